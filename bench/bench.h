@@ -0,0 +1,78 @@
+#ifndef HTML2TEX_BENCH_H
+#define HTML2TEX_BENCH_H
+
+/* helpers shared by the benchmark programs, include first so the clock is declared */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* runs per measurement, the fastest one is reported */
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 5
+#endif
+
+/* monotonic wall clock in seconds */
+static inline double bench_now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+/* growable text buffer for generated documents, aborts when memory runs out */
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} BenchText;
+
+static inline void bench_text_append(BenchText* text, const char* format, ...) {
+    if (!text->data) {
+        text->data = (char*)malloc(4096);
+        if (!text->data) abort();
+        text->capacity = 4096;
+    }
+
+    for (;;) {
+        va_list args;
+        va_start(args, format);
+        const int written = vsnprintf(text->data + text->length,
+            text->capacity - text->length, format, args);
+        va_end(args);
+
+        if (written < 0) abort();
+
+        if ((size_t)written < text->capacity - text->length) {
+            text->length += (size_t)written;
+            return;
+        }
+
+        size_t capacity = text->capacity * 2;
+        while (capacity - text->length <= (size_t)written) capacity *= 2;
+
+        char* grown = (char*)realloc(text->data, capacity);
+        if (!grown) abort();
+
+        text->data = grown;
+        text->capacity = capacity;
+    }
+}
+
+#endif
@@ -0,0 +1,162 @@
+#include "bench.h"
+#include "bench_server.h"
+#include "html2tex.h"
+#include "html_download_engine.h"
+
+#include <pthread.h>
+
+/*
+ * Connection reuse and concurrency of the curl_multi download engine against a
+ * local stand-in server.
+ * usage: bench_downloads [images]
+ *
+ * serial:   images fetched one after another from one host, from a keep-alive
+ *           server and from one closing every reply, which costs a connection
+ *           per image like a download without a shared engine
+ * parallel: images spread over hosts answering after a fixed delay, submitted at
+ *           once to engines with one and several event loops; each loop runs up
+ *           to HTML_DOWNLOAD_MAX_CONNECTIONS transfers, so one loop serves the
+ *           images in rounds of that size
+ */
+
+#define SERIAL_BODY 16384
+#define PARALLEL_HOSTS 50
+#define PARALLEL_DELAY_MS 20
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t done;
+    size_t remaining;
+    size_t failed;
+} Batch;
+
+static int discard_body(const void* data, size_t size, void* user_data) {
+    (void)data; (void)size; (void)user_data;
+    return 1;
+}
+
+static const HTMLDownloadSink discard_sink = { NULL, discard_body };
+
+static void fetch_done(const char* url, const char* path, const char* error, void* user_data) {
+    Batch* batch = (Batch*)user_data;
+    (void)url; (void)path;
+
+    pthread_mutex_lock(&batch->mutex);
+    if (error) batch->failed++;
+    if (--batch->remaining == 0) pthread_cond_signal(&batch->done);
+    pthread_mutex_unlock(&batch->mutex);
+}
+
+static void batch_wait(Batch* batch) {
+    pthread_mutex_lock(&batch->mutex);
+    while (batch->remaining) pthread_cond_wait(&batch->done, &batch->mutex);
+    pthread_mutex_unlock(&batch->mutex);
+}
+
+static void submit(HTMLDownloadEngine* engine, const BenchServer* server,
+    size_t port, size_t image, Batch* batch) {
+    char url[96];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/img%zu.png",
+        (unsigned)bench_server_port(server, port), image);
+
+    if (!html_download_engine_submit_sink(engine, url, "img.png", &discard_sink, fetch_done, batch)) {
+        fprintf(stderr, "submit failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+}
+
+static HTMLDownloadEngine* create_engine(size_t event_loops) {
+    HTMLDownloadOptions options;
+
+    memset(&options, 0, sizeof(options));
+    options.event_loops = event_loops;
+
+    HTMLDownloadEngine* engine = html_download_engine_create(&options);
+
+    if (!engine) {
+        fprintf(stderr, "engine failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    return engine;
+}
+
+static BenchServer* start_server(size_t ports, size_t body_size, unsigned int delay_ms, int keep_alive) {
+    BenchServer* server = bench_server_start(ports, body_size, delay_ms, 0, keep_alive);
+
+    if (!server) {
+        fprintf(stderr, "stand-in server failed to start\n");
+        exit(1);
+    }
+
+    return server;
+}
+
+static void run_serial(int images, int keep_alive) {
+    BenchServer* server = start_server(1, SERIAL_BODY, 0, keep_alive);
+    HTMLDownloadEngine* engine = create_engine(1);
+    size_t failed = 0;
+
+    const double start = bench_now();
+
+    /* each image waits for the previous one, as download_image_url does */
+    for (int i = 0; i < images; i++) {
+        Batch batch = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 1, 0 };
+        submit(engine, server, 0, (size_t)i, &batch);
+        batch_wait(&batch);
+        failed += batch.failed;
+    }
+
+    const double total = bench_now() - start;
+
+    printf("%12s %8d %10.1f %12.1f %12zu %8zu\n", keep_alive ? "keep-alive" : "close",
+        images, total * 1e3, total * 1e6 / images, bench_server_connections(server), failed);
+
+    html_download_engine_destroy(engine);
+    bench_server_stop(server);
+}
+
+static void run_parallel(int images, size_t event_loops) {
+    BenchServer* server = start_server(PARALLEL_HOSTS, 1024, PARALLEL_DELAY_MS, 1);
+    HTMLDownloadEngine* engine = create_engine(event_loops);
+    Batch batch = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, (size_t)images, 0 };
+
+    const double start = bench_now();
+
+    for (int i = 0; i < images; i++)
+        submit(engine, server, (size_t)i % PARALLEL_HOSTS, (size_t)i, &batch);
+
+    batch_wait(&batch);
+    const double total = bench_now() - start;
+
+    printf("%12zu %8d %10.1f %12.0f %12zu %8zu\n", event_loops, images, total * 1e3,
+        (double)images * PARALLEL_DELAY_MS, bench_server_connections(server), batch.failed);
+
+    html_download_engine_destroy(engine);
+    bench_server_stop(server);
+}
+
+int main(int argc, char** argv) {
+    const int images = argc > 1 ? atoi(argv[1]) : 300;
+
+    if (images <= 0) {
+        fprintf(stderr, "usage: %s [images]\n", argv[0]);
+        return 1;
+    }
+
+    printf("serial: %d images of %d bytes from one host\n", images, SERIAL_BODY);
+    printf("%12s %8s %10s %12s %12s %8s\n", "server", "images", "total ms",
+        "us/image", "connections", "failed");
+
+    run_serial(images, 1);
+    run_serial(images, 0);
+
+    printf("\nparallel: %d images over %d hosts, %d ms replies\n",
+        images, PARALLEL_HOSTS, PARALLEL_DELAY_MS);
+    printf("%12s %8s %10s %12s %12s %8s\n", "event loops", "images", "total ms",
+        "serial ms", "connections", "failed");
+
+    run_parallel(images, 1);
+    run_parallel(images, 4);
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include "bench.h"
+#include "bench_server.h"
+#include "html2tex.h"
+#include "html_download_engine.h"
+
+#include <pthread.h>
+#include <sys/resource.h>
+
+/*
+ * Host-aware download scheduling against a multi-port stand-in server.
+ * usage: bench_hosts [rounds]
+ *
+ * page:  one throttling host with 300 images submitted ahead of ten hosts with
+ *        10 images each, with and without the per-host connection cap
+ * hosts: rounds of 200 images on fresh ports through one long-lived engine, the
+ *        hosts it keeps stay flat while idle ones are evicted; replies close their
+ *        connection so curl pools none, round time still carries libcurl's shared
+ *        DNS cache, which keeps every host and port for its 60 s timeout
+ */
+
+#define PAGE_BUSY_IMAGES 300
+#define PAGE_SMALL_HOSTS 10
+#define PAGE_SMALL_IMAGES 10
+#define PAGE_DELAY_MS 20
+#define PAGE_HOST_LIMIT 8
+#define ROUND_PORTS 200
+
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t done;
+    size_t remaining;
+    size_t failed;
+} Batch;
+
+typedef struct {
+    Batch* batch;
+    double submitted;
+    double latency;
+} Fetch;
+
+static int discard_body(const void* data, size_t size, void* user_data) {
+    (void)data; (void)size; (void)user_data;
+    return 1;
+}
+
+static const HTMLDownloadSink discard_sink = { NULL, discard_body };
+
+static void fetch_done(const char* url, const char* path, const char* error, void* user_data) {
+    Fetch* fetch = (Fetch*)user_data;
+    Batch* batch = fetch->batch;
+    (void)url; (void)path;
+
+    fetch->latency = bench_now() - fetch->submitted;
+
+    pthread_mutex_lock(&batch->mutex);
+    if (error) batch->failed++;
+    if (--batch->remaining == 0) pthread_cond_signal(&batch->done);
+    pthread_mutex_unlock(&batch->mutex);
+}
+
+static void batch_wait(Batch* batch) {
+    pthread_mutex_lock(&batch->mutex);
+    while (batch->remaining) pthread_cond_wait(&batch->done, &batch->mutex);
+    pthread_mutex_unlock(&batch->mutex);
+}
+
+static void submit(HTMLDownloadEngine* engine, const BenchServer* server,
+    size_t port, size_t image, Fetch* fetch) {
+    char url[96];
+    snprintf(url, sizeof(url), "http://127.0.0.1:%u/img%zu.png",
+        (unsigned)bench_server_port(server, port), image);
+
+    fetch->submitted = bench_now();
+
+    if (!html_download_engine_submit_sink(engine, url, "img.png", &discard_sink, fetch_done, fetch)) {
+        fprintf(stderr, "submit failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+}
+
+static int compare_double(const void* left, const void* right) {
+    const double a = *(const double*)left, b = *(const double*)right;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/* latency percentile in milliseconds of fetches [first, first + count) */
+static double percentile(const Fetch* fetches, size_t first, size_t count, double rank) {
+    double* sorted = (double*)malloc(count * sizeof(double));
+    if (!sorted) abort();
+
+    for (size_t i = 0; i < count; i++) sorted[i] = fetches[first + i].latency;
+    qsort(sorted, count, sizeof(double), compare_double);
+
+    const double value = sorted[(size_t)(rank * (double)(count - 1))];
+    free(sorted);
+    return value * 1e3;
+}
+
+static void run_page(size_t host_connections) {
+    enum { TOTAL = PAGE_BUSY_IMAGES + PAGE_SMALL_HOSTS * PAGE_SMALL_IMAGES };
+    static Fetch fetches[TOTAL];
+    Batch batch = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, TOTAL, 0 };
+    HTMLDownloadOptions options;
+
+    BenchServer* server = bench_server_start(1 + PAGE_SMALL_HOSTS, 16384,
+        PAGE_DELAY_MS, PAGE_HOST_LIMIT, 1);
+
+    if (!server) {
+        fprintf(stderr, "stand-in server failed to start\n");
+        exit(1);
+    }
+
+    memset(&options, 0, sizeof(options));
+    options.max_host_connections = host_connections;
+
+    HTMLDownloadEngine* engine = html_download_engine_create(&options);
+
+    if (!engine) {
+        fprintf(stderr, "engine failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    const double start = bench_now();
+    size_t n = 0;
+
+    /* the busy host comes first, a FIFO scheduler would serve it alone */
+    for (size_t i = 0; i < PAGE_BUSY_IMAGES; i++, n++) {
+        fetches[n].batch = &batch;
+        submit(engine, server, 0, i, &fetches[n]);
+    }
+
+    for (size_t h = 0; h < PAGE_SMALL_HOSTS; h++) {
+        for (size_t i = 0; i < PAGE_SMALL_IMAGES; i++, n++) {
+            fetches[n].batch = &batch;
+            submit(engine, server, 1 + h, i, &fetches[n]);
+        }
+    }
+
+    batch_wait(&batch);
+    const double total = bench_now() - start;
+
+    printf("%10zu %10.0f %12.1f %12.1f %12.1f %8zu %8zu\n", host_connections, total * 1e3,
+        percentile(fetches, PAGE_BUSY_IMAGES, TOTAL - PAGE_BUSY_IMAGES, 0.5),
+        percentile(fetches, PAGE_BUSY_IMAGES, TOTAL - PAGE_BUSY_IMAGES, 0.99),
+        percentile(fetches, 0, PAGE_BUSY_IMAGES, 0.99),
+        bench_server_throttled(server), batch.failed);
+
+    html_download_engine_destroy(engine);
+    bench_server_stop(server);
+}
+
+static long peak_rss_kb(void) {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static void run_rounds(int rounds) {
+    static Fetch fetches[ROUND_PORTS];
+    HTMLDownloadEngine* engine = html_download_engine_create(NULL);
+    const int every = rounds >= 10 ? rounds / 10 : 1;
+
+    if (!engine) {
+        fprintf(stderr, "engine failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    for (int round = 1; round <= rounds; round++) {
+        Batch batch = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, ROUND_PORTS, 0 };
+        BenchServer* server = bench_server_start(ROUND_PORTS, 1024, 0, 0, 0);
+
+        if (!server) {
+            fprintf(stderr, "stand-in server failed to start\n");
+            exit(1);
+        }
+
+        const double start = bench_now();
+
+        for (size_t i = 0; i < ROUND_PORTS; i++) {
+            fetches[i].batch = &batch;
+            submit(engine, server, i, 0, &fetches[i]);
+        }
+
+        batch_wait(&batch);
+        const double elapsed = bench_now() - start;
+        bench_server_stop(server);
+
+        if (round % every == 0)
+            printf("%8d %10d %10zu %12.1f %8zu %14ld\n", round, round * ROUND_PORTS,
+                html_download_engine_hosts(engine), elapsed * 1e3, batch.failed, peak_rss_kb());
+    }
+
+    html_download_engine_destroy(engine);
+}
+
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? atoi(argv[1]) : 100;
+
+    if (rounds <= 0) {
+        fprintf(stderr, "usage: %s [rounds]\n", argv[0]);
+        return 1;
+    }
+
+    printf("page: %d images on a host answering 503 past %d requests, %d hosts x %d images, %d ms replies\n",
+        PAGE_BUSY_IMAGES, PAGE_HOST_LIMIT, PAGE_SMALL_HOSTS, PAGE_SMALL_IMAGES, PAGE_DELAY_MS);
+    printf("%10s %10s %12s %12s %12s %8s %8s\n", "host conns", "total ms",
+        "small p50 ms", "small p99 ms", "busy p99 ms", "503s", "failed");
+
+    run_page(HTML_DOWNLOAD_MAX_CONNECTIONS);
+    run_page(HTML_DOWNLOAD_MAX_HOST_CONNECTIONS);
+
+    printf("\nhosts: %d images per round, each on a fresh port\n", ROUND_PORTS);
+    printf("%8s %10s %10s %12s %8s %14s\n", "round", "hosts seen", "hosts kept",
+        "round ms", "failed", "peak RSS KB");
+
+    run_rounds(rounds);
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include "bench.h"
+#include "html2tex.h"
+
+/*
+ * Parse cost of tag soup relying on implied end tags against the same
+ * documents written out in full, per element as the document grows. Both
+ * documents of a case must parse to the same number of nodes.
+ * usage: bench_parser [max_elements]
+ */
+
+typedef struct {
+    const char* name;
+    const char* open;
+    const char* soup_item;
+    const char* full_item;
+    const char* close;
+} ParserCase;
+
+static const ParserCase cases[] = {
+    { "p", "<body>", "<p>text <b>bold</b>", "<p>text <b>bold</b></p>", "</body>" },
+    { "li", "<ul>", "<li>item <a href=\"#\">link</a>", "<li>item <a href=\"#\">link</a></li>", "</ul>" },
+    { "tr/td", "<table>", "<tr><td>a<td>b<td>c", "<tr><td>a</td><td>b</td><td>c</td></tr>", "</table>" },
+    { "dt/dd", "<dl>", "<dt>term<dd>definition", "<dt>term</dt><dd>definition</dd>", "</dl>" },
+    { "option", "<select>", "<option>choice", "<option>choice</option>", "</select>" }
+};
+
+static char* build_document(const ParserCase* c, int soup, int elements) {
+    BenchText html = { NULL, 0, 0 };
+
+    bench_text_append(&html, "<html><body>%s", c->open);
+    for (int i = 0; i < elements; i++)
+        bench_text_append(&html, "%s", soup ? c->soup_item : c->full_item);
+    bench_text_append(&html, "%s</body></html>", c->close);
+
+    return html.data;
+}
+
+static size_t count_nodes(const HTMLNode* node) {
+    size_t count = 0;
+
+    for (; node; node = node->next)
+        count += 1 + count_nodes(node->children);
+
+    return count;
+}
+
+/* nodes of the parsed tree, the two documents of a case must agree */
+static size_t tree_size(const char* html) {
+    HTMLNode* root = html2tex_parse(html);
+
+    if (!root) {
+        fprintf(stderr, "parse failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    const size_t count = count_nodes(root);
+    html2tex_free_node(root);
+    return count;
+}
+
+/* one parse in seconds, the tree is freed outside the measurement */
+static double parse_once(const char* html) {
+    const double start = bench_now();
+    HTMLNode* root = html2tex_parse(html);
+    const double elapsed = bench_now() - start;
+
+    if (!root) {
+        fprintf(stderr, "parse failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    html2tex_free_node(root);
+    return elapsed;
+}
+
+int main(int argc, char** argv) {
+    const int max_elements = argc > 1 ? atoi(argv[1]) : 100000;
+
+    if (max_elements < 1000) {
+        fprintf(stderr, "usage: %s [max_elements >= 1000]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%8s %10s %10s %16s %16s %8s\n", "case", "elements", "nodes",
+        "full ns/elem", "soup ns/elem", "ratio");
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        for (int elements = 1000; elements <= max_elements; elements *= 10) {
+            char* full = build_document(&cases[c], 0, elements);
+            char* soup = build_document(&cases[c], 1, elements);
+
+            const size_t nodes = tree_size(full);
+            double full_best = 1e30, soup_best = 1e30;
+
+            if (tree_size(soup) != nodes) {
+                fprintf(stderr, "%s: implied end tags built a different tree\n", cases[c].name);
+                return 1;
+            }
+
+            /* alternate the two so both see the same allocator state */
+            for (int run = 0; run < BENCH_REPEAT; run++) {
+                const double full_time = parse_once(full);
+                const double soup_time = parse_once(soup);
+
+                if (full_time < full_best) full_best = full_time;
+                if (soup_time < soup_best) soup_best = soup_time;
+            }
+
+            const double full_ns = full_best * 1e9 / (double)elements;
+            const double soup_ns = soup_best * 1e9 / (double)elements;
+
+            printf("%8s %10d %10zu %16.0f %16.0f %8.2f\n", cases[c].name, elements,
+                nodes, full_ns, soup_ns, soup_ns / full_ns);
+
+            free(full);
+            free(soup);
+        }
+    }
+
+    return 0;
+}
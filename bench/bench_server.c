@@ -0,0 +1,364 @@
+#include "bench.h"
+#include "bench_server.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+static const char THROTTLED_REPLY[] =
+    "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+
+static const char THROTTLED_CLOSE_REPLY[] =
+    "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+
+/* one client connection, reading a request or writing its reply */
+typedef struct {
+    int fd;
+    size_t port;
+    char request[4096];
+    size_t received;
+
+    /* reply being written, NULL while reading */
+    const char* reply;
+    size_t reply_length;
+    size_t sent;
+
+    /* a 200 is held back until due and holds an active slot of its port meanwhile */
+    double due;
+    int counted;
+} BenchConnection;
+
+struct BenchServer {
+    size_t ports;
+    int* listeners;
+    unsigned short* numbers;
+    size_t* active;
+    size_t max_active;
+    double delay;
+    int keep_alive;
+
+    char* ok_reply;
+    size_t ok_length;
+
+    BenchConnection* connections;
+    size_t connection_count;
+    size_t connection_capacity;
+    struct pollfd* fds;
+
+    /* written to by bench_server_stop() to leave poll */
+    int wake[2];
+    pthread_t thread;
+
+    pthread_mutex_t mutex;
+    size_t accepted;
+    size_t served;
+    size_t throttled;
+};
+
+static int set_nonblocking(int fd) {
+    const int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/* end of the request head, 0 while incomplete */
+static size_t request_end(const BenchConnection* connection) {
+    for (size_t i = 3; i < connection->received; i++) {
+        if (memcmp(connection->request + i - 3, "\r\n\r\n", 4) == 0)
+            return i + 1;
+    }
+
+    return 0;
+}
+
+static void close_connection(BenchServer* server, size_t index) {
+    BenchConnection* connection = &server->connections[index];
+
+    if (connection->counted) server->active[connection->port]--;
+    close(connection->fd);
+    server->connections[index] = server->connections[--server->connection_count];
+}
+
+static void accept_connections(BenchServer* server, size_t port) {
+    for (;;) {
+        const int fd = accept(server->listeners[port], NULL, NULL);
+        if (fd < 0) return;
+
+        if (!set_nonblocking(fd) || server->connection_count == server->connection_capacity) {
+            close(fd);
+            continue;
+        }
+
+        pthread_mutex_lock(&server->mutex);
+        server->accepted++;
+        pthread_mutex_unlock(&server->mutex);
+
+        BenchConnection* connection = &server->connections[server->connection_count++];
+        memset(connection, 0, sizeof(*connection));
+        connection->fd = fd;
+        connection->port = port;
+    }
+}
+
+/* reads what arrived and queues the reply once the request head is complete, 0 to close */
+static int read_request(BenchServer* server, BenchConnection* connection, double now) {
+    const ssize_t got = recv(connection->fd, connection->request + connection->received,
+        sizeof(connection->request) - connection->received, 0);
+
+    if (got == 0) return 0;
+    if (got < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+    connection->received += (size_t)got;
+    if (!request_end(connection))
+        return connection->received < sizeof(connection->request);
+
+    connection->sent = 0;
+
+    if (server->max_active && server->active[connection->port] >= server->max_active) {
+        connection->reply = server->keep_alive ? THROTTLED_REPLY : THROTTLED_CLOSE_REPLY;
+        connection->reply_length = server->keep_alive
+            ? sizeof(THROTTLED_REPLY) - 1 : sizeof(THROTTLED_CLOSE_REPLY) - 1;
+        connection->due = now;
+    }
+    else {
+        server->active[connection->port]++;
+        connection->counted = 1;
+        connection->reply = server->ok_reply;
+        connection->reply_length = server->ok_length;
+        connection->due = now + server->delay;
+    }
+
+    return 1;
+}
+
+/* writes the reply, keeps the connection for the next request, 0 to close */
+static int write_reply(BenchServer* server, BenchConnection* connection) {
+    const ssize_t put = send(connection->fd, connection->reply + connection->sent,
+        connection->reply_length - connection->sent, 0);
+
+    if (put < 0) return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+
+    connection->sent += (size_t)put;
+    if (connection->sent < connection->reply_length) return 1;
+
+    pthread_mutex_lock(&server->mutex);
+    if (connection->counted) server->served++;
+    else server->throttled++;
+    pthread_mutex_unlock(&server->mutex);
+
+    if (connection->counted) server->active[connection->port]--;
+    connection->counted = 0;
+    connection->reply = NULL;
+
+    if (!server->keep_alive) return 0;
+
+    /* keep-alive, a pipelined request stays in the buffer */
+    const size_t end = request_end(connection);
+    memmove(connection->request, connection->request + end, connection->received - end);
+    connection->received -= end;
+    return 1;
+}
+
+static void* serve(void* arg) {
+    BenchServer* server = (BenchServer*)arg;
+
+    for (;;) {
+        const double now = bench_now();
+        double next_due = -1.0;
+        size_t count = 0;
+
+        server->fds[count].fd = server->wake[0];
+        server->fds[count++].events = POLLIN;
+
+        for (size_t i = 0; i < server->ports; i++) {
+            server->fds[count].fd = server->listeners[i];
+            server->fds[count++].events = POLLIN;
+        }
+
+        for (size_t i = 0; i < server->connection_count; i++) {
+            const BenchConnection* connection = &server->connections[i];
+            short events = POLLIN;
+
+            if (connection->reply) {
+                events = connection->due <= now ? POLLOUT : 0;
+
+                if (connection->due > now && (next_due < 0 || connection->due < next_due))
+                    next_due = connection->due;
+            }
+
+            server->fds[count].fd = connection->fd;
+            server->fds[count++].events = events;
+        }
+
+        const int timeout = next_due < 0 ? -1 : (int)((next_due - now) * 1e3) + 1;
+        if (poll(server->fds, (nfds_t)count, timeout) < 0 && errno != EINTR) break;
+        if (server->fds[0].revents) break;
+
+        /* connections are visited before accepting, their pollfds follow the listeners */
+        const double polled = bench_now();
+
+        for (size_t i = server->connection_count; i-- > 0; ) {
+            BenchConnection* connection = &server->connections[i];
+            const short revents = server->fds[1 + server->ports + i].revents;
+            int keep = 1;
+
+            if (!connection->reply && (revents & (POLLIN | POLLHUP | POLLERR)))
+                keep = read_request(server, connection, polled);
+            else if (connection->reply && (revents & (POLLHUP | POLLERR)))
+                keep = 0;
+
+            if (keep && connection->reply && connection->due <= polled)
+                keep = write_reply(server, connection);
+
+            if (!keep) close_connection(server, i);
+        }
+
+        for (size_t i = 0; i < server->ports; i++) {
+            if (server->fds[1 + i].revents & POLLIN)
+                accept_connections(server, i);
+        }
+    }
+
+    return NULL;
+}
+
+BenchServer* bench_server_start(size_t ports, size_t body_size,
+    unsigned int delay_ms, size_t max_active, int keep_alive) {
+    BenchServer* server = (BenchServer*)calloc(1, sizeof(BenchServer));
+    if (!server) return NULL;
+
+    /* a client hanging up mid-reply must not kill the benchmark */
+    signal(SIGPIPE, SIG_IGN);
+
+    server->ports = ports;
+    server->max_active = max_active;
+    server->keep_alive = keep_alive;
+    server->delay = delay_ms / 1e3;
+    server->connection_capacity = 1024;
+    server->listeners = (int*)malloc(ports * sizeof(int));
+    server->numbers = (unsigned short*)calloc(ports, sizeof(unsigned short));
+    server->active = (size_t*)calloc(ports, sizeof(size_t));
+    server->connections = (BenchConnection*)malloc(server->connection_capacity * sizeof(BenchConnection));
+    server->fds = (struct pollfd*)calloc(1 + ports + server->connection_capacity, sizeof(struct pollfd));
+    server->wake[0] = server->wake[1] = -1;
+
+    char head[128];
+    const int head_length = snprintf(head, sizeof(head),
+        "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nContent-Length: %zu\r\n%s\r\n",
+        body_size, keep_alive ? "" : "Connection: close\r\n");
+
+    server->ok_length = (size_t)head_length + body_size;
+    server->ok_reply = (char*)malloc(server->ok_length);
+
+    if (!server->listeners || !server->numbers || !server->active ||
+        !server->connections || !server->fds || !server->ok_reply)
+        goto failure;
+
+    memcpy(server->ok_reply, head, (size_t)head_length);
+    for (size_t i = 0; i < body_size; i++)
+        server->ok_reply[head_length + i] = (char)(i * 31 + 7);
+
+    for (size_t i = 0; i < ports; i++) server->listeners[i] = -1;
+
+    for (size_t i = 0; i < ports; i++) {
+        struct sockaddr_in address;
+        socklen_t length = sizeof(address);
+        const int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+        if (fd < 0) goto failure;
+        server->listeners[i] = fd;
+
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(fd, 128) != 0 || !set_nonblocking(fd) ||
+            getsockname(fd, (struct sockaddr*)&address, &length) != 0)
+            goto failure;
+
+        server->numbers[i] = ntohs(address.sin_port);
+    }
+
+    if (pipe(server->wake) != 0) goto failure;
+    pthread_mutex_init(&server->mutex, NULL);
+
+    if (pthread_create(&server->thread, NULL, serve, server) != 0) {
+        pthread_mutex_destroy(&server->mutex);
+        goto failure;
+    }
+
+    return server;
+
+failure:
+    for (size_t i = 0; server->listeners && i < ports; i++)
+        if (server->listeners[i] >= 0) close(server->listeners[i]);
+
+    if (server->wake[0] >= 0) close(server->wake[0]);
+    if (server->wake[1] >= 0) close(server->wake[1]);
+
+    free(server->listeners);
+    free(server->numbers);
+    free(server->active);
+    free(server->connections);
+    free(server->fds);
+    free(server->ok_reply);
+    free(server);
+    return NULL;
+}
+
+unsigned short bench_server_port(const BenchServer* server, size_t index) {
+    return server->numbers[index];
+}
+
+size_t bench_server_connections(const BenchServer* server) {
+    pthread_mutex_lock((pthread_mutex_t*)&server->mutex);
+    const size_t accepted = server->accepted;
+    pthread_mutex_unlock((pthread_mutex_t*)&server->mutex);
+    return accepted;
+}
+
+size_t bench_server_served(const BenchServer* server) {
+    pthread_mutex_lock((pthread_mutex_t*)&server->mutex);
+    const size_t served = server->served;
+    pthread_mutex_unlock((pthread_mutex_t*)&server->mutex);
+    return served;
+}
+
+size_t bench_server_throttled(const BenchServer* server) {
+    pthread_mutex_lock((pthread_mutex_t*)&server->mutex);
+    const size_t throttled = server->throttled;
+    pthread_mutex_unlock((pthread_mutex_t*)&server->mutex);
+    return throttled;
+}
+
+void bench_server_stop(BenchServer* server) {
+    if (!server) return;
+
+    const char stop = 1;
+    if (write(server->wake[1], &stop, 1) != 1) abort();
+    pthread_join(server->thread, NULL);
+
+    while (server->connection_count)
+        close_connection(server, server->connection_count - 1);
+
+    for (size_t i = 0; i < server->ports; i++)
+        close(server->listeners[i]);
+
+    close(server->wake[0]);
+    close(server->wake[1]);
+    pthread_mutex_destroy(&server->mutex);
+
+    free(server->listeners);
+    free(server->numbers);
+    free(server->active);
+    free(server->connections);
+    free(server->fds);
+    free(server->ok_reply);
+    free(server);
+}
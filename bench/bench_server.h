@@ -0,0 +1,32 @@
+#ifndef HTML2TEX_BENCH_SERVER_H
+#define HTML2TEX_BENCH_SERVER_H
+
+#include <stddef.h>
+
+/*
+ * HTTP/1.1 stand-in for the download benchmarks, POSIX only. Every port of a
+ * server is its own host to the download engine. A GET on any path answers 200
+ * with the same body after a fixed delay; a port already answering max_active
+ * requests answers 503 at once, like a throttling origin.
+ */
+typedef struct BenchServer BenchServer;
+
+/* starts a server thread listening on ports loopback ports picked by the kernel,
+   max_active 0 for no limit, without keep_alive every reply closes its connection,
+   NULL on failure */
+BenchServer* bench_server_start(size_t ports, size_t body_size,
+    unsigned int delay_ms, size_t max_active, int keep_alive);
+
+unsigned short bench_server_port(const BenchServer* server, size_t index);
+
+/* connections accepted so far */
+size_t bench_server_connections(const BenchServer* server);
+
+/* requests answered 200 and 503 so far */
+size_t bench_server_served(const BenchServer* server);
+size_t bench_server_throttled(const BenchServer* server);
+
+/* closes every socket and joins the server thread */
+void bench_server_stop(BenchServer* server);
+
+#endif
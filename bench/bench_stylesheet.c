@@ -0,0 +1,116 @@
+#include "bench.h"
+#include "html2tex.h"
+
+/*
+ * Cost of the embedded stylesheet cascade per element as the rule count grows.
+ * usage: bench_stylesheet [elements]
+ */
+
+static size_t cascaded;
+
+static void cascade_tree(const CSSStylesheet* sheet, const HTMLNode* node,
+    CSSMatchContext* context) {
+    for (; node; node = node->next) {
+        if (node->tag) {
+            CSSProperties* props = css_stylesheet_cascade(sheet, node, NULL, context);
+            if (props) css_properties_destroy(props);
+            cascaded++;
+        }
+
+        cascade_tree(sheet, node->children, context);
+    }
+}
+
+/* rules keyed by class, id, descendant class and tag, only a few of them match */
+static char* build_document(int rules, int elements) {
+    BenchText html = { NULL, 0, 0 };
+    int i;
+
+    bench_text_append(&html, "<html><head><style>");
+
+    for (i = 0; i < rules; i++) {
+        switch (i % 4) {
+        case 0: bench_text_append(&html, ".c%d{color:red}", i); break;
+        case 1: bench_text_append(&html, "#i%d{font-weight:bold}", i); break;
+        case 2: bench_text_append(&html, "div .c%d{font-style:italic}", i); break;
+        default: bench_text_append(&html, i < 40 ? "p{text-align:center}" : ".u%d{color:blue}", i); break;
+        }
+    }
+
+    bench_text_append(&html, "</style></head><body>");
+
+    for (i = 0; i < elements; i++)
+        bench_text_append(&html, "<div><p class=\"c%d x\" id=\"i%d\">text</p></div>",
+            (i * 4) % 40, i * 4 + 1);
+
+    bench_text_append(&html, "</body></html>");
+    return html.data;
+}
+
+int main(int argc, char** argv) {
+    static const int rule_counts[] = { 0, 10, 100, 1000, 10000 };
+    const int elements = argc > 1 ? atoi(argv[1]) : 2000;
+    size_t r;
+
+    if (elements <= 0) {
+        fprintf(stderr, "usage: %s [elements]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%8s %12s %16s %16s\n", "rules", "sheet ms", "cascade ns/elem", "convert ns/elem");
+
+    for (r = 0; r < sizeof(rule_counts) / sizeof(rule_counts[0]); r++) {
+        char* html = build_document(rule_counts[r], elements);
+        HTMLNode* root = html2tex_parse(html);
+        double best_sheet = 1e30, best_cascade = 1e30, best_convert = 1e30;
+        int run;
+
+        if (!root) {
+            fprintf(stderr, "parse failed: %s\n", html2tex_get_error_message());
+            return 1;
+        }
+
+        for (run = 0; run < BENCH_REPEAT; run++) {
+            double start = bench_now();
+            CSSStylesheet* sheet = css_stylesheet_from_document(root);
+            const double sheet_time = bench_now() - start;
+
+            CSSMatchContext context;
+            css_match_context_init(&context, root);
+
+            cascaded = 0;
+            start = bench_now();
+            cascade_tree(sheet, root, &context);
+            const double cascade_time = bench_now() - start;
+
+            css_match_context_cleanup(&context);
+            if (sheet) css_stylesheet_destroy(sheet);
+
+            /* full conversion, one cascade per element included */
+            LaTeXConverter* converter = html2tex_create();
+            start = bench_now();
+            char* latex = html2tex_convert(converter, html);
+            const double convert_time = bench_now() - start;
+
+            if (!latex) {
+                fprintf(stderr, "conversion failed: %s\n", html2tex_get_error_message());
+                return 1;
+            }
+
+            html2tex_free(latex);
+            html2tex_destroy(converter);
+
+            if (sheet_time < best_sheet) best_sheet = sheet_time;
+            if (cascade_time < best_cascade) best_cascade = cascade_time;
+            if (convert_time < best_convert) best_convert = convert_time;
+        }
+
+        printf("%8d %12.3f %16.0f %16.0f\n", rule_counts[r], best_sheet * 1e3,
+            best_cascade * 1e9 / (double)cascaded, best_convert * 1e9 / (double)cascaded);
+
+        html2tex_free_node(root);
+        free(html);
+    }
+
+    return 0;
+}
@@ -0,0 +1,228 @@
+#include "bench.h"
+#include "html2tex.h"
+#include "html_work_queue.h"
+
+/*
+ * Throughput of the lock-free work queue under contention, non-blocking and
+ * parking, against a mutex and condition variable ring of the same capacity.
+ * usage: bench_work_queue [items]
+ */
+
+#define QUEUE_CAPACITY 1024
+#define MAX_THREADS 8
+
+typedef enum {
+    MODE_TRY,
+    MODE_BLOCKING,
+    MODE_MUTEX
+} QueueMode;
+
+static const char* const mode_names[] = { "try_push/try_pop", "push/pop", "mutex ring" };
+
+/* the bounded ring guarded by one mutex that the work queue replaces */
+typedef struct {
+    mutex_t mutex;
+    cond_t not_empty;
+    cond_t not_full;
+    void* slots[QUEUE_CAPACITY];
+    size_t head;
+    size_t count;
+    int closed;
+} MutexRing;
+
+static void mutex_ring_push(MutexRing* ring, void* item) {
+    mutex_lock(&ring->mutex);
+    while (ring->count == QUEUE_CAPACITY) cond_wait(&ring->not_full, &ring->mutex);
+
+    ring->slots[(ring->head + ring->count++) % QUEUE_CAPACITY] = item;
+    cond_signal(&ring->not_empty);
+    mutex_unlock(&ring->mutex);
+}
+
+/* NULL once closed and drained */
+static void* mutex_ring_pop(MutexRing* ring) {
+    void* item = NULL;
+
+    mutex_lock(&ring->mutex);
+    while (!ring->count && !ring->closed) cond_wait(&ring->not_empty, &ring->mutex);
+
+    if (ring->count) {
+        item = ring->slots[ring->head];
+        ring->head = (ring->head + 1) % QUEUE_CAPACITY;
+        ring->count--;
+        cond_signal(&ring->not_full);
+    }
+
+    mutex_unlock(&ring->mutex);
+    return item;
+}
+
+static void mutex_ring_close(MutexRing* ring) {
+    mutex_lock(&ring->mutex);
+    ring->closed = 1;
+    cond_broadcast(&ring->not_empty);
+    mutex_unlock(&ring->mutex);
+}
+
+typedef struct {
+    QueueMode mode;
+    HTMLWorkQueue* queue;
+    MutexRing ring;
+    size_t per_producer;
+
+    /* set once every item is queued and the queue ran empty, ends MODE_TRY consumers */
+    atomic_size_t drained;
+} Run;
+
+typedef struct {
+    Run* run;
+    size_t taken;
+} Consumer;
+
+static THREAD_RETURN_TYPE THREAD_FUNC produce(void* arg) {
+    Run* run = (Run*)arg;
+
+    /* items start at 1, a NULL item means an empty queue */
+    for (size_t i = 1; i <= run->per_producer; i++) {
+        void* item = (void*)i;
+
+        switch (run->mode) {
+        case MODE_TRY:
+            while (!html_work_queue_try_push(run->queue, item)) thread_yield();
+            break;
+        case MODE_BLOCKING:
+            html_work_queue_push(run->queue, item);
+            break;
+        default:
+            mutex_ring_push(&run->ring, item);
+            break;
+        }
+    }
+
+    return 0;
+}
+
+static THREAD_RETURN_TYPE THREAD_FUNC consume(void* arg) {
+    Consumer* consumer = (Consumer*)arg;
+    Run* run = consumer->run;
+
+    for (;;) {
+        void* item;
+
+        switch (run->mode) {
+        case MODE_TRY:
+            item = html_work_queue_try_pop(run->queue);
+
+            if (!item) {
+                if (atomic_load(&run->drained)) return 0;
+                thread_yield();
+                continue;
+            }
+            break;
+        case MODE_BLOCKING:
+            item = html_work_queue_pop(run->queue, 0);
+            if (!item) return 0;
+            break;
+        default:
+            item = mutex_ring_pop(&run->ring);
+            if (!item) return 0;
+            break;
+        }
+
+        consumer->taken++;
+    }
+}
+
+static void run_queue(QueueMode mode, int producers, int consumers, size_t items) {
+    thread_t producer_threads[MAX_THREADS], consumer_threads[MAX_THREADS];
+    Consumer consumer_state[MAX_THREADS];
+    Run* run = (Run*)calloc(1, sizeof(Run));
+    size_t taken = 0;
+    int i;
+
+    if (!run) abort();
+
+    run->mode = mode;
+    run->per_producer = items / (size_t)producers;
+    atomic_store(&run->drained, 0);
+
+    if (mode == MODE_MUTEX) {
+        mutex_init(&run->ring.mutex);
+        cond_init(&run->ring.not_empty);
+        cond_init(&run->ring.not_full);
+    }
+    else if (!(run->queue = html_work_queue_create(QUEUE_CAPACITY))) {
+        fprintf(stderr, "queue failed: %s\n", html2tex_get_error_message());
+        exit(1);
+    }
+
+    const double start = bench_now();
+
+    for (i = 0; i < consumers; i++) {
+        consumer_state[i].run = run;
+        consumer_state[i].taken = 0;
+        thread_create(&consumer_threads[i], consume, &consumer_state[i]);
+    }
+
+    for (i = 0; i < producers; i++)
+        thread_create(&producer_threads[i], produce, run);
+
+    for (i = 0; i < producers; i++) thread_join(producer_threads[i]);
+
+    switch (mode) {
+    case MODE_TRY:
+        while (html_work_queue_size(run->queue)) thread_yield();
+        atomic_store(&run->drained, 1);
+        break;
+    case MODE_BLOCKING:
+        html_work_queue_close(run->queue);
+        break;
+    default:
+        mutex_ring_close(&run->ring);
+        break;
+    }
+
+    for (i = 0; i < consumers; i++) {
+        thread_join(consumer_threads[i]);
+        taken += consumer_state[i].taken;
+    }
+
+    const double elapsed = bench_now() - start;
+    const size_t queued = run->per_producer * (size_t)producers;
+
+    printf("%18s %6d %6d %12zu %14.2f%s\n", mode_names[mode], producers, consumers,
+        queued, (double)queued / elapsed / 1e6, taken == queued ? "" : "  items lost");
+
+    if (mode == MODE_MUTEX) {
+        cond_destroy(&run->ring.not_full);
+        cond_destroy(&run->ring.not_empty);
+        mutex_destroy(&run->ring.mutex);
+    }
+    else {
+        html_work_queue_destroy(run->queue);
+    }
+
+    free(run);
+}
+
+int main(int argc, char** argv) {
+    static const int threads[][2] = { { 1, 1 }, { 1, 4 }, { 4, 1 }, { 4, 4 }, { 8, 8 } };
+    const long items = argc > 1 ? atol(argv[1]) : 1000000;
+    size_t t;
+    int mode;
+
+    if (items < MAX_THREADS) {
+        fprintf(stderr, "usage: %s [items >= %d]\n", argv[0], MAX_THREADS);
+        return 1;
+    }
+
+    printf("capacity %d, %d cpus\n", QUEUE_CAPACITY, get_cpu_count());
+    printf("%18s %6s %6s %12s %14s\n", "queue", "push", "pop", "items", "M items/s");
+
+    for (t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        for (mode = MODE_TRY; mode <= MODE_MUTEX; mode++)
+            run_queue((QueueMode)mode, threads[t][0], threads[t][1], (size_t)items);
+    }
+
+    return 0;
+}
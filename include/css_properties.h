@@ -7,7 +7,6 @@
 extern "C" {
 #endif
 	typedef struct CSSProperty CSSProperty;
-	typedef enum CSSPropertyMask CSSPropertyMask;
 	typedef struct CSSPropertyDef CSSPropertyDef;
 	typedef struct CSSProperties CSSProperties;
 	typedef struct LaTeXConverter LaTeXConverter;
@@ -30,6 +29,7 @@ extern "C" {
 		CSS_MARGIN_TOP = 1 << 11,
 		CSS_MARGIN_BOTTOM = 1 << 12
 	};
+	typedef enum CSSPropertyMask CSSPropertyMask;
 
 	/* Compact CSS property storage using key-value pairs.
    Only stores properties that are actually set.
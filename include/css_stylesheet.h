@@ -0,0 +1,234 @@
+#ifndef CSS_STYLESHEET_H
+#define CSS_STYLESHEET_H
+
+#include <stddef.h>
+#include "dom_tree.h"
+#include "css_properties.h"
+
+#ifndef CSS_MAX_ANCESTOR_HASHES
+#define CSS_MAX_ANCESTOR_HASHES 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct CSSAttributeTest CSSAttributeTest;
+	typedef struct CSSNthTest CSSNthTest;
+	typedef struct CSSCompound CSSCompound;
+	typedef struct CSSRule CSSRule;
+	typedef struct CSSSelector CSSSelector;
+	typedef struct CSSPositionSlot CSSPositionSlot;
+	typedef struct CSSMatchContext CSSMatchContext;
+	typedef struct CSSRuleBucket CSSRuleBucket;
+	typedef struct CSSRuleMap CSSRuleMap;
+	typedef struct CSSStylesheet CSSStylesheet;
+
+	/* attribute test operators: [a], [a=v], [a~=v], [a^=v], [a$=v], [a*=v] */
+	typedef enum {
+		CSS_ATTR_EXISTS = 0,
+		CSS_ATTR_EQUALS,
+		CSS_ATTR_INCLUDES,
+		CSS_ATTR_PREFIX,
+		CSS_ATTR_SUFFIX,
+		CSS_ATTR_SUBSTRING
+	} CSSAttributeOp;
+
+	/* Attribute test, the key is lowercased and the value is NULL for CSS_ATTR_EXISTS. */
+	struct CSSAttributeTest {
+		char* key;
+		char* value;
+		CSSAttributeOp op;
+	};
+
+	/* Position test an+b among element siblings, counted from the last one when from_end is set. */
+	struct CSSNthTest {
+		int a;
+		int b;
+		int from_end;
+	};
+
+	/* Compound selector (tag, id, classes, attribute and position tests) with the
+	combinator linking it to the compound on its left, 0 for the leftmost one.
+	*/
+	struct CSSCompound {
+		char* tag;
+		char* id;
+		char** classes;
+		size_t class_count;
+		CSSAttributeTest* attributes;
+		size_t attribute_count;
+		CSSNthTest* positions;
+		size_t position_count;
+		char combinator;
+	};
+
+	/* Single selector, with its declarations when it belongs to a stylesheet,
+	compounds stored right-to-left.
+	*/
+	struct CSSRule {
+		CSSCompound* compounds;
+		size_t compound_count;
+		unsigned int specificity;
+		size_t order;
+		CSSProperties* declarations;
+
+		/* keys every matching ancestor chain must carry */
+		unsigned int ancestor_hashes[CSS_MAX_ANCESTOR_HASHES];
+		size_t ancestor_hash_count;
+	};
+
+	/* Rules sharing the same id, class or tag key. */
+	struct CSSRuleBucket {
+		char* key;
+		CSSRule** rules;
+		size_t count;
+		size_t capacity;
+	};
+
+	/* Open-addressing table of rule buckets. */
+	struct CSSRuleMap {
+		CSSRuleBucket* slots;
+		size_t capacity;
+		size_t used;
+	};
+
+	/* Parsed stylesheet, each rule is filed under the most selective
+	key of its subject compound so a node only tests candidate rules.
+	*/
+	struct CSSStylesheet {
+		CSSRule** rules;
+		size_t rule_count;
+		size_t rule_capacity;
+
+		CSSRuleMap ids;
+		CSSRuleMap classes;
+		CSSRuleMap tags;
+
+		CSSRule** universal;
+		size_t universal_count;
+		size_t universal_capacity;
+	};
+
+	/* Compiled selector list, one rule without declarations per alternative. */
+	struct CSSSelector {
+		CSSRule** alternatives;
+		size_t count;
+	};
+
+	/* Cached 1-based position of an element among its element siblings. */
+	struct CSSPositionSlot {
+		const HTMLNode* node;
+		unsigned int index;
+		unsigned int count;
+	};
+
+	/* Matching state for one traversal or query. Positions are filled for a whole
+	sibling list on first use, so :nth-child tests stay linear in the siblings.
+	*/
+	struct CSSMatchContext {
+		const HTMLNode* root;
+		CSSPositionSlot* slots;
+		size_t capacity;
+		size_t used;
+	};
+
+	/**
+	 * @brief Compiles a selector list shared by stylesheets and DOM queries.
+	 * @param text Selector text (e.g. "ul > li:nth-child(2n+1), a[href^=http]")
+	 * @return Success: Compiled selector (caller owns)
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_CSS_SYNTAX with the reason and offset, HTML2TEX_ERR_NOMEM)
+	 */
+	CSSSelector* css_selector_compile(const char* text);
+
+	/**
+	 * @brief Releases a compiled selector.
+	 * @param selector Selector to destroy (NULL-safe)
+	 */
+	void css_selector_destroy(CSSSelector* selector);
+
+	/**
+	 * @brief Tests whether a node matches any alternative of a compiled selector.
+	 * @param selector Compiled selector
+	 * @param node Candidate node (text nodes never match)
+	 * @param context Position cache and document root (NULL allowed, positions are then counted per test)
+	 * @return 1 on match, 0 otherwise
+	 * @note Read-only on the selector, one context per thread
+	 */
+	int css_selector_matches(const CSSSelector* selector,
+		const HTMLNode* node, CSSMatchContext* context);
+
+	/**
+	 * @brief Prepares an empty match context.
+	 * @param context Context to initialize
+	 * @param root Document root, stands in as the parent of top-level nodes (NULL allowed)
+	 */
+	void css_match_context_init(CSSMatchContext* context, const HTMLNode* root);
+
+	/**
+	 * @brief Releases the position cache of a match context.
+	 * @param context Context to clean up (NULL-safe)
+	 * @note The cache must be cleared whenever sibling lists change
+	 */
+	void css_match_context_cleanup(CSSMatchContext* context);
+
+	/**
+	 * @brief Creates an empty stylesheet.
+	 * @return Success: Empty CSSStylesheet* container
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 */
+	CSSStylesheet* css_stylesheet_create(void);
+
+	/**
+	 * @brief Releases the stylesheet and all of its rules.
+	 * @param sheet Stylesheet to destroy (NULL-safe)
+	 */
+	void css_stylesheet_destroy(CSSStylesheet* sheet);
+
+	/**
+	 * @brief Parses CSS rules and appends them to the stylesheet.
+	 * @param sheet Target stylesheet
+	 * @param css_text Stylesheet source (e.g. "p.note { color: red }")
+	 * @return Success: 1 (unsupported selectors and at-rules are skipped)
+	 * @return Failure: 0 with error set
+	 */
+	int css_stylesheet_parse(CSSStylesheet* sheet, const char* css_text);
+
+	/**
+	 * @brief Collects every style element of a document into one stylesheet.
+	 * @param root Document root node
+	 * @return Success: Stylesheet (caller owns)
+	 * @return No style elements: NULL (not an error)
+	 * @return Failure: NULL with error set
+	 */
+	CSSStylesheet* css_stylesheet_from_document(const HTMLNode* root);
+
+	/**
+	 * @brief Computes the declared style of an element from the stylesheet and its style attribute.
+	 * @param sheet Document stylesheet (NULL allowed, only the style attribute is used)
+	 * @param node Element node
+	 * @param ancestors Traversal filter used to reject descendant rules early (NULL allowed)
+	 * @param context Position cache and document root for structural pseudo-classes (NULL allowed)
+	 * @return Success: Cascaded properties (caller owns)
+	 * @return No matching rules nor style attribute: NULL (not an error)
+	 * @return Failure: NULL with error set
+	 */
+	CSSProperties* css_stylesheet_cascade(const CSSStylesheet* sheet,
+		const HTMLNode* node, const AncestorFilter* ancestors, CSSMatchContext* context);
+
+#ifndef CSS_STYLESHEET_MIN_CAPACITY
+#define CSS_STYLESHEET_MIN_CAPACITY 16
+#endif
+
+#ifndef CSS_MATCH_CONTEXT_MIN_CAPACITY
+#define CSS_MATCH_CONTEXT_MIN_CAPACITY 64
+#endif
+
+#ifndef CSS_MAX_SELECTOR_LENGTH
+#define CSS_MAX_SELECTOR_LENGTH 1024
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define DOM_TREE_H
 
 #include <stddef.h>
+#include "html_charset.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,6 +11,22 @@ extern "C" {
 	typedef struct HTMLAttribute HTMLAttribute;
 	typedef struct LaTeXConverter LaTeXConverter;
 	typedef struct TagProperties TagProperties;
+	typedef struct AncestorFilter AncestorFilter;
+
+	/* Frequently queried attributes indexed on each node. */
+	typedef enum {
+		HTML_ATTR_STYLE = 0,
+		HTML_ATTR_ID,
+		HTML_ATTR_CLASS,
+		HTML_ATTR_SRC,
+		HTML_ATTR_HREF,
+		HTML_ATTR_COLSPAN,
+		HTML_ATTR_ROWSPAN,
+		HTML_ATTR_WIDTH,
+		HTML_ATTR_HEIGHT,
+		HTML_ATTR_ALT,
+		HTML_ATTR_HOT_COUNT
+	} HTMLHotAttribute;
 
 	/* HTML node structure */
 	struct HTMLNode {
@@ -19,6 +36,7 @@ extern "C" {
 		HTMLNode* children;
 		HTMLNode* next;
 		HTMLNode* parent;
+		HTMLAttribute* hot_attrs[HTML_ATTR_HOT_COUNT];
 	};
 
 	/* HTML attribute structure */
@@ -34,14 +52,60 @@ extern "C" {
 		const unsigned char length;
 	};
 
+	/* Ancestor contexts tracked exactly by AncestorFilter. */
+	typedef enum {
+		HTML_CONTEXT_TABLE = 1 << 0,
+		HTML_CONTEXT_TABLE_CELL = 1 << 1,
+		HTML_CONTEXT_LIST = 1 << 2,
+		HTML_CONTEXT_PRE = 1 << 3
+	} HTMLContextFlag;
+
+#ifndef HTML_ANCESTOR_FILTER_SLOTS
+#define HTML_ANCESTOR_FILTER_SLOTS 1024
+#endif
+
+#define HTML_CONTEXT_KIND_COUNT 4
+
+	/* Rolling summary of the open ancestors during a traversal: a counting
+	Bloom filter of tag/id/class hashes plus exact context depths.
+	*/
+	struct AncestorFilter {
+		unsigned char counters[HTML_ANCESTOR_FILTER_SLOTS];
+		unsigned int context_depth[HTML_CONTEXT_KIND_COUNT];
+		unsigned int context;
+		const HTMLNode* top;
+	};
+
 	/**
 	 * @brief Parses HTML into a DOM tree with basic tag/attribute extraction.
-	 * @param html HTML source string (UTF-8, NULL-terminated)
+	 * @param html HTML source string (NULL-terminated, UTF-8 unless a byte
+	 *        order mark or <meta> charset declares otherwise)
 	 * @return Success: Root DOM node with children (caller owns)
 	 * @return Failure: NULL with error set
 	 */
 	HTMLNode* html2tex_parse(const char* html);
 
+	/**
+	 * @brief Parses HTML in a caller-declared encoding, text is stored as UTF-8.
+	 * @param html HTML source string (NULL-terminated)
+	 * @param hint Transport encoding (HTML_CHARSET_UNKNOWN to sniff <meta>)
+	 * @return Success: Root DOM node with children (caller owns)
+	 * @return Failure: NULL with error set
+	 * @note A UTF-8 byte order mark overrides the hint
+	 */
+	HTMLNode* html2tex_parse_charset(const char* html, HTMLCharset hint);
+
+	/**
+	 * @brief Parses HTML from a length-delimited buffer, such as a mapped file.
+	 * @param html HTML source bytes (need not be null-terminated)
+	 * @param length Source length in bytes
+	 * @param hint Transport encoding (HTML_CHARSET_UNKNOWN to sniff <meta>)
+	 * @return Success: Root DOM node with children (caller owns)
+	 * @return Failure: NULL with error set
+	 * @note The buffer is read in place and never copied as a whole
+	 */
+	HTMLNode* html2tex_parse_buffer(const char* html, size_t length, HTMLCharset hint);
+
 	/**
 	 * @brief Extracts document title from DOM using BFS.
 	 * @param root DOM tree root (typically from html2tex_parse())
@@ -191,6 +255,16 @@ extern "C" {
 	 */
 	char* html2tex_compress_html(const char* html);
 
+	/**
+	 * @brief Like html2tex_compress_html(), but reads a buffer that need not be null-terminated.
+	 * @param html Raw HTML bytes (NULL allowed when length is 0)
+	 * @param length Number of bytes to read
+	 * @param out_length Receives the compressed length (NULL allowed)
+	 * @return Success: Compressed HTML, null-terminated (caller must free)
+	 * @return Failure: NULL with error set
+	 */
+	char* html2tex_compress_html_buffer(const char* html, size_t length, size_t* out_length);
+
 	/**
 	 * @brief Retrieves attribute value with case-insensitive lookup.
 	 * @param attrs Attribute linked list head
@@ -201,6 +275,81 @@ extern "C" {
 	 */
 	const char* get_attribute(HTMLAttribute* attrs, const char* key);
 
+	/**
+	 * @brief Rebuilds the hot attribute index from the node attribute list.
+	 * @param node Node whose attribute list was created or modified (NULL-safe)
+	 * @note Must be called whenever node->attributes is assigned or changed
+	 */
+	void html2tex_index_attributes(HTMLNode* node);
+
+	/**
+	 * @brief Retrieves a hot attribute value in constant time.
+	 * @param node Node indexed by html2tex_index_attributes()
+	 * @param attr Hot attribute identifier
+	 * @return Found: Attribute value (do not free)
+	 * @return Not found: NULL (no error set)
+	 * @return NULL with error set on invalid arguments
+	 */
+	const char* get_hot_attribute(const HTMLNode* node, HTMLHotAttribute attr);
+
+	/**
+	 * @brief Clears an ancestor filter before a traversal.
+	 * @param filter Filter to reset
+	 */
+	void ancestor_filter_reset(AncestorFilter* filter);
+
+	/**
+	 * @brief Records a node as open, its descendants see it as an ancestor.
+	 * @param filter Active filter
+	 * @param node Element being entered (text and root nodes are ignored)
+	 */
+	void ancestor_filter_push(AncestorFilter* filter, const HTMLNode* node);
+
+	/**
+	 * @brief Removes a node previously recorded by ancestor_filter_push().
+	 * @param filter Active filter
+	 * @param node Element being left
+	 */
+	void ancestor_filter_pop(AncestorFilter* filter, const HTMLNode* node);
+
+	/**
+	 * @brief Hashes an ancestor key for filter lookups.
+	 * @param kind Key kind: 't' for tags, '#' for ids, '.' for classes
+	 * @param key Key text
+	 * @param len Key length in bytes
+	 * @return Hash usable with ancestor_filter_may_contain()
+	 */
+	unsigned int ancestor_filter_hash(char kind, const char* key, size_t len);
+
+	/**
+	 * @brief Tests whether some open ancestor may carry a key.
+	 * @param filter Active filter
+	 * @param hash Key hash from ancestor_filter_hash()
+	 * @return 0: No ancestor carries the key
+	 * @return 1: An ancestor may carry the key
+	 */
+	int ancestor_filter_may_contain(const AncestorFilter* filter, unsigned int hash);
+
+	/**
+	 * @brief Checks that the filter describes exactly the ancestors of a node.
+	 * @param filter Filter to check (NULL-safe)
+	 * @param node Node about to be queried
+	 * @return 1: Filter answers ancestor queries for this node
+	 * @return 0: Caller must walk the parent chain
+	 */
+	int ancestor_filter_covers(const AncestorFilter* filter, const HTMLNode* node);
+
+	/**
+	 * @brief Checks an ancestor context, in constant time when the filter covers the node.
+	 * @param filter Traversal filter (NULL walks the parent chain)
+	 * @param node HTML node to check
+	 * @param context Context to look for
+	 * @return 1: Inside the context
+	 * @return 0: Not inside the context
+	 * @return -1: Error
+	 */
+	int is_inside_context(const AncestorFilter* filter, const HTMLNode* node, HTMLContextFlag context);
+
 	/**
 	 * @brief Detects if processing is inside table cell (td/th).
 	 * @param converter Conversion context (may have state)
@@ -241,6 +390,10 @@ extern "C" {
 #ifndef HTML_TITLE_MAX_SIZE
 #define HTML_TITLE_MAX_SIZE 256
 #endif
+
+#ifndef HTML_PARSER_MIN_DEPTH
+#define HTML_PARSER_MIN_DEPTH 32
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -16,29 +16,27 @@ extern "C" {
 	typedef int (*DOMTreeVisitor)(const HTMLNode*, const void*);
 
 	/**
-	 * @brief Linked list node for element storage.
+	 * @brief Contiguous element array with amortized O(1) append and O(1) indexing.
 	*/
-	typedef struct HTMLElementList HTMLElementList;
+	typedef struct HTMLNodeList HTMLNodeList;
 
 	/**
-	 * @brief Optimized list structure with O(1) append operations and size tracking.
+	 * @brief Selects whether queries attach computed CSS to their matches.
 	*/
-	typedef struct HTMLNodeList HTMLNodeList;
+	typedef enum {
+		HTML2TEX_QUERY_STYLES = 0, /* compute css_props for every match */
+		HTML2TEX_QUERY_NO_STYLES = 1 /* skip CSS work, css_props is NULL */
+	} HTMLQueryMode;
 
 	struct HTMLElement {
 		HTMLNode* node; /* Pointer to DOM node (owned by caller) */
 		CSSProperties* css_props; /* Computed CSS properties (owned by this structure) */
 	};
 
-	struct HTMLElementList {
-		HTMLElement* element; /* Contained element */
-		struct HTMLElementList* next; /* Next list node */
-	};
-
 	struct HTMLNodeList {
-		HTMLElementList* head; /* First element in list */
-		HTMLElementList** tail; /* Pointer to last node's next pointer */
+		HTMLElement* items; /* Elements stored by value */
 		size_t node_count; /* Number of elements in list */
+		size_t capacity; /* Allocated element slots */
 	};
 
 	/**
@@ -49,12 +47,21 @@ extern "C" {
 	HTMLNodeList* html_nodelist_create(void);
 
 	/**
-	 * @brief Appends an HTMLElement to the list with O(1) complexity.
+	 * @brief Preallocates room for at least capacity elements.
 	 * @param list Target list (non-NULL)
-	 * @param element Element to append (non-NULL, ownership transferred)
+	 * @param capacity Minimum number of element slots
 	 * @return Success: 1
 	 * @return Failure: 0 with error set
 	 */
+	int html_nodelist_reserve(HTMLNodeList* list, size_t capacity);
+
+	/**
+	 * @brief Appends an HTMLElement to the list with amortized O(1) complexity.
+	 * @param list Target list (non-NULL)
+	 * @param element Heap element to append (non-NULL, ownership transferred)
+	 * @return Success: 1 (element contents moved into the list, container freed)
+	 * @return Failure: 0 with error set (caller keeps ownership)
+	 */
 	int html_nodelist_append(HTMLNodeList* list, HTMLElement* element);
 
 	/**
@@ -75,10 +82,10 @@ extern "C" {
 	int html_nodelist_extend(HTMLNodeList* dest, HTMLNodeList* src);
 
 	/**
-	 * @brief Retrieves element at specified index with bounds checking.
+	 * @brief Retrieves element at specified index in O(1) with bounds checking.
 	 * @param list List to query (can be NULL)
 	 * @param index Zero-based position
-	 * @return Success: HTMLElement* (list retains ownership)
+	 * @return Success: HTMLElement* (list retains ownership, valid until next append)
 	 * @return Failure: NULL (index out of bounds or NULL list)
 	*/
 	HTMLElement* html_nodelist_at(const HTMLNodeList* list, size_t index);
@@ -104,12 +111,12 @@ extern "C" {
 	void html_nodelist_destroy(HTMLNodeList** list);
 
 	/**
-	 * @brief Converts list to array and empties (but doesn't destroy) the list.
-	 * @param list Pointer to list pointer (list becomes empty)
-	 * @return Success: Array of HTMLElement* pointers (caller owns array and elements)
-	 * @return Failure: NULL with error set
+	 * @brief Hands the element array over to the caller and empties the list.
+	 * @param list Pointer to list pointer (list becomes empty, not destroyed)
+	 * @return Success: Array of html_nodelist_size() elements (caller owns array and CSS)
+	 * @return Empty list: NULL
 	*/
-	HTMLElement** html_nodelist_dismantle(HTMLNodeList** list);
+	HTMLElement* html_nodelist_dismantle(HTMLNodeList** list);
 
 	/**
 	 * @brief Performs depth-first traversal to find all DOM nodes matching a predicate.
@@ -135,6 +142,45 @@ extern "C" {
 	HTMLElement* html2tex_search_tree(const HTMLNode* root, DOMTreeVisitor predicate, 
 		const void* data, const CSSProperties* inherited_props);
 
+	/**
+	 * @brief Same as html2tex_find_all() with explicit style evaluation mode.
+	 * @param root Starting node for traversal (inclusive)
+	 * @param predicate Callback function that evaluates whether a node matches
+	 * @param data User-defined context passed to each predicate invocation
+	 * @param inherited_props Base CSS properties for the inheritance chain
+	 * @param mode HTML2TEX_QUERY_NO_STYLES skips CSS evaluation entirely
+	 * @return Success: HTMLNodeList* containing matched elements
+	 * @return Failure: NULL with error set
+	 * @note Styles are resolved only for matches, reusing shared ancestor paths
+	*/
+	HTMLNodeList* html2tex_find_all_ex(const HTMLNode* root, DOMTreeVisitor predicate,
+		const void* data, const CSSProperties* inherited_props, HTMLQueryMode mode);
+
+	/**
+	 * @brief Same as html2tex_search_tree() with explicit style evaluation mode.
+	 * @param root Starting node for DFS search
+	 * @param predicate Matching function (returns non-zero for match)
+	 * @param data User context passed to predicate
+	 * @param inherited_props Base CSS properties for inheritance chain
+	 * @param mode HTML2TEX_QUERY_NO_STYLES skips CSS evaluation entirely
+	 * @return Success: HTMLElement with node (+ computed CSS in styles mode)
+	 * @return Not found: NULL (no error set)
+	 * @return Failure: NULL with error set
+	 */
+	HTMLElement* html2tex_search_tree_ex(const HTMLNode* root, DOMTreeVisitor predicate,
+		const void* data, const CSSProperties* inherited_props, HTMLQueryMode mode);
+
+	/**
+	 * @brief Computes the CSS of a node from the inline styles on its ancestor path.
+	 * @param node Node whose style is computed
+	 * @param root Ancestor where inheritance starts (NULL for the document root)
+	 * @param inherited_props Base CSS properties applied above root
+	 * @return Success: Computed properties (caller owns, empty if none apply)
+	 * @return Failure: NULL with error set
+	 */
+	CSSProperties* html2tex_compute_style(const HTMLNode* node, const HTMLNode* root,
+		const CSSProperties* inherited_props);
+
 	/**
 	 * @brief Safely deallocates HTMLElement structure from html2tex_search_tree().
 	 * @param elem Element to destroy (NULL-safe)
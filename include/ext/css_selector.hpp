@@ -0,0 +1,55 @@
+#ifndef HTMLTEX_CSS_SELECTOR_HPP
+#define HTMLTEX_CSS_SELECTOR_HPP
+
+#include "dom_tree.h"
+#include "css_stylesheet.h"
+#include "html_exception.hpp"
+#include <memory>
+#include <string>
+
+/**
+ * @class CssSelector
+ * @brief Compiled CSS selector used by HtmlDocument::querySelector().
+ *
+ * Wraps the selector compiler of the embedded stylesheets (css_selector_compile()),
+ * so queries and style elements accept the same grammar. Supported syntax:
+ *
+ * - type (`td`), universal (`*`), id (`#main`) and class (`.price`) selectors
+ * - attribute selectors: `[a]`, `[a=v]`, `[a~=v]`, `[a^=v]`, `[a$=v]`, `[a*=v]`
+ * - `:nth-child(an+b|odd|even)`, `:nth-last-child()`, `:first-child`, `:last-child`
+ * - descendant (whitespace) and child (`>`) combinators
+ * - selector lists separated by commas
+ *
+ * @note Instances are immutable after construction and safe to share between threads
+ */
+class CssSelector {
+public:
+    /**
+     * @brief Compiles a selector string.
+     * @param selector Selector text (e.g. "td.price > span")
+     * @throws HtmlRuntimeException if the selector is empty or malformed
+     */
+    explicit CssSelector(const std::string& selector);
+
+    /**
+     * @brief Tests whether a node matches any alternative of the selector.
+     * @param node Candidate node (text nodes never match)
+     * @param root Document root, stands in as the parent of top-level nodes for position tests
+     * @return true if the node matches, false otherwise
+     */
+    bool matches(const HTMLNode* node, const HTMLNode* root = nullptr) const;
+
+    /**
+     * @brief Gets the source text the selector was compiled from.
+     * @return Original selector string
+     */
+    const std::string& text() const noexcept;
+
+private:
+    friend class HtmlDocument;
+
+    std::shared_ptr<const CSSSelector> compiled;
+    std::string source;
+};
+
+#endif
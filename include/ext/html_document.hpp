@@ -5,6 +5,8 @@
 #include "dom_tree_visitor.h"
 #include "html_exception.hpp"
 #include "css_properties.h"
+#include "css_selector.hpp"
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,8 +24,56 @@
  */
 class HtmlDocument {
 private:
-    static int getElementByIdPredicate(const HTMLNode* root, const void* data);
-    static int getElementByClassPredicate(const HTMLNode* root, const void* data);
+    struct DocumentIndex;
+    struct IndexSlot;
+
+    /**
+     * @brief Gets the index slot shared by all copies of this document, creating it on first use.
+     * @return Index slot (never null)
+     */
+    std::shared_ptr<IndexSlot> indexSlot() const;
+
+    /**
+     * @brief Gets the index generation shared with every document reached from this one.
+     * @return Generation counter (never null), bumped by invalidateIndex()
+     */
+    std::shared_ptr<std::atomic<unsigned long>> indexGeneration() const;
+
+    /**
+     * @brief Wraps a node of the same tree, sharing the index generation of this document.
+     * @param target Node to wrap (nullptr gives an invalid document)
+     * @return Document whose index goes stale together with this one
+     */
+    HtmlDocument related(HTMLNode* target) const;
+
+    /**
+     * @brief Builds the id/class/tag index for this subtree on first use.
+     * @return Current index, kept alive for the caller even if it is invalidated meanwhile
+     * @note Concurrent first queries build it once, under the lock of the shared slot
+     */
+    std::shared_ptr<const DocumentIndex> documentIndex() const;
+
+    /**
+     * @brief Resolves matching nodes for a class query through the index.
+     * @param className One or more whitespace-separated class tokens
+     * @return Nodes carrying every token, in document order
+     */
+    std::vector<HTMLNode*> indexedClassMatches(const std::string& className) const;
+
+    /**
+     * @brief Wraps a descendant with its computed CSS properties.
+     * @param target Descendant node of this document (inclusive)
+     * @return Element owning its computed CSS (invalid on failure)
+     */
+    HtmlDocument makeElement(HTMLNode* target) const;
+
+    /**
+     * @brief Collects descendants matching a compiled selector.
+     * @param selector Compiled selector
+     * @param firstOnly Stop after the first match
+     * @return Matching nodes in document order
+     */
+    std::vector<HTMLNode*> selectorMatches(const CssSelector& selector, bool firstOnly) const;
 
 public:
     class Iterator;
@@ -230,8 +280,8 @@ public:
     HtmlDocument getFirstElementById(const std::string& id) const;
 
     /**
-     * @brief Finds the first descendant matching a specific class name attribute value.
-     * @param className The class name attribute value of HTML tree node
+     * @brief Finds the first descendant whose class list contains the given tokens.
+     * @param className One or more whitespace-separated class names
      * @return First matching element (invalid if none found)
      */
     HtmlDocument getFirstElementByClassName(const std::string& className) const;
@@ -240,17 +290,21 @@ public:
      * @brief Finds the first descendant matching a predicate.
      * @param predicate Function returning true for matching elements
      * @param content The user text content, passed to the predicate
+     * @param computeStyles Whether to attach computed CSS to the result
      * @return First matching element (invalid if none found)
      */
-    HtmlDocument findFirst(DOMTreeVisitor predicate, const std::string& content) const;
+    HtmlDocument findFirst(DOMTreeVisitor predicate, const std::string& content,
+        bool computeStyles = true) const;
 
     /**
      * @brief Finds all descendants matching a predicate.
      * @param predicate Function returning true for matching elements
      * @param content The user text content, passed to the predicate
+     * @param computeStyles Whether to attach computed CSS to each result
      * @return Vector of matching elements
      */
-    std::vector<HtmlDocument> findAll(DOMTreeVisitor predicate, const std::string& content) const;
+    std::vector<HtmlDocument> findAll(DOMTreeVisitor predicate, const std::string& content,
+        bool computeStyles = true) const;
 
     /**
      * @brief Finds all descendants matching a specific ID attribute value.
@@ -260,8 +314,8 @@ public:
     std::vector<HtmlDocument> findAllElementsById(const std::string& id) const;
 
     /**
-     * @brief Finds all descendants matching a specific class name attribute value.
-     * @param className The class name attribute value of HTML tree node
+     * @brief Finds all descendants whose class list contains the given tokens.
+     * @param className One or more whitespace-separated class names
      * @return Vector of matching elements
      */
     std::vector<HtmlDocument> findAllElementsByClassName(const std::string& className) const;
@@ -290,6 +344,36 @@ public:
      */
     bool hasAnyElement(DOMTreeVisitor predicate, const std::string content) const;
 
+    /**
+     * @brief Finds the first descendant matching a CSS selector.
+     * @param selector Selector text (e.g. "table.data td:nth-child(2)")
+     * @return First matching element (invalid if none found)
+     * @throws HtmlRuntimeException if the selector is malformed
+     */
+    HtmlDocument querySelector(const std::string& selector) const;
+
+    /**
+     * @brief Finds the first descendant matching a precompiled selector.
+     * @param selector Compiled selector, reusable across documents
+     * @return First matching element (invalid if none found)
+     */
+    HtmlDocument querySelector(const CssSelector& selector) const;
+
+    /**
+     * @brief Finds all descendants matching a CSS selector.
+     * @param selector Selector text (e.g. "ul > li.item")
+     * @return Vector of matching elements in document order
+     * @throws HtmlRuntimeException if the selector is malformed
+     */
+    std::vector<HtmlDocument> querySelectorAll(const std::string& selector) const;
+
+    /**
+     * @brief Finds all descendants matching a precompiled selector.
+     * @param selector Compiled selector, reusable across documents
+     * @return Vector of matching elements in document order
+     */
+    std::vector<HtmlDocument> querySelectorAll(const CssSelector& selector) const;
+
     // Range-based for loop support
 
     /**
@@ -321,10 +405,22 @@ public:
      */
     static HtmlDocument fromRawElement(HTMLElement* elem);
 
+    /**
+     * @brief Discards the id/class/tag index so the next query rebuilds it.
+     * @note Must be called after the underlying tree is modified through rawNode(),
+     *       every copy of this document sees the index as stale afterwards, as do the
+     *       documents reached from it (navigation, queries, iteration) and the one it
+     *       was reached from
+     * @warning Const queries may run concurrently, but not while the tree is modified
+     */
+    void invalidateIndex() const noexcept;
+
 private:
     HTMLNode* node;
     CSSProperties* props;
     bool hasProps;
+    mutable std::shared_ptr<IndexSlot> index;
+    mutable std::shared_ptr<std::atomic<unsigned long>> generation;
 };
 
 /**
@@ -352,6 +448,7 @@ public:
     bool operator!=(const Iterator& other) const noexcept;
 
 private:
+    friend class HtmlDocument;
     HTMLNode* current;
     CSSProperties* props;
     HtmlDocument element;
@@ -382,6 +479,7 @@ public:
     bool operator!=(const ConstIterator& other) const noexcept;
 
 private:
+    friend class HtmlDocument;
     const HTMLNode* current;
     CSSProperties* props;
     HtmlDocument element;
@@ -4,16 +4,16 @@
  * @section Overview
  *
  * ImageManager provides efficient, thread-safe asynchronous downloading of images
- * referenced in HTML documents during conversion to LaTeX. It wraps the existing
- * C API (download_image_src) with modern C++14 concurrency primitives, offering
- * both synchronous and asynchronous download patterns with automatic resource
+ * referenced in HTML documents during conversion to LaTeX. It wraps the C download
+ * engine (html_download_engine_*) with modern C++14 futures, offering both
+ * synchronous and asynchronous download patterns with automatic resource
  * management.
  *
  * @section Design Philosophy
  *
  * - Minimal overhead: Direct mapping to underlying C API without abstraction layers
  * - Thread safety: Lock-free where possible, mutex-protected where required
- * - RAII: Automatic cleanup of threads and CURL resources
+ * - RAII: Automatic cleanup of event loop tasks and CURL resources
  * - Non-intrusive: No modifications to existing converter workflows
  * - Failure transparency: Exceptions propagate through futures when appropriate
  *
@@ -21,13 +21,14 @@
  *
  * - Public member functions are thread-safe
  * - Multiple threads may call downloadAsync() concurrently
- * - Internal synchronization uses single producer-consumer queue
- * - Worker threads are isolated from each other
+ * - Transfers are multiplexed on a single curl_multi event loop, run as a task
+ *   of the process-wide executor (see TaskExecutor) rather than a thread of its own
+ * - Pooled handles reuse connections, DNS lookups and TLS sessions
  *
  * @section Resource Management
  *
- * - CURL is initialized once globally (thread-safe)
- * - Thread pool created on construction, joined on destruction
+ * - CURL is initialized by the download engine (reference counted)
+ * - Event loop scheduled on demand, released on destruction
  * - Pending promises are rejected with exception on destruction
  * - All heap allocations are exception-safe
  *
@@ -41,11 +42,11 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <memory>
 #include <future>
-#include <queue>
+#include <functional>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <thread>
 #include "html2tex.h"
@@ -55,7 +56,7 @@
   * @class ImageManager
   * @brief Manages concurrent downloading of images from URLs and data URIs.
   *
-  * Provides a fixed-size thread pool for downloading images asynchronously while
+  * Drives all downloads from one event loop task asynchronously while
   * 
   * maintaining the order of completion requests. Each download is independent and
   * 
@@ -83,38 +84,76 @@ public:
         bool success = false;              ///< Whether download succeeded
         std::string error;         ///< Error description if failed
         int sequence_number = 0;       ///< Request sequence number
+        std::vector<unsigned char> data;   ///< Image bytes (Delivery::Memory only)
+        std::string content_type;  ///< MIME type reported by the server or data URI
+        std::string filename;      ///< Suggested file name, the last component of local_path
     };
 
     /**
-     * @brief Constructs ImageManager with specified thread pool size.
+     * @enum Delivery
+     * @brief Where downloaded images go.
+     */
+    enum class Delivery {
+        File,      ///< Written to local_path
+        Memory,    ///< Kept in DownloadResult::data, nothing is written
+        Stream     ///< Handed to a StreamWriter as they arrive, nothing is written
+    };
+
+    /**
+     * @brief Receives the bytes of an image in order, false fails its download.
+     *
+     * The image describes the download (url, local_path, filename, content_type
+     * 
+     * and sequence_number). Runs on the event loop, exceptions count as false.
+     */
+    using StreamWriter = std::function<bool(const DownloadResult& image,
+        const void* data, size_t size)>;
+
+    /**
+     * @brief Constructs ImageManager with specified connection limit.
      *
-     * Initializes global CURL context and creates worker threads. CURL is
+     * Starts a download engine with one curl_multi event loop. Any number of
      * 
-     * initialized only once globally, even with multiple ImageManager instances.
+     * downloads may be in flight, they share the loop and its pooled connections.
      *
-     * @param max_workers Number of concurrent download threads
-     *        - 0: Uses std::thread::hardware_concurrency()
-     *        - >0: Uses specified number (capped at system limits)
-     *        - Default: 4 threads (balanced for typical I/O workloads)
+     * @param max_workers Maximum number of open connections
+     *        - 0: Uses HTML_DOWNLOAD_MAX_CONNECTIONS
+     *        - >0: Uses specified number
+     *        - Default: 4 connections
      *
-     * @throws std::system_error if thread creation fails
-     * @throws ImageRuntimeException if CURL initialization fails
+     * @throws ImageRuntimeException if CURL, the event loop or the executor cannot be initialized
      *
-     * @note Thread count should balance between I/O parallelism and system load
-     * @warning Excessive threads may degrade performance due to context switching
+     * @note Transfers beyond the limit wait in per-host queues served round-robin,
+     *       throttling hosts (429/503) are backed off and retried
      */
     explicit ImageManager(size_t max_workers = 4);
 
+    /**
+     * @brief Constructs ImageManager reading images through a fetcher.
+     *
+     * No download engine is started, every request goes to the fetcher.
+     * 
+     * Blocking backends complete a download inside downloadAsync().
+     *
+     * @param fetcher Image fetcher (not owned, must outlive the manager)
+     *
+     * @note Requests the fetcher does not serve fail with HTML2TEX_ERR_IMAGE_DOWNLOAD,
+     *       cancelAll() cancels the fetches of every user of the fetcher
+     * @see image_fetcher_chain_create() to combine backends
+     */
+    explicit ImageManager(ImageFetcher& fetcher);
+
     /**
      * @brief Destructor - ensures graceful shutdown.
      *
      * Performs ordered shutdown:
-     * 1. Signals all workers to stop
-     * 2. Rejects pending promises with std::runtime_error
-     * 3. Joins all worker threads
+     * 1. Signals shutdown
+     * 2. Aborts transfers and rejects their promises with std::runtime_error
+     * 3. Waits for the event loop task to return
      * 4. Cleans up global CURL resources (if last instance)
      *
-     * @note Blocks until all in-progress downloads complete
+     * @note Blocks until the event loop has stopped, a fetcher-backed manager
+     *       waits for its fetches to complete instead
      * @warning Pending async operations receive std::runtime_error exception
      */
     ~ImageManager();
@@ -132,7 +171,9 @@ public:
      *
      * Queues the download request and returns immediately. The download executes
      * 
-     * on a worker thread from the pool. Result is accessible via the returned future.
+     * on the event loop task. Result is accessible via the returned future.
+     * 
+     * Data URIs are decoded on the calling thread.
      *
      * @param request Complete download specification
      * @return std::future<DownloadResult> Future containing eventual result
@@ -141,11 +182,13 @@ public:
      * @throws std::bad_alloc if memory allocation fails
      *
      * @par Performance characteristics:
-     * - O(1) queue insertion (amortized)
-     * - Lock contention limited to queue mutex
+     * - O(1) submission to the event loop
+     * - Lock contention limited to the loop's submission mutex
      * - Memory: sizeof(DownloadRequest) + promise overhead
      *
      * @note Future may throw ImageRuntimeException if download fails
+     * @note A request for a URL and directory already in flight joins that
+     *       transfer and shares its file, see getDedupHits()
      * @warning Request output_dir must exist or be creatable
      *
      * @see downloadSync() for blocking alternative
@@ -185,7 +228,7 @@ public:
      * @throws std::bad_alloc if memory allocation fails
      *
      * @par Concurrency behavior:
-     * - All downloads start immediately (subject to thread pool limits)
+     * - All downloads start immediately (subject to connection limits)
      * - Method blocks until all downloads complete
      * - Ordering of completion is non-deterministic
      * - Ordering of results matches input requests
@@ -204,7 +247,7 @@ public:
      *
      * @par Implementation details:
      * - Polls internal state with 10ms sleeps
-     * - Returns when task queue is empty and no active workers
+     * - Returns when no transfer is pending
      * - Does not prevent new downloads during wait
      *
      * @note May return while other threads add new tasks
@@ -215,17 +258,15 @@ public:
     /**
      * @brief Cancels all pending downloads immediately.
      *
-     * Removes all queued tasks and rejects their promises with
-     * std::runtime_error.
-     * 
-     * Actively executing downloads continue to completion.
+     * Aborts queued and running transfers and rejects their promises
+     * with std::runtime_error.
      *
      * @par Use cases:
      * - Application shutdown
      * - User cancellation
      * - Error recovery
      *
-     * @note Active downloads are not interrupted
+     * @note Running transfers are interrupted, partial files are removed
      * @warning Cancelled promises throw std::runtime_error when accessed
      */
     void cancelAll();
@@ -239,9 +280,7 @@ public:
      * 
      * activity.
      *
-     * @return true if any of:
-     *         - Tasks are queued but not yet started
-     *         - Workers are actively downloading
+     * @return true if any transfer is queued or running,
      *         false otherwise
      *
      * @note Race condition: State may change immediately after check
@@ -249,26 +288,69 @@ public:
      */
     bool isActive() const;
 
+    /**
+     * @brief Counts requests that joined a transfer already in flight.
+     *
+     * @return Number of downloads served by another request's transfer
+     *
+     * @note O(1) atomic read, no locking
+     */
+    size_t getDedupHits() const noexcept;
+
+    /**
+     * @brief Selects where downloaded images go.
+     *
+     * local_path still names the file the converter references, memory and
+     * 
+     * stream deliveries neither write it nor create the output directory.
+     *
+     * @param mode Delivery mode (Delivery::File by default)
+     * @param writer Receiver of Delivery::Stream, ignored otherwise
+     *
+     * @throws std::invalid_argument for Delivery::Stream without a writer, or a
+     *         delivery other than Delivery::File on a fetcher-backed manager
+     * @throws std::runtime_error while downloads are active
+     *
+     * @note Requests that joined a transfer share its outcome and, in memory,
+     *       its bytes. They are not streamed a second time
+     * @warning Not synchronized with downloadAsync(), select before downloading
+     */
+    void setDelivery(Delivery mode, StreamWriter writer = nullptr);
+
 private:
+    struct PendingDownload;
+
     /**
-     * @brief Worker thread entry point.
+     * @brief Engine completion callback.
      *
-     * Each worker thread executes this function, continuously:
-     * 1. Waiting for tasks on queue
-     * 2. Executing download via download_image_src()
-     * 3. Fulfilling promise with result
+     * Runs on the event loop task, fulfills the promise of the
+     * 
+     * finished transfer and releases its pending record.
      *
-     * @note Thread-safe access to task queue via mutex
-     * @warning Catches all exceptions to prevent thread termination
+     * @note Cancelled transfers reject their promise with std::runtime_error
      */
-    void workerThread();
+    static void onTransferDone(const char* url, const char* path,
+        const char* error, void* user_data);
+
+    /**
+     * @brief Receiver callbacks of memory and stream deliveries.
+     *
+     * Run on the event loop, or on the calling thread for data URIs.
+     */
+    static int onDeliveryBegin(const char* content_type, void* user_data);
+    static int onDeliveryWrite(const void* data, size_t size, void* user_data);
+    static const HTMLDownloadSink delivery_sink;
+
+    HTMLDownloadEngine* engine = nullptr;          ///< curl_multi download engine
+    ImageFetcher* fetcher = nullptr;               ///< Serves requests instead of the engine when set
+    std::atomic<bool> stop_flag{ false };          ///< Shutdown signal
+    std::atomic<size_t> active_downloads{ 0 };     ///< Transfers not completed yet
+    std::atomic<size_t> dedup_hits{ 0 };           ///< Requests that joined a transfer
+    Delivery delivery = Delivery::File;            ///< Where images go
+    StreamWriter writer;                           ///< Receiver of Delivery::Stream
 
-    std::queue<std::pair<DownloadRequest, std::promise<DownloadResult>>> task_queue;
-    mutable std::mutex queue_mutex;          ///< Protects task_queue
-    std::condition_variable queue_cv;        ///< Signals task availability
-    std::vector<std::thread> workers;        ///< Worker thread handles
-    std::atomic<bool> stop_flag{ false };      ///< Shutdown signal
-    std::atomic<size_t> active_workers{ 0 };   ///< Currently executing workers
+    std::mutex flights_mutex;                                  ///< Guards flights
+    std::unordered_map<std::string, PendingDownload*> flights; ///< In-flight transfers by URL and directory
 };
 
 #endif
\ No newline at end of file
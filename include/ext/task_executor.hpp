@@ -0,0 +1,113 @@
+/**
+ * @brief Process-wide task executor shared by downloads and conversions
+ *
+ * @section Overview
+ *
+ * TaskExecutor wraps the C executor (html_executor_*) that also runs the
+ * download engines of ImageManager, ImageDownloader and image conversions.
+ * Every instance is a pool of one priority on the same worker threads, so
+ * the process never runs more workers than html_executor_threads().
+ *
+ * @section Thread Safety
+ *
+ * - submit() and pending() may be called from any thread, tasks included
+ * - Workers take higher priorities first and steal from each other when idle
+ * - Workers start with the first pool and stop with the last one
+ *
+ * @note This class is non-copyable and non-movable
+ */
+
+#ifndef TASK_EXECUTOR_HPP
+#define TASK_EXECUTOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include "html2tex.h"
+#include "base_exception.hpp"
+
+ /**
+  * @class TaskExecutor
+  * @brief Pool of tasks run on the process-wide executor.
+  */
+class TaskExecutor {
+public:
+    /**
+     * @brief Scheduling priority of every task of the pool.
+     */
+    enum class Priority {
+        Low = HTML_PRIORITY_LOW,
+        Normal = HTML_PRIORITY_NORMAL,
+        High = HTML_PRIORITY_HIGH
+    };
+
+    /**
+     * @brief Sets the number of worker threads of the process-wide executor.
+     *
+     * @param threads Worker count (0 for the CPU count)
+     *
+     * @throws RuntimeException if workers are already running
+     *
+     * @note Call before the first pool, ImageManager or conversion is created
+     */
+    static void configure(size_t threads);
+
+    /**
+     * @brief Gets the worker count, the global concurrency limit of all pools.
+     *
+     * @return Worker thread count
+     */
+    static size_t threads() noexcept;
+
+    /**
+     * @brief Creates a pool on the process-wide executor.
+     *
+     * @param priority Priority of the tasks submitted to this pool
+     *
+     * @throws RuntimeException if the pool or the workers cannot be created
+     */
+    explicit TaskExecutor(Priority priority = Priority::Normal);
+
+    /**
+     * @brief Waits for every submitted task, then releases the pool.
+     *
+     * @warning Must not run on a task of this pool
+     */
+    ~TaskExecutor();
+
+    // Non-copyable and non-movable - tasks keep a pointer to the pool
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    /**
+     * @brief Runs a function on an executor worker.
+     *
+     * @param task Function to run
+     * @return std::future<void> Ready once the task returns, holds its exception if it threw
+     *
+     * @throws RuntimeException if the task cannot be queued
+     * @throws std::bad_alloc if memory allocation fails
+     *
+     * @note Tasks submitted from a worker run on that worker first, others may steal them
+     */
+    std::future<void> submit(std::function<void()> task);
+
+    /**
+     * @brief Counts tasks of this pool not finished yet.
+     *
+     * @return Pending task count
+     *
+     * @note O(1) atomic read, no locking
+     */
+    size_t pending() const noexcept;
+
+private:
+    /**
+     * @brief Executor entry point, runs and frees one submitted task.
+     */
+    static void runTask(void* arg);
+
+    HTMLExecutorPool* pool = nullptr;   ///< C executor pool
+};
+
+#endif
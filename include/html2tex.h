@@ -4,19 +4,29 @@
 #include <stddef.h>
 #include "dom_tree.h"
 #include "image_utils.h"
+#include "image_fetcher.h"
 #include "image_storage.h"
 #include "string_buffer.h"
 #include "html2tex_stack.h"
 #include "html2tex_queue.h"
 #include "css_properties.h"
+#include "css_stylesheet.h"
+#include "html_entities.h"
+#include "html_charset.h"
+#include "html_compress.h"
+#include "html_mapped_file.h"
+#include "html_image_cache.h"
+#include "html_work_queue.h"
+#include "html_executor.h"
+#include "html_download_engine.h"
 #include "html2tex_processor.h"
 #ifndef __cplusplus
-#include "image_downloader.h"
 #include "html2tex_thread.h"
 #include "atomic_types.h"
 #endif
 #include "dom_tree_visitor.h"
 #include "html2tex_errors.h"
+#include "html2tex_alloc.h"
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -25,10 +35,23 @@ extern "C" {
 	typedef struct ConverterState ConverterState;
 	typedef struct LaTeXConverter LaTeXConverter;
 	typedef struct ImageStorage ImageStorage;
+	typedef struct ImageURLEntry ImageURLEntry;
+
+	/* local path given to an image URL, path is NULL while only queued */
+	struct ImageURLEntry {
+		char* url;
+		char* path;
+	};
 
 	struct ImageStorage {
 		int lazy_downloading;
 		Stack* image_stack;
+
+		/* image URLs of the current document, open addressing */
+		ImageURLEntry* urls;
+		size_t url_capacity;
+		size_t url_count;
+		size_t dedup_hits;
 	};
 
 	/* converter configuration */
@@ -68,10 +91,22 @@ extern "C" {
 		StringBuffer* buffer;
 		ConverterState state;
 		CSSProperties* current_css;
+		CSSStylesheet* stylesheet;
+		AncestorFilter* ancestors;
+		CSSMatchContext* match_context;
 		ImageStorage* store;
+		ImagePrefetch* prefetch;
+		ImageFetcher* fetcher;
 		char* image_output_dir;
 		int download_images;
 		int image_counter;
+		HTMLCharset input_charset;
+		const HTML2TeXAllocator* allocator;
+		ImageDelivery image_delivery;
+		ImageStreamWriter image_writer;
+		void* image_writer_data;
+		DownloadResult** images;
+		size_t image_count;
 	};
 
 	/**
@@ -81,6 +116,17 @@ extern "C" {
 	 */
 	LaTeXConverter* html2tex_create(void);
 
+	/**
+	 * @brief Initializes a conversion context whose allocations go through its own allocator.
+	 * @param allocator Hooks for this converter (NULL uses the process-wide allocator),
+	 *        must outlive the converter
+	 * @return Success: Valid LaTeXConverter* ready for configuration
+	 * @return Failure: NULL with error set
+	 * @note Documents returned by html2tex_convert() are allocated with it too,
+	 *       release them through allocator->free_fn
+	 */
+	LaTeXConverter* html2tex_create_with_allocator(const HTML2TeXAllocator* allocator);
+
 	/**
 	 * @brief Creates a deep copy of converter state for branching or checkpointing.
 	 * @param converter Valid converter to duplicate (non-NULL)
@@ -98,12 +144,23 @@ extern "C" {
 	/**
 	 * @brief Converts HTML document to complete LaTeX document with preamble.
 	 * @param converter Configured conversion context
-	 * @param html HTML source string (UTF-8, NULL-terminated)
+	 * @param html HTML source string (NULL-terminated, see html2tex_set_input_charset())
 	 * @return Success: Complete LaTeX document (caller owns, must free())
 	 * @return Failure: NULL with error set
 	 */
 	char* html2tex_convert(LaTeXConverter* converter, const char* html);
 
+	/**
+	 * @brief Converts an HTML file to a LaTeX file, parsing the memory-mapped input in place.
+	 * @param converter Configured conversion context
+	 * @param path HTML input file (gzip and zlib archives are inflated first)
+	 * @param out_path LaTeX output file (".gz" writes gzip, ".zz" writes zlib)
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_MALFORMED when an archive inflates past HTML_COMPRESSION_MAX_INFLATED)
+	 * @note The mapped input is normalized like html2tex_convert() does, so both give the same LaTeX
+	 */
+	int html2tex_convert_file(LaTeXConverter* converter, const char* path, const char* out_path);
+
 	/**
 	 * @brief Retrieves the most recent error code from thread-local storage.
 	 * @return Current HTML2TeXError enum value
@@ -166,9 +223,63 @@ extern "C" {
 	 * @brief Enables or disables automatic image download and local storage.
 	 * @param converter Active conversion context
 	 * @param enable Non-zero to enable, zero to disable
+	 * @note Remote images download in the background while the document is converted,
+	 *       html2tex_convert() waits for them before returning
 	 */
 	void html2tex_set_download_images(LaTeXConverter* converter, int enable);
 
+	/**
+	 * @brief Routes the image downloads of a converter through a fetcher.
+	 * @param converter Active conversion context
+	 * @param fetcher Image fetcher (NULL restores the shared libcurl engine), not owned,
+	 *        must outlive the conversions using it
+	 * @note Sources the fetcher does not serve fail instead of falling back to the network,
+	 *       combine backends with image_fetcher_chain_create() for that. Copies of the
+	 *       converter share the fetcher. Fetchers only deliver files, so a fetcher is
+	 *       rejected with HTML2TEX_ERR_INVAL while a memory or stream delivery is selected
+	 */
+	void html2tex_set_image_fetcher(LaTeXConverter* converter, ImageFetcher* fetcher);
+
+	/**
+	 * @brief Selects where the images a converter downloads go.
+	 * @param converter Active conversion context
+	 * @param delivery Delivery mode (IMAGE_DELIVERY_FILE by default)
+	 * @param writer Receiver for IMAGE_DELIVERY_STREAM (copied, NULL otherwise)
+	 * @param user_data Context for the writer, copies of the converter share it
+	 * @note The document references the same paths below the image directory, memory and
+	 *       stream deliveries neither write them nor create the directory. Each image of a
+	 *       document is delivered once, on the converting thread for data URIs and on the
+	 *       event loop otherwise. Converters with an image fetcher only deliver files, other
+	 *       modes are rejected with HTML2TEX_ERR_INVAL and the current delivery is kept
+	 */
+	void html2tex_set_image_delivery(LaTeXConverter* converter, ImageDelivery delivery,
+		const ImageStreamWriter* writer, void* user_data);
+
+	/**
+	 * @brief Gets the images the last conversion delivered in memory.
+	 * @param converter Conversion context (NULL-safe)
+	 * @param count Receives the number of images (may be NULL)
+	 * @return Images in document order, valid until the next conversion (NULL when there are none)
+	 * @note Each result has data, size, content_type, filename and the local_path
+	 *       the document references
+	 */
+	const DownloadResult* const* html2tex_get_delivered_images(const LaTeXConverter* converter,
+		size_t* count);
+
+	/**
+	 * @brief Gets how many image references of the last conversion reused an earlier download.
+	 * @param converter Conversion context (NULL-safe)
+	 * @return Deduplication hit count, repeats of a URL within a document share one file
+	 */
+	size_t html2tex_get_image_dedup_hits(const LaTeXConverter* converter);
+
+	/**
+	 * @brief Declares the encoding of HTML passed to html2tex_convert().
+	 * @param converter Active conversion context
+	 * @param charset Transport encoding (HTML_CHARSET_UNKNOWN to sniff BOM and <meta>)
+	 */
+	void html2tex_set_input_charset(LaTeXConverter* converter, HTMLCharset charset);
+
 	/**
 	 * @brief Portable string duplication with unified error handling.
 	 * @param str Source string to duplicate (NULL-safe)
@@ -242,7 +353,6 @@ extern "C" {
 	int count_table_columns(const HTMLNode* node);
 
 #ifdef _MSC_VER
-#define strdup html2tex_strdup
 #define html2tex_itoa(value, buffer, radix) _itoa((value), (buffer), (radix))
 #else
 #define html2tex_itoa(value, buffer, radix) portable_itoa((value), (buffer), (radix))
@@ -4,6 +4,8 @@
 #include "html_parser.hpp"
 #include "htmltex_converter.hpp"
 #include "ext/html_document.hpp"
+#include "ext/css_selector.hpp"
 #include "ext/image_manager.hpp"
+#include "ext/task_executor.hpp"
 
 #endif
\ No newline at end of file
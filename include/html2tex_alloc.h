@@ -0,0 +1,119 @@
+#ifndef HTML2TEX_ALLOC_H
+#define HTML2TEX_ALLOC_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTML2TeXAllocator HTML2TeXAllocator;
+	typedef struct HTML2TeXAllocStats HTML2TeXAllocStats;
+	typedef struct HTML2TeXAccountingAllocator HTML2TeXAccountingAllocator;
+
+	/* Memory hooks used for every allocation made by the library. */
+	struct HTML2TeXAllocator {
+		void* (*malloc_fn)(void* user_data, size_t size);
+		void* (*realloc_fn)(void* user_data, void* ptr, size_t size);
+		void (*free_fn)(void* user_data, void* ptr);
+		void* user_data;
+	};
+
+	/* Usage counters of an accounting allocator, in bytes requested. */
+	struct HTML2TeXAllocStats {
+		size_t current;
+		size_t peak;
+		size_t total;
+		size_t allocations;
+	};
+
+	/* Allocator wrapper that measures the usage of another allocator,
+	install its allocator member and read stats after a conversion.
+	*/
+	struct HTML2TeXAccountingAllocator {
+		HTML2TeXAllocator allocator;
+		const HTML2TeXAllocator* backing;
+		HTML2TeXAllocStats stats;
+	};
+
+	/**
+	 * @brief Replaces the process-wide allocator.
+	 * @param allocator Hooks to install (NULL restores malloc/realloc/free)
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_INVAL for missing hooks)
+	 * @warning Call before any other library function, memory allocated with
+	 *          the previous allocator must not be released afterwards
+	 */
+	int html2tex_set_allocator(const HTML2TeXAllocator* allocator);
+
+	/**
+	 * @brief Gets the allocator serving the calling thread.
+	 * @return Allocator of the conversion in progress on this thread, else the process-wide one
+	 */
+	const HTML2TeXAllocator* html2tex_get_allocator(void);
+
+	/**
+	 * @brief Routes the calling thread's allocations to another allocator.
+	 * @param allocator Allocator to activate (NULL selects the process-wide one)
+	 * @return Previously active allocator, to hand to html2tex_allocator_leave()
+	 * @note Scopes nest, every block must be released inside the scope that allocated it
+	 */
+	const HTML2TeXAllocator* html2tex_allocator_enter(const HTML2TeXAllocator* allocator);
+
+	/**
+	 * @brief Restores the allocator active before html2tex_allocator_enter().
+	 * @param previous Value returned by the matching html2tex_allocator_enter()
+	 */
+	void html2tex_allocator_leave(const HTML2TeXAllocator* previous);
+
+	/**
+	 * @brief Allocates memory through the active allocator.
+	 * @param size Bytes to allocate
+	 * @return Success: Block (release with html2tex_free())
+	 * @return Failure: NULL (no error set, callers report their own context)
+	 */
+	void* html2tex_malloc(size_t size);
+
+	/**
+	 * @brief Allocates zeroed memory for an array through the active allocator.
+	 * @param count Number of elements
+	 * @param size Element size in bytes
+	 * @return Success: Zeroed block
+	 * @return Failure or size overflow: NULL
+	 */
+	void* html2tex_calloc(size_t count, size_t size);
+
+	/**
+	 * @brief Resizes a block through the active allocator.
+	 * @param ptr Block to resize (NULL allocates a new one)
+	 * @param size New size in bytes
+	 * @return Success: Resized block, ptr is invalidated
+	 * @return Failure: NULL, ptr stays valid
+	 */
+	void* html2tex_realloc(void* ptr, size_t size);
+
+	/**
+	 * @brief Releases a block through the active allocator.
+	 * @param ptr Block to release (NULL-safe)
+	 */
+	void html2tex_free(void* ptr);
+
+	/**
+	 * @brief Sets up an allocator that tracks current, peak and total usage.
+	 * @param accounting Wrapper to initialize (stats are reset)
+	 * @param backing Allocator doing the actual work (NULL for malloc/realloc/free)
+	 * @note Counters are not synchronized, use one accounting allocator per converter
+	 */
+	void html2tex_accounting_init(HTML2TeXAccountingAllocator* accounting,
+		const HTML2TeXAllocator* backing);
+
+	/**
+	 * @brief Starts a new measurement window, the peak restarts from current usage.
+	 * @param accounting Accounting allocator to reset
+	 */
+	void html2tex_accounting_reset(HTML2TeXAccountingAllocator* accounting);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define HTML2TEX_THREAD_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef _WIN32
@@ -20,12 +21,41 @@ typedef DWORD thread_return_t;
 
 typedef CRITICAL_SECTION mutex_t;
 typedef CONDITION_VARIABLE cond_t;
+typedef INIT_ONCE once_t;
+#define THREAD_ONCE_INIT INIT_ONCE_STATIC_INIT
 
 #include <intrin.h>
+/* atomic_size_t is pointer sized, so are the interlocked operations on it */
+#ifdef _WIN64
+#define atomic_load(ptr) InterlockedOr64((LONG64 volatile*)(ptr), 0)
+#define atomic_store(ptr, val) InterlockedExchange64((LONG64 volatile*)(ptr), (LONG64)(val))
+#define atomic_fetch_add(ptr, val) InterlockedExchangeAdd64((LONG64 volatile*)(ptr), (LONG64)(val))
+#define atomic_fetch_sub(ptr, val) InterlockedExchangeAdd64((LONG64 volatile*)(ptr), -(LONG64)(val))
+#else
 #define atomic_load(ptr) InterlockedOr((LONG volatile*)(ptr), 0)
 #define atomic_store(ptr, val) InterlockedExchange((LONG volatile*)(ptr), (LONG)(val))
 #define atomic_fetch_add(ptr, val) InterlockedExchangeAdd((LONG volatile*)(ptr), (LONG)(val))
 #define atomic_fetch_sub(ptr, val) InterlockedExchangeAdd((LONG volatile*)(ptr), -(LONG)(val))
+#endif
+#define atomic_fence() MemoryBarrier()
+
+/* on failure stores the current value in expected */
+static inline int atomic_compare_exchange_size(volatile void* ptr, size_t* expected, size_t desired) {
+#ifdef _WIN64
+    const size_t seen = (size_t)InterlockedCompareExchange64((LONG64 volatile*)ptr,
+        (LONG64)desired, (LONG64)*expected);
+#else
+    const size_t seen = (size_t)InterlockedCompareExchange((LONG volatile*)ptr,
+        (LONG)desired, (LONG)*expected);
+#endif
+    if (seen == *expected) return 1;
+
+    *expected = seen;
+    return 0;
+}
+
+#define atomic_compare_exchange(ptr, expected, desired) \
+    atomic_compare_exchange_size((ptr), (expected), (desired))
 
 static inline int get_cpu_count(void) {
     SYSTEM_INFO sysinfo;
@@ -37,6 +67,7 @@ static inline int get_cpu_count(void) {
 #include <unistd.h>
 #include <stdatomic.h>
 #include <threads.h>
+#include <time.h>
 
 typedef thrd_t thread_t;
 typedef int thread_return_t;
@@ -45,11 +76,16 @@ typedef int thread_return_t;
 
 typedef mtx_t mutex_t;
 typedef cnd_t cond_t;
+typedef once_flag once_t;
+#define THREAD_ONCE_INIT ONCE_FLAG_INIT
 
 #define atomic_load(ptr) atomic_load_explicit(ptr, memory_order_acquire)
 #define atomic_store(ptr, val) atomic_store_explicit(ptr, val, memory_order_release)
 #define atomic_fetch_add(ptr, val) atomic_fetch_add_explicit(ptr, val, memory_order_acq_rel)
 #define atomic_fetch_sub(ptr, val) atomic_fetch_sub_explicit(ptr, val, memory_order_acq_rel)
+#define atomic_compare_exchange(ptr, expected, desired) \
+    atomic_compare_exchange_weak_explicit(ptr, expected, desired, memory_order_acq_rel, memory_order_acquire)
+#define atomic_fence() atomic_thread_fence(memory_order_seq_cst)
 
 static inline int get_cpu_count(void) {
     long nprocs = sysconf(_SC_NPROCESSORS_ONLN);
@@ -61,6 +97,8 @@ int thread_create(thread_t* thread,
     THREAD_RETURN_TYPE(THREAD_FUNC* func)(void*), void* arg);
 int thread_join(thread_t thread);
 void thread_exit(thread_return_t ret);
+void thread_yield(void);
+void thread_once(once_t* flag, void (*func)(void));
 
 int mutex_init(mutex_t* mutex);
 int mutex_lock(mutex_t* mutex);
@@ -77,4 +115,7 @@ int cond_broadcast(cond_t* cond);
 void cond_destroy(cond_t* cond);
 int cond_timedwait(cond_t* cond, mutex_t* mutex, unsigned int timeout_ms);
 
+/* milliseconds since an arbitrary start, never goes back */
+uint64_t get_monotonic_ms(void);
+
 #endif
\ No newline at end of file
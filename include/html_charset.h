@@ -0,0 +1,92 @@
+#ifndef HTML_CHARSET_H
+#define HTML_CHARSET_H
+
+#include <stddef.h>
+
+/* bytes of the document searched for a <meta> charset declaration */
+#ifndef HTML_CHARSET_PRESCAN_LIMIT
+#define HTML_CHARSET_PRESCAN_LIMIT 1024
+#endif
+
+/* a single-byte charset never needs more than 3 UTF-8 bytes per input byte */
+#define HTML_TRANSCODED_CAPACITY(length) (3 * (length) + 1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	/* Input encodings accepted by the parser. */
+	typedef enum {
+		HTML_CHARSET_UNKNOWN = 0,
+		HTML_CHARSET_UTF8,
+		HTML_CHARSET_WINDOWS_1250,
+		HTML_CHARSET_WINDOWS_1251,
+		HTML_CHARSET_WINDOWS_1252,
+		HTML_CHARSET_WINDOWS_1253,
+		HTML_CHARSET_WINDOWS_1254,
+		HTML_CHARSET_WINDOWS_1255,
+		HTML_CHARSET_WINDOWS_1256,
+		HTML_CHARSET_WINDOWS_1257,
+		HTML_CHARSET_WINDOWS_1258,
+		HTML_CHARSET_WINDOWS_874,
+		HTML_CHARSET_ISO_8859_2,
+		HTML_CHARSET_ISO_8859_3,
+		HTML_CHARSET_ISO_8859_4,
+		HTML_CHARSET_ISO_8859_5,
+		HTML_CHARSET_ISO_8859_6,
+		HTML_CHARSET_ISO_8859_7,
+		HTML_CHARSET_ISO_8859_8,
+		HTML_CHARSET_ISO_8859_10,
+		HTML_CHARSET_ISO_8859_13,
+		HTML_CHARSET_ISO_8859_14,
+		HTML_CHARSET_ISO_8859_15,
+		HTML_CHARSET_ISO_8859_16,
+		HTML_CHARSET_KOI8_R,
+		HTML_CHARSET_KOI8_U,
+		HTML_CHARSET_COUNT
+	} HTMLCharset;
+
+	/**
+	 * @brief Resolves an encoding label such as "latin1" or "windows-1251".
+	 * @param label Label text (ASCII case-insensitive, surrounding whitespace ignored)
+	 * @param length Label length in bytes
+	 * @return Known label: Matching charset (ISO-8859-1 and ASCII resolve to windows-1252)
+	 * @return Unknown label: HTML_CHARSET_UNKNOWN
+	 */
+	HTMLCharset html_charset_from_label(const char* label, size_t length);
+
+	/**
+	 * @brief Determines the encoding of a document before parsing.
+	 * @param html Raw document bytes
+	 * @param length Document length in bytes
+	 * @param hint Caller-supplied encoding (HTML_CHARSET_UNKNOWN for none)
+	 * @param bom_length Receives the byte order mark length to skip (may be NULL)
+	 * @return Detected charset: UTF-8 BOM first, then the hint, then a <meta>
+	 *         declaration within HTML_CHARSET_PRESCAN_LIMIT bytes, else UTF-8
+	 */
+	HTMLCharset html_charset_sniff(const char* html, size_t length,
+		HTMLCharset hint, size_t* bom_length);
+
+	/**
+	 * @brief Gets the byte map of a single-byte charset.
+	 * @param charset Charset to look up
+	 * @return Single-byte charset: Code points for bytes 0x80-0xFF
+	 * @return UTF-8 or unknown: NULL (input is copied unchanged)
+	 */
+	const unsigned short* html_charset_map(HTMLCharset charset);
+
+	/**
+	 * @brief Transcodes single-byte text to UTF-8.
+	 * @param source Source bytes (need not be null-terminated)
+	 * @param length Source length in bytes
+	 * @param dest Output buffer of at least HTML_TRANSCODED_CAPACITY(length) bytes
+	 * @param map Byte map from html_charset_map() (NULL copies unchanged)
+	 * @return Number of bytes written, no null terminator is added
+	 */
+	size_t html_charset_transcode(const char* source, size_t length,
+		char* dest, const unsigned short* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
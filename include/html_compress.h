@@ -0,0 +1,110 @@
+#ifndef HTML_COMPRESS_H
+#define HTML_COMPRESS_H
+
+#include <stddef.h>
+
+/* bytes moved through the codec per step, bounding its working memory */
+#ifndef HTML_COMPRESSION_CHUNK
+#define HTML_COMPRESSION_CHUNK 65536
+#endif
+
+/* leading bytes html_compression_detect() test-inflates before trusting a zlib header */
+#ifndef HTML_COMPRESSION_PROBE
+#define HTML_COMPRESSION_PROBE 4096
+#endif
+
+/* largest document an archive may inflate to, guarding against decompression bombs */
+#ifndef HTML_COMPRESSION_MAX_INFLATED
+#define HTML_COMPRESSION_MAX_INFLATED 134217728
+#endif
+
+/* zlib compression level used for written archives */
+#ifndef HTML_COMPRESSION_LEVEL
+#define HTML_COMPRESSION_LEVEL 6
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLCodec HTMLCodec;
+
+	/* Container format of a compressed stream. */
+	typedef enum {
+		HTML_COMPRESSION_NONE = 0,
+		HTML_COMPRESSION_GZIP,
+		HTML_COMPRESSION_DEFLATE
+	} HTMLCompression;
+
+	/* Receives the bytes produced by a codec, returns 0 to abort the stream. */
+	typedef int (*HTMLCodecSink)(const char* data, size_t length, void* user_data);
+
+	/**
+	 * @brief Recognizes a compressed stream from its leading bytes.
+	 * @param data First bytes of the stream
+	 * @param length Number of bytes available (up to HTML_COMPRESSION_PROBE are examined)
+	 * @return Gzip magic: HTML_COMPRESSION_GZIP
+	 * @return Zlib header whose data inflates: HTML_COMPRESSION_DEFLATE
+	 * @return Otherwise: HTML_COMPRESSION_NONE
+	 * @note Headers asking for a preset dictionary are plain text, as is a zlib-looking
+	 *       start that fails to inflate or inflates to nothing within the probe. Builds
+	 *       without zlib never report HTML_COMPRESSION_DEFLATE
+	 */
+	HTMLCompression html_compression_detect(const unsigned char* data, size_t length);
+
+	/**
+	 * @brief Chooses the output format from a file name extension.
+	 * @param path Output file path
+	 * @return ".gz": HTML_COMPRESSION_GZIP
+	 * @return ".zz" or ".deflate": HTML_COMPRESSION_DEFLATE
+	 * @return Otherwise: HTML_COMPRESSION_NONE
+	 */
+	HTMLCompression html_compression_from_path(const char* path);
+
+	/**
+	 * @brief Reports whether compressed streams are supported by this build.
+	 * @return 1 when linked against zlib, 0 otherwise
+	 */
+	int html_compression_available(void);
+
+	/**
+	 * @brief Creates a streaming compressor or decompressor.
+	 * @param type Stream format (HTML_COMPRESSION_NONE passes bytes through)
+	 * @param compress Non-zero to compress, zero to decompress
+	 * @return Success: Codec (caller owns)
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM, HTML2TEX_ERR_UNSUPPORTED)
+	 */
+	HTMLCodec* html_codec_create(HTMLCompression type, int compress);
+
+	/**
+	 * @brief Runs one chunk through the codec and forwards the produced bytes.
+	 * @param codec Codec from html_codec_create()
+	 * @param data Input chunk (may be NULL when length is 0)
+	 * @param length Input chunk length in bytes
+	 * @param finish Non-zero on the last chunk to flush the stream trailer
+	 * @param sink Callback receiving the output in pieces of at most HTML_COMPRESSION_CHUNK bytes
+	 * @param user_data Opaque pointer passed to the sink
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_MALFORMED, HTML2TEX_ERR_IO)
+	 * @note Decompression stops at the end of the compressed stream, trailing bytes are ignored
+	 */
+	int html_codec_process(HTMLCodec* codec, const char* data, size_t length,
+		int finish, HTMLCodecSink sink, void* user_data);
+
+	/**
+	 * @brief Reports whether a decompressor reached the end of its stream.
+	 * @param codec Codec to query
+	 * @return 1 once the stream trailer was read, 0 otherwise
+	 */
+	int html_codec_finished(const HTMLCodec* codec);
+
+	/**
+	 * @brief Releases a codec.
+	 * @param codec Codec to destroy (NULL-safe)
+	 */
+	void html_codec_destroy(HTMLCodec* codec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef HTML_DOWNLOAD_ENGINE_H
+#define HTML_DOWNLOAD_ENGINE_H
+
+#include <stddef.h>
+#include "html_image_cache.h"
+#include "html_executor.h"
+
+/* connections one event loop keeps open at once */
+#define HTML_DOWNLOAD_MAX_CONNECTIONS 64
+
+/* connections to a single host, matching what browsers open */
+#define HTML_DOWNLOAD_MAX_HOST_CONNECTIONS 6
+
+/* times a transfer answered with 429 or 503 is queued again */
+#define HTML_DOWNLOAD_MAX_RETRIES 3
+
+/* first pause in milliseconds of a host that answered 429 or 503, doubled while it keeps doing so */
+#define HTML_DOWNLOAD_BACKOFF 1000L
+
+/* longest pause of a throttled host in milliseconds, also caps Retry-After */
+#define HTML_DOWNLOAD_MAX_BACKOFF 30000L
+
+/* submissions a loop queues lock-free, more wait on a locked overflow list */
+#define HTML_DOWNLOAD_QUEUE_CAPACITY 4096
+
+/* whole-transfer timeout in milliseconds */
+#define HTML_DOWNLOAD_TIMEOUT 30000L
+
+/* error reported to the callbacks of cancelled transfers */
+#define HTML_DOWNLOAD_CANCELLED "Download cancelled."
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLDownloadEngine HTMLDownloadEngine;
+	typedef struct HTMLDownloadOptions HTMLDownloadOptions;
+	typedef struct HTMLDownloadSink HTMLDownloadSink;
+
+	/* Tuning of a download engine, zero fields select the defaults. */
+	struct HTMLDownloadOptions {
+		size_t event_loops;
+		size_t max_connections;
+		size_t max_host_connections;
+
+		/* requests started per second against one host (0 for no limit), and the burst
+		   above that rate an idle host may take (0 for max_host_connections) */
+		double host_rate;
+		size_t host_burst;
+
+		long timeout_ms;
+		int multiplex;
+
+		/* executor priority of the event loops */
+		HTMLTaskPriority priority;
+
+		/* persistent cache consulted before the network (NULL for none, not owned) */
+		HTMLImageCache* cache;
+	};
+
+	/**
+	 * @brief Completion callback of a single transfer.
+	 * @param url Requested URL
+	 * @param path Destination file
+	 * @param error NULL on success, else a description valid during the call
+	 * @param user_data Context passed to html_download_engine_submit()
+	 * @note Runs on the executor worker driving the loop, or on the cancelling thread for
+	 *       transfers that never started
+	 */
+	typedef void (*HTMLDownloadCallback)(const char* url, const char* path,
+		const char* error, void* user_data);
+
+	/* Receiver of a response body in place of a file, both calls get the user_data of the transfer. */
+	struct HTMLDownloadSink {
+		/* called once before the body, content_type is NULL when the response names none, 0 aborts (NULL allowed) */
+		int (*begin)(const char* content_type, void* user_data);
+
+		/* called with the body in arrival order, 0 aborts */
+		int (*write)(const void* data, size_t size, void* user_data);
+	};
+
+	/**
+	 * @brief Creates a download engine driven by curl_multi event loops.
+	 * @param options Tuning (NULL for one loop, HTML_DOWNLOAD_MAX_CONNECTIONS and HTTP/2 multiplexing)
+	 * @return Success: Engine (caller owns, see html_download_engine_destroy())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM, HTML2TEX_ERR_IMAGE_DOWNLOAD)
+	 * @note Transfers wait in per-host queues served round-robin, so one busy host never
+	 *       holds back the others. Each host is capped by its connection limit and rate,
+	 *       and halves its connection window and pauses when it answers 429 or 503.
+	 *       Every URL of a host goes to the same loop.
+	 *       Loops own no threads, each runs as a task of the process-wide executor while
+	 *       it has transfers and yields to waiting tasks of the same or a higher priority.
+	 *       Easy handles are pooled per loop, DNS and TLS sessions are shared by all loops
+	 *       and a single loop also shares its connection cache
+	 */
+	HTMLDownloadEngine* html_download_engine_create(const HTMLDownloadOptions* options);
+
+	/**
+	 * @brief Queues a download of url into path.
+	 * @param engine Download engine
+	 * @param url Source URL (copied)
+	 * @param path Destination file, written once the first byte arrives (copied)
+	 * @param callback Completion callback (NULL allowed)
+	 * @param user_data Context for the callback
+	 * @return Success: 1, the callback fires exactly once
+	 * @return Failure: 0 with error set, the callback never fires
+	 * @note Only a 200 response counts as success, a failed transfer leaves no file behind.
+	 *       With a cache, fresh images are materialized without network I/O and stale
+	 *       ones are revalidated with If-None-Match/If-Modified-Since
+	 */
+	int html_download_engine_submit(HTMLDownloadEngine* engine, const char* url,
+		const char* path, HTMLDownloadCallback callback, void* user_data);
+
+	/**
+	 * @brief Queues a download of url whose body goes to a sink instead of a file.
+	 * @param engine Download engine
+	 * @param url Source URL (copied)
+	 * @param path Name reported to the callback, nothing is written to it (copied)
+	 * @param sink Body receiver, called on the loop's worker (copied)
+	 * @param callback Completion callback (NULL allowed), an error tells the sink to drop what it got
+	 * @param user_data Context for the sink and the callback
+	 * @return Success: 1, the callback fires exactly once
+	 * @return Failure: 0 with error set, neither the sink nor the callback is called
+	 * @note Only the body of a 200 response reaches the sink, begin runs for empty bodies too.
+	 *       Sink transfers bypass the cache, which keeps its images as files
+	 */
+	int html_download_engine_submit_sink(HTMLDownloadEngine* engine, const char* url,
+		const char* path, const HTMLDownloadSink* sink, HTMLDownloadCallback callback, void* user_data);
+
+	/**
+	 * @brief Downloads url into path and waits for the transfer.
+	 * @param engine Download engine
+	 * @param url Source URL
+	 * @param path Destination file
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_IMAGE_DOWNLOAD, HTML2TEX_ERR_FILE_OPEN)
+	 */
+	int html_download_engine_fetch(HTMLDownloadEngine* engine, const char* url, const char* path);
+
+	/**
+	 * @brief Aborts queued and running transfers, their callbacks report cancellation.
+	 * @param engine Download engine
+	 * @return Number of transfers cancelled
+	 * @note Transfers submitted afterwards run normally
+	 */
+	size_t html_download_engine_cancel(HTMLDownloadEngine* engine);
+
+	/**
+	 * @brief Gets the number of submitted transfers not completed yet.
+	 * @param engine Download engine
+	 * @return Pending transfer count
+	 */
+	size_t html_download_engine_pending(HTMLDownloadEngine* engine);
+
+	/**
+	 * @brief Gets the number of hosts whose scheduling state the engine keeps.
+	 * @param engine Download engine
+	 * @return Host count
+	 * @note Hosts with nothing queued or running and no throttling to remember are evicted
+	 *       once the count doubles, a long-lived engine stays proportional to its busy hosts
+	 */
+	size_t html_download_engine_hosts(HTMLDownloadEngine* engine);
+
+	/**
+	 * @brief Cancels outstanding transfers, waits for the event loops and frees the engine.
+	 * @param engine Download engine (NULL-safe)
+	 * @warning Must not be called from a completion callback or another executor task
+	 */
+	void html_download_engine_destroy(HTMLDownloadEngine* engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef HTML_ENTITIES_H
+#define HTML_ENTITIES_H
+
+#include <stddef.h>
+
+/* longest named reference, trailing semicolon included */
+#ifndef HTML_ENTITY_MAX_NAME
+#define HTML_ENTITY_MAX_NAME 32
+#endif
+
+/* longest name also accepted without its semicolon */
+#ifndef HTML_ENTITY_MAX_LEGACY_NAME
+#define HTML_ENTITY_MAX_LEGACY_NAME 6
+#endif
+
+/* decoded text never exceeds 6 bytes per 5 source bytes (&nGt; and &nLt;) */
+#define HTML_DECODED_CAPACITY(length) ((length) + (length) / 4 + 1)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLEntity HTMLEntity;
+
+	/* Named character reference with its UTF-8 replacement. */
+	struct HTMLEntity {
+		const char* name;
+		const char* value;
+		unsigned char name_length;
+		unsigned char value_length;
+	};
+
+	/**
+	 * @brief Looks up a named character reference through the perfect hash table.
+	 * @param name Reference name without the ampersand (e.g. "amp;" or "eacute")
+	 * @param length Name length in bytes
+	 * @return Success: Entity table entry
+	 * @return Unknown name: NULL (not an error)
+	 */
+	const HTMLEntity* html_entity_lookup(const char* name, size_t length);
+
+	/**
+	 * @brief Decodes named and numeric character references into UTF-8.
+	 * @param source Raw text or attribute value (need not be null-terminated)
+	 * @param length Source length in bytes
+	 * @param dest Output buffer of at least HTML_DECODED_CAPACITY(length) bytes
+	 * @param in_attribute Non-zero to apply attribute value rules to references
+	 *        lacking a semicolon
+	 * @param charset_map Single-byte map for the text between references
+	 *        (NULL for UTF-8 input, see html_charset_map())
+	 * @return Number of bytes written, excluding the terminating null byte
+	 * @note Unrecognized references are copied verbatim
+	 * @note With a charset map the buffer needs HTML_TRANSCODED_CAPACITY(length) bytes
+	 */
+	size_t html_decode_entities(const char* source, size_t length,
+		char* dest, int in_attribute, const unsigned short* charset_map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
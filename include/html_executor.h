@@ -0,0 +1,105 @@
+#ifndef HTML_EXECUTOR_H
+#define HTML_EXECUTOR_H
+
+#include <stddef.h>
+
+/* fewest workers started when none are configured, event loops block while they poll */
+#define HTML_EXECUTOR_MIN_THREADS 4
+
+/* tasks each priority level queues lock-free, more park the submitter */
+#define HTML_EXECUTOR_QUEUE_CAPACITY 4096
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLExecutorPool HTMLExecutorPool;
+	typedef struct HTMLExecutorTask HTMLExecutorTask;
+
+	/* Scheduling priority of a pool, workers always take higher levels first. */
+	typedef enum {
+		HTML_PRIORITY_LOW = -1,
+		HTML_PRIORITY_NORMAL = 0,
+		HTML_PRIORITY_HIGH = 1
+	} HTMLTaskPriority;
+
+	typedef void (*HTMLTaskFunc)(void* arg);
+
+	/* A task in caller-owned storage, see html_executor_post(). */
+	struct HTMLExecutorTask {
+		HTMLTaskFunc run;
+		void* arg;
+
+		/* set by the executor */
+		HTMLExecutorPool* pool;
+		int owned;
+	};
+
+	/**
+	 * @brief Sets the number of worker threads of the process-wide executor.
+	 * @param threads Worker count (0 for the CPU count, at least HTML_EXECUTOR_MIN_THREADS)
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_INVAL while workers are running)
+	 * @note Workers start with the first pool and stop with the last one
+	 */
+	int html_executor_configure(size_t threads);
+
+	/**
+	 * @brief Gets the worker count the executor runs or will start with.
+	 * @return Worker thread count, the global concurrency limit of all pools
+	 */
+	size_t html_executor_threads(void);
+
+	/**
+	 * @brief Creates a pool of tasks sharing one priority, starting the workers if needed.
+	 * @param priority Priority of every task of the pool
+	 * @return Success: Pool (caller owns, see html_executor_pool_destroy())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM, HTML2TEX_ERR_INTERNAL)
+	 */
+	HTMLExecutorPool* html_executor_pool_create(HTMLTaskPriority priority);
+
+	/**
+	 * @brief Runs func(arg) on an executor worker.
+	 * @param pool Pool the task belongs to
+	 * @param func Task function
+	 * @param arg Task argument
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_NULL, HTML2TEX_ERR_NOMEM)
+	 */
+	int html_executor_submit(HTMLExecutorPool* pool, HTMLTaskFunc func, void* arg);
+
+	/**
+	 * @brief Runs a task stored by the caller, without allocating.
+	 * @param pool Pool the task belongs to
+	 * @param task Task with run and arg set, untouched by the executor once run starts
+	 * @note A task may post itself again while it runs. When every queue is full a
+	 *       worker runs the task inline and any other thread parks until there is room
+	 */
+	void html_executor_post(HTMLExecutorPool* pool, HTMLExecutorTask* task);
+
+	/**
+	 * @brief Tells a long-running task whether it should post itself again and return.
+	 * @param pool Pool of the running task
+	 * @return 1 when tasks of the same or a higher priority are waiting for a worker, else 0
+	 */
+	int html_executor_should_yield(const HTMLExecutorPool* pool);
+
+	/**
+	 * @brief Gets the number of tasks of a pool not finished yet.
+	 * @param pool Pool
+	 * @return Pending task count
+	 */
+	size_t html_executor_pool_pending(const HTMLExecutorPool* pool);
+
+	/**
+	 * @brief Waits for every task of a pool, then frees it.
+	 * @param pool Pool (NULL-safe)
+	 * @note The last pool stops the workers, unless it is destroyed on one of them
+	 * @warning Must not be called from a task of the same pool
+	 */
+	void html_executor_pool_destroy(HTMLExecutorPool* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef HTML_IMAGE_CACHE_H
+#define HTML_IMAGE_CACHE_H
+
+#include <stddef.h>
+
+/* default size bound of the cached images */
+#define HTML_IMAGE_CACHE_MAX_BYTES (256ULL * 1024 * 1024)
+
+/* seconds an entry is reused without revalidation when the server sent no max-age */
+#define HTML_IMAGE_CACHE_FRESHNESS 86400L
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLImageCache HTMLImageCache;
+	typedef struct HTMLCacheValidators HTMLCacheValidators;
+
+	/* Outcome of a cache lookup. */
+	typedef enum {
+		HTML_CACHE_MISS,
+		HTML_CACHE_FRESH,
+		HTML_CACHE_STALE
+	} HTMLCacheState;
+
+	/* Revalidation data of a cached response. */
+	struct HTMLCacheValidators {
+		char etag[256];
+		char last_modified[64];
+		long max_age;
+		int no_store;
+	};
+
+	/**
+	 * @brief Opens (or creates) a persistent image cache in a directory.
+	 * @param dir Cache directory, created with its parents when missing
+	 * @param max_bytes Size bound of the cached images (0 for HTML_IMAGE_CACHE_MAX_BYTES)
+	 * @return Success: Cache (caller owns, see html_image_cache_close())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NULL, HTML2TEX_ERR_NOMEM, HTML2TEX_ERR_FILE_OPEN)
+	 * @note Entries are keyed by normalized URL, images are stored once per SHA-256 of their content
+	 *       and a damaged index starts the cache empty
+	 */
+	HTMLImageCache* html_image_cache_open(const char* dir, unsigned long long max_bytes);
+
+	/**
+	 * @brief Looks up the cached image of a URL.
+	 * @param cache Image cache
+	 * @param url Image URL
+	 * @param validators Receives the stored validators when the URL is cached (NULL allowed)
+	 * @return HTML_CACHE_FRESH when reusable as is, HTML_CACHE_STALE when it needs
+	 *         revalidation, HTML_CACHE_MISS otherwise
+	 */
+	HTMLCacheState html_image_cache_lookup(HTMLImageCache* cache, const char* url,
+		HTMLCacheValidators* validators);
+
+	/**
+	 * @brief Places the cached image of a URL at a destination path.
+	 * @param cache Image cache
+	 * @param url Image URL
+	 * @param dest Destination file, replaced when it exists
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_IMAGE_DOWNLOAD, HTML2TEX_ERR_FILE_OPEN)
+	 * @note Hardlinks first, then reflinks, then copies, so destinations must be
+	 *       replaced rather than rewritten in place
+	 */
+	int html_image_cache_materialize(HTMLImageCache* cache, const char* url, const char* dest);
+
+	/**
+	 * @brief Stores a downloaded image under its URL.
+	 * @param cache Image cache
+	 * @param url Image URL
+	 * @param path Downloaded file
+	 * @param validators Response validators (NULL when the response had none)
+	 * @return Success: 1, also when no-store kept the image out of the cache
+	 * @return Failure: 0 with error set
+	 * @note Least recently used entries are evicted to stay within the size bound
+	 */
+	int html_image_cache_store(HTMLImageCache* cache, const char* url,
+		const char* path, const HTMLCacheValidators* validators);
+
+	/**
+	 * @brief Marks a cached image revalidated after a 304 response.
+	 * @param cache Image cache
+	 * @param url Image URL
+	 * @param validators Validators of the 304 response, empty fields keep the stored ones
+	 * @return 1 when the URL was cached, else 0
+	 */
+	int html_image_cache_refresh(HTMLImageCache* cache, const char* url,
+		const HTMLCacheValidators* validators);
+
+	/**
+	 * @brief Writes the cache index to disk when it changed.
+	 * @param cache Image cache (NULL-safe)
+	 * @return Success: 1
+	 * @return Failure: 0, the previous index stays in place
+	 * @note Leaves the error state untouched
+	 */
+	int html_image_cache_flush(HTMLImageCache* cache);
+
+	/**
+	 * @brief Flushes the index and frees the cache.
+	 * @param cache Image cache (NULL-safe)
+	 */
+	void html_image_cache_close(HTMLImageCache* cache);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HTML_MAPPED_FILE_H
+#define HTML_MAPPED_FILE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLMappedFile HTMLMappedFile;
+
+	/**
+	 * @brief Maps a file read-only into memory for sequential parsing.
+	 * @param path File to map
+	 * @return Success: Mapped file (caller owns, see html_mapped_file_close())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_FILE_OPEN, HTML2TEX_ERR_FILE_READ, HTML2TEX_ERR_NOMEM)
+	 * @note Pages are faulted in on demand, the kernel is advised of sequential access
+	 */
+	HTMLMappedFile* html_mapped_file_open(const char* path);
+
+	/**
+	 * @brief Gets the mapped bytes.
+	 * @param file Mapped file
+	 * @return File contents (not null-terminated, valid until the file is closed)
+	 */
+	const char* html_mapped_file_data(const HTMLMappedFile* file);
+
+	/**
+	 * @brief Gets the mapped length.
+	 * @param file Mapped file
+	 * @return File size in bytes (0 for an empty file)
+	 */
+	size_t html_mapped_file_length(const HTMLMappedFile* file);
+
+	/**
+	 * @brief Unmaps the file and releases its handles.
+	 * @param file Mapped file (NULL-safe)
+	 */
+	void html_mapped_file_close(HTMLMappedFile* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
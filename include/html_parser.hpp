@@ -142,6 +142,7 @@ public:
      * @param input Input file stream (must be open for reading).
      * @return HtmlParser instance.
      * @note Stream is read until EOF (up to 128MB limit).
+     * @note Gzip and zlib streams are inflated in chunks (128MB limit applies to the inflated size).
      * @warning Returns empty parser on failure (no exceptions thrown).
      */
     static HtmlParser fromStream(std::ifstream& input) noexcept;
@@ -151,10 +152,21 @@ public:
      * @param filePath Path to HTML file.
      * @return HtmlParser instance.
      * @note Reads entire file (up to 128MB limit).
+     * @note Compressed files (e.g. page.html.gz) are detected by content and inflated.
      * @warning Returns empty parser on failure (no exceptions thrown).
      */
     static HtmlParser fromHtml(const std::string& filePath) noexcept;
 
+    /**
+     * @brief Creates parser from a memory-mapped HTML file.
+     * @param filePath Path to HTML file.
+     * @return HtmlParser instance.
+     * @note The mapped pages are parsed in place, without the 128MB limit or a heap copy.
+     * @note Compressed files fall back to fromHtml().
+     * @warning Returns empty parser on failure (no exceptions thrown).
+     */
+    static HtmlParser fromFile(const std::string& filePath) noexcept;
+
     /**
      * @brief Writes prettified HTML to file.
      * @param filePath Path to output file.
@@ -0,0 +1,84 @@
+#ifndef HTML_WORK_QUEUE_H
+#define HTML_WORK_QUEUE_H
+
+#include <stddef.h>
+
+/* slots of a work queue created with capacity 0 */
+#define HTML_WORK_QUEUE_CAPACITY 1024
+
+/* times a blocking push or pop yields and retries before parking */
+#ifndef HTML_WORK_QUEUE_SPIN
+#define HTML_WORK_QUEUE_SPIN 4
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct HTMLWorkQueue HTMLWorkQueue;
+
+	/**
+	 * @brief Creates a bounded lock-free queue for any number of producers and consumers.
+	 * @param capacity Slot count, rounded up to a power of two (0 for HTML_WORK_QUEUE_CAPACITY)
+	 * @return Success: Queue (caller owns, see html_work_queue_destroy())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 * @note Threads only lock the queue to park, when it is full or empty
+	 */
+	HTMLWorkQueue* html_work_queue_create(size_t capacity);
+
+	/**
+	 * @brief Queues an item without blocking.
+	 * @param queue Work queue
+	 * @param item Item to queue (non-NULL, not owned)
+	 * @return 1 when queued, 0 when the queue is full or closed
+	 */
+	int html_work_queue_try_push(HTMLWorkQueue* queue, void* item);
+
+	/**
+	 * @brief Takes the oldest item without blocking.
+	 * @param queue Work queue
+	 * @return Item, or NULL when the queue is empty
+	 */
+	void* html_work_queue_try_pop(HTMLWorkQueue* queue);
+
+	/**
+	 * @brief Queues an item, parking while the queue is full.
+	 * @param queue Work queue
+	 * @param item Item to queue (non-NULL, not owned)
+	 * @return 1 when queued, 0 when the queue was closed
+	 */
+	int html_work_queue_push(HTMLWorkQueue* queue, void* item);
+
+	/**
+	 * @brief Takes the oldest item, parking while the queue is empty.
+	 * @param queue Work queue
+	 * @param timeout_ms Longest wait in milliseconds (0 = infinite)
+	 * @return Item, or NULL on timeout or once the queue is closed and drained
+	 */
+	void* html_work_queue_pop(HTMLWorkQueue* queue, unsigned int timeout_ms);
+
+	/**
+	 * @brief Rejects further pushes and wakes every parked thread.
+	 * @param queue Work queue
+	 * @note Items already queued can still be taken
+	 */
+	void html_work_queue_close(HTMLWorkQueue* queue);
+
+	/**
+	 * @brief Gets the number of queued items.
+	 * @param queue Work queue
+	 * @return Item count, approximate while other threads use the queue
+	 */
+	size_t html_work_queue_size(HTMLWorkQueue* queue);
+
+	/**
+	 * @brief Frees the queue, items left in it are not touched.
+	 * @param queue Work queue (NULL-safe)
+	 * @warning No thread may be using or parked on the queue
+	 */
+	void html_work_queue_destroy(HTMLWorkQueue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
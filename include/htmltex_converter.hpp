@@ -28,6 +28,7 @@ class HtmlTeXConverter {
 private:
     std::unique_ptr<LaTeXConverter, decltype(&html2tex_destroy)> converter;
     std::unique_ptr<ImageManager> image_manager;
+    std::shared_ptr<ImageManager::StreamWriter> image_writer;
     std::string image_directory;
     bool downloads_enabled, valid;
 
@@ -64,7 +65,7 @@ public:
     /**
      * @brief Converts HTML string to LaTeX and writes to file.
      * @param html HTML source code to convert.
-     * @param filePath Path to output LaTeX file.
+     * @param filePath Path to output LaTeX file (".gz" writes gzip, ".zz" writes zlib).
      * @return true if conversion and writing succeeded.
      * @throws LaTeXRuntimeException if conversion fails.
      * @throws std::runtime_error if converter is not valid or file I/O fails.
@@ -74,7 +75,7 @@ public:
     /**
      * @brief Converts HtmlParser content to LaTeX and writes to file.
      * @param parser Parser containing HTML to convert.
-     * @param filePath Path to output LaTeX file.
+     * @param filePath Path to output LaTeX file (".gz" writes gzip, ".zz" writes zlib).
      * @return true if conversion and writing succeeded.
      * @throws LaTeXRuntimeException if conversion fails.
      * @throws std::runtime_error if converter is not valid or file I/O fails.
@@ -121,6 +122,39 @@ public:
      */
     bool enableLazyDownloading(bool enabled);
 
+    /**
+     * @brief Reads images through a fetcher instead of the shared libcurl engine.
+     * @param fetcher Image fetcher (nullptr restores the network), not owned,
+     *        must outlive the converter and its copies.
+     * @return true if the fetcher was set, false while Delivery::Memory or
+     *         Delivery::Stream is selected (fetchers only deliver files).
+     * @note Also serves the ImageManager when set before the first getImageManager() call.
+     * @see image_fetcher_chain_create() (C API) to combine local and network backends
+     */
+    bool setImageFetcher(ImageFetcher* fetcher) noexcept;
+
+    /**
+     * @brief Selects where the images of a conversion go.
+     * @param mode Delivery mode (ImageManager::Delivery::File by default).
+     * @param writer Receiver of Delivery::Stream, ignored otherwise. Runs on the
+     *        event loop, or on the converting thread for data URIs.
+     * @throws std::invalid_argument for Delivery::Stream without a writer.
+     * @throws std::runtime_error if converter is not valid.
+     * @throws LaTeXRuntimeException for Delivery::Memory and Delivery::Stream while an
+     *         image fetcher is set.
+     * @note The document references the same paths below setDirectory(), memory and
+     *       stream deliveries neither write them nor create the directory. Copies share
+     *       the writer.
+     * @see getDeliveredImages() for the images of Delivery::Memory
+     */
+    void setImageDelivery(ImageManager::Delivery mode, ImageManager::StreamWriter writer = nullptr);
+
+    /**
+     * @brief Gets the images the last conversion delivered in memory.
+     * @return Images in document order, empty unless Delivery::Memory is selected.
+     */
+    std::vector<ImageManager::DownloadResult> getDeliveredImages() const;
+
     /**
      * @brief Checks for errors from last operation.
      * @return true if error occurred, false otherwise.
@@ -176,6 +210,13 @@ public:
      */
     std::vector<ImageManager::DownloadRequest> getImages();
 
+    /**
+     * @brief Counts image references of the last conversion that reused an earlier one.
+     * @return Deduplication hits, repeats of a URL within a document share one file
+     * @note Zero for an invalid converter or when images are not downloaded
+     */
+    size_t getImageDedupHits() const noexcept;
+
     /**
      * @brief Asynchronously downloads a provided list of images using the internal ImageManager.
      *
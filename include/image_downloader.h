@@ -13,6 +13,7 @@ extern "C" {
 
 	typedef struct DownloadRequest DownloadRequest;
 	typedef struct ImageDownloader ImageDownloader;
+	typedef struct ImageFetcher ImageFetcher;
 
     /**
      * @brief Result structure for individual download operations.
@@ -23,6 +24,35 @@ extern "C" {
         bool success;           /* Whether download succeeded */
         char* error;           /* Error description (NULL on success) */
         int sequence_number;    /* Request sequence number */
+        unsigned char* data;    /* Image bytes with IMAGE_DELIVERY_MEMORY (NULL otherwise) */
+        size_t size;            /* Byte count of data */
+        char* content_type;     /* MIME type of memory and stream deliveries (NULL when unknown) */
+        char* filename;         /* Suggested file name, the last component of local_path */
+    };
+
+    /**
+     * @brief Where downloaded images go.
+     */
+    typedef enum {
+        IMAGE_DELIVERY_FILE,    /* written to local_path */
+        IMAGE_DELIVERY_MEMORY,  /* kept in DownloadResult.data, nothing is written */
+        IMAGE_DELIVERY_STREAM   /* handed to an ImageStreamWriter as they arrive, nothing is written */
+    } ImageDelivery;
+
+    typedef struct ImageStreamWriter ImageStreamWriter;
+
+    /**
+     * @brief Receiver of IMAGE_DELIVERY_STREAM, called outside any lock on the event loop
+     *        (on the enqueuing thread for data URIs).
+     * @note image describes the download (url, local_path, filename, content_type and
+     *       sequence_number), the DownloadCallback result then tells whether it completed
+     */
+    struct ImageStreamWriter {
+        /* starts an image, 0 fails the download (NULL allowed) */
+        int (*begin)(const DownloadResult* image, void* user_data);
+
+        /* receives the bytes in order, 0 fails the download */
+        int (*write)(const DownloadResult* image, const void* data, size_t size, void* user_data);
     };
 
     /**
@@ -56,17 +86,48 @@ extern "C" {
 
     /**
      * @brief Creates a new asynchronous download manager.
-     * @param max_workers Maximum number of concurrent download threads (0 = auto-detect)
+     * @param max_workers Maximum number of concurrent connections (0 = HTML_DOWNLOAD_MAX_CONNECTIONS)
      * @param callback Optional callback for individual download completion (NULL allowed)
      * @param batch_callback Optional callback for batch completion (NULL allowed)
      * @param user_data User context passed to callbacks
      * @return New ImageDownloader instance, NULL on failure
+     * @note Downloads share one curl_multi event loop run on an executor worker, callbacks run on it
+     *       outside any lock, before the result can be collected
      */
     ImageDownloader* image_downloader_create(size_t max_workers,
         DownloadCallback callback,
         BatchCompleteCallback batch_callback,
         void* user_data);
 
+    /**
+     * @brief Creates a download manager reading images through a fetcher.
+     * @param fetcher Image fetcher serving every download (not owned, must outlive the manager)
+     * @param callback Optional callback for individual download completion (NULL allowed)
+     * @param batch_callback Optional callback for batch completion (NULL allowed)
+     * @param user_data User context passed to callbacks
+     * @return New ImageDownloader instance, NULL on failure
+     * @note No download engine is started. Blocking backends complete a download inside
+     *       image_downloader_enqueue(), asynchronous ones on their own threads
+     */
+    ImageDownloader* image_downloader_create_with_fetcher(ImageFetcher* fetcher,
+        DownloadCallback callback,
+        BatchCompleteCallback batch_callback,
+        void* user_data);
+
+    /**
+     * @brief Selects where the images of a download manager go.
+     * @param downloader Download manager instance, without downloads in flight
+     * @param delivery Delivery mode (IMAGE_DELIVERY_FILE by default)
+     * @param writer Receiver for IMAGE_DELIVERY_STREAM (copied, NULL otherwise), gets the user_data of the manager
+     * @return true on success, false with error set (HTML2TEX_ERR_INVAL while downloading
+     *         or for a fetcher-backed manager, which only writes files)
+     * @note local_path still names the file the converter references, memory and stream
+     *       deliveries neither write it nor create output_dir. Requests that joined a transfer
+     *       share its outcome and, in memory, a copy of its bytes, they are not streamed again
+     */
+    bool image_downloader_set_delivery(ImageDownloader* downloader,
+        ImageDelivery delivery, const ImageStreamWriter* writer);
+
     /**
      * @brief Enqueues a single image for asynchronous download.
      * @param downloader Download manager instance
@@ -74,6 +135,9 @@ extern "C" {
      * @param output_dir Destination directory (copied internally)
      * @param sequence_number Unique identifier for ordering
      * @return true on success, false on failure
+     * @note A request for a URL and directory already in flight joins that transfer
+     *       and reports its file, see image_downloader_dedup_hits(). A download that
+     *       cannot be started is reported as a failed result
      */
     bool image_downloader_enqueue(ImageDownloader* downloader,
         const char* url,
@@ -95,6 +159,7 @@ extern "C" {
      * @brief Starts asynchronous processing of all queued downloads.
      * @param downloader Download manager instance
      * @return true on success, false on failure
+     * @note Transfers already begin on enqueue, kept for API compatibility
      */
     bool image_downloader_start(ImageDownloader* downloader);
 
@@ -110,6 +175,8 @@ extern "C" {
      * @brief Cancels all pending downloads immediately.
      * @param downloader Download manager instance
      * @return Number of pending downloads cancelled
+     * @note Cancelled downloads are reported as failed results, a fetcher cancels
+     *       the fetches of all its users (see image_fetcher_cancel())
      */
     size_t image_downloader_cancel(ImageDownloader* downloader);
 
@@ -120,16 +187,24 @@ extern "C" {
      */
     bool image_downloader_is_active(const ImageDownloader* downloader);
 
+    /**
+     * @brief Gets how many requests joined a transfer already in flight.
+     * @param downloader Download manager instance
+     * @return Deduplication hit count
+     */
+    size_t image_downloader_dedup_hits(const ImageDownloader* downloader);
+
     /**
      * @brief Retrieves all completed results. (consumes results)
      * @param downloader Download manager instance
      * @param count Output parameter for number of results
      * @return Array of DownloadResult pointers (caller must free array and results)
+     * @note Results arrive on a lock-free list and are returned in completion order
      */
     DownloadResult** image_downloader_get_results(ImageDownloader* downloader, size_t* count);
 
     /**
-     * @brief Frees a DownloadResult structure and all contained strings.
+     * @brief Frees a DownloadResult structure, its strings and image bytes.
      * @param result Result to free (NULL-safe)
      */
     void download_result_free(DownloadResult* result);
@@ -137,6 +212,7 @@ extern "C" {
     /**
      * @brief Destroys download manager and all associated resources
      * @param downloader Download manager to destroy (NULL-safe)
+     * @note Waits for the fetches of a fetcher-backed manager still in progress
      */
     void image_downloader_destroy(ImageDownloader* downloader);
 
@@ -0,0 +1,169 @@
+#ifndef IMAGE_FETCHER_H
+#define IMAGE_FETCHER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+	typedef struct ImageFetcher ImageFetcher;
+	typedef struct ImageFetcherVTable ImageFetcherVTable;
+	typedef struct HTMLDownloadOptions HTMLDownloadOptions;
+
+	/**
+	 * @brief Completion callback of an image fetch.
+	 * @param src Requested image source
+	 * @param path Destination file
+	 * @param error NULL on success, else a description valid during the call
+	 * @param user_data Context passed to image_fetcher_submit()
+	 */
+	typedef void (*ImageFetchCallback)(const char* src, const char* path,
+		const char* error, void* user_data);
+
+	/* Operations of an image fetcher backend, context is the one given to image_fetcher_create(). */
+	struct ImageFetcherVTable {
+		/* 1 when the backend serves src, NULL serves every source */
+		int (*accepts)(void* context, const char* src);
+
+		/* writes the image of src into path and blocks until done, 1 on success, else 0 with error set */
+		int (*fetch)(void* context, const char* src, const char* path);
+
+		/* starts a fetch whose callback fires exactly once, 0 with error set when it never will,
+		   NULL runs fetch() on the calling thread */
+		int (*submit)(void* context, const char* src, const char* path,
+			ImageFetchCallback callback, void* user_data);
+
+		/* aborts submitted fetches, their callbacks report HTML_DOWNLOAD_CANCELLED, NULL when none can be */
+		size_t (*cancel)(void* context);
+
+		/* releases the context, NULL when there is nothing to release */
+		void (*destroy)(void* context);
+	};
+
+	/**
+	 * @brief Wraps a backend into an image fetcher.
+	 * @param vtable Backend operations (fetch required, must outlive the fetcher)
+	 * @param context Backend state handed to every operation (owned, see destroy)
+	 * @return Success: Fetcher (caller owns, see image_fetcher_destroy())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NULL, HTML2TEX_ERR_NOMEM)
+	 */
+	ImageFetcher* image_fetcher_create(const ImageFetcherVTable* vtable, void* context);
+
+	/**
+	 * @brief Tells whether a fetcher serves an image source.
+	 * @param fetcher Image fetcher (NULL-safe)
+	 * @param src Image source
+	 * @return 1 when served, else 0
+	 */
+	int image_fetcher_accepts(const ImageFetcher* fetcher, const char* src);
+
+	/**
+	 * @brief Writes the image of src into path.
+	 * @param fetcher Image fetcher
+	 * @param src Image source
+	 * @param path Destination file, replaced and removed again on failure
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_IMAGE_DOWNLOAD when no backend serves src)
+	 */
+	int image_fetcher_fetch(ImageFetcher* fetcher, const char* src, const char* path);
+
+	/**
+	 * @brief Starts writing the image of src into path.
+	 * @param fetcher Image fetcher
+	 * @param src Image source
+	 * @param path Destination file
+	 * @param callback Completion callback (NULL allowed)
+	 * @param user_data Context for the callback
+	 * @return Success: 1, the callback fires exactly once, possibly before this returns
+	 * @return Failure: 0 with error set, the callback never fires
+	 */
+	int image_fetcher_submit(ImageFetcher* fetcher, const char* src, const char* path,
+		ImageFetchCallback callback, void* user_data);
+
+	/**
+	 * @brief Aborts the fetches a fetcher has in progress.
+	 * @param fetcher Image fetcher (NULL-safe)
+	 * @return Number of fetches cancelled, blocking backends cannot be
+	 * @note Affects every user of the fetcher
+	 */
+	size_t image_fetcher_cancel(ImageFetcher* fetcher);
+
+	/**
+	 * @brief Releases a fetcher and its backend.
+	 * @param fetcher Image fetcher (NULL-safe)
+	 * @warning No fetch of the fetcher may be in progress
+	 */
+	void image_fetcher_destroy(ImageFetcher* fetcher);
+
+	/**
+	 * @brief Creates a backend copying local files, in the kernel where the platform allows.
+	 * @param base_dir Directory relative sources are resolved against (NULL for the working directory)
+	 * @return Success: Fetcher serving file:// URLs and sources without a URL scheme
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 * @note file:// URLs are percent-decoded and lose their query string and fragment,
+	 *       sources without a scheme are used verbatim. Linux copies with copy_file_range()
+	 *       or sendfile(), Windows with CopyFile()
+	 */
+	ImageFetcher* image_fetcher_file_create(const char* base_dir);
+
+	/**
+	 * @brief Creates a backend serving URLs from local copies of their sites.
+	 * @return Success: Fetcher, empty until image_fetcher_mirror_add() is called
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 */
+	ImageFetcher* image_fetcher_mirror_create(void);
+
+	/**
+	 * @brief Maps every URL starting with prefix to the same path below directory.
+	 * @param fetcher Fetcher from image_fetcher_mirror_create()
+	 * @param prefix URL prefix, such as "https://cdn.example.com/assets/" (copied)
+	 * @param directory Local directory mirroring the prefix (copied)
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_INVAL for another kind of fetcher)
+	 * @note The longest matching prefix wins, paths climbing out with ".." are refused
+	 * @warning Not synchronized with fetches, add every mapping before use
+	 */
+	int image_fetcher_mirror_add(ImageFetcher* fetcher, const char* prefix, const char* directory);
+
+	/**
+	 * @brief Creates a backend serving images held in memory.
+	 * @return Success: Fetcher, empty until image_fetcher_memory_add() is called
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 */
+	ImageFetcher* image_fetcher_memory_create(void);
+
+	/**
+	 * @brief Registers the bytes served for an image source.
+	 * @param fetcher Fetcher from image_fetcher_memory_create()
+	 * @param src Image source, matched exactly (copied)
+	 * @param data Image bytes (copied)
+	 * @param size Byte count
+	 * @return Success: 1, replacing an earlier registration of src
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_INVAL for another kind of fetcher)
+	 * @warning Not synchronized with fetches, add every image before use
+	 */
+	int image_fetcher_memory_add(ImageFetcher* fetcher, const char* src,
+		const void* data, size_t size);
+
+	/**
+	 * @brief Creates a backend downloading through a libcurl engine of its own.
+	 * @param options Engine tuning (NULL for the defaults of html_download_engine_create())
+	 * @return Success: Fetcher serving every source with a URL scheme, data URIs excepted
+	 * @return Failure: NULL with error set (see html_download_engine_create())
+	 */
+	ImageFetcher* image_fetcher_curl_create(const HTMLDownloadOptions* options);
+
+	/**
+	 * @brief Combines fetchers, each source goes to the first one that accepts it.
+	 * @param fetchers Backends in order of preference (ownership taken, also on failure)
+	 * @param count Number of backends
+	 * @return Success: Fetcher accepting what any backend accepts, NULL members are skipped
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NULL, HTML2TEX_ERR_NOMEM)
+	 */
+	ImageFetcher* image_fetcher_chain_create(ImageFetcher* const* fetchers, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
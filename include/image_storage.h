@@ -96,7 +96,9 @@ extern "C" {
 	 *                     Must be a valid, non-empty string representing an existing file.
 	 * @return Status code indicating operation result:
 	 *
-	 *         -  Success: 1, image queued for deferred processing
+	 *         -  Success: 1, image queued for deferred processing (or already queued
+	 *
+	 *            by the current document, which counts a deduplication hit)
 	 *
 	 *         -  Success: 0, lazy downloading not enabled or storage is NULL (no operation)
 	 *
@@ -130,6 +132,39 @@ extern "C" {
 	 */
 	ImageStorage* copy_image_storage(const ImageStorage* store);
 
+	/**
+	 * @brief Records an image URL of the current document and its local path.
+	 * @param store Image storage
+	 * @param url Image URL or data URI (copied)
+	 * @param path Local path (copied, NULL while the image is only queued)
+	 * @return 1: URL recorded for the first time
+	 * @return 0: URL already recorded, a missing path is filled in
+	 * @return -1: Failure with error set
+	 */
+	int image_storage_track_url(ImageStorage* store, const char* url, const char* path);
+
+	/**
+	 * @brief Gets the local path an earlier reference to url was given.
+	 * @param store Image storage (NULL-safe)
+	 * @param url Image URL or data URI
+	 * @return Path owned by the storage (valid until the URLs are forgotten), NULL if unknown
+	 * @note Every hit is counted, see image_storage_dedup_hits()
+	 */
+	const char* image_storage_reuse_url(ImageStorage* store, const char* url);
+
+	/**
+	 * @brief Forgets the URLs of the current document and resets the hit count.
+	 * @param store Image storage (NULL-safe)
+	 */
+	void image_storage_forget_urls(ImageStorage* store);
+
+	/**
+	 * @brief Gets how many image references reused an earlier URL of the document.
+	 * @param store Image storage (NULL-safe)
+	 * @return Deduplication hit count
+	 */
+	size_t image_storage_dedup_hits(const ImageStorage* store);
+
 #ifdef __cplusplus
 }
 #endif
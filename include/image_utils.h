@@ -3,11 +3,15 @@
 
 #include <stddef.h>
 #include "html2tex_stack.h"
+#include "image_downloader.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 	typedef struct ImageStorage ImageStorage;
+	typedef struct ImagePrefetch ImagePrefetch;
+	typedef struct ImageFetcher ImageFetcher;
+	typedef struct HTMLDownloadSink HTMLDownloadSink;
 
 	/**
 	 * @brief Downloads or processes image source to local file with collision avoidance.
@@ -17,9 +21,123 @@ extern "C" {
 	 * @param image_counter Sequence number for unique filename generation
 	 * @return Success: Local file path (caller must free())
 	 * @return Failure: NULL with error set
+	 * @note Base64 data URIs are decoded in place and streamed to disk in fixed-size blocks,
+	 *       even when storage defers downloads
 	 */
 	char* download_image_src(ImageStorage** storage, const char* src, const char* output_dir, int image_counter);
 
+	/**
+	 * @brief Like download_image_src(), but images are read through a fetcher.
+	 * @param fetcher Image fetcher (NULL downloads through the shared libcurl engine)
+	 * @param storage Image storage structure for deferred download management (NULL for immediate processing)
+	 * @param src Image source (URL, file path, or Base64 data URI)
+	 * @param output_dir Directory for downloaded images (created if needed)
+	 * @param image_counter Sequence number for unique filename generation
+	 * @return Success: Local file path (caller must free())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_IMAGE_DOWNLOAD when the fetcher does not serve src)
+	 * @note Data URIs are still decoded locally
+	 */
+	char* fetch_image_src(ImageFetcher* fetcher, ImageStorage** storage,
+		const char* src, const char* output_dir, int image_counter);
+
+	/**
+	 * @brief Builds the collision-free local path an image source is saved to.
+	 * @param src Image source (URL, file path, or Base64 data URI)
+	 * @param output_dir Directory for downloaded images (created if needed)
+	 * @param image_counter Sequence number for unique filename generation
+	 * @return Success: Local file path (caller must free())
+	 * @return Failure: NULL with error set
+	 */
+	char* prepare_image_path(const char* src, const char* output_dir, int image_counter);
+
+	/**
+	 * @brief Like prepare_image_path(), but leaves the file system alone.
+	 * @param src Image source (URL, file path, or Base64 data URI)
+	 * @param output_dir Directory the path is placed in (not created)
+	 * @param image_counter Sequence number for unique filename generation
+	 * @return Success: Local file path (caller must free())
+	 * @return Failure: NULL with error set
+	 * @note Names images delivered in memory with the path the converter references
+	 */
+	char* build_image_path(const char* src, const char* output_dir, int image_counter);
+
+	/**
+	 * @brief Creates a directory and its missing parents.
+	 * @param dir_path Directory to create (absolute or relative)
+	 * @return Success: 0, also when it already exists
+	 * @return Failure: -1 with error set
+	 */
+	int create_directory_if_not_exists(const char* dir_path);
+
+	/**
+	 * @brief Starts tracking image downloads that overlap with a conversion.
+	 * @param fetcher Fetcher serving the images of the set (NULL for the shared libcurl engine, not owned)
+	 * @return Success: Prefetch set (see image_prefetch_join())
+	 * @return Failure: NULL with error set (HTML2TEX_ERR_NOMEM)
+	 * @warning Without a fetcher, requires an image_utils_init() reference held until the join
+	 */
+	ImagePrefetch* image_prefetch_create(ImageFetcher* fetcher);
+
+	/**
+	 * @brief Selects where the images of a prefetch set go.
+	 * @param prefetch Prefetch set, before its first image
+	 * @param delivery Delivery mode (IMAGE_DELIVERY_FILE by default)
+	 * @param writer Receiver for IMAGE_DELIVERY_STREAM (copied, NULL otherwise)
+	 * @param user_data Context for the writer
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_INVAL for a set with a fetcher, which only writes files)
+	 * @note Memory and stream deliveries name each image with the path a file delivery would
+	 *       write, but neither write it nor create the directory. Data URIs are decoded on the
+	 *       calling thread, URLs on the event loop of the shared engine
+	 */
+	int image_prefetch_set_delivery(ImagePrefetch* prefetch, ImageDelivery delivery,
+		const ImageStreamWriter* writer, void* user_data);
+
+	/**
+	 * @brief Like download_image_src(), but URLs are fetched in the background.
+	 * @param prefetch Prefetch set (NULL downloads synchronously)
+	 * @param storage Image storage structure for deferred download management (NULL for immediate processing)
+	 * @param src Image source (URL, file path, or Base64 data URI)
+	 * @param output_dir Directory for downloaded images (created if needed)
+	 * @param image_counter Sequence number for unique filename generation
+	 * @return Success: Local file path, written by the time the set is joined (caller must free())
+	 * @return Failure: NULL with error set
+	 * @note Data URIs are still decoded immediately. A source the storage already saw in
+	 *       this document gets the path of its first reference and is not fetched again
+	 */
+	char* prefetch_image_src(ImagePrefetch* prefetch, ImageStorage** storage,
+		const char* src, const char* output_dir, int image_counter);
+
+	/**
+	 * @brief Waits for every download of the set and frees it.
+	 * @param prefetch Prefetch set (NULL-safe)
+	 * @param images Receives the images delivered in memory ordered by image_counter,
+	 *        NULL when there are none (NULL releases them, see image_prefetch_free_images())
+	 * @param image_count Receives the number of images (may be NULL)
+	 * @return Number of downloads that failed
+	 * @note Leaves the error state untouched
+	 */
+	size_t image_prefetch_join(ImagePrefetch* prefetch, DownloadResult*** images, size_t* image_count);
+
+	/**
+	 * @brief Releases the images a prefetch set delivered in memory.
+	 * @param images Images from image_prefetch_join() (NULL-safe)
+	 * @param image_count Number of images
+	 * @note They are filled on the event loop, so they live in the process-wide allocator
+	 */
+	void image_prefetch_free_images(DownloadResult** images, size_t image_count);
+
+	/**
+	 * @brief Decodes a Base64 data URI into a receiver instead of a file.
+	 * @param src Base64 data URI
+	 * @param sink Receiver, begin gets the MIME type of the URI before the first block
+	 * @param user_data Context for the sink
+	 * @return Success: 1
+	 * @return Failure: 0 with error set (HTML2TEX_ERR_IMAGE_DECODE, HTML2TEX_ERR_FILE_WRITE when the sink aborts)
+	 * @note Decodes in the same fixed-size blocks as download_image_src(), nothing touches the disk
+	 */
+	int stream_base64_image(const char* src, const HTMLDownloadSink* sink, void* user_data);
+
 	/**
 	 * @brief Detects Base64-encoded image data URIs.
 	 * @param src String to test
@@ -32,12 +150,25 @@ extern "C" {
 	 * @brief Initializes image download subsystem.
 	 * @return Success: 0
 	 * @return Failure: -1 with error set
+	 * @note Calls are counted, the shared download engine keeps its connections
+	 *       alive until the matching number of image_utils_cleanup() calls
 	 */
 	int image_utils_init(void);
 
 	/* @brief Releases image download resources. */
 	void image_utils_cleanup(void);
 
+	/**
+	 * @brief Sets the persistent cache used by image downloads of every conversion.
+	 * @param dir Cache directory, NULL closes the current cache
+	 * @param max_bytes Size bound of the cache (0 for HTML_IMAGE_CACHE_MAX_BYTES)
+	 * @return Success: 0
+	 * @return Failure: -1 with error set (HTML2TEX_ERR_INVAL while downloads are in progress)
+	 * @note A repeat conversion materializes unchanged images from the cache without
+	 *       network I/O, the index is written whenever the download engine stops
+	 */
+	int image_utils_set_cache(const char* dir, unsigned long long max_bytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -76,7 +76,7 @@ extern "C" {
 	int string_buffer_append_printf(StringBuffer* buf, const char* format, ...);
 
 	/**
-	 * @brief Appends string with LaTeX special character escaping.
+	 * @brief Appends UTF-8 string with LaTeX special character escaping.
 	 * @param buf Target string buffer
 	 * @param str Raw string to escape and append
 	 * @return Success: 0
@@ -84,6 +84,14 @@ extern "C" {
 	 */
 	int string_buffer_append_latex(StringBuffer* buf, const char* str);
 
+	/**
+	 * @brief Maps a Unicode code point to its LaTeX text or math command.
+	 * @param code_point Code point decoded from UTF-8 input
+	 * @return Mapped: Command string (e.g. \'{e} for U+00E9, empty for dropped characters)
+	 * @return Unmapped: NULL, the character is emitted as UTF-8
+	 */
+	const char* latex_unicode_command(unsigned long code_point);
+
 	/**
 	 * @brief Returns read-only pointer to buffer contents.
 	 * @param buf String buffer to query
@@ -0,0 +1,23 @@
+#include "ext/css_selector.hpp"
+#include "html2tex.h"
+
+CssSelector::CssSelector(const std::string& selector)
+    : source(selector) {
+    CSSSelector* raw = css_selector_compile(source.c_str());
+    if (!raw) throw HtmlRuntimeException::fromHtmlError();
+
+    compiled = std::shared_ptr<CSSSelector>(raw, css_selector_destroy);
+}
+
+const std::string& CssSelector::text() const noexcept {
+    return source;
+}
+
+bool CssSelector::matches(const HTMLNode* node, const HTMLNode* root) const {
+    CSSMatchContext context;
+    css_match_context_init(&context, root);
+
+    const bool matched = css_selector_matches(compiled.get(), node, &context) != 0;
+    css_match_context_cleanup(&context);
+    return matched;
+}
@@ -1,13 +1,16 @@
 #include "html2tex.h"
 #include <stdlib.h>
 #include <string.h>
+#include <stdio.h>
 
-LaTeXConverter* html2tex_create(void) {
+static LaTeXConverter* create_converter(const HTML2TeXAllocator* allocator) {
     html2tex_err_clear();
-    LaTeXConverter* converter = calloc(1, sizeof(LaTeXConverter));
+    LaTeXConverter* converter = html2tex_calloc(1, sizeof(LaTeXConverter));
     HTML2TEX__CHECK_NULL(converter, HTML2TEX_ERR_NOMEM, 
         "Converter initialization failed.");
 
+    converter->allocator = allocator;
+
     converter->buffer = string_buffer_create(1024);
     HTML2TEX__CHECK_NULL(converter->buffer, HTML2TEX_ERR_NOMEM, 
         "String buffer memory allocation failed.");
@@ -36,46 +39,79 @@ LaTeXConverter* html2tex_create(void) {
     converter->image_output_dir = NULL;
     converter->download_images = 0;
     converter->image_counter = 0;
+    converter->input_charset = HTML_CHARSET_UNKNOWN;
     converter->current_css = NULL;
+    converter->stylesheet = NULL;
+    converter->ancestors = NULL;
+    converter->match_context = NULL;
     converter->store = NULL;
+    converter->prefetch = NULL;
+    converter->fetcher = NULL;
+    converter->image_delivery = IMAGE_DELIVERY_FILE;
+    memset(&converter->image_writer, 0, sizeof(converter->image_writer));
+    converter->image_writer_data = NULL;
+    converter->images = NULL;
+    converter->image_count = 0;
 
     return converter;
 }
 
-LaTeXConverter* html2tex_copy(LaTeXConverter* converter) {
+LaTeXConverter* html2tex_create(void) {
+    return html2tex_create_with_allocator(NULL);
+}
+
+LaTeXConverter* html2tex_create_with_allocator(const HTML2TeXAllocator* allocator) {
+    /* the converter and everything it allocates live in its allocator */
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(allocator);
+    LaTeXConverter* converter = create_converter(allocator);
+
+    html2tex_allocator_leave(previous);
+    return converter;
+}
+
+static LaTeXConverter* copy_converter(LaTeXConverter* converter) {
     html2tex_err_clear();
     HTML2TEX__CHECK_NULL(converter, HTML2TEX_ERR_NULL,
         "Converter initialization failed.");
 
-    LaTeXConverter* clone = calloc(1, sizeof(LaTeXConverter));
+    LaTeXConverter* clone = html2tex_calloc(1, sizeof(LaTeXConverter));
     HTML2TEX__CHECK_NULL(clone, HTML2TEX_ERR_NOMEM,
         "Clone converter memory allocation failed.");
 
     /* initialize to safe defaults before any allocations */
     clone->buffer = NULL;
     clone->current_css = NULL;
+    clone->stylesheet = NULL;
+    clone->ancestors = NULL;
+    clone->match_context = NULL;
     clone->store = NULL;
     clone->image_output_dir = NULL;
     clone->state.table_caption = NULL;
 
     /* copy primitive fields */
+    clone->allocator = converter->allocator;
     clone->state = converter->state;
     clone->download_images = converter->download_images;
+    clone->fetcher = converter->fetcher;
+    clone->image_delivery = converter->image_delivery;
+    clone->image_writer = converter->image_writer;
+    clone->image_writer_data = converter->image_writer_data;
     clone->image_counter = converter->image_counter;
+    clone->input_charset = converter->input_charset;
 
     /* clear pointers in cloned state */
     clone->state.table_caption = NULL;
 
     /* copy string fields with duplication */
     if (converter->state.table_caption) {
-        clone->state.table_caption = strdup(converter->state.table_caption);
+        clone->state.table_caption = html2tex_strdup(converter->state.table_caption);
         HTML2TEX__CHECK_NULL(clone->state.table_caption,
             HTML2TEX_ERR_NOMEM, "Table caption duplication"
             " in memory failed.");
     }
 
     if (converter->image_output_dir) {
-        clone->image_output_dir = strdup(converter->image_output_dir);
+        clone->image_output_dir = html2tex_strdup(converter->image_output_dir);
         HTML2TEX__CHECK_NULL(clone->image_output_dir,
             HTML2TEX_ERR_NOMEM, "Image directory "
             "duplication failed.");
@@ -131,6 +167,15 @@ LaTeXConverter* html2tex_copy(LaTeXConverter* converter) {
     return clone;
 }
 
+LaTeXConverter* html2tex_copy(LaTeXConverter* converter) {
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(
+        converter ? converter->allocator : NULL);
+    LaTeXConverter* clone = copy_converter(converter);
+
+    html2tex_allocator_leave(previous);
+    return clone;
+}
+
 void html2tex_set_image_directory(LaTeXConverter* converter, const char* dir) {
     if (!converter) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, 
@@ -138,18 +183,22 @@ void html2tex_set_image_directory(LaTeXConverter* converter, const char* dir) {
         return;
     }
 
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(converter->allocator);
+
     if (converter->image_output_dir) {
-        free(converter->image_output_dir);
+        html2tex_free(converter->image_output_dir);
         converter->image_output_dir = NULL;
     }
 
     if (dir && dir[0] != '\0') {
-        converter->image_output_dir = strdup(dir);
+        converter->image_output_dir = html2tex_strdup(dir);
         if (!converter->image_output_dir) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM, 
                 "Image directory memory allocation failed.");
         }
     }
+
+    html2tex_allocator_leave(previous);
 }
 
 void html2tex_set_download_images(LaTeXConverter* converter, int enable) {
@@ -161,18 +210,88 @@ void html2tex_set_download_images(LaTeXConverter* converter, int enable) {
     converter->download_images = enable ? 1 : 0;
 }
 
-char* html2tex_convert(LaTeXConverter* converter, const char* html) {
-    html2tex_err_clear();
+void html2tex_set_image_fetcher(LaTeXConverter* converter, ImageFetcher* fetcher) {
+    if (!converter) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, 
+            "Converter is not initialized.");
+        return;
+    }
 
-    HTML2TEX__CHECK_NULL(converter, HTML2TEX_ERR_NULL, 
-        "Converter is not initialized.");
-    HTML2TEX__CHECK_NULL(html, HTML2TEX_ERR_NULL, 
-        "HTML input is NULL.");
+    /* fetchers write files, only the engine hands out the body */
+    if (fetcher && converter->image_delivery != IMAGE_DELIVERY_FILE) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetchers only deliver files, select IMAGE_DELIVERY_FILE first.");
+        return;
+    }
+
+    converter->fetcher = fetcher;
+}
+
+void html2tex_set_image_delivery(LaTeXConverter* converter, ImageDelivery delivery,
+    const ImageStreamWriter* writer, void* user_data) {
+    if (!converter || (delivery == IMAGE_DELIVERY_STREAM && (!writer || !writer->write))) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, 
+            "Converter or stream writer is NULL.");
+        return;
+    }
+
+    if (delivery < IMAGE_DELIVERY_FILE || delivery > IMAGE_DELIVERY_STREAM) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL, 
+            "Unsupported image delivery %d.", (int)delivery);
+        return;
+    }
 
+    if (converter->fetcher && delivery != IMAGE_DELIVERY_FILE) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetchers only deliver files, remove the fetcher first.");
+        return;
+    }
+
+    converter->image_delivery = delivery;
+    converter->image_writer_data = user_data;
+    memset(&converter->image_writer, 0, sizeof(converter->image_writer));
+
+    if (delivery == IMAGE_DELIVERY_STREAM)
+        converter->image_writer = *writer;
+}
+
+const DownloadResult* const* html2tex_get_delivered_images(const LaTeXConverter* converter,
+    size_t* count) {
+    if (count) *count = converter ? converter->image_count : 0;
+    return converter ? (const DownloadResult* const*)converter->images : NULL;
+}
+
+size_t html2tex_get_image_dedup_hits(const LaTeXConverter* converter) {
+    return converter ? image_storage_dedup_hits(converter->store) : 0;
+}
+
+void html2tex_set_input_charset(LaTeXConverter* converter, HTMLCharset charset) {
+    if (!converter) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, 
+            "Converter is not initialized.");
+        return;
+    }
+
+    if (charset < HTML_CHARSET_UNKNOWN || charset >= HTML_CHARSET_COUNT) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL, 
+            "Unsupported input charset %d.", (int)charset);
+        return;
+    }
+
+    converter->input_charset = charset;
+}
+
+/* resets per-document state ahead of a conversion */
+static int begin_conversion(LaTeXConverter* converter) {
     converter->image_counter = 0;
 
+    /* images delivered in memory belong to one conversion */
+    image_prefetch_free_images(converter->images, converter->image_count);
+    converter->images = NULL;
+    converter->image_count = 0;
+
     if (converter->state.table_caption) {
-        free(converter->state.table_caption);
+        html2tex_free(converter->state.table_caption);
         converter->state.table_caption = NULL;
     }
 
@@ -186,33 +305,75 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
         if (string_buffer_clear(converter->buffer) != 0) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
                 "Buffer clear failed because of overflow.");
-            return NULL;
+            return 0;
         }
     }
     else {
         converter->buffer = string_buffer_create(1024);
-        HTML2TEX__CHECK_NULL(converter->buffer,
-            HTML2TEX_ERR_NOMEM, "String buffer"
-            " creation failed.");
+
+        if (!converter->buffer) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "String buffer creation failed.");
+            return 0;
+        }
     }
 
     /* initialize image download if needed */
     if (converter->download_images) {
-        if (image_utils_init() != 0) {
+        /* the storage maps each image URL of the document to its file */
+        if (!converter->store) {
+            converter->store = create_image_storage();
+            if (!converter->store) return 0;
+        }
+
+        image_storage_forget_urls(converter->store);
+
+        /* a fetcher replaces the shared engine, no curl setup is needed */
+        if (!converter->fetcher && image_utils_init() != 0) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE, 
                 "Image utils init failed.");
-            return NULL;
+            return 0;
+        }
+
+        /* images download in the background while the tree is converted */
+        converter->prefetch = image_prefetch_create(converter->fetcher);
+
+        if (!converter->prefetch || !image_prefetch_set_delivery(converter->prefetch,
+            converter->image_delivery, &converter->image_writer, converter->image_writer_data)) {
+            image_prefetch_join(converter->prefetch, NULL, NULL);
+            converter->prefetch = NULL;
+
+            if (!converter->fetcher) image_utils_cleanup();
+            return 0;
         }
     }
 
-    /* compress the HTML code */
-    char* compact_html = html2tex_compress_html(html);
-    HTML2TEX__CHECK_NULL(compact_html, HTML2TEX_ERR_PARSE, 
-        "HTML compression failed.");
+    return 1;
+}
+
+/* joins the image downloads started by the conversion and releases the engine */
+static void end_image_downloads(LaTeXConverter* converter) {
+    if (!converter->download_images) return;
+
+    image_prefetch_join(converter->prefetch, &converter->images, &converter->image_count);
+    converter->prefetch = NULL;
+    if (!converter->fetcher) image_utils_cleanup();
+}
+
+/* writes the complete LaTeX document for a parsed tree, takes ownership of root */
+static char* finish_conversion(LaTeXConverter* converter, HTMLNode* root) {
+    if (!root) {
+        end_image_downloads(converter);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_PARSE, 
+            "Parsed HTML content failed.");
+        return NULL;
+    }
 
     /* add LaTeX preamble */
     if (string_buffer_append(converter->buffer,
         "\\documentclass{article}\n"
+        "\\usepackage[T1]{fontenc}\n"
+        "\\usepackage{textcomp}\n"
         "\\usepackage{hyperref}\n"
         "\\usepackage{ulem}\n"
         "\\usepackage[table]{xcolor}\n"
@@ -220,20 +381,14 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
         "\\usepackage{graphicx}\n"
         "\\usepackage{placeins}\n"
         "\\setcounter{secnumdepth}{4}\n", 0) != 0) {
-        free(compact_html);
-        if (converter->download_images) image_utils_cleanup();
+        html2tex_free_node(root);
+        end_image_downloads(converter);
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
             "LaTeX preamble overflow.");
         return NULL;
     }
 
-    /* parse HTML and extract title */
-    HTMLNode* root = html2tex_parse(compact_html);
-    free(compact_html);
-
-    HTML2TEX__CHECK_NULL(root, HTML2TEX_ERR_PARSE, 
-        "Parsed HTML content failed.");
-
+    /* extract the title */
     char* title = html2tex_extract_title(root);
     int has_title = 0;
 
@@ -242,21 +397,21 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
         if (string_buffer_append(converter->buffer, "\\title{", 7) != 0 ||
             string_buffer_append_latex(converter->buffer, title) != 0 ||
             string_buffer_append(converter->buffer, "}\n", 2) != 0) {
-            free(title);
+            html2tex_free(title);
             html2tex_free_node(root);
-            if (converter->download_images) image_utils_cleanup();
+            end_image_downloads(converter);
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
                 "Title addition failed.");
             return NULL;
         }
-        free(title);
+        html2tex_free(title);
     }
 
     /* begin the document */
     if (string_buffer_append(converter->buffer,
         "\\begin{document}\n", 0) != 0) {
         html2tex_free_node(root);
-        if (converter->download_images) image_utils_cleanup();
+        end_image_downloads(converter);
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
             "Document begin overflow.");
         return NULL;
@@ -266,7 +421,7 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
     if (has_title) {
         if (string_buffer_append(converter->buffer, "\\maketitle\n\n", 0) != 0) {
             html2tex_free_node(root);
-            if (converter->download_images) image_utils_cleanup();
+            end_image_downloads(converter);
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
                 "Failed maketitle addition.");
             return NULL;
@@ -279,22 +434,20 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
 
     /* check for conversion errors */
     if (html2tex_has_error()) {
-        if (converter->download_images) 
-            image_utils_cleanup();
+        end_image_downloads(converter);
         return NULL;
     }
 
     /* end the document */
     if (string_buffer_append(converter->buffer, "\n\\end{document}\n", 0) != 0) {
-        if (converter->download_images) image_utils_cleanup();
+        end_image_downloads(converter);
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW, 
             "Document end overflow.");
         return NULL;
     }
 
-    /* cleanup image download resources */
-    if (converter->download_images)
-        image_utils_cleanup();
+    /* wait for the images and cleanup download resources */
+    end_image_downloads(converter);
 
     /* return the output */
     char* result = string_buffer_detach(converter->buffer);
@@ -304,6 +457,169 @@ char* html2tex_convert(LaTeXConverter* converter, const char* html) {
     return result;
 }
 
+static char* convert_html(LaTeXConverter* converter, const char* html) {
+    html2tex_err_clear();
+
+    HTML2TEX__CHECK_NULL(converter, HTML2TEX_ERR_NULL, 
+        "Converter is not initialized.");
+    HTML2TEX__CHECK_NULL(html, HTML2TEX_ERR_NULL, 
+        "HTML input is NULL.");
+
+    if (!begin_conversion(converter))
+        return NULL;
+
+    /* compress the HTML code */
+    char* compact_html = html2tex_compress_html(html);
+
+    if (!compact_html) {
+        end_image_downloads(converter);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_PARSE, 
+            "HTML compression failed.");
+        return NULL;
+    }
+
+    /* parse HTML and emit the document */
+    HTMLNode* root = html2tex_parse_charset(compact_html, converter->input_charset);
+    html2tex_free(compact_html);
+
+    return finish_conversion(converter, root);
+}
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+    int oversized;
+} InflatedInput;
+
+static int collect_inflated(const char* data, size_t length, void* user_data) {
+    InflatedInput* input = (InflatedInput*)user_data;
+
+    /* same cap as HtmlParser, an archive may not expand without bound */
+    if (length > HTML_COMPRESSION_MAX_INFLATED - input->length) {
+        input->oversized = 1;
+        return 0;
+    }
+
+    if (length > input->capacity - input->length) {
+        size_t capacity = input->capacity ? input->capacity : HTML_COMPRESSION_CHUNK;
+        while (capacity - input->length < length) capacity *= 2;
+
+        char* grown = (char*)html2tex_realloc(input->data, capacity);
+        if (!grown) return 0;
+
+        input->data = grown;
+        input->capacity = capacity;
+    }
+
+    memcpy(input->data + input->length, data, length);
+    input->length += length;
+    return 1;
+}
+
+static int write_output(const char* data, size_t length, void* user_data) {
+    return fwrite(data, 1, length, (FILE*)user_data) == length;
+}
+
+char* html2tex_convert(LaTeXConverter* converter, const char* html) {
+    /* every allocation of the conversion, result included, uses the converter's allocator */
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(
+        converter ? converter->allocator : NULL);
+    char* result = convert_html(converter, html);
+
+    html2tex_allocator_leave(previous);
+    return result;
+}
+
+static int convert_file(LaTeXConverter* converter, const char* path, const char* out_path) {
+    html2tex_err_clear();
+
+    if (!converter || !path || !out_path) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Converter, input path or output path is NULL.");
+        return 0;
+    }
+
+    HTMLMappedFile* mapped = html_mapped_file_open(path);
+    if (!mapped) return 0;
+
+    const char* html = html_mapped_file_data(mapped);
+    size_t length = html_mapped_file_length(mapped);
+    InflatedInput inflated = { NULL, 0, 0, 0 };
+
+    /* compressed archives are inflated, plain files are read from the mapping */
+    const HTMLCompression compression = html_compression_detect(
+        (const unsigned char*)html, length);
+
+    if (compression != HTML_COMPRESSION_NONE) {
+        HTMLCodec* codec = html_codec_create(compression, 0);
+        int inflated_ok = codec && html_codec_process(codec, html,
+            length, 1, collect_inflated, &inflated);
+
+        html_codec_destroy(codec);
+        html_mapped_file_close(mapped);
+        mapped = NULL;
+
+        if (!inflated_ok) {
+            if (inflated.oversized)
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_MALFORMED,
+                    "Archive '%s' inflates past %zu bytes.",
+                    path, (size_t)HTML_COMPRESSION_MAX_INFLATED);
+
+            html2tex_free(inflated.data);
+            return 0;
+        }
+
+        html = inflated.data ? inflated.data : "";
+        length = inflated.length;
+    }
+
+    /* whitespace is collapsed as in html2tex_convert(), read straight from the mapping */
+    size_t compact_length = 0;
+    char* compact_html = html2tex_compress_html_buffer(html, length, &compact_length);
+
+    html_mapped_file_close(mapped);
+    html2tex_free(inflated.data);
+
+    if (!compact_html) return 0;
+
+    if (!begin_conversion(converter)) {
+        html2tex_free(compact_html);
+        return 0;
+    }
+
+    HTMLNode* root = html2tex_parse_buffer(compact_html, compact_length, converter->input_charset);
+    html2tex_free(compact_html);
+
+    char* result = finish_conversion(converter, root);
+    if (!result) return 0;
+
+    FILE* file = fopen(out_path, "wb");
+
+    if (!file) {
+        html2tex_free(result);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open file '%s' for writing.", out_path);
+        return 0;
+    }
+
+    /* ".gz" and ".zz" outputs are compressed on the way out */
+    HTMLCodec* codec = html_codec_create(html_compression_from_path(out_path), 1);
+    int written = codec && html_codec_process(codec, result,
+        strlen(result), 1, write_output, file);
+
+    html_codec_destroy(codec);
+    html2tex_free(result);
+
+    if (fclose(file) != 0 && written) {
+        written = 0;
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to write LaTeX output to '%s'.", out_path);
+    }
+
+    return written;
+}
+
 int html2tex_get_error(void) {
     return (int)html2tex_err_get();
 }
@@ -312,23 +628,39 @@ const char* html2tex_get_error_message(void) {
     return html2tex_err_msg();
 }
 
+int html2tex_convert_file(LaTeXConverter* converter, const char* path, const char* out_path) {
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(
+        converter ? converter->allocator : NULL);
+    const int converted = convert_file(converter, path, out_path);
+
+    html2tex_allocator_leave(previous);
+    return converted;
+}
+
 void html2tex_destroy(LaTeXConverter* converter) {
     if (!converter) return;
 
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(converter->allocator);
+
     if (converter->buffer)
         string_buffer_destroy(converter->buffer);
 
     if (converter->current_css)
         css_properties_destroy(converter->current_css);
 
+    if (converter->stylesheet)
+        css_stylesheet_destroy(converter->stylesheet);
+
     if (converter->state.table_caption)
-        free(converter->state.table_caption);
+        html2tex_free(converter->state.table_caption);
 
     if (converter->image_output_dir)
-        free(converter->image_output_dir);
+        html2tex_free(converter->image_output_dir);
 
     if (converter->store != NULL)
         destroy_image_storage(converter->store);
 
-    free(converter);
+    image_prefetch_free_images(converter->images, converter->image_count);
+    html2tex_free(converter);
+    html2tex_allocator_leave(previous);
 }
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "html2tex_alloc.h"
+#include "html2tex_errors.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define HTML2TEX_TLS __declspec(thread)
+#else
+#define HTML2TEX_TLS __thread
+#endif
+
+/* size prefix of accounted blocks, padded to the strictest fundamental alignment */
+typedef union {
+    size_t size;
+    long double ld;
+    long long ll;
+    void* ptr;
+} AccountingHeader;
+
+static void* default_malloc(void* user_data, size_t size) {
+    (void)user_data;
+    return malloc(size);
+}
+
+static void* default_realloc(void* user_data, void* ptr, size_t size) {
+    (void)user_data;
+    return realloc(ptr, size);
+}
+
+static void default_free(void* user_data, void* ptr) {
+    (void)user_data;
+    free(ptr);
+}
+
+static const HTML2TeXAllocator DEFAULT_ALLOCATOR = {
+    default_malloc, default_realloc, default_free, NULL
+};
+
+/* process-wide hooks, copied so the caller's struct need not outlive the call */
+static HTML2TeXAllocator process_allocator = {
+    default_malloc, default_realloc, default_free, NULL
+};
+
+/* allocator of the conversion running on this thread, NULL outside of one */
+static HTML2TEX_TLS const HTML2TeXAllocator* tls_allocator = NULL;
+
+static const HTML2TeXAllocator* active_allocator(void) {
+    return tls_allocator ? tls_allocator : &process_allocator;
+}
+
+int html2tex_set_allocator(const HTML2TeXAllocator* allocator) {
+    html2tex_err_clear();
+
+    if (!allocator) {
+        process_allocator = DEFAULT_ALLOCATOR;
+        return 1;
+    }
+
+    if (!allocator->malloc_fn || !allocator->realloc_fn || !allocator->free_fn) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Allocator must provide malloc, realloc and free hooks.");
+        return 0;
+    }
+
+    process_allocator = *allocator;
+    return 1;
+}
+
+const HTML2TeXAllocator* html2tex_get_allocator(void) {
+    return active_allocator();
+}
+
+const HTML2TeXAllocator* html2tex_allocator_enter(const HTML2TeXAllocator* allocator) {
+    const HTML2TeXAllocator* previous = tls_allocator;
+    tls_allocator = allocator;
+    return previous;
+}
+
+void html2tex_allocator_leave(const HTML2TeXAllocator* previous) {
+    tls_allocator = previous;
+}
+
+void* html2tex_malloc(size_t size) {
+    const HTML2TeXAllocator* allocator = active_allocator();
+    return allocator->malloc_fn(allocator->user_data, size);
+}
+
+void* html2tex_calloc(size_t count, size_t size) {
+    if (size && count > SIZE_MAX / size) return NULL;
+
+    const size_t bytes = count * size;
+    void* ptr = html2tex_malloc(bytes);
+
+    if (ptr) memset(ptr, 0, bytes);
+    return ptr;
+}
+
+void* html2tex_realloc(void* ptr, size_t size) {
+    const HTML2TeXAllocator* allocator = active_allocator();
+    return allocator->realloc_fn(allocator->user_data, ptr, size);
+}
+
+void html2tex_free(void* ptr) {
+    if (!ptr) return;
+
+    const HTML2TeXAllocator* allocator = active_allocator();
+    allocator->free_fn(allocator->user_data, ptr);
+}
+
+static void* accounting_malloc(void* user_data, size_t size) {
+    HTML2TeXAccountingAllocator* accounting = (HTML2TeXAccountingAllocator*)user_data;
+    const HTML2TeXAllocator* backing = accounting->backing;
+
+    if (size > SIZE_MAX - sizeof(AccountingHeader)) return NULL;
+    AccountingHeader* header = (AccountingHeader*)backing->malloc_fn(
+        backing->user_data, sizeof(AccountingHeader) + size);
+
+    if (!header) return NULL;
+    header->size = size;
+
+    HTML2TeXAllocStats* stats = &accounting->stats;
+    stats->current += size;
+    stats->total += size;
+    stats->allocations++;
+
+    if (stats->current > stats->peak)
+        stats->peak = stats->current;
+
+    return header + 1;
+}
+
+static void accounting_free(void* user_data, void* ptr) {
+    HTML2TeXAccountingAllocator* accounting = (HTML2TeXAccountingAllocator*)user_data;
+    const HTML2TeXAllocator* backing = accounting->backing;
+
+    if (!ptr) return;
+    AccountingHeader* header = (AccountingHeader*)ptr - 1;
+
+    accounting->stats.current -= header->size;
+    backing->free_fn(backing->user_data, header);
+}
+
+static void* accounting_realloc(void* user_data, void* ptr, size_t size) {
+    HTML2TeXAccountingAllocator* accounting = (HTML2TeXAccountingAllocator*)user_data;
+    const HTML2TeXAllocator* backing = accounting->backing;
+
+    if (!ptr) return accounting_malloc(user_data, size);
+    if (size > SIZE_MAX - sizeof(AccountingHeader)) return NULL;
+
+    AccountingHeader* header = (AccountingHeader*)ptr - 1;
+    const size_t old_size = header->size;
+
+    header = (AccountingHeader*)backing->realloc_fn(
+        backing->user_data, header, sizeof(AccountingHeader) + size);
+
+    if (!header) return NULL;
+    header->size = size;
+
+    /* growth counts towards the total as freshly requested bytes */
+    HTML2TeXAllocStats* stats = &accounting->stats;
+    stats->current = stats->current - old_size + size;
+
+    if (size > old_size)
+        stats->total += size - old_size;
+
+    if (stats->current > stats->peak)
+        stats->peak = stats->current;
+
+    return header + 1;
+}
+
+void html2tex_accounting_init(HTML2TeXAccountingAllocator* accounting,
+    const HTML2TeXAllocator* backing) {
+    if (!accounting) return;
+
+    accounting->allocator.malloc_fn = accounting_malloc;
+    accounting->allocator.realloc_fn = accounting_realloc;
+    accounting->allocator.free_fn = accounting_free;
+    accounting->allocator.user_data = accounting;
+
+    accounting->backing = backing ? backing : &DEFAULT_ALLOCATOR;
+    memset(&accounting->stats, 0, sizeof(HTML2TeXAllocStats));
+}
+
+void html2tex_accounting_reset(HTML2TeXAccountingAllocator* accounting) {
+    if (!accounting) return;
+
+    accounting->stats.peak = accounting->stats.current;
+    accounting->stats.total = 0;
+    accounting->stats.allocations = 0;
+}
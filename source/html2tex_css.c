@@ -198,7 +198,7 @@ static int handle_margin_shorthand(CSSProperties* props, const char* key, const
 }
 
 CSSProperties* css_properties_create(void) {
-    CSSProperties* props = (CSSProperties*)calloc(1, sizeof(CSSProperties));
+    CSSProperties* props = (CSSProperties*)html2tex_calloc(1, sizeof(CSSProperties));
 
     if (!props) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -225,14 +225,14 @@ void css_properties_destroy(CSSProperties* props) {
 
     while (current) {
         CSSProperty* next = current->next;
-        free((void*)current->key);
-        free(current->value);
+        html2tex_free((void*)current->key);
+        html2tex_free(current->value);
 
-        free(current);
+        html2tex_free(current);
         current = next;
     }
 
-    free(props);
+    html2tex_free(props);
 }
 
 static CSSPropertyMask property_to_mask(const char* key) {
@@ -389,14 +389,14 @@ int css_properties_set(CSSProperties* props, const char* key, const char* value,
 
     while (current) {
         if (strcasecmp(current->key, key) == 0) {
-            char* new_value = strdup(value);
+            char* new_value = html2tex_strdup(value);
             if (!new_value) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                     "Failed to duplicate CSS value for property: %s.", key);
                 return 0;
             }
 
-            free(current->value);
+            html2tex_free(current->value);
             current->value = new_value;
             current->important = important ? 1 : 0;
 
@@ -417,19 +417,19 @@ int css_properties_set(CSSProperties* props, const char* key, const char* value,
     int success = 0;
 
     /* allocate with proper error context */
-    new_prop = (CSSProperty*)calloc(1, sizeof(CSSProperty));
+    new_prop = (CSSProperty*)html2tex_calloc(1, sizeof(CSSProperty));
     if (!new_prop) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM, "CSSProperty structure allocation failure.");
         goto cleanup;
     }
 
-    key_copy = strdup(key);
+    key_copy = html2tex_strdup(key);
     if (!key_copy) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM, "CSS property key duplication: %s.", key);
         goto cleanup;
     }
 
-    value_copy = strdup(value);
+    value_copy = html2tex_strdup(value);
     if (!value_copy) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM, "CSS property value duplication.");
         goto cleanup;
@@ -462,9 +462,9 @@ int css_properties_set(CSSProperties* props, const char* key, const char* value,
 
 cleanup:
     /* cleanup path for any allocation failure */
-    if (key_copy) free(key_copy);
-    if (value_copy) free(value_copy);
-    if (new_prop) free(new_prop);
+    if (key_copy) html2tex_free(key_copy);
+    if (value_copy) html2tex_free(value_copy);
+    if (new_prop) html2tex_free(new_prop);
 
 exit:
     return success;
@@ -806,12 +806,12 @@ CSSProperties* parse_css_style(const char* style_str) {
         if (!valid_property) continue;
 
         /* allocate property name and value */
-        char* prop_name = (char*)malloc(prop_len + 1);
-        char* prop_value = (char*)malloc(value_len + 1);
+        char* prop_name = (char*)html2tex_malloc(prop_len + 1);
+        char* prop_value = (char*)html2tex_malloc(value_len + 1);
 
         if (!prop_name || !prop_value) {
-            if (prop_name) free(prop_name);
-            if (prop_value) free(prop_value);
+            if (prop_name) html2tex_free(prop_name);
+            if (prop_value) html2tex_free(prop_value);
 
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate CSS property buffer (prop_len=%zu, value_len=%zu).",
@@ -831,8 +831,8 @@ CSSProperties* parse_css_style(const char* style_str) {
         int success = css_properties_set(props, prop_name, prop_value, important);
 
         /* clean up temporary strings */
-        free(prop_name);
-        free(prop_value);
+        html2tex_free(prop_name);
+        html2tex_free(prop_value);
 
         /* if setting property fails, abort entire parsing */
         if (!success) {
@@ -1016,7 +1016,7 @@ void css_properties_apply(LaTeXConverter* converter, const CSSProperties* props,
                         *applied |= CSS_COLOR;
                     }
 
-                    free(hex);
+                    html2tex_free(hex);
                 }
             }
         }
@@ -1046,7 +1046,7 @@ void css_properties_apply(LaTeXConverter* converter, const CSSProperties* props,
                         *applied |= CSS_BACKGROUND;
                     }
 
-                    free(hex);
+                    html2tex_free(hex);
                 }
             }
         }
@@ -1187,13 +1187,13 @@ void css_properties_end(LaTeXConverter* converter, const CSSProperties* props, c
         }
         else {
             /* pre-allocate a string to reduce function calls */
-            char* braces = (char*)malloc(brace_count + 1);
+            char* braces = (char*)html2tex_malloc(brace_count + 1);
 
             if (braces) {
                 memset(braces, '}', brace_count);
                 braces[brace_count] = '\0';
                 append_string(converter, braces);
-                free(braces);
+                html2tex_free(braces);
             }
             else {
                 /* fallback to loop if allocation fails */
@@ -1365,7 +1365,7 @@ char* css_color_to_hex(const char* color_value) {
         }
 
         if (hex_len == 3) {
-            char* result = (char*)malloc(7);
+            char* result = (char*)html2tex_malloc(7);
             if (!result) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                     "Failed to allocate memory for hex color conversion.");
@@ -1389,7 +1389,7 @@ char* css_color_to_hex(const char* color_value) {
 
         }
         else if (hex_len == 6) {
-            char* result = (char*)malloc(7);
+            char* result = (char*)html2tex_malloc(7);
             if (!result) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                     "Failed to allocate memory for hex color conversion.");
@@ -1427,7 +1427,7 @@ char* css_color_to_hex(const char* color_value) {
                 if (g < 0) g = 0; else if (g > 255) g = 255;
                 if (b < 0) b = 0; else if (b > 255) b = 255;
 
-                char* result = (char*)malloc(7);
+                char* result = (char*)html2tex_malloc(7);
                 if (!result) {
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                         "Failed to allocate memory for hex color conversion.");
@@ -1495,12 +1495,12 @@ char* css_color_to_hex(const char* color_value) {
             }
 
             if (match)
-                return strdup(color_map[i].hex);
+                return html2tex_strdup(color_map[i].hex);
         }
     }
 
     /* default fallback */
-    return strdup("000000");
+    return html2tex_strdup("000000");
 }
 
 int is_css_property_inheritable(const char* property_name) {
@@ -1,6 +1,18 @@
 #include "html2tex.h"
 #include <stdlib.h>
+#include <string.h>
 #include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
+
+/* 1 when the length bytes at src fit before end and match text */
+static int starts_with(const char* src, const char* end, const char* text, size_t length) {
+    return (size_t)(end - src) >= length && strncmp(src, text, length) == 0;
+}
+
+static int starts_with_nocase(const char* src, const char* end, const char* text, size_t length) {
+    return (size_t)(end - src) >= length && strncasecmp(src, text, length) == 0;
+}
 
 char* html2tex_compress_html(const char* html) {
     html2tex_err_clear();
@@ -11,10 +23,22 @@ char* html2tex_compress_html(const char* html) {
         return NULL;
     }
 
-    size_t len = strlen(html);
+    return html2tex_compress_html_buffer(html, strlen(html), NULL);
+}
+
+char* html2tex_compress_html_buffer(const char* html, size_t len, size_t* out_length) {
+    html2tex_err_clear();
+
+    if (out_length) *out_length = 0;
+
+    if (!html && len) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, 
+            "HTML input is NULL for compression.");
+        return NULL;
+    }
 
     if (len == 0) {
-        char* empty = strdup("");
+        char* empty = html2tex_strdup("");
 
         if (!empty) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -25,7 +49,7 @@ char* html2tex_compress_html(const char* html) {
         return empty;
     }
 
-    char* result = (char*)malloc(len + 1);
+    char* result = (char*)html2tex_malloc(len + 1);
 
     if (!result) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -35,6 +59,7 @@ char* html2tex_compress_html(const char* html) {
     }
 
     const char* src = html;
+    const char* const end = html + len;
     char* dest = result;
 
     int in_tag = 0;
@@ -45,15 +70,15 @@ char* html2tex_compress_html(const char* html) {
     int last_char_was_gt = 0;
     int skip_whitespace = 0;
 
-    while (*src) {
+    while (src < end) {
         unsigned char c = (unsigned char)*src;
 
         /* handle comments */
         if (!in_quotes && !in_tag && !in_script_style) {
-            if (c == '<' && strncmp(src, "<!--", 4) == 0)
+            if (c == '<' && starts_with(src, end, "<!--", 4))
                 in_comment = 1;
             else if (c == '-' && in_comment && 
-                strncmp(src, "-->", 3) == 0) {
+                starts_with(src, end, "-->", 3)) {
                 in_comment = 0; *dest++ = '-'; 
                 *dest++ = '-'; *dest++ = '>';
                 src += 2; goto next_char;
@@ -68,20 +93,20 @@ char* html2tex_compress_html(const char* html) {
         /* detect script/style tags */
         if (!in_quotes && c == '<') {
             const char* tag_start = src + 1;
-            while (*tag_start && isspace((unsigned char)*tag_start)) 
+            while (tag_start < end && isspace((unsigned char)*tag_start)) 
                 tag_start++;
 
-            if (strncasecmp(tag_start, "script", 6) == 0 ||
-                strncasecmp(tag_start, "style", 5) == 0)
+            if (starts_with_nocase(tag_start, end, "script", 6) ||
+                starts_with_nocase(tag_start, end, "style", 5))
                 in_script_style = 1;
         }
         /* check for closing script/style tags */
-        else if (!in_quotes && c == '<' && strncmp(src, "</", 2) == 0) {
+        else if (!in_quotes && c == '<' && starts_with(src, end, "</", 2)) {
             const char* tag_start = src + 2;
-            while (*tag_start && isspace((unsigned char)*tag_start)) tag_start++;
+            while (tag_start < end && isspace((unsigned char)*tag_start)) tag_start++;
 
-            if (strncasecmp(tag_start, "script", 6) == 0 ||
-                strncasecmp(tag_start, "style", 5) == 0)
+            if (starts_with_nocase(tag_start, end, "script", 6) ||
+                starts_with_nocase(tag_start, end, "style", 5))
                 in_script_style = 0;
         }
 
@@ -153,7 +178,9 @@ char* html2tex_compress_html(const char* html) {
 
     /* trim to actual size */
     size_t final_len = dest - result;
-    char* final_result = (char*)realloc(result, final_len + 1);
+    if (out_length) *out_length = final_len;
+
+    char* final_result = (char*)html2tex_realloc(result, final_len + 1);
 
     if (!final_result) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -229,6 +256,76 @@ const char* get_attribute(HTMLAttribute* attrs, const char* key) {
     return NULL;
 }
 
+/* Maps a lowercase attribute key to its hot slot, or -1 if not indexed. */
+static int hot_attribute_slot(const char* key) {
+    size_t len = strlen(key);
+
+    switch (key[0]) {
+    case 'a':
+        if (len == 3 && memcmp(key, "alt", 3) == 0) return HTML_ATTR_ALT;
+        break;
+    case 'c':
+        if (len == 5 && memcmp(key, "class", 5) == 0) return HTML_ATTR_CLASS;
+        if (len == 7 && memcmp(key, "colspan", 7) == 0) return HTML_ATTR_COLSPAN;
+        break;
+    case 'h':
+        if (len == 4 && memcmp(key, "href", 4) == 0) return HTML_ATTR_HREF;
+        if (len == 6 && memcmp(key, "height", 6) == 0) return HTML_ATTR_HEIGHT;
+        break;
+    case 'i':
+        if (len == 2 && key[1] == 'd') return HTML_ATTR_ID;
+        break;
+    case 'r':
+        if (len == 7 && memcmp(key, "rowspan", 7) == 0) return HTML_ATTR_ROWSPAN;
+        break;
+    case 's':
+        if (len == 5 && memcmp(key, "style", 5) == 0) return HTML_ATTR_STYLE;
+        if (len == 3 && memcmp(key, "src", 3) == 0) return HTML_ATTR_SRC;
+        break;
+    case 'w':
+        if (len == 5 && memcmp(key, "width", 5) == 0) return HTML_ATTR_WIDTH;
+        break;
+    default:
+        break;
+    }
+
+    return -1;
+}
+
+void html2tex_index_attributes(HTMLNode* node) {
+    if (!node) return;
+
+    for (int i = 0; i < HTML_ATTR_HOT_COUNT; i++)
+        node->hot_attrs[i] = NULL;
+
+    for (HTMLAttribute* attr = node->attributes; attr; attr = attr->next) {
+        if (!attr->key) continue;
+        int slot = hot_attribute_slot(attr->key);
+
+        /* keep the first occurrence, as get_attribute does */
+        if (slot >= 0 && !node->hot_attrs[slot])
+            node->hot_attrs[slot] = attr;
+    }
+}
+
+const char* get_hot_attribute(const HTMLNode* node, HTMLHotAttribute attr) {
+    if (!node) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Node is NULL for hot attribute lookup.");
+        return NULL;
+    }
+
+    if ((unsigned)attr >= HTML_ATTR_HOT_COUNT) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Hot attribute identifier %d is out of range.",
+            (int)attr);
+        return NULL;
+    }
+
+    const HTMLAttribute* slot = node->hot_attrs[attr];
+    return slot ? slot->value : NULL;
+}
+
 char* html2tex_extract_title(const HTMLNode* root) {
     html2tex_err_clear();
 
@@ -267,7 +364,7 @@ char* html2tex_extract_title(const HTMLNode* root) {
             /* extract all text content from title element */
             if (tag_len == 5 && strcmp(current->tag, "title") == 0) {
                 size_t capacity = HTML_TITLE_MAX_SIZE;
-                char* buffer = (char*)malloc(capacity);
+                char* buffer = (char*)html2tex_malloc(capacity);
 
                 if (!buffer) {
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -284,7 +381,7 @@ char* html2tex_extract_title(const HTMLNode* root) {
                 Queue* title_rear = NULL;
 
                 if (!queue_enqueue(&title_front, &title_rear, current)) {
-                    free(buffer);
+                    html2tex_free(buffer);
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                         "Failed to initialize BFS for title"
                         " content extraction.");
@@ -303,7 +400,7 @@ char* html2tex_extract_title(const HTMLNode* root) {
 
                         /* ensure capacity with safe overflow checking */
                         if (length > SIZE_MAX - text_len - 1) {
-                            free(buffer);
+                            html2tex_free(buffer);
                             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                                 "Title text size exceeds maximum allowed.");
                             queue_cleanup(&title_front, &title_rear);
@@ -317,7 +414,7 @@ char* html2tex_extract_title(const HTMLNode* root) {
                             /* cannot double, try to add exactly what's needed */
                             if (capacity > SIZE_MAX / 2) {
                                 if (SIZE_MAX - length - text_len - 1 < capacity) {
-                                    free(buffer);
+                                    html2tex_free(buffer);
                                     HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                                         "Title text requires capacity exceeding SIZE_MAX.");
                                     queue_cleanup(&title_front, &title_rear);
@@ -334,9 +431,9 @@ char* html2tex_extract_title(const HTMLNode* root) {
                                     new_capacity = length + text_len + 1;
                             }
 
-                            char* new_buffer = (char*)realloc(buffer, new_capacity);
+                            char* new_buffer = (char*)html2tex_realloc(buffer, new_capacity);
                             if (!new_buffer) {
-                                free(buffer);
+                                html2tex_free(buffer);
                                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                                     "Failed to reallocate title buffer"
                                     " from %zu to %zu bytes.",
@@ -362,7 +459,7 @@ char* html2tex_extract_title(const HTMLNode* root) {
                         if (!queue_enqueue(&title_front, &title_rear, title_child)) {
                             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                                 "Failed to enqueue title child node.");
-                            free(buffer);
+                            html2tex_free(buffer);
                             queue_cleanup(&title_front, &title_rear);
                             goto cleanup;
                         }
@@ -393,13 +490,13 @@ char* html2tex_extract_title(const HTMLNode* root) {
 
                     if (trimmed_len > 0) {
                         /* allocate exact size for trimmed title */
-                        title_text = (char*)malloc(trimmed_len + 1);
+                        title_text = (char*)html2tex_malloc(trimmed_len + 1);
 
                         if (!title_text) {
                             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                                 "Failed to allocate %zu bytes for"
                                 " trimmed title.", trimmed_len + 1);
-                            free(buffer);
+                            html2tex_free(buffer);
                             goto cleanup;
                         }
 
@@ -412,13 +509,13 @@ char* html2tex_extract_title(const HTMLNode* root) {
                             "Title element contains only whitespace.");
                     }
 
-                    free(buffer);
+                    html2tex_free(buffer);
                 }
                 else {
                     /* empty title */
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_PARSE,
                         "Title element contains no text content.");
-                    free(buffer);
+                    html2tex_free(buffer);
                 }
 
                 /* found title, exit BFS */
@@ -450,7 +547,7 @@ cleanup:
 
     /* if error occurred but title_text was allocated, free it */
     if (html2tex_has_error() && title_text) {
-        free(title_text);
+        html2tex_free(title_text);
         title_text = NULL;
     }
 
@@ -1018,6 +1115,140 @@ int is_whitespace_only(const char* text) {
     return 1;
 }
 
+/* maps a tag to the context it opens, 0 when it opens none */
+static unsigned int tag_context(const char* tag) {
+    if (!tag) return 0;
+
+    switch (tag[0]) {
+    case 't':
+        if (strcmp(tag, "table") == 0) return HTML_CONTEXT_TABLE;
+        if (strcmp(tag, "td") == 0 || strcmp(tag, "th") == 0)
+            return HTML_CONTEXT_TABLE_CELL;
+        break;
+    case 'u': case 'o': case 'd':
+        if (tag[1] == 'l' && tag[2] == '\0') return HTML_CONTEXT_LIST;
+        break;
+    case 'p':
+        if (strcmp(tag, "pre") == 0) return HTML_CONTEXT_PRE;
+        break;
+    }
+
+    return 0;
+}
+
+unsigned int ancestor_filter_hash(char kind, const char* key, size_t len) {
+    /* FNV-1a seeded with the key kind so equal tag, id and class names differ */
+    uint32_t hash = 2166136261u;
+    hash ^= (unsigned char)kind;
+    hash *= 16777619u;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+
+    return (unsigned int)hash;
+}
+
+/* two counter slots per key, saturated counters are never decremented */
+static void ancestor_filter_update(AncestorFilter* filter, unsigned int hash, int delta) {
+    size_t slots[2] = {
+        hash % HTML_ANCESTOR_FILTER_SLOTS,
+        (hash >> 16) % HTML_ANCESTOR_FILTER_SLOTS
+    };
+
+    for (int i = 0; i < 2; i++) {
+        unsigned char* counter = &filter->counters[slots[i]];
+        if (*counter == UCHAR_MAX) continue;
+
+        if (delta > 0) (*counter)++;
+        else if (*counter > 0) (*counter)--;
+    }
+}
+
+static void ancestor_filter_apply(AncestorFilter* filter, const HTMLNode* node, int delta) {
+    ancestor_filter_update(filter, ancestor_filter_hash('t',
+        node->tag, strlen(node->tag)), delta);
+
+    const char* id = get_hot_attribute(node, HTML_ATTR_ID);
+    if (id) ancestor_filter_update(filter, ancestor_filter_hash('#', id, strlen(id)), delta);
+
+    const char* classes = get_hot_attribute(node, HTML_ATTR_CLASS);
+
+    if (classes) {
+        const char* p = classes;
+
+        while (*p) {
+            while (*p && isspace((unsigned char)*p)) p++;
+            const char* start = p;
+
+            while (*p && !isspace((unsigned char)*p)) p++;
+            if (p > start)
+                ancestor_filter_update(filter, ancestor_filter_hash('.',
+                    start, (size_t)(p - start)), delta);
+        }
+    }
+
+    unsigned int context = tag_context(node->tag);
+
+    if (context) {
+        int kind = 0;
+        while (!(context & (1u << kind))) kind++;
+
+        if (delta > 0) filter->context_depth[kind]++;
+        else if (filter->context_depth[kind] > 0) filter->context_depth[kind]--;
+
+        if (filter->context_depth[kind] > 0) filter->context |= context;
+        else filter->context &= ~context;
+    }
+}
+
+void ancestor_filter_reset(AncestorFilter* filter) {
+    if (!filter) return;
+    memset(filter, 0, sizeof(AncestorFilter));
+}
+
+void ancestor_filter_push(AncestorFilter* filter, const HTMLNode* node) {
+    if (!filter || !node || !node->tag) return;
+    ancestor_filter_apply(filter, node, 1);
+    filter->top = node;
+}
+
+void ancestor_filter_pop(AncestorFilter* filter, const HTMLNode* node) {
+    if (!filter || !node || !node->tag) return;
+    ancestor_filter_apply(filter, node, -1);
+    filter->top = node->parent;
+}
+
+int ancestor_filter_may_contain(const AncestorFilter* filter, unsigned int hash) {
+    return filter->counters[hash % HTML_ANCESTOR_FILTER_SLOTS] != 0 &&
+        filter->counters[(hash >> 16) % HTML_ANCESTOR_FILTER_SLOTS] != 0;
+}
+
+int ancestor_filter_covers(const AncestorFilter* filter, const HTMLNode* node) {
+    /* the innermost open element must be the node's parent */
+    return filter && node && filter->top == node->parent;
+}
+
+int is_inside_context(const AncestorFilter* filter, const HTMLNode* node, HTMLContextFlag context) {
+    if (!node) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Node is NULL for context check.");
+        return -1;
+    }
+
+    /* exact answer without touching the parent chain */
+    if (ancestor_filter_covers(filter, node))
+        return (filter->context & (unsigned int)context) != 0;
+
+    for (const HTMLNode* current = node->parent; current; current = current->parent) {
+        if (tag_context(current->tag) & (unsigned int)context)
+            return 1;
+    }
+
+    return 0;
+}
+
 int is_inside_table_cell(LaTeXConverter* converter, const HTMLNode* node) {
     html2tex_err_clear();
 
@@ -1033,22 +1264,9 @@ int is_inside_table_cell(LaTeXConverter* converter, const HTMLNode* node) {
     if (converter->state.in_table_cell) return 1;
     if (!node) return 0;
 
-    /* check node's parent hierarchy for table cells */
-    HTMLNode* current = node->parent;
-
-    while (current) {
-        if (current->tag) {
-            if (current->tag[0] == 't') {
-                if (strcmp(current->tag, "td") == 0 || 
-                    strcmp(current->tag, "th") == 0)
-                    return 1;
-            }
-        }
-
-        current = current->parent;
-    }
-
-    return 0;
+    /* check node's ancestors for table cells */
+    return is_inside_context(converter->ancestors,
+        node, HTML_CONTEXT_TABLE_CELL);
 }
 
 int is_inside_table(const HTMLNode* node) {
@@ -1058,15 +1276,5 @@ int is_inside_table(const HTMLNode* node) {
         return -1;
     }
 
-    HTMLNode* current = node->parent;
-
-    while (current) {
-        if (current->tag && 
-            strcmp(current->tag, "table") == 0)
-            return 1;
-
-        current = current->parent;
-    }
-
-    return 0;
-}
\ No newline at end of file
+    return is_inside_context(NULL, node, HTML_CONTEXT_TABLE);
+}
@@ -1,25 +1,56 @@
 #include "html2tex.h"
+#include <stdint.h>
+#include <string.h>
+
+#ifndef HTML_NODELIST_MIN_CAPACITY
+#define HTML_NODELIST_MIN_CAPACITY 8
+#endif
+
+static int nodelist_reserve(HTMLNodeList* list, size_t needed) {
+    if (needed <= list->capacity) return 1;
+    size_t capacity = list->capacity ? list->capacity : HTML_NODELIST_MIN_CAPACITY;
+
+    while (capacity < needed) {
+        if (capacity > SIZE_MAX / (2 * sizeof(HTMLElement))) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
+                "HTMLNodeList capacity overflow for %zu elements.",
+                needed);
+            return 0;
+        }
 
-static HTMLElementList* element_list_node_create(HTMLElement* element) {
-    /* clear previous errors */
-    html2tex_err_clear();
+        capacity *= 2;
+    }
 
-    HTMLElementList* node = (HTMLElementList*)malloc(sizeof(HTMLElementList));
-    if (!node) {
+    HTMLElement* items = (HTMLElement*)html2tex_realloc(list->items,
+        capacity * sizeof(HTMLElement));
+
+    if (!items) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to allocate HTMLElementList node.");
-        return NULL;
+            "Failed to grow HTMLNodeList to %zu elements.",
+            capacity);
+        return 0;
     }
 
-    node->element = element;
-    node->next = NULL;
-    return node;
+    list->items = items;
+    list->capacity = capacity;
+    return 1;
+}
+
+/* Stores an element by value, taking ownership of its CSS properties. */
+static int nodelist_push(HTMLNodeList* list, HTMLNode* node, CSSProperties* css_props) {
+    if (!nodelist_reserve(list, list->node_count + 1))
+        return 0;
+
+    HTMLElement* slot = &list->items[list->node_count++];
+    slot->node = node;
+    slot->css_props = css_props;
+    return 1;
 }
 
 HTMLNodeList* html_nodelist_create() {
     /* clear previous errors */
     html2tex_err_clear();
-    HTMLNodeList* list = (HTMLNodeList*)calloc(1, sizeof(HTMLNodeList));
+    HTMLNodeList* list = (HTMLNodeList*)html2tex_calloc(1, sizeof(HTMLNodeList));
 
     if (!list) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -28,13 +59,25 @@ HTMLNodeList* html_nodelist_create() {
         return NULL;
     }
 
-    /* init tail pointer to point to head pointer */
-    list->tail = &list->head;
+    list->items = NULL;
     list->node_count = 0;
-    list->head = NULL;
+    list->capacity = 0;
     return list;
 }
 
+int html_nodelist_reserve(HTMLNodeList* list, size_t capacity) {
+    /* clear previous errors */
+    html2tex_err_clear();
+
+    if (!list) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Cannot reserve space in NULL HTMLNodeList.");
+        return 0;
+    }
+
+    return nodelist_reserve(list, capacity);
+}
+
 int html_nodelist_append(HTMLNodeList* list, HTMLElement* element) {
     /* clear previous errors */
     html2tex_err_clear();
@@ -51,13 +94,11 @@ int html_nodelist_append(HTMLNodeList* list, HTMLElement* element) {
         return 0;
     }
 
-    HTMLElementList* new_node = element_list_node_create(element);
-    if (!new_node) return 0;
+    /* amortized O(1) append, the container itself is released */
+    if (!nodelist_push(list, element->node, element->css_props))
+        return 0;
 
-    /* O(1) append using tail pointer */
-    *list->tail = new_node;
-    list->tail = &new_node->next;
-    list->node_count++;
+    html2tex_free(element);
     return 1;
 }
 
@@ -87,21 +128,16 @@ int html_nodelist_extend(HTMLNodeList* dest, HTMLNodeList* src) {
     }
 
     /* source is empty */
-    if (!src->head)
+    if (src->node_count == 0)
         return 1;
 
-    if (!dest->head) {
-        dest->head = src->head;
-        dest->tail = src->tail;
-    }
-    else {
-        *dest->tail = src->head;
-        dest->tail = src->tail;
-    }
+    if (!nodelist_reserve(dest, dest->node_count + src->node_count))
+        return 0;
+
+    memcpy(dest->items + dest->node_count, src->items,
+        src->node_count * sizeof(HTMLElement));
 
     dest->node_count += src->node_count;
-    src->head = NULL;
-    src->tail = &src->head;
     src->node_count = 0;
     return 1;
 }
@@ -110,13 +146,7 @@ HTMLElement* html_nodelist_at(const HTMLNodeList* list, size_t index) {
     if (!list || index >= list->node_count)
         return NULL;
 
-    /* optimized for sequential access starting from head */
-    HTMLElementList* current = list->head;
-
-    for (size_t i = 0; i < index && current; i++)
-        current = current->next;
-
-    return current ? current->element : NULL;
+    return &list->items[index];
 }
 
 size_t html_nodelist_size(const HTMLNodeList* list) {
@@ -124,444 +154,353 @@ size_t html_nodelist_size(const HTMLNodeList* list) {
 }
 
 int html_nodelist_empty(const HTMLNodeList* list) {
-    return !list || !list->head || list->node_count == 0;
+    return !list || list->node_count == 0;
 }
 
 void html_nodelist_destroy(HTMLNodeList** list) {
     if (!list || !*list)
         return;
 
-    HTMLElementList* current = (*list)->head;
-    HTMLElementList* next = NULL;
-
-    /* destroy all elements and list nodes */
-    while (current) {
-        next = current->next;
-
-        if (current->element)
-            html2tex_element_destroy(current->element);
+    HTMLNodeList* lst = *list;
 
-        free(current);
-        current = next;
+    /* destroy the CSS owned by each element */
+    for (size_t i = 0; i < lst->node_count; i++) {
+        if (lst->items[i].css_props)
+            css_properties_destroy(lst->items[i].css_props);
     }
 
-    /* free the list structure */
-    free(*list);
+    /* single free for the element storage */
+    html2tex_free(lst->items);
+    html2tex_free(lst);
     *list = NULL;
 }
 
-HTMLElement** html_nodelist_dismantle(HTMLNodeList** list) {
+HTMLElement* html_nodelist_dismantle(HTMLNodeList** list) {
     /* clear the errors */
     html2tex_err_clear();
 
-    if (!list || !*list || !(*list)->head)
+    if (!list || !*list || (*list)->node_count == 0)
         return NULL;
 
-    /* allocate array for elements */
+    /* hand the element storage over to the caller */
     HTMLNodeList* lst = *list;
-    HTMLElement** array = (HTMLElement**)malloc(
-        lst->node_count * sizeof(HTMLElement*));
-
-    if (!array) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to allocate element array"
-            " for list dismantling.");
-        return NULL;
-    }
-
-    /* extract elements and free list nodes */
-    HTMLElementList* current = lst->head;
-    HTMLElementList* next = NULL;
-    size_t i = 0;
-
-    while (current) {
-        next = current->next;
-        array[i++] = current->element;
-        free(current);
-        current = next;
-    }
+    HTMLElement* array = lst->items;
 
     /* reset list to empty state */
-    lst->head = NULL;
-    lst->tail = &lst->head;
+    lst->items = NULL;
     lst->node_count = 0;
+    lst->capacity = 0;
     return array;
 }
 
-HTMLNodeList* html2tex_find_all(const HTMLNode* root, DOMTreeVisitor predicate,
-    const void* data, const CSSProperties* inherited_props) {
-    /* clear the previous errors */
-    html2tex_err_clear();
-
-    if (!root || !predicate) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "Invalid parameters in html2tex_find_all() function.");
-        return NULL;
-    }
+/* Computed style at one level of the cached ancestor path. */
+typedef struct {
+    const HTMLNode* node;
+    CSSProperties* style;
+    int owned;
+} StyleFrame;
+
+/* Memoized root-to-node style path shared by consecutive matches. */
+typedef struct {
+    StyleFrame* frames;
+    const HTMLNode** path;
+    size_t depth;
+    size_t capacity;
+    const CSSProperties* base;
+} StyleCache;
+
+static void style_cache_init(StyleCache* cache, const CSSProperties* base) {
+    cache->frames = NULL;
+    cache->path = NULL;
+    cache->depth = 0;
+    cache->capacity = 0;
+    cache->base = base;
+}
 
-    HTMLNodeList* result = html_nodelist_create();
-    if (!result) return NULL;
+static void style_cache_truncate(StyleCache* cache, size_t depth) {
+    while (cache->depth > depth) {
+        StyleFrame* frame = &cache->frames[--cache->depth];
 
-    Stack* node_stack = NULL;
-    Stack* css_stack = NULL;
+        if (frame->owned && frame->style)
+            css_properties_destroy(frame->style);
 
-    /* push root node with initial CSS properties */
-    if (!stack_push(&node_stack, (void*)root) ||
-        !stack_push(&css_stack, (void*)inherited_props)) {
-        html_nodelist_destroy(&result);
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to push initial nodes "
-            "onto stack.");
-        goto cleanup;
+        frame->style = NULL;
+        frame->owned = 0;
     }
+}
 
-    while (!stack_is_empty(node_stack)) {
-        CSSProperties* current_css = (CSSProperties*)stack_pop(&css_stack);
-        HTMLNode* current_node = (HTMLNode*)stack_pop(&node_stack);
-
-        if (!current_node) {
-            if (current_css && current_css != inherited_props)
-                css_properties_destroy(current_css);
-            continue;
-        }
-
-        /* merge CSS properties with inline styles */
-        CSSProperties* merged_css = current_css;
-        CSSProperties* inline_css = NULL;
-
-        if (current_node->tag) {
-            const char* style_attr = get_attribute(current_node->attributes, "style");
-            if (style_attr) {
-                inline_css = parse_css_style(style_attr);
-                if (inline_css) {
-                    merged_css = css_properties_merge(current_css, inline_css);
-                    css_properties_destroy(inline_css);
-
-                    if (html2tex_has_error()) {
-                        if (merged_css && merged_css != current_css)
-                            css_properties_destroy(merged_css);
-                        if (current_css && current_css != inherited_props)
-                            css_properties_destroy(current_css);
-                        goto cleanup;
-                    }
-                }
-            }
-        }
-
-        /* check predicate: if matches, add to result list */
-        if (predicate(current_node, data)) {
-            HTMLElement* found = (HTMLElement*)malloc(sizeof(HTMLElement));
-            if (!found) {
-                HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-                    "Failed to allocate HTMLElement.");
-                if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                    css_properties_destroy(merged_css);
-                if (current_css && current_css != inherited_props)
-                    css_properties_destroy(current_css);
-                goto cleanup;
-            }
-
-            found->node = current_node;
-            found->css_props = css_properties_copy(merged_css);
-            if (!found->css_props) {
-                free(found);
-                if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                    css_properties_destroy(merged_css);
-                if (current_css && current_css != inherited_props)
-                    css_properties_destroy(current_css);
-                goto cleanup;
-            }
-
-            /* efficient O(1) append to result list */
-            if (!html_nodelist_append(result, found)) {
-                html2tex_element_destroy(found);
-                if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                    css_properties_destroy(merged_css);
-                if (current_css && current_css != inherited_props)
-                    css_properties_destroy(current_css);
-                goto cleanup;
-            }
-        }
+static void style_cache_destroy(StyleCache* cache) {
+    style_cache_truncate(cache, 0);
+    html2tex_free(cache->frames);
+    html2tex_free(cache->path);
+    cache->frames = NULL;
+    cache->path = NULL;
+    cache->capacity = 0;
+}
 
-        /* push children in reverse order for DFS */
-        if (current_node->children) {
-            HTMLNode* last_child = current_node->children;
-            while (last_child->next) last_child = last_child->next;
-            HTMLNode* child = last_child;
-
-            while (child) {
-                CSSProperties* child_css = merged_css;
-
-                /* only copy CSS if it's different from inherited */
-                if (child_css && child_css != inherited_props) {
-                    child_css = css_properties_copy(merged_css);
-                    if (!child_css || html2tex_has_error()) {
-                        if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                            css_properties_destroy(merged_css);
-                        if (current_css && current_css != inherited_props)
-                            css_properties_destroy(current_css);
-                        goto cleanup;
-                    }
-                }
+static int style_cache_reserve(StyleCache* cache, size_t needed) {
+    if (needed <= cache->capacity) return 1;
+    size_t capacity = cache->capacity ? cache->capacity : 16;
+    while (capacity < needed) capacity *= 2;
 
-                /* push child onto stack */
-                if (!stack_push(&node_stack, (void*)child) ||
-                    !stack_push(&css_stack, (void*)child_css)) {
-                    if (child_css && child_css != merged_css && child_css != inherited_props)
-                        css_properties_destroy(child_css);
-                    if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                        css_properties_destroy(merged_css);
-                    if (current_css && current_css != inherited_props)
-                        css_properties_destroy(current_css);
-                    HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-                        "Failed to push child node onto stack.");
-                    goto cleanup;
-                }
+    StyleFrame* frames = (StyleFrame*)html2tex_realloc(cache->frames,
+        capacity * sizeof(StyleFrame));
 
-                /* move to previous sibling */
-                if (child == current_node->children)
-                    child = NULL;
-                else {
-                    HTMLNode* prev = current_node->children;
-                    while (prev->next != child) prev = prev->next;
-                    child = prev;
-                }
-            }
-        }
-
-        /* clean up current node's CSS (if haven't passed it to children) */
-        if (merged_css && merged_css != current_css && merged_css != inherited_props)
-            css_properties_destroy(merged_css);
-
-        if (current_css && current_css != inherited_props)
-            css_properties_destroy(current_css);
+    if (!frames) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to grow style cache to %zu frames.",
+            capacity);
+        return 0;
     }
 
-cleanup:
-    /* clean up stacks */
-    stack_cleanup(&node_stack);
-    stack_cleanup(&css_stack);
+    cache->frames = frames;
+    const HTMLNode** path = (const HTMLNode**)html2tex_realloc((void*)cache->path,
+        capacity * sizeof(const HTMLNode*));
 
-    /* if error occurred, clean up partial results */
-    if (html2tex_has_error() && result) {
-        html_nodelist_destroy(&result);
-        return NULL;
+    if (!path) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to grow style path to %zu nodes.",
+            capacity);
+        return 0;
     }
 
-    return result;
+    cache->path = path;
+    cache->capacity = capacity;
+    return 1;
 }
 
-HTMLElement* html2tex_search_tree(const HTMLNode* root, DOMTreeVisitor predicate, const void* data, const CSSProperties* inherited_props) {
-    html2tex_err_clear();
+/* Resolves the computed style of node, reusing the cached common ancestor path. */
+static CSSProperties* style_cache_resolve(StyleCache* cache,
+    const HTMLNode* node, const HTMLNode* root) {
+    size_t length = 0;
 
-    if (!root) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "HTML root node is NULL for tree search.");
-        return NULL;
+    for (const HTMLNode* p = node; p; p = p->parent) {
+        length++;
+        if (p == root) break;
     }
 
-    if (!predicate) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "Predicate function is NULL for"
-            " tree search.");
+    if (!style_cache_reserve(cache, length))
         return NULL;
-    }
-
-    Stack* node_stack = NULL;
-    Stack* css_stack = NULL;
-    HTMLElement* result = NULL;
 
-    /* push root node with initial CSS properties */
-    if (!stack_push(&node_stack, (void*)root) ||
-        !stack_push(&css_stack, (void*)inherited_props)) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to push initial nodes onto"
-            " stack for tree search.");
-        goto cleanup;
-    }
+    /* record the path top-down */
+    size_t i = length;
 
-    /* pop current context */
-    while (!stack_is_empty(node_stack)) {
-        CSSProperties* current_css = (CSSProperties*)stack_pop(&css_stack);
-        HTMLNode* current_node = (HTMLNode*)stack_pop(&node_stack);
+    for (const HTMLNode* p = node; i > 0; p = p->parent)
+        cache->path[--i] = p;
 
-        if (!current_node) {
-            /* only destroy if we allocated */
-            if (current_css && current_css != inherited_props)
-                css_properties_destroy(current_css);
+    /* keep the prefix shared with the previous match */
+    size_t common = 0;
 
-            continue;
-        }
+    while (common < cache->depth && common < length &&
+        cache->frames[common].node == cache->path[common])
+        common++;
 
-        /* merge CSS properties with inline styles if node has style attribute */
-        CSSProperties* merged_css = current_css;
-        CSSProperties* inline_css = NULL;
+    style_cache_truncate(cache, common);
 
-        if (current_node->tag) {
-            const char* style_attr = get_attribute(current_node->attributes, "style");
+    for (i = common; i < length; i++) {
+        const HTMLNode* current = cache->path[i];
+        CSSProperties* parent_style = i > 0 ? cache->frames[i - 1].style
+            : (CSSProperties*)cache->base;
 
-            if (style_attr) {
-                inline_css = parse_css_style(style_attr);
+        StyleFrame* frame = &cache->frames[i];
+        frame->node = current;
+        frame->style = parent_style;
+        frame->owned = 0;
 
-                if (inline_css) {
-                    merged_css = css_properties_merge(current_css, inline_css);
-                    css_properties_destroy(inline_css);
+        const char* style_attr = current->tag ?
+            get_hot_attribute(current, HTML_ATTR_STYLE) : NULL;
 
-                    if (html2tex_has_error()) {
-                        /* if merge failed, merged_css might be current_css or NULL */
-                        if (merged_css && merged_css != current_css)
-                            css_properties_destroy(merged_css);
+        if (style_attr) {
+            CSSProperties* inline_css = parse_css_style(style_attr);
 
-                        if (current_css && current_css != inherited_props)
-                            css_properties_destroy(current_css);
+            if (inline_css) {
+                CSSProperties* merged = css_properties_merge(parent_style, inline_css);
+                css_properties_destroy(inline_css);
 
-                        goto cleanup;
-                    }
+                if (!merged) {
+                    cache->depth = i;
+                    return NULL;
                 }
+
+                frame->style = merged;
+                frame->owned = 1;
             }
+            else
+                /* malformed inline styles are ignored */
+                html2tex_err_clear();
         }
 
-        /* check current node with predicate */
-        if (predicate(current_node, data)) {
-            result = (HTMLElement*)malloc(sizeof(HTMLElement));
-
-            if (!result) {
-                HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-                    "Failed to allocate HTMLElement structure.");
+        cache->depth = i + 1;
+    }
 
-                if (merged_css && merged_css != current_css &&
-                    merged_css != inherited_props)
-                    css_properties_destroy(merged_css);
+    CSSProperties* computed = cache->frames[length - 1].style;
+    return computed ? css_properties_copy(computed)
+        : css_properties_create();
+}
 
-                if (current_css && current_css != inherited_props)
-                    css_properties_destroy(current_css);
+/* Returns the next node in document order within the subtree of root. */
+static const HTMLNode* next_preorder(const HTMLNode* node, const HTMLNode* root) {
+    if (node->children) return node->children;
 
-                goto cleanup;
-            }
+    while (node != root) {
+        if (node->next) return node->next;
+        node = node->parent;
 
-            result->node = current_node;
+        /* top-level nodes of a parsed document have no parent link */
+        if (!node) break;
+    }
 
-            /* copy the CSS properties for the result */
-            if (merged_css) result->css_props = css_properties_copy(merged_css);
-            else result->css_props = css_properties_create();
+    return NULL;
+}
 
-            if (!result->css_props || html2tex_has_error()) {
-                if (result->css_props)
-                    css_properties_destroy(result->css_props);
+static HTMLElement* query_element_create(StyleCache* cache, const HTMLNode* node,
+    const HTMLNode* root, HTMLQueryMode mode) {
+    HTMLElement* element = (HTMLElement*)html2tex_malloc(sizeof(HTMLElement));
 
-                free(result);
-                result = NULL;
+    if (!element) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate HTMLElement.");
+        return NULL;
+    }
 
-                if (merged_css && merged_css != current_css &&
-                    merged_css != inherited_props)
-                    css_properties_destroy(merged_css);
+    element->node = (HTMLNode*)node;
+    element->css_props = NULL;
 
-                if (current_css && current_css != inherited_props)
-                    css_properties_destroy(current_css);
+    if (mode == HTML2TEX_QUERY_STYLES) {
+        element->css_props = style_cache_resolve(cache, node, root);
 
-                goto cleanup;
-            }
+        if (!element->css_props) {
+            html2tex_free(element);
+            return NULL;
+        }
+    }
 
-            /* clean up current node's CSS props */
-            if (merged_css && merged_css != current_css &&
-                merged_css != inherited_props)
-                css_properties_destroy(merged_css);
+    return element;
+}
 
-            if (current_css && current_css != inherited_props)
-                css_properties_destroy(current_css);
+CSSProperties* html2tex_compute_style(const HTMLNode* node, const HTMLNode* root,
+    const CSSProperties* inherited_props) {
+    html2tex_err_clear();
 
-            break;
-        }
+    if (!node) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "HTML node is NULL for style computation.");
+        return NULL;
+    }
 
-        /* push children in reverse order */
-        if (current_node->children) {
-            HTMLNode* last_child = current_node->children;
-            while (last_child->next) last_child = last_child->next;
-            HTMLNode* child = last_child;
+    StyleCache cache;
+    style_cache_init(&cache, inherited_props);
 
-            while (child) {
-                CSSProperties* child_css = merged_css;
+    CSSProperties* computed = style_cache_resolve(&cache, node, root);
+    style_cache_destroy(&cache);
+    return computed;
+}
 
-                /* only copy CSS if it's different from inherited and it need a unique copy */
-                if (child_css && child_css != inherited_props) {
-                    child_css = css_properties_copy(merged_css);
-                    if (!child_css || html2tex_has_error()) {
-                        if (merged_css && merged_css != current_css
-                            && merged_css != inherited_props)
-                            css_properties_destroy(merged_css);
+HTMLNodeList* html2tex_find_all_ex(const HTMLNode* root, DOMTreeVisitor predicate,
+    const void* data, const CSSProperties* inherited_props, HTMLQueryMode mode) {
+    /* clear the previous errors */
+    html2tex_err_clear();
 
-                        if (current_css && current_css != inherited_props)
-                            css_properties_destroy(current_css);
+    if (!root || !predicate) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Invalid parameters in html2tex_find_all() function.");
+        return NULL;
+    }
 
-                        goto cleanup;
-                    }
-                }
+    HTMLNodeList* result = html_nodelist_create();
+    if (!result) return NULL;
 
-                /* push child onto stack */
-                if (!stack_push(&node_stack, (void*)child) ||
-                    !stack_push(&css_stack, (void*)child_css)) {
-                    if (child_css && child_css != merged_css && child_css != inherited_props)
-                        css_properties_destroy(child_css);
+    StyleCache cache;
+    style_cache_init(&cache, inherited_props);
+    int failed = 0;
 
-                    if (merged_css && merged_css != current_css && merged_css != inherited_props)
-                        css_properties_destroy(merged_css);
+    for (const HTMLNode* current = root; current;
+        current = next_preorder(current, root)) {
+        if (!predicate(current, data))
+            continue;
 
-                    if (current_css && current_css != inherited_props)
-                        css_properties_destroy(current_css);
+        /* styles are computed only for matched nodes */
+        CSSProperties* css_props = NULL;
 
-                    HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-                        "Failed to push child node onto stack.");
-                    goto cleanup;
-                }
+        if (mode == HTML2TEX_QUERY_STYLES) {
+            css_props = style_cache_resolve(&cache, current, root);
 
-                /* move to previous sibling */
-                if (child == current_node->children)
-                    child = NULL;
-                else {
-                    HTMLNode* prev = current_node->children;
-                    while (prev->next != child) prev = prev->next;
-                    child = prev;
-                }
+            if (!css_props) {
+                failed = 1;
+                break;
             }
         }
 
-        /* clean up current node's CSS if we haven't passed it to children */
-        if (merged_css && merged_css != current_css && merged_css != inherited_props)
-            css_properties_destroy(merged_css);
+        /* amortized O(1) append to result list */
+        if (!nodelist_push(result, (HTMLNode*)current, css_props)) {
+            if (css_props) css_properties_destroy(css_props);
+            failed = 1;
+            break;
+        }
+    }
+
+    style_cache_destroy(&cache);
 
-        if (current_css && current_css != inherited_props)
-            css_properties_destroy(current_css);
+    /* if error occurred, clean up partial results */
+    if (failed) {
+        html_nodelist_destroy(&result);
+        return NULL;
     }
 
-cleanup:
-    /* clean up any remaining CSS properties on the stack */
-    while (!stack_is_empty(css_stack)) {
-        CSSProperties* css = (CSSProperties*)stack_pop(&css_stack);
-        if (css && css != inherited_props)
-            css_properties_destroy(css);
+    return result;
+}
+
+HTMLNodeList* html2tex_find_all(const HTMLNode* root, DOMTreeVisitor predicate,
+    const void* data, const CSSProperties* inherited_props) {
+    return html2tex_find_all_ex(root, predicate, data,
+        inherited_props, HTML2TEX_QUERY_STYLES);
+}
+
+HTMLElement* html2tex_search_tree_ex(const HTMLNode* root, DOMTreeVisitor predicate,
+    const void* data, const CSSProperties* inherited_props, HTMLQueryMode mode) {
+    html2tex_err_clear();
+
+    if (!root) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "HTML root node is NULL for tree search.");
+        return NULL;
     }
 
-    /* clean up any remaining nodes on the stack */
-    while (!stack_is_empty(node_stack))
-        stack_pop(&node_stack);
+    if (!predicate) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Predicate function is NULL for"
+            " tree search.");
+        return NULL;
+    }
+
+    for (const HTMLNode* current = root; current;
+        current = next_preorder(current, root)) {
+        if (!predicate(current, data))
+            continue;
 
-    /* clean up stacks */
-    stack_cleanup(&node_stack);
-    stack_cleanup(&css_stack);
+        StyleCache cache;
+        style_cache_init(&cache, inherited_props);
 
-    /* if error occurred but result was allocated, free it */
-    if (html2tex_has_error() && result) {
-        html2tex_element_destroy(result);
-        result = NULL;
+        HTMLElement* result = query_element_create(&cache,
+            current, root, mode);
+
+        style_cache_destroy(&cache);
+        return result;
     }
 
-    return result;
+    return NULL;
+}
+
+HTMLElement* html2tex_search_tree(const HTMLNode* root, DOMTreeVisitor predicate,
+    const void* data, const CSSProperties* inherited_props) {
+    return html2tex_search_tree_ex(root, predicate, data,
+        inherited_props, HTML2TEX_QUERY_STYLES);
 }
 
 void html2tex_element_destroy(HTMLElement* elem) {
     if (elem) {
         if (elem->css_props)
             css_properties_destroy(elem->css_props);
-        free(elem);
+        html2tex_free(elem);
     }
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "html2tex_errors.h"
+#include "html2tex_alloc.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -114,7 +115,7 @@ void html2tex_err_clear(void) {
 }
 
 void* html2tex_err_save(void) {
-    struct HTML2TeXErrorSave* save = malloc(sizeof(struct HTML2TeXErrorSave));
+    struct HTML2TeXErrorSave* save = html2tex_malloc(sizeof(struct HTML2TeXErrorSave));
     if (!save) return NULL;
 
     save->ctx = tls_err;
@@ -129,7 +130,7 @@ void html2tex_err_restore(void* saved) {
 
     struct HTML2TeXErrorSave* save = (struct HTML2TeXErrorSave*)saved;
     tls_err = save->ctx;
-    free(save);
+    html2tex_free(save);
 }
 
 int html2tex_err_syserr(void) {
@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <limits.h>
 
 void append_string(LaTeXConverter* converter, const char* str) {
     /* clear previous errors */
@@ -198,14 +199,14 @@ void apply_color(LaTeXConverter* converter, const char* color_value, int is_back
 
     if (len > 0 && (size_t)len < sizeof(buffer)) {
         if (string_buffer_append(converter->buffer, buffer, (size_t)len) != 0) {
-            free(hex_color);
+            html2tex_free(hex_color);
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Failed to apply color.");
             return;
         }
     }
 
-    free(hex_color);
+    html2tex_free(hex_color);
 }
 
 void begin_table(LaTeXConverter* converter, int columns) {
@@ -231,7 +232,7 @@ void begin_table(LaTeXConverter* converter, int columns) {
 
     /* free existing caption if any */
     if (converter->state.table_caption) {
-        free(converter->state.table_caption);
+        html2tex_free(converter->state.table_caption);
         converter->state.table_caption = NULL;
     }
 
@@ -315,7 +316,7 @@ void end_table(LaTeXConverter* converter, const char* table_label) {
 cleanup:
     /* clean up resources */
     if (converter->state.table_caption) {
-        free(converter->state.table_caption);
+        html2tex_free(converter->state.table_caption);
         converter->state.table_caption = NULL;
     }
 
@@ -448,7 +449,7 @@ int count_table_columns(const HTMLNode* node) {
                             int colspan = 1;
 
                             /* check for colspan attribute */
-                            const char* colspan_attr = get_attribute(cell->attributes, "colspan");
+                            const char* colspan_attr = get_hot_attribute(cell, HTML_ATTR_COLSPAN);
 
                             /* robust conversion with error checking */
                             if (colspan_attr && colspan_attr[0]) {
@@ -527,7 +528,7 @@ char* extract_caption_text(const HTMLNode* node) {
     /* optimized dynamic string buffer */
     size_t capacity = 256;
 
-    char* buffer = (char*)malloc(capacity);
+    char* buffer = (char*)html2tex_malloc(capacity);
     if (!buffer) return NULL;
 
     size_t length = 0;
@@ -538,7 +539,7 @@ char* extract_caption_text(const HTMLNode* node) {
 
     /* start with root node */
     if (!stack_push(&stack, (void*)node)) {
-        free(buffer);
+        html2tex_free(buffer);
         return NULL;
     }
 
@@ -562,15 +563,15 @@ char* extract_caption_text(const HTMLNode* node) {
                 /* overflow protection */
                 if (new_capacity < capacity || new_capacity > SIZE_MAX / 2) {
                     stack_cleanup(&stack);
-                    free(buffer);
+                    html2tex_free(buffer);
                     return NULL;
                 }
 
-                char* new_buffer = (char*)realloc(buffer, new_capacity);
+                char* new_buffer = (char*)html2tex_realloc(buffer, new_capacity);
 
                 if (!new_buffer) {
                     stack_cleanup(&stack);
-                    free(buffer);
+                    html2tex_free(buffer);
                     return NULL;
                 }
 
@@ -599,7 +600,7 @@ char* extract_caption_text(const HTMLNode* node) {
             if (child_count == 1) {
                 if (!stack_push(&stack, (void*)current->children)) {
                     stack_cleanup(&stack);
-                    free(buffer);
+                    html2tex_free(buffer);
                     return NULL;
                 }
             }
@@ -613,7 +614,7 @@ char* extract_caption_text(const HTMLNode* node) {
                     if (!stack_push(&temp_stack, (void*)child)) {
                         stack_cleanup(&temp_stack);
                         stack_cleanup(&stack);
-                        free(buffer);
+                        html2tex_free(buffer);
                         return NULL;
                     }
 
@@ -628,7 +629,7 @@ char* extract_caption_text(const HTMLNode* node) {
                         stack_cleanup(&temp_stack);
                         stack_cleanup(&stack);
 
-                        free(buffer);
+                        html2tex_free(buffer);
                         return NULL;
                     }
                 }
@@ -643,12 +644,12 @@ char* extract_caption_text(const HTMLNode* node) {
 
     /* return NULL for empty captions */
     if (length == 0) {
-        free(buffer);
+        html2tex_free(buffer);
         return NULL;
     }
 
     /* trim to exact size */
-    char* result = (char*)realloc(buffer, length + 1);
+    char* result = (char*)html2tex_realloc(buffer, length + 1);
     return result ? result : buffer;
 }
 
@@ -668,7 +669,7 @@ void process_table_image(LaTeXConverter* converter, const HTMLNode* img_node) {
         return;
     }
 
-    const char* src = get_attribute(img_node->attributes, "src");
+    const char* src = get_hot_attribute(img_node, HTML_ATTR_SRC);
     if (!src || src[0] == '\0') return;
 
     char* image_path = NULL;
@@ -676,7 +677,7 @@ void process_table_image(LaTeXConverter* converter, const HTMLNode* img_node) {
 
     if (converter->download_images && converter->image_output_dir) {
         converter->image_counter++;
-        image_path = download_image_src(
+        image_path = prefetch_image_src(converter->prefetch,
             &converter->store, src, 
             converter->image_output_dir,
             converter->image_counter);
@@ -689,7 +690,7 @@ void process_table_image(LaTeXConverter* converter, const HTMLNode* img_node) {
     }
 
     if (!image_path) {
-        image_path = strdup(src);
+        image_path = html2tex_strdup(src);
         if (!image_path) return;
     }
 
@@ -697,33 +698,31 @@ void process_table_image(LaTeXConverter* converter, const HTMLNode* img_node) {
     int width_pt = 0, height_pt = 0;
     int has_background = 0;
     char* bg_hex_color = NULL;
-    const char* style_attr = get_attribute(img_node->attributes, "style");
-
-    if (style_attr) {
-        img_css = parse_css_style(style_attr);
-        if (img_css) {
-            const char* width = css_properties_get(img_css, "width");
-            const char* height = css_properties_get(img_css, "height");
-            const char* bg_color = css_properties_get(img_css, "background-color");
-
-            if (width) width_pt = css_length_to_pt(width);
-            if (height) height_pt = css_length_to_pt(height);
-
-            if (bg_color) {
-                bg_hex_color = css_color_to_hex(bg_color);
-                if (bg_hex_color && strcmp(bg_hex_color, "FFFFFF") != 0)
-                    has_background = 1;
-            }
+    img_css = css_stylesheet_cascade(converter->stylesheet,
+        img_node, converter->ancestors, converter->match_context);
+
+    if (img_css) {
+        const char* width = css_properties_get(img_css, "width");
+        const char* height = css_properties_get(img_css, "height");
+        const char* bg_color = css_properties_get(img_css, "background-color");
+
+        if (width) width_pt = css_length_to_pt(width);
+        if (height) height_pt = css_length_to_pt(height);
+
+        if (bg_color) {
+            bg_hex_color = css_color_to_hex(bg_color);
+            if (bg_hex_color && strcmp(bg_hex_color, "FFFFFF") != 0)
+                has_background = 1;
         }
     }
 
     if (width_pt == 0) {
-        const char* width_attr = get_attribute(img_node->attributes, "width");
+        const char* width_attr = get_hot_attribute(img_node, HTML_ATTR_WIDTH);
         if (width_attr) width_pt = css_length_to_pt(width_attr);
     }
 
     if (height_pt == 0) {
-        const char* height_attr = get_attribute(img_node->attributes, "height");
+        const char* height_attr = get_hot_attribute(img_node, HTML_ATTR_HEIGHT);
         if (height_attr) height_pt = css_length_to_pt(height_attr);
     }
 
@@ -767,8 +766,8 @@ void process_table_image(LaTeXConverter* converter, const HTMLNode* img_node) {
     if (has_background)
         append_string(converter, "}");
 
-    if (image_path) free(image_path);
-    if (bg_hex_color) free(bg_hex_color);
+    if (image_path) html2tex_free(image_path);
+    if (bg_hex_color) html2tex_free(bg_hex_color);
     if (img_css) css_properties_destroy(img_css);
 }
 
@@ -809,7 +808,7 @@ void append_figure_caption(LaTeXConverter* converter, const HTMLNode* table_node
     if (caption) caption_text = extract_caption_text(caption);
 
     /* build the label */
-    const char* fig_id = get_attribute(table_node->attributes, "id");
+    const char* fig_id = get_hot_attribute(table_node, HTML_ATTR_ID);
     char figure_label[64];
 
     /* safe copy with bounds checking */
@@ -831,13 +830,13 @@ void append_figure_caption(LaTeXConverter* converter, const HTMLNode* table_node
 
     if (html2tex_has_error()) {
         if (caption_text)
-            free(caption_text);
+            html2tex_free(caption_text);
         return;
     }
 
     if (caption_text) {
         escape_latex(converter, caption_text);
-        free(caption_text);
+        html2tex_free(caption_text);
 
         if (html2tex_has_error())
             return;
@@ -884,6 +883,21 @@ void html2tex_convert_document(LaTeXConverter* converter, const HTMLNode* node)
     Stack* processed_stack = NULL;
     CSSProperties* inherit_props = NULL;
 
+    /* collect the document stylesheet once for the whole traversal */
+    CSSStylesheet* stylesheet = css_stylesheet_from_document(node);
+    if (!stylesheet && html2tex_has_error()) return;
+    converter->stylesheet = stylesheet;
+
+    /* open ancestors of the node being converted */
+    AncestorFilter ancestors;
+    ancestor_filter_reset(&ancestors);
+    converter->ancestors = &ancestors;
+
+    /* sibling positions for structural selectors, the root lists the top-level nodes */
+    CSSMatchContext match_context;
+    css_match_context_init(&match_context, node);
+    converter->match_context = &match_context;
+
     /* push root node with initial CSS properties */
     if (!stack_push(&node_stack, (void*)node) ||
         !stack_push(&css_stack, (void*)inherit_props) ||
@@ -902,6 +916,10 @@ void html2tex_convert_document(LaTeXConverter* converter, const HTMLNode* node)
             continue;
         }
 
+        /* the closing pass sees the node's ancestors, not the node itself */
+        if (already_processed)
+            ancestor_filter_pop(&ancestors, current_node);
+
         /* skip excluded elements */
         if (should_exclude_tag(current_node->tag))
             continue;
@@ -910,28 +928,26 @@ void html2tex_convert_document(LaTeXConverter* converter, const HTMLNode* node)
         if (should_skip_nested_table(current_node) > 0)
             continue;
 
-        /* merge CSS properties */
+        /* merge CSS properties, the closing pass gets the opening pass result */
         CSSProperties* merged_css = current_css;
-        CSSProperties* inline_css = NULL;
+        CSSProperties* declared_css = NULL;
 
-        if (current_node->tag) {
-            const char* style_attr = get_attribute(current_node->attributes, "style");
+        if (current_node->tag && !already_processed) {
+            /* stylesheet rules and the style attribute, in cascade order */
+            declared_css = css_stylesheet_cascade(converter->stylesheet,
+                current_node, converter->ancestors, converter->match_context);
 
-            if (style_attr) {
-                inline_css = parse_css_style(style_attr);
+            if (declared_css) {
+                merged_css = css_properties_merge(current_css, declared_css);
+                css_properties_destroy(declared_css);
 
-                if (inline_css) {
-                    merged_css = css_properties_merge(current_css, inline_css);
-                    css_properties_destroy(inline_css);
-
-                    if (html2tex_has_error()) {
-                        if (merged_css && merged_css != current_css)
-                            css_properties_destroy(merged_css);
+                if (html2tex_has_error()) {
+                    if (merged_css && merged_css != current_css)
+                        css_properties_destroy(merged_css);
 
-                        if (current_css && current_css != inherit_props)
-                            css_properties_destroy(current_css);
-                        goto cleanup;
-                    }
+                    if (current_css && current_css != inherit_props)
+                        css_properties_destroy(current_css);
+                    goto cleanup;
                 }
             }
         }
@@ -968,6 +984,7 @@ void html2tex_convert_document(LaTeXConverter* converter, const HTMLNode* node)
 
                 /* merged_css will be cleaned up in second pass */
                 merged_css = NULL;
+                ancestor_filter_push(&ancestors, current_node);
             }
         }
         else {
@@ -1041,4 +1058,10 @@ cleanup:
     stack_cleanup(&node_stack);
     stack_cleanup(&css_stack);
     stack_cleanup(&processed_stack);
+
+    converter->ancestors = NULL;
+    converter->match_context = NULL;
+    css_match_context_cleanup(&match_context);
+    converter->stylesheet = NULL;
+    if (stylesheet) css_stylesheet_destroy(stylesheet);
 }
\ No newline at end of file
@@ -0,0 +1,833 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "html2tex.h"
+#include "image_fetcher.h"
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+#endif
+
+/* largest chunk handed to one copy_file_range() or sendfile() call */
+#define FETCH_COPY_CHUNK ((size_t)1 << 30)
+
+struct ImageFetcher {
+    const ImageFetcherVTable* vtable;
+    void* context;
+};
+
+ImageFetcher* image_fetcher_create(const ImageFetcherVTable* vtable, void* context) {
+    html2tex_err_clear();
+
+    if (!vtable || !vtable->fetch) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image fetcher needs a fetch operation.");
+        return NULL;
+    }
+
+    ImageFetcher* fetcher = (ImageFetcher*)html2tex_malloc(sizeof(ImageFetcher));
+
+    if (!fetcher) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the image fetcher.");
+        return NULL;
+    }
+
+    fetcher->vtable = vtable;
+    fetcher->context = context;
+    return fetcher;
+}
+
+int image_fetcher_accepts(const ImageFetcher* fetcher, const char* src) {
+    if (!fetcher || !src) return 0;
+    if (!fetcher->vtable->accepts) return 1;
+
+    return fetcher->vtable->accepts(fetcher->context, src) != 0;
+}
+
+/* validates a request and checks that the fetcher serves it */
+static int check_request(const ImageFetcher* fetcher, const char* src, const char* path) {
+    if (!fetcher || !src || !path) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image fetcher, source or destination is NULL.");
+        return 0;
+    }
+
+    if (!image_fetcher_accepts(fetcher, src)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+            "No image fetcher serves '%s'.", src);
+        return 0;
+    }
+
+    return 1;
+}
+
+int image_fetcher_fetch(ImageFetcher* fetcher, const char* src, const char* path) {
+    html2tex_err_clear();
+    if (!check_request(fetcher, src, path)) return 0;
+
+    return fetcher->vtable->fetch(fetcher->context, src, path);
+}
+
+int image_fetcher_submit(ImageFetcher* fetcher, const char* src, const char* path,
+    ImageFetchCallback callback, void* user_data) {
+    html2tex_err_clear();
+    if (!check_request(fetcher, src, path)) return 0;
+
+    if (fetcher->vtable->submit)
+        return fetcher->vtable->submit(fetcher->context,
+            src, path, callback, user_data);
+
+    /* a blocking backend completes before submit returns */
+    const int success = fetcher->vtable->fetch(fetcher->context, src, path);
+
+    if (callback)
+        callback(src, path, success ? NULL : html2tex_get_error_message(), user_data);
+
+    return 1;
+}
+
+size_t image_fetcher_cancel(ImageFetcher* fetcher) {
+    if (!fetcher || !fetcher->vtable->cancel) return 0;
+    return fetcher->vtable->cancel(fetcher->context);
+}
+
+void image_fetcher_destroy(ImageFetcher* fetcher) {
+    if (!fetcher) return;
+
+    if (fetcher->vtable->destroy)
+        fetcher->vtable->destroy(fetcher->context);
+
+    html2tex_free(fetcher);
+}
+
+/* 1 when src starts with a URL scheme, a Windows drive letter is none */
+static int has_url_scheme(const char* src) {
+    if (!isalpha((unsigned char)src[0])) return 0;
+    const char* p = src + 1;
+
+    while (isalnum((unsigned char)*p) || *p == '+' || *p == '-' || *p == '.')
+        p++;
+
+    return *p == ':' && p - src > 1;
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* percent-decodes the URL path in [begin, end), stopping at a query or fragment */
+static char* decode_url_path(const char* begin, const char* end) {
+    const char* stop = begin;
+
+    while (stop < end && *stop != '?' && *stop != '#')
+        stop++;
+
+    char* decoded = (char*)html2tex_malloc((size_t)(stop - begin) + 1);
+
+    if (!decoded) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate a decoded image path.");
+        return NULL;
+    }
+
+    char* out = decoded;
+
+    for (const char* p = begin; p < stop; p++) {
+        if (*p == '%' && stop - p > 2) {
+            const int high = hex_value(p[1]);
+            const int low = hex_value(p[2]);
+
+            /* an encoded NUL would cut the path short */
+            if (high >= 0 && low >= 0 && (high | low)) {
+                *out++ = (char)(high << 4 | low);
+                p += 2;
+                continue;
+            }
+        }
+
+        *out++ = *p;
+    }
+
+    *out = '\0';
+    return decoded;
+}
+
+/* 1 when a path climbs out of its directory through a ".." segment */
+static int climbs_out(const char* path) {
+    const char* segment = path;
+
+    for (const char* p = path; ; p++) {
+        if (*p == '/' || *p == '\\' || *p == '\0') {
+            if (p - segment == 2 && segment[0] == '.' && segment[1] == '.')
+                return 1;
+
+            if (*p == '\0') return 0;
+            segment = p + 1;
+        }
+    }
+}
+
+/* joins directory and name with a single separator */
+static char* join_path(const char* directory, const char* name) {
+    while (*name == '/' || *name == '\\')
+        name++;
+
+    size_t dir_len = strlen(directory);
+
+    while (dir_len && (directory[dir_len - 1] == '/' || directory[dir_len - 1] == '\\'))
+        dir_len--;
+
+    const size_t name_len = strlen(name);
+    char* joined = (char*)html2tex_malloc(dir_len + name_len + 2);
+
+    if (!joined) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate a joined image path.");
+        return NULL;
+    }
+
+    memcpy(joined, directory, dir_len);
+    joined[dir_len] = '/';
+    memcpy(joined + dir_len + 1, name, name_len + 1);
+    return joined;
+}
+
+#ifndef _WIN32
+/* moves bytes between descriptors, in the kernel when both ends allow it */
+static int copy_descriptor(int in, int out, unsigned long long size) {
+    unsigned long long copied = 0;
+
+#if defined(__linux__)
+    /* copy_file_range() may share extents on filesystems that reflink */
+    while (copied < size) {
+        const size_t chunk = size - copied > FETCH_COPY_CHUNK
+            ? FETCH_COPY_CHUNK : (size_t)(size - copied);
+        const ssize_t moved = copy_file_range(in, NULL, out, NULL, chunk, 0);
+
+        if (moved <= 0) break;
+        copied += (unsigned long long)moved;
+    }
+
+    /* sendfile() covers kernels and filesystems copy_file_range() refuses */
+    while (copied < size) {
+        const size_t chunk = size - copied > FETCH_COPY_CHUNK
+            ? FETCH_COPY_CHUNK : (size_t)(size - copied);
+        const ssize_t moved = sendfile(out, in, NULL, chunk);
+
+        if (moved <= 0) break;
+        copied += (unsigned long long)moved;
+    }
+#endif
+
+    /* both descriptors stand at copied, a plain loop finishes the file */
+    char buffer[65536];
+    ssize_t read_count;
+
+    while ((read_count = read(in, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t written = 0; written < read_count; ) {
+            const ssize_t moved = write(out, buffer + written, (size_t)(read_count - written));
+
+            if (moved < 0) {
+                if (errno == EINTR) continue;
+                return 0;
+            }
+
+            written += moved;
+        }
+    }
+
+    return read_count == 0;
+}
+#endif
+
+/* copies a local file into path, path never keeps a partial copy */
+static int copy_local_file(const char* source, const char* path) {
+#ifdef _WIN32
+    if (!CopyFileA(source, path, FALSE)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to copy image '%s' to '%s' (error %lu).",
+            source, path, (unsigned long)GetLastError());
+        DeleteFileA(path);
+        return 0;
+    }
+
+    return 1;
+#else
+    const int in = open(source, O_RDONLY);
+
+    if (in < 0) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open image '%s': %s.", source, strerror(errno));
+        return 0;
+    }
+
+    struct stat info;
+
+    if (fstat(in, &info) != 0 || !S_ISREG(info.st_mode)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Image '%s' is not a regular file.", source);
+        close(in);
+        return 0;
+    }
+
+    const int out = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (out < 0) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open file '%s' for writing: %s.", path, strerror(errno));
+        close(in);
+        return 0;
+    }
+
+    int success = copy_descriptor(in, out, (unsigned long long)info.st_size);
+
+    if (!success)
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to copy image '%s' to '%s': %s.", source, path, strerror(errno));
+
+    close(in);
+
+    if (close(out) != 0 && success) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to close file '%s' after write: %s.", path, strerror(errno));
+        success = 0;
+    }
+
+    if (!success) remove(path);
+    return success;
+#endif
+}
+
+/* local files, context is the base directory or NULL */
+static int file_accepts(void* context, const char* src) {
+    (void)context;
+    if (!src[0]) return 0;
+
+    return !has_url_scheme(src) || strncasecmp(src, "file:", 5) == 0;
+}
+
+/* 1 when path is absolute on this platform */
+static int is_absolute_path(const char* path) {
+    if (path[0] == '/' || path[0] == '\\') return 1;
+#ifdef _WIN32
+    if (isalpha((unsigned char)path[0]) && path[1] == ':') return 1;
+#endif
+    return 0;
+}
+
+static char* resolve_file_source(const char* base_dir, const char* src) {
+    char* local;
+
+    if (strncasecmp(src, "file:", 5) == 0) {
+        const char* path = src + 5;
+
+        /* file://host/path names a path on host, only the local one is reachable */
+        if (strncmp(path, "//", 2) == 0) {
+            path += 2;
+
+            if (strncasecmp(path, "localhost", 9) == 0)
+                path += 9;
+
+            if (*path != '/') {
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+                    "File URL '%s' names a remote host.", src);
+                return NULL;
+            }
+        }
+
+#ifdef _WIN32
+        /* file:///C:/dir keeps the drive letter first */
+        if (path[0] == '/' && isalpha((unsigned char)path[1]) && path[2] == ':')
+            path++;
+#endif
+        local = decode_url_path(path, path + strlen(path));
+    }
+    else
+        local = html2tex_strdup(src);
+
+    if (!local || !base_dir || is_absolute_path(local))
+        return local;
+
+    char* joined = join_path(base_dir, local);
+    html2tex_free(local);
+    return joined;
+}
+
+static int file_fetch(void* context, const char* src, const char* path) {
+    char* source = resolve_file_source((const char*)context, src);
+    if (!source) return 0;
+
+    const int success = copy_local_file(source, path);
+    html2tex_free(source);
+    return success;
+}
+
+static void file_destroy(void* context) {
+    html2tex_free(context);
+}
+
+static const ImageFetcherVTable file_vtable = {
+    file_accepts, file_fetch, NULL, NULL, file_destroy
+};
+
+ImageFetcher* image_fetcher_file_create(const char* base_dir) {
+    html2tex_err_clear();
+    char* context = NULL;
+
+    if (base_dir && base_dir[0]) {
+        context = html2tex_strdup(base_dir);
+
+        if (!context) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to allocate the image base directory.");
+            return NULL;
+        }
+    }
+
+    ImageFetcher* fetcher = image_fetcher_create(&file_vtable, context);
+    if (!fetcher) html2tex_free(context);
+
+    return fetcher;
+}
+
+/* URL prefixes served from local directories */
+typedef struct {
+    char* prefix;
+    size_t prefix_len;
+    char* directory;
+} MirrorEntry;
+
+typedef struct {
+    MirrorEntry* entries;
+    size_t count;
+    size_t capacity;
+} ImageMirror;
+
+/* longest prefix of src, NULL when none matches */
+static const MirrorEntry* find_mirror(const ImageMirror* mirror, const char* src) {
+    const MirrorEntry* best = NULL;
+
+    for (size_t i = 0; i < mirror->count; i++) {
+        const MirrorEntry* entry = &mirror->entries[i];
+
+        if ((!best || entry->prefix_len > best->prefix_len)
+            && strncmp(src, entry->prefix, entry->prefix_len) == 0)
+            best = entry;
+    }
+
+    return best;
+}
+
+static int mirror_accepts(void* context, const char* src) {
+    return find_mirror((const ImageMirror*)context, src) != NULL;
+}
+
+static int mirror_fetch(void* context, const char* src, const char* path) {
+    const MirrorEntry* entry = find_mirror((const ImageMirror*)context, src);
+    const char* rest = src + entry->prefix_len;
+    char* relative = decode_url_path(rest, rest + strlen(rest));
+
+    if (!relative) return 0;
+
+    if (!relative[0] || climbs_out(relative)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+            "URL '%s' does not name a file below its mirror.", src);
+        html2tex_free(relative);
+        return 0;
+    }
+
+    char* source = join_path(entry->directory, relative);
+    html2tex_free(relative);
+
+    if (!source) return 0;
+
+    const int success = copy_local_file(source, path);
+    html2tex_free(source);
+    return success;
+}
+
+static void mirror_destroy(void* context) {
+    ImageMirror* mirror = (ImageMirror*)context;
+
+    for (size_t i = 0; i < mirror->count; i++) {
+        html2tex_free(mirror->entries[i].prefix);
+        html2tex_free(mirror->entries[i].directory);
+    }
+
+    html2tex_free(mirror->entries);
+    html2tex_free(mirror);
+}
+
+static const ImageFetcherVTable mirror_vtable = {
+    mirror_accepts, mirror_fetch, NULL, NULL, mirror_destroy
+};
+
+ImageFetcher* image_fetcher_mirror_create(void) {
+    html2tex_err_clear();
+    ImageMirror* mirror = (ImageMirror*)html2tex_calloc(1, sizeof(ImageMirror));
+
+    if (!mirror) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the image mirror.");
+        return NULL;
+    }
+
+    ImageFetcher* fetcher = image_fetcher_create(&mirror_vtable, mirror);
+    if (!fetcher) html2tex_free(mirror);
+
+    return fetcher;
+}
+
+int image_fetcher_mirror_add(ImageFetcher* fetcher, const char* prefix, const char* directory) {
+    html2tex_err_clear();
+
+    if (!fetcher || !prefix || !prefix[0] || !directory) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image mirror, URL prefix or directory is NULL.");
+        return 0;
+    }
+
+    if (fetcher->vtable != &mirror_vtable) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetcher is not a mirror.");
+        return 0;
+    }
+
+    ImageMirror* mirror = (ImageMirror*)fetcher->context;
+
+    if (mirror->count == mirror->capacity) {
+        const size_t capacity = mirror->capacity ? mirror->capacity * 2 : 4;
+        MirrorEntry* entries = (MirrorEntry*)html2tex_realloc(mirror->entries,
+            capacity * sizeof(MirrorEntry));
+
+        if (!entries) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to grow the image mirror.");
+            return 0;
+        }
+
+        mirror->entries = entries;
+        mirror->capacity = capacity;
+    }
+
+    MirrorEntry* entry = &mirror->entries[mirror->count];
+    entry->prefix = html2tex_strdup(prefix);
+    entry->directory = html2tex_strdup(directory);
+
+    if (!entry->prefix || !entry->directory) {
+        html2tex_free(entry->prefix);
+        html2tex_free(entry->directory);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to copy an image mirror mapping.");
+        return 0;
+    }
+
+    entry->prefix_len = strlen(prefix);
+    mirror->count++;
+    return 1;
+}
+
+/* image bytes registered for one source */
+typedef struct {
+    char* src;
+    unsigned char* data;
+    size_t size;
+} MemoryImage;
+
+typedef struct {
+    MemoryImage* images;
+    size_t count;
+    size_t capacity;
+} ImageMemory;
+
+static MemoryImage* find_memory_image(const ImageMemory* memory, const char* src) {
+    for (size_t i = 0; i < memory->count; i++) {
+        if (strcmp(memory->images[i].src, src) == 0)
+            return &memory->images[i];
+    }
+
+    return NULL;
+}
+
+static int memory_accepts(void* context, const char* src) {
+    return find_memory_image((const ImageMemory*)context, src) != NULL;
+}
+
+static int memory_fetch(void* context, const char* src, const char* path) {
+    const MemoryImage* image = find_memory_image((const ImageMemory*)context, src);
+    FILE* file = fopen(path, "wb");
+
+    if (!file) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open file '%s' for writing: %s.",
+            path, strerror(errno));
+        return 0;
+    }
+
+    int success = fwrite(image->data, 1, image->size, file) == image->size;
+
+    if (fclose(file) != 0) success = 0;
+
+    if (!success) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to write complete image data to '%s': %s.",
+            path, strerror(errno));
+        remove(path);
+    }
+
+    return success;
+}
+
+static void memory_destroy(void* context) {
+    ImageMemory* memory = (ImageMemory*)context;
+
+    for (size_t i = 0; i < memory->count; i++) {
+        html2tex_free(memory->images[i].src);
+        html2tex_free(memory->images[i].data);
+    }
+
+    html2tex_free(memory->images);
+    html2tex_free(memory);
+}
+
+static const ImageFetcherVTable memory_vtable = {
+    memory_accepts, memory_fetch, NULL, NULL, memory_destroy
+};
+
+ImageFetcher* image_fetcher_memory_create(void) {
+    html2tex_err_clear();
+    ImageMemory* memory = (ImageMemory*)html2tex_calloc(1, sizeof(ImageMemory));
+
+    if (!memory) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the in-memory image set.");
+        return NULL;
+    }
+
+    ImageFetcher* fetcher = image_fetcher_create(&memory_vtable, memory);
+    if (!fetcher) html2tex_free(memory);
+
+    return fetcher;
+}
+
+int image_fetcher_memory_add(ImageFetcher* fetcher, const char* src,
+    const void* data, size_t size) {
+    html2tex_err_clear();
+
+    if (!fetcher || !src || (!data && size)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image set, source or image data is NULL.");
+        return 0;
+    }
+
+    if (fetcher->vtable != &memory_vtable) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetcher is not an in-memory image set.");
+        return 0;
+    }
+
+    ImageMemory* memory = (ImageMemory*)fetcher->context;
+    unsigned char* copy = (unsigned char*)html2tex_malloc(size ? size : 1);
+
+    if (!copy) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to copy %zu bytes of image data.", size);
+        return 0;
+    }
+
+    if (size) memcpy(copy, data, size);
+    MemoryImage* image = find_memory_image(memory, src);
+
+    /* a second registration replaces the bytes of the first */
+    if (image) {
+        html2tex_free(image->data);
+        image->data = copy;
+        image->size = size;
+        return 1;
+    }
+
+    if (memory->count == memory->capacity) {
+        const size_t capacity = memory->capacity ? memory->capacity * 2 : 8;
+        MemoryImage* images = (MemoryImage*)html2tex_realloc(memory->images,
+            capacity * sizeof(MemoryImage));
+
+        if (!images) {
+            html2tex_free(copy);
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to grow the in-memory image set.");
+            return 0;
+        }
+
+        memory->images = images;
+        memory->capacity = capacity;
+    }
+
+    image = &memory->images[memory->count];
+    image->src = html2tex_strdup(src);
+
+    if (!image->src) {
+        html2tex_free(copy);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to copy the image source.");
+        return 0;
+    }
+
+    image->data = copy;
+    image->size = size;
+    memory->count++;
+    return 1;
+}
+
+/* network sources, context is the download engine */
+static int curl_accepts(void* context, const char* src) {
+    (void)context;
+
+    return has_url_scheme(src) && strncasecmp(src, "data:", 5) != 0
+        && strncasecmp(src, "file:", 5) != 0;
+}
+
+static int curl_fetch(void* context, const char* src, const char* path) {
+    return html_download_engine_fetch((HTMLDownloadEngine*)context, src, path);
+}
+
+static int curl_submit(void* context, const char* src, const char* path,
+    ImageFetchCallback callback, void* user_data) {
+    return html_download_engine_submit((HTMLDownloadEngine*)context,
+        src, path, callback, user_data);
+}
+
+static size_t curl_cancel(void* context) {
+    return html_download_engine_cancel((HTMLDownloadEngine*)context);
+}
+
+static void curl_destroy(void* context) {
+    html_download_engine_destroy((HTMLDownloadEngine*)context);
+}
+
+static const ImageFetcherVTable curl_vtable = {
+    curl_accepts, curl_fetch, curl_submit, curl_cancel, curl_destroy
+};
+
+ImageFetcher* image_fetcher_curl_create(const HTMLDownloadOptions* options) {
+    html2tex_err_clear();
+    HTMLDownloadEngine* engine = html_download_engine_create(options);
+
+    if (!engine) return NULL;
+    ImageFetcher* fetcher = image_fetcher_create(&curl_vtable, engine);
+
+    if (!fetcher) html_download_engine_destroy(engine);
+    return fetcher;
+}
+
+/* fetchers tried in order */
+typedef struct {
+    ImageFetcher** fetchers;
+    size_t count;
+} ImageFetcherChain;
+
+static ImageFetcher* chain_select(const ImageFetcherChain* chain, const char* src) {
+    for (size_t i = 0; i < chain->count; i++) {
+        if (image_fetcher_accepts(chain->fetchers[i], src))
+            return chain->fetchers[i];
+    }
+
+    return NULL;
+}
+
+static int chain_accepts(void* context, const char* src) {
+    return chain_select((const ImageFetcherChain*)context, src) != NULL;
+}
+
+static int chain_fetch(void* context, const char* src, const char* path) {
+    return image_fetcher_fetch(chain_select(
+        (const ImageFetcherChain*)context, src), src, path);
+}
+
+static int chain_submit(void* context, const char* src, const char* path,
+    ImageFetchCallback callback, void* user_data) {
+    return image_fetcher_submit(chain_select((const ImageFetcherChain*)context, src),
+        src, path, callback, user_data);
+}
+
+static size_t chain_cancel(void* context) {
+    const ImageFetcherChain* chain = (const ImageFetcherChain*)context;
+    size_t cancelled = 0;
+
+    for (size_t i = 0; i < chain->count; i++)
+        cancelled += image_fetcher_cancel(chain->fetchers[i]);
+
+    return cancelled;
+}
+
+static void chain_destroy(void* context) {
+    ImageFetcherChain* chain = (ImageFetcherChain*)context;
+
+    for (size_t i = 0; i < chain->count; i++)
+        image_fetcher_destroy(chain->fetchers[i]);
+
+    html2tex_free(chain->fetchers);
+    html2tex_free(chain);
+}
+
+static const ImageFetcherVTable chain_vtable = {
+    chain_accepts, chain_fetch, chain_submit, chain_cancel, chain_destroy
+};
+
+ImageFetcher* image_fetcher_chain_create(ImageFetcher* const* fetchers, size_t count) {
+    html2tex_err_clear();
+
+    if (!fetchers || !count) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image fetcher chain has no fetchers.");
+        return NULL;
+    }
+
+    ImageFetcherChain* chain = (ImageFetcherChain*)html2tex_calloc(1, sizeof(ImageFetcherChain));
+    ImageFetcher** members = (ImageFetcher**)html2tex_malloc(count * sizeof(ImageFetcher*));
+
+    if (!chain || !members) {
+        html2tex_free(chain);
+        html2tex_free(members);
+
+        for (size_t i = 0; i < count; i++)
+            image_fetcher_destroy(fetchers[i]);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the image fetcher chain.");
+        return NULL;
+    }
+
+    /* NULL members are skipped, so a failed create can be passed along */
+    for (size_t i = 0; i < count; i++) {
+        if (fetchers[i])
+            members[chain->count++] = fetchers[i];
+    }
+
+    chain->fetchers = members;
+    ImageFetcher* fetcher = image_fetcher_create(&chain_vtable, chain);
+
+    if (!fetcher) chain_destroy(chain);
+    return fetcher;
+}
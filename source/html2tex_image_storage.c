@@ -1,10 +1,11 @@
 #include "html2tex.h"
+#include <string.h>
 
 ImageStorage* create_image_storage() {
     /* clear any previous error state */
     html2tex_err_clear();
 
-    ImageStorage* store = (ImageStorage*)malloc(sizeof(ImageStorage));
+    ImageStorage* store = (ImageStorage*)html2tex_malloc(sizeof(ImageStorage));
 
     if (!store) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -17,9 +18,119 @@ ImageStorage* create_image_storage() {
     /* initialize with safe defaults */
     store->lazy_downloading = 0;
     store->image_stack = NULL;
+
+    store->urls = NULL;
+    store->url_capacity = 0;
+    store->url_count = 0;
+    store->dedup_hits = 0;
     return store;
 }
 
+/* djb2 over the URL, the table size is a power of two */
+static size_t url_slot(const ImageURLEntry* urls, size_t capacity, const char* url) {
+    unsigned long hash = 5381;
+
+    for (const unsigned char* p = (const unsigned char*)url; *p; p++)
+        hash = ((hash << 5) + hash) + *p;
+
+    size_t slot = (size_t)hash & (capacity - 1);
+
+    while (urls[slot].url && strcmp(urls[slot].url, url) != 0)
+        slot = (slot + 1) & (capacity - 1);
+
+    return slot;
+}
+
+static int grow_urls(ImageStorage* store) {
+    const size_t capacity = store->url_capacity ? store->url_capacity * 2 : 64;
+    ImageURLEntry* urls = (ImageURLEntry*)html2tex_calloc(capacity, sizeof(ImageURLEntry));
+
+    if (!urls) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate %zu image URL slots.", capacity);
+        return 0;
+    }
+
+    for (size_t i = 0; i < store->url_capacity; i++) {
+        if (store->urls[i].url)
+            urls[url_slot(urls, capacity, store->urls[i].url)] = store->urls[i];
+    }
+
+    html2tex_free(store->urls);
+    store->urls = urls;
+    store->url_capacity = capacity;
+    return 1;
+}
+
+int image_storage_track_url(ImageStorage* store, const char* url, const char* path) {
+    if (!store || !url) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "ImageStorage or URL is NULL for URL tracking.");
+        return -1;
+    }
+
+    /* keeps the load factor at or below one half */
+    if ((store->url_count + 1) * 2 > store->url_capacity && !grow_urls(store))
+        return -1;
+
+    ImageURLEntry* entry = &store->urls[url_slot(store->urls, store->url_capacity, url)];
+
+    if (entry->url) {
+        if (!entry->path && path) {
+            entry->path = html2tex_strdup(path);
+            if (!entry->path) return -1;
+        }
+
+        return 0;
+    }
+
+    entry->url = html2tex_strdup(url);
+    if (!entry->url) return -1;
+
+    if (path) {
+        entry->path = html2tex_strdup(path);
+
+        if (!entry->path) {
+            html2tex_free(entry->url);
+            entry->url = NULL;
+            return -1;
+        }
+    }
+
+    store->url_count++;
+    return 1;
+}
+
+const char* image_storage_reuse_url(ImageStorage* store, const char* url) {
+    if (!store || !url || !store->url_count) return NULL;
+    const ImageURLEntry* entry = &store->urls[url_slot(store->urls, store->url_capacity, url)];
+
+    if (!entry->url || !entry->path)
+        return NULL;
+
+    store->dedup_hits++;
+    return entry->path;
+}
+
+void image_storage_forget_urls(ImageStorage* store) {
+    if (!store) return;
+
+    for (size_t i = 0; i < store->url_capacity; i++) {
+        html2tex_free(store->urls[i].url);
+        html2tex_free(store->urls[i].path);
+    }
+
+    html2tex_free(store->urls);
+    store->urls = NULL;
+    store->url_capacity = 0;
+    store->url_count = 0;
+    store->dedup_hits = 0;
+}
+
+size_t image_storage_dedup_hits(const ImageStorage* store) {
+    return store ? store->dedup_hits : 0;
+}
+
 int clear_image_storage(ImageStorage* store) {
     /* clear any existing error state */
     html2tex_err_clear();
@@ -34,15 +145,15 @@ int clear_image_storage(ImageStorage* store) {
         /* propagate the existing error forward */
         if (errorThrown) {
             /* force memory clean up first */
-            stack_destroy(&image_stack, &free);
+            stack_destroy(&image_stack, &html2tex_free);
             return -1;
         }
 
         /* transferring data ownership succeed */
         for (size_t i = 0; i < count; i++)
-            free(filenames[i]);
+            html2tex_free(filenames[i]);
 
-        free(filenames);
+        html2tex_free(filenames);
         return 1;
     }
 
@@ -67,6 +178,15 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
 
     /* copy lazy downloading flag */
     new_store->lazy_downloading = store->lazy_downloading;
+    new_store->dedup_hits = store->dedup_hits;
+
+    for (size_t i = 0; i < store->url_capacity; i++) {
+        if (store->urls[i].url && image_storage_track_url(new_store,
+            store->urls[i].url, store->urls[i].path) < 0) {
+            destroy_image_storage(new_store);
+            return NULL;
+        }
+    }
 
     /* handle empty stack case efficiently */
     if (!store->image_stack || stack_is_empty(store->image_stack))
@@ -87,7 +207,7 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
         return NULL;
     }
 
-    char** filenames = (char**)malloc(count * sizeof(char*));
+    char** filenames = (char**)html2tex_malloc(count * sizeof(char*));
     if (!filenames) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate %zu bytes for"
@@ -110,7 +230,7 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
         const char* original = (const char*)current->data;
 
         if (original) {
-            char* copy = strdup(original);
+            char* copy = html2tex_strdup(original);
 
             if (!copy) {
                 allocation_failed = 1;
@@ -134,10 +254,10 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
     if (allocation_failed) {
         for (size_t i = 0; i < index && i < count; i++) {
             if (filenames[i])
-                free(filenames[i]);
+                html2tex_free(filenames[i]);
         }
 
-        free(filenames);
+        html2tex_free(filenames);
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to duplicate filename "
             "string during ImageStorage copy.");
@@ -153,16 +273,16 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
             while (!stack_is_empty(new_store->image_stack)) {
                 char* item = (char*)stack_pop(
                     &new_store->image_stack);
-                if (item) free(item);
+                if (item) html2tex_free(item);
             }
 
             /* cleanup remaining filenames */
             for (size_t j = i; j < index; j++) {
                 if (filenames[j]) 
-                    free(filenames[j]);
+                    html2tex_free(filenames[j]);
             }
 
-            free(filenames);
+            html2tex_free(filenames);
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to push filename onto "
                 "stack during ImageStorage copy.");
@@ -173,7 +293,7 @@ ImageStorage* copy_image_storage(const ImageStorage* store) {
     }
 
     /* free temporary array */
-    free(filenames);
+    html2tex_free(filenames);
     return new_store;
 }
 
@@ -184,7 +304,9 @@ void destroy_image_storage(ImageStorage* store) {
 
     store->lazy_downloading = 0;
     clear_image_storage(store);
-    free(store);
+
+    image_storage_forget_urls(store);
+    html2tex_free(store);
 }
 
 int html2tex_enable_downloads(ImageStorage** storage, int enable) {
@@ -262,6 +384,15 @@ int html2tex_add_image(ImageStorage** storage, const char* file_path) {
     if (!store || (store && !store->lazy_downloading))
         return 0;
 
+    /* a URL already queued in this document is not queued again */
+    const int tracked = image_storage_track_url(store, file_path, NULL);
+    if (tracked < 0) return -1;
+
+    if (tracked == 0) {
+        store->dedup_hits++;
+        return 1;
+    }
+
     /* duplicate file path with bounds checking */
     size_t path_len = strlen(file_path);
 
@@ -272,13 +403,13 @@ int html2tex_add_image(ImageStorage** storage, const char* file_path) {
         return -1;
     }
 
-    char* full_path = strdup(file_path);
+    char* full_path = html2tex_strdup(file_path);
     if (!full_path) return -1;
 
     /* push onto image stack with error handling */
     if (!stack_push(&store->image_stack, full_path)) {
         /* clean up allocated path */
-        free(full_path);
+        html2tex_free(full_path);
 
         /* check if error was already set */
         if (!html2tex_has_error()) {
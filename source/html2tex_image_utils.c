@@ -29,7 +29,6 @@
 #include <ctype.h>
 #include <stdint.h>
 
-#include <curl/curl.h>
 #include "html2tex.h"
 #include <time.h>
 
@@ -88,7 +87,7 @@ static char* extract_mime_type(const char* base64_data) {
         return NULL;
     }
 
-    char* mime_type = (char*)malloc(len + 1);
+    char* mime_type = (char*)html2tex_malloc(len + 1);
 
     if (!mime_type) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -102,233 +101,229 @@ static char* extract_mime_type(const char* base64_data) {
     return mime_type;
 }
 
-/* @brief Extract base64 data from data URI. */
-static char* extract_base64_data(const char* base64_data) {
-    /* clear any existing error state */
-    html2tex_err_clear();
-
-    if (!base64_data) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "Base64 data URI is NULL for "
-            "data extraction.");
-        return NULL;
-    }
+/* @brief Get file extension from MIME type. */
+static const char* get_extension_from_mime_type(const char* mime_type) {
+    if (!mime_type) return ".bin";
 
-    const char* base64_prefix = "base64,";
-    const char* data_start = strstr(base64_data, base64_prefix);
+    if (strstr(mime_type, "jpeg") || strstr(mime_type, "jpg")) return ".jpg";
+    else if (strstr(mime_type, "png")) return ".png";
+    else if (strstr(mime_type, "gif")) return ".gif";
+    else if (strstr(mime_type, "bmp")) return ".bmp";
+    else if (strstr(mime_type, "tiff")) return ".tiff";
+    else if (strstr(mime_type, "webp")) return ".webp";
+    else if (strstr(mime_type, "svg")) return ".svg";
+    else return ".bin";
+}
 
-    if (!data_start) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Malformed data URI: missing base64 prefix.");
-        return NULL;
-    }
+/* decoded bytes written per block, a multiple of the 12 bytes one vector yields */
+#define BASE64_BLOCK_SIZE (8 * 1024 * 3)
 
-    data_start += strlen(base64_prefix);
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BASE64_SSE2 1
+#endif
 
-    /* validate we have data after the prefix */
-    if (*data_start == '\0') {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Empty base64 data after prefix.");
-        return NULL;
-    }
+/* streaming decoder, sextets of an incomplete quad carry over between characters */
+typedef struct {
+    /* blocks go to the file, or to the sink when it is NULL */
+    FILE* file;
+    const HTMLDownloadSink* sink;
+    void* sink_data;
+
+    unsigned char block[BASE64_BLOCK_SIZE];
+    size_t used;
+    size_t written;
+
+    unsigned long quad;
+    int sextets;
+    int padding;
+    int finished;
+} Base64Stream;
+
+#ifdef BASE64_SSE2
+/* decodes 16 plain base64 digits into 12 bytes, 0 when any character needs the scalar path */
+static int base64_decode_vector(const char* input, unsigned char* output) {
+    const __m128i chars = _mm_loadu_si128((const __m128i*)input);
+
+    /* bytes above 0x7F compare as negative and fall outside every range */
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('A' - 1)),
+        _mm_cmplt_epi8(chars, _mm_set1_epi8('Z' + 1)));
+    const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(chars, _mm_set1_epi8('z' + 1)));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    const __m128i plus = _mm_cmpeq_epi8(chars, _mm_set1_epi8('+'));
+    const __m128i slash = _mm_cmpeq_epi8(chars, _mm_set1_epi8('/'));
+
+    const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+        _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+
+    if (_mm_movemask_epi8(valid) != 0xFFFF)
+        return 0;
 
-    /* calculate length and allocate efficiently */
-    size_t len = strlen(data_start);
-    size_t clean_len = 0;
+    /* each range maps to its sextets by a constant offset */
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+    offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
 
-    /* pre-scan to determine exact memory needed */
-    for (const char* src = data_start; *src; src++) {
-        if (!isspace((unsigned char)*src)) {
-            clean_len++;
-        }
-    }
+    const __m128i sextets = _mm_add_epi8(chars, offset);
 
-    if (clean_len == 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Base64 data contains only whitespace.");
-        return NULL;
-    }
+    /* joins sextet pairs into 12 bits, then 12-bit pairs into 24 bits per lane */
+    const __m128i pairs = _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(sextets, _mm_set1_epi16(0x00FF)), 6),
+        _mm_srli_epi16(sextets, 8));
+    const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
 
-    char* clean_data = (char*)malloc(clean_len + 1);
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, triples);
 
-    if (!clean_data) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to allocate %zu bytes for base64 data.",
-            clean_len + 1);
-        return NULL;
+    for (int i = 0; i < 4; i++) {
+        output[3 * i] = (unsigned char)(lanes[i] >> 16);
+        output[3 * i + 1] = (unsigned char)(lanes[i] >> 8);
+        output[3 * i + 2] = (unsigned char)lanes[i];
     }
 
-    /* copy and clean the data */
-    char* dest = clean_data;
+    return 1;
+}
+#endif
 
-    for (const char* src = data_start; *src; src++) {
-        if (!isspace((unsigned char)*src)) {
-            *dest++ = *src;
-        }
-    }
+/* feeds one character, whitespace is skipped and '=' pads the final quad */
+static int base64_push(Base64Stream* stream, unsigned char c) {
+    if (isspace(c)) return 1;
 
-    *dest = '\0';
+    /* nothing but whitespace may follow the padded quad */
+    if (stream->finished) return 0;
 
-    /* validate the cleaned data looks like base64 */
-    if (clean_len % 4 != 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Invalid base64 data length: %zu (must be multiple of 4).",
-            clean_len);
-        free(clean_data);
-        return NULL;
+    if (c == '=') {
+        /* padding fills at most the last two places of a quad */
+        if (stream->sextets < 2) return 0;
+        stream->padding++;
     }
+    else {
+        const unsigned char value = base64_table[c];
+        if (value == 0x80 || stream->padding) return 0;
 
-    /* quick sanity check for base64 characters */
-    for (size_t i = 0; i < clean_len; i++) {
-        char c = clean_data[i];
-        if (!((c >= 'A' && c <= 'Z') ||
-            (c >= 'a' && c <= 'z') ||
-            (c >= '0' && c <= '9') ||
-            c == '+' || c == '/' || c == '=')) {
-            HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-                "Invalid base64 character '%c' (0x%02X) at position %zu.",
-                (c < 32 || c > 126) ? '?' : c, (unsigned char)c, i);
-            free(clean_data);
-            return NULL;
-        }
+        stream->quad = (stream->quad << 6) | value;
+        stream->sextets++;
     }
 
-    return clean_data;
-}
+    if (stream->sextets + stream->padding < 4)
+        return 1;
 
-/* @brief Get file extension from MIME type. */
-static const char* get_extension_from_mime_type(const char* mime_type) {
-    if (!mime_type) return ".bin";
+    const unsigned long triple = stream->quad << (6 * stream->padding);
+    stream->block[stream->used++] = (unsigned char)(triple >> 16);
 
-    if (strstr(mime_type, "jpeg") || strstr(mime_type, "jpg")) return ".jpg";
-    else if (strstr(mime_type, "png")) return ".png";
-    else if (strstr(mime_type, "gif")) return ".gif";
-    else if (strstr(mime_type, "bmp")) return ".bmp";
-    else if (strstr(mime_type, "tiff")) return ".tiff";
-    else if (strstr(mime_type, "webp")) return ".webp";
-    else if (strstr(mime_type, "svg")) return ".svg";
-    else return ".bin";
-}
+    if (stream->padding < 2)
+        stream->block[stream->used++] = (unsigned char)(triple >> 8);
 
-/* @brief Robust base64 decoding function. */
-static unsigned char* base64_decode(const char* data, size_t input_len, size_t* output_len) {
-    /* clear any existing error state */
-    html2tex_err_clear();
+    if (stream->padding < 1)
+        stream->block[stream->used++] = (unsigned char)triple;
 
-    if (!data) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "Base64 data is NULL for decoding.");
-        return NULL;
-    }
-
-    if (input_len == 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Empty base64 data for decoding.");
-        return NULL;
-    }
+    stream->finished = stream->padding > 0;
+    stream->quad = 0;
+    stream->sextets = 0;
+    return 1;
+}
 
-    /* invalid base64 string length */
-    if (input_len % 4 != 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Invalid base64 length: %zu (must be multiple of 4).",
-            input_len);
-        return NULL;
-    }
+static int base64_flush(Base64Stream* stream) {
+    if (stream->used && (stream->file
+        ? fwrite(stream->block, 1, stream->used, stream->file) != stream->used
+        : !stream->sink->write(stream->block, stream->used, stream->sink_data)))
+        return 0;
 
-    /* calculate output length with padding handling */
-    *output_len = (input_len * 3) / 4;
+    stream->written += stream->used;
+    stream->used = 0;
+    return 1;
+}
 
-    if (data[input_len - 1] == '=') (*output_len)--;
-    if (data[input_len - 2] == '=') (*output_len)--;
+/* @brief Locate the payload of a base64 data URI. */
+static const char* find_base64_payload(const char* base64_data) {
+    const char* base64_prefix = "base64,";
+    const char* data_start = strstr(base64_data, base64_prefix);
 
-    if (*output_len == 0) {
+    if (!data_start) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Zero-length output after base64 padding removal.");
+            "Malformed data URI: missing base64 prefix.");
         return NULL;
     }
 
-    /* validate maximum reasonable output size */
-    const size_t MAX_REASONABLE_SIZE = 16 * 1024 * 1024;
+    data_start += strlen(base64_prefix);
 
-    if (*output_len > MAX_REASONABLE_SIZE) {
+    /* validate we have data after the prefix */
+    if (*data_start == '\0') {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Decoded base64 size %zu exceeds maximum allowed %zu bytes.",
-            *output_len, MAX_REASONABLE_SIZE);
+            "Empty base64 data after prefix.");
         return NULL;
     }
 
-    unsigned char* decoded = (unsigned char*)malloc(*output_len);
-    if (!decoded) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
-            "Failed to allocate %zu bytes for decoded base64 data.",
-            *output_len);
-        return NULL;
-    }
+    return data_start;
+}
 
-    const unsigned char* input = (const unsigned char*)data;
-    unsigned char* output = decoded;
+/* @brief Decode a payload into the stream, target names the destination in errors. */
+static int decode_base64_payload(const char* data_start, Base64Stream* stream, const char* target) {
+    stream->used = stream->written = 0;
+    stream->quad = 0;
+    stream->sextets = stream->padding = stream->finished = 0;
 
-    for (size_t i = 0; i < input_len; ) {
-        /* decode 4 characters to 3 bytes */
-        unsigned long int sextet_a = (input[i] == '=') ? 
-            0 : base64_table[input[i]];
-        i++;
+    const char* end = data_start + strlen(data_start);
+    int success = 1;
 
-        unsigned long int sextet_b = (input[i] == '=') ? 
-            0 : base64_table[input[i]];
-        i++;
+    for (const char* p = data_start; p < end; ) {
+        if (stream->used > BASE64_BLOCK_SIZE - 12 && !base64_flush(stream)) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+                "Failed to write complete image data to '%s': %s.", target,
+                stream->file ? strerror(errno) : "write refused");
+            success = 0;
+            break;
+        }
 
-        unsigned long int sextet_c = (input[i] == '=') ? 
-            0 : base64_table[input[i]];
-        i++;
+#ifdef BASE64_SSE2
+        /* runs of plain digits on a quad boundary decode 16 characters at a time */
+        if (!stream->sextets && !stream->finished && end - p >= 16
+            && base64_decode_vector(p, stream->block + stream->used)) {
+            p += 16;
+            stream->used += 12;
+            continue;
+        }
+#endif
 
-        unsigned long int sextet_d = (input[i] == '=') ? 
-            0 : base64_table[input[i]];
-        i++;
+        const unsigned char c = (unsigned char)*p++;
 
-        /* validate decoded values */
-        if (sextet_a == 0x80 || sextet_b == 0x80 ||
-            sextet_c == 0x80 || sextet_d == 0x80) {
+        if (!base64_push(stream, c)) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-                "Invalid base64 character at position %zu: '%c' (0x%02X).",
-                i - 1, data[i - 1], (unsigned char)data[i - 1]);
-            free(decoded);
-            return NULL;
+                "Invalid base64 character '%c' (0x%02X) at position %zu.",
+                (c < 32 || c > 126) ? '?' : c, c, (size_t)(p - 1 - data_start));
+            success = 0;
+            break;
         }
+    }
 
-        /* combine into 24-bit value */
-        unsigned long int triple = (sextet_a << 18) | 
-            (sextet_b << 12) |
-            (sextet_c << 6) | 
-            sextet_d;
-
-        /* extract 3 bytes with bounds checking */
-        if (output - decoded < (ptrdiff_t)(*output_len - 2))
-            *output++ = (triple >> 16) & 0xFF;
-
-        if (output - decoded < (ptrdiff_t)(*output_len - 1))
-            *output++ = (triple >> 8) & 0xFF;
-
-        if (output - decoded < (ptrdiff_t)(*output_len))
-            *output++ = triple & 0xFF;
+    if (success && (stream->sextets || stream->padding) && !stream->finished) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
+            "Invalid base64 data length: last quad has %d of 4 characters.",
+            stream->sextets + stream->padding);
+        success = 0;
     }
 
-    /* verify it wrote the expected amount */
-    size_t bytes_written = (size_t)(output - decoded);
+    if (success && !base64_flush(stream)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to write complete image data to '%s': %s.", target,
+            stream->file ? strerror(errno) : "write refused");
+        success = 0;
+    }
 
-    if (bytes_written != *output_len) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_INTERNAL,
-            "Base64 decoding inconsistency: "
-            "expected %zu bytes, wrote %zu.",
-            *output_len, bytes_written);
-        free(decoded);
-        return NULL;
+    if (success && stream->written == 0) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
+            "Base64 decoding produced zero-length output.");
+        success = 0;
     }
 
-    return decoded;
+    return success;
 }
 
-/* @brief Decode base64 data and save to file. */
+/* @brief Decode a data URI in place and stream the image to a file. */
 static int save_base64_image(const char* base64_data, const char* filename) {
     /* clear any existing error state */
     html2tex_err_clear();
@@ -345,75 +340,84 @@ static int save_base64_image(const char* base64_data, const char* filename) {
         return 0;
     }
 
-    char* clean_data = extract_base64_data(base64_data);
-    /* error already set by extract_base64_data */
-    if (!clean_data) return 0;
-    size_t input_len = strlen(clean_data);
-
-    if (input_len == 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Cleaned base64 data is empty.");
-        free(clean_data);
-        return 0;
-    }
-
-    size_t output_len = 0;
-    unsigned char* decoded_data = base64_decode(
-        clean_data, input_len, &output_len);
-    free(clean_data);
+    const char* data_start = find_base64_payload(base64_data);
+    if (!data_start) return 0;
 
-    /* error already set by base64_decode */
-    if (!decoded_data) return 0;
+    Base64Stream stream;
+    stream.sink = NULL;
+    stream.sink_data = NULL;
+    stream.file = fopen(filename, "wb");
 
-    if (output_len == 0) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DECODE,
-            "Base64 decoding produced zero-length output.");
-        free(decoded_data);
-        return 0;
-    }
-
-    /* write to the file */
-    FILE* file = fopen(filename, "wb");
-
-    if (!file) {
+    if (!stream.file) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
             "Failed to open file '%s' for writing: %s.",
             filename, strerror(errno));
-        free(decoded_data);
         return 0;
     }
 
-    size_t written = fwrite(decoded_data, 
-        1, output_len, file);
+    /* blocks go straight to the descriptor, stdio would copy them once more */
+    setvbuf(stream.file, NULL, _IONBF, 0);
+    int success = decode_base64_payload(data_start, &stream, filename);
 
     /* close file before checking write result */
-    if (fclose(file) != 0) {
+    if (fclose(stream.file) != 0 && success) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
             "Failed to close file '%s' after write: %s.",
             filename, strerror(errno));
-        free(decoded_data);
+        success = 0;
+    }
+
+    /* never leave a partial image behind */
+    if (!success) remove(filename);
+    return success;
+}
+
+int stream_base64_image(const char* src, const HTMLDownloadSink* sink, void* user_data) {
+    /* clear any existing error state */
+    html2tex_err_clear();
+
+    if (!src || !sink || !sink->write) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Data URI or sink is NULL for image streaming.");
         return 0;
     }
 
-    free(decoded_data);
+    const char* data_start = find_base64_payload(src);
+    if (!data_start) return 0;
+
+    char* mime_type = extract_mime_type(src);
+    if (!mime_type) return 0;
+
+    /* the receiver learns the type before the first block */
+    const int accepted = !sink->begin || sink->begin(mime_type, user_data);
+    html2tex_free(mime_type);
 
-    if (written != output_len) {
+    if (!accepted) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
-            "Failed to write complete image data to '%s': "
-            "expected %zu bytes, wrote %zu bytes.",
-            filename, output_len, written);
+            "Receiver refused the decoded data URI image.");
         return 0;
     }
 
-    return 1;
+    Base64Stream stream;
+    stream.file = NULL;
+    stream.sink = sink;
+    stream.sink_data = user_data;
+
+    return decode_base64_payload(data_start, &stream, "image receiver");
 }
 
-/* @brief libcurl write callback */
-static size_t write_data(void* ptr, size_t size, size_t nmemb, FILE* stream) {
-    return fwrite(ptr, size, nmemb, stream);
+/* engine shared by the conversions in progress, guarded by engine_mutex */
+static once_t engine_once = THREAD_ONCE_INIT;
+static mutex_t engine_mutex;
+static HTMLDownloadEngine* shared_engine = NULL;
+static HTMLImageCache* shared_cache = NULL;
+static size_t engine_users = 0;
+
+static void init_engine_mutex(void) {
+    mutex_init(&engine_mutex);
 }
 
-/* @brief Download image from URL using libcurl. */
+/* @brief Download image from URL through the shared download engine. */
 static int download_image_url(const char* url, const char* filename) {
     /* clear any existing error state */
     html2tex_err_clear();
@@ -430,70 +434,17 @@ static int download_image_url(const char* url, const char* filename) {
         return 0;
     }
 
-    CURL* curl = NULL;
-    FILE* fp = NULL;
-    CURLcode res;
-    int success = 0;
-
-    curl = curl_easy_init();
-    if (!curl) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
-            "Failed to initialize libcurl handle.");
-        return 0;
-    }
-
-    fp = fopen(filename, "wb");
-    if (!fp) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
-            "Failed to open file '%s' for writing: %s.",
-            filename, strerror(errno));
-        curl_easy_cleanup(curl);
+    /* holds the engine alive, a lone call starts and stops its own */
+    if (image_utils_init() != 0)
         return 0;
-    }
-
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_data);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, "html2tex/1.0");
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
-
-    res = curl_easy_perform(curl);
 
-    if (res == CURLE_OK) {
-        long response_code = 0;
-        curl_easy_getinfo(curl, 
-            CURLINFO_RESPONSE_CODE, 
-            &response_code);
-
-        if (response_code == 200)
-            success = 1;
-        else {
-            HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
-                "HTTP request failed with status code: %ld for URL: %s.",
-                response_code, url);
-        }
-    }
-    else {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
-            "libcurl error: %s for URL: %s",
-            curl_easy_strerror(res), url);
-    }
-
-    if (fp) {
-        if (fclose(fp) != 0) {
-            HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
-                "Failed to close file '%s' after download: %s.",
-                filename, strerror(errno));
-        }
-    }
-
-    if (curl) curl_easy_cleanup(curl);
+    int success = html_download_engine_fetch(shared_engine, url, filename);
+    image_utils_cleanup();
     return success;
 }
 
 /* @brief Create directory if it doesn't exist. */
-static int create_directory_if_not_exists(const char* dir_path) {
+int create_directory_if_not_exists(const char* dir_path) {
     /* clear any existing error state */
     html2tex_err_clear();
 
@@ -513,7 +464,7 @@ static int create_directory_if_not_exists(const char* dir_path) {
 
     if (stat(dir_path, &st) == -1) {
         /* create directory recursively */
-        char* path_copy = strdup(dir_path);
+        char* path_copy = html2tex_strdup(dir_path);
 
         if (!path_copy) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -530,7 +481,8 @@ static int create_directory_if_not_exists(const char* dir_path) {
 #endif
 
         while (*p) {
-            if (*p == '/' || *p == '\\') {
+            /* a leading separator is the root of an absolute path */
+            if ((*p == '/' || *p == '\\') && p != path_copy) {
                 char old_char = *p;
                 *p = '\0';
 
@@ -539,7 +491,7 @@ static int create_directory_if_not_exists(const char* dir_path) {
                         HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
                             "Failed to create directory '%s': %s.",
                             path_copy, strerror(errno));
-                        free(path_copy);
+                        html2tex_free(path_copy);
                         return -1;
                     }
                 }
@@ -555,11 +507,11 @@ static int create_directory_if_not_exists(const char* dir_path) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
                 "Failed to create final directory '%s': %s.",
                 dir_path, strerror(errno));
-            free(path_copy);
+            html2tex_free(path_copy);
             return -1;
         }
 
-        free(path_copy);
+        html2tex_free(path_copy);
     }
 
     return 0;
@@ -583,7 +535,7 @@ static char* generate_safe_filename(const char* src, int image_counter) {
         return NULL;
     }
 
-    char* filename = (char*)malloc(256);
+    char* filename = (char*)html2tex_malloc(256);
 
     if (!filename) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -596,7 +548,7 @@ static char* generate_safe_filename(const char* src, int image_counter) {
 
         /* error already set by extract_mime_type */
         if (!mime_type) {
-            free(filename);
+            html2tex_free(filename);
             return NULL;
         }
 
@@ -605,20 +557,20 @@ static char* generate_safe_filename(const char* src, int image_counter) {
         if (!extension) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_INTERNAL,
                 "Failed to get extension for MIME type: %s.", mime_type);
-            free(mime_type);
-            free(filename);
+            html2tex_free(mime_type);
+            html2tex_free(filename);
             return NULL;
         }
 
         int result = snprintf(filename, 256, "image_%d%s",
             image_counter, extension);
-        free(mime_type);
+        html2tex_free(mime_type);
 
         if (result < 0 || result >= 256) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Generated filename exceeds buffer size for counter: %d.",
                 image_counter);
-            free(filename);
+            html2tex_free(filename);
             return NULL;
         }
     }
@@ -634,7 +586,7 @@ static char* generate_safe_filename(const char* src, int image_counter) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                     "Default filename exceeds buffer for counter: %d.",
                     image_counter);
-                free(filename);
+                html2tex_free(filename);
                 return NULL;
             }
 
@@ -656,7 +608,7 @@ static char* generate_safe_filename(const char* src, int image_counter) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                     "Default filename exceeds buffer for counter: %d.",
                     image_counter);
-                free(filename);
+                html2tex_free(filename);
                 return NULL;
             }
             return filename;
@@ -693,7 +645,7 @@ static char* generate_safe_filename(const char* src, int image_counter) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                     "Filename too long to add .jpg extension: %s.",
                     filename);
-                free(filename);
+                html2tex_free(filename);
                 return NULL;
             }
 
@@ -756,7 +708,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
             "Full path exceeds buffer size for: %s/%s.",
             output_dir, filename);
-        free(filename);
+        html2tex_free(filename);
         return NULL;
     }
 
@@ -767,12 +719,13 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
         return filename;
 
     /* file exists, apply deterministic hash */
-    free(filename);
+    html2tex_free(filename);
     unsigned long hash = deterministic_hash(src);
 
-    char hash_str[9];
+    /* two hex digits per byte of the hash */
+    char hash_str[2 * sizeof(unsigned long) + 1];
     snprintf_result = snprintf(hash_str, sizeof(hash_str),
-        "%08lx", hash);
+        "%0*lx", (int)(2 * sizeof(unsigned long)), hash);
 
     if (snprintf_result < 0 || snprintf_result >= (int)sizeof(hash_str)) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_INTERNAL,
@@ -791,27 +744,27 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
         if (!extension) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_INTERNAL,
                 "Failed to get extension for MIME type: %s.", mime_type);
-            free(mime_type);
+            html2tex_free(mime_type);
             return NULL;
         }
 
-        char* unique_name = (char*)malloc(256);
+        char* unique_name = (char*)html2tex_malloc(256);
         if (!unique_name) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate 256 bytes for unique filename.");
-            free(mime_type);
+            html2tex_free(mime_type);
             return NULL;
         }
 
         snprintf_result = snprintf(unique_name, 256, "image_%d_%s%s",
             image_counter, hash_str, extension);
-        free(mime_type);
+        html2tex_free(mime_type);
 
         if (snprintf_result < 0 || snprintf_result >= 256) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Unique filename exceeds buffer for counter: %d, hash: %s.",
                 image_counter, hash_str);
-            free(unique_name);
+            html2tex_free(unique_name);
             return NULL;
         }
 
@@ -824,7 +777,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
 
     /* empty filename */
     if (!*name_start) {
-        char* unique_name = (char*)malloc(256);
+        char* unique_name = (char*)html2tex_malloc(256);
         if (!unique_name) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate 256 bytes for"
@@ -838,7 +791,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Default unique filename exceeds buffer"
                 " for counter: %d.", image_counter);
-            free(unique_name);
+            html2tex_free(unique_name);
             return NULL;
         }
 
@@ -860,7 +813,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
             last_dot = p;
     }
 
-    char* unique_name = (char*)malloc(256);
+    char* unique_name = (char*)html2tex_malloc(256);
 
     if (!unique_name) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -903,7 +856,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
         if (snprintf_result < 0 || (size_t)snprintf_result >= remaining) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Filename with extension exceeds buffer: %s.", src);
-            free(unique_name);
+            html2tex_free(unique_name);
             return NULL;
         }
     }
@@ -941,7 +894,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
         if (snprintf_result < 0 || (size_t)snprintf_result >= remaining) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
                 "Filename without extension exceeds buffer: %s.", src);
-            free(unique_name);
+            html2tex_free(unique_name);
             return NULL;
         }
     }
@@ -949,7 +902,7 @@ static char* generate_unique_filename(const char* output_dir, const char* src, i
     return unique_name;
 }
 
-char* download_image_src(ImageStorage** storage, const char* src, const char* output_dir, int image_counter) {
+char* prepare_image_path(const char* src, const char* output_dir, int image_counter) {
     /* clear any existing error state */
     html2tex_err_clear();
 
@@ -976,6 +929,26 @@ char* download_image_src(ImageStorage** storage, const char* src, const char* ou
     if (create_directory_if_not_exists(output_dir) != 0)
         return NULL;
 
+    return build_image_path(src, output_dir, image_counter);
+}
+
+char* build_image_path(const char* src, const char* output_dir, int image_counter) {
+    /* clear any existing error state */
+    html2tex_err_clear();
+
+    if (!src || !output_dir) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image source or output directory is NULL for the image path.");
+        return NULL;
+    }
+
+    if (image_counter < 0) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Invalid image counter: %d (must be non-negative).",
+            image_counter);
+        return NULL;
+    }
+
     /* generate unique filename */
     char* safe_filename = generate_unique_filename(output_dir, src, image_counter);
     if (!safe_filename) return NULL;
@@ -989,18 +962,18 @@ char* download_image_src(ImageStorage** storage, const char* src, const char* ou
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
             "Path length overflow: dir=%zu, filename=%zu.",
             dir_len, filename_len);
-        free(safe_filename);
+        html2tex_free(safe_filename);
         return NULL;
     }
 
     size_t full_path_len = dir_len + filename_len + 2;
-    char* full_path = (char*)malloc(full_path_len);
+    char* full_path = (char*)html2tex_malloc(full_path_len);
 
     if (!full_path) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate %zu bytes for full path.",
             full_path_len);
-        free(safe_filename);
+        html2tex_free(safe_filename);
         return NULL;
     }
 
@@ -1011,28 +984,42 @@ char* download_image_src(ImageStorage** storage, const char* src, const char* ou
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
             "Generated full path exceeds allocated buffer: %s/%s.",
             output_dir, safe_filename);
-        free(safe_filename);
-        free(full_path);
+        html2tex_free(safe_filename);
+        html2tex_free(full_path);
         return NULL;
     }
 
+    html2tex_free(safe_filename);
+    return full_path;
+}
+
+char* fetch_image_src(ImageFetcher* fetcher, ImageStorage** storage,
+    const char* src, const char* output_dir, int image_counter) {
+    char* full_path = prepare_image_path(src, output_dir, image_counter);
+    if (!full_path) return NULL;
+
     ImageStorage* store = storage ? (*storage) : NULL;
     int success = 0;
 
+    /* data URIs stream to disk at once, queueing them would copy the whole payload */
+    if (is_base64_image(src)) {
+        if (save_base64_image(src, full_path))
+            return full_path;
+
+        html2tex_free(full_path);
+        return NULL;
+    }
+
     /* lazy image download is not enabled */
     if (!store || (store != NULL && !store->lazy_downloading)) {
-        /* handle base64 encoded image */
-        if (is_base64_image(src))
-            success = save_base64_image(src, full_path);
-        else
-            /* handle normal URL */
-            success = download_image_url(src, full_path);
-        free(safe_filename);
+        /* handle normal URL */
+        success = fetcher ? image_fetcher_fetch(fetcher, src, full_path)
+            : download_image_url(src, full_path);
 
         if (success)
             return full_path;
         else {
-            free(full_path);
+            html2tex_free(full_path);
             return NULL;
         }
     }
@@ -1040,17 +1027,450 @@ char* download_image_src(ImageStorage** storage, const char* src, const char* ou
         success = html2tex_add_image(storage, src);
         if (success > 0) return full_path;
         else {
-            free(full_path);
+            html2tex_free(full_path);
             return NULL;
         }
     }
 }
 
+char* download_image_src(ImageStorage** storage, const char* src, const char* output_dir, int image_counter) {
+    return fetch_image_src(NULL, storage, src, output_dir, image_counter);
+}
+
+struct ImagePrefetch {
+    ImageFetcher* fetcher;
+    mutex_t mutex;
+    cond_t settled;
+    size_t pending;
+    size_t failed;
+
+    /* where images go, fixed before the first image */
+    ImageDelivery delivery;
+    ImageStreamWriter writer;
+    void* user_data;
+
+    /* images delivered in memory, guarded by mutex */
+    DownloadResult** images;
+    size_t image_count;
+    size_t image_capacity;
+};
+
+/* an image of a memory or stream delivery, described to the writer by image */
+typedef struct {
+    ImagePrefetch* prefetch;
+    DownloadResult* image;
+    size_t capacity;
+} PrefetchImage;
+
+static void prefetch_done(const char* url, const char* path, const char* error, void* user_data) {
+    ImagePrefetch* prefetch = (ImagePrefetch*)user_data;
+    (void)url;
+    (void)path;
+
+    mutex_lock(&prefetch->mutex);
+    if (error) prefetch->failed++;
+
+    if (--prefetch->pending == 0)
+        cond_broadcast(&prefetch->settled);
+
+    mutex_unlock(&prefetch->mutex);
+}
+
+ImagePrefetch* image_prefetch_create(ImageFetcher* fetcher) {
+    ImagePrefetch* prefetch = (ImagePrefetch*)html2tex_calloc(1, sizeof(ImagePrefetch));
+
+    if (!prefetch) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the image prefetch set.");
+        return NULL;
+    }
+
+    prefetch->fetcher = fetcher;
+    mutex_init(&prefetch->mutex);
+    cond_init(&prefetch->settled);
+    return prefetch;
+}
+
+int image_prefetch_set_delivery(ImagePrefetch* prefetch, ImageDelivery delivery,
+    const ImageStreamWriter* writer, void* user_data) {
+    if (!prefetch || (delivery == IMAGE_DELIVERY_STREAM && (!writer || !writer->write))) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Prefetch set or stream writer is NULL.");
+        return 0;
+    }
+
+    if (delivery < IMAGE_DELIVERY_FILE || delivery > IMAGE_DELIVERY_STREAM) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Unsupported image delivery %d.", (int)delivery);
+        return 0;
+    }
+
+    /* fetchers write files, only the engine hands out the body */
+    if (prefetch->fetcher && delivery != IMAGE_DELIVERY_FILE) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetchers only deliver files.");
+        return 0;
+    }
+
+    prefetch->delivery = delivery;
+    prefetch->user_data = user_data;
+    memset(&prefetch->writer, 0, sizeof(prefetch->writer));
+
+    if (delivery == IMAGE_DELIVERY_STREAM)
+        prefetch->writer = *writer;
+
+    return 1;
+}
+
+/* describes an image to its sink, in the process-wide allocator because the event loop releases it */
+static PrefetchImage* create_prefetch_image(ImagePrefetch* prefetch,
+    const char* src, const char* full_path, int image_counter) {
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    PrefetchImage* entry = (PrefetchImage*)html2tex_calloc(1, sizeof(PrefetchImage));
+    DownloadResult* image = entry
+        ? (DownloadResult*)html2tex_calloc(1, sizeof(DownloadResult)) : NULL;
+
+    const char* filename = strrchr(full_path, '/');
+    filename = filename ? filename + 1 : full_path;
+
+    if (image) {
+        image->url = html2tex_strdup(src);
+        image->local_path = html2tex_strdup(full_path);
+        image->filename = html2tex_strdup(filename);
+        image->sequence_number = image_counter;
+    }
+
+    if (!image || !image->url || !image->local_path || !image->filename) {
+        download_result_free(image);
+        html2tex_free(entry);
+        entry = NULL;
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the delivery of %s.", full_path);
+    }
+    else {
+        entry->prefetch = prefetch;
+        entry->image = image;
+    }
+
+    html2tex_allocator_leave(previous);
+    return entry;
+}
+
+static int prefetch_begin(const char* content_type, void* user_data) {
+    PrefetchImage* entry = (PrefetchImage*)user_data;
+    ImagePrefetch* prefetch = entry->prefetch;
+
+    if (content_type) {
+        entry->image->content_type = html2tex_strdup(content_type);
+        if (!entry->image->content_type) return 0;
+    }
+
+    if (prefetch->delivery == IMAGE_DELIVERY_STREAM && prefetch->writer.begin)
+        return prefetch->writer.begin(entry->image, prefetch->user_data);
+
+    return 1;
+}
+
+static int prefetch_write(const void* data, size_t size, void* user_data) {
+    PrefetchImage* entry = (PrefetchImage*)user_data;
+    ImagePrefetch* prefetch = entry->prefetch;
+    DownloadResult* image = entry->image;
+
+    if (prefetch->delivery == IMAGE_DELIVERY_STREAM)
+        return prefetch->writer.write(image, data, size, prefetch->user_data);
+
+    if (size > entry->capacity - image->size) {
+        size_t capacity = entry->capacity ? entry->capacity : 16384;
+
+        while (capacity - image->size < size) {
+            if (capacity > SIZE_MAX / 2) return 0;
+            capacity *= 2;
+        }
+
+        unsigned char* grown = (unsigned char*)html2tex_realloc(image->data, capacity);
+        if (!grown) return 0;
+
+        image->data = grown;
+        entry->capacity = capacity;
+    }
+
+    memcpy(image->data + image->size, data, size);
+    image->size += size;
+    return 1;
+}
+
+static const HTMLDownloadSink prefetch_sink = { prefetch_begin, prefetch_write };
+
+/* keeps an image delivered in memory and settles its download */
+static void prefetch_delivered(const char* url, const char* path, const char* error, void* user_data) {
+    PrefetchImage* entry = (PrefetchImage*)user_data;
+    ImagePrefetch* prefetch = entry->prefetch;
+    DownloadResult* image = entry->image;
+    html2tex_free(entry);
+
+    if (!error && prefetch->delivery == IMAGE_DELIVERY_MEMORY) {
+        /* an empty image still gets a buffer, so data tells delivery apart from failure */
+        if (!image->data) image->data = (unsigned char*)html2tex_malloc(1);
+        image->success = image->data != NULL;
+
+        mutex_lock(&prefetch->mutex);
+
+        if (image->success && prefetch->image_count == prefetch->image_capacity) {
+            const size_t capacity = prefetch->image_capacity ? prefetch->image_capacity * 2 : 8;
+            DownloadResult** images = (DownloadResult**)html2tex_realloc(prefetch->images,
+                capacity * sizeof(DownloadResult*));
+
+            if (images) {
+                prefetch->images = images;
+                prefetch->image_capacity = capacity;
+            }
+            else image->success = false;
+        }
+
+        if (image->success) {
+            prefetch->images[prefetch->image_count++] = image;
+            image = NULL;
+        }
+
+        mutex_unlock(&prefetch->mutex);
+        if (image) error = "Failed to keep the delivered image.";
+    }
+
+    download_result_free(image);
+    prefetch_done(url, path, error, prefetch);
+}
+
+/* hands an image to the delivery of the set instead of writing it */
+static char* deliver_image_src(ImagePrefetch* prefetch, const char* src,
+    const char* output_dir, int image_counter) {
+    if (!shared_engine && !is_base64_image(src)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE,
+            "Image delivery requires image_utils_init().");
+        return NULL;
+    }
+
+    char* full_path = build_image_path(src, output_dir, image_counter);
+    if (!full_path) return NULL;
+
+    PrefetchImage* entry = create_prefetch_image(prefetch, src, full_path, image_counter);
+
+    if (!entry) {
+        html2tex_free(full_path);
+        return NULL;
+    }
+
+    mutex_lock(&prefetch->mutex);
+    prefetch->pending++;
+    mutex_unlock(&prefetch->mutex);
+
+    if (is_base64_image(src)) {
+        /* decoded here, but kept in the same allocator as images from the event loop */
+        const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+        const int decoded = stream_base64_image(src, &prefetch_sink, entry);
+
+        prefetch_delivered(src, full_path, decoded ? NULL : "Data URI decoding failed.", entry);
+        html2tex_allocator_leave(previous);
+
+        if (decoded) return full_path;
+        html2tex_free(full_path);
+        return NULL;
+    }
+
+    if (!html_download_engine_submit_sink(shared_engine, src, full_path,
+        &prefetch_sink, prefetch_delivered, entry)) {
+        mutex_lock(&prefetch->mutex);
+        prefetch->pending--;
+        mutex_unlock(&prefetch->mutex);
+
+        const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+        download_result_free(entry->image);
+        html2tex_free(entry);
+        html2tex_allocator_leave(previous);
+
+        html2tex_free(full_path);
+        return NULL;
+    }
+
+    return full_path;
+}
+
+/* remembers the path of a document URL, repeats then reuse it */
+static char* track_image_path(ImageStorage* store, const char* src, char* full_path) {
+    /* deduplication is best effort, the download itself succeeded */
+    if (full_path && store && !is_base64_image(src)
+        && image_storage_track_url(store, src, full_path) < 0)
+        html2tex_err_clear();
+
+    return full_path;
+}
+
+char* prefetch_image_src(ImagePrefetch* prefetch, ImageStorage** storage,
+    const char* src, const char* output_dir, int image_counter) {
+    ImageStorage* store = storage ? (*storage) : NULL;
+    /* data URIs are not hashed, a key the size of the image costs more than decoding it */
+    const char* known = is_base64_image(src) ? NULL : image_storage_reuse_url(store, src);
+
+    /* a repeated image shares the file of its first reference */
+    if (known) return html2tex_strdup(known);
+
+    ImageFetcher* fetcher = prefetch ? prefetch->fetcher : NULL;
+
+    /* memory and stream deliveries keep the image off the disk, lazy storage included */
+    if (prefetch && src && prefetch->delivery != IMAGE_DELIVERY_FILE)
+        return track_image_path(store, src,
+            deliver_image_src(prefetch, src, output_dir, image_counter));
+
+    /* data URIs decode faster than a round trip, lazy storage only records */
+    if (!prefetch || (!fetcher && !shared_engine) || !src || is_base64_image(src)
+        || (store && store->lazy_downloading))
+        return track_image_path(store, src,
+            fetch_image_src(fetcher, storage, src, output_dir, image_counter));
+
+    char* full_path = prepare_image_path(src, output_dir, image_counter);
+    if (!full_path) return NULL;
+
+    mutex_lock(&prefetch->mutex);
+    prefetch->pending++;
+    mutex_unlock(&prefetch->mutex);
+
+    /* the path is final now, the file appears once the set is joined */
+    const int submitted = fetcher
+        ? image_fetcher_submit(fetcher, src, full_path, prefetch_done, prefetch)
+        : html_download_engine_submit(shared_engine, src, full_path, prefetch_done, prefetch);
+
+    if (!submitted) {
+        mutex_lock(&prefetch->mutex);
+        prefetch->pending--;
+        mutex_unlock(&prefetch->mutex);
+
+        html2tex_free(full_path);
+        return NULL;
+    }
+
+    return track_image_path(store, src, full_path);
+}
+
+static int compare_images(const void* a, const void* b) {
+    const int left = (*(DownloadResult* const*)a)->sequence_number;
+    const int right = (*(DownloadResult* const*)b)->sequence_number;
+    return (left > right) - (left < right);
+}
+
+size_t image_prefetch_join(ImagePrefetch* prefetch, DownloadResult*** images, size_t* image_count) {
+    if (images) *images = NULL;
+    if (image_count) *image_count = 0;
+
+    if (!prefetch) return 0;
+    mutex_lock(&prefetch->mutex);
+
+    while (prefetch->pending)
+        cond_wait(&prefetch->settled, &prefetch->mutex);
+
+    const size_t failed = prefetch->failed;
+    mutex_unlock(&prefetch->mutex);
+
+    /* images complete in any order, the document references them in sequence */
+    if (prefetch->image_count > 1)
+        qsort(prefetch->images, prefetch->image_count, sizeof(DownloadResult*), compare_images);
+
+    if (images) {
+        *images = prefetch->images;
+        if (image_count) *image_count = prefetch->image_count;
+    }
+    else image_prefetch_free_images(prefetch->images, prefetch->image_count);
+
+    cond_destroy(&prefetch->settled);
+    mutex_destroy(&prefetch->mutex);
+    html2tex_free(prefetch);
+    return failed;
+}
+
+void image_prefetch_free_images(DownloadResult** images, size_t image_count) {
+    if (!images) return;
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+
+    for (size_t i = 0; i < image_count; i++)
+        download_result_free(images[i]);
+
+    html2tex_free(images);
+    html2tex_allocator_leave(previous);
+}
+
 int image_utils_init(void) {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
+    thread_once(&engine_once, init_engine_mutex);
+    mutex_lock(&engine_mutex);
+
+    if (!shared_engine) {
+        HTMLDownloadOptions options;
+        memset(&options, 0, sizeof(options));
+
+        options.multiplex = 1;
+        options.cache = shared_cache;
+
+        /* conversions wait on their images, they go ahead of background downloads */
+        options.priority = HTML_PRIORITY_HIGH;
+        shared_engine = html_download_engine_create(&options);
+
+        if (!shared_engine) {
+            mutex_unlock(&engine_mutex);
+            return -1;
+        }
+    }
+
+    engine_users++;
+    mutex_unlock(&engine_mutex);
     return 0;
 }
 
 void image_utils_cleanup(void) {
-    curl_global_cleanup();
+    HTMLDownloadEngine* retired = NULL;
+    thread_once(&engine_once, init_engine_mutex);
+    mutex_lock(&engine_mutex);
+
+    /* the last user stops the event loop and drops the pooled connections */
+    if (engine_users && --engine_users == 0) {
+        retired = shared_engine;
+        shared_engine = NULL;
+    }
+
+    mutex_unlock(&engine_mutex);
+    html_download_engine_destroy(retired);
+
+    /* the next process starts from what this conversion learned */
+    if (retired) {
+        mutex_lock(&engine_mutex);
+        html_image_cache_flush(shared_cache);
+        mutex_unlock(&engine_mutex);
+    }
+}
+
+int image_utils_set_cache(const char* dir, unsigned long long max_bytes) {
+    html2tex_err_clear();
+    thread_once(&engine_once, init_engine_mutex);
+    mutex_lock(&engine_mutex);
+
+    if (shared_engine) {
+        mutex_unlock(&engine_mutex);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image cache cannot change while images are downloading.");
+        return -1;
+    }
+
+    HTMLImageCache* cache = NULL;
+
+    if (dir) {
+        cache = html_image_cache_open(dir, max_bytes);
+
+        if (!cache) {
+            mutex_unlock(&engine_mutex);
+            return -1;
+        }
+    }
+
+    html_image_cache_close(shared_cache);
+    shared_cache = cache;
+
+    mutex_unlock(&engine_mutex);
+    return 0;
 }
\ No newline at end of file
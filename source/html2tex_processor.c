@@ -1,6 +1,7 @@
 #include "html2tex.h"
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #ifndef MAX_ALLOWED_TAG_LENGTH
 #define MAX_ALLOWED_TAG_LENGTH 7
@@ -307,7 +308,7 @@ int finish_table(LaTeXConverter* converter, const HTMLNode* node, const CSSPrope
     if (strcmp(node->tag, "table") != 0)
         return 0;
 
-    const char* table_id = get_attribute(node->attributes, "id");
+    const char* table_id = get_hot_attribute(node, HTML_ATTR_ID);
     if (table_id && table_id[0] != '\0') end_table(converter, table_id);
     else {
         char table_label[64];
@@ -331,16 +332,16 @@ int convert_caption(LaTeXConverter* converter, const HTMLNode* node, const CSSPr
 
     if (converter->state.in_table) {
         if (converter->state.table_caption) {
-            free(converter->state.table_caption);
+            html2tex_free(converter->state.table_caption);
             converter->state.table_caption = NULL;
         }
 
         char* raw_caption = extract_caption_text(node);
-        const char* style_attr = get_attribute(node->attributes, "style");
 
         if (raw_caption) {
-            CSSProperties* caption_css = NULL;
-            if (style_attr) caption_css = parse_css_style(style_attr);
+            CSSProperties* caption_css = css_stylesheet_cascade(
+                converter->stylesheet, node, converter->ancestors,
+                converter->match_context);
 
             if (caption_css) {
                 /* calculate maximum required buffer size */
@@ -366,7 +367,7 @@ int convert_caption(LaTeXConverter* converter, const HTMLNode* node, const CSSPr
 
                 /* allocate exact size needed */
                 size_t buffer_size = color_prefix_len + bold_len + raw_len + closing_len + 1;
-                char* formatted_caption = (char*)malloc(buffer_size);
+                char* formatted_caption = (char*)html2tex_malloc(buffer_size);
 
                 if (formatted_caption) {
                     char* ptr = formatted_caption;
@@ -417,7 +418,7 @@ int convert_caption(LaTeXConverter* converter, const HTMLNode* node, const CSSPr
                     converter->state.table_caption = formatted_caption;
                 }
 
-                if (hex_color) free(hex_color);
+                if (hex_color) html2tex_free(hex_color);
                 css_properties_destroy(caption_css);
             }
             else
@@ -460,8 +461,7 @@ int convert_table_cell(LaTeXConverter* converter, const HTMLNode* node, const CS
     int colspan = 1;
     
     if (node->attributes != NULL) {
-        const char* colspan_attr = get_attribute(node->attributes, 
-            "colspan");
+        const char* colspan_attr = get_hot_attribute(node, HTML_ATTR_COLSPAN);
 
         if (colspan_attr) {
             colspan = atoi(colspan_attr);
@@ -492,8 +492,7 @@ int finish_table_cell(LaTeXConverter* converter, const HTMLNode* node, const CSS
     int colspan = 1;
 
     if (node->attributes != NULL) {
-        const char* colspan_attr = get_attribute(node->attributes, 
-            "colspan");
+        const char* colspan_attr = get_hot_attribute(node, HTML_ATTR_COLSPAN);
 
         if (colspan_attr) {
             colspan = atoi(colspan_attr);
@@ -717,7 +716,7 @@ int finish_inline_underline(LaTeXConverter* converter, const HTMLNode* node, con
 }
 
 int convert_inline_anchor(LaTeXConverter* converter, const HTMLNode* node, const CSSProperties* props) {
-    const char* href = get_attribute(node->attributes, "href");
+    const char* href = get_hot_attribute(node, HTML_ATTR_HREF);
 
     /* apply CSS properties for this element */
     if (props && node->tag)
@@ -734,7 +733,7 @@ int convert_inline_anchor(LaTeXConverter* converter, const HTMLNode* node, const
 }
 
 int finish_inline_anchor(LaTeXConverter* converter, const HTMLNode* node, const CSSProperties* props) {
-    const char* href = get_attribute(node->attributes, "href");
+    const char* href = get_hot_attribute(node, HTML_ATTR_HREF);
 
     if (href) {
         append_string(converter, "}");
@@ -861,23 +860,22 @@ int finish_inline_span(LaTeXConverter* converter, const HTMLNode* node, const CS
 int convert_inline_image(LaTeXConverter* converter, const HTMLNode* node, const CSSProperties* props) {
     if (strcmp(node->tag, "img") != 0)
         return 0;
-    if (is_inside_table(node)) {
-        const char* src = get_attribute(node->attributes, "src");
-        const char* style_attr = get_attribute(node->attributes, "style");
-        const char* width_attr = get_attribute(node->attributes, "width");
-        const char* height_attr = get_attribute(node->attributes, "height");
+    if (is_inside_context(converter->ancestors, node, HTML_CONTEXT_TABLE) > 0) {
+        const char* src = get_hot_attribute(node, HTML_ATTR_SRC);
+        const char* width_attr = get_hot_attribute(node, HTML_ATTR_WIDTH);
+        const char* height_attr = get_hot_attribute(node, HTML_ATTR_HEIGHT);
 
         if (src) {
             char* image_path = NULL;
 
             if (converter->download_images && converter->image_output_dir) {
                 converter->image_counter++;
-                image_path = download_image_src(&converter->store, 
-                    src, converter->image_output_dir,
+                image_path = prefetch_image_src(converter->prefetch,
+                    &converter->store, src, converter->image_output_dir,
                     converter->image_counter);
             }
 
-            if (!image_path) image_path = strdup(src);
+            if (!image_path) image_path = html2tex_strdup(src);
             append_string(converter, "\\includegraphics");
 
             int width_pt = 0;
@@ -886,17 +884,17 @@ int convert_inline_image(LaTeXConverter* converter, const HTMLNode* node, const
             if (width_attr) width_pt = css_length_to_pt(width_attr);
             if (height_attr) height_pt = css_length_to_pt(height_attr);
 
-            if (style_attr) {
-                CSSProperties* img_css = parse_css_style(style_attr);
+            CSSProperties* img_css = css_stylesheet_cascade(
+                converter->stylesheet, node, converter->ancestors,
+                converter->match_context);
 
-                if (img_css) {
-                    const char* width = css_properties_get(img_css, "width");
-                    const char* height = css_properties_get(img_css, "height");
+            if (img_css) {
+                const char* width = css_properties_get(img_css, "width");
+                const char* height = css_properties_get(img_css, "height");
 
-                    if (width) width_pt = css_length_to_pt(width);
-                    if (height) height_pt = css_length_to_pt(height);
-                    css_properties_destroy(img_css);
-                }
+                if (width) width_pt = css_length_to_pt(width);
+                if (height) height_pt = css_length_to_pt(height);
+                css_properties_destroy(img_css);
             }
 
             if (width_pt > 0 || height_pt > 0) {
@@ -925,37 +923,37 @@ int convert_inline_image(LaTeXConverter* converter, const HTMLNode* node, const
             else
                 escape_latex(converter, image_path);
             append_string(converter, "}");
-            free(image_path);
+            html2tex_free(image_path);
         }
     }
     else {
         converter->image_counter++;
         converter->state.image_internal_counter++;
-        const char* src = get_attribute(node->attributes, "src");
-        const char* alt = get_attribute(node->attributes, "alt");
+        const char* src = get_hot_attribute(node, HTML_ATTR_SRC);
+        const char* alt = get_hot_attribute(node, HTML_ATTR_ALT);
 
-        const char* width_attr = get_attribute(node->attributes, "width");
-        const char* height_attr = get_attribute(node->attributes, "height");
-        const char* image_id_attr = get_attribute(node->attributes, "id");
+        const char* width_attr = get_hot_attribute(node, HTML_ATTR_WIDTH);
+        const char* height_attr = get_hot_attribute(node, HTML_ATTR_HEIGHT);
+        const char* image_id_attr = get_hot_attribute(node, HTML_ATTR_ID);
 
         if (src) {
             char* image_path = NULL;
 
             if (converter->download_images
                 && converter->image_output_dir)
-                image_path = download_image_src(
+                image_path = prefetch_image_src(converter->prefetch,
                     &converter->store, src, 
                     converter->image_output_dir,
                     converter->image_counter);
 
             if (!image_path) {
                 if (is_base64_image(src) && converter->download_images && converter->image_output_dir)
-                    image_path = download_image_src(
+                    image_path = prefetch_image_src(converter->prefetch,
                         &converter->store, src, 
                         converter->image_output_dir,
                         converter->image_counter);
 
-                if (!image_path) image_path = strdup(src);
+                if (!image_path) image_path = html2tex_strdup(src);
             }
 
             append_string(converter, "\n\n\\begin{figure}[h]\n");
@@ -996,6 +994,7 @@ int convert_inline_image(LaTeXConverter* converter, const HTMLNode* node, const
             else
                 escape_latex(converter, image_path);
             append_string(converter, "}\n");
+            html2tex_free(image_path);
 
             if (alt && alt[0] != '\0') {
                 append_string(converter, "\n");
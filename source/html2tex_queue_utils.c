@@ -1,6 +1,7 @@
 #include <stdlib.h>
 #include "html2tex_queue.h"
 #include "html2tex_errors.h"
+#include "html2tex_alloc.h"
 
 int queue_enqueue(Queue** front, Queue** rear, void* data) {
     /* clear the error context */
@@ -12,7 +13,7 @@ int queue_enqueue(Queue** front, Queue** rear, void* data) {
         return 0;
     }
 
-    Queue* node = (Queue*)malloc(sizeof(Queue));
+    Queue* node = (Queue*)html2tex_malloc(sizeof(Queue));
     
     if (!node) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -56,7 +57,7 @@ void* queue_dequeue(Queue** front, Queue** rear) {
     if (!*front)
         *rear = NULL;
 
-    free(node);
+    html2tex_free(node);
     return data;
 }
 
@@ -107,7 +108,7 @@ void queue_destroy(Queue** front, Queue** rear, void (*cleanup)(void*)) {
         if (cleanup && current->data)
             cleanup(current->data);
 
-        free(current);
+        html2tex_free(current);
         current = next;
     }
 
@@ -1,5 +1,6 @@
 #include "html2tex_stack.h"
 #include "html2tex_errors.h"
+#include "html2tex_alloc.h"
 #include <stdlib.h>
 
 int stack_push(Stack** top, void* data) {
@@ -12,7 +13,7 @@ int stack_push(Stack** top, void* data) {
         return 0;
     }
 
-    Stack* node = (Stack*)malloc(sizeof(Stack));
+    Stack* node = (Stack*)html2tex_malloc(sizeof(Stack));
 
     if (!node) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -53,7 +54,7 @@ void** stack_to_array(Stack** top, size_t* count) {
     if (!element_count) return NULL;
     
     /* allocate array with exact size */
-    void** array = (void**)malloc(element_count * sizeof(void*));
+    void** array = (void**)html2tex_malloc(element_count * sizeof(void*));
 
     if (!array) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -103,7 +104,7 @@ void* stack_pop(Stack** top) {
 
     void* data = node->data;
     *top = node->next;
-    free(node);
+    html2tex_free(node);
 
     return data;
 }
@@ -142,7 +143,7 @@ void stack_destroy(Stack** top, void (*cleanup)(void*)) {
         if (cleanup && current->data)
             cleanup(current->data);
 
-        free(current);
+        html2tex_free(current);
         current = next;
     }
 
@@ -1,17 +1,27 @@
 #include "string_buffer.h"
 #include "html2tex_errors.h"
+#include "html2tex_alloc.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
 #include <ctype.h>
 #include <limits.h>
+#include <stdint.h>
 
 #define STRING_BUFFER_MIN_CAPACITY 64
 #define STRING_BUFFER_GROWTH_FACTOR 2
 #define STRING_BUFFER_MIN_GROW 32
 #define STRING_BUFFER_MAX_CAPACITY (SIZE_MAX / 2)
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#define STRING_BUFFER_SSE2 1
+#endif
+
 static int string_buffer_grow(StringBuffer* buf, size_t min_capacity) {
     /* clear previous errors */
     html2tex_err_clear();
@@ -83,7 +93,7 @@ static int string_buffer_grow(StringBuffer* buf, size_t min_capacity) {
         new_capacity = min_capacity;
     }
 
-    char* new_data = (char*)realloc(buf->data, new_capacity);
+    char* new_data = (char*)html2tex_realloc(buf->data, new_capacity);
     if (!new_data) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to reallocate string buffer to %zu bytes.", new_capacity);
@@ -101,7 +111,7 @@ StringBuffer* string_buffer_create(size_t initial_capacity) {
     html2tex_err_clear();
 
     /* allocate buffer structure */
-    StringBuffer* buf = (StringBuffer*)calloc(1, sizeof(StringBuffer));
+    StringBuffer* buf = (StringBuffer*)html2tex_calloc(1, sizeof(StringBuffer));
     if (!buf) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate %zu bytes for StringBuffer structure.",
@@ -114,19 +124,19 @@ StringBuffer* string_buffer_create(size_t initial_capacity) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_BUF_OVERFLOW,
             "Initial capacity %zu exceeds maximum %zu.",
             initial_capacity, STRING_BUFFER_MAX_CAPACITY);
-        free(buf);
+        html2tex_free(buf);
         return NULL;
     }
 
     buf->capacity = (initial_capacity > 0) ? initial_capacity : STRING_BUFFER_MIN_CAPACITY;
 
     /* allocate data buffer */
-    buf->data = (char*)malloc(buf->capacity);
+    buf->data = (char*)html2tex_malloc(buf->capacity);
     if (!buf->data) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate %zu bytes for string buffer data.",
             buf->capacity);
-        free(buf);
+        html2tex_free(buf);
         return NULL;
     }
 
@@ -149,12 +159,12 @@ void string_buffer_destroy(StringBuffer* buf) {
 
     /* free data if present */
     if (buf->data) {
-        free(buf->data);
+        html2tex_free(buf->data);
         buf->data = NULL;
     }
 
     /* free structure */
-    free(buf);
+    html2tex_free(buf);
 }
 
 int string_buffer_clear(StringBuffer* buf) {
@@ -198,7 +208,7 @@ char* string_buffer_detach(StringBuffer* buf) {
 
     /* handle empty buffer */
     if (buf->length == 0) {
-        char* empty_string = (char*)malloc(1);
+        char* empty_string = (char*)html2tex_malloc(1);
         if (!empty_string) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate empty string for detach.");
@@ -208,7 +218,7 @@ char* string_buffer_detach(StringBuffer* buf) {
 
         /* reset buffer */
         if (string_buffer_clear(buf) != 0) {
-            free(empty_string);
+            html2tex_free(empty_string);
             return NULL;
         }
 
@@ -216,7 +226,7 @@ char* string_buffer_detach(StringBuffer* buf) {
     }
 
     /* shrink buffer to exact size */
-    char* result = (char*)realloc(buf->data, buf->length + 1);
+    char* result = (char*)html2tex_realloc(buf->data, buf->length + 1);
     if (!result) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to reallocate buffer to %zu bytes for detach.",
@@ -226,7 +236,7 @@ char* string_buffer_detach(StringBuffer* buf) {
     }
 
     /* allocate new buffer for the structure */
-    buf->data = (char*)malloc(STRING_BUFFER_MIN_CAPACITY);
+    buf->data = (char*)html2tex_malloc(STRING_BUFFER_MIN_CAPACITY);
     if (!buf->data) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate new buffer after detach.");
@@ -393,6 +403,124 @@ int string_buffer_append_printf(StringBuffer* buf, const char* format, ...) {
     return written;
 }
 
+/* LaTeX special characters lookup table */
+static const unsigned char LATEX_ESCAPE_MAP[256] = {
+    ['\\'] = 1,['{'] = 2,['}'] = 3,['&'] = 4,
+    ['%'] = 5,['$'] = 6,['#'] = 7,['_'] = 8,
+    ['^'] = 9,['~'] = 10,['<'] = 11,['>'] = 12,
+    ['\n'] = 13,['['] = 14,[']'] = 15,['('] = 16,
+    [')'] = 17,['|'] = 18
+};
+
+static const char* const LATEX_ESCAPE_SEQ[] = {
+    NULL,
+    "\\textbackslash{}", "\\{", "\\}", "\\&",
+    "\\%", "\\$", "\\#", "\\_", "\\^{}",
+    "\\~{}", "\\textless{}", "\\textgreater{}",
+    "\\\\", "\\lbrack{}", "\\rbrack{}",
+    "\\lparen{}", "\\rparen{}", "\\textbar{}"
+};
+
+#ifdef STRING_BUFFER_SSE2
+/* index of the lowest set bit, mask must be non-zero */
+static inline unsigned int lowest_bit(unsigned int mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned int)index;
+#else
+    return (unsigned int)__builtin_ctz(mask);
+#endif
+}
+#endif
+
+/* skips bytes copied verbatim: ASCII outside the LaTeX special set */
+static const unsigned char* latex_plain_run(const unsigned char* p, const unsigned char* end) {
+#ifdef STRING_BUFFER_SSE2
+    /* sixteen bytes at a time, the sign bit already flags non-ASCII */
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i lparen = _mm_set1_epi8('(');
+    const __m128i rparen = _mm_set1_epi8(')');
+    const __m128i less = _mm_set1_epi8('<');
+    const __m128i greater = _mm_set1_epi8('>');
+    const __m128i hash_low = _mm_set1_epi8('#' - 1);
+    const __m128i amp_high = _mm_set1_epi8('&' + 1);
+    const __m128i bracket_low = _mm_set1_epi8('[' - 1);
+    const __m128i underscore_high = _mm_set1_epi8('_' + 1);
+    const __m128i brace_low = _mm_set1_epi8('{' - 1);
+    const __m128i tilde_high = _mm_set1_epi8('~' + 1);
+
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+
+        /* # $ % &, [ \ ] ^ _ and { | } ~ are contiguous ranges */
+        __m128i special = _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi8(v, hash_low), _mm_cmplt_epi8(v, amp_high)),
+            _mm_and_si128(_mm_cmpgt_epi8(v, bracket_low), _mm_cmplt_epi8(v, underscore_high)));
+
+        special = _mm_or_si128(special,
+            _mm_and_si128(_mm_cmpgt_epi8(v, brace_low), _mm_cmplt_epi8(v, tilde_high)));
+
+        special = _mm_or_si128(special, _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, lparen)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, rparen), _mm_or_si128(
+                _mm_cmpeq_epi8(v, less), _mm_cmpeq_epi8(v, greater)))));
+
+        unsigned int mask = (unsigned int)(_mm_movemask_epi8(special)
+            | _mm_movemask_epi8(v));
+
+        if (mask) return p + lowest_bit(mask);
+        p += 16;
+    }
+#endif
+
+    while (p < end && *p < 0x80 && !LATEX_ESCAPE_MAP[*p])
+        p++;
+
+    return p;
+}
+
+/* decodes one well-formed UTF-8 sequence, returns its length or 0 when invalid */
+static size_t utf8_decode(const unsigned char* p, const unsigned char* end,
+    unsigned long* code_point) {
+    size_t avail = (size_t)(end - p);
+    unsigned char c = p[0];
+
+    if (c >= 0xC2 && c <= 0xDF) {
+        if (avail < 2 || (p[1] & 0xC0) != 0x80) return 0;
+        *code_point = ((unsigned long)(c & 0x1F) << 6) | (p[1] & 0x3F);
+        return 2;
+    }
+
+    if (c >= 0xE0 && c <= 0xEF) {
+        if (avail < 3 || (p[1] & 0xC0) != 0x80 || (p[2] & 0xC0) != 0x80)
+            return 0;
+
+        *code_point = ((unsigned long)(c & 0x0F) << 12)
+            | ((unsigned long)(p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+
+        /* reject overlong forms and surrogates */
+        if (*code_point < 0x800 || (*code_point >= 0xD800 && *code_point <= 0xDFFF))
+            return 0;
+        return 3;
+    }
+
+    if (c >= 0xF0 && c <= 0xF4) {
+        if (avail < 4 || (p[1] & 0xC0) != 0x80 ||
+            (p[2] & 0xC0) != 0x80 || (p[3] & 0xC0) != 0x80)
+            return 0;
+
+        *code_point = ((unsigned long)(c & 0x07) << 18)
+            | ((unsigned long)(p[1] & 0x3F) << 12)
+            | ((unsigned long)(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+
+        if (*code_point < 0x10000 || *code_point > 0x10FFFF) return 0;
+        return 4;
+    }
+
+    return 0;
+}
+
 int string_buffer_append_latex(StringBuffer* buf, const char* str) {
     /* clear previous errors */
     html2tex_err_clear();
@@ -413,88 +541,46 @@ int string_buffer_append_latex(StringBuffer* buf, const char* str) {
         return -1;
     }
 
-    /* LaTeX special characters lookup table */
-    static const unsigned char escape_map[256] = {
-        ['\\'] = 1,['{'] = 2,['}'] = 3,['&'] = 4,
-        ['%'] = 5,['$'] = 6,['#'] = 7,['_'] = 8,
-        ['^'] = 9,['~'] = 10,['<'] = 11,['>'] = 12,
-        ['\n'] = 13,['['] = 14,[']'] = 15,['('] = 16,
-        [')'] = 17,['|'] = 18
-    };
+    const unsigned char* p = (const unsigned char*)str;
+    const unsigned char* const end = p + strlen(str);
 
-    static const char* const escape_seq[] = {
-        NULL,
-        "\\textbackslash{}", "\\{", "\\}", "\\&",
-        "\\%", "\\$", "\\#", "\\_", "\\^{}",
-        "\\~{}", "\\textless{}", "\\textgreater{}",
-        "\\\\", "\\lbrack{}", "\\rbrack{}",
-        "\\lparen{}", "\\rparen{}", "\\textbar{}"
-    };
-
-    const char* p = str;
-    const char* start = p;
-    size_t segment_count = 0;
-
-    /* calculate required capacity */
-    size_t extra_chars = 0;
-
-    while (*p) {
-        unsigned char c = (unsigned char)*p;
-        unsigned char type = escape_map[c];
-
-        if (type != 0) {
-            const char* seq = escape_seq[type];
-            extra_chars += strlen(seq) - 1;
-        }
-
-        p++;
-    }
+    /* plain text dominates, escapes grow the buffer as needed */
+    if (string_buffer_ensure_capacity(buf, buf->length + (size_t)(end - p) + 1) != 0)
+        return -1;
 
-    /* reset pointer */
-    p = str;
+    while (p < end) {
+        /* copy the plain run in one block */
+        const unsigned char* run = p;
+        p = latex_plain_run(p, end);
 
-    /* ensure capacity for escaped string */
-    size_t original_len = strlen(str);
-    size_t total_len = original_len + extra_chars;
+        if (p > run && string_buffer_append(buf, (const char*)run, (size_t)(p - run)) != 0)
+            return -1;
 
-    if (string_buffer_ensure_capacity(buf, buf->length + total_len + 1) != 0)
-        return -1;
+        if (p == end) break;
+        const char* seq = NULL;
+        size_t consumed = 1;
 
-    /* process and escape */
-    while (*p) {
-        unsigned char c = (unsigned char)*p;
-        unsigned char type = escape_map[c];
+        if (*p < 0x80)
+            seq = LATEX_ESCAPE_SEQ[LATEX_ESCAPE_MAP[*p]];
+        else {
+            unsigned long code_point = 0;
+            consumed = utf8_decode(p, end, &code_point);
 
-        if (type == 0) {
-            p++;
-            continue;
+            if (consumed)
+                seq = latex_unicode_command(code_point);
+            else
+                consumed = 1;
         }
 
-        /* copy normal characters before escape sequence */
-        if (p > start) {
-            size_t normal_len = p - start;
-
-            if (string_buffer_append(buf, start, normal_len) != 0)
+        /* unmapped characters and invalid bytes pass through unchanged */
+        if (!seq) {
+            if (string_buffer_append(buf, (const char*)p, consumed) != 0)
                 return -1;
         }
-
-        /* append escape sequence */
-        const char* seq = escape_seq[type];
-
-        if (string_buffer_append(buf, seq, 0) != 0)
+        else if (*seq && string_buffer_append(buf, seq, 0) != 0)
             return -1;
 
-        p++;
-        start = p;
-        segment_count++;
-    }
-
-    /* copy any remaining characters */
-    if (p > start) {
-        size_t remaining_len = p - start;
-
-        if (string_buffer_append(buf, start, remaining_len) != 0)
-            return -1;
+        p += consumed;
     }
 
     return 0;
@@ -630,7 +716,7 @@ int string_buffer_shrink_to_fit(StringBuffer* buf) {
         return 0;
 
     /* perform reallocation */
-    char* new_data = (char*)realloc(buf->data, optimal_capacity);
+    char* new_data = (char*)html2tex_realloc(buf->data, optimal_capacity);
 
     if (!new_data) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -0,0 +1,1374 @@
+#include "html2tex.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+static inline int is_selector_ident(char c) {
+    unsigned char u = (unsigned char)c;
+    return isalnum(u) || c == '-' || c == '_' || u >= 0x80;
+}
+
+/* FNV-1a over a length-delimited key */
+static size_t rule_map_hash(const char* key, size_t len) {
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < len; i++) {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+
+    return (size_t)hash;
+}
+
+static CSSRuleBucket* rule_map_find(const CSSRuleMap* map, const char* key, size_t len) {
+    if (!map->slots) return NULL;
+    size_t mask = map->capacity - 1;
+    size_t slot = rule_map_hash(key, len) & mask;
+
+    while (map->slots[slot].key) {
+        const char* existing = map->slots[slot].key;
+        if (strncmp(existing, key, len) == 0 && existing[len] == '\0')
+            return &map->slots[slot];
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static int rule_map_grow(CSSRuleMap* map) {
+    size_t capacity = map->capacity ? map->capacity * 2 : CSS_STYLESHEET_MIN_CAPACITY;
+    CSSRuleBucket* slots = (CSSRuleBucket*)html2tex_calloc(capacity, sizeof(CSSRuleBucket));
+
+    if (!slots) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate %zu stylesheet rule buckets.", capacity);
+        return 0;
+    }
+
+    /* rehash the existing buckets, entries move without copying */
+    for (size_t i = 0; i < map->capacity; i++) {
+        if (!map->slots[i].key) continue;
+        size_t slot = rule_map_hash(map->slots[i].key,
+            strlen(map->slots[i].key)) & (capacity - 1);
+
+        while (slots[slot].key)
+            slot = (slot + 1) & (capacity - 1);
+        slots[slot] = map->slots[i];
+    }
+
+    html2tex_free(map->slots);
+    map->slots = slots;
+    map->capacity = capacity;
+    return 1;
+}
+
+static void rule_map_cleanup(CSSRuleMap* map) {
+    for (size_t i = 0; i < map->capacity; i++) {
+        html2tex_free(map->slots[i].key);
+        html2tex_free(map->slots[i].rules);
+    }
+
+    html2tex_free(map->slots);
+    map->slots = NULL;
+    map->capacity = 0;
+    map->used = 0;
+}
+
+static int rule_list_push(CSSRule*** rules, size_t* count, size_t* capacity, CSSRule* rule) {
+    if (*count == *capacity) {
+        size_t new_capacity = *capacity ? *capacity * 2 : CSS_STYLESHEET_MIN_CAPACITY;
+        CSSRule** grown = (CSSRule**)html2tex_realloc(*rules, new_capacity * sizeof(CSSRule*));
+
+        if (!grown) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to grow stylesheet rule list to %zu entries.", new_capacity);
+            return 0;
+        }
+
+        *rules = grown;
+        *capacity = new_capacity;
+    }
+
+    (*rules)[(*count)++] = rule;
+    return 1;
+}
+
+static int rule_map_add(CSSRuleMap* map, const char* key, CSSRule* rule) {
+    size_t len = strlen(key);
+    CSSRuleBucket* bucket = rule_map_find(map, key, len);
+
+    if (!bucket) {
+        /* keep the load factor under 3/4 */
+        if ((map->used + 1) * 4 > map->capacity * 3 && !rule_map_grow(map))
+            return 0;
+
+        size_t slot = rule_map_hash(key, len) & (map->capacity - 1);
+        while (map->slots[slot].key)
+            slot = (slot + 1) & (map->capacity - 1);
+
+        bucket = &map->slots[slot];
+        bucket->key = html2tex_strdup(key);
+
+        if (!bucket->key) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to duplicate stylesheet bucket key.");
+            return 0;
+        }
+
+        map->used++;
+    }
+
+    return rule_list_push(&bucket->rules, &bucket->count, &bucket->capacity, rule);
+}
+
+static void compound_cleanup(CSSCompound* compound) {
+    html2tex_free(compound->tag);
+    html2tex_free(compound->id);
+
+    for (size_t i = 0; i < compound->class_count; i++)
+        html2tex_free(compound->classes[i]);
+
+    for (size_t i = 0; i < compound->attribute_count; i++) {
+        html2tex_free(compound->attributes[i].key);
+        html2tex_free(compound->attributes[i].value);
+    }
+
+    html2tex_free(compound->classes);
+    html2tex_free(compound->attributes);
+    html2tex_free(compound->positions);
+}
+
+static void rule_destroy(CSSRule* rule) {
+    if (!rule) return;
+
+    for (size_t i = 0; i < rule->compound_count; i++)
+        compound_cleanup(&rule->compounds[i]);
+
+    html2tex_free(rule->compounds);
+    if (rule->declarations)
+        css_properties_destroy(rule->declarations);
+    html2tex_free(rule);
+}
+
+/* selector text being compiled, the first failure keeps its reason and offset */
+typedef struct {
+    const char* start;
+    const char* p;
+    const char* end;
+    const char* reason;
+    size_t offset;
+} SelectorCursor;
+
+static void selector_cursor_init(SelectorCursor* cursor, const char* start, const char* end) {
+    cursor->start = start;
+    cursor->p = start;
+    cursor->end = end;
+    cursor->reason = NULL;
+    cursor->offset = 0;
+}
+
+static int selector_fail(SelectorCursor* cursor, const char* reason) {
+    if (!cursor->reason) {
+        cursor->reason = reason;
+        cursor->offset = (size_t)(cursor->p - cursor->start);
+    }
+
+    return 0;
+}
+
+static inline char selector_peek(const SelectorCursor* cursor) {
+    return cursor->p < cursor->end ? *cursor->p : '\0';
+}
+
+static int selector_skip_spaces(SelectorCursor* cursor) {
+    const char* start = cursor->p;
+
+    while (cursor->p < cursor->end && isspace((unsigned char)*cursor->p))
+        cursor->p++;
+
+    return cursor->p > start;
+}
+
+static char* selector_copy(const char* start, size_t len, int lower) {
+    char* copy = (char*)html2tex_malloc(len + 1);
+    if (!copy) return NULL;
+
+    for (size_t i = 0; i < len; i++)
+        copy[i] = lower ? (char)tolower((unsigned char)start[i]) : start[i];
+
+    copy[len] = '\0';
+    return copy;
+}
+
+/* Reads an identifier; returns 1 on success, 0 for a syntax error, -1 when out of memory. */
+static int selector_ident(SelectorCursor* cursor, char** out, int lower) {
+    const char* start = cursor->p;
+
+    while (cursor->p < cursor->end && is_selector_ident(*cursor->p))
+        cursor->p++;
+
+    if (cursor->p == start)
+        return selector_fail(cursor, "expected identifier");
+
+    *out = selector_copy(start, (size_t)(cursor->p - start), lower);
+    return *out ? 1 : -1;
+}
+
+static int compound_add_class(CSSCompound* compound, char* ident) {
+    char** classes = (char**)html2tex_realloc(compound->classes,
+        (compound->class_count + 1) * sizeof(char*));
+
+    if (!classes) {
+        html2tex_free(ident);
+        return -1;
+    }
+
+    compound->classes = classes;
+    compound->classes[compound->class_count++] = ident;
+    return 1;
+}
+
+/* Parses the attribute test after its opening bracket. */
+static int parse_attribute(SelectorCursor* cursor, CSSCompound* compound) {
+    CSSAttributeTest test = { NULL, NULL, CSS_ATTR_EXISTS };
+    int status;
+
+    selector_skip_spaces(cursor);
+    if ((status = selector_ident(cursor, &test.key, 1)) <= 0) return status;
+    selector_skip_spaces(cursor);
+
+    char c = selector_peek(cursor);
+
+    if (c == '\0') {
+        status = selector_fail(cursor, "expected ']'");
+        goto failure;
+    }
+
+    if (c != ']') {
+        switch (c) {
+        case '=': test.op = CSS_ATTR_EQUALS; break;
+        case '~': test.op = CSS_ATTR_INCLUDES; break;
+        case '^': test.op = CSS_ATTR_PREFIX; break;
+        case '$': test.op = CSS_ATTR_SUFFIX; break;
+        case '*': test.op = CSS_ATTR_SUBSTRING; break;
+        default:
+            status = selector_fail(cursor, "unsupported attribute operator");
+            goto failure;
+        }
+
+        cursor->p++;
+
+        if (test.op != CSS_ATTR_EQUALS) {
+            if (selector_peek(cursor) != '=') {
+                status = selector_fail(cursor, "expected '='");
+                goto failure;
+            }
+
+            cursor->p++;
+        }
+
+        selector_skip_spaces(cursor);
+        char quote = selector_peek(cursor);
+
+        if (quote == '"' || quote == '\'') {
+            const char* start = ++cursor->p;
+            while (cursor->p < cursor->end && *cursor->p != quote) cursor->p++;
+
+            if (cursor->p >= cursor->end) {
+                status = selector_fail(cursor, "unterminated string");
+                goto failure;
+            }
+
+            test.value = selector_copy(start, (size_t)(cursor->p++ - start), 0);
+            status = test.value ? 1 : -1;
+        }
+        else
+            status = selector_ident(cursor, &test.value, 0);
+
+        if (status <= 0) goto failure;
+        selector_skip_spaces(cursor);
+    }
+
+    if (selector_peek(cursor) != ']') {
+        status = selector_fail(cursor, "expected ']'");
+        goto failure;
+    }
+
+    cursor->p++;
+
+    CSSAttributeTest* attributes = (CSSAttributeTest*)html2tex_realloc(compound->attributes,
+        (compound->attribute_count + 1) * sizeof(CSSAttributeTest));
+
+    if (!attributes) {
+        status = -1;
+        goto failure;
+    }
+
+    compound->attributes = attributes;
+    compound->attributes[compound->attribute_count++] = test;
+    return 1;
+
+failure:
+    html2tex_free(test.key);
+    html2tex_free(test.value);
+    return status;
+}
+
+/* a sign must be followed by digits, "2n+" is not "2n+1" */
+static int parse_nth_number(const char* digits, int* out) {
+    if (!digits[0] || ((digits[0] == '+' || digits[0] == '-') && !digits[1]))
+        return 0;
+
+    char* end = NULL;
+    long value = strtol(digits, &end, 10);
+
+    if (!end || *end != '\0' || value < INT_MIN || value > INT_MAX)
+        return 0;
+
+    *out = (int)value;
+    return 1;
+}
+
+/* Parses an+b, odd or even up to the closing parenthesis. */
+static int parse_nth_expression(SelectorCursor* cursor, CSSNthTest* test) {
+    const char* close = cursor->p;
+    while (close < cursor->end && *close != ')') close++;
+    if (close >= cursor->end) return selector_fail(cursor, "expected ')'");
+
+    /* compact the argument, an+b tolerates inner spaces */
+    char expr[32];
+    size_t len = 0;
+
+    for (const char* c = cursor->p; c < close; c++) {
+        if (isspace((unsigned char)*c)) continue;
+        if (len + 1 == sizeof(expr)) return selector_fail(cursor, "invalid :nth-child() argument");
+        expr[len++] = (char)tolower((unsigned char)*c);
+    }
+
+    expr[len] = '\0';
+    cursor->p = close + 1;
+    test->a = 0;
+    test->b = 0;
+
+    if (strcmp(expr, "odd") == 0) {
+        test->a = 2;
+        test->b = 1;
+        return 1;
+    }
+
+    if (strcmp(expr, "even") == 0) {
+        test->a = 2;
+        return 1;
+    }
+
+    char* n = strchr(expr, 'n');
+
+    if (!n)
+        return parse_nth_number(expr, &test->b) ? 1
+            : selector_fail(cursor, "invalid :nth-child() argument");
+
+    /* a bare "n", "+n" or "-n" has an implied coefficient of one */
+    char* rest = n + 1;
+    *n = '\0';
+
+    if (!expr[0] || strcmp(expr, "+") == 0) test->a = 1;
+    else if (strcmp(expr, "-") == 0) test->a = -1;
+    else if (!parse_nth_number(expr, &test->a))
+        return selector_fail(cursor, "invalid :nth-child() argument");
+
+    if (rest[0] && ((rest[0] != '+' && rest[0] != '-') || !parse_nth_number(rest, &test->b)))
+        return selector_fail(cursor, "invalid :nth-child() argument");
+
+    return 1;
+}
+
+/* Parses the pseudo-class after its colon, only the structural child positions are supported. */
+static int parse_pseudo_class(SelectorCursor* cursor, CSSCompound* compound) {
+    const char* name = cursor->p;
+    while (cursor->p < cursor->end && is_selector_ident(*cursor->p)) cursor->p++;
+
+    size_t len = (size_t)(cursor->p - name);
+    CSSNthTest test = { 0, 1, 0 };
+
+    if (len == 0)
+        return selector_fail(cursor, "expected identifier");
+
+    if (len == 11 && strncasecmp(name, "first-child", len) == 0)
+        test.from_end = 0;
+    else if (len == 10 && strncasecmp(name, "last-child", len) == 0)
+        test.from_end = 1;
+    else if ((len == 9 && strncasecmp(name, "nth-child", len) == 0) ||
+        (len == 14 && strncasecmp(name, "nth-last-child", len) == 0)) {
+        if (selector_peek(cursor) != '(')
+            return selector_fail(cursor, "expected '('");
+
+        cursor->p++;
+        if (!parse_nth_expression(cursor, &test)) return 0;
+        test.from_end = len == 14;
+    }
+    else
+        return selector_fail(cursor, "unsupported pseudo-class");
+
+    CSSNthTest* positions = (CSSNthTest*)html2tex_realloc(compound->positions,
+        (compound->position_count + 1) * sizeof(CSSNthTest));
+    if (!positions) return -1;
+
+    compound->positions = positions;
+    compound->positions[compound->position_count++] = test;
+    return 1;
+}
+
+/* Parses one compound; returns 1 on success, 0 for unsupported syntax, -1 when out of memory. */
+static int parse_compound(SelectorCursor* cursor, CSSCompound* compound) {
+    int empty = 1, status;
+
+    if (selector_peek(cursor) == '*') {
+        cursor->p++;
+        empty = 0;
+    }
+    else if (cursor->p < cursor->end && is_selector_ident(*cursor->p)) {
+        if ((status = selector_ident(cursor, &compound->tag, 1)) <= 0)
+            return status;
+        empty = 0;
+    }
+
+    for (;;) {
+        char c = selector_peek(cursor);
+        char* ident = NULL;
+
+        if (c == '#' || c == '.') {
+            cursor->p++;
+            if ((status = selector_ident(cursor, &ident, 0)) <= 0) return status;
+
+            if (c == '#') {
+                html2tex_free(compound->id);
+                compound->id = ident;
+            }
+            else
+                status = compound_add_class(compound, ident);
+        }
+        else if (c == '[') {
+            cursor->p++;
+            status = parse_attribute(cursor, compound);
+        }
+        else if (c == ':') {
+            cursor->p++;
+            status = parse_pseudo_class(cursor, compound);
+        }
+        else
+            break;
+
+        if (status <= 0) return status;
+        empty = 0;
+    }
+
+    return empty ? selector_fail(cursor, "expected selector") : 1;
+}
+
+/* Builds a rule from one selector of a list, stops before the next comma; compounds stored right-to-left. */
+static int parse_selector(SelectorCursor* cursor, CSSRule** out) {
+    *out = NULL;
+    CSSRule* rule = (CSSRule*)html2tex_calloc(1, sizeof(CSSRule));
+    if (!rule) return -1;
+
+    size_t capacity = 0;
+    unsigned int ids = 0, classes = 0, tags = 0;
+    char combinator = 0;
+
+    selector_skip_spaces(cursor);
+
+    for (;;) {
+        if (rule->compound_count == capacity) {
+            capacity = capacity ? capacity * 2 : 4;
+            CSSCompound* grown = (CSSCompound*)html2tex_realloc(rule->compounds,
+                capacity * sizeof(CSSCompound));
+
+            if (!grown) {
+                rule_destroy(rule);
+                return -1;
+            }
+
+            rule->compounds = grown;
+        }
+
+        CSSCompound* compound = &rule->compounds[rule->compound_count];
+        memset(compound, 0, sizeof(CSSCompound));
+        rule->compound_count++;
+
+        int status = parse_compound(cursor, compound);
+
+        if (status <= 0) {
+            rule_destroy(rule);
+            return status;
+        }
+
+        compound->combinator = combinator;
+        if (compound->id) ids++;
+        classes += (unsigned int)(compound->class_count +
+            compound->attribute_count + compound->position_count);
+        if (compound->tag) tags++;
+
+        /* read the combinator to the next compound */
+        int spaced = selector_skip_spaces(cursor);
+        char c = selector_peek(cursor);
+
+        if (c == '\0' || c == ',') break;
+
+        if (c == '>') {
+            combinator = '>';
+            cursor->p++;
+            selector_skip_spaces(cursor);
+        }
+        else if (spaced)
+            combinator = ' ';
+        else {
+            /* sibling combinators and anything else outside the grammar */
+            rule_destroy(rule);
+            return selector_fail(cursor, "unexpected character");
+        }
+    }
+
+    /* reverse so the subject comes first, each compound keeps the link to its left */
+    size_t count = rule->compound_count;
+
+    for (size_t i = 0; i < count / 2; i++) {
+        CSSCompound swap = rule->compounds[i];
+        rule->compounds[i] = rule->compounds[count - 1 - i];
+        rule->compounds[count - 1 - i] = swap;
+    }
+
+    if (ids > 255) ids = 255;
+    if (classes > 255) classes = 255;
+    if (tags > 255) tags = 255;
+
+    rule->specificity = (ids << 16) | (classes << 8) | tags;
+
+    /* collect ancestor keys, most selective first, for the traversal filter */
+    for (size_t i = 1; i < count && rule->ancestor_hash_count < CSS_MAX_ANCESTOR_HASHES; i++) {
+        const CSSCompound* ancestor = &rule->compounds[i];
+
+        if (ancestor->id)
+            rule->ancestor_hashes[rule->ancestor_hash_count++] =
+                ancestor_filter_hash('#', ancestor->id, strlen(ancestor->id));
+
+        for (size_t k = 0; k < ancestor->class_count &&
+            rule->ancestor_hash_count < CSS_MAX_ANCESTOR_HASHES; k++)
+            rule->ancestor_hashes[rule->ancestor_hash_count++] =
+                ancestor_filter_hash('.', ancestor->classes[k], strlen(ancestor->classes[k]));
+
+        if (ancestor->tag && rule->ancestor_hash_count < CSS_MAX_ANCESTOR_HASHES)
+            rule->ancestor_hashes[rule->ancestor_hash_count++] =
+                ancestor_filter_hash('t', ancestor->tag, strlen(ancestor->tag));
+    }
+    *out = rule;
+    return 1;
+}
+
+/* Moves past the next comma outside strings, brackets and parentheses. */
+static void skip_selector_alternative(SelectorCursor* cursor) {
+    int depth = 0;
+    char quote = 0;
+
+    for (; cursor->p < cursor->end; cursor->p++) {
+        char c = *cursor->p;
+
+        if (quote) {
+            if (c == quote) quote = 0;
+        }
+        else if (c == '"' || c == '\'') quote = c;
+        else if (c == '[' || c == '(') depth++;
+        else if ((c == ']' || c == ')') && depth > 0) depth--;
+        else if (c == ',' && depth == 0) {
+            cursor->p++;
+            break;
+        }
+    }
+
+    cursor->reason = NULL;
+}
+
+CSSSelector* css_selector_compile(const char* text) {
+    html2tex_err_clear();
+
+    if (!text) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL, "CSS selector text is NULL.");
+        return NULL;
+    }
+
+    CSSSelector* selector = (CSSSelector*)html2tex_calloc(1, sizeof(CSSSelector));
+
+    HTML2TEX__CHECK_NULL(selector, HTML2TEX_ERR_NOMEM,
+        "Failed to allocate %zu bytes for CSSSelector.", sizeof(CSSSelector));
+
+    SelectorCursor cursor;
+    size_t capacity = 0;
+    int status = 1;
+
+    selector_cursor_init(&cursor, text, text + strlen(text));
+    selector_skip_spaces(&cursor);
+
+    if (cursor.p >= cursor.end)
+        status = selector_fail(&cursor, "empty selector");
+
+    while (status > 0) {
+        CSSRule* rule = NULL;
+        status = parse_selector(&cursor, &rule);
+        if (status <= 0) break;
+
+        if (!rule_list_push(&selector->alternatives, &selector->count, &capacity, rule)) {
+            rule_destroy(rule);
+            css_selector_destroy(selector);
+            return NULL;
+        }
+
+        selector_skip_spaces(&cursor);
+        if (cursor.p >= cursor.end) break;
+
+        if (*cursor.p != ',')
+            status = selector_fail(&cursor, "expected ','");
+        else
+            cursor.p++;
+    }
+
+    if (status < 0) {
+        css_selector_destroy(selector);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate CSS selector '%s'.", text);
+        return NULL;
+    }
+
+    if (status == 0) {
+        css_selector_destroy(selector);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_CSS_SYNTAX,
+            "Invalid CSS selector '%s': %s at offset %zu.",
+            text, cursor.reason, cursor.offset);
+        return NULL;
+    }
+
+    return selector;
+}
+
+void css_selector_destroy(CSSSelector* selector) {
+    if (!selector) return;
+
+    for (size_t i = 0; i < selector->count; i++)
+        rule_destroy(selector->alternatives[i]);
+
+    html2tex_free(selector->alternatives);
+    html2tex_free(selector);
+}
+
+static int stylesheet_add_rule(CSSStylesheet* sheet, CSSRule* rule) {
+    rule->order = sheet->rule_count;
+
+    if (!rule_list_push(&sheet->rules, &sheet->rule_count,
+        &sheet->rule_capacity, rule))
+        return 0;
+
+    /* file the rule under the most selective key of its subject */
+    const CSSCompound* subject = &rule->compounds[0];
+
+    if (subject->id)
+        return rule_map_add(&sheet->ids, subject->id, rule);
+    if (subject->class_count > 0)
+        return rule_map_add(&sheet->classes, subject->classes[0], rule);
+    if (subject->tag)
+        return rule_map_add(&sheet->tags, subject->tag, rule);
+
+    return rule_list_push(&sheet->universal, &sheet->universal_count,
+        &sheet->universal_capacity, rule);
+}
+
+CSSStylesheet* css_stylesheet_create(void) {
+    html2tex_err_clear();
+    CSSStylesheet* sheet = (CSSStylesheet*)html2tex_calloc(1, sizeof(CSSStylesheet));
+
+    HTML2TEX__CHECK_NULL(sheet, HTML2TEX_ERR_NOMEM,
+        "Failed to allocate %zu bytes for CSSStylesheet.",
+        sizeof(CSSStylesheet));
+
+    return sheet;
+}
+
+void css_stylesheet_destroy(CSSStylesheet* sheet) {
+    if (!sheet) return;
+
+    for (size_t i = 0; i < sheet->rule_count; i++)
+        rule_destroy(sheet->rules[i]);
+
+    html2tex_free(sheet->rules);
+    html2tex_free(sheet->universal);
+
+    rule_map_cleanup(&sheet->ids);
+    rule_map_cleanup(&sheet->classes);
+    rule_map_cleanup(&sheet->tags);
+    html2tex_free(sheet);
+}
+
+/* Copies CSS text without comments. */
+static char* strip_css_comments(const char* css_text) {
+    size_t len = strlen(css_text);
+    char* clean = (char*)html2tex_malloc(len + 1);
+    if (!clean) return NULL;
+
+    const char* p = css_text;
+    char* out = clean;
+
+    while (*p) {
+        if (p[0] == '/' && p[1] == '*') {
+            const char* close = strstr(p + 2, "*/");
+            if (!close) break;
+
+            p = close + 2;
+            *out++ = ' ';
+            continue;
+        }
+
+        *out++ = *p++;
+    }
+
+    *out = '\0';
+    return clean;
+}
+
+/* Skips an at-rule statement or block, returns the position after it. */
+static const char* skip_at_rule(const char* p) {
+    while (*p && *p != ';' && *p != '{') p++;
+    if (*p == ';') return p + 1;
+    if (!*p) return p;
+
+    int depth = 0;
+
+    for (; *p; p++) {
+        if (*p == '{') depth++;
+        else if (*p == '}' && --depth == 0)
+            return p + 1;
+    }
+
+    return p;
+}
+
+int css_stylesheet_parse(CSSStylesheet* sheet, const char* css_text) {
+    html2tex_err_clear();
+
+    if (!sheet || !css_text) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Stylesheet or CSS text is NULL.");
+        return 0;
+    }
+
+    char* clean = strip_css_comments(css_text);
+
+    if (!clean) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to copy stylesheet text.");
+        return 0;
+    }
+
+    const char* p = clean;
+
+    while (*p) {
+        while (*p && isspace((unsigned char)*p)) p++;
+        if (!*p) break;
+
+        if (*p == '@') {
+            p = skip_at_rule(p);
+            continue;
+        }
+
+        const char* selector_start = p;
+        while (*p && *p != '{' && *p != '}') p++;
+
+        if (*p != '{') {
+            /* stray text or closing brace, resynchronize after it */
+            if (*p) p++;
+            continue;
+        }
+
+        const char* selector_end = p++;
+        const char* block_start = p;
+
+        while (*p && *p != '}') p++;
+        size_t block_len = (size_t)(p - block_start);
+        if (*p) p++;
+
+        if ((size_t)(selector_end - selector_start) > CSS_MAX_SELECTOR_LENGTH)
+            continue;
+
+        char* block = (char*)html2tex_malloc(block_len + 1);
+
+        if (!block) {
+            html2tex_free(clean);
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to copy stylesheet declaration block.");
+            return 0;
+        }
+
+        memcpy(block, block_start, block_len);
+        block[block_len] = '\0';
+
+        CSSProperties* declarations = parse_css_style(block);
+        html2tex_free(block);
+
+        if (!declarations) {
+            if (html2tex_err_get() == HTML2TEX_ERR_NOMEM) {
+                html2tex_free(clean);
+                return 0;
+            }
+
+            /* invalid block, drop the rule like browsers do */
+            continue;
+        }
+
+        if (declarations->count == 0) {
+            css_properties_destroy(declarations);
+            continue;
+        }
+
+        /* one rule per selector of the list, each with its own declarations */
+        SelectorCursor cursor;
+        selector_cursor_init(&cursor, selector_start, selector_end);
+
+        while (cursor.p < selector_end) {
+            CSSRule* rule = NULL;
+            int status = parse_selector(&cursor, &rule);
+
+            if (status < 0) {
+                css_properties_destroy(declarations);
+                html2tex_free(clean);
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                    "Failed to allocate stylesheet selector.");
+                return 0;
+            }
+
+            if (status > 0) {
+                rule->declarations = css_properties_copy(declarations);
+
+                if (!rule->declarations || !stylesheet_add_rule(sheet, rule)) {
+                    /* a rule already filed in the list is owned by the sheet */
+                    if (!sheet->rule_count || sheet->rules[sheet->rule_count - 1] != rule)
+                        rule_destroy(rule);
+
+                    css_properties_destroy(declarations);
+                    html2tex_free(clean);
+                    return 0;
+                }
+            }
+
+            /* an unsupported selector only drops itself, not the rest of the list */
+            skip_selector_alternative(&cursor);
+        }
+
+        css_properties_destroy(declarations);
+    }
+
+    html2tex_free(clean);
+
+    /* skipped rules are not errors */
+    html2tex_err_clear();
+    return 1;
+}
+
+CSSStylesheet* css_stylesheet_from_document(const HTMLNode* root) {
+    html2tex_err_clear();
+
+    if (!root) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "HTML root node is NULL for stylesheet.");
+        return NULL;
+    }
+
+    CSSStylesheet* sheet = NULL;
+    Stack* pending = NULL;
+
+    if (!stack_push(&pending, (void*)root))
+        return NULL;
+
+    /* pre-order walk, the sibling waits under the subtree so sheets keep document order */
+    while (!stack_is_empty(pending)) {
+        const HTMLNode* current = (const HTMLNode*)stack_pop(&pending);
+
+        if (current != root && current->next && !stack_push(&pending, (void*)current->next))
+            goto failure;
+
+        if (current->tag && strcmp(current->tag, "style") == 0) {
+            for (const HTMLNode* text = current->children; text; text = text->next) {
+                if (text->tag || !text->content) continue;
+
+                if (!sheet) {
+                    sheet = css_stylesheet_create();
+                    if (!sheet) goto failure;
+                }
+
+                if (!css_stylesheet_parse(sheet, text->content))
+                    goto failure;
+            }
+
+            continue;
+        }
+
+        if (current->children && !stack_push(&pending, (void*)current->children))
+            goto failure;
+    }
+
+    if (sheet && sheet->rule_count == 0) {
+        css_stylesheet_destroy(sheet);
+        sheet = NULL;
+    }
+
+    return sheet;
+
+failure:
+    stack_cleanup(&pending);
+    css_stylesheet_destroy(sheet);
+    return NULL;
+}
+
+/* checks a whitespace-separated list for an exact token */
+static int has_class_token(const char* list, const char* token) {
+    size_t len = strlen(token);
+    const char* p = list;
+
+    while (*p) {
+        while (*p && isspace((unsigned char)*p)) p++;
+        const char* start = p;
+
+        while (*p && !isspace((unsigned char)*p)) p++;
+        if ((size_t)(p - start) == len && memcmp(start, token, len) == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+static const HTMLAttribute* find_attribute(const HTMLNode* node, const char* key) {
+    for (const HTMLAttribute* attr = node->attributes; attr; attr = attr->next) {
+        if (attr->key && strcmp(attr->key, key) == 0)
+            return attr;
+    }
+
+    return NULL;
+}
+
+static int attribute_matches(const CSSAttributeTest* test, const HTMLNode* node) {
+    const HTMLAttribute* attr = find_attribute(node, test->key);
+    if (!attr) return 0;
+    if (test->op == CSS_ATTR_EXISTS) return 1;
+
+    const char* value = attr->value ? attr->value : "";
+    size_t length = strlen(value);
+    size_t wanted = strlen(test->value);
+
+    switch (test->op) {
+    case CSS_ATTR_EQUALS:
+        return strcmp(value, test->value) == 0;
+    case CSS_ATTR_INCLUDES:
+        return wanted > 0 && has_class_token(value, test->value);
+    case CSS_ATTR_PREFIX:
+        return wanted > 0 && length >= wanted && memcmp(value, test->value, wanted) == 0;
+    case CSS_ATTR_SUFFIX:
+        return wanted > 0 && length >= wanted &&
+            memcmp(value + length - wanted, test->value, wanted) == 0;
+    case CSS_ATTR_SUBSTRING:
+        return wanted > 0 && strstr(value, test->value) != NULL;
+    default:
+        return 0;
+    }
+}
+
+static size_t position_slot_hash(const HTMLNode* node, size_t mask) {
+    uint64_t key = (uint64_t)(uintptr_t)node >> 4;
+    return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+static const CSSPositionSlot* match_context_find(const CSSMatchContext* context,
+    const HTMLNode* node) {
+    if (!context->slots) return NULL;
+    size_t mask = context->capacity - 1;
+
+    for (size_t slot = position_slot_hash(node, mask); context->slots[slot].node;
+        slot = (slot + 1) & mask) {
+        if (context->slots[slot].node == node)
+            return &context->slots[slot];
+    }
+
+    return NULL;
+}
+
+/* the cache is an optimization, running out of memory falls back to counting */
+static int match_context_grow(CSSMatchContext* context) {
+    size_t capacity = context->capacity ? context->capacity * 2 : CSS_MATCH_CONTEXT_MIN_CAPACITY;
+    CSSPositionSlot* slots = (CSSPositionSlot*)html2tex_calloc(capacity, sizeof(CSSPositionSlot));
+    if (!slots) return 0;
+
+    for (size_t i = 0; i < context->capacity; i++) {
+        if (!context->slots[i].node) continue;
+        size_t slot = position_slot_hash(context->slots[i].node, capacity - 1);
+
+        while (slots[slot].node)
+            slot = (slot + 1) & (capacity - 1);
+        slots[slot] = context->slots[i];
+    }
+
+    html2tex_free(context->slots);
+    context->slots = slots;
+    context->capacity = capacity;
+    return 1;
+}
+
+/* records the position of every element of one sibling list in a single walk */
+static int match_context_index(CSSMatchContext* context, const HTMLNode* first) {
+    unsigned int count = 0, index = 0;
+
+    for (const HTMLNode* sibling = first; sibling; sibling = sibling->next)
+        if (sibling->tag) count++;
+
+    for (const HTMLNode* sibling = first; sibling; sibling = sibling->next) {
+        if (!sibling->tag) continue;
+        index++;
+
+        if ((context->used + 1) * 4 > context->capacity * 3 && !match_context_grow(context))
+            return 0;
+
+        size_t mask = context->capacity - 1;
+        size_t slot = position_slot_hash(sibling, mask);
+
+        while (context->slots[slot].node && context->slots[slot].node != sibling)
+            slot = (slot + 1) & mask;
+
+        if (!context->slots[slot].node) context->used++;
+        context->slots[slot].node = sibling;
+        context->slots[slot].index = index;
+        context->slots[slot].count = count;
+    }
+
+    return 1;
+}
+
+/* 1-based position among element siblings, from the last one when asked, 0 when unknown */
+static unsigned int sibling_position(CSSMatchContext* context, const HTMLNode* node, int from_end) {
+    const HTMLNode* first = NULL;
+
+    /* top-level nodes have no parent, the document root lists them */
+    if (node->parent)
+        first = node->parent->children;
+    else if (context && context->root && context->root != node)
+        first = context->root->children;
+
+    if (!first) return 0;
+
+    if (context) {
+        const CSSPositionSlot* slot = match_context_find(context, node);
+
+        if (!slot && match_context_index(context, first))
+            slot = match_context_find(context, node);
+
+        if (slot)
+            return from_end ? slot->count - slot->index + 1 : slot->index;
+    }
+
+    unsigned int before = 0, after = 0;
+    int seen = 0;
+
+    for (const HTMLNode* sibling = first; sibling; sibling = sibling->next) {
+        if (sibling == node) seen = 1;
+        else if (sibling->tag) {
+            if (seen) after++;
+            else before++;
+        }
+    }
+
+    if (!seen) return 0;
+    return (from_end ? after : before) + 1;
+}
+
+static int position_matches(const CSSNthTest* test, unsigned int position) {
+    if (position == 0) return 0;
+
+    long offset = (long)position - test->b;
+
+    if (test->a == 0) return offset == 0;
+    return offset % test->a == 0 && offset / test->a >= 0;
+}
+
+static int compound_matches(const CSSCompound* compound, const HTMLNode* node,
+    CSSMatchContext* context) {
+    if (!node || !node->tag) return 0;
+
+    if (compound->tag && strcmp(compound->tag, node->tag) != 0)
+        return 0;
+
+    if (compound->id) {
+        const char* id = get_hot_attribute(node, HTML_ATTR_ID);
+        if (!id || strcmp(compound->id, id) != 0) return 0;
+    }
+
+    if (compound->class_count > 0) {
+        const char* classes = get_hot_attribute(node, HTML_ATTR_CLASS);
+        if (!classes) return 0;
+
+        for (size_t i = 0; i < compound->class_count; i++) {
+            if (!has_class_token(classes, compound->classes[i]))
+                return 0;
+        }
+    }
+
+    for (size_t i = 0; i < compound->attribute_count; i++) {
+        if (!attribute_matches(&compound->attributes[i], node))
+            return 0;
+    }
+
+    for (size_t i = 0; i < compound->position_count; i++) {
+        const CSSNthTest* test = &compound->positions[i];
+
+        if (!position_matches(test, sibling_position(context, node, test->from_end)))
+            return 0;
+    }
+
+    return 1;
+}
+
+static int rule_matches_from(const CSSRule* rule, size_t index, const HTMLNode* node,
+    CSSMatchContext* context) {
+    if (!compound_matches(&rule->compounds[index], node, context))
+        return 0;
+
+    if (index + 1 == rule->compound_count)
+        return 1;
+
+    /* child combinator checks the parent only */
+    if (rule->compounds[index].combinator == '>')
+        return node->parent && rule_matches_from(rule, index + 1, node->parent, context);
+
+    /* descendant combinator tries every ancestor */
+    for (const HTMLNode* ancestor = node->parent; ancestor; ancestor = ancestor->parent) {
+        if (rule_matches_from(rule, index + 1, ancestor, context))
+            return 1;
+    }
+
+    return 0;
+}
+
+void css_match_context_init(CSSMatchContext* context, const HTMLNode* root) {
+    if (!context) return;
+
+    context->root = root;
+    context->slots = NULL;
+    context->capacity = 0;
+    context->used = 0;
+}
+
+void css_match_context_cleanup(CSSMatchContext* context) {
+    if (!context) return;
+
+    html2tex_free(context->slots);
+    context->slots = NULL;
+    context->capacity = 0;
+    context->used = 0;
+}
+
+int css_selector_matches(const CSSSelector* selector,
+    const HTMLNode* node, CSSMatchContext* context) {
+    if (!selector || !node || !node->tag) return 0;
+
+    for (size_t i = 0; i < selector->count; i++) {
+        if (rule_matches_from(selector->alternatives[i], 0, node, context))
+            return 1;
+    }
+
+    return 0;
+}
+
+typedef struct {
+    const CSSRule** items;
+    size_t count;
+    size_t capacity;
+    const CSSRule* inline_items[32];
+} MatchedRules;
+
+/* rejects a rule when an ancestor key it needs is absent from the filter */
+static int ancestors_may_match(const CSSRule* rule, const AncestorFilter* ancestors) {
+    for (size_t i = 0; i < rule->ancestor_hash_count; i++) {
+        if (!ancestor_filter_may_contain(ancestors, rule->ancestor_hashes[i]))
+            return 0;
+    }
+
+    return 1;
+}
+
+static int matched_rules_test(MatchedRules* matched, const CSSRule* const* rules,
+    size_t count, const HTMLNode* node, const AncestorFilter* ancestors,
+    CSSMatchContext* context) {
+    for (size_t i = 0; i < count; i++) {
+        if (ancestors && !ancestors_may_match(rules[i], ancestors))
+            continue;
+
+        if (!rule_matches_from(rules[i], 0, node, context))
+            continue;
+
+        if (matched->count == matched->capacity) {
+            size_t capacity = matched->capacity * 2;
+            const CSSRule** grown = NULL;
+
+            if (matched->items == matched->inline_items) {
+                grown = (const CSSRule**)html2tex_malloc(capacity * sizeof(CSSRule*));
+                if (grown) memcpy(grown, matched->items, matched->count * sizeof(CSSRule*));
+            }
+            else
+                grown = (const CSSRule**)html2tex_realloc((void*)matched->items, capacity * sizeof(CSSRule*));
+
+            if (!grown) {
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                    "Failed to grow matched rule list.");
+                return 0;
+            }
+
+            matched->items = grown;
+            matched->capacity = capacity;
+        }
+
+        matched->items[matched->count++] = rules[i];
+    }
+
+    return 1;
+}
+
+static int compare_rule_priority(const void* left, const void* right) {
+    const CSSRule* a = *(const CSSRule* const*)left;
+    const CSSRule* b = *(const CSSRule* const*)right;
+
+    if (a->specificity != b->specificity)
+        return a->specificity < b->specificity ? -1 : 1;
+    return a->order < b->order ? -1 : (a->order > b->order ? 1 : 0);
+}
+
+/* Applies declarations in cascade order, normal values never override important ones. */
+static int cascade_declarations(CSSProperties* target, const CSSProperties* source) {
+    for (const CSSProperty* prop = source->head; prop; prop = prop->next) {
+        const CSSProperty* existing = target->head;
+
+        while (existing && strcasecmp(existing->key, prop->key) != 0)
+            existing = existing->next;
+
+        if (existing && existing->important && !prop->important)
+            continue;
+
+        if (!css_properties_set(target, prop->key, prop->value, prop->important))
+            return 0;
+    }
+
+    return 1;
+}
+
+CSSProperties* css_stylesheet_cascade(const CSSStylesheet* sheet,
+    const HTMLNode* node, const AncestorFilter* ancestors, CSSMatchContext* context) {
+    html2tex_err_clear();
+
+    if (!node) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "HTML node is NULL for CSS cascade.");
+        return NULL;
+    }
+
+    if (!node->tag) return NULL;
+    const char* style_attr = get_hot_attribute(node, HTML_ATTR_STYLE);
+
+    if (!sheet || sheet->rule_count == 0)
+        return style_attr ? parse_css_style(style_attr) : NULL;
+
+    /* the filter only describes this node when it was built along its parent chain */
+    if (!ancestor_filter_covers(ancestors, node))
+        ancestors = NULL;
+
+    MatchedRules matched;
+    matched.items = matched.inline_items;
+    matched.count = 0;
+    matched.capacity = sizeof(matched.inline_items) / sizeof(matched.inline_items[0]);
+
+    /* only rules filed under this node's keys can match */
+    const char* id = get_hot_attribute(node, HTML_ATTR_ID);
+    const char* classes = get_hot_attribute(node, HTML_ATTR_CLASS);
+    const CSSRuleBucket* bucket = NULL;
+    int ok = 1;
+
+    if (id && (bucket = rule_map_find(&sheet->ids, id, strlen(id))) != NULL)
+        ok = matched_rules_test(&matched, (const CSSRule* const*)bucket->rules, bucket->count, node, ancestors, context);
+
+    if (ok && classes && sheet->classes.used > 0) {
+        const char* p = classes;
+
+        while (ok && *p) {
+            while (*p && isspace((unsigned char)*p)) p++;
+            const char* start = p;
+
+            while (*p && !isspace((unsigned char)*p)) p++;
+            size_t len = (size_t)(p - start);
+            if (len == 0) continue;
+
+            /* a repeated token would test the same bucket twice */
+            int repeated = 0;
+
+            for (const char* q = classes; q < start && !repeated; ) {
+                while (q < start && isspace((unsigned char)*q)) q++;
+                const char* prev = q;
+
+                while (q < start && !isspace((unsigned char)*q)) q++;
+                repeated = (size_t)(q - prev) == len && memcmp(prev, start, len) == 0;
+            }
+
+            if (!repeated && (bucket = rule_map_find(&sheet->classes, start, len)) != NULL)
+                ok = matched_rules_test(&matched, (const CSSRule* const*)bucket->rules, bucket->count, node, ancestors, context);
+        }
+    }
+
+    if (ok && (bucket = rule_map_find(&sheet->tags, node->tag, strlen(node->tag))) != NULL)
+        ok = matched_rules_test(&matched, (const CSSRule* const*)bucket->rules, bucket->count, node, ancestors, context);
+
+    if (ok && sheet->universal_count > 0)
+        ok = matched_rules_test(&matched, (const CSSRule* const*)sheet->universal,
+            sheet->universal_count, node, ancestors, context);
+
+    CSSProperties* result = NULL;
+
+    if (!ok) goto exit;
+
+    if (matched.count == 0) {
+        result = style_attr ? parse_css_style(style_attr) : NULL;
+        goto exit;
+    }
+
+    qsort((void*)matched.items, matched.count, sizeof(CSSRule*), compare_rule_priority);
+    result = css_properties_create();
+    if (!result) goto exit;
+
+    for (size_t i = 0; i < matched.count; i++) {
+        if (!cascade_declarations(result, matched.items[i]->declarations)) {
+            css_properties_destroy(result);
+            result = NULL;
+            goto exit;
+        }
+    }
+
+    /* the style attribute wins over every non-important rule */
+    if (style_attr) {
+        CSSProperties* inline_css = parse_css_style(style_attr);
+
+        if (inline_css) {
+            int applied = cascade_declarations(result, inline_css);
+            css_properties_destroy(inline_css);
+
+            if (!applied) {
+                css_properties_destroy(result);
+                result = NULL;
+            }
+        }
+    }
+
+exit:
+    if (matched.items != matched.inline_items)
+        html2tex_free((void*)matched.items);
+
+    return result;
+}
@@ -1,3 +1,8 @@
+/* clock_gettime() and its clocks are POSIX, hidden by a strict C99 build */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "html2tex_thread.h"
 #include <stdlib.h>
 
@@ -16,6 +21,21 @@ void thread_exit(thread_return_t ret) {
     ExitThread(ret);
 }
 
+void thread_yield(void) {
+    SwitchToThread();
+}
+
+static BOOL CALLBACK run_once(PINIT_ONCE flag, PVOID func, PVOID* context) {
+    (void)flag;
+    (void)context;
+    ((void (*)(void))func)();
+    return TRUE;
+}
+
+void thread_once(once_t* flag, void (*func)(void)) {
+    InitOnceExecuteOnce(flag, run_once, (PVOID)func, NULL);
+}
+
 int mutex_init(mutex_t* mutex) {
     InitializeCriticalSection(mutex);
     return 0;
@@ -62,6 +82,10 @@ void cond_destroy(cond_t* cond) {
     (void)cond;
 }
 
+uint64_t get_monotonic_ms(void) {
+    return (uint64_t)GetTickCount64();
+}
+
 #else
 
 int thread_create(thread_t* thread, THREAD_RETURN_TYPE(*func)(void*), void* arg) {
@@ -76,6 +100,14 @@ void thread_exit(thread_return_t ret) {
     thrd_exit(ret);
 }
 
+void thread_yield(void) {
+    thrd_yield();
+}
+
+void thread_once(once_t* flag, void (*func)(void)) {
+    call_once(flag, func);
+}
+
 int mutex_init(mutex_t* mutex) {
     return mtx_init(mutex, mtx_plain);
 }
@@ -127,4 +159,10 @@ void cond_destroy(cond_t* cond) {
     cnd_destroy(cond);
 }
 
+uint64_t get_monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)(ts.tv_nsec / 1000000);
+}
+
 #endif
\ No newline at end of file
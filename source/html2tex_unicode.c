@@ -0,0 +1,774 @@
+#include "string_buffer.h"
+#include <stddef.h>
+
+/* Generated from the Unicode character database (NFD decompositions for
+accented Latin letters) plus hand-picked symbol, Greek and math commands,
+do not edit by hand. A code point maps through LATEX_UNICODE_PAGES[cp >> 8]
+to a 256-entry page of offsets into LATEX_UNICODE_POOL, offset 0 means
+unmapped and offset 1 is the empty string (dropped characters).
+*/
+#define LATEX_UNICODE_PAGE_LIMIT 0x2300
+
+static const unsigned char LATEX_UNICODE_PAGES[35] = {
+    1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0,
+    6, 7, 8
+};
+
+static const unsigned short LATEX_UNICODE_OFFSETS[8][256] = {
+    /* U+0000 */ {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        2, 4, 22, 34, 44, 60, 71, 88, 93, 114, 131, 150, 167, 185, 188, 206,
+        225, 239, 256, 275, 296, 314, 331, 336, 358, 364, 383, 403, 421, 439, 454, 475,
+        495, 501, 507, 513, 519, 525, 531, 537, 543, 549, 555, 561, 567, 573, 579, 585,
+        591, 597, 603, 609, 615, 621, 627, 633, 653, 658, 664, 670, 676, 682, 688, 694,
+        700, 706, 712, 718, 724, 730, 736, 742, 748, 754, 760, 766, 772, 779, 786, 793,
+        800, 806, 812, 818, 824, 830, 836, 842, 860, 865, 871, 877, 883, 889, 895, 901
+    },
+    /* U+0100 */ {
+        907, 913, 919, 925, 931, 937, 943, 949, 955, 961, 967, 973, 979, 985, 991, 997,
+        1003, 1009, 1015, 1021, 1027, 1033, 1039, 1045, 1051, 1057, 1063, 1069, 1075, 1081, 1087, 1093,
+        1099, 1105, 1111, 1117, 1123, 1129, 0, 0, 1135, 1141, 1148, 1154, 1161, 1167, 1174, 1180,
+        1186, 1192, 1197, 1200, 1203, 1209, 1216, 1222, 0, 1228, 1234, 1240, 1246, 1252, 1258, 0,
+        0, 1264, 1269, 1274, 1280, 1286, 1292, 1298, 1304, 0, 1310, 1316, 1322, 1328, 1334, 1340,
+        1346, 1352, 1358, 1364, 1370, 1376, 1382, 1388, 1394, 1400, 1406, 1412, 1418, 1424, 1430, 1436,
+        1442, 1448, 1454, 1460, 1466, 1472, 0, 0, 1478, 1484, 1490, 1496, 1502, 1508, 1514, 1520,
+        1526, 1532, 1538, 1544, 1550, 1556, 1562, 1568, 1574, 1580, 1586, 1592, 1598, 1604, 1610, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1616, 1622, 1628,
+        1634, 1641, 1647, 1653, 1659, 1665, 1675, 1685, 1695, 1705, 1715, 1725, 1735, 0, 1745, 1755,
+        1765, 1775, 0, 0, 0, 0, 1785, 1791, 1797, 1803, 1809, 1815, 1821, 1831, 0, 0,
+        1841, 0, 0, 0, 1848, 1854, 0, 0, 1860, 1866, 1872, 1882, 0, 0, 0, 0
+    },
+    /* U+0200 */ {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1892, 1898,
+        0, 0, 0, 0, 0, 0, 1904, 1910, 1916, 1922, 1928, 1938, 1948, 1958, 1968, 1974,
+        1980, 1990, 2000, 2006, 0, 0, 0, 2012, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 2017, 2022, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 2027, 2032, 2037, 0, 2042, 2047, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    },
+    /* U+0300 */ {
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 2052, 2054, 2056, 2076, 2096, 2098, 2100, 2102, 2122, 2124, 2126, 2147, 2149, 2151, 2168,
+        2170, 2187, 0, 2189, 2209, 2211, 2233, 2251, 2253, 2271, 0, 0, 0, 0, 0, 0,
+        0, 2291, 2311, 2330, 2350, 2370, 2392, 2411, 2429, 2449, 2468, 2488, 314, 2509, 2526, 2543,
+        2545, 2562, 2580, 2603, 2623, 2641, 2663, 2681, 2699, 2717, 0, 0, 0, 0, 0, 0,
+        0, 2737, 0, 0, 0, 2760, 2781, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 2801, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    },
+    /* U+1E00 */ {
+        0, 0, 2826, 2832, 2838, 2844, 2850, 2856, 2862, 2872, 2882, 2888, 2894, 2900, 2906, 2912,
+        2918, 2924, 0, 0, 2930, 2940, 2950, 2960, 0, 0, 0, 0, 2970, 2980, 2990, 2996,
+        3002, 3008, 3014, 3020, 3026, 3032, 3038, 3044, 3050, 3056, 0, 0, 0, 0, 3062, 3072,
+        3083, 3089, 3095, 3101, 3107, 3113, 3119, 3125, 3131, 3141, 3151, 3157, 0, 0, 3163, 3169,
+        3175, 3181, 3187, 3193, 3199, 3205, 3211, 3217, 3223, 3229, 0, 0, 3235, 3245, 3255, 3265,
+        3275, 3285, 3295, 3305, 3315, 3321, 3327, 3333, 3339, 3345, 3351, 3357, 3363, 3373, 3383, 3389,
+        3395, 3401, 3407, 3413, 3419, 3429, 3439, 3449, 3459, 3469, 3479, 3485, 3491, 3497, 3503, 3509,
+        0, 0, 0, 0, 0, 0, 0, 0, 3515, 3525, 3535, 3545, 3555, 3561, 3567, 3573,
+        3579, 3585, 3591, 3597, 3603, 3609, 3615, 3621, 3627, 3633, 3639, 3645, 3651, 3657, 3663, 3669,
+        3675, 3681, 3687, 3693, 3699, 3705, 3711, 3717, 3723, 3729, 0, 0, 0, 0, 0, 0,
+        3735, 3741, 0, 0, 3747, 3757, 3767, 3777, 0, 0, 3787, 3797, 3807, 3817, 3827, 3837,
+        3847, 3857, 0, 0, 3867, 3877, 3887, 3897, 3907, 3913, 0, 0, 3919, 3925, 3931, 3941,
+        3951, 3961, 0, 0, 3971, 3981, 3991, 4001, 0, 0, 4011, 4017, 4023, 4029, 0, 0,
+        4035, 4045, 4055, 4065, 0, 0, 4075, 4085, 4095, 4105, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 4115, 4121, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 4127, 4133, 4139, 4145, 0, 0, 4151, 4157, 0, 0, 0, 0, 0, 0
+    },
+    /* U+2000 */ {
+        0, 0, 4163, 4174, 0, 0, 0, 0, 0, 4182, 4182, 1, 1, 1, 0, 0,
+        4185, 4187, 4196, 4196, 4199, 4199, 4203, 0, 4219, 4221, 4223, 0, 4241, 4244, 4247, 0,
+        4263, 4270, 4278, 0, 0, 0, 4292, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        4300, 0, 4319, 4339, 0, 0, 0, 0, 0, 4365, 4382, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 4400, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 4423, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    },
+    /* U+2100 */ {
+        0, 0, 0, 4435, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 4450, 0, 4467, 0, 0, 4485, 0, 4499, 0, 0, 0, 4516, 0, 0, 0,
+        0, 0, 4533, 0, 0, 0, 2271, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 4550, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        4570, 4594, 4616, 4641, 4665, 4694, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 4720, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        4741, 4765, 4787, 4812, 4836, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    },
+    /* U+2200 */ {
+        4865, 0, 4886, 4908, 0, 4929, 0, 4952, 4972, 4989, 0, 5009, 0, 0, 0, 5026,
+        0, 5045, 5063, 5078, 0, 0, 0, 5095, 5113, 5132, 5153, 0, 0, 5172, 5193, 0,
+        5213, 0, 0, 5233, 0, 5251, 0, 5274, 5294, 5312, 5330, 5348, 0, 0, 5366, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5385, 0, 0, 0,
+        0, 0, 0, 5403, 0, 5423, 0, 0, 5442, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        5463, 5481, 0, 0, 5501, 5519, 0, 0, 0, 0, 5537, 5554, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 5571, 5592, 0, 0, 5613, 5636, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 5659, 0, 5679, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 5700, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 5719, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5738, 5758,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+    }
+};
+
+static const char LATEX_UNICODE_POOL[] =
+    "\0\0"
+    "~\0"
+    "\\textexclamdown{}\0"
+    "\\textcent{}\0"
+    "\\pounds{}\0"
+    "\\textcurrency{}\0"
+    "\\textyen{}\0"
+    "\\textbrokenbar{}\0"
+    "\\S{}\0"
+    "\\textasciidieresis{}\0"
+    "\\textcopyright{}\0"
+    "\\textordfeminine{}\0"
+    "\\guillemotleft{}\0"
+    "\\ensuremath{\\neg}\0"
+    "\\-\0"
+    "\\textregistered{}\0"
+    "\\textasciimacron{}\0"
+    "\\textdegree{}\0"
+    "\\ensuremath{\\pm}\0"
+    "\\texttwosuperior{}\0"
+    "\\textthreesuperior{}\0"
+    "\\textasciiacute{}\0"
+    "\\ensuremath{\\mu}\0"
+    "\\P{}\0"
+    "\\textperiodcentered{}\0"
+    "\\c{ }\0"
+    "\\textonesuperior{}\0"
+    "\\textordmasculine{}\0"
+    "\\guillemotright{}\0"
+    "\\textonequarter{}\0"
+    "\\textonehalf{}\0"
+    "\\textthreequarters{}\0"
+    "\\textquestiondown{}\0"
+    "\\`{A}\0"
+    "\\'{A}\0"
+    "\\^{A}\0"
+    "\\~{A}\0"
+    "\\\"{A}\0"
+    "\\r{A}\0"
+    "\\AE{}\0"
+    "\\c{C}\0"
+    "\\`{E}\0"
+    "\\'{E}\0"
+    "\\^{E}\0"
+    "\\\"{E}\0"
+    "\\`{I}\0"
+    "\\'{I}\0"
+    "\\^{I}\0"
+    "\\\"{I}\0"
+    "\\DH{}\0"
+    "\\~{N}\0"
+    "\\`{O}\0"
+    "\\'{O}\0"
+    "\\^{O}\0"
+    "\\~{O}\0"
+    "\\\"{O}\0"
+    "\\ensuremath{\\times}\0"
+    "\\O{}\0"
+    "\\`{U}\0"
+    "\\'{U}\0"
+    "\\^{U}\0"
+    "\\\"{U}\0"
+    "\\'{Y}\0"
+    "\\TH{}\0"
+    "\\ss{}\0"
+    "\\`{a}\0"
+    "\\'{a}\0"
+    "\\^{a}\0"
+    "\\~{a}\0"
+    "\\\"{a}\0"
+    "\\r{a}\0"
+    "\\ae{}\0"
+    "\\c{c}\0"
+    "\\`{e}\0"
+    "\\'{e}\0"
+    "\\^{e}\0"
+    "\\\"{e}\0"
+    "\\`{\\i}\0"
+    "\\'{\\i}\0"
+    "\\^{\\i}\0"
+    "\\\"{\\i}\0"
+    "\\dh{}\0"
+    "\\~{n}\0"
+    "\\`{o}\0"
+    "\\'{o}\0"
+    "\\^{o}\0"
+    "\\~{o}\0"
+    "\\\"{o}\0"
+    "\\ensuremath{\\div}\0"
+    "\\o{}\0"
+    "\\`{u}\0"
+    "\\'{u}\0"
+    "\\^{u}\0"
+    "\\\"{u}\0"
+    "\\'{y}\0"
+    "\\th{}\0"
+    "\\\"{y}\0"
+    "\\={A}\0"
+    "\\={a}\0"
+    "\\u{A}\0"
+    "\\u{a}\0"
+    "\\k{A}\0"
+    "\\k{a}\0"
+    "\\'{C}\0"
+    "\\'{c}\0"
+    "\\^{C}\0"
+    "\\^{c}\0"
+    "\\.{C}\0"
+    "\\.{c}\0"
+    "\\v{C}\0"
+    "\\v{c}\0"
+    "\\v{D}\0"
+    "\\v{d}\0"
+    "\\DJ{}\0"
+    "\\dj{}\0"
+    "\\={E}\0"
+    "\\={e}\0"
+    "\\u{E}\0"
+    "\\u{e}\0"
+    "\\.{E}\0"
+    "\\.{e}\0"
+    "\\k{E}\0"
+    "\\k{e}\0"
+    "\\v{E}\0"
+    "\\v{e}\0"
+    "\\^{G}\0"
+    "\\^{g}\0"
+    "\\u{G}\0"
+    "\\u{g}\0"
+    "\\.{G}\0"
+    "\\.{g}\0"
+    "\\c{G}\0"
+    "\\c{g}\0"
+    "\\^{H}\0"
+    "\\^{h}\0"
+    "\\~{I}\0"
+    "\\~{\\i}\0"
+    "\\={I}\0"
+    "\\={\\i}\0"
+    "\\u{I}\0"
+    "\\u{\\i}\0"
+    "\\k{I}\0"
+    "\\k{i}\0"
+    "\\.{I}\0"
+    "\\i{}\0"
+    "IJ\0"
+    "ij\0"
+    "\\^{J}\0"
+    "\\^{\\j}\0"
+    "\\c{K}\0"
+    "\\c{k}\0"
+    "\\'{L}\0"
+    "\\'{l}\0"
+    "\\c{L}\0"
+    "\\c{l}\0"
+    "\\v{L}\0"
+    "\\v{l}\0"
+    "\\L{}\0"
+    "\\l{}\0"
+    "\\'{N}\0"
+    "\\'{n}\0"
+    "\\c{N}\0"
+    "\\c{n}\0"
+    "\\v{N}\0"
+    "\\v{n}\0"
+    "\\NG{}\0"
+    "\\ng{}\0"
+    "\\={O}\0"
+    "\\={o}\0"
+    "\\u{O}\0"
+    "\\u{o}\0"
+    "\\H{O}\0"
+    "\\H{o}\0"
+    "\\OE{}\0"
+    "\\oe{}\0"
+    "\\'{R}\0"
+    "\\'{r}\0"
+    "\\c{R}\0"
+    "\\c{r}\0"
+    "\\v{R}\0"
+    "\\v{r}\0"
+    "\\'{S}\0"
+    "\\'{s}\0"
+    "\\^{S}\0"
+    "\\^{s}\0"
+    "\\c{S}\0"
+    "\\c{s}\0"
+    "\\v{S}\0"
+    "\\v{s}\0"
+    "\\c{T}\0"
+    "\\c{t}\0"
+    "\\v{T}\0"
+    "\\v{t}\0"
+    "\\~{U}\0"
+    "\\~{u}\0"
+    "\\={U}\0"
+    "\\={u}\0"
+    "\\u{U}\0"
+    "\\u{u}\0"
+    "\\r{U}\0"
+    "\\r{u}\0"
+    "\\H{U}\0"
+    "\\H{u}\0"
+    "\\k{U}\0"
+    "\\k{u}\0"
+    "\\^{W}\0"
+    "\\^{w}\0"
+    "\\^{Y}\0"
+    "\\^{y}\0"
+    "\\\"{Y}\0"
+    "\\'{Z}\0"
+    "\\'{z}\0"
+    "\\.{Z}\0"
+    "\\.{z}\0"
+    "\\v{Z}\0"
+    "\\v{z}\0"
+    "\\v{A}\0"
+    "\\v{a}\0"
+    "\\v{I}\0"
+    "\\v{\\i}\0"
+    "\\v{O}\0"
+    "\\v{o}\0"
+    "\\v{U}\0"
+    "\\v{u}\0"
+    "\\={\\\"{U}}\0"
+    "\\={\\\"{u}}\0"
+    "\\'{\\\"{U}}\0"
+    "\\'{\\\"{u}}\0"
+    "\\v{\\\"{U}}\0"
+    "\\v{\\\"{u}}\0"
+    "\\`{\\\"{U}}\0"
+    "\\`{\\\"{u}}\0"
+    "\\={\\\"{A}}\0"
+    "\\={\\\"{a}}\0"
+    "\\={\\.{A}}\0"
+    "\\={\\.{a}}\0"
+    "\\v{G}\0"
+    "\\v{g}\0"
+    "\\v{K}\0"
+    "\\v{k}\0"
+    "\\k{O}\0"
+    "\\k{o}\0"
+    "\\={\\k{O}}\0"
+    "\\={\\k{o}}\0"
+    "\\v{\\j}\0"
+    "\\'{G}\0"
+    "\\'{g}\0"
+    "\\`{N}\0"
+    "\\`{n}\0"
+    "\\'{\\r{A}}\0"
+    "\\'{\\r{a}}\0"
+    "\\v{H}\0"
+    "\\v{h}\0"
+    "\\.{A}\0"
+    "\\.{a}\0"
+    "\\c{E}\0"
+    "\\c{e}\0"
+    "\\={\\\"{O}}\0"
+    "\\={\\\"{o}}\0"
+    "\\={\\~{O}}\0"
+    "\\={\\~{o}}\0"
+    "\\.{O}\0"
+    "\\.{o}\0"
+    "\\={\\.{O}}\0"
+    "\\={\\.{o}}\0"
+    "\\={Y}\0"
+    "\\={y}\0"
+    "\\j{}\0"
+    "\\^{}\0"
+    "\\v{}\0"
+    "\\u{}\0"
+    "\\.{}\0"
+    "\\r{}\0"
+    "\\~{}\0"
+    "\\H{}\0"
+    "A\0"
+    "B\0"
+    "\\ensuremath{\\Gamma}\0"
+    "\\ensuremath{\\Delta}\0"
+    "E\0"
+    "Z\0"
+    "H\0"
+    "\\ensuremath{\\Theta}\0"
+    "I\0"
+    "K\0"
+    "\\ensuremath{\\Lambda}\0"
+    "M\0"
+    "N\0"
+    "\\ensuremath{\\Xi}\0"
+    "O\0"
+    "\\ensuremath{\\Pi}\0"
+    "P\0"
+    "\\ensuremath{\\Sigma}\0"
+    "T\0"
+    "\\ensuremath{\\Upsilon}\0"
+    "\\ensuremath{\\Phi}\0"
+    "X\0"
+    "\\ensuremath{\\Psi}\0"
+    "\\ensuremath{\\Omega}\0"
+    "\\ensuremath{\\alpha}\0"
+    "\\ensuremath{\\beta}\0"
+    "\\ensuremath{\\gamma}\0"
+    "\\ensuremath{\\delta}\0"
+    "\\ensuremath{\\epsilon}\0"
+    "\\ensuremath{\\zeta}\0"
+    "\\ensuremath{\\eta}\0"
+    "\\ensuremath{\\theta}\0"
+    "\\ensuremath{\\iota}\0"
+    "\\ensuremath{\\kappa}\0"
+    "\\ensuremath{\\lambda}\0"
+    "\\ensuremath{\\nu}\0"
+    "\\ensuremath{\\xi}\0"
+    "o\0"
+    "\\ensuremath{\\pi}\0"
+    "\\ensuremath{\\rho}\0"
+    "\\ensuremath{\\varsigma}\0"
+    "\\ensuremath{\\sigma}\0"
+    "\\ensuremath{\\tau}\0"
+    "\\ensuremath{\\upsilon}\0"
+    "\\ensuremath{\\phi}\0"
+    "\\ensuremath{\\chi}\0"
+    "\\ensuremath{\\psi}\0"
+    "\\ensuremath{\\omega}\0"
+    "\\ensuremath{\\vartheta}\0"
+    "\\ensuremath{\\varphi}\0"
+    "\\ensuremath{\\varpi}\0"
+    "\\ensuremath{\\varepsilon}\0"
+    "\\.{B}\0"
+    "\\.{b}\0"
+    "\\d{B}\0"
+    "\\d{b}\0"
+    "\\b{B}\0"
+    "\\b{b}\0"
+    "\\'{\\c{C}}\0"
+    "\\'{\\c{c}}\0"
+    "\\.{D}\0"
+    "\\.{d}\0"
+    "\\d{D}\0"
+    "\\d{d}\0"
+    "\\b{D}\0"
+    "\\b{d}\0"
+    "\\c{D}\0"
+    "\\c{d}\0"
+    "\\`{\\={E}}\0"
+    "\\`{\\={e}}\0"
+    "\\'{\\={E}}\0"
+    "\\'{\\={e}}\0"
+    "\\u{\\c{E}}\0"
+    "\\u{\\c{e}}\0"
+    "\\.{F}\0"
+    "\\.{f}\0"
+    "\\={G}\0"
+    "\\={g}\0"
+    "\\.{H}\0"
+    "\\.{h}\0"
+    "\\d{H}\0"
+    "\\d{h}\0"
+    "\\\"{H}\0"
+    "\\\"{h}\0"
+    "\\c{H}\0"
+    "\\c{h}\0"
+    "\\'{\\\"{I}}\0"
+    "\\'{\\\"{\\i}}\0"
+    "\\'{K}\0"
+    "\\'{k}\0"
+    "\\d{K}\0"
+    "\\d{k}\0"
+    "\\b{K}\0"
+    "\\b{k}\0"
+    "\\d{L}\0"
+    "\\d{l}\0"
+    "\\={\\d{L}}\0"
+    "\\={\\d{l}}\0"
+    "\\b{L}\0"
+    "\\b{l}\0"
+    "\\'{M}\0"
+    "\\'{m}\0"
+    "\\.{M}\0"
+    "\\.{m}\0"
+    "\\d{M}\0"
+    "\\d{m}\0"
+    "\\.{N}\0"
+    "\\.{n}\0"
+    "\\d{N}\0"
+    "\\d{n}\0"
+    "\\b{N}\0"
+    "\\b{n}\0"
+    "\\'{\\~{O}}\0"
+    "\\'{\\~{o}}\0"
+    "\\\"{\\~{O}}\0"
+    "\\\"{\\~{o}}\0"
+    "\\`{\\={O}}\0"
+    "\\`{\\={o}}\0"
+    "\\'{\\={O}}\0"
+    "\\'{\\={o}}\0"
+    "\\'{P}\0"
+    "\\'{p}\0"
+    "\\.{P}\0"
+    "\\.{p}\0"
+    "\\.{R}\0"
+    "\\.{r}\0"
+    "\\d{R}\0"
+    "\\d{r}\0"
+    "\\={\\d{R}}\0"
+    "\\={\\d{r}}\0"
+    "\\b{R}\0"
+    "\\b{r}\0"
+    "\\.{S}\0"
+    "\\.{s}\0"
+    "\\d{S}\0"
+    "\\d{s}\0"
+    "\\.{\\'{S}}\0"
+    "\\.{\\'{s}}\0"
+    "\\.{\\v{S}}\0"
+    "\\.{\\v{s}}\0"
+    "\\.{\\d{S}}\0"
+    "\\.{\\d{s}}\0"
+    "\\.{T}\0"
+    "\\.{t}\0"
+    "\\d{T}\0"
+    "\\d{t}\0"
+    "\\b{T}\0"
+    "\\b{t}\0"
+    "\\'{\\~{U}}\0"
+    "\\'{\\~{u}}\0"
+    "\\\"{\\={U}}\0"
+    "\\\"{\\={u}}\0"
+    "\\~{V}\0"
+    "\\~{v}\0"
+    "\\d{V}\0"
+    "\\d{v}\0"
+    "\\`{W}\0"
+    "\\`{w}\0"
+    "\\'{W}\0"
+    "\\'{w}\0"
+    "\\\"{W}\0"
+    "\\\"{w}\0"
+    "\\.{W}\0"
+    "\\.{w}\0"
+    "\\d{W}\0"
+    "\\d{w}\0"
+    "\\.{X}\0"
+    "\\.{x}\0"
+    "\\\"{X}\0"
+    "\\\"{x}\0"
+    "\\.{Y}\0"
+    "\\.{y}\0"
+    "\\^{Z}\0"
+    "\\^{z}\0"
+    "\\d{Z}\0"
+    "\\d{z}\0"
+    "\\b{Z}\0"
+    "\\b{z}\0"
+    "\\b{h}\0"
+    "\\\"{t}\0"
+    "\\r{w}\0"
+    "\\r{y}\0"
+    "\\d{A}\0"
+    "\\d{a}\0"
+    "\\'{\\^{A}}\0"
+    "\\'{\\^{a}}\0"
+    "\\`{\\^{A}}\0"
+    "\\`{\\^{a}}\0"
+    "\\~{\\^{A}}\0"
+    "\\~{\\^{a}}\0"
+    "\\^{\\d{A}}\0"
+    "\\^{\\d{a}}\0"
+    "\\'{\\u{A}}\0"
+    "\\'{\\u{a}}\0"
+    "\\`{\\u{A}}\0"
+    "\\`{\\u{a}}\0"
+    "\\~{\\u{A}}\0"
+    "\\~{\\u{a}}\0"
+    "\\u{\\d{A}}\0"
+    "\\u{\\d{a}}\0"
+    "\\d{E}\0"
+    "\\d{e}\0"
+    "\\~{E}\0"
+    "\\~{e}\0"
+    "\\'{\\^{E}}\0"
+    "\\'{\\^{e}}\0"
+    "\\`{\\^{E}}\0"
+    "\\`{\\^{e}}\0"
+    "\\~{\\^{E}}\0"
+    "\\~{\\^{e}}\0"
+    "\\^{\\d{E}}\0"
+    "\\^{\\d{e}}\0"
+    "\\d{I}\0"
+    "\\d{i}\0"
+    "\\d{O}\0"
+    "\\d{o}\0"
+    "\\'{\\^{O}}\0"
+    "\\'{\\^{o}}\0"
+    "\\`{\\^{O}}\0"
+    "\\`{\\^{o}}\0"
+    "\\~{\\^{O}}\0"
+    "\\~{\\^{o}}\0"
+    "\\^{\\d{O}}\0"
+    "\\^{\\d{o}}\0"
+    "\\d{U}\0"
+    "\\d{u}\0"
+    "\\`{Y}\0"
+    "\\`{y}\0"
+    "\\d{Y}\0"
+    "\\d{y}\0"
+    "\\~{Y}\0"
+    "\\~{y}\0"
+    "\\enspace{}\0"
+    "\\quad{}\0"
+    "\\,\0"
+    "-\0"
+    "\\mbox{-}\0"
+    "--\0"
+    "---\0"
+    "\\ensuremath{\\|}\0"
+    "`\0"
+    "'\0"
+    "\\quotesinglbase{}\0"
+    "``\0"
+    "''\0"
+    "\\quotedblbase{}\0"
+    "\\dag{}\0"
+    "\\ddag{}\0"
+    "\\textbullet{}\0"
+    "\\dots{}\0"
+    "\\textperthousand{}\0"
+    "\\ensuremath{\\prime}\0"
+    "\\ensuremath{\\prime\\prime}\0"
+    "\\guilsinglleft{}\0"
+    "\\guilsinglright{}\0"
+    "\\textfractionsolidus{}\0"
+    "\\texteuro{}\0"
+    "\\textcelsius{}\0"
+    "\\ensuremath{\\Im}\0"
+    "\\ensuremath{\\ell}\0"
+    "\\textnumero{}\0"
+    "\\ensuremath{\\wp}\0"
+    "\\ensuremath{\\Re}\0"
+    "\\texttrademark{}\0"
+    "\\ensuremath{\\aleph}\0"
+    "\\ensuremath{\\leftarrow}\0"
+    "\\ensuremath{\\uparrow}\0"
+    "\\ensuremath{\\rightarrow}\0"
+    "\\ensuremath{\\downarrow}\0"
+    "\\ensuremath{\\leftrightarrow}\0"
+    "\\ensuremath{\\updownarrow}\0"
+    "\\ensuremath{\\mapsto}\0"
+    "\\ensuremath{\\Leftarrow}\0"
+    "\\ensuremath{\\Uparrow}\0"
+    "\\ensuremath{\\Rightarrow}\0"
+    "\\ensuremath{\\Downarrow}\0"
+    "\\ensuremath{\\Leftrightarrow}\0"
+    "\\ensuremath{\\forall}\0"
+    "\\ensuremath{\\partial}\0"
+    "\\ensuremath{\\exists}\0"
+    "\\ensuremath{\\emptyset}\0"
+    "\\ensuremath{\\nabla}\0"
+    "\\ensuremath{\\in}\0"
+    "\\ensuremath{\\notin}\0"
+    "\\ensuremath{\\ni}\0"
+    "\\ensuremath{\\prod}\0"
+    "\\ensuremath{\\sum}\0"
+    "\\ensuremath{-}\0"
+    "\\ensuremath{\\mp}\0"
+    "\\ensuremath{\\ast}\0"
+    "\\ensuremath{\\circ}\0"
+    "\\ensuremath{\\bullet}\0"
+    "\\ensuremath{\\surd}\0"
+    "\\ensuremath{\\propto}\0"
+    "\\ensuremath{\\infty}\0"
+    "\\ensuremath{\\angle}\0"
+    "\\ensuremath{\\mid}\0"
+    "\\ensuremath{\\parallel}\0"
+    "\\ensuremath{\\wedge}\0"
+    "\\ensuremath{\\vee}\0"
+    "\\ensuremath{\\cap}\0"
+    "\\ensuremath{\\cup}\0"
+    "\\ensuremath{\\int}\0"
+    "\\ensuremath{\\oint}\0"
+    "\\ensuremath{\\sim}\0"
+    "\\ensuremath{\\simeq}\0"
+    "\\ensuremath{\\cong}\0"
+    "\\ensuremath{\\approx}\0"
+    "\\ensuremath{\\neq}\0"
+    "\\ensuremath{\\equiv}\0"
+    "\\ensuremath{\\leq}\0"
+    "\\ensuremath{\\geq}\0"
+    "\\ensuremath{\\ll}\0"
+    "\\ensuremath{\\gg}\0"
+    "\\ensuremath{\\subset}\0"
+    "\\ensuremath{\\supset}\0"
+    "\\ensuremath{\\subseteq}\0"
+    "\\ensuremath{\\supseteq}\0"
+    "\\ensuremath{\\oplus}\0"
+    "\\ensuremath{\\otimes}\0"
+    "\\ensuremath{\\perp}\0"
+    "\\ensuremath{\\cdot}\0"
+    "\\ensuremath{\\vdots}\0"
+    "\\ensuremath{\\cdots}\0";
+
+const char* latex_unicode_command(unsigned long code_point) {
+    if (code_point >= LATEX_UNICODE_PAGE_LIMIT) return NULL;
+
+    unsigned char page = LATEX_UNICODE_PAGES[code_point >> 8];
+    if (!page) return NULL;
+
+    unsigned short offset = LATEX_UNICODE_OFFSETS[page - 1][code_point & 0xFF];
+    return offset ? LATEX_UNICODE_POOL + offset : NULL;
+}
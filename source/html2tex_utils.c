@@ -81,7 +81,7 @@ char* html2tex_strdup(const char* str) {
         return NULL;
     }
 
-    char* copy = (char*)malloc(len + 1);
+    char* copy = (char*)html2tex_malloc(len + 1);
 
     if (!copy) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
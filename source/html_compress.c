@@ -0,0 +1,256 @@
+#include "html2tex.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#ifndef HTML2TEX_NO_ZLIB
+#include <zlib.h>
+#endif
+
+struct HTMLCodec {
+    HTMLCompression type;
+    int compress;
+    int finished;
+#ifndef HTML2TEX_NO_ZLIB
+    z_stream stream;
+    unsigned char buffer[HTML_COMPRESSION_CHUNK];
+#endif
+};
+
+/* 1 when the leading bytes decode as a zlib stream, up to the end of the probe */
+static int inflates(const unsigned char* data, size_t length) {
+#ifndef HTML2TEX_NO_ZLIB
+    unsigned char output[4096];
+    const size_t probe = length < HTML_COMPRESSION_PROBE ? length : HTML_COMPRESSION_PROBE;
+    z_stream stream;
+    int status;
+
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit(&stream) != Z_OK) return 0;
+
+    stream.next_in = (unsigned char*)data;
+    stream.avail_in = (uInt)probe;
+    stream.next_out = output;
+    stream.avail_out = sizeof(output);
+
+    /* text fails within a few bytes, a full output buffer is proof enough */
+    status = inflate(&stream, Z_NO_FLUSH);
+    const int produced = stream.avail_out < sizeof(output);
+    const int consumed = stream.avail_in == 0 && probe == HTML_COMPRESSION_PROBE;
+    inflateEnd(&stream);
+
+    /* a short input swallowed without output proves nothing */
+    if (status == Z_STREAM_END) return 1;
+    return (status == Z_OK || status == Z_BUF_ERROR) && (produced || consumed);
+#else
+    /* without zlib the data cannot be verified, so it stays plain text */
+    (void)data;
+    (void)length;
+    return 0;
+#endif
+}
+
+HTMLCompression html_compression_detect(const unsigned char* data, size_t length) {
+    if (!data || length < 2) return HTML_COMPRESSION_NONE;
+
+    if (data[0] == 0x1F && data[1] == 0x8B)
+        return HTML_COMPRESSION_GZIP;
+
+    /* zlib header: deflate method, window up to 32K, no preset dictionary and a valid
+       check value. text such as "x^" or "HK" passes too, so the data must also inflate */
+    if ((data[0] & 0x0F) == 8 && (data[0] >> 4) <= 7 && !(data[1] & 0x20)
+        && ((data[0] << 8) | data[1]) % 31 == 0 && inflates(data, length))
+        return HTML_COMPRESSION_DEFLATE;
+
+    return HTML_COMPRESSION_NONE;
+}
+
+static int has_suffix(const char* path, size_t length, const char* suffix) {
+    const size_t suffix_length = strlen(suffix);
+    size_t i;
+
+    if (length < suffix_length) return 0;
+    path += length - suffix_length;
+
+    for (i = 0; i < suffix_length; i++)
+        if (tolower((unsigned char)path[i]) != suffix[i]) return 0;
+
+    return 1;
+}
+
+HTMLCompression html_compression_from_path(const char* path) {
+    if (!path) return HTML_COMPRESSION_NONE;
+    const size_t length = strlen(path);
+
+    if (has_suffix(path, length, ".gz"))
+        return HTML_COMPRESSION_GZIP;
+
+    if (has_suffix(path, length, ".zz") || has_suffix(path, length, ".deflate"))
+        return HTML_COMPRESSION_DEFLATE;
+
+    return HTML_COMPRESSION_NONE;
+}
+
+int html_compression_available(void) {
+#ifndef HTML2TEX_NO_ZLIB
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+HTMLCodec* html_codec_create(HTMLCompression type, int compress) {
+    html2tex_err_clear();
+
+#ifdef HTML2TEX_NO_ZLIB
+    if (type != HTML_COMPRESSION_NONE) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_UNSUPPORTED,
+            "Compressed streams require zlib, which was not found at build time.");
+        return NULL;
+    }
+#endif
+
+    HTMLCodec* codec = (HTMLCodec*)html2tex_malloc(sizeof(HTMLCodec));
+
+    if (!codec) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate %zu bytes for the stream codec.",
+            sizeof(HTMLCodec));
+        return NULL;
+    }
+
+    codec->type = type;
+    codec->compress = compress != 0;
+    codec->finished = 0;
+
+#ifndef HTML2TEX_NO_ZLIB
+    if (type != HTML_COMPRESSION_NONE) {
+        /* 16 selects the gzip wrapper, 32 lets inflate detect either one */
+        const int window_bits = compress
+            ? (type == HTML_COMPRESSION_GZIP ? MAX_WBITS + 16 : MAX_WBITS)
+            : MAX_WBITS + 32;
+        int status;
+
+        memset(&codec->stream, 0, sizeof(z_stream));
+
+        status = compress
+            ? deflateInit2(&codec->stream, HTML_COMPRESSION_LEVEL, Z_DEFLATED,
+                window_bits, 8, Z_DEFAULT_STRATEGY)
+            : inflateInit2(&codec->stream, window_bits);
+
+        if (status != Z_OK) {
+            HTML2TEX__SET_ERR(status == Z_MEM_ERROR ? HTML2TEX_ERR_NOMEM : HTML2TEX_ERR_INTERNAL,
+                "Failed to initialize the zlib stream (%d).", status);
+            html2tex_free(codec);
+            return NULL;
+        }
+    }
+#endif
+
+    return codec;
+}
+
+int html_codec_process(HTMLCodec* codec, const char* data, size_t length,
+    int finish, HTMLCodecSink sink, void* user_data) {
+    html2tex_err_clear();
+
+    if (!codec || !sink || (!data && length)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Invalid arguments for the stream codec.");
+        return 0;
+    }
+
+    if (codec->type == HTML_COMPRESSION_NONE) {
+        if (finish) codec->finished = 1;
+        if (!length) return 1;
+
+        if (!sink(data, length, user_data)) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
+                "Stream consumer rejected %zu bytes.", length);
+            return 0;
+        }
+
+        return 1;
+    }
+
+#ifndef HTML2TEX_NO_ZLIB
+    z_stream* stream = &codec->stream;
+
+    /* trailing bytes after the end of a compressed member are ignored */
+    if (codec->finished) return 1;
+
+    while (1) {
+        /* zlib counts in uInt, so feed oversized chunks in slices */
+        if (!stream->avail_in && length) {
+            const size_t slice = length > HTML_COMPRESSION_CHUNK
+                ? HTML_COMPRESSION_CHUNK : length;
+
+            stream->next_in = (unsigned char*)data;
+            stream->avail_in = (uInt)slice;
+            data += slice;
+            length -= slice;
+        }
+
+        const int flush = finish && !length ? Z_FINISH : Z_NO_FLUSH;
+        int status;
+
+        stream->next_out = codec->buffer;
+        stream->avail_out = HTML_COMPRESSION_CHUNK;
+
+        status = codec->compress
+            ? deflate(stream, flush)
+            : inflate(stream, Z_NO_FLUSH);
+
+        if (status == Z_NEED_DICT || status == Z_DATA_ERROR
+            || status == Z_STREAM_ERROR || status == Z_MEM_ERROR) {
+            HTML2TEX__SET_ERR(status == Z_MEM_ERROR ? HTML2TEX_ERR_NOMEM : HTML2TEX_ERR_MALFORMED,
+                "Compressed stream is corrupt (%s).",
+                stream->msg ? stream->msg : "zlib error");
+            return 0;
+        }
+
+        const size_t produced = HTML_COMPRESSION_CHUNK - stream->avail_out;
+
+        if (produced && !sink((const char*)codec->buffer, produced, user_data)) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
+                "Stream consumer rejected %zu bytes.", produced);
+            return 0;
+        }
+
+        if (status == Z_STREAM_END) {
+            codec->finished = 1;
+            return 1;
+        }
+
+        /* output space left over means the pending input is consumed */
+        if (stream->avail_out && !stream->avail_in && !length) {
+            if (!codec->compress && finish) {
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_MALFORMED,
+                    "Compressed stream is truncated.");
+                return 0;
+            }
+
+            if (flush != Z_FINISH) return 1;
+        }
+    }
+#else
+    return 0;
+#endif
+}
+
+int html_codec_finished(const HTMLCodec* codec) {
+    return codec ? codec->finished : 0;
+}
+
+void html_codec_destroy(HTMLCodec* codec) {
+    if (!codec) return;
+
+#ifndef HTML2TEX_NO_ZLIB
+    if (codec->type != HTML_COMPRESSION_NONE) {
+        if (codec->compress) deflateEnd(&codec->stream);
+        else inflateEnd(&codec->stream);
+    }
+#endif
+
+    html2tex_free(codec);
+}
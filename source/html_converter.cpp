@@ -2,6 +2,56 @@
 #include <iostream>
 #include <fstream>
 #include <stdexcept>
+#include <cstring>
+
+namespace {
+    int writeDeflated(const char* data, size_t length, void* user_data) {
+        std::ostream* output = static_cast<std::ostream*>(user_data);
+        return output->write(data, static_cast<std::streamsize>(length)) ? 1 : 0;
+    }
+
+    /* writes the document, compressing it chunk by chunk when requested */
+    bool writeOutput(std::ostream& output, HTMLCompression type,
+        const char* data, size_t length) {
+        if (type == HTML_COMPRESSION_NONE)
+            return static_cast<bool>(output.write(data, static_cast<std::streamsize>(length)));
+
+        std::unique_ptr<HTMLCodec, decltype(&html_codec_destroy)> codec(
+            html_codec_create(type, 1), &html_codec_destroy);
+
+        if (!codec) throw LaTeXRuntimeException::fromLaTeXError();
+        return html_codec_process(codec.get(), data, length, 1, &writeDeflated, &output) != 0;
+    }
+
+    ImageManager::DownloadResult toResult(const DownloadResult& image) {
+        ImageManager::DownloadResult result;
+
+        result.url = image.url ? image.url : "";
+        result.local_path = image.local_path ? image.local_path : "";
+        result.success = image.success;
+        result.sequence_number = image.sequence_number;
+        result.content_type = image.content_type ? image.content_type : "";
+        result.filename = image.filename ? image.filename : "";
+
+        if (image.data)
+            result.data.assign(image.data, image.data + image.size);
+
+        return result;
+    }
+
+    /* hands streamed images to the ImageManager::StreamWriter of the converter */
+    int writeDeliveredImage(const DownloadResult* image, const void* data,
+        size_t size, void* user_data) {
+        const auto* writer = static_cast<const ImageManager::StreamWriter*>(user_data);
+
+        try {
+            return (*writer)(toResult(*image), data, size) ? 1 : 0;
+        }
+        catch (...) {
+            return 0;
+        }
+    }
+}
 
 HtmlTeXConverter::HtmlTeXConverter() : converter(nullptr, &html2tex_destroy), valid(false),
 downloads_enabled(false), image_directory(""), image_manager(nullptr) {
@@ -27,6 +77,7 @@ downloads_enabled(false), image_directory(""), image_manager(nullptr) {
         if (clone) {
             downloads_enabled = other.downloads_enabled;
             image_directory = other.image_directory;
+            image_writer = other.image_writer;
 
             converter.reset(clone);
             valid = true;
@@ -43,7 +94,8 @@ HtmlTeXConverter::HtmlTeXConverter(HtmlTeXConverter&& other) noexcept
     : converter(std::move(other.converter)), valid(other.valid), 
     downloads_enabled(other.downloads_enabled), 
     image_directory(other.image_directory),
-    image_manager(std::move(other.image_manager)) {
+    image_manager(std::move(other.image_manager)),
+    image_writer(std::move(other.image_writer)) {
     other.downloads_enabled = false;
     other.image_directory = "";
 
@@ -86,6 +138,65 @@ bool HtmlTeXConverter::enableLazyDownloading(bool enabled) {
     return true;
 }
 
+bool HtmlTeXConverter::setImageFetcher(ImageFetcher* fetcher) noexcept {
+    if (!converter || !valid)
+        return false;
+
+    /* refused while a memory or stream delivery is selected */
+    html2tex_err_clear();
+    html2tex_set_image_fetcher(converter.get(), fetcher);
+    return !html2tex_has_error();
+}
+
+void HtmlTeXConverter::setImageDelivery(ImageManager::Delivery mode,
+    ImageManager::StreamWriter writer) {
+    if (!converter || !valid)
+        THROW_RUNTIME_ERROR(
+            "HtmlTeXConverter:"
+            " Converter not "
+            "initialized.", -1);
+
+    if (mode == ImageManager::Delivery::Stream && !writer)
+        throw std::invalid_argument(
+            "Stream delivery requires a writer.");
+
+    /* the C converter keeps a pointer, copies of this converter share the function */
+    std::shared_ptr<ImageManager::StreamWriter> stream;
+    ImageStreamWriter bridge = { nullptr, &writeDeliveredImage };
+    ImageDelivery delivery = IMAGE_DELIVERY_FILE;
+
+    if (mode == ImageManager::Delivery::Memory)
+        delivery = IMAGE_DELIVERY_MEMORY;
+    else if (mode == ImageManager::Delivery::Stream) {
+        stream = std::make_shared<ImageManager::StreamWriter>(std::move(writer));
+        delivery = IMAGE_DELIVERY_STREAM;
+    }
+
+    html2tex_err_clear();
+    html2tex_set_image_delivery(converter.get(), delivery, &bridge, stream.get());
+
+    if (html2tex_has_error())
+        throw LaTeXRuntimeException::fromLaTeXError();
+
+    image_writer = std::move(stream);
+}
+
+std::vector<ImageManager::DownloadResult> HtmlTeXConverter::getDeliveredImages() const {
+    std::vector<ImageManager::DownloadResult> images;
+    if (!converter || !valid) return images;
+
+    size_t count = 0;
+    const DownloadResult* const* delivered =
+        html2tex_get_delivered_images(converter.get(), &count);
+
+    images.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+        images.push_back(toResult(*delivered[i]));
+
+    return images;
+}
+
 ImageManager& HtmlTeXConverter::getImageManager() {
     if (!converter || !valid)
         THROW_RUNTIME_ERROR(
@@ -94,7 +205,11 @@ ImageManager& HtmlTeXConverter::getImageManager() {
             "initialized.", -1);
 
     if (!image_manager) {
-        image_manager = std::make_unique<ImageManager>();
+        ImageFetcher* fetcher = converter.get()->fetcher;
+
+        image_manager = fetcher
+            ? std::make_unique<ImageManager>(*fetcher)
+            : std::make_unique<ImageManager>();
 
         /* check if image directory is set */
         if (image_directory.empty()) {
@@ -132,18 +247,23 @@ std::vector<ImageManager::DownloadRequest> HtmlTeXConverter::getImages() {
         if (count > 0) {
             for (size_t i = 0; i < count; i++) {
                 std::string full_path = std::string(filenames[i]);
-                std::free(filenames[i]);
+                html2tex_free(filenames[i]);
                 ImageManager::DownloadRequest req{ full_path, image_directory, (int)(i + 1) };
                 batch.emplace_back(req);
             }
 
-            std::free(filenames);
+            html2tex_free(filenames);
         }
     }
 
     return batch;
 }
 
+size_t HtmlTeXConverter::getImageDedupHits() const noexcept {
+    if (!converter || !valid) return 0;
+    return html2tex_get_image_dedup_hits(converter.get());
+}
+
 void HtmlTeXConverter::downloadImageListAsync(std::vector<ImageManager::DownloadRequest> imageList) {
     if (imageList.size() > 0) {
         ImageManager& imageManager = getImageManager();
@@ -190,7 +310,7 @@ std::string HtmlTeXConverter::convert(const std::string& html) const {
     }
 
     /* ensures memory is freed even on exceptions */
-    const auto deleter = [](char* p) noexcept { if (p) std::free(p); };
+    const auto deleter = [](char* p) noexcept { if (p) html2tex_free(p); };
     std::unique_ptr<char[], decltype(deleter)> result_guard(raw_result, deleter);
 
     /* check if result is actually empty */
@@ -217,7 +337,7 @@ bool HtmlTeXConverter::convertToFile(const std::string& html, const std::string&
     std::unique_ptr<char[], void(*)(char*)> result(
         html2tex_convert(converter.get(), html.c_str()),
         [](char* p) noexcept { 
-            std::free(p); 
+            html2tex_free(p); 
         });
 
     if (!result) {
@@ -229,14 +349,19 @@ bool HtmlTeXConverter::convertToFile(const std::string& html, const std::string&
         return false;
     }
 
-    /* write the file */
-    std::ofstream fout(filePath);
+    /* write the file, ".gz" and ".zz" paths are compressed */
+    const HTMLCompression compression = html_compression_from_path(filePath.c_str());
+    std::ofstream fout(filePath, compression != HTML_COMPRESSION_NONE
+        ? std::ios::binary | std::ios::trunc : std::ios::out);
 
     if (!fout)
         throw std::runtime_error(
             "Cannot open output file.");
 
-    fout << result.get();
+    if (!writeOutput(fout, compression, result.get(), std::strlen(result.get())))
+        throw std::runtime_error(
+            "Failed to write LaTeX output.");
+
     fout.flush();
 
     if (!fout)
@@ -264,7 +389,7 @@ std::string HtmlTeXConverter::convert(const HtmlParser& parser) const {
         html.c_str());
 
     /* RAII management with custom deleter */
-    const auto deleter = [](char* p) noexcept { std::free(p); };
+    const auto deleter = [](char* p) noexcept { html2tex_free(p); };
     std::unique_ptr<char[], decltype(deleter)> result_guard(raw_result, deleter);
 
     /* error analysis */
@@ -304,7 +429,7 @@ bool HtmlTeXConverter::convertToFile(const HtmlParser& parser, const std::string
 
     /* RAII with custom deleter */
     const auto deleter = [](char* p) noexcept {
-        if (p) std::free(p);
+        if (p) html2tex_free(p);
     };
 
     std::unique_ptr<char[], decltype(deleter)> result_guard(raw_result, deleter);
@@ -337,8 +462,9 @@ bool HtmlTeXConverter::convertToFile(const HtmlParser& parser, const std::string
     /* get result length once */
     const size_t result_len = std::strlen(raw_result);
 
-    /* write entire result in one operation */
-    if (!fout.write(raw_result, static_cast<std::streamsize>(result_len)))
+    /* write entire result in one operation, compressed for archive paths */
+    if (!writeOutput(fout, html_compression_from_path(filePath.c_str()),
+        raw_result, result_len))
         throw std::runtime_error(
             "Failed to write LaTeX"
             " output to: " 
@@ -382,7 +508,7 @@ bool HtmlTeXConverter::convertToFile(const HtmlParser& parser, std::ofstream& ou
     /* RAII with custom deleter */
     const auto deleter = [](char* p) noexcept {
         /* free handles nullptr */
-        std::free(p);
+        html2tex_free(p);
     };
 
     std::unique_ptr<char[], decltype(deleter)> result_guard(raw_result, deleter);
@@ -447,6 +573,7 @@ HtmlTeXConverter& HtmlTeXConverter::operator =(const HtmlTeXConverter& other) {
             if (clone) {
                 downloads_enabled = other.downloads_enabled;
                 image_directory = other.image_directory;
+                image_writer = other.image_writer;
 
                 temp.reset(clone);
                 new_valid = true;
@@ -474,6 +601,7 @@ HtmlTeXConverter& HtmlTeXConverter::operator =(HtmlTeXConverter&& other) noexcep
 
         converter = std::move(other.converter);
         image_manager = std::move(other.image_manager);
+        image_writer = std::move(other.image_writer);
 
         valid = other.valid;
         other.valid = false;
@@ -1,6 +1,42 @@
 #include "ext/html_document.hpp"
+#include "html2tex_alloc.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+
+/* id, class and tag lookup tables, each bucket in document order */
+struct HtmlDocument::DocumentIndex {
+    std::unordered_map<std::string, std::vector<HTMLNode*>> ids;
+    std::unordered_map<std::string, std::vector<HTMLNode*>> classes;
+    std::unordered_map<std::string, std::vector<HTMLNode*>> tags;
+};
+
+/* shared by the copies of a document, so invalidating one makes the index stale for all */
+struct HtmlDocument::IndexSlot {
+    std::mutex mutex;
+    std::shared_ptr<const DocumentIndex> index;
+    unsigned long built = 0; /* index generation the index was built at */
+};
+
+namespace {
+    /* splits a class attribute into its whitespace-separated tokens */
+    std::vector<std::string> splitClassTokens(const char* value) {
+        std::vector<std::string> tokens;
+        const char* p = value;
+
+        while (*p) {
+            while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r' || *p == '\f') p++;
+            const char* start = p;
+
+            while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r' && *p != '\f') p++;
+            if (p > start) tokens.emplace_back(start, (size_t)(p - start));
+        }
+
+        return tokens;
+    }
+}
 
 HtmlDocument::HtmlDocument() noexcept
     : node(nullptr), props(nullptr), hasProps(false) {
@@ -21,7 +57,7 @@ HtmlDocument::HtmlDocument(HTMLElement* elem) noexcept
         props = elem->css_props;
 
         /* destroy container only */
-        std::free(elem);
+        html2tex_free(elem);
 
         if (props != nullptr)
             hasProps = true;
@@ -29,7 +65,9 @@ HtmlDocument::HtmlDocument(HTMLElement* elem) noexcept
 }
 
 HtmlDocument::HtmlDocument(const HtmlDocument& other)
-    : node(other.node), props(nullptr), hasProps(false) {
+    : node(other.node), props(nullptr), hasProps(false),
+    index(other.node ? other.indexSlot() : nullptr),
+    generation(other.node ? other.indexGeneration() : nullptr) {
     if (other.props) {
         try {
             props = css_properties_copy(other.props);
@@ -42,7 +80,8 @@ HtmlDocument::HtmlDocument(const HtmlDocument& other)
 }
 
 HtmlDocument::HtmlDocument(HtmlDocument&& other) noexcept
-    : node(other.node), props(other.props), hasProps(other.hasProps) {
+    : node(other.node), props(other.props), hasProps(other.hasProps),
+    index(std::move(other.index)), generation(std::move(other.generation)) {
     other.node = nullptr;
     other.props = nullptr;
     other.hasProps = false;
@@ -56,6 +95,10 @@ HtmlDocument& HtmlDocument::operator=(const HtmlDocument& other) {
 
         node = other.node;
 
+        /* copies share one slot, so invalidating either reaches both */
+        index = other.node ? other.indexSlot() : nullptr;
+        generation = other.node ? other.indexGeneration() : nullptr;
+
         if (other.props) {
             try {
                 props = css_properties_copy(other.props);
@@ -83,6 +126,8 @@ HtmlDocument& HtmlDocument::operator=(HtmlDocument&& other) noexcept {
         node = other.node;
         props = other.props;
         hasProps = other.hasProps;
+        index = std::move(other.index);
+        generation = std::move(other.generation);
 
         other.node = nullptr;
         other.props = nullptr;
@@ -123,7 +168,7 @@ CSSProperties* HtmlDocument::cssProperties() const noexcept {
 
 HtmlDocument HtmlDocument::parent() const noexcept {
     if (!node || !node->parent) return HtmlDocument();
-    return HtmlDocument(node->parent);
+    return related(node->parent);
 }
 
 bool HtmlDocument::hasParent() const noexcept {
@@ -132,7 +177,7 @@ bool HtmlDocument::hasParent() const noexcept {
 
 HtmlDocument HtmlDocument::nextSibling() const noexcept {
     if (!node || !node->next) return HtmlDocument();
-    return HtmlDocument(node->next);
+    return related(node->next);
 }
 
 HtmlDocument HtmlDocument::previousSibling() const noexcept {
@@ -149,7 +194,7 @@ HtmlDocument HtmlDocument::previousSibling() const noexcept {
         child = child->next;
     }
 
-    return prev ? HtmlDocument(prev) 
+    return prev ? related(prev) 
         : HtmlDocument();
 }
 
@@ -166,7 +211,7 @@ bool HtmlDocument::hasPreviousSibling() const noexcept {
 
 HtmlDocument HtmlDocument::firstChild() const noexcept {
     if (!node || !node->children) return HtmlDocument();
-    return HtmlDocument(node->children);
+    return related(node->children);
 }
 
 HtmlDocument HtmlDocument::lastChild() const noexcept {
@@ -177,7 +222,7 @@ HtmlDocument HtmlDocument::lastChild() const noexcept {
     while (child->next)
         child = child->next;
 
-    return HtmlDocument(child);
+    return related(child);
 }
 
 bool HtmlDocument::hasChildren() const noexcept {
@@ -191,7 +236,7 @@ std::vector<HtmlDocument> HtmlDocument::children() const {
 
     while (child) {
         result.emplace_back(
-            HtmlDocument(child));
+            related(child));
         child = child->next;
     }
 
@@ -236,97 +281,102 @@ bool HtmlDocument::shouldExclude() const {
     return should_exclude_tag(node->tag) != 0;
 }
 
-int HtmlDocument::getElementByIdPredicate(const HTMLNode* root, const void* data) {
-    if (!root || !root->tag) return 0;
-    
-    if (root->attributes) {
-        const char* value = get_attribute(root->attributes, "id");
-        return (value && std::strcmp(value, (const char*)data) == 0);
-    }
-
-    return 0;
-}
-
-int HtmlDocument::getElementByClassPredicate(const HTMLNode* root, const void* data) {
-    if (!root || !root->tag) return 0;
-
-    if (root->attributes) {
-        const char* className = get_attribute(root->attributes, "class");
-        return (className && std::strcmp(className, (const char*)data) == 0);
-    }
-
-    return 0;
-}
-
 HtmlDocument HtmlDocument::getFirstElementById(const std::string& id) const {
-    return findFirst(
-        &getElementByIdPredicate,
-        id);
+    if (!node) return HtmlDocument();
+    const std::shared_ptr<const DocumentIndex> idx = documentIndex();
+
+    auto it = idx->ids.find(id);
+    if (it == idx->ids.end()) return HtmlDocument();
+    return makeElement(it->second.front());
 }
 
-HtmlDocument HtmlDocument::findFirst(DOMTreeVisitor predicate, const std::string& content) const {
+HtmlDocument HtmlDocument::findFirst(DOMTreeVisitor predicate, const std::string& content,
+    bool computeStyles) const {
     if (!node) return HtmlDocument();
 
-    HTMLElement* found = html2tex_search_tree(
+    HTMLElement* found = html2tex_search_tree_ex(
         node, predicate,
         (const void*)content.c_str(),
-        props
+        props, computeStyles ? HTML2TEX_QUERY_STYLES
+        : HTML2TEX_QUERY_NO_STYLES
     );
 
-    if (found)
-        return HtmlDocument(found);
-    return HtmlDocument();
+    if (!found) return HtmlDocument();
+
+    HtmlDocument document(found);
+    document.generation = indexGeneration();
+    return document;
 }
 
 bool HtmlDocument::hasElementWithId(const std::string& id) const {
-    return hasAnyElement(
-        &getElementByIdPredicate,
-        id);
+    if (!node) return false;
+    const std::shared_ptr<const DocumentIndex> idx = documentIndex();
+    return idx->ids.find(id) != idx->ids.end();
 }
 
 bool HtmlDocument::hasElementWithClass(const std::string& className) const {
-    return hasAnyElement(
-        &getElementByClassPredicate,
-        className);
+    if (!node) return false;
+    return !indexedClassMatches(className).empty();
 }
 
 bool HtmlDocument::hasAnyElement(DOMTreeVisitor predicate, const std::string content) const {
+    /* existence checks never need computed styles */
     return findFirst(
         predicate,
-        content
+        content,
+        false
     ).isValid();
 }
 
 std::vector<HtmlDocument> HtmlDocument::findAllElementsById(const std::string& id) const {
-    return findAll(
-        &getElementByIdPredicate,
-        id);
+    std::vector<HtmlDocument> result;
+    if (!node) return result;
+
+    const std::shared_ptr<const DocumentIndex> idx = documentIndex();
+    auto it = idx->ids.find(id);
+    if (it == idx->ids.end()) return result;
+
+    result.reserve(it->second.size());
+
+    for (HTMLNode* match : it->second) {
+        HtmlDocument document = makeElement(match);
+        if (document.isValid())
+            result.emplace_back(std::move(document));
+    }
+
+    return result;
 }
 
-std::vector<HtmlDocument> HtmlDocument::findAll(DOMTreeVisitor predicate, const std::string& content) const {
+std::vector<HtmlDocument> HtmlDocument::findAll(DOMTreeVisitor predicate, const std::string& content,
+    bool computeStyles) const {
     std::vector<HtmlDocument> result;
     if (!node) return result;
 
-    HTMLNodeList* list = html2tex_find_all(
+    HTMLNodeList* list = html2tex_find_all_ex(
         node, predicate,
         (const void*)content.c_str(),
-        props
+        props, computeStyles ? HTML2TEX_QUERY_STYLES
+        : HTML2TEX_QUERY_NO_STYLES
     );
 
     if (list) {
         size_t count = list->node_count;
         result.reserve(count);
 
-        /* get array of matching elements */
-        HTMLElement** elements = html_nodelist_dismantle(&list);
+        /* take the element array, CSS ownership moves to each document */
+        HTMLElement* elements = html_nodelist_dismantle(&list);
 
         if (elements) {
+            const std::shared_ptr<std::atomic<unsigned long>> shared = indexGeneration();
+
             for (size_t i = 0; i < count; ++i) {
-                HtmlDocument document = HtmlDocument(elements[i]);
-                result.emplace_back(document);
+                HtmlDocument document(elements[i].node, elements[i].css_props);
+                document.hasProps = elements[i].css_props != nullptr;
+                document.generation = shared;
+                result.emplace_back(std::move(document));
             }
 
-            free(elements);
+            html2tex_free(elements);
         }
 
         /* destroy the list, but keep the ownership */
@@ -336,16 +386,273 @@ std::vector<HtmlDocument> HtmlDocument::findAll(DOMTreeVisitor predicate, const
     return result;
 }
 
+HtmlDocument HtmlDocument::querySelector(const std::string& selector) const {
+    return querySelector(CssSelector(selector));
+}
+
+HtmlDocument HtmlDocument::querySelector(const CssSelector& selector) const {
+    if (!node) return HtmlDocument();
+    std::vector<HTMLNode*> matches = selectorMatches(selector, true);
+
+    if (matches.empty()) return HtmlDocument();
+    return makeElement(matches.front());
+}
+
+std::vector<HtmlDocument> HtmlDocument::querySelectorAll(const std::string& selector) const {
+    return querySelectorAll(CssSelector(selector));
+}
+
+std::vector<HtmlDocument> HtmlDocument::querySelectorAll(const CssSelector& selector) const {
+    std::vector<HtmlDocument> result;
+    if (!node) return result;
+
+    std::vector<HTMLNode*> matches = selectorMatches(selector, false);
+    result.reserve(matches.size());
+
+    for (HTMLNode* match : matches) {
+        HtmlDocument document = makeElement(match);
+        if (document.isValid())
+            result.emplace_back(std::move(document));
+    }
+
+    return result;
+}
+
 HtmlDocument HtmlDocument::getFirstElementByClassName(const std::string& className) const {
-    return findFirst(
-        &getElementByClassPredicate,
-        className);
+    if (!node) return HtmlDocument();
+    std::vector<HTMLNode*> matches = indexedClassMatches(className);
+
+    if (matches.empty()) return HtmlDocument();
+    return makeElement(matches.front());
 }
 
 std::vector<HtmlDocument> HtmlDocument::findAllElementsByClassName(const std::string& className) const {
-    return findAll(
-        &getElementByClassPredicate,
-        className);
+    std::vector<HtmlDocument> result;
+    if (!node) return result;
+
+    std::vector<HTMLNode*> matches = indexedClassMatches(className);
+    result.reserve(matches.size());
+
+    for (HTMLNode* match : matches) {
+        HtmlDocument document = makeElement(match);
+        if (document.isValid())
+            result.emplace_back(std::move(document));
+    }
+
+    return result;
+}
+
+std::shared_ptr<HtmlDocument::IndexSlot> HtmlDocument::indexSlot() const {
+    std::shared_ptr<IndexSlot> slot = std::atomic_load(&index);
+    if (slot) return slot;
+
+    /* a concurrent query may install its slot first, then that one is used */
+    std::shared_ptr<IndexSlot> fresh = std::make_shared<IndexSlot>();
+    if (std::atomic_compare_exchange_strong(&index, &slot, fresh))
+        return fresh;
+
+    return slot;
+}
+
+std::shared_ptr<std::atomic<unsigned long>> HtmlDocument::indexGeneration() const {
+    std::shared_ptr<std::atomic<unsigned long>> current = std::atomic_load(&generation);
+    if (current) return current;
+
+    std::shared_ptr<std::atomic<unsigned long>> fresh =
+        std::make_shared<std::atomic<unsigned long>>(0);
+    if (std::atomic_compare_exchange_strong(&generation, &current, fresh))
+        return fresh;
+
+    return current;
+}
+
+HtmlDocument HtmlDocument::related(HTMLNode* target) const {
+    HtmlDocument document(target);
+    if (target) document.generation = indexGeneration();
+    return document;
+}
+
+std::shared_ptr<const HtmlDocument::DocumentIndex> HtmlDocument::documentIndex() const {
+    std::shared_ptr<IndexSlot> slot = indexSlot();
+
+    /* read before building, an invalidation racing the build leaves it stale */
+    const unsigned long current = indexGeneration()->load();
+    std::lock_guard<std::mutex> lock(slot->mutex);
+
+    if (slot->index && slot->built == current) return slot->index;
+    std::shared_ptr<DocumentIndex> built = std::make_shared<DocumentIndex>();
+
+    /* pre-order DFS keeps every bucket in document order */
+    std::vector<HTMLNode*> pending;
+    pending.push_back(node);
+
+    while (!pending.empty()) {
+        HTMLNode* current = pending.back();
+        pending.pop_back();
+
+        if (current->tag) {
+            built->tags[current->tag].push_back(current);
+            const char* id = get_hot_attribute(current, HTML_ATTR_ID);
+            if (id) built->ids[id].push_back(current);
+
+            const char* classes = get_hot_attribute(current, HTML_ATTR_CLASS);
+
+            if (classes) {
+                std::vector<std::string> seen;
+
+                for (std::string& token : splitClassTokens(classes)) {
+                    /* an element appears once per bucket even if a token repeats */
+                    if (std::find(seen.begin(), seen.end(), token) != seen.end())
+                        continue;
+
+                    built->classes[token].push_back(current);
+                    seen.push_back(std::move(token));
+                }
+            }
+        }
+
+        /* push children in reverse so the first child is visited next */
+        size_t mark = pending.size();
+
+        for (HTMLNode* child = current->children; child; child = child->next)
+            pending.push_back(child);
+
+        std::reverse(pending.begin() + mark, pending.end());
+    }
+
+    slot->index = built;
+    slot->built = current;
+    return slot->index;
+}
+
+std::vector<HTMLNode*> HtmlDocument::indexedClassMatches(const std::string& className) const {
+    std::vector<HTMLNode*> matches;
+    std::vector<std::string> tokens = splitClassTokens(className.c_str());
+    if (tokens.empty()) return matches;
+
+    /* a repeated token adds no constraint */
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+    /* the smallest bucket bounds the result, its nodes are checked against the sorted tokens */
+    const std::shared_ptr<const DocumentIndex> idx = documentIndex();
+    const std::vector<HTMLNode*>* smallest = nullptr;
+
+    for (const std::string& token : tokens) {
+        auto it = idx->classes.find(token);
+        if (it == idx->classes.end()) return matches;
+        if (!smallest || it->second.size() < smallest->size()) smallest = &it->second;
+    }
+
+    if (tokens.size() == 1)
+        return *smallest;
+
+    for (HTMLNode* candidate : *smallest) {
+        std::vector<std::string> own = splitClassTokens(
+            get_hot_attribute(candidate, HTML_ATTR_CLASS));
+        std::sort(own.begin(), own.end());
+
+        if (std::includes(own.begin(), own.end(), tokens.begin(), tokens.end()))
+            matches.push_back(candidate);
+    }
+
+    return matches;
+}
+
+std::vector<HTMLNode*> HtmlDocument::selectorMatches(const CssSelector& selector, bool firstOnly) const {
+    std::vector<HTMLNode*> matches;
+
+    /* one position cache per query, a document root stands in as the parent of top-level nodes */
+    CSSMatchContext context;
+    css_match_context_init(&context, node->tag ? nullptr : node);
+
+    std::unique_ptr<CSSMatchContext, decltype(&css_match_context_cleanup)> contextGuard(
+        &context, &css_match_context_cleanup);
+
+    const CSSSelector* compiled = selector.compiled.get();
+
+    if (compiled->count == 1) {
+        /* seed candidates from the most selective index bucket of the subject */
+        const CSSCompound& subject = compiled->alternatives[0]->compounds[0];
+        const std::vector<HTMLNode*>* bucket = nullptr;
+        const std::shared_ptr<const DocumentIndex> idx = documentIndex();
+        static const std::vector<HTMLNode*> none;
+
+        if (subject.id) {
+            auto it = idx->ids.find(subject.id);
+            bucket = it != idx->ids.end() ? &it->second : &none;
+        }
+        else if (subject.class_count > 0) {
+            auto it = idx->classes.find(subject.classes[0]);
+            bucket = it != idx->classes.end() ? &it->second : &none;
+        }
+        else if (subject.tag) {
+            auto it = idx->tags.find(subject.tag);
+            bucket = it != idx->tags.end() ? &it->second : &none;
+        }
+
+        if (bucket) {
+            for (HTMLNode* candidate : *bucket) {
+                if (candidate == node || !css_selector_matches(compiled, candidate, &context))
+                    continue;
+
+                matches.push_back(candidate);
+                if (firstOnly) break;
+            }
+
+            return matches;
+        }
+    }
+
+    /* no usable bucket, walk the descendants in document order */
+    std::vector<HTMLNode*> pending;
+
+    for (HTMLNode* child = node->children; child; child = child->next)
+        pending.push_back(child);
+
+    std::reverse(pending.begin(), pending.end());
+
+    while (!pending.empty()) {
+        HTMLNode* current = pending.back();
+        pending.pop_back();
+
+        if (css_selector_matches(compiled, current, &context)) {
+            matches.push_back(current);
+            if (firstOnly) break;
+        }
+
+        size_t mark = pending.size();
+
+        for (HTMLNode* child = current->children; child; child = child->next)
+            pending.push_back(child);
+
+        std::reverse(pending.begin() + mark, pending.end());
+    }
+
+    return matches;
+}
+
+HtmlDocument HtmlDocument::makeElement(HTMLNode* target) const {
+    CSSProperties* computed = html2tex_compute_style(target, node, props);
+    if (!computed) return HtmlDocument();
+
+    HtmlDocument element(target, computed);
+    element.hasProps = true;
+    element.generation = indexGeneration();
+    return element;
+}
+
+void HtmlDocument::invalidateIndex() const noexcept {
+    /* documents reached from this one, or this one from, share the generation */
+    std::shared_ptr<std::atomic<unsigned long>> shared = std::atomic_load(&generation);
+    if (shared) shared->fetch_add(1);
+
+    std::shared_ptr<IndexSlot> slot = std::atomic_load(&index);
+    if (!slot) return;
+
+    /* queries already running keep the snapshot they hold */
+    std::lock_guard<std::mutex> lock(slot->mutex);
+    slot->index.reset();
 }
 
 HtmlDocument::~HtmlDocument() {
@@ -354,15 +661,19 @@ HtmlDocument::~HtmlDocument() {
 }
 
 HtmlDocument::Iterator HtmlDocument::begin() {
-    return Iterator(node ? node->children : nullptr, props);
+    Iterator it(node ? node->children : nullptr, props);
+    if (it.current) it.element.generation = indexGeneration();
+    return it;
 }
 
 HtmlDocument::ConstIterator HtmlDocument::begin() const {
-    return ConstIterator(node ? node->children : nullptr, props);
+    return cbegin();
 }
 
 HtmlDocument::ConstIterator HtmlDocument::cbegin() const {
-    return ConstIterator(node ? node->children : nullptr, props);
+    ConstIterator it(node ? node->children : nullptr, props);
+    if (it.current) it.element.generation = indexGeneration();
+    return it;
 }
 
 HtmlDocument::Iterator HtmlDocument::end() {
@@ -404,7 +715,11 @@ HtmlDocument::Iterator::pointer HtmlDocument::Iterator::operator->() noexcept {
 HtmlDocument::Iterator& HtmlDocument::Iterator::operator++() noexcept {
     if (current) {
         current = current->next;
+
+        /* siblings stay in the generation of the iterated document */
+        std::shared_ptr<std::atomic<unsigned long>> shared = std::move(element.generation);
         element = HtmlDocument(current, props);
+        if (current) element.generation = std::move(shared);
     }
 
     return *this;
@@ -445,7 +760,10 @@ HtmlDocument::ConstIterator::pointer HtmlDocument::ConstIterator::operator->() c
 HtmlDocument::ConstIterator& HtmlDocument::ConstIterator::operator++() noexcept {
     if (current) {
         current = current->next;
+
+        std::shared_ptr<std::atomic<unsigned long>> shared = std::move(element.generation);
         element = HtmlDocument(const_cast<HTMLNode*>(current), props);
+        if (current) element.generation = std::move(shared);
     }
 
     return *this;
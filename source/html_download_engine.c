@@ -0,0 +1,1304 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "html2tex.h"
+#include <curl/curl.h>
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct DownloadTransfer DownloadTransfer;
+typedef struct DownloadHost DownloadHost;
+typedef struct DownloadLoop DownloadLoop;
+
+/* one submitted download, url, path and host key are stored after the struct */
+struct DownloadTransfer {
+    const char* url;
+    const char* path;
+    const char* host_key;
+    FILE* file;
+    CURL* easy;
+    int open_error;
+
+    /* receives the body instead of file when sink.write is set */
+    HTMLDownloadSink sink;
+    int sink_begun;
+    int sink_refused;
+    char content_type[128];
+
+    /* cache bookkeeping, unused without a cache */
+    HTMLImageCache* store_into;
+    HTMLCacheValidators cached;
+    HTMLCacheValidators response;
+    struct curl_slist* conditions;
+    int revalidating;
+    int materialized;
+
+    /* host it waits on or holds a connection of, NULL when started unscheduled */
+    DownloadHost* host;
+    size_t retries;
+    long retry_after;
+
+    HTMLDownloadCallback callback;
+    void* user_data;
+
+    DownloadTransfer* prev;
+    DownloadTransfer* next;
+};
+
+/* longest sleep of a loop in curl_multi_poll, bounds how long it keeps a busy executor waiting */
+#define LOOP_POLL_MS 100
+
+/* sleep of a loop about to yield, so loops sharing busy workers wait on sockets instead of spinning */
+#define LOOP_YIELD_POLL_MS 10
+
+/* hash buckets of the hosts a loop keeps, also the host count below which none is evicted */
+#define LOOP_HOST_BUCKETS 64
+
+/* scheduling state of one scheme, host and port, kept while it has transfers or throttling
+   to remember so its window and backoff outlast idle periods, the key is stored after the struct */
+struct DownloadHost {
+    const char* key;
+    size_t hash;
+    DownloadHost* chain;
+
+    /* ring of hosts with waiting transfers, served round-robin */
+    DownloadHost* ring_prev;
+    DownloadHost* ring_next;
+
+    DownloadTransfer* waiting_head;
+    DownloadTransfer* waiting_tail;
+    size_t active;
+
+    /* AIMD connection window, halved on 429 or 503 and regrown by one per window of answers,
+       slower past the window the host last throttled at */
+    double window;
+    double ceiling;
+
+    /* token bucket of host_rate, unused without a rate */
+    double tokens;
+    uint64_t refilled_at;
+
+    /* no transfer starts before resume_at, set by Retry-After or throttling at a window of one */
+    uint64_t resume_at;
+    long backoff;
+};
+
+/* a curl_multi handle, driven by an executor task while it has transfers */
+struct DownloadLoop {
+    HTMLDownloadEngine* engine;
+    CURLM* multi;
+    HTMLExecutorTask task;
+
+    /* 1 while the task is posted or running, whoever sets it posts the task */
+    atomic_size_t scheduled;
+
+    /* submissions waiting for the loop, taken by the loop or a cancelling thread */
+    HTMLWorkQueue* queue;
+
+    /* submissions that found the queue full, guarded by mutex, which also
+       orders the release of the task against html_download_engine_destroy() */
+    mutex_t mutex;
+    cond_t released;
+    DownloadTransfer* overflow_head;
+    DownloadTransfer* overflow_tail;
+    atomic_size_t overflowed;
+
+    /* transfers submitted and not completed yet */
+    atomic_size_t pending;
+    atomic_size_t cancel;
+    atomic_size_t stopping;
+
+    /* set while the loop sleeps in curl_multi_poll, only then do submitters wake it */
+    atomic_size_t polling;
+
+    /* owned by the running loop task */
+    DownloadTransfer* running;
+    CURL** idle;
+    size_t idle_count;
+
+    /* host scheduler, owned by the running loop task, ready points at the host served next */
+    DownloadHost* hosts[LOOP_HOST_BUCKETS];
+    DownloadHost* ready;
+    size_t ready_count;
+    size_t active;
+
+    /* hosts in the table, idle ones are evicted once it doubles since the last sweep,
+       the count is read by html_download_engine_hosts() */
+    atomic_size_t host_count;
+    size_t host_sweep_at;
+};
+
+struct HTMLDownloadEngine {
+    HTMLDownloadOptions options;
+    HTMLExecutorPool* pool;
+    DownloadLoop* loops;
+    size_t loop_count;
+
+    CURLSH* share;
+    mutex_t share_locks[CURL_LOCK_DATA_LAST];
+};
+
+static void share_lock(CURL* handle, curl_lock_data data,
+    curl_lock_access access, void* user_data) {
+    HTMLDownloadEngine* engine = (HTMLDownloadEngine*)user_data;
+    (void)handle;
+    (void)access;
+    mutex_lock(&engine->share_locks[data]);
+}
+
+static void share_unlock(CURL* handle, curl_lock_data data, void* user_data) {
+    HTMLDownloadEngine* engine = (HTMLDownloadEngine*)user_data;
+    (void)handle;
+    mutex_unlock(&engine->share_locks[data]);
+}
+
+/* announces the body to the sink, 0 when it refuses the image */
+static int begin_sink(DownloadTransfer* transfer) {
+    transfer->sink_begun = 1;
+
+    if (transfer->sink.begin && !transfer->sink.begin(transfer->content_type[0]
+        ? transfer->content_type : NULL, transfer->user_data)) {
+        transfer->sink_refused = 1;
+        return 0;
+    }
+
+    return 1;
+}
+
+static size_t write_body(char* data, size_t size, size_t count, void* user_data) {
+    DownloadTransfer* transfer = (DownloadTransfer*)user_data;
+    long status = 0;
+
+    /* error pages are drained without creating the destination */
+    curl_easy_getinfo(transfer->easy, CURLINFO_RESPONSE_CODE, &status);
+    if (status != 200) return size * count;
+
+    if (transfer->sink.write) {
+        if (!transfer->sink_begun && !begin_sink(transfer))
+            return 0;
+
+        if (!transfer->sink.write(data, size * count, transfer->user_data)) {
+            transfer->sink_refused = 1;
+            return 0;
+        }
+
+        return size * count;
+    }
+
+    if (!transfer->file) {
+        /* replaced rather than truncated, it may be linked to a cached image */
+        remove(transfer->path);
+        transfer->file = fopen(transfer->path, "wb");
+
+        if (!transfer->file) {
+            transfer->open_error = errno;
+            return 0;
+        }
+    }
+
+    return fwrite(data, size, count, transfer->file);
+}
+
+/* copies a header value without surrounding blanks */
+static void copy_header_value(char* dest, size_t size, const char* value, size_t length) {
+    while (length && (*value == ' ' || *value == '\t')) {
+        value++;
+        length--;
+    }
+
+    while (length && (value[length - 1] == '\r' || value[length - 1] == '\n'
+        || value[length - 1] == ' ' || value[length - 1] == '\t'))
+        length--;
+
+    if (length >= size) length = size - 1;
+    memcpy(dest, value, length);
+    dest[length] = '\0';
+}
+
+/* captures the validators and Retry-After of the final response, redirects start over */
+static size_t read_header(char* data, size_t size, size_t count, void* user_data) {
+    DownloadTransfer* transfer = (DownloadTransfer*)user_data;
+    HTMLCacheValidators* response = &transfer->response;
+    const size_t length = size * count;
+
+    if (length >= 5 && strncmp(data, "HTTP/", 5) == 0) {
+        memset(response, 0, sizeof(*response));
+        response->max_age = -1;
+        transfer->retry_after = -1;
+        transfer->content_type[0] = '\0';
+    }
+    else if (length > 12 && strncasecmp(data, "Retry-After:", 12) == 0) {
+        char value[64];
+        copy_header_value(value, sizeof(value), data + 12, length - 12);
+
+        /* only delta-seconds, an HTTP date falls back to the host's own backoff */
+        if (isdigit((unsigned char)value[0]))
+            transfer->retry_after = strtol(value, NULL, 10);
+    }
+    else if (length > 13 && strncasecmp(data, "Content-Type:", 13) == 0)
+        copy_header_value(transfer->content_type, sizeof(transfer->content_type),
+            data + 13, length - 13);
+    else if (length > 5 && strncasecmp(data, "ETag:", 5) == 0)
+        copy_header_value(response->etag, sizeof(response->etag), data + 5, length - 5);
+    else if (length > 14 && strncasecmp(data, "Last-Modified:", 14) == 0)
+        copy_header_value(response->last_modified, sizeof(response->last_modified),
+            data + 14, length - 14);
+    else if (length > 14 && strncasecmp(data, "Cache-Control:", 14) == 0) {
+        char value[256];
+        copy_header_value(value, sizeof(value), data + 14, length - 14);
+
+        for (char* p = value; *p; p++)
+            *p = (char)tolower((unsigned char)*p);
+
+        const char* max_age = strstr(value, "max-age=");
+
+        if (max_age) response->max_age = strtol(max_age + 8, NULL, 10);
+        if (strstr(value, "no-store")) response->no_store = 1;
+    }
+
+    return length;
+}
+
+/* runs the callback and releases the transfer, error is NULL on success */
+static void complete_transfer(DownloadTransfer* transfer, const char* error) {
+    char message[512];
+
+    if (transfer->sink.write) {
+        /* an empty body still announces the image */
+        if (!error && !transfer->sink_begun && !begin_sink(transfer)) {
+            snprintf(message, sizeof(message),
+                "Receiver refused the download of '%s'.", transfer->url);
+            error = message;
+        }
+    }
+    else if (transfer->file) {
+        if (fclose(transfer->file) != 0 && !error) {
+            snprintf(message, sizeof(message),
+                "Failed to close file '%s' after download: %s.",
+                transfer->path, strerror(errno));
+            error = message;
+        }
+
+        /* never leave a truncated image behind */
+        if (error) remove(transfer->path);
+        transfer->file = NULL;
+    }
+    else if (!error && !transfer->materialized) {
+        /* a successful transfer with an empty body still produces the file */
+        FILE* file = fopen(transfer->path, "wb");
+
+        if (!file || fclose(file) != 0) {
+            snprintf(message, sizeof(message),
+                "Failed to open file '%s' for writing: %s.",
+                transfer->path, strerror(errno));
+            error = message;
+        }
+    }
+
+    /* failing to cache is not failing to download */
+    if (!error && transfer->store_into)
+        html_image_cache_store(transfer->store_into, transfer->url,
+            transfer->path, &transfer->response);
+
+    if (transfer->callback)
+        transfer->callback(transfer->url, transfer->path,
+            error, transfer->user_data);
+
+    html2tex_free(transfer);
+}
+
+static void release_easy(DownloadLoop* loop, CURL* easy) {
+    curl_multi_remove_handle(loop->multi, easy);
+
+    if (loop->idle_count < loop->engine->options.max_connections)
+        loop->idle[loop->idle_count++] = easy;
+    else
+        curl_easy_cleanup(easy);
+}
+
+static void unlink_running(DownloadLoop* loop, DownloadTransfer* transfer) {
+    if (transfer->prev) transfer->prev->next = transfer->next;
+    else loop->running = transfer->next;
+
+    if (transfer->next) transfer->next->prev = transfer->prev;
+    transfer->prev = transfer->next = NULL;
+}
+
+/* the scheme, host and port a URL connects to, lowercased, key must hold strlen(url) + 1 */
+static void url_host_key(const char* url, char* key) {
+    const char* separator = strstr(url, "://");
+    size_t length = 0;
+
+    /* data URIs and relative paths share one unnamed host */
+    if (separator) {
+        const char* host = separator + 3;
+        const char* end = host + strcspn(host, "/?#");
+
+        /* credentials are not part of the host */
+        for (const char* p = host; p < end; p++)
+            if (*p == '@') host = p + 1;
+
+        for (const char* p = url; p < separator + 3; p++)
+            key[length++] = (char)tolower((unsigned char)*p);
+
+        for (const char* p = host; p < end; p++)
+            key[length++] = (char)tolower((unsigned char)*p);
+    }
+
+    key[length] = '\0';
+}
+
+static size_t hash_host_key(const char* key) {
+    size_t hash = 2166136261u;
+
+    while (*key) {
+        hash ^= (unsigned char)*key++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/* a host with nothing queued or running and no throttling left starts over as a new one would */
+static int host_is_idle(const HTMLDownloadOptions* options, const DownloadHost* host, uint64_t now) {
+    if (host->active || host->waiting_head || now < host->resume_at)
+        return 0;
+
+    if (host->window < (double)options->max_host_connections)
+        return 0;
+
+    return options->host_rate <= 0 || host->tokens +
+        (double)(now - host->refilled_at) * options->host_rate / 1000.0 >= (double)options->host_burst;
+}
+
+/* drops idle hosts, so a long-lived engine stays as large as the hosts it is still pacing */
+static void sweep_hosts(DownloadLoop* loop) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+    const uint64_t now = get_monotonic_ms();
+
+    for (size_t i = 0; i < LOOP_HOST_BUCKETS; i++) {
+        DownloadHost** link = &loop->hosts[i];
+
+        while (*link) {
+            DownloadHost* host = *link;
+
+            if (host_is_idle(options, host, now)) {
+                *link = host->chain;
+                html2tex_free(host);
+                atomic_fetch_sub(&loop->host_count, 1);
+            }
+            else
+                link = &host->chain;
+        }
+    }
+
+    loop->host_sweep_at = 2 * atomic_load(&loop->host_count);
+}
+
+/* looks up the scheduling state of a host, created on first use */
+static DownloadHost* find_host(DownloadLoop* loop, const char* key) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+    const size_t hash = hash_host_key(key);
+    DownloadHost** bucket = &loop->hosts[hash % LOOP_HOST_BUCKETS];
+
+    for (DownloadHost* host = *bucket; host; host = host->chain) {
+        if (host->hash == hash && strcmp(host->key, key) == 0)
+            return host;
+    }
+
+    const size_t key_len = strlen(key) + 1;
+    /* sweeps are amortized over the hosts added since the last one */
+    const size_t hosts = atomic_load(&loop->host_count);
+    if (hosts >= LOOP_HOST_BUCKETS && hosts >= loop->host_sweep_at)
+        sweep_hosts(loop);
+
+    DownloadHost* host = (DownloadHost*)html2tex_calloc(1, sizeof(DownloadHost) + key_len);
+    if (!host) return NULL;
+
+    memcpy(host + 1, key, key_len);
+    host->key = (const char*)(host + 1);
+    host->hash = hash;
+
+    /* new hosts start with the full window and bucket, like a browser's first page load */
+    host->window = host->ceiling = (double)options->max_host_connections;
+    host->tokens = (double)options->host_burst;
+    host->refilled_at = get_monotonic_ms();
+    host->backoff = HTML_DOWNLOAD_BACKOFF;
+
+    host->chain = *bucket;
+    *bucket = host;
+    atomic_fetch_add(&loop->host_count, 1);
+    return host;
+}
+
+/* a host joins just behind the cursor, after every host already waiting */
+static void ring_insert(DownloadLoop* loop, DownloadHost* host) {
+    if (!loop->ready) {
+        host->ring_prev = host->ring_next = host;
+        loop->ready = host;
+    }
+    else {
+        host->ring_next = loop->ready;
+        host->ring_prev = loop->ready->ring_prev;
+        host->ring_prev->ring_next = host;
+        loop->ready->ring_prev = host;
+    }
+
+    loop->ready_count++;
+}
+
+static void ring_remove(DownloadLoop* loop, DownloadHost* host) {
+    if (host->ring_next == host)
+        loop->ready = NULL;
+    else {
+        host->ring_prev->ring_next = host->ring_next;
+        host->ring_next->ring_prev = host->ring_prev;
+        if (loop->ready == host) loop->ready = host->ring_next;
+    }
+
+    host->ring_prev = host->ring_next = NULL;
+    loop->ready_count--;
+}
+
+/* queues a transfer on its host, retries go first */
+static void wait_on_host(DownloadLoop* loop, DownloadTransfer* transfer, int front) {
+    DownloadHost* host = transfer->host;
+    if (!host->waiting_head) ring_insert(loop, host);
+
+    if (front) {
+        transfer->next = host->waiting_head;
+        host->waiting_head = transfer;
+        if (!host->waiting_tail) host->waiting_tail = transfer;
+    }
+    else {
+        transfer->next = NULL;
+
+        if (host->waiting_tail) host->waiting_tail->next = transfer;
+        else host->waiting_head = transfer;
+        host->waiting_tail = transfer;
+    }
+}
+
+/* 0 when host may start a transfer at now, else the time it may (UINT64_MAX once a connection frees up) */
+static uint64_t host_ready_at(const HTMLDownloadOptions* options, DownloadHost* host, uint64_t now) {
+    const size_t limit = host->window < 1.0 ? 1 : (size_t)host->window;
+
+    if (host->active >= limit) return UINT64_MAX;
+    if (now < host->resume_at) return host->resume_at;
+
+    if (options->host_rate > 0) {
+        host->tokens += (double)(now - host->refilled_at) * options->host_rate / 1000.0;
+        host->refilled_at = now;
+
+        if (host->tokens > (double)options->host_burst)
+            host->tokens = (double)options->host_burst;
+
+        if (host->tokens < 1.0)
+            return now + (uint64_t)((1.0 - host->tokens) * 1000.0 / options->host_rate) + 1;
+    }
+
+    return 0;
+}
+
+/* frees the connection slot of a transfer, the response status steers its host's window */
+static void release_slot(DownloadLoop* loop, DownloadTransfer* transfer, long status) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+    DownloadHost* host = transfer->host;
+
+    loop->active--;
+    if (!host) return;
+
+    host->active--;
+
+    if (status == 429 || status == 503) {
+        const uint64_t now = get_monotonic_ms();
+
+        /* answers to transfers started before the last decrease only count once */
+        if (now < host->resume_at || (double)(host->active + 1) > host->window) return;
+
+        long pause = 0;
+
+        /* the host asked for a pause, or halving cannot slow it down any more */
+        if (transfer->retry_after >= 0)
+            pause = transfer->retry_after < HTML_DOWNLOAD_MAX_BACKOFF / 1000
+                ? transfer->retry_after * 1000 : HTML_DOWNLOAD_MAX_BACKOFF;
+        else if (host->window <= 1.0) {
+            pause = host->backoff;
+            host->backoff = host->backoff * 2 < HTML_DOWNLOAD_MAX_BACKOFF
+                ? host->backoff * 2 : HTML_DOWNLOAD_MAX_BACKOFF;
+        }
+
+        host->ceiling = host->window;
+        host->window /= 2.0;
+        if (host->window < 1.0) host->window = 1.0;
+
+        host->resume_at = now + (uint64_t)pause;
+    }
+    else if (status > 0) {
+        const double limit = (double)options->max_host_connections;
+
+        /* probes past the last throttling window one connection per few windows of answers */
+        if (host->window + 1.0 < host->ceiling)
+            host->window += 1.0 / host->window;
+        else
+            host->window += 1.0 / (host->window * limit);
+
+        if (host->window > limit) host->window = limit;
+        host->backoff = HTML_DOWNLOAD_BACKOFF;
+    }
+}
+
+static void detach_running(DownloadLoop* loop, DownloadTransfer* transfer, long status) {
+    unlink_running(loop, transfer);
+    release_easy(loop, transfer->easy);
+    transfer->easy = NULL;
+
+    curl_slist_free_all(transfer->conditions);
+    transfer->conditions = NULL;
+    release_slot(loop, transfer, status);
+}
+
+/* detaches a running transfer from the multi handle and reports it, status 0 without a response */
+static void finish_running(DownloadLoop* loop, DownloadTransfer* transfer,
+    long status, const char* error) {
+    detach_running(loop, transfer, status);
+
+    /* settled before the callback, which may wake a waiter counting pending work */
+    atomic_fetch_sub(&loop->pending, 1);
+    complete_transfer(transfer, error);
+}
+
+/* hands a transfer holding a connection slot to the multi handle */
+static void start_transfer(DownloadLoop* loop, DownloadTransfer* transfer) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+    CURL* easy = NULL;
+
+    /* reset keeps the connection, DNS and TLS session caches warm */
+    if (loop->idle_count) {
+        easy = loop->idle[--loop->idle_count];
+        curl_easy_reset(easy);
+    }
+    else
+        easy = curl_easy_init();
+
+    if (!easy) {
+        release_slot(loop, transfer, 0);
+        atomic_fetch_sub(&loop->pending, 1);
+        complete_transfer(transfer, "Failed to initialize libcurl handle.");
+        return;
+    }
+
+    transfer->easy = easy;
+    curl_easy_setopt(easy, CURLOPT_URL, transfer->url);
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_body);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer);
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer);
+    curl_easy_setopt(easy, CURLOPT_SHARE, loop->engine->share);
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(easy, CURLOPT_USERAGENT, "html2tex/1.0");
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, options->timeout_ms);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+
+    /* Retry-After of a throttling host, the cache validators when there is a cache */
+    transfer->retry_after = -1;
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, read_header);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer);
+
+    if (options->multiplex) {
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+
+        /* only TLS can negotiate HTTP/2, waiting on a plain HTTP/1.1 connection serializes */
+        if (strncmp(transfer->url, "https:", 6) == 0)
+            curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    }
+    else
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_1_1);
+
+    if (options->cache) {
+        char header[320];
+        transfer->response.max_age = -1;
+
+        if (transfer->revalidating && transfer->cached.etag[0]) {
+            snprintf(header, sizeof(header), "If-None-Match: %s", transfer->cached.etag);
+            transfer->conditions = curl_slist_append(transfer->conditions, header);
+        }
+
+        if (transfer->revalidating && transfer->cached.last_modified[0]) {
+            snprintf(header, sizeof(header), "If-Modified-Since: %s", transfer->cached.last_modified);
+            transfer->conditions = curl_slist_append(transfer->conditions, header);
+        }
+
+        if (transfer->conditions)
+            curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->conditions);
+    }
+
+    transfer->prev = NULL;
+    transfer->next = loop->running;
+
+    if (loop->running) loop->running->prev = transfer;
+    loop->running = transfer;
+
+    if (curl_multi_add_handle(loop->multi, easy) != CURLM_OK)
+        finish_running(loop, transfer, 0, "Failed to add transfer to the download engine.");
+}
+
+/* settles fresh cache hits at once and queues the rest on their host */
+static void admit_transfer(DownloadLoop* loop, DownloadTransfer* transfer) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+
+    if (options->cache && !transfer->sink.write) {
+        const HTMLCacheState state = html_image_cache_lookup(options->cache,
+            transfer->url, &transfer->cached);
+
+        /* unchanged images never touch the network */
+        if (state == HTML_CACHE_FRESH &&
+            html_image_cache_materialize(options->cache, transfer->url, transfer->path)) {
+            atomic_fetch_sub(&loop->pending, 1);
+            transfer->materialized = 1;
+            complete_transfer(transfer, NULL);
+            return;
+        }
+
+        transfer->revalidating = state == HTML_CACHE_STALE;
+    }
+
+    transfer->host = find_host(loop, transfer->host_key);
+
+    if (transfer->host) {
+        wait_on_host(loop, transfer, 0);
+        return;
+    }
+
+    /* without memory for the host the transfer starts unscheduled */
+    loop->active++;
+    start_transfer(loop, transfer);
+}
+
+/* starts waiting transfers round-robin, one per host per turn, and returns how many started,
+   wake is set to the earliest time a host held back by its rate or backoff may go on (UINT64_MAX for none) */
+static size_t dispatch_waiting(DownloadLoop* loop, uint64_t* wake) {
+    const HTMLDownloadOptions* options = &loop->engine->options;
+    const uint64_t now = get_monotonic_ms();
+    size_t started = 0;
+    size_t passed = 0;
+
+    *wake = UINT64_MAX;
+
+    while (loop->ready && passed < loop->ready_count
+        && loop->active < options->max_connections) {
+        DownloadHost* host = loop->ready;
+        const uint64_t ready_at = host_ready_at(options, host, now);
+
+        if (ready_at) {
+            if (ready_at < *wake) *wake = ready_at;
+            loop->ready = host->ring_next;
+            passed++;
+            continue;
+        }
+
+        DownloadTransfer* transfer = host->waiting_head;
+        host->waiting_head = transfer->next;
+        transfer->next = NULL;
+
+        /* the cursor moves on either way, so every host gets a turn */
+        if (!host->waiting_head) {
+            host->waiting_tail = NULL;
+            ring_remove(loop, host);
+        }
+        else
+            loop->ready = host->ring_next;
+
+        passed = 0;
+        host->active++;
+        loop->active++;
+
+        if (options->host_rate > 0) host->tokens -= 1.0;
+        start_transfer(loop, transfer);
+        started++;
+    }
+
+    return started;
+}
+
+/* reports every transfer still waiting on a host as cancelled */
+static void cancel_waiting(DownloadLoop* loop) {
+    while (loop->ready) {
+        DownloadHost* host = loop->ready;
+        DownloadTransfer* transfer;
+
+        while ((transfer = host->waiting_head) != NULL) {
+            host->waiting_head = transfer->next;
+            atomic_fetch_sub(&loop->pending, 1);
+            complete_transfer(transfer, HTML_DOWNLOAD_CANCELLED);
+        }
+
+        host->waiting_tail = NULL;
+        ring_remove(loop, host);
+    }
+}
+
+static void collect_finished(DownloadLoop* loop) {
+    char message[512];
+    CURLMsg* msg;
+    int left = 0;
+
+    while ((msg = curl_multi_info_read(loop->multi, &left)) != NULL) {
+        if (msg->msg != CURLMSG_DONE) continue;
+
+        DownloadTransfer* transfer = NULL;
+        curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&transfer);
+
+        const CURLcode res = msg->data.result;
+        const char* error = NULL;
+        long status = 0;
+
+        if (res == CURLE_OK) {
+            HTMLImageCache* cache = loop->engine->options.cache;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &status);
+
+            /* a throttling host is paused and the transfer waits for it at the head of its queue */
+            if ((status == 429 || status == 503) && transfer->host
+                && transfer->retries < HTML_DOWNLOAD_MAX_RETRIES) {
+                detach_running(loop, transfer, status);
+                transfer->retries++;
+                wait_on_host(loop, transfer, 1);
+                continue;
+            }
+
+            if (status == 304 && transfer->revalidating) {
+                html_image_cache_refresh(cache, transfer->url, &transfer->response);
+
+                if (html_image_cache_materialize(cache, transfer->url, transfer->path))
+                    transfer->materialized = 1;
+                else {
+                    snprintf(message, sizeof(message), "%s",
+                        html2tex_get_error_message());
+                    error = message;
+                }
+            }
+            else if (status == 200)
+                transfer->store_into = transfer->sink.write ? NULL : cache;
+            else {
+                snprintf(message, sizeof(message),
+                    "HTTP request failed with status code: %ld for URL: %s.",
+                    status, transfer->url);
+                error = message;
+            }
+        }
+        else if (res == CURLE_WRITE_ERROR && transfer->sink_refused) {
+            snprintf(message, sizeof(message),
+                "Receiver refused the download of '%s'.", transfer->url);
+            error = message;
+        }
+        else if (res == CURLE_WRITE_ERROR && transfer->open_error) {
+            snprintf(message, sizeof(message),
+                "Failed to open file '%s' for writing: %s.",
+                transfer->path, strerror(transfer->open_error));
+            error = message;
+        }
+        else {
+            snprintf(message, sizeof(message),
+                "libcurl error: %s for URL: %s",
+                curl_easy_strerror(res), transfer->url);
+            error = message;
+        }
+
+        finish_running(loop, transfer, status, error);
+    }
+}
+
+/* takes the oldest submission, the overflow list only once the queue is drained */
+static DownloadTransfer* take_queued(DownloadLoop* loop) {
+    DownloadTransfer* transfer = (DownloadTransfer*)html_work_queue_try_pop(loop->queue);
+    if (transfer || !atomic_load(&loop->overflowed)) return transfer;
+
+    mutex_lock(&loop->mutex);
+    transfer = loop->overflow_head;
+
+    if (transfer) {
+        loop->overflow_head = transfer->next;
+        if (!loop->overflow_head) loop->overflow_tail = NULL;
+
+        transfer->next = NULL;
+        atomic_fetch_sub(&loop->overflowed, 1);
+    }
+
+    mutex_unlock(&loop->mutex);
+    return transfer;
+}
+
+/* gives the worker back once nothing is left to drive, unless a submission raced the decision */
+static int release_loop(DownloadLoop* loop) {
+    int keep = 0;
+    mutex_lock(&loop->mutex);
+
+    atomic_store(&loop->scheduled, 0);
+    atomic_fence();
+
+    if (html_work_queue_size(loop->queue) || atomic_load(&loop->overflowed)) {
+        size_t idle = 0;
+
+        /* a failed exchange means a submitter posted the task again */
+        while (idle == 0 && !atomic_compare_exchange(&loop->scheduled, &idle, 1));
+        keep = idle == 0;
+    }
+
+    if (!keep) cond_broadcast(&loop->released);
+    mutex_unlock(&loop->mutex);
+    return keep;
+}
+
+/* posts the loop task unless it is already scheduled, then only wakes a sleeping loop */
+static void schedule_loop(DownloadLoop* loop) {
+    size_t idle = 0;
+
+    while (idle == 0 && !atomic_compare_exchange(&loop->scheduled, &idle, 1));
+
+    if (idle == 0)
+        html_executor_post(loop->engine->pool, &loop->task);
+    else if (atomic_load(&loop->polling))
+        curl_multi_wakeup(loop->multi);
+}
+
+static void loop_task(void* arg) {
+    DownloadLoop* loop = (DownloadLoop*)arg;
+
+    for (;;) {
+        const int stopping = atomic_load(&loop->stopping) != 0;
+        const int cancel = atomic_load(&loop->cancel) != 0;
+
+        if (cancel) atomic_store(&loop->cancel, 0);
+
+        /* cancellation covers only what was running before it was requested */
+        if (cancel || stopping) {
+            while (loop->running)
+                finish_running(loop, loop->running, 0, HTML_DOWNLOAD_CANCELLED);
+
+            cancel_waiting(loop);
+        }
+
+        DownloadTransfer* incoming;
+
+        while ((incoming = take_queued(loop)) != NULL) {
+            if (stopping) {
+                atomic_fetch_sub(&loop->pending, 1);
+                complete_transfer(incoming, HTML_DOWNLOAD_CANCELLED);
+            }
+            else
+                admit_transfer(loop, incoming);
+        }
+
+        if (stopping) {
+            if (release_loop(loop)) continue;
+            return;
+        }
+
+        uint64_t wake = UINT64_MAX;
+        dispatch_waiting(loop, &wake);
+
+        int running = 0;
+        curl_multi_perform(loop->multi, &running);
+        collect_finished(loop);
+
+        /* slots freed by finished transfers go to the next hosts in turn, driven before yielding */
+        if (dispatch_waiting(loop, &wake)) continue;
+
+        if (!loop->running && !loop->ready) {
+            if (release_loop(loop)) continue;
+            return;
+        }
+
+        /* waiting tasks of the same or a higher priority take the worker once the loop has
+           polled briefly, transfers resume on its next turn */
+        const int yield = html_executor_should_yield(loop->engine->pool);
+
+        /* a submission racing the flag is seen here and the poll does not sleep */
+        atomic_store(&loop->polling, 1);
+        atomic_fence();
+
+        int timeout = html_work_queue_size(loop->queue)
+            || atomic_load(&loop->overflowed) ? 0 : (yield ? LOOP_YIELD_POLL_MS : LOOP_POLL_MS);
+
+        /* wakes in time for a host coming out of its backoff or refilling its bucket */
+        if (wake != UINT64_MAX) {
+            const uint64_t now = get_monotonic_ms();
+
+            if (wake <= now) timeout = 0;
+            else if (wake - now < (uint64_t)timeout) timeout = (int)(wake - now);
+        }
+
+        /* sleeps until a socket is ready, a timer expires or a submission wakes us */
+        curl_multi_poll(loop->multi, NULL, 0, timeout, NULL);
+        atomic_store(&loop->polling, 0);
+
+        if (yield) {
+            html_executor_post(loop->engine->pool, &loop->task);
+            return;
+        }
+    }
+}
+
+static void destroy_loops(HTMLDownloadEngine* engine) {
+    for (size_t i = 0; i < engine->loop_count; i++) {
+        DownloadLoop* loop = &engine->loops[i];
+
+        if (loop->multi) {
+            /* a final pass cancels what is left, on the worker running the loop */
+            atomic_store(&loop->stopping, 1);
+            atomic_fence();
+            schedule_loop(loop);
+
+            mutex_lock(&loop->mutex);
+
+            while (atomic_load(&loop->scheduled))
+                cond_wait(&loop->released, &loop->mutex);
+
+            mutex_unlock(&loop->mutex);
+        }
+    }
+
+    for (size_t i = 0; i < engine->loop_count; i++) {
+        DownloadLoop* loop = &engine->loops[i];
+
+        for (size_t j = 0; j < loop->idle_count; j++)
+            curl_easy_cleanup(loop->idle[j]);
+
+        for (size_t j = 0; j < LOOP_HOST_BUCKETS; j++) {
+            DownloadHost* host = loop->hosts[j];
+
+            while (host) {
+                DownloadHost* chain = host->chain;
+                html2tex_free(host);
+                host = chain;
+            }
+        }
+
+        if (loop->multi) {
+            curl_multi_cleanup(loop->multi);
+            html_work_queue_destroy(loop->queue);
+            mutex_destroy(&loop->mutex);
+            cond_destroy(&loop->released);
+        }
+
+        html2tex_free(loop->idle);
+    }
+
+    html2tex_free(engine->loops);
+}
+
+static void destroy_engine(HTMLDownloadEngine* engine) {
+    destroy_loops(engine);
+
+    /* waits until the executor is done with the loop tasks */
+    html_executor_pool_destroy(engine->pool);
+
+    /* the share handle outlives every easy handle attached to it */
+    curl_share_cleanup(engine->share);
+
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++)
+        mutex_destroy(&engine->share_locks[i]);
+
+    html2tex_free(engine);
+    curl_global_cleanup();
+}
+
+static int start_loop(HTMLDownloadEngine* engine, DownloadLoop* loop) {
+    const HTMLDownloadOptions* options = &engine->options;
+    loop->engine = engine;
+    loop->idle = (CURL**)html2tex_calloc(options->max_connections, sizeof(CURL*));
+    loop->multi = curl_multi_init();
+    loop->queue = html_work_queue_create(HTML_DOWNLOAD_QUEUE_CAPACITY);
+
+    if (!loop->idle || !loop->multi || !loop->queue) {
+        if (loop->multi) curl_multi_cleanup(loop->multi);
+        html_work_queue_destroy(loop->queue);
+
+        loop->multi = NULL;
+        loop->queue = NULL;
+        return 0;
+    }
+
+    mutex_init(&loop->mutex);
+    cond_init(&loop->released);
+
+    loop->task.run = loop_task;
+    loop->task.arg = loop;
+
+    atomic_store(&loop->scheduled, 0);
+    atomic_store(&loop->overflowed, 0);
+    atomic_store(&loop->pending, 0);
+    atomic_store(&loop->cancel, 0);
+    atomic_store(&loop->stopping, 0);
+    atomic_store(&loop->polling, 0);
+
+    curl_multi_setopt(loop->multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long)options->max_connections);
+    curl_multi_setopt(loop->multi, CURLMOPT_MAX_HOST_CONNECTIONS, (long)options->max_host_connections);
+    curl_multi_setopt(loop->multi, CURLMOPT_MAXCONNECTS, (long)options->max_connections);
+    curl_multi_setopt(loop->multi, CURLMOPT_PIPELINING,
+        options->multiplex ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+
+    /* the loop takes an executor worker only once something is submitted */
+    return 1;
+}
+
+HTMLDownloadEngine* html_download_engine_create(const HTMLDownloadOptions* options) {
+    html2tex_err_clear();
+
+    /* executor workers release what is allocated here, keep it on the process allocator */
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        html2tex_allocator_leave(previous);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+            "Failed to initialize libcurl.");
+        return NULL;
+    }
+
+    HTMLDownloadEngine* engine = (HTMLDownloadEngine*)html2tex_calloc(1, sizeof(HTMLDownloadEngine));
+
+    if (!engine) {
+        curl_global_cleanup();
+        html2tex_allocator_leave(previous);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the download engine.");
+        return NULL;
+    }
+
+    if (options) engine->options = *options;
+    if (!engine->options.event_loops) engine->options.event_loops = 1;
+    if (!engine->options.max_connections) engine->options.max_connections = HTML_DOWNLOAD_MAX_CONNECTIONS;
+    if (!engine->options.max_host_connections) engine->options.max_host_connections = HTML_DOWNLOAD_MAX_HOST_CONNECTIONS;
+    if (engine->options.timeout_ms <= 0) engine->options.timeout_ms = HTML_DOWNLOAD_TIMEOUT;
+    if (engine->options.host_rate < 0) engine->options.host_rate = 0;
+    if (!engine->options.host_burst) engine->options.host_burst = engine->options.max_host_connections;
+    if (!options) engine->options.multiplex = 1;
+
+    for (int i = 0; i < CURL_LOCK_DATA_LAST; i++)
+        mutex_init(&engine->share_locks[i]);
+
+    engine->share = curl_share_init();
+
+    if (engine->share) {
+        curl_share_setopt(engine->share, CURLSHOPT_LOCKFUNC, share_lock);
+        curl_share_setopt(engine->share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+        curl_share_setopt(engine->share, CURLSHOPT_USERDATA, engine);
+        curl_share_setopt(engine->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(engine->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+        /* libcurl does not support sharing connections between concurrent threads */
+        if (engine->options.event_loops == 1)
+            curl_share_setopt(engine->share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+
+    /* the event loops run as tasks of the process-wide executor */
+    engine->pool = html_executor_pool_create(engine->options.priority);
+
+    if (!engine->pool) {
+        destroy_engine(engine);
+        html2tex_allocator_leave(previous);
+        return NULL;
+    }
+
+    engine->loops = (DownloadLoop*)html2tex_calloc(engine->options.event_loops, sizeof(DownloadLoop));
+
+    if (!engine->share || !engine->loops) {
+        destroy_engine(engine);
+        html2tex_allocator_leave(previous);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the download engine.");
+        return NULL;
+    }
+
+    engine->loop_count = engine->options.event_loops;
+
+    for (size_t i = 0; i < engine->loop_count; i++) {
+        if (!start_loop(engine, &engine->loops[i])) {
+            destroy_engine(engine);
+            html2tex_allocator_leave(previous);
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+                "Failed to set up download event loop %zu.", i);
+            return NULL;
+        }
+    }
+
+    html2tex_allocator_leave(previous);
+    return engine;
+}
+
+int html_download_engine_submit(HTMLDownloadEngine* engine, const char* url,
+    const char* path, HTMLDownloadCallback callback, void* user_data) {
+    return html_download_engine_submit_sink(engine, url, path, NULL, callback, user_data);
+}
+
+int html_download_engine_submit_sink(HTMLDownloadEngine* engine, const char* url,
+    const char* path, const HTMLDownloadSink* sink, HTMLDownloadCallback callback, void* user_data) {
+    html2tex_err_clear();
+
+    if (!engine || !url || !path || (sink && !sink->write)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Download engine, URL, path or sink writer is NULL.");
+        return 0;
+    }
+
+    const size_t url_len = strlen(url) + 1;
+    const size_t path_len = strlen(path) + 1;
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    DownloadTransfer* transfer = (DownloadTransfer*)html2tex_calloc(1,
+        sizeof(DownloadTransfer) + url_len + path_len + url_len);
+    html2tex_allocator_leave(previous);
+
+    if (!transfer) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate download of '%s'.", url);
+        return 0;
+    }
+
+    char* strings = (char*)(transfer + 1);
+    memcpy(strings, url, url_len);
+    memcpy(strings + url_len, path, path_len);
+
+    transfer->url = strings;
+    transfer->path = strings + url_len;
+    transfer->callback = callback;
+    transfer->user_data = user_data;
+    if (sink) transfer->sink = *sink;
+
+    /* a host is scheduled by one loop, which keeps its limits exact and its connections warm */
+    url_host_key(url, strings + url_len + path_len);
+    transfer->host_key = strings + url_len + path_len;
+
+    DownloadLoop* loop = &engine->loops[hash_host_key(transfer->host_key) % engine->loop_count];
+    atomic_fetch_add(&loop->pending, 1);
+
+    /* once overflowing, later submissions queue behind the earlier ones */
+    if (atomic_load(&loop->overflowed) || !html_work_queue_try_push(loop->queue, transfer)) {
+        mutex_lock(&loop->mutex);
+
+        if (loop->overflow_tail) loop->overflow_tail->next = transfer;
+        else loop->overflow_head = transfer;
+
+        loop->overflow_tail = transfer;
+        atomic_fetch_add(&loop->overflowed, 1);
+        mutex_unlock(&loop->mutex);
+    }
+
+    /* pairs with the fences the loop runs before it polls or lets go of its worker */
+    atomic_fence();
+    schedule_loop(loop);
+    return 1;
+}
+
+typedef struct {
+    mutex_t mutex;
+    cond_t done_cond;
+    int done;
+    int success;
+    char error[512];
+} FetchWaiter;
+
+static void fetch_done(const char* url, const char* path, const char* error, void* user_data) {
+    FetchWaiter* waiter = (FetchWaiter*)user_data;
+    (void)url;
+    (void)path;
+
+    mutex_lock(&waiter->mutex);
+    waiter->success = error == NULL;
+
+    if (error) snprintf(waiter->error, sizeof(waiter->error), "%s", error);
+    waiter->done = 1;
+
+    cond_signal(&waiter->done_cond);
+    mutex_unlock(&waiter->mutex);
+}
+
+int html_download_engine_fetch(HTMLDownloadEngine* engine, const char* url, const char* path) {
+    FetchWaiter waiter;
+    memset(&waiter, 0, sizeof(waiter));
+
+    mutex_init(&waiter.mutex);
+    cond_init(&waiter.done_cond);
+
+    if (!html_download_engine_submit(engine, url, path, fetch_done, &waiter)) {
+        cond_destroy(&waiter.done_cond);
+        mutex_destroy(&waiter.mutex);
+        return 0;
+    }
+
+    mutex_lock(&waiter.mutex);
+
+    while (!waiter.done)
+        cond_wait(&waiter.done_cond, &waiter.mutex);
+
+    mutex_unlock(&waiter.mutex);
+    cond_destroy(&waiter.done_cond);
+    mutex_destroy(&waiter.mutex);
+
+    if (!waiter.success) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD, "%s", waiter.error);
+        return 0;
+    }
+
+    return 1;
+}
+
+size_t html_download_engine_cancel(HTMLDownloadEngine* engine) {
+    if (!engine) return 0;
+    size_t cancelled = 0;
+
+    for (size_t i = 0; i < engine->loop_count; i++) {
+        DownloadLoop* loop = &engine->loops[i];
+        cancelled += atomic_load(&loop->pending);
+
+        /* transfers the loop never saw are reported from here */
+        const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+        DownloadTransfer* queued;
+
+        while ((queued = take_queued(loop)) != NULL) {
+            atomic_fetch_sub(&loop->pending, 1);
+            complete_transfer(queued, HTML_DOWNLOAD_CANCELLED);
+        }
+
+        html2tex_allocator_leave(previous);
+
+        /* the loop cancels what it already took */
+        atomic_store(&loop->cancel, 1);
+        curl_multi_wakeup(loop->multi);
+    }
+
+    return cancelled;
+}
+
+size_t html_download_engine_pending(HTMLDownloadEngine* engine) {
+    if (!engine) return 0;
+    size_t pending = 0;
+
+    for (size_t i = 0; i < engine->loop_count; i++) {
+        pending += atomic_load(&engine->loops[i].pending);
+    }
+
+    return pending;
+}
+
+size_t html_download_engine_hosts(HTMLDownloadEngine* engine) {
+    if (!engine) return 0;
+    size_t hosts = 0;
+
+    for (size_t i = 0; i < engine->loop_count; i++)
+        hosts += atomic_load(&engine->loops[i].host_count);
+
+    return hosts;
+}
+
+void html_download_engine_destroy(HTMLDownloadEngine* engine) {
+    if (!engine) return;
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    html_download_engine_cancel(engine);
+    destroy_engine(engine);
+    html2tex_allocator_leave(previous);
+}
@@ -0,0 +1,975 @@
+#include "html2tex.h"
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/* Generated from the WHATWG named character reference table
+(https://html.spec.whatwg.org/entities.json), do not edit by hand.
+Minimal perfect hash: bucket = fnv1a(0, name) % 558, slot =
+fnv1a(ENTITY_DISPLACEMENTS[bucket], name) % 2231.
+*/
+#define HTML_ENTITY_COUNT 2231
+#define HTML_ENTITY_BUCKETS 558
+
+static const unsigned short ENTITY_DISPLACEMENTS[HTML_ENTITY_BUCKETS] = {
+    1, 116, 8, 81, 5, 58, 216, 88, 127, 9, 2, 12,
+    89, 27, 7, 19, 58, 76, 5, 72, 20, 13, 188, 110,
+    67, 18, 40, 5, 26, 117, 15, 67, 18, 6, 396, 436,
+    38, 253, 123, 259, 123, 10, 37, 22, 60, 1, 1, 52,
+    77, 138, 96, 46, 11, 90, 56, 1, 28, 17, 16, 88,
+    1, 31, 1, 9, 4, 13, 2, 102, 138, 7, 174, 40,
+    8, 19, 7, 0, 39, 24, 89, 21, 93, 0, 150, 69,
+    10, 12, 167, 62, 28, 1, 128, 6, 61, 294, 6, 76,
+    1, 1, 157, 102, 433, 152, 0, 34, 89, 350, 3, 133,
+    243, 2, 27, 3, 55, 237, 67, 40, 4, 33, 21, 441,
+    9, 71, 219, 2, 26, 82, 136, 17, 34, 5, 28, 98,
+    291, 22, 5, 28, 1, 18, 119, 54, 37, 8, 510, 32,
+    5, 1, 6, 2, 249, 2, 166, 1, 55, 4, 41, 42,
+    27, 365, 3, 160, 0, 66, 164, 139, 9, 92, 45, 369,
+    2, 209, 1, 60, 1, 420, 2, 58, 161, 144, 458, 9,
+    38, 37, 0, 34, 181, 87, 16, 6, 60, 5, 98, 0,
+    39, 1, 3, 477, 29, 168, 0, 65, 122, 7, 326, 7,
+    146, 168, 12, 20, 0, 119, 3, 3, 2, 599, 724, 82,
+    188, 13, 35, 43, 2, 124, 36, 9, 100, 103, 641, 27,
+    130, 162, 214, 46, 3, 128, 54, 20, 10, 23, 75, 23,
+    2, 11, 9, 111, 14, 1, 556, 1, 5, 269, 6, 2,
+    405, 67, 1, 4, 90, 148, 3, 108, 6, 1854, 71, 9,
+    11, 5, 8, 107, 19, 13, 366, 205, 107, 34, 1, 10,
+    228, 6, 2, 67, 508, 8, 553, 2, 94, 3, 5, 2,
+    229, 158, 163, 536, 97, 492, 211, 6, 68, 442, 5, 71,
+    172, 52, 14, 881, 210, 62, 286, 20, 57, 1, 4, 273,
+    121, 12, 6, 12, 4, 70, 14, 90, 497, 2, 4, 125,
+    733, 391, 148, 45, 161, 9, 24, 20, 397, 7, 63, 351,
+    193, 2, 36, 79, 313, 453, 56, 68, 3, 9, 252, 118,
+    53, 82, 32, 4, 221, 179, 123, 198, 228, 150, 1110, 2,
+    1, 2, 4, 3, 7, 33, 64, 4, 58, 1055, 53, 1040,
+    160, 1, 1, 121, 379, 10, 489, 735, 74, 743, 562, 665,
+    72, 318, 1, 153, 32, 16, 2, 3, 298, 358, 3, 68,
+    4, 37, 1, 234, 3, 113, 126, 41, 85, 1, 132, 18,
+    2, 40, 5, 1470, 182, 207, 1, 412, 3, 2, 104, 44,
+    1, 53, 502, 7, 2, 741, 23, 2, 116, 12, 93, 16,
+    69, 1, 471, 4, 2, 23, 104, 1301, 271, 92, 3, 149,
+    617, 8, 2437, 365, 1095, 14, 4, 15, 383, 288, 140, 9,
+    59, 550, 117, 15, 61, 273, 244, 81, 32, 3, 45, 366,
+    196, 123, 1, 304, 26, 135, 3, 4293, 1, 21, 3, 29,
+    30, 58, 214, 12, 208, 1193, 1011, 35, 96, 586, 170, 294,
+    0, 38, 116, 10, 359, 125, 37, 68, 20, 31, 542, 1758,
+    792, 33, 1957, 1127, 9, 71, 351, 18, 941, 1296, 102, 245,
+    302, 5403, 993, 324, 9, 1, 1447, 57, 509, 35, 16, 4002,
+    489, 146, 186, 465, 13, 24, 821, 866, 10, 14, 10, 1567,
+    15, 586, 1, 1889, 4264, 7, 1105, 51, 1, 3641, 3028, 358,
+    682, 171, 226, 3582, 156, 4
+};
+
+static const HTMLEntity ENTITY_TABLE[HTML_ENTITY_COUNT] = {
+    {"Product;", "\xE2\x88\x8F", 8, 3}, {"angmsdag;", "\xE2\xA6\xAE", 9, 3}, {"angmsdah;", "\xE2\xA6\xAF", 9, 3},
+    {"lrm;", "\xE2\x80\x8E", 4, 3}, {"LeftTriangle;", "\xE2\x8A\xB2", 13, 3}, {"fallingdotseq;", "\xE2\x89\x92", 14, 3},
+    {"yen;", "\xC2\xA5", 4, 2}, {"andd;", "\xE2\xA9\x9C", 5, 3}, {"bernou;", "\xE2\x84\xAC", 7, 3},
+    {"gl;", "\xE2\x89\xB7", 3, 3}, {"Rcedil;", "\xC5\x96", 7, 2}, {"xuplus;", "\xE2\xA8\x84", 7, 3},
+    {"RightUpTeeVector;", "\xE2\xA5\x9C", 17, 3}, {"spadesuit;", "\xE2\x99\xA0", 10, 3}, {"ni;", "\xE2\x88\x8B", 3, 3},
+    {"fjlig;", "\x66\x6A", 6, 2}, {"pr;", "\xE2\x89\xBA", 3, 3}, {"simplus;", "\xE2\xA8\xA4", 8, 3},
+    {"rdca;", "\xE2\xA4\xB7", 5, 3}, {"ncedil;", "\xC5\x86", 7, 2}, {"ncongdot;", "\xE2\xA9\xAD\xCC\xB8", 9, 5},
+    {"Ntilde;", "\xC3\x91", 7, 2}, {"Eta;", "\xCE\x97", 4, 2}, {"nsim;", "\xE2\x89\x81", 5, 3},
+    {"easter;", "\xE2\xA9\xAE", 7, 3}, {"plusacir;", "\xE2\xA8\xA3", 9, 3}, {"bopf;", "\xF0\x9D\x95\x93", 5, 4},
+    {"rtimes;", "\xE2\x8B\x8A", 7, 3}, {"subsetneq;", "\xE2\x8A\x8A", 10, 3}, {"nleftarrow;", "\xE2\x86\x9A", 11, 3},
+    {"Poincareplane;", "\xE2\x84\x8C", 14, 3}, {"loz;", "\xE2\x97\x8A", 4, 3}, {"boxDR;", "\xE2\x95\x94", 6, 3},
+    {"alpha;", "\xCE\xB1", 6, 2}, {"aopf;", "\xF0\x9D\x95\x92", 5, 4}, {"circ;", "\xCB\x86", 5, 2},
+    {"LT", "\x3C", 2, 1}, {"biguplus;", "\xE2\xA8\x84", 9, 3}, {"leftarrowtail;", "\xE2\x86\xA2", 14, 3},
+    {"hcirc;", "\xC4\xA5", 6, 2}, {"Wopf;", "\xF0\x9D\x95\x8E", 5, 4}, {"vert;", "\x7C", 5, 1},
+    {"ExponentialE;", "\xE2\x85\x87", 13, 3}, {"twoheadleftarrow;", "\xE2\x86\x9E", 17, 3}, {"Agrave;", "\xC3\x80", 7, 2},
+    {"And;", "\xE2\xA9\x93", 4, 3}, {"LeftRightArrow;", "\xE2\x86\x94", 15, 3}, {"nsucceq;", "\xE2\xAA\xB0\xCC\xB8", 8, 5},
+    {"nsubseteq;", "\xE2\x8A\x88", 10, 3}, {"nsupE;", "\xE2\xAB\x86\xCC\xB8", 6, 5}, {"CapitalDifferentialD;", "\xE2\x85\x85", 21, 3},
+    {"ocirc", "\xC3\xB4", 5, 2}, {"vBarv;", "\xE2\xAB\xA9", 6, 3}, {"jcy;", "\xD0\xB9", 4, 2},
+    {"apos;", "\x27", 5, 1}, {"yopf;", "\xF0\x9D\x95\xAA", 5, 4}, {"NotSubset;", "\xE2\x8A\x82\xE2\x83\x92", 10, 6},
+    {"nless;", "\xE2\x89\xAE", 6, 3}, {"Omacr;", "\xC5\x8C", 6, 2}, {"Zcaron;", "\xC5\xBD", 7, 2},
+    {"numsp;", "\xE2\x80\x87", 6, 3}, {"curlywedge;", "\xE2\x8B\x8F", 11, 3}, {"NotSquareSubset;", "\xE2\x8A\x8F\xCC\xB8", 16, 5},
+    {"it;", "\xE2\x81\xA2", 3, 3}, {"rightleftharpoons;", "\xE2\x87\x8C", 18, 3}, {"gesdoto;", "\xE2\xAA\x82", 8, 3},
+    {"Or;", "\xE2\xA9\x94", 3, 3}, {"rHar;", "\xE2\xA5\xA4", 5, 3}, {"elsdot;", "\xE2\xAA\x97", 7, 3},
+    {"apE;", "\xE2\xA9\xB0", 4, 3}, {"ldrushar;", "\xE2\xA5\x8B", 9, 3}, {"gfr;", "\xF0\x9D\x94\xA4", 4, 4},
+    {"Zscr;", "\xF0\x9D\x92\xB5", 5, 4}, {"lharu;", "\xE2\x86\xBC", 6, 3}, {"Uring;", "\xC5\xAE", 6, 2},
+    {"SquareUnion;", "\xE2\x8A\x94", 12, 3}, {"Iacute", "\xC3\x8D", 6, 2}, {"notinE;", "\xE2\x8B\xB9\xCC\xB8", 7, 5},
+    {"nbumpe;", "\xE2\x89\x8F\xCC\xB8", 7, 5}, {"supsetneq;", "\xE2\x8A\x8B", 10, 3}, {"ruluhar;", "\xE2\xA5\xA8", 8, 3},
+    {"bsol;", "\x5C", 5, 1}, {"varepsilon;", "\xCF\xB5", 11, 2}, {"Mscr;", "\xE2\x84\xB3", 5, 3},
+    {"Map;", "\xE2\xA4\x85", 4, 3}, {"gamma;", "\xCE\xB3", 6, 2}, {"gdot;", "\xC4\xA1", 5, 2},
+    {"bigcup;", "\xE2\x8B\x83", 7, 3}, {"ijlig;", "\xC4\xB3", 6, 2}, {"rharu;", "\xE2\x87\x80", 6, 3},
+    {"nrarrw;", "\xE2\x86\x9D\xCC\xB8", 7, 5}, {"square;", "\xE2\x96\xA1", 7, 3}, {"complement;", "\xE2\x88\x81", 11, 3},
+    {"ClockwiseContourIntegral;", "\xE2\x88\xB2", 25, 3}, {"clubs;", "\xE2\x99\xA3", 6, 3}, {"lotimes;", "\xE2\xA8\xB4", 8, 3},
+    {"twixt;", "\xE2\x89\xAC", 6, 3}, {"otilde;", "\xC3\xB5", 7, 2}, {"xutri;", "\xE2\x96\xB3", 6, 3},
+    {"rarrlp;", "\xE2\x86\xAC", 7, 3}, {"GT", "\x3E", 2, 1}, {"eth", "\xC3\xB0", 3, 2},
+    {"Cross;", "\xE2\xA8\xAF", 6, 3}, {"frasl;", "\xE2\x81\x84", 6, 3}, {"nhArr;", "\xE2\x87\x8E", 6, 3},
+    {"rho;", "\xCF\x81", 4, 2}, {"clubsuit;", "\xE2\x99\xA3", 9, 3}, {"gnE;", "\xE2\x89\xA9", 4, 3},
+    {"nsmid;", "\xE2\x88\xA4", 6, 3}, {"tcedil;", "\xC5\xA3", 7, 2}, {"omega;", "\xCF\x89", 6, 2},
+    {"Vert;", "\xE2\x80\x96", 5, 3}, {"DownLeftRightVector;", "\xE2\xA5\x90", 20, 3}, {"bottom;", "\xE2\x8A\xA5", 7, 3},
+    {"nlt;", "\xE2\x89\xAE", 4, 3}, {"varpi;", "\xCF\x96", 6, 2}, {"reg", "\xC2\xAE", 3, 2},
+    {"circledcirc;", "\xE2\x8A\x9A", 12, 3}, {"ddotseq;", "\xE2\xA9\xB7", 8, 3}, {"Aring", "\xC3\x85", 5, 2},
+    {"uml", "\xC2\xA8", 3, 2}, {"RightTriangleEqual;", "\xE2\x8A\xB5", 19, 3}, {"geq;", "\xE2\x89\xA5", 4, 3},
+    {"opar;", "\xE2\xA6\xB7", 5, 3}, {"boxHU;", "\xE2\x95\xA9", 6, 3}, {"curlyeqsucc;", "\xE2\x8B\x9F", 12, 3},
+    {"vdash;", "\xE2\x8A\xA2", 6, 3}, {"blank;", "\xE2\x90\xA3", 6, 3}, {"Igrave;", "\xC3\x8C", 7, 2},
+    {"DownTee;", "\xE2\x8A\xA4", 8, 3}, {"chcy;", "\xD1\x87", 5, 2}, {"DownLeftVector;", "\xE2\x86\xBD", 15, 3},
+    {"Hcirc;", "\xC4\xA4", 6, 2}, {"oslash;", "\xC3\xB8", 7, 2}, {"Tscr;", "\xF0\x9D\x92\xAF", 5, 4},
+    {"Cfr;", "\xE2\x84\xAD", 4, 3}, {"oror;", "\xE2\xA9\x96", 5, 3}, {"macr", "\xC2\xAF", 4, 2},
+    {"Auml", "\xC3\x84", 4, 2}, {"Ascr;", "\xF0\x9D\x92\x9C", 5, 4}, {"circlearrowright;", "\xE2\x86\xBB", 17, 3},
+    {"boxDr;", "\xE2\x95\x93", 6, 3}, {"awint;", "\xE2\xA8\x91", 6, 3}, {"subne;", "\xE2\x8A\x8A", 6, 3},
+    {"notinvb;", "\xE2\x8B\xB7", 8, 3}, {"rpar;", "\x29", 5, 1}, {"Gg;", "\xE2\x8B\x99", 3, 3},
+    {"UnderBar;", "\x5F", 9, 1}, {"nabla;", "\xE2\x88\x87", 6, 3}, {"becaus;", "\xE2\x88\xB5", 7, 3},
+    {"ogon;", "\xCB\x9B", 5, 2}, {"yacute", "\xC3\xBD", 6, 2}, {"ltquest;", "\xE2\xA9\xBB", 8, 3},
+    {"Lsh;", "\xE2\x86\xB0", 4, 3}, {"ycy;", "\xD1\x8B", 4, 2}, {"ogt;", "\xE2\xA7\x81", 4, 3},
+    {"LeftArrow;", "\xE2\x86\x90", 10, 3}, {"Lcy;", "\xD0\x9B", 4, 2}, {"Rsh;", "\xE2\x86\xB1", 4, 3},
+    {"prurel;", "\xE2\x8A\xB0", 7, 3}, {"uparrow;", "\xE2\x86\x91", 8, 3}, {"acirc", "\xC3\xA2", 5, 2},
+    {"eDot;", "\xE2\x89\x91", 5, 3}, {"cudarrl;", "\xE2\xA4\xB8", 8, 3}, {"nLeftrightarrow;", "\xE2\x87\x8E", 16, 3},
+    {"supsetneqq;", "\xE2\xAB\x8C", 11, 3}, {"Implies;", "\xE2\x87\x92", 8, 3}, {"ncong;", "\xE2\x89\x87", 6, 3},
+    {"vsupne;", "\xE2\x8A\x8B\xEF\xB8\x80", 7, 6}, {"RightArrowLeftArrow;", "\xE2\x87\x84", 20, 3}, {"Bernoullis;", "\xE2\x84\xAC", 11, 3},
+    {"vartriangleleft;", "\xE2\x8A\xB2", 16, 3}, {"piv;", "\xCF\x96", 4, 2}, {"iscr;", "\xF0\x9D\x92\xBE", 5, 4},
+    {"prod;", "\xE2\x88\x8F", 5, 3}, {"aleph;", "\xE2\x84\xB5", 6, 3}, {"DoubleLongLeftRightArrow;", "\xE2\x9F\xBA", 25, 3},
+    {"DownArrowBar;", "\xE2\xA4\x93", 13, 3}, {"lvertneqq;", "\xE2\x89\xA8\xEF\xB8\x80", 10, 6}, {"lne;", "\xE2\xAA\x87", 4, 3},
+    {"Ycy;", "\xD0\xAB", 4, 2}, {"micro;", "\xC2\xB5", 6, 2}, {"gnap;", "\xE2\xAA\x8A", 5, 3},
+    {"roplus;", "\xE2\xA8\xAE", 7, 3}, {"thorn;", "\xC3\xBE", 6, 2}, {"subrarr;", "\xE2\xA5\xB9", 8, 3},
+    {"qprime;", "\xE2\x81\x97", 7, 3}, {"barvee;", "\xE2\x8A\xBD", 7, 3}, {"langle;", "\xE2\x9F\xA8", 7, 3},
+    {"DiacriticalTilde;", "\xCB\x9C", 17, 2}, {"half;", "\xC2\xBD", 5, 2}, {"gE;", "\xE2\x89\xA7", 3, 3},
+    {"Lang;", "\xE2\x9F\xAA", 5, 3}, {"icirc", "\xC3\xAE", 5, 2}, {"Hstrok;", "\xC4\xA6", 7, 2},
+    {"bbrk;", "\xE2\x8E\xB5", 5, 3}, {"lgE;", "\xE2\xAA\x91", 4, 3}, {"Vfr;", "\xF0\x9D\x94\x99", 4, 4},
+    {"larr;", "\xE2\x86\x90", 5, 3}, {"apacir;", "\xE2\xA9\xAF", 7, 3}, {"delta;", "\xCE\xB4", 6, 2},
+    {"afr;", "\xF0\x9D\x94\x9E", 4, 4}, {"DownArrowUpArrow;", "\xE2\x87\xB5", 17, 3}, {"Hscr;", "\xE2\x84\x8B", 5, 3},
+    {"odblac;", "\xC5\x91", 7, 2}, {"pi;", "\xCF\x80", 3, 2}, {"scnE;", "\xE2\xAA\xB6", 5, 3},
+    {"PartialD;", "\xE2\x88\x82", 9, 3}, {"leqslant;", "\xE2\xA9\xBD", 9, 3}, {"Gamma;", "\xCE\x93", 6, 2},
+    {"ntilde;", "\xC3\xB1", 7, 2}, {"LeftTee;", "\xE2\x8A\xA3", 8, 3}, {"trie;", "\xE2\x89\x9C", 5, 3},
+    {"rationals;", "\xE2\x84\x9A", 10, 3}, {"ccaps;", "\xE2\xA9\x8D", 6, 3}, {"NotEqualTilde;", "\xE2\x89\x82\xCC\xB8", 14, 5},
+    {"iinfin;", "\xE2\xA7\x9C", 7, 3}, {"dlcrop;", "\xE2\x8C\x8D", 7, 3}, {"Uacute;", "\xC3\x9A", 7, 2},
+    {"npart;", "\xE2\x88\x82\xCC\xB8", 6, 5}, {"RightTriangle;", "\xE2\x8A\xB3", 14, 3}, {"wr;", "\xE2\x89\x80", 3, 3},
+    {"copysr;", "\xE2\x84\x97", 7, 3}, {"mlcp;", "\xE2\xAB\x9B", 5, 3}, {"cent", "\xC2\xA2", 4, 2},
+    {"boxuL;", "\xE2\x95\x9B", 6, 3}, {"parsim;", "\xE2\xAB\xB3", 7, 3}, {"smile;", "\xE2\x8C\xA3", 6, 3},
+    {"NotHumpEqual;", "\xE2\x89\x8F\xCC\xB8", 13, 5}, {"NegativeThinSpace;", "\xE2\x80\x8B", 18, 3}, {"excl;", "\x21", 5, 1},
+    {"ropf;", "\xF0\x9D\x95\xA3", 5, 4}, {"perp;", "\xE2\x8A\xA5", 5, 3}, {"curlyeqprec;", "\xE2\x8B\x9E", 12, 3},
+    {"otimes;", "\xE2\x8A\x97", 7, 3}, {"smtes;", "\xE2\xAA\xAC\xEF\xB8\x80", 6, 6}, {"imagpart;", "\xE2\x84\x91", 9, 3},
+    {"DownLeftTeeVector;", "\xE2\xA5\x9E", 18, 3}, {"ncap;", "\xE2\xA9\x83", 5, 3}, {"Equal;", "\xE2\xA9\xB5", 6, 3},
+    {"vltri;", "\xE2\x8A\xB2", 6, 3}, {"ordm", "\xC2\xBA", 4, 2}, {"curlyvee;", "\xE2\x8B\x8E", 9, 3},
+    {"nLeftarrow;", "\xE2\x87\x8D", 11, 3}, {"hellip;", "\xE2\x80\xA6", 7, 3}, {"Subset;", "\xE2\x8B\x90", 7, 3},
+    {"leftrightarrow;", "\xE2\x86\x94", 15, 3}, {"rArr;", "\xE2\x87\x92", 5, 3}, {"plankv;", "\xE2\x84\x8F", 7, 3},
+    {"lmoustache;", "\xE2\x8E\xB0", 11, 3}, {"jopf;", "\xF0\x9D\x95\x9B", 5, 4}, {"bdquo;", "\xE2\x80\x9E", 6, 3},
+    {"marker;", "\xE2\x96\xAE", 7, 3}, {"ordm;", "\xC2\xBA", 5, 2}, {"sup2", "\xC2\xB2", 4, 2},
+    {"Kfr;", "\xF0\x9D\x94\x8E", 4, 4}, {"backsim;", "\xE2\x88\xBD", 8, 3}, {"boxvR;", "\xE2\x95\x9E", 6, 3},
+    {"nbsp;", "\xC2\xA0", 5, 2}, {"Gcedil;", "\xC4\xA2", 7, 2}, {"nsupset;", "\xE2\x8A\x83\xE2\x83\x92", 8, 6},
+    {"ETH", "\xC3\x90", 3, 2}, {"mapstodown;", "\xE2\x86\xA7", 11, 3}, {"Pfr;", "\xF0\x9D\x94\x93", 4, 4},
+    {"PrecedesSlantEqual;", "\xE2\x89\xBC", 19, 3}, {"vopf;", "\xF0\x9D\x95\xA7", 5, 4}, {"eqvparsl;", "\xE2\xA7\xA5", 9, 3},
+    {"rarrtl;", "\xE2\x86\xA3", 7, 3}, {"otimesas;", "\xE2\xA8\xB6", 9, 3}, {"Element;", "\xE2\x88\x88", 8, 3},
+    {"supsim;", "\xE2\xAB\x88", 7, 3}, {"sqcups;", "\xE2\x8A\x94\xEF\xB8\x80", 7, 6}, {"rdldhar;", "\xE2\xA5\xA9", 8, 3},
+    {"squarf;", "\xE2\x96\xAA", 7, 3}, {"lnapprox;", "\xE2\xAA\x89", 9, 3}, {"commat;", "\x40", 7, 1},
+    {"Delta;", "\xCE\x94", 6, 2}, {"erDot;", "\xE2\x89\x93", 6, 3}, {"rarrb;", "\xE2\x87\xA5", 6, 3},
+    {"nacute;", "\xC5\x84", 7, 2}, {"TSHcy;", "\xD0\x8B", 6, 2}, {"nltri;", "\xE2\x8B\xAA", 6, 3},
+    {"iukcy;", "\xD1\x96", 6, 2}, {"emptyset;", "\xE2\x88\x85", 9, 3}, {"iacute;", "\xC3\xAD", 7, 2},
+    {"cedil", "\xC2\xB8", 5, 2}, {"sext;", "\xE2\x9C\xB6", 5, 3}, {"lowbar;", "\x5F", 7, 1},
+    {"hairsp;", "\xE2\x80\x8A", 7, 3}, {"angsph;", "\xE2\x88\xA2", 7, 3}, {"lessdot;", "\xE2\x8B\x96", 8, 3},
+    {"Congruent;", "\xE2\x89\xA1", 10, 3}, {"triangleright;", "\xE2\x96\xB9", 14, 3}, {"boxHd;", "\xE2\x95\xA4", 6, 3},
+    {"smashp;", "\xE2\xA8\xB3", 7, 3}, {"minusd;", "\xE2\x88\xB8", 7, 3}, {"NotEqual;", "\xE2\x89\xA0", 9, 3},
+    {"bumpeq;", "\xE2\x89\x8F", 7, 3}, {"subsim;", "\xE2\xAB\x87", 7, 3}, {"precnapprox;", "\xE2\xAA\xB9", 12, 3},
+    {"Rarrtl;", "\xE2\xA4\x96", 7, 3}, {"telrec;", "\xE2\x8C\x95", 7, 3}, {"rarrc;", "\xE2\xA4\xB3", 6, 3},
+    {"shortparallel;", "\xE2\x88\xA5", 14, 3}, {"notnivc;", "\xE2\x8B\xBD", 8, 3}, {"ifr;", "\xF0\x9D\x94\xA6", 4, 4},
+    {"LeftRightVector;", "\xE2\xA5\x8E", 16, 3}, {"dcaron;", "\xC4\x8F", 7, 2}, {"REG", "\xC2\xAE", 3, 2},
+    {"djcy;", "\xD1\x92", 5, 2}, {"rsquo;", "\xE2\x80\x99", 6, 3}, {"ofcir;", "\xE2\xA6\xBF", 6, 3},
+    {"Gopf;", "\xF0\x9D\x94\xBE", 5, 4}, {"sqsupe;", "\xE2\x8A\x92", 7, 3}, {"Lt;", "\xE2\x89\xAA", 3, 3},
+    {"heartsuit;", "\xE2\x99\xA5", 10, 3}, {"kappa;", "\xCE\xBA", 6, 2}, {"LessGreater;", "\xE2\x89\xB6", 12, 3},
+    {"ggg;", "\xE2\x8B\x99", 4, 3}, {"iuml;", "\xC3\xAF", 5, 2}, {"asymp;", "\xE2\x89\x88", 6, 3},
+    {"xotime;", "\xE2\xA8\x82", 7, 3}, {"rsh;", "\xE2\x86\xB1", 4, 3}, {"Uarr;", "\xE2\x86\x9F", 5, 3},
+    {"Vee;", "\xE2\x8B\x81", 4, 3}, {"leftrightarrows;", "\xE2\x87\x86", 16, 3}, {"circeq;", "\xE2\x89\x97", 7, 3},
+    {"nRightarrow;", "\xE2\x87\x8F", 12, 3}, {"uopf;", "\xF0\x9D\x95\xA6", 5, 4}, {"nwarrow;", "\xE2\x86\x96", 8, 3},
+    {"Vopf;", "\xF0\x9D\x95\x8D", 5, 4}, {"kjcy;", "\xD1\x9C", 5, 2}, {"ll;", "\xE2\x89\xAA", 3, 3},
+    {"starf;", "\xE2\x98\x85", 6, 3}, {"escr;", "\xE2\x84\xAF", 5, 3}, {"Cedilla;", "\xC2\xB8", 8, 2},
+    {"divideontimes;", "\xE2\x8B\x87", 14, 3}, {"Ecirc", "\xC3\x8A", 5, 2}, {"Colon;", "\xE2\x88\xB7", 6, 3},
+    {"TildeEqual;", "\xE2\x89\x83", 11, 3}, {"thkap;", "\xE2\x89\x88", 6, 3}, {"lfisht;", "\xE2\xA5\xBC", 7, 3},
+    {"supplus;", "\xE2\xAB\x80", 8, 3}, {"nvHarr;", "\xE2\xA4\x84", 7, 3}, {"suphsub;", "\xE2\xAB\x97", 8, 3},
+    {"lceil;", "\xE2\x8C\x88", 6, 3}, {"radic;", "\xE2\x88\x9A", 6, 3}, {"lap;", "\xE2\xAA\x85", 4, 3},
+    {"Pi;", "\xCE\xA0", 3, 2}, {"DoubleLeftArrow;", "\xE2\x87\x90", 16, 3}, {"rotimes;", "\xE2\xA8\xB5", 8, 3},
+    {"Uparrow;", "\xE2\x87\x91", 8, 3}, {"disin;", "\xE2\x8B\xB2", 6, 3}, {"rightharpoondown;", "\xE2\x87\x81", 17, 3},
+    {"Umacr;", "\xC5\xAA", 6, 2}, {"equals;", "\x3D", 7, 1}, {"Oacute;", "\xC3\x93", 7, 2},
+    {"notin;", "\xE2\x88\x89", 6, 3}, {"Dstrok;", "\xC4\x90", 7, 2}, {"DD;", "\xE2\x85\x85", 3, 3},
+    {"Zacute;", "\xC5\xB9", 7, 2}, {"gneq;", "\xE2\xAA\x88", 5, 3}, {"Sc;", "\xE2\xAA\xBC", 3, 3},
+    {"gEl;", "\xE2\xAA\x8C", 4, 3}, {"Oslash;", "\xC3\x98", 7, 2}, {"tstrok;", "\xC5\xA7", 7, 2},
+    {"LeftVector;", "\xE2\x86\xBC", 11, 3}, {"sdot;", "\xE2\x8B\x85", 5, 3}, {"LeftArrowBar;", "\xE2\x87\xA4", 13, 3},
+    {"xrArr;", "\xE2\x9F\xB9", 6, 3}, {"Cap;", "\xE2\x8B\x92", 4, 3}, {"Zfr;", "\xE2\x84\xA8", 4, 3},
+    {"nltrie;", "\xE2\x8B\xAC", 7, 3}, {"isinE;", "\xE2\x8B\xB9", 6, 3}, {"epar;", "\xE2\x8B\x95", 5, 3},
+    {"zdot;", "\xC5\xBC", 5, 2}, {"nprcue;", "\xE2\x8B\xA0", 7, 3}, {"nleqslant;", "\xE2\xA9\xBD\xCC\xB8", 10, 5},
+    {"chi;", "\xCF\x87", 4, 2}, {"efr;", "\xF0\x9D\x94\xA2", 4, 4}, {"boxtimes;", "\xE2\x8A\xA0", 9, 3},
+    {"sharp;", "\xE2\x99\xAF", 6, 3}, {"subseteq;", "\xE2\x8A\x86", 9, 3}, {"Uacute", "\xC3\x9A", 6, 2},
+    {"blk14;", "\xE2\x96\x91", 6, 3}, {"Hopf;", "\xE2\x84\x8D", 5, 3}, {"curarrm;", "\xE2\xA4\xBC", 8, 3},
+    {"dtri;", "\xE2\x96\xBF", 5, 3}, {"jukcy;", "\xD1\x94", 6, 2}, {"cir;", "\xE2\x97\x8B", 4, 3},
+    {"angmsd;", "\xE2\x88\xA1", 7, 3}, {"GreaterEqual;", "\xE2\x89\xA5", 13, 3}, {"mapsto;", "\xE2\x86\xA6", 7, 3},
+    {"boxdL;", "\xE2\x95\x95", 6, 3}, {"lrhard;", "\xE2\xA5\xAD", 7, 3}, {"DDotrahd;", "\xE2\xA4\x91", 9, 3},
+    {"gimel;", "\xE2\x84\xB7", 6, 3}, {"bepsi;", "\xCF\xB6", 6, 2}, {"DScy;", "\xD0\x85", 5, 2},
+    {"lnsim;", "\xE2\x8B\xA6", 6, 3}, {"boxDl;", "\xE2\x95\x96", 6, 3}, {"cirE;", "\xE2\xA7\x83", 5, 3},
+    {"boxHD;", "\xE2\x95\xA6", 6, 3}, {"Dot;", "\xC2\xA8", 4, 2}, {"jmath;", "\xC8\xB7", 6, 2},
+    {"gesdot;", "\xE2\xAA\x80", 7, 3}, {"ltrie;", "\xE2\x8A\xB4", 6, 3}, {"NotPrecedes;", "\xE2\x8A\x80", 12, 3},
+    {"RightCeiling;", "\xE2\x8C\x89", 13, 3}, {"varnothing;", "\xE2\x88\x85", 11, 3}, {"nearr;", "\xE2\x86\x97", 6, 3},
+    {"sung;", "\xE2\x99\xAA", 5, 3}, {"Escr;", "\xE2\x84\xB0", 5, 3}, {"searr;", "\xE2\x86\x98", 6, 3},
+    {"itilde;", "\xC4\xA9", 7, 2}, {"THORN", "\xC3\x9E", 5, 2}, {"suphsol;", "\xE2\x9F\x89", 8, 3},
+    {"Prime;", "\xE2\x80\xB3", 6, 3}, {"dArr;", "\xE2\x87\x93", 5, 3}, {"sqsube;", "\xE2\x8A\x91", 7, 3},
+    {"bsolb;", "\xE2\xA7\x85", 6, 3}, {"larrtl;", "\xE2\x86\xA2", 7, 3}, {"mu;", "\xCE\xBC", 3, 2},
+    {"leftharpoonup;", "\xE2\x86\xBC", 14, 3}, {"LeftAngleBracket;", "\xE2\x9F\xA8", 17, 3}, {"rdquo;", "\xE2\x80\x9D", 6, 3},
+    {"Iota;", "\xCE\x99", 5, 2}, {"boxhD;", "\xE2\x95\xA5", 6, 3}, {"rnmid;", "\xE2\xAB\xAE", 6, 3},
+    {"atilde", "\xC3\xA3", 6, 2}, {"nbsp", "\xC2\xA0", 4, 2}, {"RightUpVector;", "\xE2\x86\xBE", 14, 3},
+    {"ThickSpace;", "\xE2\x81\x9F\xE2\x80\x8A", 11, 6}, {"egrave", "\xC3\xA8", 6, 2}, {"longleftrightarrow;", "\xE2\x9F\xB7", 19, 3},
+    {"ccaron;", "\xC4\x8D", 7, 2}, {"hardcy;", "\xD1\x8A", 7, 2}, {"boxv;", "\xE2\x94\x82", 5, 3},
+    {"SHCHcy;", "\xD0\xA9", 7, 2}, {"nmid;", "\xE2\x88\xA4", 5, 3}, {"setmn;", "\xE2\x88\x96", 6, 3},
+    {"fnof;", "\xC6\x92", 5, 2}, {"psi;", "\xCF\x88", 4, 2}, {"RightVectorBar;", "\xE2\xA5\x93", 15, 3},
+    {"NotSupersetEqual;", "\xE2\x8A\x89", 17, 3}, {"nesim;", "\xE2\x89\x82\xCC\xB8", 6, 5}, {"omacr;", "\xC5\x8D", 6, 2},
+    {"xsqcup;", "\xE2\xA8\x86", 7, 3}, {"num;", "\x23", 4, 1}, {"Cscr;", "\xF0\x9D\x92\x9E", 5, 4},
+    {"alefsym;", "\xE2\x84\xB5", 8, 3}, {"ntriangleleft;", "\xE2\x8B\xAA", 14, 3}, {"Union;", "\xE2\x8B\x83", 6, 3},
+    {"male;", "\xE2\x99\x82", 5, 3}, {"approxeq;", "\xE2\x89\x8A", 9, 3}, {"lessgtr;", "\xE2\x89\xB6", 8, 3},
+    {"DotEqual;", "\xE2\x89\x90", 9, 3}, {"Bscr;", "\xE2\x84\xAC", 5, 3}, {"els;", "\xE2\xAA\x95", 4, 3},
+    {"caps;", "\xE2\x88\xA9\xEF\xB8\x80", 5, 6}, {"kappav;", "\xCF\xB0", 7, 2}, {"nleftrightarrow;", "\xE2\x86\xAE", 16, 3},
+    {"frac45;", "\xE2\x85\x98", 7, 3}, {"ltrPar;", "\xE2\xA6\x96", 7, 3}, {"eqcirc;", "\xE2\x89\x96", 7, 3},
+    {"plussim;", "\xE2\xA8\xA6", 8, 3}, {"uharr;", "\xE2\x86\xBE", 6, 3}, {"Zcy;", "\xD0\x97", 4, 2},
+    {"Iscr;", "\xE2\x84\x90", 5, 3}, {"Iopf;", "\xF0\x9D\x95\x80", 5, 4}, {"thinsp;", "\xE2\x80\x89", 7, 3},
+    {"hopf;", "\xF0\x9D\x95\x99", 5, 4}, {"circlearrowleft;", "\xE2\x86\xBA", 16, 3}, {"PlusMinus;", "\xC2\xB1", 10, 2},
+    {"esim;", "\xE2\x89\x82", 5, 3}, {"sfrown;", "\xE2\x8C\xA2", 7, 3}, {"Tilde;", "\xE2\x88\xBC", 6, 3},
+    {"NotSucceeds;", "\xE2\x8A\x81", 12, 3}, {"isindot;", "\xE2\x8B\xB5", 8, 3}, {"cwconint;", "\xE2\x88\xB2", 9, 3},
+    {"LeftUpTeeVector;", "\xE2\xA5\xA0", 16, 3}, {"Vvdash;", "\xE2\x8A\xAA", 7, 3}, {"sigmaf;", "\xCF\x82", 7, 2},
+    {"NotLessLess;", "\xE2\x89\xAA\xCC\xB8", 12, 5}, {"boxbox;", "\xE2\xA7\x89", 7, 3}, {"Ograve", "\xC3\x92", 6, 2},
+    {"Ropf;", "\xE2\x84\x9D", 5, 3}, {"LessFullEqual;", "\xE2\x89\xA6", 14, 3}, {"REG;", "\xC2\xAE", 4, 2},
+    {"middot", "\xC2\xB7", 6, 2}, {"prap;", "\xE2\xAA\xB7", 5, 3}, {"hearts;", "\xE2\x99\xA5", 7, 3},
+    {"plusdo;", "\xE2\x88\x94", 7, 3}, {"siml;", "\xE2\xAA\x9D", 5, 3}, {"order;", "\xE2\x84\xB4", 6, 3},
+    {"NotNestedGreaterGreater;", "\xE2\xAA\xA2\xCC\xB8", 24, 5}, {"ngeqq;", "\xE2\x89\xA7\xCC\xB8", 6, 5}, {"racute;", "\xC5\x95", 7, 2},
+    {"odsold;", "\xE2\xA6\xBC", 7, 3}, {"lozenge;", "\xE2\x97\x8A", 8, 3}, {"gtcc;", "\xE2\xAA\xA7", 5, 3},
+    {"angrt;", "\xE2\x88\x9F", 6, 3}, {"apid;", "\xE2\x89\x8B", 5, 3}, {"RightTeeArrow;", "\xE2\x86\xA6", 14, 3},
+    {"agrave", "\xC3\xA0", 6, 2}, {"ntrianglerighteq;", "\xE2\x8B\xAD", 17, 3}, {"sol;", "\x2F", 4, 1},
+    {"sup2;", "\xC2\xB2", 5, 2}, {"nsucc;", "\xE2\x8A\x81", 6, 3}, {"oscr;", "\xE2\x84\xB4", 5, 3},
+    {"qopf;", "\xF0\x9D\x95\xA2", 5, 4}, {"nwnear;", "\xE2\xA4\xA7", 7, 3}, {"int;", "\xE2\x88\xAB", 4, 3},
+    {"ufisht;", "\xE2\xA5\xBE", 7, 3}, {"subnE;", "\xE2\xAB\x8B", 6, 3}, {"Ycirc;", "\xC5\xB6", 6, 2},
+    {"Ccaron;", "\xC4\x8C", 7, 2}, {"Aring;", "\xC3\x85", 6, 2}, {"cups;", "\xE2\x88\xAA\xEF\xB8\x80", 5, 6},
+    {"agrave;", "\xC3\xA0", 7, 2}, {"auml;", "\xC3\xA4", 5, 2}, {"nrtrie;", "\xE2\x8B\xAD", 7, 3},
+    {"bbrktbrk;", "\xE2\x8E\xB6", 9, 3}, {"shy;", "\xC2\xAD", 4, 2}, {"profsurf;", "\xE2\x8C\x93", 9, 3},
+    {"ffilig;", "\xEF\xAC\x83", 7, 3}, {"dzigrarr;", "\xE2\x9F\xBF", 9, 3}, {"ugrave", "\xC3\xB9", 6, 2},
+    {"Precedes;", "\xE2\x89\xBA", 9, 3}, {"incare;", "\xE2\x84\x85", 7, 3}, {"Ufr;", "\xF0\x9D\x94\x98", 4, 4},
+    {"leftthreetimes;", "\xE2\x8B\x8B", 15, 3}, {"planck;", "\xE2\x84\x8F", 7, 3}, {"sfr;", "\xF0\x9D\x94\xB0", 4, 4},
+    {"Int;", "\xE2\x88\xAC", 4, 3}, {"NotSubsetEqual;", "\xE2\x8A\x88", 15, 3}, {"Backslash;", "\xE2\x88\x96", 10, 3},
+    {"prnap;", "\xE2\xAA\xB9", 6, 3}, {"jscr;", "\xF0\x9D\x92\xBF", 5, 4}, {"gscr;", "\xE2\x84\x8A", 5, 3},
+    {"NotReverseElement;", "\xE2\x88\x8C", 18, 3}, {"UnderBrace;", "\xE2\x8F\x9F", 11, 3}, {"loarr;", "\xE2\x87\xBD", 6, 3},
+    {"igrave", "\xC3\xAC", 6, 2}, {"wfr;", "\xF0\x9D\x94\xB4", 4, 4}, {"emsp;", "\xE2\x80\x83", 5, 3},
+    {"Ncaron;", "\xC5\x87", 7, 2}, {"smid;", "\xE2\x88\xA3", 5, 3}, {"Kscr;", "\xF0\x9D\x92\xA6", 5, 4},
+    {"napE;", "\xE2\xA9\xB0\xCC\xB8", 5, 5}, {"Lcedil;", "\xC4\xBB", 7, 2}, {"pcy;", "\xD0\xBF", 4, 2},
+    {"Efr;", "\xF0\x9D\x94\x88", 4, 4}, {"Longrightarrow;", "\xE2\x9F\xB9", 15, 3}, {"VeryThinSpace;", "\xE2\x80\x8A", 14, 3},
+    {"Eogon;", "\xC4\x98", 6, 2}, {"sqsub;", "\xE2\x8A\x8F", 6, 3}, {"rlm;", "\xE2\x80\x8F", 4, 3},
+    {"RightDownVectorBar;", "\xE2\xA5\x95", 19, 3}, {"Vdash;", "\xE2\x8A\xA9", 6, 3}, {"eth;", "\xC3\xB0", 4, 2},
+    {"MinusPlus;", "\xE2\x88\x93", 10, 3}, {"ltri;", "\xE2\x97\x83", 5, 3}, {"NotGreaterGreater;", "\xE2\x89\xAB\xCC\xB8", 18, 5},
+    {"ccedil", "\xC3\xA7", 6, 2}, {"ycirc;", "\xC5\xB7", 6, 2}, {"phmmat;", "\xE2\x84\xB3", 7, 3},
+    {"rarrpl;", "\xE2\xA5\x85", 7, 3}, {"longmapsto;", "\xE2\x9F\xBC", 11, 3}, {"nvsim;", "\xE2\x88\xBC\xE2\x83\x92", 6, 6},
+    {"wedgeq;", "\xE2\x89\x99", 7, 3}, {"eopf;", "\xF0\x9D\x95\x96", 5, 4}, {"Omega;", "\xCE\xA9", 6, 2},
+    {"Amacr;", "\xC4\x80", 6, 2}, {"ShortRightArrow;", "\xE2\x86\x92", 16, 3}, {"qscr;", "\xF0\x9D\x93\x86", 5, 4},
+    {"bump;", "\xE2\x89\x8E", 5, 3}, {"ensp;", "\xE2\x80\x82", 5, 3}, {"Rcaron;", "\xC5\x98", 7, 2},
+    {"ang;", "\xE2\x88\xA0", 4, 3}, {"GreaterEqualLess;", "\xE2\x8B\x9B", 17, 3}, {"Rscr;", "\xE2\x84\x9B", 5, 3},
+    {"simne;", "\xE2\x89\x86", 6, 3}, {"Conint;", "\xE2\x88\xAF", 7, 3}, {"RightTriangleBar;", "\xE2\xA7\x90", 17, 3},
+    {"nesear;", "\xE2\xA4\xA8", 7, 3}, {"nsupseteq;", "\xE2\x8A\x89", 10, 3}, {"QUOT;", "\x22", 5, 1},
+    {"minus;", "\xE2\x88\x92", 6, 3}, {"Atilde", "\xC3\x83", 6, 2}, {"fscr;", "\xF0\x9D\x92\xBB", 5, 4},
+    {"succeq;", "\xE2\xAA\xB0", 7, 3}, {"lescc;", "\xE2\xAA\xA8", 6, 3}, {"frac12;", "\xC2\xBD", 7, 2},
+    {"boxVh;", "\xE2\x95\xAB", 6, 3}, {"napid;", "\xE2\x89\x8B\xCC\xB8", 6, 5}, {"scap;", "\xE2\xAA\xB8", 5, 3},
+    {"NestedGreaterGreater;", "\xE2\x89\xAB", 21, 3}, {"fllig;", "\xEF\xAC\x82", 6, 3}, {"supsup;", "\xE2\xAB\x96", 7, 3},
+    {"IEcy;", "\xD0\x95", 5, 2}, {"para;", "\xC2\xB6", 5, 2}, {"mDDot;", "\xE2\x88\xBA", 6, 3},
+    {"Phi;", "\xCE\xA6", 4, 2}, {"darr;", "\xE2\x86\x93", 5, 3}, {"bcy;", "\xD0\xB1", 4, 2},
+    {"Udblac;", "\xC5\xB0", 7, 2}, {"curvearrowleft;", "\xE2\x86\xB6", 15, 3}, {"acd;", "\xE2\x88\xBF", 4, 3},
+    {"timesb;", "\xE2\x8A\xA0", 7, 3}, {"andslope;", "\xE2\xA9\x98", 9, 3}, {"TRADE;", "\xE2\x84\xA2", 6, 3},
+    {"RightDownTeeVector;", "\xE2\xA5\x9D", 19, 3}, {"InvisibleTimes;", "\xE2\x81\xA2", 15, 3}, {"twoheadrightarrow;", "\xE2\x86\xA0", 18, 3},
+    {"llarr;", "\xE2\x87\x87", 6, 3}, {"Ifr;", "\xE2\x84\x91", 4, 3}, {"minusdu;", "\xE2\xA8\xAA", 8, 3},
+    {"UpTeeArrow;", "\xE2\x86\xA5", 11, 3}, {"nsup;", "\xE2\x8A\x85", 5, 3}, {"boxUr;", "\xE2\x95\x99", 6, 3},
+    {"bigtriangleup;", "\xE2\x96\xB3", 14, 3}, {"eqsim;", "\xE2\x89\x82", 6, 3}, {"nwarr;", "\xE2\x86\x96", 6, 3},
+    {"compfn;", "\xE2\x88\x98", 7, 3}, {"njcy;", "\xD1\x9A", 5, 2}, {"cup;", "\xE2\x88\xAA", 4, 3},
+    {"NotExists;", "\xE2\x88\x84", 10, 3}, {"tbrk;", "\xE2\x8E\xB4", 5, 3}, {"NotLeftTriangleEqual;", "\xE2\x8B\xAC", 21, 3},
+    {"Ocy;", "\xD0\x9E", 4, 2}, {"zwj;", "\xE2\x80\x8D", 4, 3}, {"lrhar;", "\xE2\x87\x8B", 6, 3},
+    {"nap;", "\xE2\x89\x89", 4, 3}, {"ovbar;", "\xE2\x8C\xBD", 6, 3}, {"LeftDownVectorBar;", "\xE2\xA5\x99", 18, 3},
+    {"empty;", "\xE2\x88\x85", 6, 3}, {"Not;", "\xE2\xAB\xAC", 4, 3}, {"vfr;", "\xF0\x9D\x94\xB3", 4, 4},
+    {"lHar;", "\xE2\xA5\xA2", 5, 3}, {"nGg;", "\xE2\x8B\x99\xCC\xB8", 4, 5}, {"LeftTeeVector;", "\xE2\xA5\x9A", 14, 3},
+    {"Dfr;", "\xF0\x9D\x94\x87", 4, 4}, {"Oslash", "\xC3\x98", 6, 2}, {"nge;", "\xE2\x89\xB1", 4, 3},
+    {"asympeq;", "\xE2\x89\x8D", 8, 3}, {"urcrop;", "\xE2\x8C\x8E", 7, 3}, {"Assign;", "\xE2\x89\x94", 7, 3},
+    {"nLl;", "\xE2\x8B\x98\xCC\xB8", 4, 5}, {"NotPrecedesEqual;", "\xE2\xAA\xAF\xCC\xB8", 17, 5}, {"questeq;", "\xE2\x89\x9F", 8, 3},
+    {"angle;", "\xE2\x88\xA0", 6, 3}, {"lesdotor;", "\xE2\xAA\x83", 9, 3}, {"pre;", "\xE2\xAA\xAF", 4, 3},
+    {"nharr;", "\xE2\x86\xAE", 6, 3}, {"glE;", "\xE2\xAA\x92", 4, 3}, {"capdot;", "\xE2\xA9\x80", 7, 3},
+    {"ominus;", "\xE2\x8A\x96", 7, 3}, {"scy;", "\xD1\x81", 4, 2}, {"filig;", "\xEF\xAC\x81", 6, 3},
+    {"macr;", "\xC2\xAF", 5, 2}, {"thetav;", "\xCF\x91", 7, 2}, {"acute;", "\xC2\xB4", 6, 2},
+    {"nsubseteqq;", "\xE2\xAB\x85\xCC\xB8", 11, 5}, {"DJcy;", "\xD0\x82", 5, 2}, {"intcal;", "\xE2\x8A\xBA", 7, 3},
+    {"vnsup;", "\xE2\x8A\x83\xE2\x83\x92", 6, 6}, {"blacktriangleleft;", "\xE2\x97\x82", 18, 3}, {"lhblk;", "\xE2\x96\x84", 6, 3},
+    {"part;", "\xE2\x88\x82", 5, 3}, {"sqsubset;", "\xE2\x8A\x8F", 9, 3}, {"larrhk;", "\xE2\x86\xA9", 7, 3},
+    {"theta;", "\xCE\xB8", 6, 2}, {"ograve", "\xC3\xB2", 6, 2}, {"gnapprox;", "\xE2\xAA\x8A", 9, 3},
+    {"gesdotol;", "\xE2\xAA\x84", 9, 3}, {"fopf;", "\xF0\x9D\x95\x97", 5, 4}, {"Ccedil", "\xC3\x87", 6, 2},
+    {"curren;", "\xC2\xA4", 7, 2}, {"race;", "\xE2\x88\xBD\xCC\xB1", 5, 5}, {"Gcy;", "\xD0\x93", 4, 2},
+    {"backepsilon;", "\xCF\xB6", 12, 2}, {"crarr;", "\xE2\x86\xB5", 6, 3}, {"lurdshar;", "\xE2\xA5\x8A", 9, 3},
+    {"LeftVectorBar;", "\xE2\xA5\x92", 14, 3}, {"ntriangleright;", "\xE2\x8B\xAB", 15, 3}, {"LeftUpVector;", "\xE2\x86\xBF", 13, 3},
+    {"rbrke;", "\xE2\xA6\x8C", 6, 3}, {"Uuml", "\xC3\x9C", 4, 2}, {"Jcy;", "\xD0\x99", 4, 2},
+    {"frac15;", "\xE2\x85\x95", 7, 3}, {"Fopf;", "\xF0\x9D\x94\xBD", 5, 4}, {"nearrow;", "\xE2\x86\x97", 8, 3},
+    {"NotNestedLessLess;", "\xE2\xAA\xA1\xCC\xB8", 18, 5}, {"precapprox;", "\xE2\xAA\xB7", 11, 3}, {"KHcy;", "\xD0\xA5", 5, 2},
+    {"eacute", "\xC3\xA9", 6, 2}, {"lArr;", "\xE2\x87\x90", 5, 3}, {"FilledSmallSquare;", "\xE2\x97\xBC", 18, 3},
+    {"plusdu;", "\xE2\xA8\xA5", 7, 3}, {"mho;", "\xE2\x84\xA7", 4, 3}, {"Ocirc;", "\xC3\x94", 6, 2},
+    {"sup;", "\xE2\x8A\x83", 4, 3}, {"deg;", "\xC2\xB0", 4, 2}, {"isinsv;", "\xE2\x8B\xB3", 7, 3},
+    {"looparrowleft;", "\xE2\x86\xAB", 14, 3}, {"sqcup;", "\xE2\x8A\x94", 6, 3}, {"Pcy;", "\xD0\x9F", 4, 2},
+    {"bprime;", "\xE2\x80\xB5", 7, 3}, {"rsquor;", "\xE2\x80\x99", 7, 3}, {"nGt;", "\xE2\x89\xAB\xE2\x83\x92", 4, 6},
+    {"MediumSpace;", "\xE2\x81\x9F", 12, 3}, {"Longleftrightarrow;", "\xE2\x9F\xBA", 19, 3}, {"npar;", "\xE2\x88\xA6", 5, 3},
+    {"dollar;", "\x24", 7, 1}, {"boxUL;", "\xE2\x95\x9D", 6, 3}, {"Sum;", "\xE2\x88\x91", 4, 3},
+    {"comma;", "\x2C", 6, 1}, {"Lopf;", "\xF0\x9D\x95\x83", 5, 4}, {"nisd;", "\xE2\x8B\xBA", 5, 3},
+    {"ngeq;", "\xE2\x89\xB1", 5, 3}, {"varsupsetneqq;", "\xE2\xAB\x8C\xEF\xB8\x80", 14, 6}, {"gescc;", "\xE2\xAA\xA9", 6, 3},
+    {"LeftFloor;", "\xE2\x8C\x8A", 10, 3}, {"rightrightarrows;", "\xE2\x87\x89", 17, 3}, {"ngt;", "\xE2\x89\xAF", 4, 3},
+    {"tscy;", "\xD1\x86", 5, 2}, {"Therefore;", "\xE2\x88\xB4", 10, 3}, {"supset;", "\xE2\x8A\x83", 7, 3},
+    {"Sup;", "\xE2\x8B\x91", 4, 3}, {"succ;", "\xE2\x89\xBB", 5, 3}, {"frac38;", "\xE2\x85\x9C", 7, 3},
+    {"rightleftarrows;", "\xE2\x87\x84", 16, 3}, {"AElig;", "\xC3\x86", 6, 2}, {"Dashv;", "\xE2\xAB\xA4", 6, 3},
+    {"boxh;", "\xE2\x94\x80", 5, 3}, {"Ncedil;", "\xC5\x85", 7, 2}, {"image;", "\xE2\x84\x91", 6, 3},
+    {"SHcy;", "\xD0\xA8", 5, 2}, {"seArr;", "\xE2\x87\x98", 6, 3}, {"ldquo;", "\xE2\x80\x9C", 6, 3},
+    {"dbkarow;", "\xE2\xA4\x8F", 8, 3}, {"ulcrop;", "\xE2\x8C\x8F", 7, 3}, {"lcy;", "\xD0\xBB", 4, 2},
+    {"suplarr;", "\xE2\xA5\xBB", 8, 3}, {"times", "\xC3\x97", 5, 2}, {"trpezium;", "\xE2\x8F\xA2", 9, 3},
+    {"malt;", "\xE2\x9C\xA0", 5, 3}, {"lscr;", "\xF0\x9D\x93\x81", 5, 4}, {"doteq;", "\xE2\x89\x90", 6, 3},
+    {"upsilon;", "\xCF\x85", 8, 2}, {"coprod;", "\xE2\x88\x90", 7, 3}, {"Iacute;", "\xC3\x8D", 7, 2},
+    {"sup3", "\xC2\xB3", 4, 2}, {"Downarrow;", "\xE2\x87\x93", 10, 3}, {"nopf;", "\xF0\x9D\x95\x9F", 5, 4},
+    {"zscr;", "\xF0\x9D\x93\x8F", 5, 4}, {"rrarr;", "\xE2\x87\x89", 6, 3}, {"LessTilde;", "\xE2\x89\xB2", 10, 3},
+    {"Scirc;", "\xC5\x9C", 6, 2}, {"lfloor;", "\xE2\x8C\x8A", 7, 3}, {"notniva;", "\xE2\x88\x8C", 8, 3},
+    {"prE;", "\xE2\xAA\xB3", 4, 3}, {"rsqb;", "\x5D", 5, 1}, {"lopf;", "\xF0\x9D\x95\x9D", 5, 4},
+    {"maltese;", "\xE2\x9C\xA0", 8, 3}, {"Cconint;", "\xE2\x88\xB0", 8, 3}, {"phi;", "\xCF\x86", 4, 2},
+    {"orarr;", "\xE2\x86\xBB", 6, 3}, {"Omicron;", "\xCE\x9F", 8, 2}, {"ropar;", "\xE2\xA6\x86", 6, 3},
+    {"Tau;", "\xCE\xA4", 4, 2}, {"RightTeeVector;", "\xE2\xA5\x9B", 15, 3}, {"plusb;", "\xE2\x8A\x9E", 6, 3},
+    {"euro;", "\xE2\x82\xAC", 5, 3}, {"RightDownVector;", "\xE2\x87\x82", 16, 3}, {"Aopf;", "\xF0\x9D\x94\xB8", 5, 4},
+    {"Kcedil;", "\xC4\xB6", 7, 2}, {"olt;", "\xE2\xA7\x80", 4, 3}, {"weierp;", "\xE2\x84\x98", 7, 3},
+    {"zwnj;", "\xE2\x80\x8C", 5, 3}, {"AMP;", "\x26", 4, 1}, {"Lcaron;", "\xC4\xBD", 7, 2},
+    {"capcup;", "\xE2\xA9\x87", 7, 3}, {"Supset;", "\xE2\x8B\x91", 7, 3}, {"NotLeftTriangle;", "\xE2\x8B\xAA", 16, 3},
+    {"wscr;", "\xF0\x9D\x93\x8C", 5, 4}, {"imath;", "\xC4\xB1", 6, 2}, {"Wfr;", "\xF0\x9D\x94\x9A", 4, 4},
+    {"NotRightTriangleBar;", "\xE2\xA7\x90\xCC\xB8", 20, 5}, {"copy", "\xC2\xA9", 4, 2}, {"NotGreaterLess;", "\xE2\x89\xB9", 15, 3},
+    {"ImaginaryI;", "\xE2\x85\x88", 11, 3}, {"dzcy;", "\xD1\x9F", 5, 2}, {"NotSquareSubsetEqual;", "\xE2\x8B\xA2", 21, 3},
+    {"Beta;", "\xCE\x92", 5, 2}, {"nsubE;", "\xE2\xAB\x85\xCC\xB8", 6, 5}, {"Ubreve;", "\xC5\xAC", 7, 2},
+    {"supseteq;", "\xE2\x8A\x87", 9, 3}, {"NotGreaterTilde;", "\xE2\x89\xB5", 16, 3}, {"csupe;", "\xE2\xAB\x92", 6, 3},
+    {"smallsetminus;", "\xE2\x88\x96", 14, 3}, {"VerticalLine;", "\x7C", 13, 1}, {"xcap;", "\xE2\x8B\x82", 5, 3},
+    {"rhov;", "\xCF\xB1", 5, 2}, {"oast;", "\xE2\x8A\x9B", 5, 3}, {"ecy;", "\xD1\x8D", 4, 2},
+    {"boxvl;", "\xE2\x94\xA4", 6, 3}, {"triplus;", "\xE2\xA8\xB9", 8, 3}, {"dharl;", "\xE2\x87\x83", 6, 3},
+    {"iexcl", "\xC2\xA1", 5, 2}, {"ratail;", "\xE2\xA4\x9A", 7, 3}, {"angmsdaa;", "\xE2\xA6\xA8", 9, 3},
+    {"lesseqgtr;", "\xE2\x8B\x9A", 10, 3}, {"rarrap;", "\xE2\xA5\xB5", 7, 3}, {"dotsquare;", "\xE2\x8A\xA1", 10, 3},
+    {"mp;", "\xE2\x88\x93", 3, 3}, {"capbrcup;", "\xE2\xA9\x89", 9, 3}, {"micro", "\xC2\xB5", 5, 2},
+    {"eparsl;", "\xE2\xA7\xA3", 7, 3}, {"ape;", "\xE2\x89\x8A", 4, 3}, {"ubreve;", "\xC5\xAD", 7, 2},
+    {"bnot;", "\xE2\x8C\x90", 5, 3}, {"lmoust;", "\xE2\x8E\xB0", 7, 3}, {"boxUl;", "\xE2\x95\x9C", 6, 3},
+    {"bigstar;", "\xE2\x98\x85", 8, 3}, {"uml;", "\xC2\xA8", 4, 2}, {"scnap;", "\xE2\xAA\xBA", 6, 3},
+    {"trianglelefteq;", "\xE2\x8A\xB4", 15, 3}, {"Ccirc;", "\xC4\x88", 6, 2}, {"VDash;", "\xE2\x8A\xAB", 6, 3},
+    {"aogon;", "\xC4\x85", 6, 2}, {"mapstoup;", "\xE2\x86\xA5", 9, 3}, {"NotCupCap;", "\xE2\x89\xAD", 10, 3},
+    {"swarhk;", "\xE2\xA4\xA6", 7, 3}, {"RuleDelayed;", "\xE2\xA7\xB4", 12, 3}, {"frac58;", "\xE2\x85\x9D", 7, 3},
+    {"SucceedsTilde;", "\xE2\x89\xBF", 14, 3}, {"emptyv;", "\xE2\x88\x85", 7, 3}, {"lbrke;", "\xE2\xA6\x8B", 6, 3},
+    {"aring", "\xC3\xA5", 5, 2}, {"simgE;", "\xE2\xAA\xA0", 6, 3}, {"HARDcy;", "\xD0\xAA", 7, 2},
+    {"NotTildeEqual;", "\xE2\x89\x84", 14, 3}, {"boxH;", "\xE2\x95\x90", 5, 3}, {"gtrapprox;", "\xE2\xAA\x86", 10, 3},
+    {"ZeroWidthSpace;", "\xE2\x80\x8B", 15, 3}, {"sqsup;", "\xE2\x8A\x90", 6, 3}, {"bkarow;", "\xE2\xA4\x8D", 7, 3},
+    {"intercal;", "\xE2\x8A\xBA", 9, 3}, {"eqslantgtr;", "\xE2\xAA\x96", 11, 3}, {"tau;", "\xCF\x84", 4, 2},
+    {"rmoustache;", "\xE2\x8E\xB1", 11, 3}, {"Wedge;", "\xE2\x8B\x80", 6, 3}, {"curvearrowright;", "\xE2\x86\xB7", 16, 3},
+    {"vzigzag;", "\xE2\xA6\x9A", 8, 3}, {"check;", "\xE2\x9C\x93", 6, 3}, {"tint;", "\xE2\x88\xAD", 5, 3},
+    {"rharul;", "\xE2\xA5\xAC", 7, 3}, {"scpolint;", "\xE2\xA8\x93", 9, 3}, {"Lleftarrow;", "\xE2\x87\x9A", 11, 3},
+    {"Hfr;", "\xE2\x84\x8C", 4, 3}, {"efDot;", "\xE2\x89\x92", 6, 3}, {"NotLeftTriangleBar;", "\xE2\xA7\x8F\xCC\xB8", 19, 5},
+    {"Dcaron;", "\xC4\x8E", 7, 2}, {"varkappa;", "\xCF\xB0", 9, 2}, {"DoubleRightTee;", "\xE2\x8A\xA8", 15, 3},
+    {"thksim;", "\xE2\x88\xBC", 7, 3}, {"bigoplus;", "\xE2\xA8\x81", 9, 3}, {"CloseCurlyDoubleQuote;", "\xE2\x80\x9D", 22, 3},
+    {"Bumpeq;", "\xE2\x89\x8E", 7, 3}, {"leftleftarrows;", "\xE2\x87\x87", 15, 3}, {"cscr;", "\xF0\x9D\x92\xB8", 5, 4},
+    {"NotLessTilde;", "\xE2\x89\xB4", 13, 3}, {"Utilde;", "\xC5\xA8", 7, 2}, {"nvrtrie;", "\xE2\x8A\xB5\xE2\x83\x92", 8, 6},
+    {"yfr;", "\xF0\x9D\x94\xB6", 4, 4}, {"NotSquareSupersetEqual;", "\xE2\x8B\xA3", 23, 3}, {"cylcty;", "\xE2\x8C\xAD", 7, 3},
+    {"Leftarrow;", "\xE2\x87\x90", 10, 3}, {"Chi;", "\xCE\xA7", 4, 2}, {"target;", "\xE2\x8C\x96", 7, 3},
+    {"triminus;", "\xE2\xA8\xBA", 9, 3}, {"roarr;", "\xE2\x87\xBE", 6, 3}, {"rpargt;", "\xE2\xA6\x94", 7, 3},
+    {"topcir;", "\xE2\xAB\xB1", 7, 3}, {"topfork;", "\xE2\xAB\x9A", 8, 3}, {"Ll;", "\xE2\x8B\x98", 3, 3},
+    {"quot;", "\x22", 5, 1}, {"atilde;", "\xC3\xA3", 7, 2}, {"xfr;", "\xF0\x9D\x94\xB5", 4, 4},
+    {"ord;", "\xE2\xA9\x9D", 4, 3}, {"yacute;", "\xC3\xBD", 7, 2}, {"Aogon;", "\xC4\x84", 6, 2},
+    {"Dopf;", "\xF0\x9D\x94\xBB", 5, 4}, {"acE;", "\xE2\x88\xBE\xCC\xB3", 4, 5}, {"hksearow;", "\xE2\xA4\xA5", 9, 3},
+    {"lBarr;", "\xE2\xA4\x8E", 6, 3}, {"Sscr;", "\xF0\x9D\x92\xAE", 5, 4}, {"YIcy;", "\xD0\x87", 5, 2},
+    {"OverBrace;", "\xE2\x8F\x9E", 10, 3}, {"eogon;", "\xC4\x99", 6, 2}, {"larrsim;", "\xE2\xA5\xB3", 8, 3},
+    {"rang;", "\xE2\x9F\xA9", 5, 3}, {"brvbar", "\xC2\xA6", 6, 2}, {"nsube;", "\xE2\x8A\x88", 6, 3},
+    {"cuvee;", "\xE2\x8B\x8E", 6, 3}, {"iprod;", "\xE2\xA8\xBC", 6, 3}, {"upsi;", "\xCF\x85", 5, 2},
+    {"bigsqcup;", "\xE2\xA8\x86", 9, 3}, {"icirc;", "\xC3\xAE", 6, 2}, {"kopf;", "\xF0\x9D\x95\x9C", 5, 4},
+    {"boxuR;", "\xE2\x95\x98", 6, 3}, {"softcy;", "\xD1\x8C", 7, 2}, {"oline;", "\xE2\x80\xBE", 6, 3},
+    {"cupbrcap;", "\xE2\xA9\x88", 9, 3}, {"lsim;", "\xE2\x89\xB2", 5, 3}, {"ldrdhar;", "\xE2\xA5\xA7", 8, 3},
+    {"swArr;", "\xE2\x87\x99", 6, 3}, {"nleqq;", "\xE2\x89\xA6\xCC\xB8", 6, 5}, {"hookrightarrow;", "\xE2\x86\xAA", 15, 3},
+    {"Scaron;", "\xC5\xA0", 7, 2}, {"lsh;", "\xE2\x86\xB0", 4, 3}, {"Iogon;", "\xC4\xAE", 6, 2},
+    {"nvge;", "\xE2\x89\xA5\xE2\x83\x92", 5, 6}, {"DoubleLongRightArrow;", "\xE2\x9F\xB9", 21, 3}, {"lsime;", "\xE2\xAA\x8D", 6, 3},
+    {"xoplus;", "\xE2\xA8\x81", 7, 3}, {"ForAll;", "\xE2\x88\x80", 7, 3}, {"ic;", "\xE2\x81\xA3", 3, 3},
+    {"infintie;", "\xE2\xA7\x9D", 9, 3}, {"OpenCurlyDoubleQuote;", "\xE2\x80\x9C", 21, 3}, {"subdot;", "\xE2\xAA\xBD", 7, 3},
+    {"harr;", "\xE2\x86\x94", 5, 3}, {"lAtail;", "\xE2\xA4\x9B", 7, 3}, {"and;", "\xE2\x88\xA7", 4, 3},
+    {"gel;", "\xE2\x8B\x9B", 4, 3}, {"boxVL;", "\xE2\x95\xA3", 6, 3}, {"angrtvbd;", "\xE2\xA6\x9D", 9, 3},
+    {"pointint;", "\xE2\xA8\x95", 9, 3}, {"oopf;", "\xF0\x9D\x95\xA0", 5, 4}, {"nldr;", "\xE2\x80\xA5", 5, 3},
+    {"lsquo;", "\xE2\x80\x98", 6, 3}, {"Darr;", "\xE2\x86\xA1", 5, 3}, {"gvertneqq;", "\xE2\x89\xA9\xEF\xB8\x80", 10, 6},
+    {"colone;", "\xE2\x89\x94", 7, 3}, {"Vdashl;", "\xE2\xAB\xA6", 7, 3}, {"NotElement;", "\xE2\x88\x89", 11, 3},
+    {"DiacriticalGrave;", "\x60", 17, 1}, {"emsp14;", "\xE2\x80\x85", 7, 3}, {"swarrow;", "\xE2\x86\x99", 8, 3},
+    {"ldquor;", "\xE2\x80\x9E", 7, 3}, {"cupor;", "\xE2\xA9\x85", 6, 3}, {"AMP", "\x26", 3, 1},
+    {"grave;", "\x60", 6, 1}, {"rfisht;", "\xE2\xA5\xBD", 7, 3}, {"pound", "\xC2\xA3", 5, 2},
+    {"hbar;", "\xE2\x84\x8F", 5, 3}, {"utri;", "\xE2\x96\xB5", 5, 3}, {"RightAngleBracket;", "\xE2\x9F\xA9", 18, 3},
+    {"downarrow;", "\xE2\x86\x93", 10, 3}, {"pertenk;", "\xE2\x80\xB1", 8, 3}, {"cupcap;", "\xE2\xA9\x86", 7, 3},
+    {"Ntilde", "\xC3\x91", 6, 2}, {"hstrok;", "\xC4\xA7", 7, 2}, {"phone;", "\xE2\x98\x8E", 6, 3},
+    {"lbarr;", "\xE2\xA4\x8C", 6, 3}, {"subsup;", "\xE2\xAB\x93", 7, 3}, {"rtri;", "\xE2\x96\xB9", 5, 3},
+    {"succnapprox;", "\xE2\xAA\xBA", 12, 3}, {"GJcy;", "\xD0\x83", 5, 2}, {"beta;", "\xCE\xB2", 5, 2},
+    {"Egrave", "\xC3\x88", 6, 2}, {"caron;", "\xCB\x87", 6, 2}, {"HorizontalLine;", "\xE2\x94\x80", 15, 3},
+    {"intprod;", "\xE2\xA8\xBC", 8, 3}, {"subseteqq;", "\xE2\xAB\x85", 10, 3}, {"midcir;", "\xE2\xAB\xB0", 7, 3},
+    {"dscy;", "\xD1\x95", 5, 2}, {"Theta;", "\xCE\x98", 6, 2}, {"Square;", "\xE2\x96\xA1", 7, 3},
+    {"sopf;", "\xF0\x9D\x95\xA4", 5, 4}, {"supseteqq;", "\xE2\xAB\x86", 10, 3}, {"NotPrecedesSlantEqual;", "\xE2\x8B\xA0", 22, 3},
+    {"VerticalBar;", "\xE2\x88\xA3", 12, 3}, {"thickapprox;", "\xE2\x89\x88", 12, 3}, {"integers;", "\xE2\x84\xA4", 9, 3},
+    {"eqslantless;", "\xE2\xAA\x95", 12, 3}, {"uhblk;", "\xE2\x96\x80", 6, 3}, {"TildeFullEqual;", "\xE2\x89\x85", 15, 3},
+    {"DoubleContourIntegral;", "\xE2\x88\xAF", 22, 3}, {"iocy;", "\xD1\x91", 5, 2}, {"NotGreaterSlantEqual;", "\xE2\xA9\xBE\xCC\xB8", 21, 5},
+    {"frac14", "\xC2\xBC", 6, 2}, {"SquareIntersection;", "\xE2\x8A\x93", 19, 3}, {"late;", "\xE2\xAA\xAD", 5, 3},
+    {"squ;", "\xE2\x96\xA1", 4, 3}, {"Cacute;", "\xC4\x86", 7, 2}, {"nvltrie;", "\xE2\x8A\xB4\xE2\x83\x92", 8, 6},
+    {"uscr;", "\xF0\x9D\x93\x8A", 5, 4}, {"omicron;", "\xCE\xBF", 8, 2}, {"isins;", "\xE2\x8B\xB4", 6, 3},
+    {"boxHu;", "\xE2\x95\xA7", 6, 3}, {"xscr;", "\xF0\x9D\x93\x8D", 5, 4}, {"vee;", "\xE2\x88\xA8", 4, 3},
+    {"AElig", "\xC3\x86", 5, 2}, {"Rightarrow;", "\xE2\x87\x92", 11, 3}, {"simg;", "\xE2\xAA\x9E", 5, 3},
+    {"toea;", "\xE2\xA4\xA8", 5, 3}, {"DoubleUpDownArrow;", "\xE2\x87\x95", 18, 3}, {"vDash;", "\xE2\x8A\xA8", 6, 3},
+    {"umacr;", "\xC5\xAB", 6, 2}, {"Acirc;", "\xC3\x82", 6, 2}, {"euml;", "\xC3\xAB", 5, 2},
+    {"Mu;", "\xCE\x9C", 3, 2}, {"uuml;", "\xC3\xBC", 5, 2}, {"FilledVerySmallSquare;", "\xE2\x96\xAA", 22, 3},
+    {"ltrif;", "\xE2\x97\x82", 6, 3}, {"sub;", "\xE2\x8A\x82", 4, 3}, {"dfr;", "\xF0\x9D\x94\xA1", 4, 4},
+    {"zcaron;", "\xC5\xBE", 7, 2}, {"ENG;", "\xC5\x8A", 4, 2}, {"ordf;", "\xC2\xAA", 5, 2},
+    {"capcap;", "\xE2\xA9\x8B", 7, 3}, {"shchcy;", "\xD1\x89", 7, 2}, {"equest;", "\xE2\x89\x9F", 7, 3},
+    {"Icirc", "\xC3\x8E", 5, 2}, {"Qfr;", "\xF0\x9D\x94\x94", 4, 4}, {"gcy;", "\xD0\xB3", 4, 2},
+    {"uuml", "\xC3\xBC", 4, 2}, {"DoubleRightArrow;", "\xE2\x87\x92", 17, 3}, {"gsiml;", "\xE2\xAA\x90", 6, 3},
+    {"gtquest;", "\xE2\xA9\xBC", 8, 3}, {"rdsh;", "\xE2\x86\xB3", 5, 3}, {"ldsh;", "\xE2\x86\xB2", 5, 3},
+    {"SOFTcy;", "\xD0\xAC", 7, 2}, {"lE;", "\xE2\x89\xA6", 3, 3}, {"Uarrocir;", "\xE2\xA5\x89", 9, 3},
+    {"Barv;", "\xE2\xAB\xA7", 5, 3}, {"measuredangle;", "\xE2\x88\xA1", 14, 3}, {"Ouml", "\xC3\x96", 4, 2},
+    {"wopf;", "\xF0\x9D\x95\xA8", 5, 4}, {"COPY", "\xC2\xA9", 4, 2}, {"gne;", "\xE2\xAA\x88", 4, 3},
+    {"laquo;", "\xC2\xAB", 6, 2}, {"orslope;", "\xE2\xA9\x97", 8, 3}, {"nrtri;", "\xE2\x8B\xAB", 6, 3},
+    {"DownTeeArrow;", "\xE2\x86\xA7", 13, 3}, {"sce;", "\xE2\xAA\xB0", 4, 3}, {"hslash;", "\xE2\x84\x8F", 7, 3},
+    {"NotTildeFullEqual;", "\xE2\x89\x87", 18, 3}, {"succneqq;", "\xE2\xAA\xB6", 9, 3}, {"thorn", "\xC3\xBE", 5, 2},
+    {"iuml", "\xC3\xAF", 4, 2}, {"breve;", "\xCB\x98", 6, 2}, {"ohbar;", "\xE2\xA6\xB5", 6, 3},
+    {"barwed;", "\xE2\x8C\x85", 7, 3}, {"DoubleUpArrow;", "\xE2\x87\x91", 14, 3}, {"solb;", "\xE2\xA7\x84", 5, 3},
+    {"sqcaps;", "\xE2\x8A\x93\xEF\xB8\x80", 7, 6}, {"ssetmn;", "\xE2\x88\x96", 7, 3}, {"aacute", "\xC3\xA1", 6, 2},
+    {"gtlPar;", "\xE2\xA6\x95", 7, 3}, {"PrecedesTilde;", "\xE2\x89\xBE", 14, 3}, {"gvnE;", "\xE2\x89\xA9\xEF\xB8\x80", 5, 6},
+    {"mumap;", "\xE2\x8A\xB8", 6, 3}, {"cent;", "\xC2\xA2", 5, 2}, {"backprime;", "\xE2\x80\xB5", 10, 3},
+    {"angmsdae;", "\xE2\xA6\xAC", 9, 3}, {"straightepsilon;", "\xCF\xB5", 16, 2}, {"epsilon;", "\xCE\xB5", 8, 2},
+    {"nang;", "\xE2\x88\xA0\xE2\x83\x92", 5, 6}, {"Kcy;", "\xD0\x9A", 4, 2}, {"circledR;", "\xC2\xAE", 9, 2},
+    {"nvinfin;", "\xE2\xA7\x9E", 8, 3}, {"diamond;", "\xE2\x8B\x84", 8, 3}, {"SmallCircle;", "\xE2\x88\x98", 12, 3},
+    {"triangleleft;", "\xE2\x97\x83", 13, 3}, {"dstrok;", "\xC4\x91", 7, 2}, {"frac13;", "\xE2\x85\x93", 7, 3},
+    {"notindot;", "\xE2\x8B\xB5\xCC\xB8", 9, 5}, {"curren", "\xC2\xA4", 6, 2}, {"dHar;", "\xE2\xA5\xA5", 5, 3},
+    {"xvee;", "\xE2\x8B\x81", 5, 3}, {"ngsim;", "\xE2\x89\xB5", 6, 3}, {"Eopf;", "\xF0\x9D\x94\xBC", 5, 4},
+    {"top;", "\xE2\x8A\xA4", 4, 3}, {"rcub;", "\x7D", 5, 1}, {"origof;", "\xE2\x8A\xB6", 7, 3},
+    {"ndash;", "\xE2\x80\x93", 6, 3}, {"nexists;", "\xE2\x88\x84", 8, 3}, {"lsaquo;", "\xE2\x80\xB9", 7, 3},
+    {"gla;", "\xE2\xAA\xA5", 4, 3}, {"supdsub;", "\xE2\xAB\x98", 8, 3}, {"OverBar;", "\xE2\x80\xBE", 8, 3},
+    {"iiiint;", "\xE2\xA8\x8C", 7, 3}, {"tdot;", "\xE2\x83\x9B", 5, 3}, {"varsubsetneqq;", "\xE2\xAB\x8B\xEF\xB8\x80", 14, 6},
+    {"NegativeMediumSpace;", "\xE2\x80\x8B", 20, 3}, {"rbarr;", "\xE2\xA4\x8D", 6, 3}, {"trade;", "\xE2\x84\xA2", 6, 3},
+    {"Lmidot;", "\xC4\xBF", 7, 2}, {"Upsilon;", "\xCE\xA5", 8, 2}, {"Nacute;", "\xC5\x83", 7, 2},
+    {"bigcirc;", "\xE2\x97\xAF", 8, 3}, {"mnplus;", "\xE2\x88\x93", 7, 3}, {"fcy;", "\xD1\x84", 4, 2},
+    {"downdownarrows;", "\xE2\x87\x8A", 15, 3}, {"bigvee;", "\xE2\x8B\x81", 7, 3}, {"plustwo;", "\xE2\xA8\xA7", 8, 3},
+    {"NotSquareSuperset;", "\xE2\x8A\x90\xCC\xB8", 18, 5}, {"DownRightTeeVector;", "\xE2\xA5\x9F", 19, 3}, {"larrlp;", "\xE2\x86\xAB", 7, 3},
+    {"star;", "\xE2\x98\x86", 5, 3}, {"subset;", "\xE2\x8A\x82", 7, 3}, {"lnE;", "\xE2\x89\xA8", 4, 3},
+    {"vsubne;", "\xE2\x8A\x8A\xEF\xB8\x80", 7, 6}, {"xmap;", "\xE2\x9F\xBC", 5, 3}, {"LongLeftRightArrow;", "\xE2\x9F\xB7", 19, 3},
+    {"drcorn;", "\xE2\x8C\x9F", 7, 3}, {"fflig;", "\xEF\xAC\x80", 6, 3}, {"Acy;", "\xD0\x90", 4, 2},
+    {"ljcy;", "\xD1\x99", 5, 2}, {"ulcorner;", "\xE2\x8C\x9C", 9, 3}, {"quaternions;", "\xE2\x84\x8D", 12, 3},
+    {"cirscir;", "\xE2\xA7\x82", 8, 3}, {"demptyv;", "\xE2\xA6\xB1", 8, 3}, {"ge;", "\xE2\x89\xA5", 3, 3},
+    {"sect", "\xC2\xA7", 4, 2}, {"cuesc;", "\xE2\x8B\x9F", 6, 3}, {"sigma;", "\xCF\x83", 6, 2},
+    {"QUOT", "\x22", 4, 1}, {"frac56;", "\xE2\x85\x9A", 7, 3}, {"lesdot;", "\xE2\xA9\xBF", 7, 3},
+    {"boxVH;", "\xE2\x95\xAC", 6, 3}, {"brvbar;", "\xC2\xA6", 7, 2}, {"bigotimes;", "\xE2\xA8\x82", 10, 3},
+    {"UnderBracket;", "\xE2\x8E\xB5", 13, 3}, {"Dscr;", "\xF0\x9D\x92\x9F", 5, 4}, {"orv;", "\xE2\xA9\x9B", 4, 3},
+    {"Dcy;", "\xD0\x94", 4, 2}, {"lopar;", "\xE2\xA6\x85", 6, 3}, {"Ouml;", "\xC3\x96", 5, 2},
+    {"Gfr;", "\xF0\x9D\x94\x8A", 4, 4}, {"nlArr;", "\xE2\x87\x8D", 6, 3}, {"zopf;", "\xF0\x9D\x95\xAB", 5, 4},
+    {"veebar;", "\xE2\x8A\xBB", 7, 3}, {"SucceedsEqual;", "\xE2\xAA\xB0", 14, 3}, {"lessapprox;", "\xE2\xAA\x85", 11, 3},
+    {"subsetneqq;", "\xE2\xAB\x8B", 11, 3}, {"iiint;", "\xE2\x88\xAD", 6, 3}, {"Tcy;", "\xD0\xA2", 4, 2},
+    {"DoubleVerticalBar;", "\xE2\x88\xA5", 18, 3}, {"imagline;", "\xE2\x84\x90", 9, 3}, {"amacr;", "\xC4\x81", 6, 2},
+    {"nlarr;", "\xE2\x86\x9A", 6, 3}, {"dharr;", "\xE2\x87\x82", 6, 3}, {"puncsp;", "\xE2\x80\x88", 7, 3},
+    {"cwint;", "\xE2\x88\xB1", 6, 3}, {"bigcap;", "\xE2\x8B\x82", 7, 3}, {"block;", "\xE2\x96\x88", 6, 3},
+    {"boxul;", "\xE2\x94\x98", 6, 3}, {"dcy;", "\xD0\xB4", 4, 2}, {"inodot;", "\xC4\xB1", 7, 2},
+    {"para", "\xC2\xB6", 4, 2}, {"egrave;", "\xC3\xA8", 7, 2}, {"lesges;", "\xE2\xAA\x93", 7, 3},
+    {"vBar;", "\xE2\xAB\xA8", 5, 3}, {"imof;", "\xE2\x8A\xB7", 5, 3}, {"lcaron;", "\xC4\xBE", 7, 2},
+    {"LeftDownTeeVector;", "\xE2\xA5\xA1", 18, 3}, {"vcy;", "\xD0\xB2", 4, 2}, {"xwedge;", "\xE2\x8B\x80", 7, 3},
+    {"fltns;", "\xE2\x96\xB1", 6, 3}, {"frac18;", "\xE2\x85\x9B", 7, 3}, {"comp;", "\xE2\x88\x81", 5, 3},
+    {"iota;", "\xCE\xB9", 5, 2}, {"Agrave", "\xC3\x80", 6, 2}, {"doteqdot;", "\xE2\x89\x91", 9, 3},
+    {"uHar;", "\xE2\xA5\xA3", 5, 3}, {"map;", "\xE2\x86\xA6", 4, 3}, {"xi;", "\xCE\xBE", 3, 2},
+    {"divonx;", "\xE2\x8B\x87", 7, 3}, {"lcedil;", "\xC4\xBC", 7, 2}, {"backsimeq;", "\xE2\x8B\x8D", 10, 3},
+    {"yucy;", "\xD1\x8E", 5, 2}, {"xrarr;", "\xE2\x9F\xB6", 6, 3}, {"dtrif;", "\xE2\x96\xBE", 6, 3},
+    {"vartriangleright;", "\xE2\x8A\xB3", 17, 3}, {"lsquor;", "\xE2\x80\x9A", 7, 3}, {"nis;", "\xE2\x8B\xBC", 4, 3},
+    {"ufr;", "\xF0\x9D\x94\xB2", 4, 4}, {"lEg;", "\xE2\xAA\x8B", 4, 3}, {"Barwed;", "\xE2\x8C\x86", 7, 3},
+    {"lobrk;", "\xE2\x9F\xA6", 6, 3}, {"LongRightArrow;", "\xE2\x9F\xB6", 15, 3}, {"wedge;", "\xE2\x88\xA7", 6, 3},
+    {"Cayleys;", "\xE2\x84\xAD", 8, 3}, {"NegativeVeryThinSpace;", "\xE2\x80\x8B", 22, 3}, {"Fscr;", "\xE2\x84\xB1", 5, 3},
+    {"erarr;", "\xE2\xA5\xB1", 6, 3}, {"llhard;", "\xE2\xA5\xAB", 7, 3}, {"DiacriticalDot;", "\xCB\x99", 15, 2},
+    {"UnionPlus;", "\xE2\x8A\x8E", 10, 3}, {"egs;", "\xE2\xAA\x96", 4, 3}, {"oplus;", "\xE2\x8A\x95", 6, 3},
+    {"Fouriertrf;", "\xE2\x84\xB1", 11, 3}, {"Cup;", "\xE2\x8B\x93", 4, 3}, {"Tab;", "\x09", 4, 1},
+    {"csub;", "\xE2\xAB\x8F", 5, 3}, {"DownBreve;", "\xCC\x91", 10, 2}, {"le;", "\xE2\x89\xA4", 3, 3},
+    {"napprox;", "\xE2\x89\x89", 8, 3}, {"gtrless;", "\xE2\x89\xB7", 8, 3}, {"szlig;", "\xC3\x9F", 6, 2},
+    {"lt", "\x3C", 2, 1}, {"looparrowright;", "\xE2\x86\xAC", 15, 3}, {"OverBracket;", "\xE2\x8E\xB4", 12, 3},
+    {"nshortmid;", "\xE2\x88\xA4", 10, 3}, {"amp", "\x26", 3, 1}, {"andand;", "\xE2\xA9\x95", 7, 3},
+    {"gtrsim;", "\xE2\x89\xB3", 7, 3}, {"Popf;", "\xE2\x84\x99", 5, 3}, {"xlarr;", "\xE2\x9F\xB5", 6, 3},
+    {"rightharpoonup;", "\xE2\x87\x80", 15, 3}, {"cedil;", "\xC2\xB8", 6, 2}, {"natural;", "\xE2\x99\xAE", 8, 3},
+    {"plusmn;", "\xC2\xB1", 7, 2}, {"gsime;", "\xE2\xAA\x8E", 6, 3}, {"downharpoonleft;", "\xE2\x87\x83", 16, 3},
+    {"Re;", "\xE2\x84\x9C", 3, 3}, {"geqslant;", "\xE2\xA9\xBE", 9, 3}, {"cupcup;", "\xE2\xA9\x8A", 7, 3},
+    {"nscr;", "\xF0\x9D\x93\x83", 5, 4}, {"nedot;", "\xE2\x89\x90\xCC\xB8", 6, 5}, {"bnequiv;", "\xE2\x89\xA1\xE2\x83\xA5", 8, 6},
+    {"laquo", "\xC2\xAB", 5, 2}, {"trianglerighteq;", "\xE2\x8A\xB5", 16, 3}, {"parallel;", "\xE2\x88\xA5", 9, 3},
+    {"qint;", "\xE2\xA8\x8C", 5, 3}, {"supne;", "\xE2\x8A\x8B", 6, 3}, {"hfr;", "\xF0\x9D\x94\xA5", 4, 4},
+    {"varsigma;", "\xCF\x82", 9, 2}, {"RightTee;", "\xE2\x8A\xA2", 9, 3}, {"kcedil;", "\xC4\xB7", 7, 2},
+    {"rarrfs;", "\xE2\xA4\x9E", 7, 3}, {"pitchfork;", "\xE2\x8B\x94", 10, 3}, {"lagran;", "\xE2\x84\x92", 7, 3},
+    {"UpArrow;", "\xE2\x86\x91", 8, 3}, {"harrcir;", "\xE2\xA5\x88", 8, 3}, {"Mcy;", "\xD0\x9C", 4, 2},
+    {"qfr;", "\xF0\x9D\x94\xAE", 4, 4}, {"frac14;", "\xC2\xBC", 7, 2}, {"sstarf;", "\xE2\x8B\x86", 7, 3},
+    {"Psi;", "\xCE\xA8", 4, 2}, {"dscr;", "\xF0\x9D\x92\xB9", 5, 4}, {"lates;", "\xE2\xAA\xAD\xEF\xB8\x80", 6, 6},
+    {"NotSuperset;", "\xE2\x8A\x83\xE2\x83\x92", 12, 6}, {"GT;", "\x3E", 3, 1}, {"Epsilon;", "\xCE\x95", 8, 2},
+    {"zeta;", "\xCE\xB6", 5, 2}, {"cupdot;", "\xE2\x8A\x8D", 7, 3}, {"RoundImplies;", "\xE2\xA5\xB0", 13, 3},
+    {"CloseCurlyQuote;", "\xE2\x80\x99", 16, 3}, {"DownRightVector;", "\xE2\x87\x81", 16, 3}, {"precsim;", "\xE2\x89\xBE", 8, 3},
+    {"ShortLeftArrow;", "\xE2\x86\x90", 15, 3}, {"DoubleDownArrow;", "\xE2\x87\x93", 16, 3}, {"succapprox;", "\xE2\xAA\xB8", 11, 3},
+    {"abreve;", "\xC4\x83", 7, 2}, {"lrcorner;", "\xE2\x8C\x9F", 9, 3}, {"gesl;", "\xE2\x8B\x9B\xEF\xB8\x80", 5, 6},
+    {"ocy;", "\xD0\xBE", 4, 2}, {"nexist;", "\xE2\x88\x84", 7, 3}, {"popf;", "\xF0\x9D\x95\xA1", 5, 4},
+    {"Igrave", "\xC3\x8C", 6, 2}, {"NotGreaterFullEqual;", "\xE2\x89\xA7\xCC\xB8", 20, 5}, {"frac16;", "\xE2\x85\x99", 7, 3},
+    {"reals;", "\xE2\x84\x9D", 6, 3}, {"ecolon;", "\xE2\x89\x95", 7, 3}, {"hscr;", "\xF0\x9D\x92\xBD", 5, 4},
+    {"shy", "\xC2\xAD", 3, 2}, {"langd;", "\xE2\xA6\x91", 6, 3}, {"Otilde;", "\xC3\x95", 7, 2},
+    {"bfr;", "\xF0\x9D\x94\x9F", 4, 4}, {"sup1;", "\xC2\xB9", 5, 2}, {"rtrie;", "\xE2\x8A\xB5", 6, 3},
+    {"equivDD;", "\xE2\xA9\xB8", 8, 3}, {"forkv;", "\xE2\xAB\x99", 6, 3}, {"frac35;", "\xE2\x85\x97", 7, 3},
+    {"gopf;", "\xF0\x9D\x95\x98", 5, 4}, {"uogon;", "\xC5\xB3", 6, 2}, {"rAarr;", "\xE2\x87\x9B", 6, 3},
+    {"leftarrow;", "\xE2\x86\x90", 10, 3}, {"reg;", "\xC2\xAE", 4, 2}, {"sdotb;", "\xE2\x8A\xA1", 6, 3},
+    {"dwangle;", "\xE2\xA6\xA6", 8, 3}, {"lsimg;", "\xE2\xAA\x8F", 6, 3}, {"tcaron;", "\xC5\xA5", 7, 2},
+    {"Cdot;", "\xC4\x8A", 5, 2}, {"edot;", "\xC4\x97", 5, 2}, {"NotVerticalBar;", "\xE2\x88\xA4", 15, 3},
+    {"Jsercy;", "\xD0\x88", 7, 2}, {"nearhk;", "\xE2\xA4\xA4", 7, 3}, {"sigmav;", "\xCF\x82", 7, 2},
+    {"Afr;", "\xF0\x9D\x94\x84", 4, 4}, {"Atilde;", "\xC3\x83", 7, 2}, {"robrk;", "\xE2\x9F\xA7", 6, 3},
+    {"semi;", "\x3B", 5, 1}, {"copf;", "\xF0\x9D\x95\x94", 5, 4}, {"planckh;", "\xE2\x84\x8E", 8, 3},
+    {"shortmid;", "\xE2\x88\xA3", 9, 3}, {"diam;", "\xE2\x8B\x84", 5, 3}, {"Kopf;", "\xF0\x9D\x95\x82", 5, 4},
+    {"cross;", "\xE2\x9C\x97", 6, 3}, {"zfr;", "\xF0\x9D\x94\xB7", 4, 4}, {"lozf;", "\xE2\xA7\xAB", 5, 3},
+    {"Iuml", "\xC3\x8F", 4, 2}, {"circledS;", "\xE2\x93\x88", 9, 3}, {"LeftTriangleEqual;", "\xE2\x8A\xB4", 18, 3},
+    {"circledast;", "\xE2\x8A\x9B", 11, 3}, {"Ugrave", "\xC3\x99", 6, 2}, {"Euml", "\xC3\x8B", 4, 2},
+    {"Euml;", "\xC3\x8B", 5, 2}, {"xcirc;", "\xE2\x97\xAF", 6, 3}, {"numero;", "\xE2\x84\x96", 7, 3},
+    {"lowast;", "\xE2\x88\x97", 7, 3}, {"nleq;", "\xE2\x89\xB0", 5, 3}, {"Jopf;", "\xF0\x9D\x95\x81", 5, 4},
+    {"aacute;", "\xC3\xA1", 7, 2}, {"topbot;", "\xE2\x8C\xB6", 7, 3}, {"downharpoonright;", "\xE2\x87\x82", 17, 3},
+    {"SquareSuperset;", "\xE2\x8A\x90", 15, 3}, {"Larr;", "\xE2\x86\x9E", 5, 3}, {"gtreqqless;", "\xE2\xAA\x8C", 11, 3},
+    {"npr;", "\xE2\x8A\x80", 4, 3}, {"Oopf;", "\xF0\x9D\x95\x86", 5, 4}, {"subedot;", "\xE2\xAB\x83", 8, 3},
+    {"ngE;", "\xE2\x89\xA7\xCC\xB8", 4, 5}, {"bsim;", "\xE2\x88\xBD", 5, 3}, {"uArr;", "\xE2\x87\x91", 5, 3},
+    {"NotRightTriangleEqual;", "\xE2\x8B\xAD", 22, 3}, {"veeeq;", "\xE2\x89\x9A", 6, 3}, {"lesdoto;", "\xE2\xAA\x81", 8, 3},
+    {"equiv;", "\xE2\x89\xA1", 6, 3}, {"zacute;", "\xC5\xBA", 7, 2}, {"napos;", "\xC5\x89", 6, 2},
+    {"bsemi;", "\xE2\x81\x8F", 6, 3}, {"nvlArr;", "\xE2\xA4\x82", 7, 3}, {"sup3;", "\xC2\xB3", 5, 2},
+    {"aelig", "\xC3\xA6", 5, 2}, {"sqsupseteq;", "\xE2\x8A\x92", 11, 3}, {"CHcy;", "\xD0\xA7", 5, 2},
+    {"jfr;", "\xF0\x9D\x94\xA7", 4, 4}, {"sect;", "\xC2\xA7", 5, 2}, {"Jfr;", "\xF0\x9D\x94\x8D", 4, 4},
+    {"ring;", "\xCB\x9A", 5, 2}, {"DoubleDot;", "\xC2\xA8", 10, 2}, {"srarr;", "\xE2\x86\x92", 6, 3},
+    {"checkmark;", "\xE2\x9C\x93", 10, 3}, {"boxplus;", "\xE2\x8A\x9E", 8, 3}, {"preccurlyeq;", "\xE2\x89\xBC", 12, 3},
+    {"sacute;", "\xC5\x9B", 7, 2}, {"Ograve;", "\xC3\x92", 7, 2}, {"Rfr;", "\xE2\x84\x9C", 4, 3},
+    {"RightFloor;", "\xE2\x8C\x8B", 11, 3}, {"oS;", "\xE2\x93\x88", 3, 3}, {"Odblac;", "\xC5\x90", 7, 2},
+    {"awconint;", "\xE2\x88\xB3", 9, 3}, {"llcorner;", "\xE2\x8C\x9E", 9, 3}, {"HilbertSpace;", "\xE2\x84\x8B", 13, 3},
+    {"cemptyv;", "\xE2\xA6\xB2", 8, 3}, {"cire;", "\xE2\x89\x97", 5, 3}, {"rarrsim;", "\xE2\xA5\xB4", 8, 3},
+    {"boxvL;", "\xE2\x95\xA1", 6, 3}, {"vsupnE;", "\xE2\xAB\x8C\xEF\xB8\x80", 7, 6}, {"not;", "\xC2\xAC", 4, 2},
+    {"sup1", "\xC2\xB9", 4, 2}, {"rBarr;", "\xE2\xA4\x8F", 6, 3}, {"nspar;", "\xE2\x88\xA6", 6, 3},
+    {"khcy;", "\xD1\x85", 5, 2}, {"Del;", "\xE2\x88\x87", 4, 3}, {"LessSlantEqual;", "\xE2\xA9\xBD", 15, 3},
+    {"hybull;", "\xE2\x81\x83", 7, 3}, {"cuepr;", "\xE2\x8B\x9E", 6, 3}, {"nLt;", "\xE2\x89\xAA\xE2\x83\x92", 4, 6},
+    {"Qscr;", "\xF0\x9D\x92\xAC", 5, 4}, {"lat;", "\xE2\xAA\xAB", 4, 3}, {"npreceq;", "\xE2\xAA\xAF\xCC\xB8", 8, 5},
+    {"LeftArrowRightArrow;", "\xE2\x87\x86", 20, 3}, {"nrarr;", "\xE2\x86\x9B", 6, 3}, {"rightarrowtail;", "\xE2\x86\xA3", 15, 3},
+    {"ograve;", "\xC3\xB2", 7, 2}, {"ange;", "\xE2\xA6\xA4", 5, 3}, {"hercon;", "\xE2\x8A\xB9", 7, 3},
+    {"rightarrow;", "\xE2\x86\x92", 11, 3}, {"yicy;", "\xD1\x97", 5, 2}, {"tfr;", "\xF0\x9D\x94\xB1", 4, 4},
+    {"boxhd;", "\xE2\x94\xAC", 6, 3}, {"nvdash;", "\xE2\x8A\xAC", 7, 3}, {"cularr;", "\xE2\x86\xB6", 7, 3},
+    {"xdtri;", "\xE2\x96\xBD", 6, 3}, {"supE;", "\xE2\xAB\x86", 5, 3}, {"ShortUpArrow;", "\xE2\x86\x91", 13, 3},
+    {"slarr;", "\xE2\x86\x90", 6, 3}, {"CounterClockwiseContourIntegral;", "\xE2\x88\xB3", 32, 3}, {"CirclePlus;", "\xE2\x8A\x95", 11, 3},
+    {"sum;", "\xE2\x88\x91", 4, 3}, {"DiacriticalDoubleAcute;", "\xCB\x9D", 23, 2}, {"succnsim;", "\xE2\x8B\xA9", 9, 3},
+    {"niv;", "\xE2\x88\x8B", 4, 3}, {"npre;", "\xE2\xAA\xAF\xCC\xB8", 5, 5}, {"ltcir;", "\xE2\xA9\xB9", 6, 3},
+    {"Vscr;", "\xF0\x9D\x92\xB1", 5, 4}, {"egsdot;", "\xE2\xAA\x98", 7, 3}, {"SuchThat;", "\xE2\x88\x8B", 9, 3},
+    {"bot;", "\xE2\x8A\xA5", 4, 3}, {"VerticalTilde;", "\xE2\x89\x80", 14, 3}, {"nlsim;", "\xE2\x89\xB4", 6, 3},
+    {"middot;", "\xC2\xB7", 7, 2}, {"barwedge;", "\xE2\x8C\x85", 9, 3}, {"uacute", "\xC3\xBA", 6, 2},
+    {"exist;", "\xE2\x88\x83", 6, 3}, {"gacute;", "\xC7\xB5", 7, 2}, {"frac23;", "\xE2\x85\x94", 7, 3},
+    {"digamma;", "\xCF\x9D", 8, 2}, {"LeftTriangleBar;", "\xE2\xA7\x8F", 16, 3}, {"gjcy;", "\xD1\x93", 5, 2},
+    {"Uopf;", "\xF0\x9D\x95\x8C", 5, 4}, {"csup;", "\xE2\xAB\x90", 5, 3}, {"swarr;", "\xE2\x86\x99", 6, 3},
+    {"vprop;", "\xE2\x88\x9D", 6, 3}, {"realpart;", "\xE2\x84\x9C", 9, 3}, {"lltri;", "\xE2\x97\xBA", 6, 3},
+    {"Coproduct;", "\xE2\x88\x90", 10, 3}, {"RightUpDownVector;", "\xE2\xA5\x8F", 18, 3}, {"npolint;", "\xE2\xA8\x94", 8, 3},
+    {"conint;", "\xE2\x88\xAE", 7, 3}, {"larrfs;", "\xE2\xA4\x9D", 7, 3}, {"rcedil;", "\xC5\x97", 7, 2},
+    {"plusmn", "\xC2\xB1", 6, 2}, {"ccupssm;", "\xE2\xA9\x90", 8, 3}, {"leftharpoondown;", "\xE2\x86\xBD", 16, 3},
+    {"Succeeds;", "\xE2\x89\xBB", 9, 3}, {"mcy;", "\xD0\xBC", 4, 2}, {"ddagger;", "\xE2\x80\xA1", 8, 3},
+    {"Superset;", "\xE2\x8A\x83", 9, 3}, {"Eacute;", "\xC3\x89", 7, 2}, {"ccirc;", "\xC4\x89", 6, 2},
+    {"nges;", "\xE2\xA9\xBE\xCC\xB8", 5, 5}, {"OverParenthesis;", "\xE2\x8F\x9C", 16, 3}, {"urcorn;", "\xE2\x8C\x9D", 7, 3},
+    {"lneq;", "\xE2\xAA\x87", 5, 3}, {"icy;", "\xD0\xB8", 4, 2}, {"NotSucceedsTilde;", "\xE2\x89\xBF\xCC\xB8", 17, 5},
+    {"hamilt;", "\xE2\x84\x8B", 7, 3}, {"Gt;", "\xE2\x89\xAB", 3, 3}, {"utrif;", "\xE2\x96\xB4", 6, 3},
+    {"tritime;", "\xE2\xA8\xBB", 8, 3}, {"vscr;", "\xF0\x9D\x93\x8B", 5, 4}, {"Uscr;", "\xF0\x9D\x92\xB0", 5, 4},
+    {"rfr;", "\xF0\x9D\x94\xAF", 4, 4}, {"auml", "\xC3\xA4", 4, 2}, {"precnsim;", "\xE2\x8B\xA8", 9, 3},
+    {"Jscr;", "\xF0\x9D\x92\xA5", 5, 4}, {"smt;", "\xE2\xAA\xAA", 4, 3}, {"ReverseEquilibrium;", "\xE2\x87\x8B", 19, 3},
+    {"ssmile;", "\xE2\x8C\xA3", 7, 3}, {"yuml;", "\xC3\xBF", 5, 2}, {"Gscr;", "\xF0\x9D\x92\xA2", 5, 4},
+    {"cuwed;", "\xE2\x8B\x8F", 6, 3}, {"gbreve;", "\xC4\x9F", 7, 2}, {"capand;", "\xE2\xA9\x84", 7, 3},
+    {"RightUpVectorBar;", "\xE2\xA5\x94", 17, 3}, {"lbrkslu;", "\xE2\xA6\x8D", 8, 3}, {"lfr;", "\xF0\x9D\x94\xA9", 4, 4},
+    {"solbar;", "\xE2\x8C\xBF", 7, 3}, {"searrow;", "\xE2\x86\x98", 8, 3}, {"RightVector;", "\xE2\x87\x80", 12, 3},
+    {"ast;", "\x2A", 4, 1}, {"lt;", "\x3C", 3, 1}, {"sime;", "\xE2\x89\x83", 5, 3},
+    {"cfr;", "\xF0\x9D\x94\xA0", 4, 4}, {"prime;", "\xE2\x80\xB2", 6, 3}, {"Wcirc;", "\xC5\xB4", 6, 2},
+    {"ltcc;", "\xE2\xAA\xA6", 5, 3}, {"cong;", "\xE2\x89\x85", 5, 3}, {"nrightarrow;", "\xE2\x86\x9B", 12, 3},
+    {"Ccedil;", "\xC3\x87", 7, 2}, {"kgreen;", "\xC4\xB8", 7, 2}, {"triangle;", "\xE2\x96\xB5", 9, 3},
+    {"simeq;", "\xE2\x89\x83", 6, 3}, {"DZcy;", "\xD0\x8F", 5, 2}, {"uwangle;", "\xE2\xA6\xA7", 8, 3},
+    {"scirc;", "\xC5\x9D", 6, 2}, {"hoarr;", "\xE2\x87\xBF", 6, 3}, {"NewLine;", "\x0A", 8, 1},
+    {"NotHumpDownHump;", "\xE2\x89\x8E\xCC\xB8", 16, 5}, {"Yfr;", "\xF0\x9D\x94\x9C", 4, 4}, {"Ucirc;", "\xC3\x9B", 6, 2},
+    {"shcy;", "\xD1\x88", 5, 2}, {"boxdr;", "\xE2\x94\x8C", 6, 3}, {"iogon;", "\xC4\xAF", 6, 2},
+    {"Im;", "\xE2\x84\x91", 3, 3}, {"diamondsuit;", "\xE2\x99\xA6", 12, 3}, {"ascr;", "\xF0\x9D\x92\xB6", 5, 4},
+    {"bullet;", "\xE2\x80\xA2", 7, 3}, {"uplus;", "\xE2\x8A\x8E", 6, 3}, {"strns;", "\xC2\xAF", 6, 2},
+    {"xcup;", "\xE2\x8B\x83", 5, 3}, {"Egrave;", "\xC3\x88", 7, 2}, {"supe;", "\xE2\x8A\x87", 5, 3},
+    {"bigodot;", "\xE2\xA8\x80", 8, 3}, {"Rang;", "\xE2\x9F\xAB", 5, 3}, {"NotLessSlantEqual;", "\xE2\xA9\xBD\xCC\xB8", 18, 5},
+    {"dfisht;", "\xE2\xA5\xBF", 7, 3}, {"nfr;", "\xF0\x9D\x94\xAB", 4, 4}, {"boxvr;", "\xE2\x94\x9C", 6, 3},
+    {"Nopf;", "\xE2\x84\x95", 5, 3}, {"LeftCeiling;", "\xE2\x8C\x88", 12, 3}, {"die;", "\xC2\xA8", 4, 2},
+    {"frown;", "\xE2\x8C\xA2", 6, 3}, {"boxdl;", "\xE2\x94\x90", 6, 3}, {"rcy;", "\xD1\x80", 4, 2},
+    {"gt;", "\x3E", 3, 1}, {"LowerRightArrow;", "\xE2\x86\x98", 16, 3}, {"Yacute", "\xC3\x9D", 6, 2},
+    {"Ubrcy;", "\xD0\x8E", 6, 2}, {"nvlt;", "\x3C\xE2\x83\x92", 5, 4}, {"blacktriangleright;", "\xE2\x96\xB8", 19, 3},
+    {"supsub;", "\xE2\xAB\x94", 7, 3}, {"ugrave;", "\xC3\xB9", 7, 2}, {"acy;", "\xD0\xB0", 4, 2},
+    {"subplus;", "\xE2\xAA\xBF", 8, 3}, {"HumpEqual;", "\xE2\x89\x8F", 10, 3}, {"THORN;", "\xC3\x9E", 6, 2},
+    {"prop;", "\xE2\x88\x9D", 5, 3}, {"DownLeftVectorBar;", "\xE2\xA5\x96", 18, 3}, {"Aacute;", "\xC3\x81", 7, 2},
+    {"dashv;", "\xE2\x8A\xA3", 6, 3}, {"ShortDownArrow;", "\xE2\x86\x93", 15, 3}, {"Esim;", "\xE2\xA9\xB3", 5, 3},
+    {"ap;", "\xE2\x89\x88", 3, 3}, {"deg", "\xC2\xB0", 3, 2}, {"bscr;", "\xF0\x9D\x92\xB7", 5, 4},
+    {"nshortparallel;", "\xE2\x88\xA6", 15, 3}, {"isinv;", "\xE2\x88\x88", 6, 3}, {"sbquo;", "\xE2\x80\x9A", 6, 3},
+    {"isin;", "\xE2\x88\x88", 5, 3}, {"rbrkslu;", "\xE2\xA6\x90", 8, 3}, {"succcurlyeq;", "\xE2\x89\xBD", 12, 3},
+    {"NotTilde;", "\xE2\x89\x81", 9, 3}, {"nles;", "\xE2\xA9\xBD\xCC\xB8", 5, 5}, {"ne;", "\xE2\x89\xA0", 3, 3},
+    {"UpEquilibrium;", "\xE2\xA5\xAE", 14, 3}, {"nrArr;", "\xE2\x87\x8F", 6, 3}, {"dagger;", "\xE2\x80\xA0", 7, 3},
+    {"sqsubseteq;", "\xE2\x8A\x91", 11, 3}, {"bne;", "\x3D\xE2\x83\xA5", 4, 4}, {"beth;", "\xE2\x84\xB6", 5, 3},
+    {"emsp13;", "\xE2\x80\x84", 7, 3}, {"Sacute;", "\xC5\x9A", 7, 2}, {"sqcap;", "\xE2\x8A\x93", 6, 3},
+    {"boxV;", "\xE2\x95\x91", 5, 3}, {"GreaterGreater;", "\xE2\xAA\xA2", 15, 3}, {"vartheta;", "\xCF\x91", 9, 2},
+    {"Leftrightarrow;", "\xE2\x87\x94", 15, 3}, {"rarrhk;", "\xE2\x86\xAA", 7, 3}, {"rthree;", "\xE2\x8B\x8C", 7, 3},
+    {"mscr;", "\xF0\x9D\x93\x82", 5, 4}, {"scaron;", "\xC5\xA1", 7, 2}, {"VerticalSeparator;", "\xE2\x9D\x98", 18, 3},
+    {"rcaron;", "\xC5\x99", 7, 2}, {"NotRightTriangle;", "\xE2\x8B\xAB", 17, 3}, {"TripleDot;", "\xE2\x83\x9B", 10, 3},
+    {"quest;", "\x3F", 6, 1}, {"lbrace;", "\x7B", 7, 1}, {"ocirc;", "\xC3\xB4", 6, 2},
+    {"varr;", "\xE2\x86\x95", 5, 3}, {"rangle;", "\xE2\x9F\xA9", 7, 3}, {"nLtv;", "\xE2\x89\xAA\xCC\xB8", 5, 5},
+    {"Exists;", "\xE2\x88\x83", 7, 3}, {"thicksim;", "\xE2\x88\xBC", 9, 3}, {"varsupsetneq;", "\xE2\x8A\x8B\xEF\xB8\x80", 13, 6},
+    {"ReverseUpEquilibrium;", "\xE2\xA5\xAF", 21, 3}, {"Qopf;", "\xE2\x84\x9A", 5, 3}, {"bsolhsub;", "\xE2\x9F\x88", 9, 3},
+    {"notinvc;", "\xE2\x8B\xB6", 8, 3}, {"GreaterTilde;", "\xE2\x89\xB3", 13, 3}, {"Tcedil;", "\xC5\xA2", 7, 2},
+    {"sccue;", "\xE2\x89\xBD", 6, 3}, {"gg;", "\xE2\x89\xAB", 3, 3}, {"nsime;", "\xE2\x89\x84", 6, 3},
+    {"ldca;", "\xE2\xA4\xB6", 5, 3}, {"range;", "\xE2\xA6\xA5", 6, 3}, {"longleftarrow;", "\xE2\x9F\xB5", 14, 3},
+    {"rlhar;", "\xE2\x87\x8C", 6, 3}, {"Breve;", "\xCB\x98", 6, 2}, {"CircleDot;", "\xE2\x8A\x99", 10, 3},
+    {"EmptyVerySmallSquare;", "\xE2\x96\xAB", 21, 3}, {"swnwar;", "\xE2\xA4\xAA", 7, 3}, {"NotCongruent;", "\xE2\x89\xA2", 13, 3},
+    {"utilde;", "\xC5\xA9", 7, 2}, {"Mopf;", "\xF0\x9D\x95\x84", 5, 4}, {"ContourIntegral;", "\xE2\x88\xAE", 16, 3},
+    {"dblac;", "\xCB\x9D", 6, 2}, {"epsi;", "\xCE\xB5", 5, 2}, {"lAarr;", "\xE2\x87\x9A", 6, 3},
+    {"ouml", "\xC3\xB6", 4, 2}, {"eDDot;", "\xE2\xA9\xB7", 6, 3}, {"boxdR;", "\xE2\x95\x92", 6, 3},
+    {"angmsdad;", "\xE2\xA6\xAB", 9, 3}, {"ThinSpace;", "\xE2\x80\x89", 10, 3}, {"supmult;", "\xE2\xAB\x82", 8, 3},
+    {"gtrdot;", "\xE2\x8B\x97", 7, 3}, {"scsim;", "\xE2\x89\xBF", 6, 3}, {"rect;", "\xE2\x96\xAD", 5, 3},
+    {"varsubsetneq;", "\xE2\x8A\x8A\xEF\xB8\x80", 13, 6}, {"eacute;", "\xC3\xA9", 7, 2}, {"boxvh;", "\xE2\x94\xBC", 6, 3},
+    {"topf;", "\xF0\x9D\x95\xA5", 5, 4}, {"xnis;", "\xE2\x8B\xBB", 5, 3}, {"lharul;", "\xE2\xA5\xAA", 7, 3},
+    {"ncy;", "\xD0\xBD", 4, 2}, {"boxhu;", "\xE2\x94\xB4", 6, 3}, {"thetasym;", "\xCF\x91", 9, 2},
+    {"lstrok;", "\xC5\x82", 7, 2}, {"olcross;", "\xE2\xA6\xBB", 8, 3}, {"DoubleLeftRightArrow;", "\xE2\x87\x94", 21, 3},
+    {"nvle;", "\xE2\x89\xA4\xE2\x83\x92", 5, 6}, {"rbrack;", "\x5D", 7, 1}, {"el;", "\xE2\xAA\x99", 3, 3},
+    {"cdot;", "\xC4\x8B", 5, 2}, {"LeftUpVectorBar;", "\xE2\xA5\x98", 16, 3}, {"ntgl;", "\xE2\x89\xB9", 5, 3},
+    {"percnt;", "\x25", 7, 1}, {"aring;", "\xC3\xA5", 6, 2}, {"Lambda;", "\xCE\x9B", 7, 2},
+    {"upharpoonright;", "\xE2\x86\xBE", 15, 3}, {"CircleTimes;", "\xE2\x8A\x97", 12, 3}, {"lmidot;", "\xC5\x80", 7, 2},
+    {"pluse;", "\xE2\xA9\xB2", 6, 3}, {"NJcy;", "\xD0\x8A", 5, 2}, {"Iukcy;", "\xD0\x86", 6, 2},
+    {"nvap;", "\xE2\x89\x8D\xE2\x83\x92", 5, 6}, {"acirc;", "\xC3\xA2", 6, 2}, {"Eacute", "\xC3\x89", 6, 2},
+    {"ordf", "\xC2\xAA", 4, 2}, {"frac34;", "\xC2\xBE", 7, 2}, {"dlcorn;", "\xE2\x8C\x9E", 7, 3},
+    {"bigwedge;", "\xE2\x8B\x80", 9, 3}, {"Alpha;", "\xCE\x91", 6, 2}, {"boxvH;", "\xE2\x95\xAA", 6, 3},
+    {"Otimes;", "\xE2\xA8\xB7", 7, 3}, {"UpArrowBar;", "\xE2\xA4\x92", 11, 3}, {"dopf;", "\xF0\x9D\x95\x95", 5, 4},
+    {"ccedil;", "\xC3\xA7", 7, 2}, {"Topf;", "\xF0\x9D\x95\x8B", 5, 4}, {"Auml;", "\xC3\x84", 5, 2},
+    {"zigrarr;", "\xE2\x87\x9D", 8, 3}, {"wreath;", "\xE2\x89\x80", 7, 3}, {"larrbfs;", "\xE2\xA4\x9F", 8, 3},
+    {"andv;", "\xE2\xA9\x9A", 5, 3}, {"eplus;", "\xE2\xA9\xB1", 6, 3}, {"Vcy;", "\xD0\x92", 4, 2},
+    {"szlig", "\xC3\x9F", 5, 2}, {"EmptySmallSquare;", "\xE2\x97\xBB", 17, 3}, {"Proportion;", "\xE2\x88\xB7", 11, 3},
+    {"RBarr;", "\xE2\xA4\x90", 6, 3}, {"quatint;", "\xE2\xA8\x96", 8, 3}, {"Star;", "\xE2\x8B\x86", 5, 3},
+    {"zeetrf;", "\xE2\x84\xA8", 7, 3}, {"Rrightarrow;", "\xE2\x87\x9B", 12, 3}, {"Hacek;", "\xCB\x87", 6, 2},
+    {"yscr;", "\xF0\x9D\x93\x8E", 5, 4}, {"scnsim;", "\xE2\x8B\xA9", 7, 3}, {"iff;", "\xE2\x87\x94", 4, 3},
+    {"SupersetEqual;", "\xE2\x8A\x87", 14, 3}, {"scedil;", "\xC5\x9F", 7, 2}, {"jcirc;", "\xC4\xB5", 6, 2},
+    {"nsqsube;", "\xE2\x8B\xA2", 8, 3}, {"squf;", "\xE2\x96\xAA", 5, 3}, {"ac;", "\xE2\x88\xBE", 3, 3},
+    {"les;", "\xE2\xA9\xBD", 4, 3}, {"ETH;", "\xC3\x90", 4, 2}, {"nsupseteqq;", "\xE2\xAB\x86\xCC\xB8", 11, 5},
+    {"Equilibrium;", "\xE2\x87\x8C", 12, 3}, {"divide", "\xC3\xB7", 6, 2}, {"rhard;", "\xE2\x87\x81", 6, 3},
+    {"ApplyFunction;", "\xE2\x81\xA1", 14, 3}, {"bowtie;", "\xE2\x8B\x88", 7, 3}, {"Ffr;", "\xF0\x9D\x94\x89", 4, 4},
+    {"Fcy;", "\xD0\xA4", 4, 2}, {"sdote;", "\xE2\xA9\xA6", 6, 3}, {"frac25;", "\xE2\x85\x96", 7, 3},
+    {"dotminus;", "\xE2\x88\xB8", 9, 3}, {"NegativeThickSpace;", "\xE2\x80\x8B", 19, 3}, {"rceil;", "\xE2\x8C\x89", 6, 3},
+    {"imacr;", "\xC4\xAB", 6, 2}, {"tcy;", "\xD1\x82", 4, 2}, {"xopf;", "\xF0\x9D\x95\xA9", 5, 4},
+    {"odot;", "\xE2\x8A\x99", 5, 3}, {"not", "\xC2\xAC", 3, 2}, {"ngeqslant;", "\xE2\xA9\xBE\xCC\xB8", 10, 5},
+    {"gnsim;", "\xE2\x8B\xA7", 6, 3}, {"Tstrok;", "\xC5\xA6", 7, 2}, {"realine;", "\xE2\x84\x9B", 8, 3},
+    {"blacktriangledown;", "\xE2\x96\xBE", 18, 3}, {"Rcy;", "\xD0\xA0", 4, 2}, {"UnderParenthesis;", "\xE2\x8F\x9D", 17, 3},
+    {"pscr;", "\xF0\x9D\x93\x85", 5, 4}, {"iacute", "\xC3\xAD", 6, 2}, {"LongLeftArrow;", "\xE2\x9F\xB5", 14, 3},
+    {"minusb;", "\xE2\x8A\x9F", 7, 3}, {"Ucy;", "\xD0\xA3", 4, 2}, {"luruhar;", "\xE2\xA5\xA6", 8, 3},
+    {"lvnE;", "\xE2\x89\xA8\xEF\xB8\x80", 5, 6}, {"Nfr;", "\xF0\x9D\x94\x91", 4, 4}, {"raemptyv;", "\xE2\xA6\xB3", 9, 3},
+    {"amp;", "\x26", 4, 1}, {"lesg;", "\xE2\x8B\x9A\xEF\xB8\x80", 5, 6}, {"gsim;", "\xE2\x89\xB3", 5, 3},
+    {"Sopf;", "\xF0\x9D\x95\x8A", 5, 4}, {"dsol;", "\xE2\xA7\xB6", 5, 3}, {"fpartint;", "\xE2\xA8\x8D", 9, 3},
+    {"horbar;", "\xE2\x80\x95", 7, 3}, {"leq;", "\xE2\x89\xA4", 4, 3}, {"pfr;", "\xF0\x9D\x94\xAD", 4, 4},
+    {"mid;", "\xE2\x88\xA3", 4, 3}, {"Uuml;", "\xC3\x9C", 5, 2}, {"cacute;", "\xC4\x87", 7, 2},
+    {"nsubset;", "\xE2\x8A\x82\xE2\x83\x92", 8, 6}, {"Ocirc", "\xC3\x94", 5, 2}, {"lsqb;", "\x5B", 5, 1},
+    {"Updownarrow;", "\xE2\x87\x95", 12, 3}, {"smte;", "\xE2\xAA\xAC", 5, 3}, {"udhar;", "\xE2\xA5\xAE", 6, 3},
+    {"LeftDoubleBracket;", "\xE2\x9F\xA6", 18, 3}, {"Sub;", "\xE2\x8B\x90", 4, 3}, {"iquest", "\xC2\xBF", 6, 2},
+    {"Emacr;", "\xC4\x92", 6, 2}, {"CupCap;", "\xE2\x89\x8D", 7, 3}, {"Itilde;", "\xC4\xA8", 7, 2},
+    {"lhard;", "\xE2\x86\xBD", 6, 3}, {"Longleftarrow;", "\xE2\x9F\xB8", 14, 3}, {"ntilde", "\xC3\xB1", 6, 2},
+    {"drcrop;", "\xE2\x8C\x8C", 7, 3}, {"pound;", "\xC2\xA3", 6, 2}, {"raquo", "\xC2\xBB", 5, 2},
+    {"rsaquo;", "\xE2\x80\xBA", 7, 3}, {"lbrksld;", "\xE2\xA6\x8F", 8, 3}, {"UpDownArrow;", "\xE2\x86\x95", 12, 3},
+    {"Colone;", "\xE2\xA9\xB4", 7, 3}, {"curarr;", "\xE2\x86\xB7", 7, 3}, {"wcirc;", "\xC5\xB5", 6, 2},
+    {"mcomma;", "\xE2\xA8\xA9", 7, 3}, {"wedbar;", "\xE2\xA9\x9F", 7, 3}, {"nsccue;", "\xE2\x8B\xA1", 7, 3},
+    {"approx;", "\xE2\x89\x88", 7, 3}, {"gneqq;", "\xE2\x89\xA9", 6, 3}, {"Xopf;", "\xF0\x9D\x95\x8F", 5, 4},
+    {"longrightarrow;", "\xE2\x9F\xB6", 15, 3}, {"tridot;", "\xE2\x97\xAC", 7, 3}, {"bull;", "\xE2\x80\xA2", 5, 3},
+    {"Dagger;", "\xE2\x80\xA1", 7, 3}, {"rightthreetimes;", "\xE2\x8B\x8C", 16, 3}, {"bemptyv;", "\xE2\xA6\xB0", 8, 3},
+    {"kscr;", "\xF0\x9D\x93\x80", 5, 4}, {"nhpar;", "\xE2\xAB\xB2", 6, 3}, {"NestedLessLess;", "\xE2\x89\xAA", 15, 3},
+    {"osol;", "\xE2\x8A\x98", 5, 3}, {"LeftDownVector;", "\xE2\x87\x83", 15, 3}, {"leqq;", "\xE2\x89\xA6", 5, 3},
+    {"ouml;", "\xC3\xB6", 5, 2}, {"Abreve;", "\xC4\x82", 7, 2}, {"ell;", "\xE2\x84\x93", 4, 3},
+    {"Rarr;", "\xE2\x86\xA0", 5, 3}, {"Pscr;", "\xF0\x9D\x92\xAB", 5, 4}, {"lacute;", "\xC4\xBA", 7, 2},
+    {"Intersection;", "\xE2\x8B\x82", 13, 3}, {"rtriltri;", "\xE2\xA7\x8E", 9, 3}, {"mfr;", "\xF0\x9D\x94\xAA", 4, 4},
+    {"NotDoubleVerticalBar;", "\xE2\x88\xA6", 21, 3}, {"NotTildeTilde;", "\xE2\x89\x89", 14, 3}, {"NonBreakingSpace;", "\xC2\xA0", 17, 2},
+    {"kcy;", "\xD0\xBA", 4, 2}, {"gtdot;", "\xE2\x8B\x97", 6, 3}, {"gtrarr;", "\xE2\xA5\xB8", 7, 3},
+    {"ucy;", "\xD1\x83", 4, 2}, {"therefore;", "\xE2\x88\xB4", 10, 3}, {"backcong;", "\xE2\x89\x8C", 9, 3},
+    {"exponentiale;", "\xE2\x85\x87", 13, 3}, {"tscr;", "\xF0\x9D\x93\x89", 5, 4}, {"LJcy;", "\xD0\x89", 5, 2},
+    {"preceq;", "\xE2\xAA\xAF", 7, 3}, {"LowerLeftArrow;", "\xE2\x86\x99", 15, 3}, {"lneqq;", "\xE2\x89\xA8", 6, 3},
+    {"EqualTilde;", "\xE2\x89\x82", 11, 3}, {"Lfr;", "\xF0\x9D\x94\x8F", 4, 4}, {"DiacriticalAcute;", "\xC2\xB4", 17, 2},
+    {"upuparrows;", "\xE2\x87\x88", 11, 3}, {"primes;", "\xE2\x84\x99", 7, 3}, {"drbkarow;", "\xE2\xA4\x90", 9, 3},
+    {"oint;", "\xE2\x88\xAE", 5, 3}, {"Verbar;", "\xE2\x80\x96", 7, 3}, {"loplus;", "\xE2\xA8\xAD", 7, 3},
+    {"TScy;", "\xD0\xA6", 5, 2}, {"ucirc;", "\xC3\xBB", 6, 2}, {"Ncy;", "\xD0\x9D", 4, 2},
+    {"upsih;", "\xCF\x92", 6, 2}, {"DifferentialD;", "\xE2\x85\x86", 14, 3}, {"nvgt;", "\x3E\xE2\x83\x92", 5, 4},
+    {"Laplacetrf;", "\xE2\x84\x92", 11, 3}, {"dash;", "\xE2\x80\x90", 5, 3}, {"Hat;", "\x5E", 4, 1},
+    {"nprec;", "\xE2\x8A\x80", 6, 3}, {"ocir;", "\xE2\x8A\x9A", 5, 3}, {"angrtvb;", "\xE2\x8A\xBE", 8, 3},
+    {"roang;", "\xE2\x9F\xAD", 6, 3}, {"rlarr;", "\xE2\x87\x84", 6, 3}, {"Acirc", "\xC3\x82", 5, 2},
+    {"ntrianglelefteq;", "\xE2\x8B\xAC", 16, 3}, {"sube;", "\xE2\x8A\x86", 5, 3}, {"yuml", "\xC3\xBF", 4, 2},
+    {"iexcl;", "\xC2\xA1", 6, 2}, {"simlE;", "\xE2\xAA\x9F", 6, 3}, {"LT;", "\x3C", 3, 1},
+    {"gt", "\x3E", 2, 1}, {"par;", "\xE2\x88\xA5", 4, 3}, {"vArr;", "\xE2\x87\x95", 5, 3},
+    {"ffllig;", "\xEF\xAC\x84", 7, 3}, {"boxDL;", "\xE2\x95\x97", 6, 3}, {"neArr;", "\xE2\x87\x97", 6, 3},
+    {"larrpl;", "\xE2\xA4\xB9", 7, 3}, {"triangledown;", "\xE2\x96\xBF", 13, 3}, {"odash;", "\xE2\x8A\x9D", 6, 3},
+    {"sqsupset;", "\xE2\x8A\x90", 9, 3}, {"RightDoubleBracket;", "\xE2\x9F\xA7", 19, 3}, {"kfr;", "\xF0\x9D\x94\xA8", 4, 4},
+    {"Ofr;", "\xF0\x9D\x94\x92", 4, 4}, {"expectation;", "\xE2\x84\xB0", 12, 3}, {"upharpoonleft;", "\xE2\x86\xBF", 14, 3},
+    {"IJlig;", "\xC4\xB2", 6, 2}, {"NotLess;", "\xE2\x89\xAE", 8, 3}, {"ubrcy;", "\xD1\x9E", 6, 2},
+    {"trisb;", "\xE2\xA7\x8D", 6, 3}, {"lesseqqgtr;", "\xE2\xAA\x8B", 11, 3}, {"mopf;", "\xF0\x9D\x95\x9E", 5, 4},
+    {"ccups;", "\xE2\xA9\x8C", 6, 3}, {"TildeTilde;", "\xE2\x89\x88", 11, 3}, {"Vbar;", "\xE2\xAB\xAB", 5, 3},
+    {"utdot;", "\xE2\x8B\xB0", 6, 3}, {"OpenCurlyQuote;", "\xE2\x80\x98", 15, 3}, {"hkswarow;", "\xE2\xA4\xA6", 9, 3},
+    {"imped;", "\xC6\xB5", 6, 2}, {"wp;", "\xE2\x84\x98", 3, 3}, {"geqq;", "\xE2\x89\xA7", 5, 3},
+    {"NotLessEqual;", "\xE2\x89\xB0", 13, 3}, {"Uogon;", "\xC5\xB2", 6, 2}, {"seswar;", "\xE2\xA4\xA9", 7, 3},
+    {"ReverseElement;", "\xE2\x88\x8B", 15, 3}, {"Nu;", "\xCE\x9D", 3, 2}, {"Aacute", "\xC3\x81", 6, 2},
+    {"uharl;", "\xE2\x86\xBF", 6, 3}, {"ofr;", "\xF0\x9D\x94\xAC", 4, 4}, {"Ugrave;", "\xC3\x99", 7, 2},
+    {"profalar;", "\xE2\x8C\xAE", 9, 3}, {"COPY;", "\xC2\xA9", 5, 2}, {"dotplus;", "\xE2\x88\x94", 8, 3},
+    {"boxVl;", "\xE2\x95\xA2", 6, 3}, {"lambda;", "\xCE\xBB", 7, 2}, {"bumpE;", "\xE2\xAA\xAE", 6, 3},
+    {"Integral;", "\xE2\x88\xAB", 9, 3}, {"risingdotseq;", "\xE2\x89\x93", 13, 3}, {"nvDash;", "\xE2\x8A\xAD", 7, 3},
+    {"xhArr;", "\xE2\x9F\xBA", 6, 3}, {"Gammad;", "\xCF\x9C", 7, 2}, {"oelig;", "\xC5\x93", 6, 2},
+    {"lbrack;", "\x5B", 7, 1}, {"nVDash;", "\xE2\x8A\xAF", 7, 3}, {"prnsim;", "\xE2\x8B\xA8", 7, 3},
+    {"ncaron;", "\xC5\x88", 7, 2}, {"Oscr;", "\xF0\x9D\x92\xAA", 5, 4}, {"boxur;", "\xE2\x94\x94", 6, 3},
+    {"Gbreve;", "\xC4\x9E", 7, 2}, {"flat;", "\xE2\x99\xAD", 5, 3}, {"acute", "\xC2\xB4", 5, 2},
+    {"timesbar;", "\xE2\xA8\xB1", 9, 3}, {"otilde", "\xC3\xB5", 6, 2}, {"leftrightsquigarrow;", "\xE2\x86\xAD", 20, 3},
+    {"angst;", "\xC3\x85", 6, 2}, {"UpTee;", "\xE2\x8A\xA5", 6, 3}, {"Zeta;", "\xCE\x96", 5, 2},
+    {"olarr;", "\xE2\x86\xBA", 6, 3}, {"SubsetEqual;", "\xE2\x8A\x86", 12, 3}, {"mdash;", "\xE2\x80\x94", 6, 3},
+    {"Yopf;", "\xF0\x9D\x95\x90", 5, 4}, {"lrarr;", "\xE2\x87\x86", 6, 3}, {"timesd;", "\xE2\xA8\xB0", 7, 3},
+    {"ratio;", "\xE2\x88\xB6", 6, 3}, {"nu;", "\xCE\xBD", 3, 2}, {"varrho;", "\xCF\xB1", 7, 2},
+    {"naturals;", "\xE2\x84\x95", 9, 3}, {"vnsub;", "\xE2\x8A\x82\xE2\x83\x92", 6, 6}, {"natur;", "\xE2\x99\xAE", 6, 3},
+    {"Icy;", "\xD0\x98", 4, 2}, {"rtrif;", "\xE2\x96\xB8", 6, 3}, {"permil;", "\xE2\x80\xB0", 7, 3},
+    {"angmsdab;", "\xE2\xA6\xA9", 9, 3}, {"supdot;", "\xE2\xAA\xBE", 7, 3}, {"triangleq;", "\xE2\x89\x9C", 10, 3},
+    {"Icirc;", "\xC3\x8E", 6, 2}, {"caret;", "\xE2\x81\x81", 6, 3}, {"nVdash;", "\xE2\x8A\xAE", 7, 3},
+    {"Bopf;", "\xF0\x9D\x94\xB9", 5, 4}, {"boxUR;", "\xE2\x95\x9A", 6, 3}, {"searhk;", "\xE2\xA4\xA5", 7, 3},
+    {"DownRightVectorBar;", "\xE2\xA5\x97", 19, 3}, {"there4;", "\xE2\x88\xB4", 7, 3}, {"laemptyv;", "\xE2\xA6\xB4", 9, 3},
+    {"nsc;", "\xE2\x8A\x81", 4, 3}, {"Gcirc;", "\xC4\x9C", 6, 2}, {"propto;", "\xE2\x88\x9D", 7, 3},
+    {"rarr;", "\xE2\x86\x92", 5, 3}, {"rAtail;", "\xE2\xA4\x9C", 7, 3}, {"varphi;", "\xCF\x95", 7, 2},
+    {"Edot;", "\xC4\x96", 5, 2}, {"lthree;", "\xE2\x8B\x8B", 7, 3}, {"ctdot;", "\xE2\x8B\xAF", 6, 3},
+    {"uuarr;", "\xE2\x87\x88", 6, 3}, {"multimap;", "\xE2\x8A\xB8", 9, 3}, {"subE;", "\xE2\xAB\x85", 5, 3},
+    {"zhcy;", "\xD0\xB6", 5, 2}, {"DoubleLeftTee;", "\xE2\xAB\xA4", 14, 3}, {"varpropto;", "\xE2\x88\x9D", 10, 3},
+    {"angzarr;", "\xE2\x8D\xBC", 8, 3}, {"csube;", "\xE2\xAB\x91", 6, 3}, {"Mfr;", "\xF0\x9D\x94\x90", 4, 4},
+    {"mstpos;", "\xE2\x88\xBE", 7, 3}, {"lpar;", "\x28", 5, 1}, {"HumpDownHump;", "\xE2\x89\x8E", 13, 3},
+    {"ecirc", "\xC3\xAA", 5, 2}, {"phiv;", "\xCF\x95", 5, 2}, {"vangrt;", "\xE2\xA6\x9C", 7, 3},
+    {"olcir;", "\xE2\xA6\xBE", 6, 3}, {"Iuml;", "\xC3\x8F", 5, 2}, {"sim;", "\xE2\x88\xBC", 4, 3},
+    {"divide;", "\xC3\xB7", 7, 2}, {"ntlg;", "\xE2\x89\xB8", 5, 3}, {"ltimes;", "\xE2\x8B\x89", 7, 3},
+    {"Lscr;", "\xE2\x84\x92", 5, 3}, {"Because;", "\xE2\x88\xB5", 8, 3}, {"SquareSubset;", "\xE2\x8A\x8F", 13, 3},
+    {"amalg;", "\xE2\xA8\xBF", 6, 3}, {"Racute;", "\xC5\x94", 7, 2}, {"bNot;", "\xE2\xAB\xAD", 5, 3},
+    {"raquo;", "\xC2\xBB", 6, 2}, {"nsce;", "\xE2\xAA\xB0\xCC\xB8", 5, 5}, {"Ecirc;", "\xC3\x8A", 6, 2},
+    {"dot;", "\xCB\x99", 4, 2}, {"LessEqualGreater;", "\xE2\x8B\x9A", 17, 3}, {"setminus;", "\xE2\x88\x96", 9, 3},
+    {"harrw;", "\xE2\x86\xAD", 6, 3}, {"Otilde", "\xC3\x95", 6, 2}, {"DoubleLongLeftArrow;", "\xE2\x9F\xB8", 20, 3},
+    {"vrtri;", "\xE2\x8A\xB3", 6, 3}, {"lang;", "\xE2\x9F\xA8", 5, 3}, {"centerdot;", "\xC2\xB7", 10, 2},
+    {"ecaron;", "\xC4\x9B", 7, 2}, {"hArr;", "\xE2\x87\x94", 5, 3}, {"period;", "\x2E", 7, 1},
+    {"bsime;", "\xE2\x8B\x8D", 6, 3}, {"tilde;", "\xCB\x9C", 6, 2}, {"cirmid;", "\xE2\xAB\xAF", 7, 3},
+    {"oacute;", "\xC3\xB3", 7, 2}, {"circleddash;", "\xE2\x8A\x9D", 12, 3}, {"nparallel;", "\xE2\x88\xA6", 10, 3},
+    {"ultri;", "\xE2\x97\xB8", 6, 3}, {"prec;", "\xE2\x89\xBA", 5, 3}, {"Scedil;", "\xC5\x9E", 7, 2},
+    {"bumpe;", "\xE2\x89\x8F", 6, 3}, {"nbump;", "\xE2\x89\x8E\xCC\xB8", 6, 5}, {"Oacute", "\xC3\x93", 6, 2},
+    {"nle;", "\xE2\x89\xB0", 4, 3}, {"xharr;", "\xE2\x9F\xB7", 6, 3}, {"NoBreak;", "\xE2\x81\xA0", 8, 3},
+    {"nwarhk;", "\xE2\xA4\xA3", 7, 3}, {"Wscr;", "\xF0\x9D\x92\xB2", 5, 4}, {"PrecedesEqual;", "\xE2\xAA\xAF", 14, 3},
+    {"diams;", "\xE2\x99\xA6", 6, 3}, {"Gdot;", "\xC4\xA0", 5, 2}, {"rdquor;", "\xE2\x80\x9D", 7, 3},
+    {"Rho;", "\xCE\xA1", 4, 2}, {"rmoust;", "\xE2\x8E\xB1", 7, 3}, {"OElig;", "\xC5\x92", 6, 2},
+    {"Xfr;", "\xF0\x9D\x94\x9B", 4, 4}, {"Sqrt;", "\xE2\x88\x9A", 5, 3}, {"blacklozenge;", "\xE2\xA7\xAB", 13, 3},
+    {"iopf;", "\xF0\x9D\x95\x9A", 5, 4}, {"Nscr;", "\xF0\x9D\x92\xA9", 5, 4}, {"Tcaron;", "\xC5\xA4", 7, 2},
+    {"pluscir;", "\xE2\xA8\xA2", 8, 3}, {"ncup;", "\xE2\xA9\x82", 5, 3}, {"Sfr;", "\xF0\x9D\x94\x96", 4, 4},
+    {"nsimeq;", "\xE2\x89\x84", 7, 3}, {"Zopf;", "\xE2\x84\xA4", 5, 3}, {"RightArrowBar;", "\xE2\x87\xA5", 14, 3},
+    {"loang;", "\xE2\x9F\xAC", 6, 3}, {"succsim;", "\xE2\x89\xBF", 8, 3}, {"KJcy;", "\xD0\x8C", 5, 2},
+    {"Tfr;", "\xF0\x9D\x94\x97", 4, 4}, {"times;", "\xC3\x97", 6, 2}, {"infin;", "\xE2\x88\x9E", 6, 3},
+    {"eqcolon;", "\xE2\x89\x95", 8, 3}, {"latail;", "\xE2\xA4\x99", 7, 3}, {"lbbrk;", "\xE2\x9D\xB2", 6, 3},
+    {"odiv;", "\xE2\xA8\xB8", 5, 3}, {"Diamond;", "\xE2\x8B\x84", 8, 3}, {"frac12", "\xC2\xBD", 6, 2},
+    {"scE;", "\xE2\xAA\xB4", 4, 3}, {"xlArr;", "\xE2\x9F\xB8", 6, 3}, {"duarr;", "\xE2\x87\xB5", 6, 3},
+    {"pm;", "\xC2\xB1", 3, 2}, {"hyphen;", "\xE2\x80\x90", 7, 3}, {"submult;", "\xE2\xAB\x81", 8, 3},
+    {"LessLess;", "\xE2\xAA\xA1", 9, 3}, {"precneqq;", "\xE2\xAA\xB5", 9, 3}, {"NotGreater;", "\xE2\x89\xAF", 11, 3},
+    {"YAcy;", "\xD0\xAF", 5, 2}, {"oslash", "\xC3\xB8", 6, 2}, {"DotDot;", "\xE2\x83\x9C", 7, 3},
+    {"NotGreaterEqual;", "\xE2\x89\xB1", 16, 3}, {"lrtri;", "\xE2\x8A\xBF", 6, 3}, {"lcub;", "\x7B", 5, 1},
+    {"angmsdaf;", "\xE2\xA6\xAD", 9, 3}, {"eta;", "\xCE\xB7", 4, 2}, {"LeftTeeArrow;", "\xE2\x86\xA4", 13, 3},
+    {"yen", "\xC2\xA5", 3, 2}, {"profline;", "\xE2\x8C\x92", 9, 3}, {"real;", "\xE2\x84\x9C", 5, 3},
+    {"female;", "\xE2\x99\x80", 7, 3}, {"notnivb;", "\xE2\x8B\xBE", 8, 3}, {"frac78;", "\xE2\x85\x9E", 7, 3},
+    {"tosa;", "\xE2\xA4\xA9", 5, 3}, {"boxVR;", "\xE2\x95\xA0", 6, 3}, {"congdot;", "\xE2\xA9\xAD", 8, 3},
+    {"ecirc;", "\xC3\xAA", 6, 2}, {"Ecaron;", "\xC4\x9A", 7, 2}, {"prnE;", "\xE2\xAA\xB5", 5, 3},
+    {"rarrbfs;", "\xE2\xA4\xA0", 8, 3}, {"smeparsl;", "\xE2\xA7\xA4", 9, 3}, {"lparlt;", "\xE2\xA6\x93", 7, 3},
+    {"xodot;", "\xE2\xA8\x80", 6, 3}, {"euml", "\xC3\xAB", 4, 2}, {"UpArrowDownArrow;", "\xE2\x87\x85", 17, 3},
+    {"igrave;", "\xC3\xAC", 7, 2}, {"UpperRightArrow;", "\xE2\x86\x97", 16, 3}, {"daleth;", "\xE2\x84\xB8", 7, 3},
+    {"esdot;", "\xE2\x89\x90", 6, 3}, {"gammad;", "\xCF\x9D", 7, 2}, {"rangd;", "\xE2\xA6\x92", 6, 3},
+    {"cirfnint;", "\xE2\xA8\x90", 9, 3}, {"parsl;", "\xE2\xAB\xBD", 6, 3}, {"NotLessGreater;", "\xE2\x89\xB8", 15, 3},
+    {"simdot;", "\xE2\xA9\xAA", 7, 3}, {"gtreqless;", "\xE2\x8B\x9B", 10, 3}, {"SquareSupersetEqual;", "\xE2\x8A\x92", 20, 3},
+    {"verbar;", "\x7C", 7, 1}, {"notinva;", "\xE2\x88\x89", 8, 3}, {"NotSucceedsEqual;", "\xE2\xAA\xB0\xCC\xB8", 17, 5},
+    {"Lstrok;", "\xC5\x81", 7, 2}, {"urcorner;", "\xE2\x8C\x9D", 9, 3}, {"Lacute;", "\xC4\xB9", 7, 2},
+    {"rscr;", "\xF0\x9D\x93\x87", 5, 4}, {"LeftUpDownVector;", "\xE2\xA5\x91", 17, 3}, {"Jukcy;", "\xD0\x84", 6, 2},
+    {"ucirc", "\xC3\xBB", 5, 2}, {"dd;", "\xE2\x85\x86", 3, 3}, {"straightphi;", "\xCF\x95", 12, 2},
+    {"prsim;", "\xE2\x89\xBE", 6, 3}, {"gap;", "\xE2\xAA\x86", 4, 3}, {"updownarrow;", "\xE2\x86\x95", 12, 3},
+    {"GreaterLess;", "\xE2\x89\xB7", 12, 3}, {"homtht;", "\xE2\x88\xBB", 7, 3}, {"nparsl;", "\xE2\xAB\xBD\xE2\x83\xA5", 7, 6},
+    {"Sigma;", "\xCE\xA3", 6, 2}, {"Jcirc;", "\xC4\xB4", 6, 2}, {"vsubnE;", "\xE2\xAB\x8B\xEF\xB8\x80", 7, 6},
+    {"Copf;", "\xE2\x84\x82", 5, 3}, {"Bcy;", "\xD0\x91", 4, 2}, {"duhar;", "\xE2\xA5\xAF", 6, 3},
+    {"RightArrow;", "\xE2\x86\x92", 11, 3}, {"nlE;", "\xE2\x89\xA6\xCC\xB8", 4, 5}, {"mldr;", "\xE2\x80\xA6", 5, 3},
+    {"ltdot;", "\xE2\x8B\x96", 6, 3}, {"fork;", "\xE2\x8B\x94", 5, 3}, {"complexes;", "\xE2\x84\x82", 10, 3},
+    {"ohm;", "\xCE\xA9", 4, 2}, {"Ecy;", "\xD0\xAD", 4, 2}, {"CenterDot;", "\xC2\xB7", 10, 2},
+    {"mapstoleft;", "\xE2\x86\xA4", 11, 3}, {"eg;", "\xE2\xAA\x9A", 3, 3}, {"epsiv;", "\xCF\xB5", 6, 2},
+    {"gesles;", "\xE2\xAA\x94", 7, 3}, {"oacute", "\xC3\xB3", 6, 2}, {"subsub;", "\xE2\xAB\x95", 7, 3},
+    {"midast;", "\x2A", 7, 1}, {"blacktriangle;", "\xE2\x96\xB4", 14, 3}, {"nequiv;", "\xE2\x89\xA2", 7, 3},
+    {"ZHcy;", "\xD0\x96", 5, 2}, {"NotSucceedsSlantEqual;", "\xE2\x8B\xA1", 22, 3}, {"tshcy;", "\xD1\x9B", 6, 2},
+    {"lnap;", "\xE2\xAA\x89", 5, 3}, {"or;", "\xE2\x88\xA8", 3, 3}, {"SquareSubsetEqual;", "\xE2\x8A\x91", 18, 3},
+    {"orderof;", "\xE2\x84\xB4", 8, 3}, {"Xscr;", "\xF0\x9D\x92\xB3", 5, 4}, {"coloneq;", "\xE2\x89\x94", 8, 3},
+    {"leftrightharpoons;", "\xE2\x87\x8B", 18, 3}, {"in;", "\xE2\x88\x88", 3, 3}, {"rightsquigarrow;", "\xE2\x86\x9D", 16, 3},
+    {"cularrp;", "\xE2\xA4\xBD", 8, 3}, {"nsqsupe;", "\xE2\x8B\xA3", 8, 3}, {"udblac;", "\xC5\xB1", 7, 2},
+    {"notni;", "\xE2\x88\x8C", 6, 3}, {"rbbrk;", "\xE2\x9D\xB3", 6, 3}, {"Xi;", "\xCE\x9E", 3, 2},
+    {"CircleMinus;", "\xE2\x8A\x96", 12, 3}, {"uarr;", "\xE2\x86\x91", 5, 3}, {"sc;", "\xE2\x89\xBB", 3, 3},
+    {"emacr;", "\xC4\x93", 6, 2}, {"blacksquare;", "\xE2\x96\xAA", 12, 3}, {"div;", "\xC3\xB7", 4, 2},
+    {"blk12;", "\xE2\x96\x92", 6, 3}, {"rarrw;", "\xE2\x86\x9D", 6, 3}, {"rfloor;", "\xE2\x8C\x8B", 7, 3},
+    {"jsercy;", "\xD1\x98", 7, 2}, {"supedot;", "\xE2\xAB\x84", 8, 3}, {"operp;", "\xE2\xA6\xB9", 6, 3},
+    {"nrarrc;", "\xE2\xA4\xB3\xCC\xB8", 7, 5}, {"YUcy;", "\xD0\xAE", 5, 2}, {"urtri;", "\xE2\x97\xB9", 6, 3},
+    {"GreaterSlantEqual;", "\xE2\xA9\xBE", 18, 3}, {"simrarr;", "\xE2\xA5\xB2", 8, 3}, {"Proportional;", "\xE2\x88\x9D", 13, 3},
+    {"frac34", "\xC2\xBE", 6, 2}, {"cudarrr;", "\xE2\xA4\xB5", 8, 3}, {"Zdot;", "\xC5\xBB", 5, 2},
+    {"models;", "\xE2\x8A\xA7", 7, 3}, {"spar;", "\xE2\x88\xA5", 5, 3}, {"ges;", "\xE2\xA9\xBE", 4, 3},
+    {"intlarhk;", "\xE2\xA8\x97", 9, 3}, {"tprime;", "\xE2\x80\xB4", 7, 3}, {"boxVr;", "\xE2\x95\x9F", 6, 3},
+    {"because;", "\xE2\x88\xB5", 8, 3}, {"gtcir;", "\xE2\xA9\xBA", 6, 3}, {"lg;", "\xE2\x89\xB6", 3, 3},
+    {"elinters;", "\xE2\x8F\xA7", 9, 3}, {"af;", "\xE2\x81\xA1", 3, 3}, {"omid;", "\xE2\xA6\xB6", 5, 3},
+    {"plus;", "\x2B", 5, 1}, {"GreaterFullEqual;", "\xE2\x89\xA7", 17, 3}, {"lesssim;", "\xE2\x89\xB2", 8, 3},
+    {"Idot;", "\xC4\xB0", 5, 2}, {"iquest;", "\xC2\xBF", 7, 2}, {"bigtriangledown;", "\xE2\x96\xBD", 16, 3},
+    {"bcong;", "\xE2\x89\x8C", 6, 3}, {"eng;", "\xC5\x8B", 4, 2}, {"nwArr;", "\xE2\x87\x96", 6, 3},
+    {"glj;", "\xE2\xAA\xA4", 4, 3}, {"larrb;", "\xE2\x87\xA4", 6, 3}, {"nsupe;", "\xE2\x8A\x89", 6, 3},
+    {"DownArrow;", "\xE2\x86\x93", 10, 3}, {"ddarr;", "\xE2\x87\x8A", 6, 3}, {"cap;", "\xE2\x88\xA9", 4, 3},
+    {"sscr;", "\xF0\x9D\x93\x88", 5, 4}, {"supnE;", "\xE2\xAB\x8C", 6, 3}, {"colon;", "\x3A", 6, 1},
+    {"forall;", "\xE2\x88\x80", 7, 3}, {"spades;", "\xE2\x99\xA0", 7, 3}, {"dtdot;", "\xE2\x8B\xB1", 6, 3},
+    {"uacute;", "\xC3\xBA", 7, 2}, {"hookleftarrow;", "\xE2\x86\xA9", 14, 3}, {"ffr;", "\xF0\x9D\x94\xA3", 4, 4},
+    {"aelig;", "\xC3\xA6", 6, 2}, {"iiota;", "\xE2\x84\xA9", 6, 3}, {"blk34;", "\xE2\x96\x93", 6, 3},
+    {"udarr;", "\xE2\x87\x85", 6, 3}, {"Kappa;", "\xCE\x9A", 6, 2}, {"SucceedsSlantEqual;", "\xE2\x89\xBD", 19, 3},
+    {"Imacr;", "\xC4\xAA", 6, 2}, {"ngtr;", "\xE2\x89\xAF", 5, 3}, {"doublebarwedge;", "\xE2\x8C\x86", 15, 3},
+    {"rbrksld;", "\xE2\xA6\x8E", 8, 3}, {"Yuml;", "\xC5\xB8", 5, 2}, {"iecy;", "\xD0\xB5", 5, 2},
+    {"nGtv;", "\xE2\x89\xAB\xCC\xB8", 5, 5}, {"nsub;", "\xE2\x8A\x84", 5, 3}, {"gcirc;", "\xC4\x9D", 6, 2},
+    {"rbrace;", "\x7D", 7, 1}, {"ltlarr;", "\xE2\xA5\xB6", 7, 3}, {"Yscr;", "\xF0\x9D\x92\xB4", 5, 4},
+    {"zcy;", "\xD0\xB7", 4, 2}, {"yacy;", "\xD1\x8F", 5, 2}, {"ee;", "\xE2\x85\x87", 3, 3},
+    {"IOcy;", "\xD0\x81", 5, 2}, {"uring;", "\xC5\xAF", 6, 2}, {"Pr;", "\xE2\xAA\xBB", 3, 3},
+    {"Mellintrf;", "\xE2\x84\xB3", 10, 3}, {"Ucirc", "\xC3\x9B", 5, 2}, {"Bfr;", "\xF0\x9D\x94\x85", 4, 4},
+    {"ecir;", "\xE2\x89\x96", 5, 3}, {"InvisibleComma;", "\xE2\x81\xA3", 15, 3}, {"rx;", "\xE2\x84\x9E", 3, 3},
+    {"rppolint;", "\xE2\xA8\x92", 9, 3}, {"UpperLeftArrow;", "\xE2\x86\x96", 15, 3}, {"Yacute;", "\xC3\x9D", 7, 2},
+    {"between;", "\xE2\x89\xAC", 8, 3}, {"boxhU;", "\xE2\x95\xA8", 6, 3}, {"Scy;", "\xD0\xA1", 4, 2},
+    {"copy;", "\xC2\xA9", 5, 2}, {"nvrArr;", "\xE2\xA4\x83", 7, 3}, {"ii;", "\xE2\x85\x88", 3, 3},
+    {"leg;", "\xE2\x8B\x9A", 4, 3}, {"Upsi;", "\xCF\x92", 5, 2}, {"boxminus;", "\xE2\x8A\x9F", 9, 3},
+    {"vellip;", "\xE2\x8B\xAE", 7, 3}, {"ulcorn;", "\xE2\x8C\x9C", 7, 3}, {"quot", "\x22", 4, 1},
+    {"prcue;", "\xE2\x89\xBC", 6, 3}, {"angmsdac;", "\xE2\xA6\xAA", 9, 3}
+};
+
+/* replacements for the C1 range of numeric references (windows-1252) */
+static const unsigned short C1_REPLACEMENTS[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178
+};
+
+static uint32_t entity_hash(uint32_t seed, const char* name, size_t length) {
+    uint32_t hash = 2166136261u ^ seed;
+
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)name[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+const HTMLEntity* html_entity_lookup(const char* name, size_t length) {
+    if (!name || length == 0 || length > HTML_ENTITY_MAX_NAME)
+        return NULL;
+
+    uint32_t seed = ENTITY_DISPLACEMENTS[entity_hash(0, name, length) % HTML_ENTITY_BUCKETS];
+    const HTMLEntity* entity = &ENTITY_TABLE[entity_hash(seed, name, length) % HTML_ENTITY_COUNT];
+
+    if (entity->name_length != length || memcmp(entity->name, name, length) != 0)
+        return NULL;
+
+    return entity;
+}
+
+static size_t encode_utf8(uint32_t code, char* dest) {
+    if (code < 0x80) {
+        dest[0] = (char)code;
+        return 1;
+    }
+
+    if (code < 0x800) {
+        dest[0] = (char)(0xC0 | (code >> 6));
+        dest[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+
+    if (code < 0x10000) {
+        dest[0] = (char)(0xE0 | (code >> 12));
+        dest[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        dest[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+
+    dest[0] = (char)(0xF0 | (code >> 18));
+    dest[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    dest[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    dest[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+/* decodes "#digits;" or "#xhex;" after the '&', returns the bytes consumed or 0 */
+static size_t decode_numeric(const char* src, size_t length, char* dest, size_t* written) {
+    size_t pos = 1;
+    int hex = 0;
+
+    if (pos < length && (src[pos] == 'x' || src[pos] == 'X')) {
+        hex = 1;
+        pos++;
+    }
+
+    size_t digits = pos;
+    uint32_t code = 0;
+
+    while (pos < length) {
+        unsigned char c = (unsigned char)src[pos];
+        uint32_t digit;
+
+        if (isdigit(c)) digit = c - '0';
+        else if (hex && isxdigit(c)) digit = (uint32_t)(tolower(c) - 'a' + 10);
+        else break;
+
+        /* clamp so overlong references stay out of range */
+        if (code <= 0x10FFFF)
+            code = code * (hex ? 16 : 10) + digit;
+        pos++;
+    }
+
+    if (pos == digits) return 0;
+    if (pos < length && src[pos] == ';') pos++;
+
+    if (code == 0 || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF))
+        code = 0xFFFD;
+    else if (code >= 0x80 && code <= 0x9F)
+        code = C1_REPLACEMENTS[code - 0x80];
+
+    *written = encode_utf8(code, dest);
+    return pos;
+}
+
+/* decodes a named reference after the '&', returns the bytes consumed or 0 */
+static size_t decode_named(const char* src, size_t length, char* dest,
+    size_t* written, int in_attribute) {
+    size_t run = 0;
+
+    while (run < HTML_ENTITY_MAX_NAME && run < length &&
+        isalnum((unsigned char)src[run]))
+        run++;
+
+    if (run == 0) return 0;
+    const HTMLEntity* entity = NULL;
+    size_t used = 0;
+
+    if (run < length && src[run] == ';')
+        entity = html_entity_lookup(src, used = run + 1);
+
+    /* longest legacy name accepted without a semicolon */
+    for (size_t k = run < HTML_ENTITY_MAX_LEGACY_NAME ? run
+        : HTML_ENTITY_MAX_LEGACY_NAME; !entity && k >= 2; k--) {
+        entity = html_entity_lookup(src, used = k);
+
+        /* "&amp=" and "&copyx" stay literal inside attribute values */
+        if (entity && in_attribute && used < length &&
+            (src[used] == '=' || isalnum((unsigned char)src[used])))
+            return 0;
+    }
+
+    if (!entity) return 0;
+    memcpy(dest, entity->value, entity->value_length);
+    *written = entity->value_length;
+    return used;
+}
+
+size_t html_decode_entities(const char* source, size_t length,
+    char* dest, int in_attribute, const unsigned short* charset_map) {
+    const char* src = source;
+    const char* const end = source + length;
+    char* out = dest;
+
+    while (src < end) {
+        const char* amp = (const char*)memchr(src, '&', (size_t)(end - src));
+
+        if (!amp) {
+            out += html_charset_transcode(src, (size_t)(end - src), out, charset_map);
+            break;
+        }
+
+        out += html_charset_transcode(src, (size_t)(amp - src), out, charset_map);
+        src = amp + 1;
+
+        size_t written = 0, consumed = 0;
+
+        if (src < end && *src == '#')
+            consumed = decode_numeric(src, (size_t)(end - src), out, &written);
+        else if (src < end)
+            consumed = decode_named(src, (size_t)(end - src), out, &written, in_attribute);
+
+        if (consumed) {
+            out += written;
+            src += consumed;
+        }
+        else
+            *out++ = '&';
+    }
+
+    *out = '\0';
+    return (size_t)(out - dest);
+}
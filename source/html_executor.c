@@ -0,0 +1,419 @@
+#include "html2tex.h"
+#include "html_executor.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define HTML2TEX_TLS __declspec(thread)
+#else
+#define HTML2TEX_TLS __thread
+#endif
+
+/* one queue per priority, indexed from HTML_PRIORITY_LOW */
+#define EXECUTOR_LEVELS 3
+#define EXECUTOR_LEVEL(priority) ((size_t)((priority) - HTML_PRIORITY_LOW))
+
+/* tasks a worker keeps for itself per level before posting to the shared queue */
+#define EXECUTOR_LOCAL_CAPACITY 256
+
+struct HTMLExecutorPool {
+    HTMLTaskPriority priority;
+    atomic_size_t pending;
+
+    /* html_executor_pool_destroy() parks here until pending drops to zero */
+    mutex_t mutex;
+    cond_t drained;
+};
+
+typedef struct {
+    thread_t thread;
+    size_t index;
+
+    /* tasks posted from this worker, idle workers steal them */
+    HTMLWorkQueue* local[EXECUTOR_LEVELS];
+} ExecutorWorker;
+
+typedef struct {
+    /* lifecycle, guarded by mutex */
+    mutex_t mutex;
+    size_t configured;
+    size_t pools;
+    int running;
+
+    ExecutorWorker* workers;
+    size_t worker_slots;
+    size_t worker_count;
+
+    HTMLWorkQueue* queues[EXECUTOR_LEVELS];
+    atomic_size_t waiting[EXECUTOR_LEVELS];
+    atomic_size_t stopping;
+
+    /* idle workers park here, submitters lock only when one does */
+    mutex_t park_mutex;
+    cond_t work;
+    atomic_size_t idle;
+} Executor;
+
+static once_t executor_once = THREAD_ONCE_INIT;
+static Executor executor;
+
+/* worker running on this thread, NULL outside of the executor */
+static HTML2TEX_TLS ExecutorWorker* current_worker = NULL;
+
+static void init_executor(void) {
+    mutex_init(&executor.mutex);
+    mutex_init(&executor.park_mutex);
+    cond_init(&executor.work);
+}
+
+static size_t default_threads(void) {
+    const size_t cpus = (size_t)get_cpu_count();
+    return cpus > HTML_EXECUTOR_MIN_THREADS ? cpus : HTML_EXECUTOR_MIN_THREADS;
+}
+
+/* higher levels first, at each level the shared queue, then this worker's, then the others' */
+static HTMLExecutorTask* take_task(ExecutorWorker* self) {
+    for (size_t level = EXECUTOR_LEVELS; level-- > 0; ) {
+        HTMLExecutorTask* task = (HTMLExecutorTask*)html_work_queue_try_pop(executor.queues[level]);
+
+        if (!task)
+            task = (HTMLExecutorTask*)html_work_queue_try_pop(self->local[level]);
+
+        for (size_t i = 1; !task && i < executor.worker_slots; i++) {
+            ExecutorWorker* victim = &executor.workers[(self->index + i) % executor.worker_slots];
+            task = (HTMLExecutorTask*)html_work_queue_try_pop(victim->local[level]);
+        }
+
+        if (task) {
+            atomic_fetch_sub(&executor.waiting[level], 1);
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+/* the last task settles under the lock, so a destroyer never frees the pool under it */
+static void finish_task(HTMLExecutorPool* pool) {
+    size_t pending = atomic_load(&pool->pending);
+
+    while (pending > 1) {
+        if (atomic_compare_exchange(&pool->pending, &pending, pending - 1))
+            return;
+    }
+
+    mutex_lock(&pool->mutex);
+
+    if (atomic_fetch_sub(&pool->pending, 1) == 1)
+        cond_broadcast(&pool->drained);
+
+    mutex_unlock(&pool->mutex);
+}
+
+static void run_task(HTMLExecutorTask* task) {
+    HTMLExecutorPool* pool = task->pool;
+    const HTMLTaskFunc run = task->run;
+    void* arg = task->arg;
+
+    /* tasks may run inline on a conversion thread, keep them off its allocator */
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+
+    /* a posted task belongs to its caller again, it may be posted anew while it runs */
+    if (task->owned) html2tex_free(task);
+
+    run(arg);
+    html2tex_allocator_leave(previous);
+    finish_task(pool);
+}
+
+static void wake_worker(void) {
+    /* pairs with the fence a worker runs before it parks */
+    atomic_fence();
+    if (!atomic_load(&executor.idle)) return;
+
+    mutex_lock(&executor.park_mutex);
+    cond_signal(&executor.work);
+    mutex_unlock(&executor.park_mutex);
+}
+
+static THREAD_RETURN_TYPE worker_main(void* arg) {
+    ExecutorWorker* self = (ExecutorWorker*)arg;
+    current_worker = self;
+
+    for (;;) {
+        HTMLExecutorTask* task = take_task(self);
+
+        if (!task) {
+            mutex_lock(&executor.park_mutex);
+            atomic_fetch_add(&executor.idle, 1);
+            atomic_fence();
+
+            while ((task = take_task(self)) == NULL && !atomic_load(&executor.stopping))
+                cond_wait(&executor.work, &executor.park_mutex);
+
+            atomic_fetch_sub(&executor.idle, 1);
+            mutex_unlock(&executor.park_mutex);
+
+            /* pools are gone before the workers stop, nothing is left to run */
+            if (!task) break;
+        }
+
+        run_task(task);
+    }
+
+    current_worker = NULL;
+    return 0;
+}
+
+/* called with executor.mutex held, once no pool is left */
+static void stop_workers(void) {
+    atomic_store(&executor.stopping, 1);
+
+    mutex_lock(&executor.park_mutex);
+    cond_broadcast(&executor.work);
+    mutex_unlock(&executor.park_mutex);
+
+    for (size_t i = 0; i < executor.worker_count; i++)
+        thread_join(executor.workers[i].thread);
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+
+    for (size_t i = 0; i < executor.worker_slots; i++) {
+        for (size_t level = 0; level < EXECUTOR_LEVELS; level++)
+            html_work_queue_destroy(executor.workers[i].local[level]);
+    }
+
+    for (size_t level = 0; level < EXECUTOR_LEVELS; level++) {
+        html_work_queue_destroy(executor.queues[level]);
+        executor.queues[level] = NULL;
+    }
+
+    html2tex_free(executor.workers);
+    html2tex_allocator_leave(previous);
+
+    executor.workers = NULL;
+    executor.worker_slots = 0;
+    executor.worker_count = 0;
+    executor.running = 0;
+}
+
+/* called with executor.mutex held */
+static int start_workers(void) {
+    const size_t count = executor.configured ? executor.configured : default_threads();
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    int success = 1;
+
+    executor.workers = (ExecutorWorker*)html2tex_calloc(count, sizeof(ExecutorWorker));
+    executor.worker_slots = executor.workers ? count : 0;
+    executor.worker_count = 0;
+    atomic_store(&executor.stopping, 0);
+
+    for (size_t level = 0; success && level < EXECUTOR_LEVELS; level++) {
+        executor.queues[level] = html_work_queue_create(HTML_EXECUTOR_QUEUE_CAPACITY);
+        atomic_store(&executor.waiting[level], 0);
+        success = executor.queues[level] != NULL;
+    }
+
+    for (size_t i = 0; success && executor.workers && i < count; i++) {
+        for (size_t level = 0; success && level < EXECUTOR_LEVELS; level++) {
+            executor.workers[i].local[level] = html_work_queue_create(EXECUTOR_LOCAL_CAPACITY);
+            success = executor.workers[i].local[level] != NULL;
+        }
+
+        executor.workers[i].index = i;
+    }
+
+    html2tex_allocator_leave(previous);
+
+    if (!executor.workers || !success) {
+        stop_workers();
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate %zu executor workers.", count);
+        return 0;
+    }
+
+    /* queues of every slot exist before the first worker steals from them */
+    for (size_t i = 0; i < count; i++) {
+        if (thread_create(&executor.workers[i].thread, worker_main, &executor.workers[i]) != 0) {
+            executor.worker_count = i;
+            stop_workers();
+
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_INTERNAL,
+                "Failed to start executor worker %zu.", i);
+            return 0;
+        }
+
+        executor.worker_count = i + 1;
+    }
+
+    executor.running = 1;
+    return 1;
+}
+
+int html_executor_configure(size_t threads) {
+    html2tex_err_clear();
+    thread_once(&executor_once, init_executor);
+    mutex_lock(&executor.mutex);
+
+    if (executor.running) {
+        mutex_unlock(&executor.mutex);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Executor threads cannot change while pools are running.");
+        return 0;
+    }
+
+    executor.configured = threads;
+    mutex_unlock(&executor.mutex);
+    return 1;
+}
+
+size_t html_executor_threads(void) {
+    thread_once(&executor_once, init_executor);
+    mutex_lock(&executor.mutex);
+
+    const size_t threads = executor.running ? executor.worker_count
+        : executor.configured ? executor.configured : default_threads();
+
+    mutex_unlock(&executor.mutex);
+    return threads;
+}
+
+HTMLExecutorPool* html_executor_pool_create(HTMLTaskPriority priority) {
+    html2tex_err_clear();
+    thread_once(&executor_once, init_executor);
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    HTMLExecutorPool* pool = (HTMLExecutorPool*)html2tex_calloc(1, sizeof(HTMLExecutorPool));
+    html2tex_allocator_leave(previous);
+
+    if (!pool) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate an executor pool.");
+        return NULL;
+    }
+
+    if (priority < HTML_PRIORITY_LOW) priority = HTML_PRIORITY_LOW;
+    if (priority > HTML_PRIORITY_HIGH) priority = HTML_PRIORITY_HIGH;
+
+    pool->priority = priority;
+    atomic_store(&pool->pending, 0);
+    mutex_init(&pool->mutex);
+    cond_init(&pool->drained);
+
+    mutex_lock(&executor.mutex);
+
+    if (!executor.running && !start_workers()) {
+        mutex_unlock(&executor.mutex);
+        mutex_destroy(&pool->mutex);
+        cond_destroy(&pool->drained);
+
+        previous = html2tex_allocator_enter(NULL);
+        html2tex_free(pool);
+        html2tex_allocator_leave(previous);
+        return NULL;
+    }
+
+    executor.pools++;
+    mutex_unlock(&executor.mutex);
+    return pool;
+}
+
+static void enqueue_task(HTMLExecutorPool* pool, HTMLExecutorTask* task) {
+    const size_t level = EXECUTOR_LEVEL(pool->priority);
+    ExecutorWorker* self = current_worker;
+
+    task->pool = pool;
+    atomic_fetch_add(&pool->pending, 1);
+    atomic_fetch_add(&executor.waiting[level], 1);
+
+    if ((self && html_work_queue_try_push(self->local[level], task))
+        || html_work_queue_try_push(executor.queues[level], task)) {
+        wake_worker();
+        return;
+    }
+
+    /* every queue is full, a worker parking on them could wait for itself */
+    if (self) {
+        atomic_fetch_sub(&executor.waiting[level], 1);
+        run_task(task);
+        return;
+    }
+
+    html_work_queue_push(executor.queues[level], task);
+    wake_worker();
+}
+
+int html_executor_submit(HTMLExecutorPool* pool, HTMLTaskFunc func, void* arg) {
+    html2tex_err_clear();
+
+    if (!pool || !func) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Executor pool or task function is NULL.");
+        return 0;
+    }
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    HTMLExecutorTask* task = (HTMLExecutorTask*)html2tex_malloc(sizeof(HTMLExecutorTask));
+    html2tex_allocator_leave(previous);
+
+    if (!task) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate an executor task.");
+        return 0;
+    }
+
+    task->run = func;
+    task->arg = arg;
+    task->owned = 1;
+
+    enqueue_task(pool, task);
+    return 1;
+}
+
+void html_executor_post(HTMLExecutorPool* pool, HTMLExecutorTask* task) {
+    if (!pool || !task || !task->run) return;
+
+    task->owned = 0;
+    enqueue_task(pool, task);
+}
+
+int html_executor_should_yield(const HTMLExecutorPool* pool) {
+    if (!pool || atomic_load(&executor.idle)) return 0;
+
+    for (size_t level = EXECUTOR_LEVEL(pool->priority); level < EXECUTOR_LEVELS; level++) {
+        if (atomic_load(&executor.waiting[level]))
+            return 1;
+    }
+
+    return 0;
+}
+
+size_t html_executor_pool_pending(const HTMLExecutorPool* pool) {
+    if (!pool) return 0;
+    return atomic_load(&((HTMLExecutorPool*)pool)->pending);
+}
+
+void html_executor_pool_destroy(HTMLExecutorPool* pool) {
+    if (!pool) return;
+    mutex_lock(&pool->mutex);
+
+    while (atomic_load(&pool->pending))
+        cond_wait(&pool->drained, &pool->mutex);
+
+    mutex_unlock(&pool->mutex);
+    mutex_destroy(&pool->mutex);
+    cond_destroy(&pool->drained);
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    html2tex_free(pool);
+    html2tex_allocator_leave(previous);
+
+    mutex_lock(&executor.mutex);
+
+    /* a worker cannot join itself, the next pool keeps using the running workers */
+    if (--executor.pools == 0 && !current_worker)
+        stop_workers();
+
+    mutex_unlock(&executor.mutex);
+}
@@ -0,0 +1,929 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "html2tex.h"
+#include "html_image_cache.h"
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#define stat _stat
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <linux/fs.h>
+#endif
+#endif
+
+#define CACHE_INDEX_HEADER "html2tex-image-cache 2"
+
+/* objects are named by the hex SHA-256 of their bytes */
+#define CACHE_DIGEST_HEX 64
+
+/* one cached URL, several entries may share a content object */
+typedef struct {
+    unsigned long long key;
+    char content[CACHE_DIGEST_HEX + 1];
+    unsigned long long size;
+    long long accessed;
+    long long validated;
+    long max_age;
+    char* etag;
+    char* last_modified;
+    char* url;
+} CacheEntry;
+
+struct HTMLImageCache {
+    char* dir;
+    unsigned long long max_bytes;
+
+    /* sorted by key then url, guarded by mutex */
+    mutex_t mutex;
+    CacheEntry* entries;
+    size_t count;
+    size_t capacity;
+    unsigned long long total_bytes;
+    int dirty;
+};
+
+static unsigned long long fnv1a_update(unsigned long long hash, const unsigned char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+static unsigned long long fnv1a(const char* text) {
+    return fnv1a_update(0xcbf29ce484222325ULL,
+        (const unsigned char*)text, strlen(text));
+}
+
+/* SHA-256 of object contents, a URL cannot pick the name another image is stored under */
+typedef struct {
+    uint32_t state[8];
+    unsigned long long length;
+    unsigned char block[64];
+    size_t used;
+} Sha256;
+
+static const uint32_t sha256_rounds[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sha256_init(Sha256* sha) {
+    static const uint32_t initial[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    memcpy(sha->state, initial, sizeof(initial));
+    sha->length = 0;
+    sha->used = 0;
+}
+
+static void sha256_block(Sha256* sha, const unsigned char* data) {
+    uint32_t w[64];
+
+    for (int i = 0; i < 16; i++)
+        w[i] = (uint32_t)data[i * 4] << 24 | (uint32_t)data[i * 4 + 1] << 16
+            | (uint32_t)data[i * 4 + 2] << 8 | (uint32_t)data[i * 4 + 3];
+
+    for (int i = 16; i < 64; i++) {
+        const uint32_t s0 = SHA256_ROTR(w[i - 15], 7) ^ SHA256_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        const uint32_t s1 = SHA256_ROTR(w[i - 2], 17) ^ SHA256_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+
+    uint32_t a = sha->state[0], b = sha->state[1], c = sha->state[2], d = sha->state[3];
+    uint32_t e = sha->state[4], f = sha->state[5], g = sha->state[6], h = sha->state[7];
+
+    for (int i = 0; i < 64; i++) {
+        const uint32_t t1 = h + (SHA256_ROTR(e, 6) ^ SHA256_ROTR(e, 11) ^ SHA256_ROTR(e, 25))
+            + ((e & f) ^ (~e & g)) + sha256_rounds[i] + w[i];
+        const uint32_t t2 = (SHA256_ROTR(a, 2) ^ SHA256_ROTR(a, 13) ^ SHA256_ROTR(a, 22))
+            + ((a & b) ^ (a & c) ^ (b & c));
+
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+
+    sha->state[0] += a; sha->state[1] += b; sha->state[2] += c; sha->state[3] += d;
+    sha->state[4] += e; sha->state[5] += f; sha->state[6] += g; sha->state[7] += h;
+}
+
+static void sha256_update(Sha256* sha, const unsigned char* data, size_t length) {
+    sha->length += length;
+
+    while (length > 0) {
+        size_t take = sizeof(sha->block) - sha->used;
+        if (take > length) take = length;
+
+        memcpy(sha->block + sha->used, data, take);
+        sha->used += take;
+        data += take;
+        length -= take;
+
+        if (sha->used == sizeof(sha->block)) {
+            sha256_block(sha, sha->block);
+            sha->used = 0;
+        }
+    }
+}
+
+/* pads the message and writes the digest as lowercase hex */
+static void sha256_final(Sha256* sha, char hex[CACHE_DIGEST_HEX + 1]) {
+    const unsigned long long bits = sha->length * 8;
+    unsigned char pad = 0x80;
+
+    sha256_update(sha, &pad, 1);
+    pad = 0;
+
+    while (sha->used != 56)
+        sha256_update(sha, &pad, 1);
+
+    for (int i = 7; i >= 0; i--) {
+        const unsigned char byte = (unsigned char)(bits >> (i * 8));
+        sha256_update(sha, &byte, 1);
+    }
+
+    for (int i = 0; i < 8; i++)
+        snprintf(hex + i * 8, 9, "%08x", (unsigned)sha->state[i]);
+}
+
+/* lowercases scheme and host, drops the default port and the fragment */
+static char* normalize_url(const char* url) {
+    const size_t length = strlen(url);
+    char* normalized = (char*)html2tex_malloc(length + 2);
+    if (!normalized) return NULL;
+
+    const char* scheme_end = strstr(url, "://");
+    size_t out = 0;
+
+    if (!scheme_end) {
+        memcpy(normalized, url, length + 1);
+        char* fragment = strchr(normalized, '#');
+
+        if (fragment) *fragment = '\0';
+        return normalized;
+    }
+
+    const char* p = url;
+
+    while (p < scheme_end)
+        normalized[out++] = (char)tolower((unsigned char)*p++);
+
+    memcpy(normalized + out, "://", 3);
+    out += 3;
+    p += 3;
+
+    const char* host = normalized + out;
+
+    while (*p && *p != '/' && *p != '?' && *p != '#')
+        normalized[out++] = (char)tolower((unsigned char)*p++);
+
+    normalized[out] = '\0';
+    const size_t scheme_len = (size_t)(scheme_end - url);
+    const char* port = strrchr(host, ':');
+    const char* bracket = strchr(host, ']');
+
+    /* a colon inside a bracketed IPv6 literal is not a port */
+    if (port && (!bracket || port > bracket)) {
+        if ((scheme_len == 4 && strcmp(port, ":80") == 0 && strncmp(normalized, "http", 4) == 0) ||
+            (scheme_len == 5 && strcmp(port, ":443") == 0 && strncmp(normalized, "https", 5) == 0))
+            out = (size_t)(port - normalized);
+    }
+
+    if (*p != '/') normalized[out++] = '/';
+
+    while (*p && *p != '#')
+        normalized[out++] = *p++;
+
+    normalized[out] = '\0';
+    return normalized;
+}
+
+static int compare_entry(unsigned long long key, const char* url, const CacheEntry* entry) {
+    if (key != entry->key) return key < entry->key ? -1 : 1;
+    return strcmp(url, entry->url);
+}
+
+/* binary search, *found tells whether index holds the url or its insertion point */
+static size_t find_entry(const HTMLImageCache* cache, unsigned long long key,
+    const char* url, int* found) {
+    size_t low = 0, high = cache->count;
+    *found = 0;
+
+    while (low < high) {
+        const size_t mid = low + (high - low) / 2;
+        const int cmp = compare_entry(key, url, &cache->entries[mid]);
+
+        if (cmp == 0) {
+            *found = 1;
+            return mid;
+        }
+
+        if (cmp < 0) high = mid;
+        else low = mid + 1;
+    }
+
+    return low;
+}
+
+static void free_entry(CacheEntry* entry) {
+    html2tex_free(entry->etag);
+    html2tex_free(entry->last_modified);
+    html2tex_free(entry->url);
+}
+
+static char* object_path(const HTMLImageCache* cache, const char* content) {
+    const size_t length = strlen(cache->dir) + CACHE_DIGEST_HEX + 16;
+    char* path = (char*)html2tex_malloc(length);
+
+    if (path) snprintf(path, length, "%s/objects/%s", cache->dir, content);
+    return path;
+}
+
+static int content_shared(const HTMLImageCache* cache, size_t index) {
+    for (size_t i = 0; i < cache->count; i++) {
+        if (i != index && strcmp(cache->entries[i].content, cache->entries[index].content) == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+/* drops an entry and, unless kept, its object once no other entry refers to it */
+static void remove_entry(HTMLImageCache* cache, size_t index, int keep_object) {
+    CacheEntry* entry = &cache->entries[index];
+
+    if (!keep_object && !content_shared(cache, index)) {
+        char* path = object_path(cache, entry->content);
+
+        if (path) {
+            remove(path);
+            html2tex_free(path);
+        }
+    }
+
+    cache->total_bytes -= entry->size;
+    free_entry(entry);
+
+    memmove(entry, entry + 1, (cache->count - index - 1) * sizeof(CacheEntry));
+    cache->count--;
+    cache->dirty = 1;
+}
+
+/* evicts least recently used entries, sparing the key just stored */
+static void evict(HTMLImageCache* cache, unsigned long long keep) {
+    while (cache->total_bytes > cache->max_bytes && cache->count > 1) {
+        size_t oldest = cache->count;
+
+        for (size_t i = 0; i < cache->count; i++) {
+            if (cache->entries[i].key == keep) continue;
+
+            if (oldest == cache->count || cache->entries[i].accessed < cache->entries[oldest].accessed)
+                oldest = i;
+        }
+
+        if (oldest == cache->count) break;
+        remove_entry(cache, oldest, 0);
+    }
+}
+
+static int insert_entry(HTMLImageCache* cache, size_t index, const CacheEntry* entry) {
+    if (cache->count == cache->capacity) {
+        const size_t capacity = cache->capacity ? cache->capacity * 2 : 64;
+        CacheEntry* entries = (CacheEntry*)html2tex_realloc(cache->entries,
+            capacity * sizeof(CacheEntry));
+
+        if (!entries) return 0;
+        cache->entries = entries;
+        cache->capacity = capacity;
+    }
+
+    memmove(&cache->entries[index + 1], &cache->entries[index],
+        (cache->count - index) * sizeof(CacheEntry));
+
+    cache->entries[index] = *entry;
+    cache->count++;
+    cache->total_bytes += entry->size;
+    cache->dirty = 1;
+    return 1;
+}
+
+static char* copy_field(const char* text) {
+    const size_t length = strlen(text) + 1;
+    char* copy = (char*)html2tex_malloc(length);
+
+    if (copy) memcpy(copy, text, length);
+    return copy;
+}
+
+/* splits a tab separated index line in place */
+static int split_fields(char* line, char** fields, int count) {
+    for (int i = 0; i < count; i++) {
+        fields[i] = line;
+
+        if (i == count - 1) break;
+        line = strchr(line, '\t');
+
+        if (!line) return 0;
+        *line++ = '\0';
+    }
+
+    return 1;
+}
+
+static void load_index(HTMLImageCache* cache, const char* index_path) {
+    HTMLMappedFile* file = html_mapped_file_open(index_path);
+
+    /* a missing index is an empty cache */
+    if (!file) {
+        html2tex_err_clear();
+        return;
+    }
+
+    const size_t length = html_mapped_file_length(file);
+    char* text = (char*)html2tex_malloc(length + 1);
+
+    if (!text) {
+        html_mapped_file_close(file);
+        return;
+    }
+
+    memcpy(text, html_mapped_file_data(file), length);
+    text[length] = '\0';
+    html_mapped_file_close(file);
+
+    char* line = text;
+    char* next = strchr(line, '\n');
+
+    if (!next || strncmp(line, CACHE_INDEX_HEADER "\n", sizeof(CACHE_INDEX_HEADER)) != 0) {
+        html2tex_free(text);
+        return;
+    }
+
+    for (line = next + 1; *line; line = next) {
+        char* fields[8];
+        next = strchr(line, '\n');
+
+        if (!next) break;
+        *next++ = '\0';
+
+        if (!split_fields(line, fields, 8) || !fields[7][0]) continue;
+
+        /* an object name that is not a digest would escape the objects directory */
+        if (strlen(fields[0]) != CACHE_DIGEST_HEX
+            || strspn(fields[0], "0123456789abcdef") != CACHE_DIGEST_HEX) continue;
+
+        CacheEntry entry;
+        memcpy(entry.content, fields[0], CACHE_DIGEST_HEX + 1);
+        entry.size = strtoull(fields[1], NULL, 10);
+        entry.accessed = strtoll(fields[2], NULL, 10);
+        entry.validated = strtoll(fields[3], NULL, 10);
+        entry.max_age = strtol(fields[4], NULL, 10);
+        entry.key = fnv1a(fields[7]);
+
+        int found = 0;
+        const size_t index = find_entry(cache, entry.key, fields[7], &found);
+        if (found) continue;
+
+        entry.etag = copy_field(fields[5]);
+        entry.last_modified = copy_field(fields[6]);
+        entry.url = copy_field(fields[7]);
+
+        if (!entry.etag || !entry.last_modified || !entry.url || !insert_entry(cache, index, &entry))
+            free_entry(&entry);
+    }
+
+    html2tex_free(text);
+    cache->dirty = 0;
+}
+
+static char* join_path(const char* dir, const char* name) {
+    const size_t length = strlen(dir) + strlen(name) + 2;
+    char* path = (char*)html2tex_malloc(length);
+
+    if (path) snprintf(path, length, "%s/%s", dir, name);
+    return path;
+}
+
+HTMLImageCache* html_image_cache_open(const char* dir, unsigned long long max_bytes) {
+    html2tex_err_clear();
+
+    if (!dir || !dir[0]) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image cache directory is NULL or empty.");
+        return NULL;
+    }
+
+    /* loop threads release what is allocated here, keep it on the process allocator */
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    HTMLImageCache* cache = (HTMLImageCache*)html2tex_calloc(1, sizeof(HTMLImageCache));
+    char* objects = NULL;
+
+    if (cache) {
+        cache->dir = copy_field(dir);
+        size_t dir_len = cache->dir ? strlen(cache->dir) : 0;
+
+        /* paths are joined with a separator of their own */
+        while (dir_len > 1 && (cache->dir[dir_len - 1] == '/' || cache->dir[dir_len - 1] == '\\'))
+            cache->dir[--dir_len] = '\0';
+
+        objects = cache->dir ? join_path(cache->dir, "objects") : NULL;
+    }
+
+    if (!cache || !cache->dir || !objects) {
+        if (cache) html2tex_free(cache->dir);
+        html2tex_free(cache);
+        html2tex_allocator_leave(previous);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the image cache.");
+        return NULL;
+    }
+
+    if (create_directory_if_not_exists(objects) != 0) {
+        html2tex_free(objects);
+        html2tex_free(cache->dir);
+        html2tex_free(cache);
+        html2tex_allocator_leave(previous);
+        return NULL;
+    }
+
+    html2tex_free(objects);
+    cache->max_bytes = max_bytes ? max_bytes : HTML_IMAGE_CACHE_MAX_BYTES;
+    mutex_init(&cache->mutex);
+
+    char* index_path = join_path(cache->dir, "index");
+
+    if (index_path) {
+        load_index(cache, index_path);
+        html2tex_free(index_path);
+    }
+
+    /* a smaller bound than the last run applies at once */
+    evict(cache, 0);
+
+    html2tex_allocator_leave(previous);
+    html2tex_err_clear();
+    return cache;
+}
+
+HTMLCacheState html_image_cache_lookup(HTMLImageCache* cache, const char* url,
+    HTMLCacheValidators* validators) {
+    if (!cache || !url) return HTML_CACHE_MISS;
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    char* normalized = normalize_url(url);
+    html2tex_allocator_leave(previous);
+
+    if (!normalized) return HTML_CACHE_MISS;
+
+    HTMLCacheState state = HTML_CACHE_MISS;
+    int found = 0;
+
+    mutex_lock(&cache->mutex);
+    const size_t index = find_entry(cache, fnv1a(normalized), normalized, &found);
+
+    if (found) {
+        const CacheEntry* entry = &cache->entries[index];
+        const long lifetime = entry->max_age >= 0 ? entry->max_age : HTML_IMAGE_CACHE_FRESHNESS;
+
+        state = (long long)time(NULL) - entry->validated < lifetime
+            ? HTML_CACHE_FRESH : HTML_CACHE_STALE;
+
+        if (validators) {
+            snprintf(validators->etag, sizeof(validators->etag), "%s", entry->etag);
+            snprintf(validators->last_modified, sizeof(validators->last_modified),
+                "%s", entry->last_modified);
+            validators->max_age = entry->max_age;
+            validators->no_store = 0;
+        }
+    }
+
+    mutex_unlock(&cache->mutex);
+    html2tex_free(normalized);
+    return state;
+}
+
+/* streams src into dest, dest is created or truncated */
+static int copy_file(const char* src, const char* dest) {
+    FILE* in = fopen(src, "rb");
+    if (!in) return 0;
+
+    FILE* out = fopen(dest, "wb");
+
+    if (!out) {
+        fclose(in);
+        return 0;
+    }
+
+    char buffer[65536];
+    size_t read_count;
+    int success = 1;
+
+    while ((read_count = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        if (fwrite(buffer, 1, read_count, out) != read_count) {
+            success = 0;
+            break;
+        }
+    }
+
+    if (ferror(in)) success = 0;
+    fclose(in);
+
+    if (fclose(out) != 0) success = 0;
+    if (!success) remove(dest);
+
+    return success;
+}
+
+/* hardlink, then reflink, then a plain copy */
+static int place_file(const char* src, const char* dest) {
+#ifdef _WIN32
+    if (CreateHardLinkA(dest, src, NULL)) return 1;
+    if (CopyFileA(src, dest, FALSE)) return 1;
+    return copy_file(src, dest);
+#else
+    if (link(src, dest) == 0) return 1;
+
+#if defined(FICLONE)
+    int in = open(src, O_RDONLY);
+
+    if (in >= 0) {
+        int out = open(dest, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (out >= 0) {
+            const int cloned = ioctl(out, FICLONE, in) == 0;
+            close(out);
+            close(in);
+
+            if (cloned) return 1;
+            remove(dest);
+        }
+        else
+            close(in);
+    }
+#endif
+
+    return copy_file(src, dest);
+#endif
+}
+
+int html_image_cache_materialize(HTMLImageCache* cache, const char* url, const char* dest) {
+    html2tex_err_clear();
+
+    if (!cache || !url || !dest) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image cache, URL or destination is NULL.");
+        return 0;
+    }
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    char* normalized = normalize_url(url);
+    char* source = NULL;
+    int found = 0;
+
+    if (normalized) {
+        mutex_lock(&cache->mutex);
+        const size_t index = find_entry(cache, fnv1a(normalized), normalized, &found);
+
+        if (found) {
+            cache->entries[index].accessed = (long long)time(NULL);
+            cache->dirty = 1;
+            source = object_path(cache, cache->entries[index].content);
+        }
+
+        mutex_unlock(&cache->mutex);
+        html2tex_free(normalized);
+    }
+
+    html2tex_allocator_leave(previous);
+
+    if (!source) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_IMAGE_DOWNLOAD,
+            "Image '%s' is not cached.", url);
+        return 0;
+    }
+
+    /* replacing keeps a linked object from being truncated through dest */
+    remove(dest);
+
+    if (!place_file(source, dest)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to materialize cached image '%s' at '%s': %s.",
+            url, dest, strerror(errno));
+        html2tex_free(source);
+        return 0;
+    }
+
+    html2tex_free(source);
+    return 1;
+}
+
+static int hash_file(const char* path, char content[CACHE_DIGEST_HEX + 1], unsigned long long* size) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return 0;
+
+    unsigned char buffer[65536];
+    Sha256 sha;
+    size_t read_count;
+
+    sha256_init(&sha);
+    *size = 0;
+
+    while ((read_count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        sha256_update(&sha, buffer, read_count);
+        *size += read_count;
+    }
+
+    const int success = !ferror(file);
+    fclose(file);
+
+    sha256_final(&sha, content);
+    return success;
+}
+
+/* creates the content object from a downloaded file unless it exists */
+static int store_object(const char* object,
+    const char* path, unsigned long long key) {
+    struct stat info;
+    if (stat(object, &info) == 0) return 1;
+
+#ifndef _WIN32
+    if (link(path, object) == 0 || errno == EEXIST) return 1;
+#endif
+
+    /* copies land under a private name so readers never see a partial object */
+    const size_t length = strlen(object) + 24;
+    char* temp = (char*)html2tex_malloc(length);
+    if (!temp) return 0;
+
+    snprintf(temp, length, "%s.%016llx", object, key);
+
+    int success = copy_file(path, temp);
+
+    if (success && rename(temp, object) != 0) {
+        success = stat(object, &info) == 0;
+        remove(temp);
+    }
+
+    html2tex_free(temp);
+    return success;
+}
+
+static int cacheable_text(const char* text) {
+    return strpbrk(text, "\t\r\n") == NULL;
+}
+
+int html_image_cache_store(HTMLImageCache* cache, const char* url,
+    const char* path, const HTMLCacheValidators* validators) {
+    html2tex_err_clear();
+
+    if (!cache || !url || !path) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image cache, URL or path is NULL.");
+        return 0;
+    }
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    char* normalized = normalize_url(url);
+
+    if (!normalized) {
+        html2tex_allocator_leave(previous);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate cache key of '%s'.", url);
+        return 0;
+    }
+
+    const unsigned long long key = fnv1a(normalized);
+    int found = 0;
+
+    /* no-store also drops what an earlier response left behind */
+    if ((validators && validators->no_store) || !cacheable_text(normalized)) {
+        mutex_lock(&cache->mutex);
+        const size_t index = find_entry(cache, key, normalized, &found);
+
+        if (found) remove_entry(cache, index, 0);
+        mutex_unlock(&cache->mutex);
+
+        html2tex_free(normalized);
+        html2tex_allocator_leave(previous);
+        return 1;
+    }
+
+    char content[CACHE_DIGEST_HEX + 1];
+    unsigned long long size = 0;
+
+    if (!hash_file(path, content, &size)) {
+        html2tex_free(normalized);
+        html2tex_allocator_leave(previous);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_READ,
+            "Failed to read downloaded image '%s'.", path);
+        return 0;
+    }
+
+    if (size > cache->max_bytes) {
+        html2tex_free(normalized);
+        html2tex_allocator_leave(previous);
+        return 1;
+    }
+
+    char* object = object_path(cache, content);
+
+    if (!object || !store_object(object, path, key)) {
+        html2tex_free(object);
+        html2tex_free(normalized);
+        html2tex_allocator_leave(previous);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_WRITE,
+            "Failed to store image '%s' in the cache.", url);
+        return 0;
+    }
+
+    html2tex_free(object);
+
+    const char* etag = validators && cacheable_text(validators->etag) ? validators->etag : "";
+    const char* last_modified = validators && cacheable_text(validators->last_modified)
+        ? validators->last_modified : "";
+
+    CacheEntry entry;
+    entry.key = key;
+    memcpy(entry.content, content, sizeof(entry.content));
+    entry.size = size;
+    entry.accessed = entry.validated = (long long)time(NULL);
+    entry.max_age = validators ? validators->max_age : -1;
+    entry.etag = copy_field(etag);
+    entry.last_modified = copy_field(last_modified);
+    entry.url = normalized;
+
+    int success = entry.etag && entry.last_modified;
+    mutex_lock(&cache->mutex);
+
+    if (success) {
+        size_t index = find_entry(cache, key, normalized, &found);
+
+        /* unchanged content keeps its object, the entry is replaced in place */
+        if (found) remove_entry(cache, index,
+            strcmp(cache->entries[index].content, content) == 0);
+
+        success = insert_entry(cache, index, &entry);
+        if (success) evict(cache, key);
+    }
+
+    mutex_unlock(&cache->mutex);
+
+    if (!success) {
+        free_entry(&entry);
+        html2tex_allocator_leave(previous);
+
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to record image '%s' in the cache.", url);
+        return 0;
+    }
+
+    html2tex_allocator_leave(previous);
+    return 1;
+}
+
+int html_image_cache_refresh(HTMLImageCache* cache, const char* url,
+    const HTMLCacheValidators* validators) {
+    if (!cache || !url) return 0;
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    char* normalized = normalize_url(url);
+    int found = 0;
+
+    if (normalized) {
+        mutex_lock(&cache->mutex);
+        const size_t index = find_entry(cache, fnv1a(normalized), normalized, &found);
+
+        if (found) {
+            CacheEntry* entry = &cache->entries[index];
+            entry->accessed = entry->validated = (long long)time(NULL);
+
+            if (validators) {
+                if (validators->etag[0] && cacheable_text(validators->etag)) {
+                    char* etag = copy_field(validators->etag);
+
+                    if (etag) {
+                        html2tex_free(entry->etag);
+                        entry->etag = etag;
+                    }
+                }
+
+                if (validators->last_modified[0] && cacheable_text(validators->last_modified)) {
+                    char* last_modified = copy_field(validators->last_modified);
+
+                    if (last_modified) {
+                        html2tex_free(entry->last_modified);
+                        entry->last_modified = last_modified;
+                    }
+                }
+
+                entry->max_age = validators->max_age;
+            }
+
+            cache->dirty = 1;
+        }
+
+        mutex_unlock(&cache->mutex);
+        html2tex_free(normalized);
+    }
+
+    html2tex_allocator_leave(previous);
+    return found;
+}
+
+int html_image_cache_flush(HTMLImageCache* cache) {
+    if (!cache) return 1;
+
+    mutex_lock(&cache->mutex);
+
+    if (!cache->dirty) {
+        mutex_unlock(&cache->mutex);
+        return 1;
+    }
+
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+    char* index_path = join_path(cache->dir, "index");
+    char* temp_path = join_path(cache->dir, "index.tmp");
+    html2tex_allocator_leave(previous);
+
+    FILE* file = index_path && temp_path ? fopen(temp_path, "wb") : NULL;
+
+    if (!file) {
+        mutex_unlock(&cache->mutex);
+        html2tex_free(index_path);
+        html2tex_free(temp_path);
+        return 0;
+    }
+
+    int success = fprintf(file, "%s\n", CACHE_INDEX_HEADER) > 0;
+
+    for (size_t i = 0; success && i < cache->count; i++) {
+        const CacheEntry* entry = &cache->entries[i];
+
+        success = fprintf(file, "%s\t%llu\t%lld\t%lld\t%ld\t%s\t%s\t%s\n",
+            entry->content, entry->size, entry->accessed, entry->validated,
+            entry->max_age, entry->etag, entry->last_modified, entry->url) > 0;
+    }
+
+    if (fclose(file) != 0) success = 0;
+
+#ifdef _WIN32
+    /* rename does not replace an existing file on Windows */
+    if (success) remove(index_path);
+#endif
+
+    /* the rename swaps the whole index at once, a crash keeps the old one */
+    if (success && rename(temp_path, index_path) != 0) success = 0;
+    if (success) cache->dirty = 0;
+    else remove(temp_path);
+
+    mutex_unlock(&cache->mutex);
+    html2tex_free(index_path);
+    html2tex_free(temp_path);
+    return success;
+}
+
+void html_image_cache_close(HTMLImageCache* cache) {
+    if (!cache) return;
+
+    html_image_cache_flush(cache);
+    const HTML2TeXAllocator* previous = html2tex_allocator_enter(NULL);
+
+    for (size_t i = 0; i < cache->count; i++)
+        free_entry(&cache->entries[i]);
+
+    html2tex_free(cache->entries);
+    html2tex_free(cache->dir);
+    mutex_destroy(&cache->mutex);
+
+    html2tex_free(cache);
+    html2tex_allocator_leave(previous);
+}
@@ -0,0 +1,149 @@
+#include "html2tex.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+struct HTMLMappedFile {
+    const char* data;
+    size_t length;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+HTMLMappedFile* html_mapped_file_open(const char* path) {
+    html2tex_err_clear();
+
+    if (!path) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "File path is NULL for mapping.");
+        return NULL;
+    }
+
+    HTMLMappedFile* mapped = (HTMLMappedFile*)html2tex_calloc(1, sizeof(HTMLMappedFile));
+
+    if (!mapped) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the mapped file handle.");
+        return NULL;
+    }
+
+    /* empty files cannot be mapped, they read as an empty buffer */
+    mapped->data = "";
+
+#ifdef _WIN32
+    LARGE_INTEGER size;
+
+    mapped->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    mapped->mapping = NULL;
+
+    if (mapped->file == INVALID_HANDLE_VALUE) {
+        html2tex_free(mapped);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open file '%s' for mapping.", path);
+        return NULL;
+    }
+
+    if (!GetFileSizeEx(mapped->file, &size) || (unsigned long long)size.QuadPart > (size_t)-1) {
+        CloseHandle(mapped->file);
+        html2tex_free(mapped);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_READ,
+            "Failed to get the size of file '%s'.", path);
+        return NULL;
+    }
+
+    mapped->length = (size_t)size.QuadPart;
+    if (!mapped->length) return mapped;
+
+    mapped->mapping = CreateFileMappingA(mapped->file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mapped->mapping
+        ? MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+    if (!view) {
+        if (mapped->mapping) CloseHandle(mapped->mapping);
+        CloseHandle(mapped->file);
+        html2tex_free(mapped);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_READ,
+            "Failed to map file '%s'.", path);
+        return NULL;
+    }
+
+    mapped->data = (const char*)view;
+#else
+    struct stat info;
+    const int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        html2tex_free(mapped);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_OPEN,
+            "Failed to open file '%s' for mapping.", path);
+        return NULL;
+    }
+
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)
+        || (unsigned long long)info.st_size > (size_t)-1) {
+        close(fd);
+        html2tex_free(mapped);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_READ,
+            "File '%s' is not a regular file that can be mapped.", path);
+        return NULL;
+    }
+
+    mapped->length = (size_t)info.st_size;
+
+    if (mapped->length) {
+        void* view = mmap(NULL, mapped->length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (view == MAP_FAILED) {
+            close(fd);
+            html2tex_free(mapped);
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_FILE_READ,
+                "Failed to map file '%s'.", path);
+            return NULL;
+        }
+
+#ifdef MADV_SEQUENTIAL
+        /* the parser walks the input once front to back */
+        madvise(view, mapped->length, MADV_SEQUENTIAL);
+#endif
+        mapped->data = (const char*)view;
+    }
+
+    /* the mapping stays valid after the descriptor is closed */
+    close(fd);
+#endif
+
+    return mapped;
+}
+
+const char* html_mapped_file_data(const HTMLMappedFile* file) {
+    return file ? file->data : NULL;
+}
+
+size_t html_mapped_file_length(const HTMLMappedFile* file) {
+    return file ? file->length : 0;
+}
+
+void html_mapped_file_close(HTMLMappedFile* file) {
+    if (!file) return;
+
+#ifdef _WIN32
+    if (file->length) UnmapViewOfFile(file->data);
+    if (file->mapping) CloseHandle(file->mapping);
+    CloseHandle(file->file);
+#else
+    if (file->length) munmap((void*)file->data, file->length);
+#endif
+
+    html2tex_free(file);
+}
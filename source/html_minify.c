@@ -31,7 +31,7 @@ static char* minify_text_content(const char* text, int is_in_preformatted) {
 
     /* preformatted content (copy as-is) */
     if (is_in_preformatted) {
-        char* result = strdup(text);
+        char* result = html2tex_strdup(text);
         if (!result) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to duplicate preformatted text.");
@@ -54,7 +54,7 @@ static char* minify_text_content(const char* text, int is_in_preformatted) {
             return NULL;
 
         /* non-whitespace single char found */
-        char* result = (char*)malloc(2);
+        char* result = (char*)html2tex_malloc(2);
         if (!result) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate single character buffer.");
@@ -103,7 +103,7 @@ static char* minify_text_content(const char* text, int is_in_preformatted) {
     /* no whitespace at all */
     if (final_size == (size_t)(scan - src)) {
         /* just copy the string */
-        char* result = (char*)malloc(final_size + 1);
+        char* result = (char*)html2tex_malloc(final_size + 1);
         if (!result) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate text copy buffer.");
@@ -116,7 +116,7 @@ static char* minify_text_content(const char* text, int is_in_preformatted) {
     }
 
     /* alloc exact size needed */
-    char* result = (char*)malloc(final_size + 1);
+    char* result = (char*)html2tex_malloc(final_size + 1);
 
     if (!result) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -165,7 +165,7 @@ static char* minify_attribute_value(const char* value) {
 
     /* empty string */
     if (*value == '\0') {
-        char* r = (char*)malloc(3);
+        char* r = (char*)html2tex_malloc(3);
         if (!r) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate empty attribute"
@@ -179,7 +179,7 @@ static char* minify_attribute_value(const char* value) {
     }
 
     /* return the exact copy */
-    char* result = strdup(value);
+    char* result = html2tex_strdup(value);
 
     if (!result) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -194,7 +194,7 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
     /* clear any previous error state */
     html2tex_err_clear();
     if (!node) return NULL;
-    HTMLNode* new_node = malloc(sizeof(HTMLNode));
+    HTMLNode* new_node = html2tex_malloc(sizeof(HTMLNode));
 
     if (!new_node) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -204,17 +204,18 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
     }
 
     /* copy the DOM structure */
-    new_node->tag = node->tag ? strdup(node->tag) : NULL;
+    new_node->tag = node->tag ? html2tex_strdup(node->tag) : NULL;
     new_node->parent = NULL;
     new_node->next = NULL;
     new_node->children = NULL;
+    new_node->attributes = NULL;
 
     /* validate tag duplication */
     if (node->tag && !new_node->tag) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to duplicate tag string "
             "during minification.");
-        free(new_node);
+        html2tex_free(new_node);
         return NULL;
     }
 
@@ -229,7 +230,7 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
     HTMLAttribute* old_attr = node->attributes;
 
     while (old_attr) {
-        HTMLAttribute* new_attr = (HTMLAttribute*)malloc(sizeof(HTMLAttribute));
+        HTMLAttribute* new_attr = (HTMLAttribute*)html2tex_malloc(sizeof(HTMLAttribute));
         if (!new_attr) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate HTMLAttribute"
@@ -238,7 +239,7 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
             return NULL;
         }
 
-        new_attr->key = strdup(old_attr->key);
+        new_attr->key = html2tex_strdup(old_attr->key);
         if (old_attr->value) new_attr->value = minify_attribute_value(old_attr->value);
         else new_attr->value = NULL;
 
@@ -247,7 +248,7 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to duplicate attribute "
                 "key during minification.");
-            free(new_attr);
+            html2tex_free(new_attr);
             html2tex_free_node(new_node);
             return NULL;
         }
@@ -259,6 +260,7 @@ static HTMLNode* minify_node(HTMLNode* node, int in_preformatted) {
     }
 
     new_node->attributes = new_attrs;
+    html2tex_index_attributes(new_node);
 
     /* minify content */
     if (node->content) {
@@ -343,7 +345,7 @@ HTMLNode* html2tex_minify_html(const HTMLNode* root) {
     }
 
     /* create a new minified tree */
-    HTMLNode* minified_root = (HTMLNode*)malloc(sizeof(HTMLNode));
+    HTMLNode* minified_root = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
     if (!minified_root) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate minified root HTMLNode.");
@@ -355,6 +357,7 @@ HTMLNode* html2tex_minify_html(const HTMLNode* root) {
     minified_root->attributes = NULL;
     minified_root->parent = NULL;
     minified_root->next = NULL;
+    html2tex_index_attributes(minified_root);
 
     /* minify children */
     HTMLNode* new_children = NULL;
@@ -8,6 +8,9 @@ typedef struct {
     const char* input;
     size_t position;
     size_t length;
+
+    /* NULL for UTF-8 input, else the map text and attribute bytes go through */
+    const unsigned short* charset_map;
 } ParserState;
 
 static void skip_whitespace(ParserState* state) {
@@ -56,7 +59,7 @@ static char* parse_tag_name(ParserState* state) {
 
     size_t tag_len = pos - start;
 
-    char* name = (char*)malloc(tag_len + 1);
+    char* name = (char*)html2tex_malloc(tag_len + 1);
     if (!name) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate tag name buffer.");
@@ -102,9 +105,15 @@ static char* parse_quoted_string(ParserState* state) {
     /* skip opening quote */
     const size_t start = ++pos;
 
-    /* scan for closing quote */
-    while (pos < length && input[pos] != quote)
+    /* scan for closing quote, noting references and bytes to transcode */
+    const int transcode = state->charset_map != NULL;
+    int has_reference = 0, has_high = 0;
+
+    while (pos < length && input[pos] != quote) {
+        if (input[pos] == '&') has_reference = 1;
+        else if ((unsigned char)input[pos] >= 0x80) has_high = transcode;
         pos++;
+    }
 
     /* validate we found the quote */
     if (pos >= length) {
@@ -113,9 +122,10 @@ static char* parse_quoted_string(ParserState* state) {
         return NULL;
     }
 
-    /* allocate and copy */
+    /* allocate and copy, decoding only when a reference is present */
     const size_t str_len = pos - start;
-    char* str = (char*)malloc(str_len + 1);
+    char* str = (char*)html2tex_malloc(has_high ? HTML_TRANSCODED_CAPACITY(str_len)
+        : has_reference ? HTML_DECODED_CAPACITY(str_len) : str_len + 1);
 
     if (!str) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -123,11 +133,17 @@ static char* parse_quoted_string(ParserState* state) {
         return NULL;
     }
 
-    if (str_len > 0)
-        memcpy(str, input + start, str_len);
+    if (has_reference)
+        html_decode_entities(input + start, str_len, str, 1, state->charset_map);
+    else if (has_high)
+        str[html_charset_transcode(input + start, str_len, str, state->charset_map)] = '\0';
+    else {
+        if (str_len > 0)
+            memcpy(str, input + start, str_len);
+        str[str_len] = '\0';
+    }
 
     /* skip closing quote */
-    str[str_len] = '\0';
     state->position = pos + 1;
     return str;
 }
@@ -186,7 +202,7 @@ static HTMLAttribute* parse_attributes(ParserState* state) {
 
             /* cleanup on parse failure */
             if (!value) {
-                free(key);
+                html2tex_free(key);
                 break;
             }
 
@@ -194,14 +210,14 @@ static HTMLAttribute* parse_attributes(ParserState* state) {
         }
 
         /* allocate and link attribute */
-        HTMLAttribute* attr = (HTMLAttribute*)malloc(sizeof(HTMLAttribute));
+        HTMLAttribute* attr = (HTMLAttribute*)html2tex_malloc(sizeof(HTMLAttribute));
 
         if (!attr) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate HTMLAttribute"
                 " structure.");
-            free(key);
-            if (value) free(value);
+            html2tex_free(key);
+            if (value) html2tex_free(value);
             break;
         }
 
@@ -217,7 +233,7 @@ static HTMLAttribute* parse_attributes(ParserState* state) {
     return head;
 }
 
-static char* parse_text_content(ParserState* state) {
+static char* parse_text_content(ParserState* state, int decode) {
     /* clear any previous error state */
     html2tex_err_clear();
 
@@ -236,13 +252,20 @@ static char* parse_text_content(ParserState* state) {
     const char* current = start_ptr;
     const char* const end = input + length;
 
-    /* scan for tag beginning */
-    while (current < end && *current != '<')
+    /* scan for tag beginning, noting references and bytes to transcode */
+    const int transcode = state->charset_map != NULL;
+    int has_reference = 0, has_high = 0;
+
+    while (current < end && *current != '<') {
+        if (*current == '&') has_reference = decode;
+        else if ((unsigned char)*current >= 0x80) has_high = transcode;
         current++;
+    }
 
     size_t text_len = (size_t)(current - start_ptr);
     if (text_len == 0) return NULL;
-    char* text = (char*)malloc(text_len + 1);
+    char* text = (char*)html2tex_malloc(has_high ? HTML_TRANSCODED_CAPACITY(text_len)
+        : has_reference ? HTML_DECODED_CAPACITY(text_len) : text_len + 1);
 
     if (!text) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -250,31 +273,274 @@ static char* parse_text_content(ParserState* state) {
         return NULL;
     }
 
-    memcpy(text, start_ptr, text_len);
-    text[text_len] = '\0';
+    if (has_reference)
+        html_decode_entities(start_ptr, text_len, text, 0, state->charset_map);
+    else if (has_high)
+        text[html_charset_transcode(start_ptr, text_len, text, state->charset_map)] = '\0';
+    else {
+        memcpy(text, start_ptr, text_len);
+        text[text_len] = '\0';
+    }
+
     state->position = (size_t)(current - input);
     return text;
 }
 
-static HTMLNode* parse_element(ParserState* state);
+/* tag groups driving the implied end tag and raw text rules */
+enum {
+    TAG_GROUP_P = 1 << 0,
+    TAG_GROUP_HEADING = 1 << 1,
+    TAG_GROUP_LI = 1 << 2,
+    TAG_GROUP_DT_DD = 1 << 3,
+    TAG_GROUP_LIST = 1 << 4,
+    TAG_GROUP_DL = 1 << 5,
+    TAG_GROUP_TABLE = 1 << 6,
+    TAG_GROUP_TABLE_SECTION = 1 << 7,
+    TAG_GROUP_TABLE_ROW = 1 << 8,
+    TAG_GROUP_TABLE_CELL = 1 << 9,
+    TAG_GROUP_CAPTION = 1 << 10,
+    TAG_GROUP_OPTION = 1 << 11,
+    TAG_GROUP_OPTGROUP = 1 << 12,
+    TAG_GROUP_SELECT = 1 << 13,
+    TAG_GROUP_SCOPE = 1 << 14,
+    TAG_GROUP_CLOSES_P = 1 << 15,
+    TAG_GROUP_RAW_TEXT = 1 << 16
+};
+
+/* elements an end tag or implied end never searches past */
+#define TAG_GROUP_BOUNDARY (TAG_GROUP_TABLE | TAG_GROUP_TABLE_CELL \
+    | TAG_GROUP_CAPTION | TAG_GROUP_SCOPE)
+
+#define TAG_GROUP_TABLE_PART (TAG_GROUP_TABLE | TAG_GROUP_TABLE_SECTION \
+    | TAG_GROUP_TABLE_ROW | TAG_GROUP_TABLE_CELL | TAG_GROUP_CAPTION)
 
-static HTMLNode* parse_node(ParserState* state) {
-    /* clear any previous error state */
-    html2tex_err_clear();
+typedef struct {
+    const char* tag;
+    unsigned int group;
+} TagGroup;
+
+/* sorted by tag for bsearch */
+static const TagGroup TAG_GROUPS[] = {
+    {"address", TAG_GROUP_CLOSES_P}, {"applet", TAG_GROUP_SCOPE},
+    {"article", TAG_GROUP_CLOSES_P}, {"aside", TAG_GROUP_CLOSES_P},
+    {"blockquote", TAG_GROUP_CLOSES_P}, {"button", TAG_GROUP_SCOPE},
+    {"caption", TAG_GROUP_CAPTION}, {"center", TAG_GROUP_CLOSES_P},
+    {"dd", TAG_GROUP_DT_DD | TAG_GROUP_CLOSES_P}, {"details", TAG_GROUP_CLOSES_P},
+    {"dialog", TAG_GROUP_CLOSES_P}, {"dir", TAG_GROUP_LIST | TAG_GROUP_CLOSES_P},
+    {"div", TAG_GROUP_CLOSES_P}, {"dl", TAG_GROUP_DL | TAG_GROUP_CLOSES_P},
+    {"dt", TAG_GROUP_DT_DD | TAG_GROUP_CLOSES_P}, {"fieldset", TAG_GROUP_CLOSES_P},
+    {"figcaption", TAG_GROUP_CLOSES_P}, {"figure", TAG_GROUP_CLOSES_P},
+    {"footer", TAG_GROUP_CLOSES_P}, {"form", TAG_GROUP_CLOSES_P},
+    {"h1", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P}, {"h2", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P},
+    {"h3", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P}, {"h4", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P},
+    {"h5", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P}, {"h6", TAG_GROUP_HEADING | TAG_GROUP_CLOSES_P},
+    {"header", TAG_GROUP_CLOSES_P}, {"hgroup", TAG_GROUP_CLOSES_P},
+    {"hr", TAG_GROUP_CLOSES_P}, {"html", TAG_GROUP_SCOPE},
+    {"li", TAG_GROUP_LI | TAG_GROUP_CLOSES_P}, {"main", TAG_GROUP_CLOSES_P},
+    {"marquee", TAG_GROUP_SCOPE}, {"menu", TAG_GROUP_LIST | TAG_GROUP_CLOSES_P},
+    {"nav", TAG_GROUP_CLOSES_P}, {"object", TAG_GROUP_SCOPE},
+    {"ol", TAG_GROUP_LIST | TAG_GROUP_CLOSES_P}, {"optgroup", TAG_GROUP_OPTGROUP},
+    {"option", TAG_GROUP_OPTION}, {"p", TAG_GROUP_P | TAG_GROUP_CLOSES_P},
+    {"pre", TAG_GROUP_CLOSES_P}, {"script", TAG_GROUP_RAW_TEXT},
+    {"section", TAG_GROUP_CLOSES_P}, {"select", TAG_GROUP_SELECT},
+    {"style", TAG_GROUP_RAW_TEXT}, {"summary", TAG_GROUP_CLOSES_P},
+    {"table", TAG_GROUP_TABLE | TAG_GROUP_CLOSES_P}, {"tbody", TAG_GROUP_TABLE_SECTION},
+    {"td", TAG_GROUP_TABLE_CELL}, {"template", TAG_GROUP_SCOPE},
+    {"tfoot", TAG_GROUP_TABLE_SECTION}, {"th", TAG_GROUP_TABLE_CELL},
+    {"thead", TAG_GROUP_TABLE_SECTION}, {"tr", TAG_GROUP_TABLE_ROW},
+    {"ul", TAG_GROUP_LIST | TAG_GROUP_CLOSES_P}
+};
+
+static int compare_tag_group(const void* key, const void* entry) {
+    return strcmp((const char*)key, ((const TagGroup*)entry)->tag);
+}
 
-    /* quick bounds check */
-    if (state->position >= state->length) {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_HTML_SYNTAX,
-            "Unexpected end of input while parsing node.");
-        return NULL;
+/* classifies a tag name of the given length, ASCII case-insensitive */
+static unsigned int tag_group(const char* name, size_t len) {
+    char key[16];
+    if (len == 0 || len >= sizeof(key)) return 0;
+
+    for (size_t i = 0; i < len; i++)
+        key[i] = (char)tolower((unsigned char)name[i]);
+
+    key[len] = '\0';
+    const TagGroup* found = (const TagGroup*)bsearch(key, TAG_GROUPS,
+        sizeof(TAG_GROUPS) / sizeof(TAG_GROUPS[0]), sizeof(TagGroup),
+        compare_tag_group);
+
+    return found ? found->group : 0;
+}
+
+/* open element with the link where its next child goes */
+typedef struct {
+    HTMLNode* node;
+    HTMLNode** tail;
+    size_t tag_length;
+    unsigned int group;
+} OpenElement;
+
+typedef struct {
+    OpenElement* items;
+    size_t count;
+    size_t capacity;
+} OpenElementStack;
+
+static int open_elements_push(OpenElementStack* stack, HTMLNode* node,
+    size_t tag_length, unsigned int group) {
+    if (stack->count == stack->capacity) {
+        size_t capacity = stack->capacity ? stack->capacity * 2 : HTML_PARSER_MIN_DEPTH;
+        OpenElement* items = (OpenElement*)html2tex_realloc(stack->items,
+            capacity * sizeof(OpenElement));
+
+        if (!items) {
+            HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+                "Failed to grow open element stack to %zu entries.",
+                capacity);
+            return 0;
+        }
+
+        stack->items = items;
+        stack->capacity = capacity;
+    }
+
+    OpenElement* top = &stack->items[stack->count++];
+    top->node = node;
+    top->tail = &node->children;
+    top->tag_length = tag_length;
+    top->group = group;
+    return 1;
+}
+
+/* pops the nearest element of the target groups and everything above it,
+unless a boundary element is met first */
+static void close_open_group(OpenElementStack* stack, unsigned int target,
+    unsigned int boundary) {
+    for (size_t i = stack->count; i > 0; i--) {
+        unsigned int group = stack->items[i - 1].group;
+
+        if (group & target) {
+            stack->count = i - 1;
+            return;
+        }
+
+        if (group & boundary) return;
+    }
+}
+
+/* pops everything above the nearest element of the context groups */
+static void clear_to_context(OpenElementStack* stack, unsigned int context) {
+    for (size_t i = stack->count; i > 0; i--) {
+        if (stack->items[i - 1].group & context) {
+            stack->count = i;
+            return;
+        }
     }
+}
+
+/* ends the elements a start tag of the given group implicitly closes */
+static void apply_implied_end_tags(OpenElementStack* stack, unsigned int group) {
+    if (!group || !stack->count) return;
+
+    if (group & TAG_GROUP_LI)
+        close_open_group(stack, TAG_GROUP_LI, TAG_GROUP_LIST | TAG_GROUP_BOUNDARY);
+    else if (group & TAG_GROUP_DT_DD)
+        close_open_group(stack, TAG_GROUP_DT_DD, TAG_GROUP_DL
+            | TAG_GROUP_LIST | TAG_GROUP_BOUNDARY);
+    else if (group & TAG_GROUP_TABLE_CELL)
+        clear_to_context(stack, TAG_GROUP_TABLE_ROW
+            | TAG_GROUP_TABLE_SECTION | TAG_GROUP_TABLE);
+    else if (group & TAG_GROUP_TABLE_ROW)
+        clear_to_context(stack, TAG_GROUP_TABLE_SECTION | TAG_GROUP_TABLE);
+    else if (group & (TAG_GROUP_TABLE_SECTION | TAG_GROUP_CAPTION))
+        clear_to_context(stack, TAG_GROUP_TABLE);
+    else if (group & (TAG_GROUP_OPTION | TAG_GROUP_OPTGROUP)) {
+        if (stack->count && (stack->items[stack->count - 1].group & TAG_GROUP_OPTION))
+            stack->count--;
+
+        if ((group & TAG_GROUP_OPTGROUP) && stack->count &&
+            (stack->items[stack->count - 1].group & TAG_GROUP_OPTGROUP))
+            stack->count--;
+    }
+
+    if (group & TAG_GROUP_CLOSES_P)
+        close_open_group(stack, TAG_GROUP_P, TAG_GROUP_BOUNDARY);
+
+    /* headings never nest directly */
+    if ((group & TAG_GROUP_HEADING) && stack->count &&
+        (stack->items[stack->count - 1].group & TAG_GROUP_HEADING))
+        stack->count--;
+}
+
+/* compares a closing tag name in place, ASCII case-insensitive */
+static int closing_tag_matches(const char* input, size_t start,
+    size_t len, const OpenElement* element) {
+    if (len != element->tag_length) return 0;
+    const char* tag = element->node->tag;
+
+    for (size_t i = 0; i < len; i++) {
+        if ((char)tolower((unsigned char)input[start + i]) != tag[i])
+            return 0;
+    }
+
+    return 1;
+}
+
+/* closes up to the nearest open element named by the end tag, an end tag
+without a match in scope is ignored */
+static void close_matching_element(OpenElementStack* stack, const char* input,
+    size_t start, size_t len) {
+    unsigned int group = tag_group(input + start, len);
+    unsigned int boundary = TAG_GROUP_TABLE;
+
+    if (!(group & TAG_GROUP_TABLE_PART)) {
+        boundary = TAG_GROUP_BOUNDARY;
+        if (group & TAG_GROUP_LI) boundary |= TAG_GROUP_LIST;
+        if (group & TAG_GROUP_DT_DD) boundary |= TAG_GROUP_DL;
+        if (group & (TAG_GROUP_OPTION | TAG_GROUP_OPTGROUP)) boundary |= TAG_GROUP_SELECT;
+    }
+
+    for (size_t i = stack->count; i > 0; i--) {
+        const OpenElement* element = &stack->items[i - 1];
 
-    /* element node */
-    if (state->input[state->position] == '<')
-        return parse_element(state);
+        if (closing_tag_matches(input, start, len, element)) {
+            stack->count = i - 1;
+            return;
+        }
+
+        if (element->group & boundary) return;
+    }
+}
+
+/* consumes "</name ws* >" after the '<' and reports the name bounds,
+a nameless end tag is skipped up to the next '>' */
+static void read_end_tag(ParserState* state, size_t* name_start, size_t* name_length) {
+    const char* input = state->input;
+    const size_t length = state->length;
+    size_t pos = state->position + 1;
+    size_t start = pos;
+
+    while (pos < length && (isalnum((unsigned char)input[pos]) || input[pos] == '-'))
+        pos++;
+
+    *name_start = start;
+    *name_length = pos - start;
+
+    if (pos == start) {
+        while (pos < length && input[pos] != '>') pos++;
+        state->position = pos < length ? pos + 1 : pos;
+        return;
+    }
+
+    state->position = pos;
+    skip_whitespace(state);
 
-    /* text node */
-    HTMLNode* node = (HTMLNode*)malloc(sizeof(HTMLNode));
+    if (state->position < length && input[state->position] == '>')
+        state->position++;
+}
+
+/* character references are left alone inside raw text elements */
+static HTMLNode* create_text_node(ParserState* state, int decode) {
+    HTMLNode* node = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
     if (!node) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate HTMLNode structure.");
@@ -283,44 +549,18 @@ static HTMLNode* parse_node(ParserState* state) {
 
     /* initialize all fields */
     node->tag = NULL;
-    node->content = parse_text_content(state);
+    node->content = parse_text_content(state, decode);
     node->attributes = NULL;
     node->children = NULL;
     node->next = NULL;
     node->parent = NULL;
+    html2tex_index_attributes(node);
     return node;
 }
 
-static HTMLNode* parse_element(ParserState* state) {
-    /* clear any previous error state */
-    html2tex_err_clear();
-
-    if (state->input[state->position] != '<') {
-        HTML2TEX__SET_ERR(HTML2TEX_ERR_HTML_SYNTAX,
-            "Expected '<' character while parsing"
-            " element.");
-        return NULL;
-    }
-
-    state->position++;
-
-    /* check for closing tag */
-    if (state->position < state->length &&
-        state->input[state->position] == '/') {
-        state->position++;
-        char* tag_name = parse_tag_name(state);
-        skip_whitespace(state);
-
-        if (state->position < state->length &&
-            state->input[state->position] == '>')
-            state->position++;
-
-        /* closing tags do not create nodes */
-        if (tag_name) free(tag_name);
-        return NULL;
-    }
-
-    /* parse opening tag */
+/* parses an opening tag after the '<', sets *container when children follow */
+static HTMLNode* create_element_node(ParserState* state, int* container) {
+    *container = 0;
     char* tag_name = parse_tag_name(state);
     if (!tag_name) return NULL;
 
@@ -329,29 +569,29 @@ static HTMLNode* parse_element(ParserState* state) {
     /* check for self-closing tag */
     int self_closing = 0;
 
-    if (state->position < state->length && 
+    if (state->position < state->length &&
         state->input[state->position] == '/') {
         self_closing = 1;
         state->position++;
     }
 
-    if (state->position < state->length && 
+    if (state->position < state->length &&
         state->input[state->position] == '>')
         state->position++;
 
-    HTMLNode* node = (HTMLNode*)malloc(sizeof(HTMLNode));
+    HTMLNode* node = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
 
     if (!node) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate HTMLNode "
             "structure for element.");
 
-        free(tag_name);
+        html2tex_free(tag_name);
         while (attributes) {
             HTMLAttribute* next = attributes->next;
-            free(attributes->key);
-            if (attributes->value) free(attributes->value);
-            free(attributes);
+            html2tex_free(attributes->key);
+            if (attributes->value) html2tex_free(attributes->value);
+            html2tex_free(attributes);
             attributes = next;
         }
 
@@ -364,125 +604,47 @@ static HTMLNode* parse_element(ParserState* state) {
     node->children = NULL;
     node->next = NULL;
     node->parent = NULL;
+    html2tex_index_attributes(node);
 
-    /* parse children if not self-closing and not a void element */
-    if (!self_closing) {
-        if (!is_void_element(tag_name)) {
-            /* cache frequently accessed values */
-            HTMLNode** current_child = &node->children;
-            const char* input = state->input;
-
-            size_t* pos = &state->position;
-            const size_t length = state->length;
-
-            while (*pos < length) {
-                /* optimized whitespace skipping inline */
-                size_t saved_pos = *pos;
-
-                while (*pos < length && 
-                    (unsigned char)input[*pos] <= ' ' 
-                    && input[*pos])
-                    (*pos)++;
-
-                /* check for closing tag */
-                if (*pos < length - 1 && 
-                    input[*pos] == '<' && 
-                    input[*pos + 1] == '/') {
-                    /* found potential closing tag */
-                    size_t check_pos = *pos;
-
-                    /* skip whitespace before checking tag name */
-                    while (check_pos < length && 
-                        (unsigned char)input[check_pos] <= ' ' 
-                        && input[check_pos])
-                        check_pos++;
-
-                    /* if we still have the closing tag after skipping whitespace */
-                    if (check_pos < length - 1 && 
-                        input[check_pos] == '<' && 
-                        input[check_pos + 1] == '/') {
-                        size_t parse_pos = check_pos + 2;
-
-                        /* parse closing tag name */
-                        char* closing_tag = NULL;
-
-                        if (parse_pos < length) {
-                            size_t start = parse_pos;
-
-                            while (parse_pos < length &&
-                                (isalnum((unsigned char)input[parse_pos]) || 
-                                    input[parse_pos] == '-'))
-                                parse_pos++;
-
-                            if (parse_pos > start) {
-                                size_t tag_len = parse_pos - start;
-                                closing_tag = (char*)malloc(tag_len + 1);
-
-                                if (closing_tag) {
-                                    for (size_t i = 0; i < tag_len; i++)
-                                        closing_tag[i] = (char)tolower((unsigned char)input[start + i]);
-
-                                    closing_tag[tag_len] = '\0';
-                                }
-                            }
-                        }
-
-                        /* skip whitespace after tag name */
-                        while (parse_pos < length && 
-                            (unsigned char)input[parse_pos] <= ' ' &&
-                            input[parse_pos])
-                            parse_pos++;
-
-                        /* only break if this is the correct closing tag */
-                        if (closing_tag && strcmp(closing_tag, tag_name) == 0) {
-                            if (parse_pos < length && input[parse_pos] == '>') {
-                                free(closing_tag);
-                                *pos = parse_pos + 1;
-                                break;
-                            }
-                        }
-
-                        if (closing_tag) free(closing_tag);
-                        *pos = saved_pos;
-                    }
-                    else
-                        /* the whitespace was actually text content */
-                        *pos = saved_pos;
-                }
+    *container = !self_closing && !is_void_element(tag_name);
+    return node;
+}
 
-                /* parse the child node */
-                HTMLNode* child = parse_node(state);
+HTMLNode* html2tex_parse(const char* html) {
+    return html2tex_parse_charset(html, HTML_CHARSET_UNKNOWN);
+}
 
-                if (child) {
-                    child->parent = node;
-                    *current_child = child;
-                    current_child = &child->next;
-                }
-                else
-                    break;
-            }
-        }
+HTMLNode* html2tex_parse_charset(const char* html, HTMLCharset hint) {
+    if (!html) {
+        html2tex_err_clear();
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "HTML input string is NULL.");
+        return NULL;
     }
 
-    return node;
+    return html2tex_parse_buffer(html, strlen(html), hint);
 }
 
-HTMLNode* html2tex_parse(const char* html) {
+HTMLNode* html2tex_parse_buffer(const char* html, size_t length, HTMLCharset hint) {
     /* clear any previous error state */
     html2tex_err_clear();
 
-    if (!html) {
+    if (!html && length) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
-            "HTML input string is NULL.");
+            "HTML input buffer is NULL.");
         return NULL;
     }
 
+    /* every read below is bounded by the length, no terminator is needed */
     ParserState state;
-    state.input = html;
-    state.position = 0;
-    state.length = strlen(html);
+    state.input = html ? html : "";
+    state.length = length;
 
-    HTMLNode* root = (HTMLNode*)malloc(sizeof(HTMLNode));
+    /* markup stays ASCII in every supported charset, only copied text is transcoded */
+    HTMLCharset charset = html_charset_sniff(state.input, state.length, hint, &state.position);
+    state.charset_map = html_charset_map(charset);
+
+    HTMLNode* root = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
     if (!root) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate root HTMLNode"
@@ -496,31 +658,94 @@ HTMLNode* html2tex_parse(const char* html) {
     root->children = NULL;
     root->next = NULL;
     root->parent = NULL;
+    html2tex_index_attributes(root);
 
-    HTMLNode** current = &root->children;
+    /* explicit open-element stack, parse depth never touches the C stack */
+    OpenElementStack open = { NULL, 0, 0 };
+    HTMLNode** top_level = &root->children;
 
-    while (state.position < state.length) {
-        HTMLNode* node = parse_node(&state);
+    const char* const input = state.input;
 
-        if (node) {
-            *current = node;
-            current = &node->next;
-        }
-        else {
-            /* if parsing failed due to error, propagate it */
-            if (html2tex_has_error()) {
-                html2tex_free_node(root);
-                return NULL;
-            }
+    while (state.position < length) {
+        html2tex_err_clear();
 
-            /* skip one character if parsing fails to avoid infinite loop */
-            if (state.position < state.length)
+        if (open.count) {
+            /* whitespace before a tag inside an element is dropped */
+            while (state.position < length &&
+                (unsigned char)input[state.position] <= ' ' &&
+                input[state.position])
                 state.position++;
-            else
+
+            if (state.position >= length) {
+                HTML2TEX__SET_ERR(HTML2TEX_ERR_HTML_SYNTAX,
+                    "Unexpected end of input while parsing node.");
                 break;
+            }
+        }
+
+        HTMLNode* node = NULL;
+        int container = 0;
+
+        if (input[state.position] == '<') {
+            state.position++;
+
+            if (state.position < length && input[state.position] == '/') {
+                /* end tags close up to their element in one forward pass */
+                size_t name_start, name_length;
+                read_end_tag(&state, &name_start, &name_length);
+
+                if (name_length)
+                    close_matching_element(&open, input, name_start, name_length);
+                continue;
+            }
+
+            node = create_element_node(&state, &container);
+        }
+        else
+            node = create_text_node(&state, !open.count ||
+                !(open.items[open.count - 1].group & TAG_GROUP_RAW_TEXT));
+
+        if (!node) {
+            /* invalid markup ends the current element */
+            if (open.count && html2tex_err_get() != HTML2TEX_ERR_NOMEM) {
+                open.count--;
+                continue;
+            }
+
+            html2tex_free(open.items);
+            html2tex_free_node(root);
+            return NULL;
+        }
+
+        size_t tag_length = 0;
+        unsigned int group = 0;
+
+        if (node->tag) {
+            tag_length = strlen(node->tag);
+            group = tag_group(node->tag, tag_length);
+            apply_implied_end_tags(&open, group);
+        }
+
+        /* top-level nodes keep a NULL parent */
+        if (open.count) {
+            OpenElement* current = &open.items[open.count - 1];
+            node->parent = current->node;
+            *current->tail = node;
+            current->tail = &node->next;
+        }
+        else {
+            *top_level = node;
+            top_level = &node->next;
+        }
+
+        if (container && !open_elements_push(&open, node, tag_length, group)) {
+            html2tex_free(open.items);
+            html2tex_free_node(root);
+            return NULL;
         }
     }
 
+    html2tex_free(open.items);
     return root;
 }
 
@@ -560,7 +785,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
     }
 
     /* create root copy */
-    HTMLNode* new_root = (HTMLNode*)malloc(sizeof(HTMLNode));
+    HTMLNode* new_root = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
     if (!new_root) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate root HTMLNode"
@@ -569,8 +794,9 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
     }
 
     /* copy root data */
-    new_root->tag = node->tag ? strdup(node->tag) : NULL;
-    new_root->content = node->content ? strdup(node->content) : NULL;
+    new_root->attributes = NULL;
+    new_root->tag = node->tag ? html2tex_strdup(node->tag) : NULL;
+    new_root->content = node->content ? html2tex_strdup(node->content) : NULL;
     new_root->parent = NULL;
     new_root->next = NULL;
     new_root->children = NULL;
@@ -579,14 +805,14 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
     if (node->tag && !new_root->tag) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to duplicate tag string.");
-        free(new_root);
+        html2tex_free(new_root);
         return NULL;
     }
     if (node->content && !new_root->content) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to duplicate content string.");
-        free(new_root->tag);
-        free(new_root);
+        html2tex_free(new_root->tag);
+        html2tex_free(new_root);
         return NULL;
     }
 
@@ -596,7 +822,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
     HTMLAttribute* old_attr = node->attributes;
 
     while (old_attr) {
-        HTMLAttribute* new_attr = (HTMLAttribute*)malloc(sizeof(HTMLAttribute));
+        HTMLAttribute* new_attr = (HTMLAttribute*)html2tex_malloc(sizeof(HTMLAttribute));
 
         if (!new_attr) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -605,16 +831,16 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
             return NULL;
         }
 
-        new_attr->key = strdup(old_attr->key);
-        new_attr->value = old_attr->value ? strdup(old_attr->value) : NULL;
+        new_attr->key = html2tex_strdup(old_attr->key);
+        new_attr->value = old_attr->value ? html2tex_strdup(old_attr->value) : NULL;
 
         /* validate attribute string duplications */
         if (!new_attr->key || (old_attr->value && !new_attr->value)) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to duplicate attribute string.");
-            free(new_attr->key);
-            free(new_attr->value);
-            free(new_attr);
+            html2tex_free(new_attr->key);
+            html2tex_free(new_attr->value);
+            html2tex_free(new_attr);
             html2tex_free_node(new_root);
             return NULL;
         }
@@ -626,6 +852,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
         old_attr = old_attr->next;
     }
     new_root->attributes = new_attrs;
+    html2tex_index_attributes(new_root);
 
     /* BFS queue for copying children */
     Queue* src_queue = NULL;
@@ -655,7 +882,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
 
         while (src_child) {
             /* create child copy */
-            HTMLNode* new_child = (HTMLNode*)malloc(sizeof(HTMLNode));
+            HTMLNode* new_child = (HTMLNode*)html2tex_malloc(sizeof(HTMLNode));
 
             if (!new_child) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -667,20 +894,21 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
             }
 
             /* copy child data */
-            new_child->tag = src_child->tag ? strdup(src_child->tag) : NULL;
-            new_child->content = src_child->content ? strdup(src_child->content) : NULL;
+            new_child->tag = src_child->tag ? html2tex_strdup(src_child->tag) : NULL;
+            new_child->content = src_child->content ? html2tex_strdup(src_child->content) : NULL;
             new_child->parent = dst_current;
             new_child->next = NULL;
             new_child->children = NULL;
+            new_child->attributes = NULL;
 
             /* Validate child string duplications */
             if ((src_child->tag && !new_child->tag) ||
                 (src_child->content && !new_child->content)) {
                 HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                     "Failed to duplicate child node string.");
-                free(new_child->tag);
-                free(new_child->content);
-                free(new_child);
+                html2tex_free(new_child->tag);
+                html2tex_free(new_child->content);
+                html2tex_free(new_child);
                 html2tex_free_node(new_root);
                 queue_cleanup(&src_queue, &src_rear);
                 queue_cleanup(&dst_queue, &dst_rear);
@@ -693,7 +921,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
             HTMLAttribute* src_child_attr = src_child->attributes;
 
             while (src_child_attr) {
-                HTMLAttribute* new_child_attr = (HTMLAttribute*)malloc(sizeof(HTMLAttribute));
+                HTMLAttribute* new_child_attr = (HTMLAttribute*)html2tex_malloc(sizeof(HTMLAttribute));
 
                 if (!new_child_attr) {
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -706,17 +934,17 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
                     return NULL;
                 }
 
-                new_child_attr->key = strdup(src_child_attr->key);
-                new_child_attr->value = src_child_attr->value ? strdup(src_child_attr->value) : NULL;
+                new_child_attr->key = html2tex_strdup(src_child_attr->key);
+                new_child_attr->value = src_child_attr->value ? html2tex_strdup(src_child_attr->value) : NULL;
 
                 /* validate child attribute string duplications */
                 if (!new_child_attr->key || (src_child_attr->value && !new_child_attr->value)) {
                     HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                         "Failed to duplicate child "
                         "attribute string.");
-                    free(new_child_attr->key);
-                    free(new_child_attr->value);
-                    free(new_child_attr);
+                    html2tex_free(new_child_attr->key);
+                    html2tex_free(new_child_attr->value);
+                    html2tex_free(new_child_attr);
                     html2tex_free_node(new_child);
                     html2tex_free_node(new_root);
                     queue_cleanup(&src_queue, &src_rear);
@@ -733,6 +961,7 @@ HTMLNode* dom_tree_copy(const HTMLNode* node) {
 
             /* link child to parent */
             new_child->attributes = child_attrs;
+            html2tex_index_attributes(new_child);
             *dst_child_ptr = new_child;
             dst_child_ptr = &new_child->next;
 
@@ -782,20 +1011,20 @@ void html2tex_free_node(HTMLNode* node) {
         current->children = NULL;
 
         /* free current node */
-        if (current->tag) free(current->tag);
-        if (current->content) free(current->content);
+        if (current->tag) html2tex_free(current->tag);
+        if (current->content) html2tex_free(current->content);
 
         /* free attribute list */
         HTMLAttribute* attr = current->attributes;
 
         while (attr) {
             HTMLAttribute* next_attr = attr->next;
-            free(attr->key);
+            html2tex_free(attr->key);
 
-            if (attr->value) free(attr->value);
-            free(attr); attr = next_attr;
+            if (attr->value) html2tex_free(attr->value);
+            html2tex_free(attr); attr = next_attr;
         }
 
-        free(current);
+        html2tex_free(current);
     }
 }
\ No newline at end of file
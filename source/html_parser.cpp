@@ -5,6 +5,67 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
+
+namespace {
+    /* decoded bytes collected from a compressed stream, capped against archive bombs */
+    struct InflateTarget {
+        std::string* content;
+        size_t limit;
+    };
+
+    int appendInflated(const char* data, size_t length, void* user_data) {
+        InflateTarget* target = static_cast<InflateTarget*>(user_data);
+
+        if (length > target->limit - target->content->size())
+            return 0;
+
+        target->content->append(data, length);
+        return 1;
+    }
+
+    /* peeks the leading bytes without consuming them, a zlib header is test-inflated */
+    HTMLCompression detectCompression(std::istream& input) {
+        unsigned char magic[HTML_COMPRESSION_PROBE];
+        const std::streampos start = input.tellg();
+
+        input.read(reinterpret_cast<char*>(magic), sizeof(magic));
+        const size_t got = static_cast<size_t>(input.gcount());
+
+        input.clear();
+        input.seekg(start);
+
+        return html_compression_detect(magic, got);
+    }
+
+    /* inflates the rest of the stream chunk by chunk into content */
+    bool readCompressed(std::istream& input, HTMLCompression type,
+        std::string& content, size_t limit) {
+        std::unique_ptr<HTMLCodec, decltype(&html_codec_destroy)> codec(
+            html_codec_create(type, 0), &html_codec_destroy);
+
+        if (!codec) return false;
+
+        std::vector<char> buffer(HTML_COMPRESSION_CHUNK);
+        InflateTarget target = { &content, limit };
+
+        while (!html_codec_finished(codec.get())) {
+            input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const size_t bytes_read = static_cast<size_t>(input.gcount());
+
+            if (input.bad()) return false;
+            const bool last = bytes_read < buffer.size();
+
+            if (!html_codec_process(codec.get(), buffer.data(), bytes_read,
+                last, &appendInflated, &target))
+                return false;
+
+            if (last) break;
+        }
+
+        return true;
+    }
+}
 
 HtmlParser::HtmlParser() : node(nullptr, &html2tex_free_node), minify(HtmlEncodingType::NONE)
 { }
@@ -140,55 +201,34 @@ std::istream& operator >>(std::istream& in, HtmlParser& parser) {
         }
     }
 
-    /* read directly using streambuf */
+    /* read directly using streambuf, whole chunks at a time */
     bool success = false;
     std::size_t total_read = 0;
 
     if (sbuf) {
-        std::streambuf::int_type ch;
+        constexpr std::size_t kChunkSize = 65'536;
         content.clear();
 
         while (total_read < kMaxSize) {
-            ch = sbuf->sbumpc();
+            const std::size_t to_read = std::min(kChunkSize, kMaxSize - total_read);
+            content.resize(total_read + to_read);
+
+            const std::streamsize actually_read = sbuf->sgetn(
+                &content[total_read], static_cast<std::streamsize>(to_read));
 
-            if (ch == std::streambuf::traits_type::eof()) {
+            total_read += static_cast<std::size_t>(std::max<std::streamsize>(actually_read, 0));
+            content.resize(total_read);
+
+            /* EOF reached */
+            if (actually_read < static_cast<std::streamsize>(to_read)) {
                 success = true;
                 break;
             }
-
-            content.push_back(std::streambuf::traits_type::to_char_type(ch));
-            ++total_read;
-
-            /* bulk read optimization */
-            if (total_read == 1) {
-                const std::streamsize remaining = sbuf->in_avail();
-
-                if (remaining > 0) {
-                    const std::size_t to_read = std::min(
-                        static_cast<std::size_t>(remaining),
-                        kMaxSize - total_read);
-
-                    if (to_read > 0) {
-                        content.resize(total_read + to_read);
-                        const std::streamsize actually_read = sbuf->sgetn(
-                            &content[total_read], static_cast<std::streamsize>(to_read));
-
-                        total_read += static_cast<std::size_t>(actually_read);
-                        content.resize(total_read);
-
-                        /* EOF reached */
-                        if (actually_read < static_cast<std::streamsize>(to_read)) {
-                            success = true;
-                            break;
-                        }
-                    }
-                }
-            }
         }
 
         /* size limit reached */
         if (total_read >= kMaxSize)
-            in.clear(in.rdstate() & ~std::ios_base::failbit);
+            success = true;
     }
 
     /* fallback to standard read if streambuf method failed */
@@ -218,6 +258,27 @@ HtmlParser HtmlParser::fromStream(std::ifstream& input) noexcept {
     if (!input.is_open() || input.bad())
         return HtmlParser();
 
+    /* gzip and zlib archives are inflated while reading */
+    const HTMLCompression compression = detectCompression(input);
+
+    if (compression != HTML_COMPRESSION_NONE) {
+        std::string content;
+
+        if (!readCompressed(input, compression, content, HTML_COMPRESSION_MAX_INFLATED)
+            || content.empty())
+            return HtmlParser();
+
+        HTMLNode* raw_node = html2tex_parse(content.c_str());
+
+        if (raw_node) {
+            HtmlParser res = HtmlParser(raw_node);
+            html2tex_free_node(raw_node);
+            return res;
+        }
+
+        return HtmlParser();
+    }
+
     /* get file size for optimal buffer sizing */
     const std::streampos current_pos = input.tellg();
     input.seekg(0, std::ios::end);
@@ -352,6 +413,12 @@ HtmlParser HtmlParser::fromHtml(const std::string& filePath) noexcept {
         return HtmlParser();
     }
 
+    /* compressed files are streamed through the decoder instead */
+    fin.seekg(0, std::ios::beg);
+
+    if (detectCompression(fin) != HTML_COMPRESSION_NONE)
+        return fromStream(fin);
+
     /* enforce absolute size limit for security reasons */
     constexpr size_t MAX_READ = 134'217'728;
 
@@ -387,6 +454,31 @@ HtmlParser HtmlParser::fromHtml(const std::string& filePath) noexcept {
     return HtmlParser();
 }
 
+HtmlParser HtmlParser::fromFile(const std::string& filePath) noexcept {
+    /* map the file instead of copying it into a heap buffer */
+    std::unique_ptr<HTMLMappedFile, decltype(&html_mapped_file_close)> mapped(
+        html_mapped_file_open(filePath.c_str()), &html_mapped_file_close);
+
+    if (!mapped) return HtmlParser();
+
+    const char* data = html_mapped_file_data(mapped.get());
+    const size_t length = html_mapped_file_length(mapped.get());
+
+    /* archives must be inflated first */
+    if (html_compression_detect(reinterpret_cast<const unsigned char*>(data), length)
+        != HTML_COMPRESSION_NONE) {
+        mapped.reset();
+        return fromHtml(filePath);
+    }
+
+    /* parse the mapped pages in place and adopt the tree without copying it */
+    HtmlParser res;
+    HTMLNode* raw_node = html2tex_parse_buffer(data, length, HTML_CHARSET_UNKNOWN);
+
+    if (raw_node) res.setParent({ raw_node, &html2tex_free_node });
+    return res;
+}
+
 HTMLNode* HtmlParser::getHtmlNode() const noexcept { 
     return node.get(); 
 }
@@ -428,7 +520,7 @@ std::string HtmlParser::toString() const {
     char* const raw_output = get_pretty_html(node.get());
 
     /* add RAII ownership for safely destroying the allocate memory */
-    const auto deleter = [](char* p) noexcept { std::free(p); };
+    const auto deleter = [](char* p) noexcept { html2tex_free(p); };
     std::unique_ptr<char[], decltype(deleter)> output_guard(raw_output, deleter);
 
     /* error thrown, invalid output */
@@ -1,3 +1,8 @@
+/* open_memstream() is POSIX.1-2008, hidden by a strict C99 build */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "html2tex.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -57,7 +62,7 @@ static char* escape_html(const char* text) {
 
     /* no escaping needed, return copy */
     if (extra == 0) {
-        char* result = strdup(text);
+        char* result = html2tex_strdup(text);
         if (!result) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to duplicate plain text"
@@ -68,7 +73,7 @@ static char* escape_html(const char* text) {
 
     /* allocate once */
     size_t len = p - text;
-    char* escaped = (char*)malloc(len + extra + 1);
+    char* escaped = (char*)html2tex_malloc(len + extra + 1);
 
     if (!escaped) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
@@ -152,7 +157,7 @@ static void write_pretty_node(FILE* file, HTMLNode* node, int indent_level) {
                 if (escaped_value) {
                     fputs(" ", file); fputs(attr->key, file); 
                     fputs("=\"", file); fputs(escaped_value, file); 
-                    fputs("\"", file); free(escaped_value);
+                    fputs("\"", file); html2tex_free(escaped_value);
                 }
                 else if (html2tex_has_error())
                     return;
@@ -180,7 +185,7 @@ static void write_pretty_node(FILE* file, HTMLNode* node, int indent_level) {
 
                 if (escaped_content) {
                     fputs(escaped_content, file);
-                    free(escaped_content);
+                    html2tex_free(escaped_content);
                 }
                 else if (html2tex_has_error())
                     return;
@@ -234,7 +239,7 @@ static void write_pretty_node(FILE* file, HTMLNode* node, int indent_level) {
                 }
                 else
                     fputs("\n", file);
-                free(escaped_content);
+                html2tex_free(escaped_content);
             }
             else if (html2tex_has_error())
                 return;
@@ -280,7 +285,7 @@ int write_pretty_html(const HTMLNode* root, const char* filename) {
         fputs("Parsed HTML Output", file);
     else {
         fputs(html_title, file);
-        free(html_title);
+        html2tex_free(html_title);
     }
 
     fputs("</title>\n", file);
@@ -339,7 +344,7 @@ char* get_pretty_html(const HTMLNode* root) {
 
         if (html2tex_has_error()) {
             fclose(stream);
-            free(buffer);
+            html2tex_free(buffer);
             return NULL;
         }
 
@@ -348,7 +353,7 @@ char* get_pretty_html(const HTMLNode* root) {
             fputs("Parsed HTML Output", stream);
         else {
             fputs(html_title, stream);
-            free(html_title);
+            html2tex_free(html_title);
         }
 
         fputs("</title>\n", stream);
@@ -362,7 +367,7 @@ char* get_pretty_html(const HTMLNode* root) {
 
             if (html2tex_has_error()) {
                 fclose(stream);
-                free(buffer);
+                html2tex_free(buffer);
                 return NULL;
             }
 
@@ -375,7 +380,7 @@ char* get_pretty_html(const HTMLNode* root) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
                 "Failed to close memory stream"
                 " for HTML generation.");
-            free(buffer);
+            html2tex_free(buffer);
             return NULL;
         }
 
@@ -408,7 +413,7 @@ char* get_pretty_html(const HTMLNode* root) {
         fputs("Parsed HTML Output", temp_file);
     else {
         fputs(html_title, temp_file);
-        free(html_title);
+        html2tex_free(html_title);
     }
 
     fputs("</title>\n", temp_file);
@@ -447,7 +452,7 @@ char* get_pretty_html(const HTMLNode* root) {
 
     if (file_size == 0) {
         fclose(temp_file);
-        char* empty_string = strdup("");
+        char* empty_string = html2tex_strdup("");
         if (!empty_string) {
             HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
                 "Failed to allocate empty string"
@@ -464,7 +469,7 @@ char* get_pretty_html(const HTMLNode* root) {
         return NULL;
     }
 
-    char* html_string = (char*)malloc(file_size + 1);
+    char* html_string = (char*)html2tex_malloc(file_size + 1);
     if (!html_string) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
             "Failed to allocate %ld bytes for"
@@ -481,7 +486,7 @@ char* get_pretty_html(const HTMLNode* root) {
             "Failed to read complete temporary"
             " file (%zu of %ld bytes).",
             bytes_read, file_size);
-        free(html_string);
+        html2tex_free(html_string);
         fclose(temp_file);
         return NULL;
     }
@@ -490,7 +495,7 @@ char* get_pretty_html(const HTMLNode* root) {
         HTML2TEX__SET_ERR(HTML2TEX_ERR_IO,
             "Failed to close temporary file"
             " after reading.");
-        free(html_string);
+        html2tex_free(html_string);
         return NULL;
     }
 
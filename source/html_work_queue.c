@@ -0,0 +1,236 @@
+#include "html2tex.h"
+#include "html_work_queue.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* keeps producer and consumer positions off each other's cache line */
+#define WORK_QUEUE_CACHE_LINE 64
+
+/* a slot is free for position p when sequence == p, and holds its item when sequence == p + 1 */
+typedef struct {
+    atomic_size_t sequence;
+    void* item;
+} WorkSlot;
+
+struct HTMLWorkQueue {
+    WorkSlot* slots;
+    size_t mask;
+
+    char tail_pad[WORK_QUEUE_CACHE_LINE];
+    atomic_size_t tail;
+    char head_pad[WORK_QUEUE_CACHE_LINE];
+    atomic_size_t head;
+    char park_pad[WORK_QUEUE_CACHE_LINE];
+
+    /* parking, only touched by threads that found the queue full or empty */
+    mutex_t mutex;
+    cond_t not_empty;
+    cond_t not_full;
+    atomic_size_t empty_waiters;
+    atomic_size_t full_waiters;
+    atomic_size_t closed;
+};
+
+HTMLWorkQueue* html_work_queue_create(size_t capacity) {
+    html2tex_err_clear();
+    size_t slots = 2;
+
+    if (!capacity) capacity = HTML_WORK_QUEUE_CAPACITY;
+    while (slots < capacity) slots <<= 1;
+
+    HTMLWorkQueue* queue = (HTMLWorkQueue*)html2tex_calloc(1, sizeof(HTMLWorkQueue));
+    if (queue) queue->slots = (WorkSlot*)html2tex_calloc(slots, sizeof(WorkSlot));
+
+    if (!queue || !queue->slots) {
+        html2tex_free(queue);
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate a work queue of %zu slots.", slots);
+        return NULL;
+    }
+
+    queue->mask = slots - 1;
+
+    for (size_t i = 0; i < slots; i++)
+        atomic_store(&queue->slots[i].sequence, i);
+
+    atomic_store(&queue->tail, 0);
+    atomic_store(&queue->head, 0);
+    atomic_store(&queue->empty_waiters, 0);
+    atomic_store(&queue->full_waiters, 0);
+    atomic_store(&queue->closed, 0);
+
+    mutex_init(&queue->mutex);
+    cond_init(&queue->not_empty);
+    cond_init(&queue->not_full);
+    return queue;
+}
+
+static int claim_push(HTMLWorkQueue* queue, void* item) {
+    size_t position = atomic_load(&queue->tail);
+    WorkSlot* slot;
+
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        const size_t sequence = atomic_load(&slot->sequence);
+        const ptrdiff_t lag = (ptrdiff_t)(sequence - position);
+
+        if (lag == 0) {
+            /* a failed exchange reloads position */
+            if (atomic_compare_exchange(&queue->tail, &position, position + 1))
+                break;
+        }
+        else if (lag < 0)
+            return 0;
+        else
+            position = atomic_load(&queue->tail);
+    }
+
+    slot->item = item;
+    atomic_store(&slot->sequence, position + 1);
+    return 1;
+}
+
+static void* claim_pop(HTMLWorkQueue* queue) {
+    size_t position = atomic_load(&queue->head);
+    WorkSlot* slot;
+
+    for (;;) {
+        slot = &queue->slots[position & queue->mask];
+        const size_t sequence = atomic_load(&slot->sequence);
+        const ptrdiff_t lag = (ptrdiff_t)(sequence - (position + 1));
+
+        if (lag == 0) {
+            if (atomic_compare_exchange(&queue->head, &position, position + 1))
+                break;
+        }
+        else if (lag < 0)
+            return NULL;
+        else
+            position = atomic_load(&queue->head);
+    }
+
+    void* item = slot->item;
+
+    /* frees the slot for the producer one lap ahead */
+    atomic_store(&slot->sequence, position + queue->mask + 1);
+    return item;
+}
+
+/* signals a parked thread, the fence pairs with the one a thread runs before parking */
+static void wake_parked(HTMLWorkQueue* queue, atomic_size_t* waiters, cond_t* cond) {
+    atomic_fence();
+    if (!atomic_load(waiters)) return;
+
+    mutex_lock(&queue->mutex);
+    cond_signal(cond);
+    mutex_unlock(&queue->mutex);
+}
+
+int html_work_queue_try_push(HTMLWorkQueue* queue, void* item) {
+    if (!queue || !item || atomic_load(&queue->closed))
+        return 0;
+
+    if (!claim_push(queue, item))
+        return 0;
+
+    wake_parked(queue, &queue->empty_waiters, &queue->not_empty);
+    return 1;
+}
+
+void* html_work_queue_try_pop(HTMLWorkQueue* queue) {
+    if (!queue) return NULL;
+    void* item = claim_pop(queue);
+
+    if (item) wake_parked(queue, &queue->full_waiters, &queue->not_full);
+    return item;
+}
+
+int html_work_queue_push(HTMLWorkQueue* queue, void* item) {
+    if (!queue || !item) return 0;
+
+    /* a consumer usually frees a slot within a time slice, parking costs two syscalls */
+    for (int spin = 0;; spin++) {
+        if (html_work_queue_try_push(queue, item)) return 1;
+        if (atomic_load(&queue->closed)) return 0;
+
+        if (spin == HTML_WORK_QUEUE_SPIN) break;
+        thread_yield();
+    }
+
+    int pushed = 0;
+    mutex_lock(&queue->mutex);
+
+    atomic_fetch_add(&queue->full_waiters, 1);
+    atomic_fence();
+
+    while (!atomic_load(&queue->closed)) {
+        if ((pushed = claim_push(queue, item)) != 0) break;
+        cond_wait(&queue->not_full, &queue->mutex);
+    }
+
+    atomic_fetch_sub(&queue->full_waiters, 1);
+    mutex_unlock(&queue->mutex);
+
+    if (pushed) wake_parked(queue, &queue->empty_waiters, &queue->not_empty);
+    return pushed;
+}
+
+void* html_work_queue_pop(HTMLWorkQueue* queue, unsigned int timeout_ms) {
+    if (!queue) return NULL;
+    void* item;
+
+    for (int spin = 0;; spin++) {
+        if ((item = html_work_queue_try_pop(queue)) != NULL) return item;
+        if (atomic_load(&queue->closed) || spin == HTML_WORK_QUEUE_SPIN) break;
+        thread_yield();
+    }
+
+    mutex_lock(&queue->mutex);
+    atomic_fetch_add(&queue->empty_waiters, 1);
+    atomic_fence();
+
+    while ((item = claim_pop(queue)) == NULL && !atomic_load(&queue->closed)) {
+        if (timeout_ms == 0)
+            cond_wait(&queue->not_empty, &queue->mutex);
+        else if (cond_timedwait(&queue->not_empty, &queue->mutex, timeout_ms) != 0) {
+            item = claim_pop(queue);
+            break;
+        }
+    }
+
+    atomic_fetch_sub(&queue->empty_waiters, 1);
+    mutex_unlock(&queue->mutex);
+
+    if (item) wake_parked(queue, &queue->full_waiters, &queue->not_full);
+    return item;
+}
+
+void html_work_queue_close(HTMLWorkQueue* queue) {
+    if (!queue) return;
+
+    mutex_lock(&queue->mutex);
+    atomic_store(&queue->closed, 1);
+
+    cond_broadcast(&queue->not_empty);
+    cond_broadcast(&queue->not_full);
+    mutex_unlock(&queue->mutex);
+}
+
+size_t html_work_queue_size(HTMLWorkQueue* queue) {
+    if (!queue) return 0;
+
+    const size_t head = atomic_load(&queue->head);
+    const size_t tail = atomic_load(&queue->tail);
+    return tail > head ? tail - head : 0;
+}
+
+void html_work_queue_destroy(HTMLWorkQueue* queue) {
+    if (!queue) return;
+
+    mutex_destroy(&queue->mutex);
+    cond_destroy(&queue->not_empty);
+    cond_destroy(&queue->not_full);
+
+    html2tex_free(queue->slots);
+    html2tex_free(queue);
+}
@@ -2,241 +2,407 @@
 #include <stdlib.h>
 #include <string.h>
 
-/* simplified internal structures */
-typedef struct {
-    char* url;
-    char* output_dir;
+/* in-flight transfers hashed by URL and directory */
+#define FLIGHT_BUCKETS 256
+
+/* context of a download handed to the engine, url, output_dir and path are stored after the struct */
+typedef struct PendingDownload PendingDownload;
+
+struct PendingDownload {
+    struct ImageDownloader* downloader;
     int sequence_number;
-} QueuedDownload;
 
-struct DownloadQueue {
-    QueuedDownload* items;
+    const char* url;
+    const char* output_dir;
+    const char* path;
+    size_t bucket;
+    PendingDownload* next;
+
+    /* requests for the same file that joined while the transfer was in flight */
+    int* followers;
+    size_t follower_count;
+    size_t follower_capacity;
+
+    /* image of a memory or stream delivery, described to the writer by image */
+    DownloadResult image;
+    unsigned char* data;
+    size_t size;
     size_t capacity;
-    size_t count;
-    size_t head;
-    mutex_t mutex;
-    cond_t not_empty;
-    cond_t not_full;
+    char* content_type;
 };
 
-struct Worker {
-    struct ImageDownloader* downloader;
-    thread_t thread;
+/* a finished download, the result comes first so download_result_free() releases the node */
+typedef struct CompletedDownload CompletedDownload;
+
+struct CompletedDownload {
+    DownloadResult result;
+    CompletedDownload* next;
 };
 
 struct ImageDownloader {
-    struct Worker* workers;
-    size_t worker_count;
-    struct DownloadQueue queue;
+    HTMLDownloadEngine* engine;
+
+    /* serves the downloads instead of the engine when set, not owned */
+    ImageFetcher* fetcher;
 
-    DownloadResult** results;
-    size_t results_capacity;
-    size_t results_count;
-    mutex_t results_mutex;
+    /* lock-free stack of results, newest first, holding a CompletedDownload pointer */
+    atomic_size_t completions;
 
     DownloadCallback download_callback;
     BatchCompleteCallback batch_callback;
     void* user_data;
 
-    atomic_bool stop_flag;
-    atomic_size_t active_workers;
     atomic_size_t total_enqueued;
     atomic_size_t completed;
     atomic_size_t successful;
 
+    /* parking of image_downloader_wait(), locked only when someone waits */
     mutex_t state_mutex;
     cond_t all_complete;
+    atomic_size_t waiters;
+
+    /* fetcher callbacks not returned yet, guarded by state_mutex */
+    size_t fetches;
+
+    /* where images go, fixed while downloads are in flight */
+    ImageDelivery delivery;
+    ImageStreamWriter writer;
+
+    /* single-flight table, guarded by flights_mutex */
+    mutex_t flights_mutex;
+    PendingDownload* flights[FLIGHT_BUCKETS];
+    atomic_size_t dedup_hits;
 };
 
-static bool queue_init(struct DownloadQueue* queue, size_t capacity) {
-    if (capacity == 0) capacity = 64;
+/* copies text without touching the error state, which error may point into */
+static char* copy_text(const char* text) {
+    const size_t length = strlen(text) + 1;
+    char* copy = html2tex_malloc(length);
 
-    queue->items = malloc(sizeof(QueuedDownload) * capacity);
-    if (!queue->items) return false;
+    if (copy) memcpy(copy, text, length);
+    return copy;
+}
 
-    queue->capacity = capacity;
-    queue->count = 0;
-    queue->head = 0;
+/* last component of a path */
+static const char* base_name(const char* path) {
+    const char* name = path;
 
-    if (mutex_init(&queue->mutex) != 0 ||
-        cond_init(&queue->not_empty) != 0 ||
-        cond_init(&queue->not_full) != 0) {
-        free(queue->items);
-        return false;
+    for (const char* p = path; *p; p++) {
+        if (*p == '/' || *p == '\\')
+            name = p + 1;
     }
 
-    return true;
+    return name;
 }
 
-static void mutex_queue_destroy(struct DownloadQueue* queue) {
-    if (!queue) return;
-    mutex_lock(&queue->mutex);
+static DownloadResult* create_result(const char* url, const char* local_path,
+    const char* error, int sequence_number) {
+    CompletedDownload* node = html2tex_malloc(sizeof(CompletedDownload));
+    if (!node) return NULL;
+
+    DownloadResult* result = &node->result;
+    node->next = NULL;
+
+    result->url = copy_text(url);
+    result->sequence_number = sequence_number;
+    result->local_path = local_path ? copy_text(local_path) : NULL;
+    result->success = local_path != NULL;
+    result->error = NULL;
+    result->data = NULL;
+    result->size = 0;
+    result->content_type = NULL;
+    result->filename = local_path ? copy_text(base_name(local_path)) : NULL;
+
+    if (!result->success)
+        result->error = copy_text(error && error[0] ? error : "Image download failed.");
+
+    return result;
+}
 
-    for (size_t i = 0; i < queue->count; i++) {
-        size_t idx = (queue->head + i) % queue->capacity;
-        free(queue->items[idx].url);
-        free(queue->items[idx].output_dir);
+/* pushes a chain of completions, first to last, onto the stack */
+static void push_completions(struct ImageDownloader* downloader,
+    CompletedDownload* first, CompletedDownload* last) {
+    size_t head = atomic_load(&downloader->completions);
+
+    do {
+        last->next = (CompletedDownload*)head;
+    } while (!atomic_compare_exchange(&downloader->completions, &head, (size_t)first));
+}
+
+static CompletedDownload* take_completions(struct ImageDownloader* downloader) {
+    size_t head = atomic_load(&downloader->completions);
+    while (!atomic_compare_exchange(&downloader->completions, &head, 0));
+
+    return (CompletedDownload*)head;
+}
+
+/* stores a finished download and signals waiters, result may be NULL when out of memory */
+static void record_result(struct ImageDownloader* downloader, DownloadResult* result) {
+    if (result) {
+        if (result->success)
+            atomic_fetch_add(&downloader->successful, 1);
+
+        /* runs before publishing, so the result cannot be collected and freed under it */
+        if (downloader->download_callback)
+            downloader->download_callback(result,
+                downloader->user_data);
+
+        CompletedDownload* node = (CompletedDownload*)result;
+        push_completions(downloader, node, node);
+    }
+
+    size_t completed = atomic_fetch_add(&downloader->completed, 1) + 1;
+    size_t total = atomic_load(&downloader->total_enqueued);
+
+    if (completed >= total && downloader->batch_callback) {
+        size_t success = atomic_load(&downloader->successful);
+        downloader->batch_callback(total, success, downloader->user_data);
     }
 
-    mutex_unlock(&queue->mutex);
-    cond_destroy(&queue->not_empty);
-    cond_destroy(&queue->not_full);
+    /* pairs with the fence image_downloader_wait() runs before it parks */
+    atomic_fence();
 
-    mutex_destroy(&queue->mutex);
-    free(queue->items);
+    if (atomic_load(&downloader->waiters)) {
+        mutex_lock(&downloader->state_mutex);
+        cond_broadcast(&downloader->all_complete);
+        mutex_unlock(&downloader->state_mutex);
+    }
 }
 
-static bool queue_push(struct DownloadQueue* queue, QueuedDownload item) {
-    mutex_lock(&queue->mutex);
+static size_t flight_bucket(const char* url, const char* output_dir) {
+    unsigned long hash = 5381;
 
-    while (queue->count == queue->capacity)
-        cond_wait(&queue->not_full, &queue->mutex);
+    for (const unsigned char* p = (const unsigned char*)url; *p; p++)
+        hash = ((hash << 5) + hash) + *p;
 
-    size_t tail = (queue->head + queue->count) % queue->capacity;
-    queue->items[tail] = item;
-    queue->count++;
+    for (const unsigned char* p = (const unsigned char*)output_dir; *p; p++)
+        hash = ((hash << 5) + hash) + *p;
 
-    cond_signal(&queue->not_empty);
-    mutex_unlock(&queue->mutex);
-    return true;
+    return (size_t)(hash % FLIGHT_BUCKETS);
 }
 
-static bool queue_pop(struct DownloadQueue* queue, QueuedDownload* item) {
-    mutex_lock(&queue->mutex);
+static PendingDownload* find_flight(struct ImageDownloader* downloader, size_t bucket,
+    const char* url, const char* output_dir) {
+    for (PendingDownload* flight = downloader->flights[bucket]; flight; flight = flight->next) {
+        if (strcmp(flight->url, url) == 0 && strcmp(flight->output_dir, output_dir) == 0)
+            return flight;
+    }
 
-    while (queue->count == 0)
-        cond_wait(&queue->not_empty, &queue->mutex);
+    return NULL;
+}
 
-    *item = queue->items[queue->head];
-    queue->head = (queue->head + 1) % queue->capacity;
-    queue->count--;
+static int join_flight(PendingDownload* flight, int sequence_number) {
+    if (flight->follower_count == flight->follower_capacity) {
+        const size_t capacity = flight->follower_capacity ? flight->follower_capacity * 2 : 4;
+        int* followers = html2tex_realloc(flight->followers, capacity * sizeof(int));
 
-    cond_signal(&queue->not_full);
-    mutex_unlock(&queue->mutex);
-    return true;
+        if (!followers) return 0;
+        flight->followers = followers;
+        flight->follower_capacity = capacity;
+    }
+
+    flight->followers[flight->follower_count++] = sequence_number;
+    return 1;
 }
 
-static bool mutex_queue_is_empty(struct DownloadQueue* queue) {
-    mutex_lock(&queue->mutex);
-    bool empty = (queue->count == 0);
-    mutex_unlock(&queue->mutex);
-    return empty;
+static int delivery_begin(const char* content_type, void* user_data) {
+    PendingDownload* pending = (PendingDownload*)user_data;
+    struct ImageDownloader* downloader = pending->downloader;
+
+    if (content_type) {
+        pending->content_type = copy_text(content_type);
+        if (!pending->content_type) return 0;
+    }
+
+    DownloadResult* image = &pending->image;
+    image->url = (char*)pending->url;
+    image->local_path = (char*)pending->path;
+    image->filename = (char*)base_name(pending->path);
+    image->content_type = pending->content_type;
+    image->sequence_number = pending->sequence_number;
+
+    if (downloader->delivery == IMAGE_DELIVERY_STREAM && downloader->writer.begin)
+        return downloader->writer.begin(image, downloader->user_data);
+
+    return 1;
 }
 
-static THREAD_RETURN_TYPE worker_func(void* arg) {
-    struct Worker* worker = (struct Worker*)arg;
-    struct ImageDownloader* downloader = worker->downloader;
-    atomic_fetch_add(&downloader->active_workers, 1);
+static int delivery_write(const void* data, size_t size, void* user_data) {
+    PendingDownload* pending = (PendingDownload*)user_data;
+    struct ImageDownloader* downloader = pending->downloader;
 
-    while (!atomic_load(&downloader->stop_flag)) {
-        QueuedDownload item;
+    if (downloader->delivery == IMAGE_DELIVERY_STREAM)
+        return downloader->writer.write(&pending->image, data, size, downloader->user_data);
 
-        if (!queue_pop(&downloader->queue, &item))
-            break;
+    if (size > pending->capacity - pending->size) {
+        size_t capacity = pending->capacity ? pending->capacity : 16384;
 
-        if (atomic_load(&downloader->stop_flag)) {
-            free(item.url);
-            free(item.output_dir);
-            break;
+        while (capacity - pending->size < size) {
+            if (capacity > SIZE_MAX / 2) return 0;
+            capacity *= 2;
         }
 
-        DownloadResult* result = malloc(sizeof(DownloadResult));
+        unsigned char* grown = html2tex_realloc(pending->data, capacity);
+        if (!grown) return 0;
 
-        if (result) {
-            result->url = strdup(item.url);
-            result->sequence_number = item.sequence_number;
-            result->local_path = NULL;
-            result->error = NULL;
+        pending->data = grown;
+        pending->capacity = capacity;
+    }
 
-            char* local_path = download_image_src(NULL, item.url,
-                item.output_dir, item.sequence_number);
+    memcpy(pending->data + pending->size, data, size);
+    pending->size += size;
+    return 1;
+}
 
-            if (local_path) {
-                result->local_path = local_path;
-                result->success = true;
-                atomic_fetch_add(&downloader->successful, 1);
-            }
-            else {
-                result->success = false;
-                const char* err = html2tex_get_error_message();
-                result->error = err ? strdup(err) : strdup("Image download failed.");
-            }
+static const HTMLDownloadSink delivery_sink = { delivery_begin, delivery_write };
 
-            mutex_lock(&downloader->results_mutex);
+/* hands the delivered image to a successful result, the last taker keeps the buffer */
+static void attach_delivery(DownloadResult* result, PendingDownload* pending, int take) {
+    if (!result || !result->success) return;
 
-            if (downloader->results_count >= downloader->results_capacity) {
-                size_t new_cap = downloader->results_capacity * 2;
-                if (new_cap == 0) new_cap = 16;
+    if (pending->content_type)
+        result->content_type = copy_text(pending->content_type);
 
-                DownloadResult** new_results = realloc(downloader->results,
-                    sizeof(DownloadResult*) * new_cap);
+    if (pending->downloader->delivery != IMAGE_DELIVERY_MEMORY)
+        return;
 
-                if (new_results) {
-                    downloader->results = new_results;
-                    downloader->results_capacity = new_cap;
-                }
-            }
+    /* an empty image still gets a buffer, so data tells delivery apart from failure */
+    if (take && pending->data) {
+        result->data = pending->data;
+        pending->data = NULL;
+    }
+    else if ((result->data = html2tex_malloc(pending->size ? pending->size : 1)) != NULL && pending->size)
+        memcpy(result->data, pending->data, pending->size);
 
-            if (downloader->results_count < downloader->results_capacity) {
-                downloader->results[downloader->results_count++] = result;
+    result->size = result->data ? pending->size : 0;
+}
 
-                /* call individual callback */
-                if (downloader->download_callback)
-                    downloader->download_callback(result, 
-                        downloader->user_data);
-            }
-            else {
-                free(result->url);
-                free(result->error);
-                free(result);
-            }
+/* releases a pending download and what it buffered */
+static void free_pending(PendingDownload* pending) {
+    html2tex_free(pending->followers);
+    html2tex_free(pending->data);
+    html2tex_free(pending->content_type);
+    html2tex_free(pending);
+}
 
-            mutex_unlock(&downloader->results_mutex);
-        }
+static PendingDownload* create_pending(struct ImageDownloader* downloader, const char* url,
+    const char* output_dir, const char* path, int sequence_number) {
+    const size_t url_len = strlen(url) + 1;
+    const size_t dir_len = strlen(output_dir) + 1;
+    const size_t path_len = strlen(path) + 1;
+
+    PendingDownload* pending = html2tex_calloc(1, sizeof(PendingDownload)
+        + url_len + dir_len + path_len);
+    if (!pending) return NULL;
+
+    char* strings = (char*)(pending + 1);
+    memcpy(strings, url, url_len);
+    memcpy(strings + url_len, output_dir, dir_len);
+    memcpy(strings + url_len + dir_len, path, path_len);
+
+    pending->downloader = downloader;
+    pending->sequence_number = sequence_number;
+    pending->url = strings;
+    pending->output_dir = strings + url_len;
+    pending->path = strings + url_len + dir_len;
+    return pending;
+}
 
-        free(item.url);
-        free(item.output_dir);
+/* decodes a data URI into the delivery of the downloader */
+static void deliver_data_uri(struct ImageDownloader* downloader, const char* url,
+    const char* output_dir, int sequence_number) {
+    char* local_path = build_image_path(url, output_dir, sequence_number);
+    PendingDownload* pending = local_path
+        ? create_pending(downloader, url, output_dir, local_path, sequence_number) : NULL;
+    int success = 0;
+
+    if (pending)
+        success = stream_base64_image(url, &delivery_sink, pending);
+    else if (local_path)
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NOMEM,
+            "Failed to allocate the delivery of a data URI.");
+
+    DownloadResult* result = create_result(url, success ? local_path : NULL,
+        success ? NULL : html2tex_get_error_message(), sequence_number);
+
+    if (pending) {
+        attach_delivery(result, pending, 1);
+        free_pending(pending);
+    }
 
-        size_t completed = atomic_fetch_add(&downloader->completed, 1) + 1;
-        size_t total = atomic_load(&downloader->total_enqueued);
+    record_result(downloader, result);
+    html2tex_free(local_path);
+}
 
-        if (completed >= total && downloader->batch_callback) {
-            size_t success = atomic_load(&downloader->successful);
-            downloader->batch_callback(total, success, downloader->user_data);
-        }
+static void transfer_done(const char* url, const char* path, const char* error, void* user_data) {
+    PendingDownload* pending = (PendingDownload*)user_data;
+    struct ImageDownloader* downloader = pending->downloader;
+
+    /* later requests for the same file start a transfer of their own */
+    mutex_lock(&downloader->flights_mutex);
+    PendingDownload** link = &downloader->flights[pending->bucket];
+
+    while (*link != pending)
+        link = &(*link)->next;
+
+    *link = pending->next;
+    mutex_unlock(&downloader->flights_mutex);
+
+    DownloadResult* result = create_result(url, error ? NULL : path,
+        error, pending->sequence_number);
+
+    attach_delivery(result, pending, pending->follower_count == 0);
+    record_result(downloader, result);
+
+    /* every request that joined shares the file and the outcome */
+    for (size_t i = 0; i < pending->follower_count; i++) {
+        result = create_result(url, error ? NULL : path, error, pending->followers[i]);
+
+        attach_delivery(result, pending, i + 1 == pending->follower_count);
+        record_result(downloader, result);
     }
 
-    atomic_fetch_sub(&downloader->active_workers, 1);
+    free_pending(pending);
 
-    if (atomic_load(&downloader->active_workers) == 0) {
+    /* last touch of the downloader, image_downloader_destroy() waits for it */
+    if (downloader->fetcher) {
         mutex_lock(&downloader->state_mutex);
-        cond_broadcast(&downloader->all_complete);
+
+        if (--downloader->fetches == 0)
+            cond_broadcast(&downloader->all_complete);
+
         mutex_unlock(&downloader->state_mutex);
     }
+}
+
+/* hands a registered download to the fetcher or the engine */
+static int submit_transfer(struct ImageDownloader* downloader, const char* url,
+    const char* local_path, PendingDownload* pending) {
+    if (!downloader->fetcher)
+        return html_download_engine_submit_sink(downloader->engine, url, local_path,
+            downloader->delivery == IMAGE_DELIVERY_FILE ? NULL : &delivery_sink,
+            transfer_done, pending);
 
-    thread_exit(0);
+    /* settled by transfer_done(), which the caller runs itself on failure */
+    mutex_lock(&downloader->state_mutex);
+    downloader->fetches++;
+    mutex_unlock(&downloader->state_mutex);
+
+    return image_fetcher_submit(downloader->fetcher, url,
+        local_path, transfer_done, pending);
 }
 
-ImageDownloader* image_downloader_create(size_t max_workers,
-    DownloadCallback callback,
+static struct ImageDownloader* alloc_downloader(DownloadCallback callback,
     BatchCompleteCallback batch_callback,
     void* user_data) {
-    if (max_workers == 0) max_workers = get_cpu_count();
-    struct ImageDownloader* downloader = calloc(1, sizeof(struct ImageDownloader));
+    struct ImageDownloader* downloader = html2tex_calloc(1, sizeof(struct ImageDownloader));
     if (!downloader) return NULL;
 
-    /* initialize queue */
-    if (!queue_init(&downloader->queue, max_workers * 4)) {
-        free(downloader);
-        return NULL;
-    }
-
     /* initialize synchronization */
-    if (mutex_init(&downloader->results_mutex) != 0 ||
-        mutex_init(&downloader->state_mutex) != 0 ||
+    if (mutex_init(&downloader->state_mutex) != 0 ||
+        mutex_init(&downloader->flights_mutex) != 0 ||
         cond_init(&downloader->all_complete) != 0) {
-        mutex_queue_destroy(&downloader->queue);
-        free(downloader);
+        html2tex_free(downloader);
         return NULL;
     }
 
@@ -244,45 +410,95 @@ ImageDownloader* image_downloader_create(size_t max_workers,
     downloader->batch_callback = batch_callback;
     downloader->user_data = user_data;
 
-    atomic_store(&downloader->stop_flag, false);
-    atomic_store(&downloader->active_workers, 0);
     atomic_store(&downloader->total_enqueued, 0);
     atomic_store(&downloader->completed, 0);
     atomic_store(&downloader->successful, 0);
+    atomic_store(&downloader->dedup_hits, 0);
+    atomic_store(&downloader->completions, 0);
+    atomic_store(&downloader->waiters, 0);
+    return downloader;
+}
+
+ImageDownloader* image_downloader_create(size_t max_workers,
+    DownloadCallback callback,
+    BatchCompleteCallback batch_callback,
+    void* user_data) {
+    struct ImageDownloader* downloader = alloc_downloader(callback,
+        batch_callback, user_data);
+    if (!downloader) return NULL;
+
+    /* every transfer runs on the engine's event loop */
+    HTMLDownloadOptions options;
+    memset(&options, 0, sizeof(options));
+
+    options.event_loops = 1;
+    options.max_connections = max_workers;
+    options.multiplex = 1;
 
-    /* create the thread workers */
-    downloader->workers = malloc(sizeof(struct Worker) 
-        * max_workers);
+    downloader->engine = html_download_engine_create(&options);
 
-    if (!downloader->workers) {
+    if (!downloader->engine) {
         image_downloader_destroy(downloader);
         return NULL;
     }
 
-    downloader->worker_count = max_workers;
+    return downloader;
+}
+
+ImageDownloader* image_downloader_create_with_fetcher(ImageFetcher* fetcher,
+    DownloadCallback callback,
+    BatchCompleteCallback batch_callback,
+    void* user_data) {
+    if (!fetcher) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Image fetcher is NULL for the downloader.");
+        return NULL;
+    }
 
-    for (size_t i = 0; i < max_workers; i++) {
-        downloader->workers[i].downloader = downloader;
+    struct ImageDownloader* downloader = alloc_downloader(callback,
+        batch_callback, user_data);
+    if (!downloader) return NULL;
 
-        if (thread_create(&downloader->workers[i].thread, worker_func,
-            &downloader->workers[i]) != 0) {
-            atomic_store(&downloader->stop_flag, true);
-            cond_broadcast(&downloader->queue.not_empty);
+    downloader->fetcher = fetcher;
+    return downloader;
+}
 
-            for (size_t j = 0; j < i; j++)
-                thread_join(downloader->workers[j].thread);
+bool image_downloader_set_delivery(ImageDownloader* downloader,
+    ImageDelivery delivery, const ImageStreamWriter* writer) {
+    html2tex_err_clear();
 
-            image_downloader_destroy(downloader);
-            return NULL;
-        }
+    if (!downloader || (delivery == IMAGE_DELIVERY_STREAM && (!writer || !writer->write))) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_NULL,
+            "Downloader or stream writer is NULL.");
+        return false;
     }
 
-    if (image_utils_init() != 0) {
-        image_downloader_destroy(downloader);
-        return NULL;
+    if (delivery < IMAGE_DELIVERY_FILE || delivery > IMAGE_DELIVERY_STREAM) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Unsupported image delivery %d.", (int)delivery);
+        return false;
     }
 
-    return downloader;
+    /* fetchers write files, only the engine hands out the body */
+    if (downloader->fetcher && delivery != IMAGE_DELIVERY_FILE) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image fetchers only deliver files.");
+        return false;
+    }
+
+    if (image_downloader_is_active(downloader)) {
+        HTML2TEX__SET_ERR(HTML2TEX_ERR_INVAL,
+            "Image delivery cannot change while images are downloading.");
+        return false;
+    }
+
+    downloader->delivery = delivery;
+    memset(&downloader->writer, 0, sizeof(downloader->writer));
+
+    if (delivery == IMAGE_DELIVERY_STREAM)
+        downloader->writer = *writer;
+
+    return true;
 }
 
 bool image_downloader_enqueue(ImageDownloader* downloader,
@@ -290,117 +506,223 @@ bool image_downloader_enqueue(ImageDownloader* downloader,
     const char* output_dir,
     int sequence_number) {
 
-    if (!downloader || !url 
-        || !output_dir) 
+    if (!downloader || !url
+        || !output_dir)
         return false;
 
-    QueuedDownload item = {
-        .url = strdup(url),
-        .output_dir = strdup(output_dir),
-        .sequence_number = sequence_number
-    };
+    atomic_fetch_add(&downloader->total_enqueued, 1);
 
-    if (!item.url || !item.output_dir) {
-        free(item.url);
-        free(item.output_dir);
-        return false;
+    /* data URIs are decoded in place, there is nothing to fetch */
+    if (is_base64_image(url)) {
+        if (downloader->delivery != IMAGE_DELIVERY_FILE) {
+            deliver_data_uri(downloader, url, output_dir, sequence_number);
+            return true;
+        }
+
+        char* local_path = download_image_src(NULL, url,
+            output_dir, sequence_number);
+        const char* err = local_path ? NULL : html2tex_get_error_message();
+
+        record_result(downloader, create_result(url, local_path,
+            err, sequence_number));
+        html2tex_free(local_path);
+        return true;
+    }
+
+    /* held until the transfer is registered, so a second request always finds it */
+    const size_t bucket = flight_bucket(url, output_dir);
+    mutex_lock(&downloader->flights_mutex);
+
+    PendingDownload* flight = find_flight(downloader, bucket, url, output_dir);
+
+    if (flight) {
+        const int joined = join_flight(flight, sequence_number);
+        mutex_unlock(&downloader->flights_mutex);
+
+        if (!joined) {
+            atomic_fetch_sub(&downloader->total_enqueued, 1);
+            return false;
+        }
+
+        atomic_fetch_add(&downloader->dedup_hits, 1);
+        return true;
     }
 
-    if (!queue_push(&downloader->queue, item)) {
-        free(item.url);
-        free(item.output_dir);
+    /* images kept off the disk need no directory */
+    char* local_path = downloader->delivery == IMAGE_DELIVERY_FILE
+        ? prepare_image_path(url, output_dir, sequence_number)
+        : build_image_path(url, output_dir, sequence_number);
+
+    if (!local_path) {
+        mutex_unlock(&downloader->flights_mutex);
+        record_result(downloader, create_result(url, NULL,
+            html2tex_get_error_message(), sequence_number));
+        return true;
+    }
+
+    PendingDownload* pending = create_pending(downloader, url,
+        output_dir, local_path, sequence_number);
+
+    if (pending) {
+        pending->bucket = bucket;
+        pending->next = downloader->flights[bucket];
+        downloader->flights[bucket] = pending;
+    }
+
+    mutex_unlock(&downloader->flights_mutex);
+
+    if (!pending) {
+        atomic_fetch_sub(&downloader->total_enqueued, 1);
+        html2tex_free(local_path);
         return false;
     }
 
-    atomic_fetch_add(&downloader->total_enqueued, 1);
+    /* submitted unlocked, a blocking fetcher completes the flight before returning */
+    if (!submit_transfer(downloader, url, local_path, pending)) {
+        char* error = copy_text(html2tex_get_error_message());
+
+        /* requests may have joined meanwhile, they fail along with it */
+        transfer_done(url, local_path, error ? error : "Image download failed.", pending);
+        html2tex_free(error);
+    }
+
+    html2tex_free(local_path);
     return true;
 }
 
 bool image_downloader_start(ImageDownloader* downloader) {
-    if (!downloader) return false;
-    cond_broadcast(&downloader->queue.not_empty);
-    return true;
+    /* transfers start as soon as they are enqueued */
+    return downloader != NULL;
 }
 
 bool image_downloader_wait(ImageDownloader* downloader, unsigned int timeout_ms) {
     if (!downloader) return false;
+
+    bool finished = true;
     mutex_lock(&downloader->state_mutex);
 
+    atomic_fetch_add(&downloader->waiters, 1);
+    atomic_fence();
+
     while (atomic_load(&downloader->completed) <
-        atomic_load(&downloader->total_enqueued) &&
-        atomic_load(&downloader->active_workers) > 0) {
+        atomic_load(&downloader->total_enqueued)) {
 
         if (timeout_ms == 0)
-            cond_wait(&downloader->all_complete, 
+            cond_wait(&downloader->all_complete,
                 &downloader->state_mutex);
         else {
             if (cond_timedwait(&downloader->all_complete,
                 &downloader->state_mutex, timeout_ms) != 0) {
-                mutex_unlock(&downloader->state_mutex);
-                return false;
+                finished = false;
+                break;
             }
         }
     }
 
+    atomic_fetch_sub(&downloader->waiters, 1);
     mutex_unlock(&downloader->state_mutex);
-    return true;
+    return finished;
 }
 
 size_t image_downloader_cancel(ImageDownloader* downloader) {
     if (!downloader) return 0;
-    atomic_store(&downloader->stop_flag, true);
-    cond_broadcast(&downloader->queue.not_empty);
-    size_t cancelled = 0;
+    size_t followers = 0;
 
-    while (!mutex_queue_is_empty(&downloader->queue)) {
-        QueuedDownload item;
+    /* requests that joined a transfer are cancelled along with it */
+    mutex_lock(&downloader->flights_mutex);
 
-        if (queue_pop(&downloader->queue, &item)) {
-            free(item.url);
-            free(item.output_dir);
-            cancelled++;
-        }
+    for (size_t i = 0; i < FLIGHT_BUCKETS; i++) {
+        for (PendingDownload* flight = downloader->flights[i]; flight; flight = flight->next)
+            followers += flight->follower_count;
     }
 
-    return cancelled;
+    mutex_unlock(&downloader->flights_mutex);
+
+    if (downloader->fetcher)
+        return image_fetcher_cancel(downloader->fetcher) + followers;
+
+    return html_download_engine_cancel(downloader->engine) + followers;
+}
+
+size_t image_downloader_dedup_hits(const ImageDownloader* downloader) {
+    if (!downloader) return 0;
+    return atomic_load(&((struct ImageDownloader*)downloader)->dedup_hits);
+}
+
+bool image_downloader_is_active(const ImageDownloader* downloader) {
+    if (!downloader) return false;
+
+    return atomic_load(&((struct ImageDownloader*)downloader)->completed) <
+        atomic_load(&((struct ImageDownloader*)downloader)->total_enqueued);
 }
 
 DownloadResult** image_downloader_get_results(ImageDownloader* downloader, size_t* count) {
     if (!downloader || !count) return NULL;
-    mutex_lock(&downloader->results_mutex);
+    *count = 0;
+
+    CompletedDownload* taken = take_completions(downloader);
+    if (!taken) return NULL;
+
+    CompletedDownload* last = taken;
+    size_t taken_count = 1;
+
+    while (last->next) {
+        last = last->next;
+        taken_count++;
+    }
+
+    DownloadResult** results = html2tex_malloc(sizeof(DownloadResult*) * taken_count);
+
+    /* nothing is lost, the next call collects them again */
+    if (!results) {
+        push_completions(downloader, taken, last);
+        return NULL;
+    }
 
-    *count = downloader->results_count;
-    DownloadResult** results = downloader->results;
+    /* the stack is newest first, results are reported in completion order */
+    *count = taken_count;
 
-    downloader->results = NULL;
-    downloader->results_count = 0;
-    downloader->results_capacity = 0;
+    for (CompletedDownload* node = taken; node; node = node->next)
+        results[--taken_count] = &node->result;
 
-    mutex_unlock(&downloader->results_mutex);
     return results;
 }
 
+void download_result_free(DownloadResult* result) {
+    if (!result) return;
+
+    html2tex_free(result->url);
+    html2tex_free(result->local_path);
+    html2tex_free(result->error);
+    html2tex_free(result->data);
+    html2tex_free(result->content_type);
+    html2tex_free(result->filename);
+    html2tex_free(result);
+}
+
 void image_downloader_destroy(ImageDownloader* downloader) {
     if (!downloader) return;
-    image_downloader_cancel(downloader);
 
-    for (size_t i = 0; i < downloader->worker_count; i++)
-        thread_join(downloader->workers[i].thread);
+    /* cancelled transfers still report through the callbacks before the loop stops */
+    html_download_engine_destroy(downloader->engine);
+
+    /* fetcher callbacks may still be returning */
+    mutex_lock(&downloader->state_mutex);
+
+    while (downloader->fetches)
+        cond_wait(&downloader->all_complete, &downloader->state_mutex);
 
-    mutex_queue_destroy(&downloader->queue);
-    mutex_lock(&downloader->results_mutex);
+    mutex_unlock(&downloader->state_mutex);
+    CompletedDownload* node = take_completions(downloader);
 
-    for (size_t i = 0; i < downloader->results_count; i++)
-        download_result_free(downloader->results[i]);
-    
-    free(downloader->results);
-    mutex_unlock(&downloader->results_mutex);
+    while (node) {
+        CompletedDownload* next = node->next;
+        download_result_free(&node->result);
+        node = next;
+    }
 
-    mutex_destroy(&downloader->results_mutex);
     mutex_destroy(&downloader->state_mutex);
+    mutex_destroy(&downloader->flights_mutex);
     cond_destroy(&downloader->all_complete);
-
-    free(downloader->workers);
-    free(downloader);
-    image_utils_cleanup();
-}
\ No newline at end of file
+    html2tex_free(downloader);
+}
@@ -1,6 +1,5 @@
 #include "ext/image_manager.hpp"
 #include <cstring>
-#include <curl/curl.h>
 #include <system_error>
 #include <iostream>
 
@@ -53,6 +52,37 @@ namespace {
         return false;
     }
 
+    /**
+     * @brief Describes the error left by a failed C API call.
+     * @return Error message of the calling thread
+     */
+    std::string downloadError() {
+        if (html2tex_has_error()) {
+            int error_code = html2tex_get_error();
+            const char* error_msg = html2tex_get_error_message();
+
+            if (error_msg && error_msg[0])
+                return error_msg;
+
+            return "Download failed"
+                " with error code: " +
+                std::to_string(error_code);
+        }
+
+        return "Download failed"
+            " (unknown reason).";
+    }
+
+    /**
+     * @brief Extracts the last component of a path.
+     * @param path Local file path
+     * @return File name suggested for the image
+     */
+    std::string fileName(const std::string& path) {
+        const size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? path : path.substr(slash + 1);
+    }
+
     /**
      * @brief Downloads single image using existing C API.
      * @param req Download request
@@ -74,143 +104,162 @@ namespace {
 
         if (local_path) {
             result.local_path = local_path;
+            result.filename = fileName(result.local_path);
             result.success = true;
-            free(local_path);
+            html2tex_free(local_path);
         }
         else {
             /* failure, check for error */
             result.success = false;
-
-            if (html2tex_has_error()) {
-                int error_code = html2tex_get_error();
-                const char* error_msg = html2tex_get_error_message();
-
-                if (error_msg && error_msg[0])
-                    result.error = error_msg;
-                else {
-                    result.error = "Download failed"
-                        " with error code: " +
-                        std::to_string(error_code);
-                }
-            }
-            else
-                result.error = "Download failed"
-                " (unknown reason).";
+            result.error = downloadError();
         }
 
         return result;
     }
 }
 
-ImageManager::ImageManager(size_t max_workers) {
-    static std::once_flag curl_init_flag;
-    std::call_once(curl_init_flag, []() {
-        CURLcode res = curl_global_init(
-            CURL_GLOBAL_DEFAULT);
-
-        if (res != CURLE_OK) {
-            throw ImageRuntimeException(
-                std::string("CURL initialization failed: ") 
-                + curl_easy_strerror(res),
-                HTML2TEX_ERR_INTERNAL);
-        }
-        });
-
-    // Determine worker count
-    size_t worker_count = max_workers;
-    if (worker_count == 0) {
-        worker_count = std::thread::hardware_concurrency();
-        if (worker_count == 0) {
-            worker_count = 4; // Reasonable default
-        }
-    }
+/* download handed to the engine, completed on its event loop */
+struct ImageManager::PendingDownload {
+    /* a request that joined the transfer while it was in flight */
+    struct Follower {
+        int sequence_number;
+        std::promise<DownloadResult> promise;
+    };
+
+    ImageManager* owner;
+    std::string key;
+    std::string path;
+    DownloadResult result;
+    std::promise<DownloadResult> promise;
+    std::vector<Follower> followers;
+};
 
-    // Create worker threads
-    workers.reserve(worker_count);
-    for (size_t i = 0; i < worker_count; ++i) {
-        try {
-            workers.emplace_back(
-                &ImageManager::workerThread, 
-                this);
-        }
-        catch (const std::system_error& e) {
-            // Clean up any successfully created threads
-            for (auto& thread : workers) {
-                if (thread.joinable()) {
-                    thread.join();
-                }
-            }
-            throw ImageRuntimeException(
-                std::string("Failed to create worker thread: ") + e.what(),
-                HTML2TEX_ERR_INTERNAL);
-        }
+ImageManager::ImageManager(size_t max_workers) {
+    /* one event loop serves every transfer, max_workers bounds the open connections */
+    HTMLDownloadOptions options;
+    std::memset(&options, 0, sizeof(options));
+
+    options.event_loops = 1;
+    options.max_connections = max_workers;
+    options.multiplex = 1;
+
+    engine = html_download_engine_create(&options);
+
+    if (!engine) {
+        const char* error_msg = html2tex_get_error_message();
+        throw ImageRuntimeException(
+            std::string("Download engine initialization failed: ")
+            + (error_msg ? error_msg : "unknown reason"),
+            HTML2TEX_ERR_INTERNAL);
     }
 }
 
+ImageManager::ImageManager(ImageFetcher& fetcher) : fetcher(&fetcher) {}
+
+const HTMLDownloadSink ImageManager::delivery_sink = {
+    &ImageManager::onDeliveryBegin,
+    &ImageManager::onDeliveryWrite
+};
+
 ImageManager::~ImageManager() {
-    std::lock_guard<std::mutex> lock(queue_mutex);
     stop_flag = true;
 
-    /* reject all pending promises */
-    while (!task_queue.empty()) {
-        auto& promise = task_queue.front().second;
-        try {
-            promise.set_exception(std::make_exception_ptr(
-                std::runtime_error("ImageManager destroyed"
-                    " while download pending")));
-        }
-        catch (...) {}
-        task_queue.pop();
-    }
+    /* rejects pending promises through the transfer callbacks */
+    html_download_engine_destroy(engine);
 
-    /* wake up all waiting threads */
-    queue_cv.notify_all();
+    /* a fetcher is shared, its transfers finish rather than being cancelled */
+    if (fetcher) waitForCompletion();
+}
 
-    /* wait for threads to finish */
-    for (auto& worker : workers) {
-        if (worker.joinable())
-            worker.join();
+void ImageManager::onTransferDone(const char* url, const char* path,
+    const char* error, void* user_data) {
+    std::unique_ptr<PendingDownload> pending(
+        static_cast<PendingDownload*>(user_data));
+    ImageManager* owner = pending->owner;
+    (void)url;
+
+    /* later requests for the same file start a transfer of their own */
+    {
+        std::lock_guard<std::mutex> lock(owner->flights_mutex);
+        owner->flights.erase(pending->key);
     }
-}
 
-void ImageManager::workerThread() {
-    while (true) {
-        std::pair<DownloadRequest, std::promise<DownloadResult>> task;
+    try {
+        if (error && std::strcmp(error, HTML_DOWNLOAD_CANCELLED) == 0) {
+            const auto cancelled = std::make_exception_ptr(
+                std::runtime_error(owner->stop_flag
+                    ? "ImageManager destroyed while download pending"
+                    : "Download cancelled by user"));
 
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
+            pending->promise.set_exception(cancelled);
 
-            /* wait for task or shutdown signal */
-            queue_cv.wait(lock, [this]() {
-                return stop_flag || !task_queue.empty();
-                });
+            for (auto& follower : pending->followers)
+                follower.promise.set_exception(cancelled);
+        }
+        else {
+            if (error) {
+                /* partial bytes and the type of a failed delivery are dropped */
+                pending->result.error = error;
+                pending->result.local_path.clear();
+                pending->result.filename.clear();
+                pending->result.content_type.clear();
+                pending->result.data.clear();
+            }
+            else {
+                pending->result.local_path = path;
+                pending->result.filename = fileName(pending->result.local_path);
+                pending->result.success = true;
+            }
 
-            // Check for shutdown
-            if (stop_flag && task_queue.empty()) {
-                return;
+            /* every request that joined shares the file and the outcome */
+            for (auto& follower : pending->followers) {
+                DownloadResult shared = pending->result;
+                shared.sequence_number = follower.sequence_number;
+                follower.promise.set_value(std::move(shared));
             }
 
-            /* get next task */
-            task = std::move(task_queue.front());
-            task_queue.pop();
-            ++active_workers;
+            pending->promise.set_value(std::move(pending->result));
         }
+    }
+    catch (...) {}
 
-        try {
-            /* execute download */
-            DownloadResult result = downloadSingle(task.first);
+    owner->active_downloads -= 1 + pending->followers.size();
+}
 
-            /* set result in promise */
-            task.second.set_value(std::move(result));
+int ImageManager::onDeliveryBegin(const char* content_type, void* user_data) {
+    auto* pending = static_cast<PendingDownload*>(user_data);
 
-        }
-        catch (...) {
-            /* set exception in promise */
-            task.second.set_exception(std::current_exception());
-        }
+    try {
+        /* the writer sees the file the converter references */
+        pending->result.local_path = pending->path;
+        pending->result.filename = fileName(pending->path);
+
+        if (content_type)
+            pending->result.content_type = content_type;
+    }
+    catch (...) {
+        return 0;
+    }
+
+    return 1;
+}
+
+int ImageManager::onDeliveryWrite(const void* data, size_t size, void* user_data) {
+    auto* pending = static_cast<PendingDownload*>(user_data);
+    ImageManager* owner = pending->owner;
+
+    try {
+        if (owner->delivery == Delivery::Stream)
+            return owner->writer(pending->result, data, size) ? 1 : 0;
 
-        --active_workers;
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        pending->result.data.insert(pending->result.data.end(), bytes, bytes + size);
     }
+    catch (...) {
+        return 0;
+    }
+
+    return 1;
 }
 
 std::future<ImageManager::DownloadResult>
@@ -229,23 +278,97 @@ ImageManager::downloadAsync(const DownloadRequest& request) {
             "Sequence number must be"
             " non-negative.");
 
-    std::promise<DownloadResult> promise;
-    auto future = promise.get_future();
-
-    std::lock_guard<std::mutex> lock(queue_mutex);
-
     /* check if we're shutting down */
     if (stop_flag)
         throw std::runtime_error(
             "ImageManager is shutting down.");
 
-    /* add task to queue */
-    task_queue.emplace(request,
-        std::move(promise));
+    std::unique_ptr<PendingDownload> pending(new PendingDownload());
+    pending->owner = this;
+    pending->result.url = request.url;
+    pending->result.sequence_number = request.sequence_number;
+    auto future = pending->promise.get_future();
+
+    /* data URIs are decoded in place, there is nothing to fetch */
+    if (is_base64_image(request.url.c_str())) {
+        if (delivery == Delivery::File) {
+            pending->promise.set_value(downloadSingle(request));
+            return future;
+        }
+
+        char* local_path = build_image_path(request.url.c_str(),
+            request.output_dir.c_str(), request.sequence_number);
+
+        if (local_path) {
+            pending->path = local_path;
+            html2tex_free(local_path);
+        }
+
+        const int delivered = local_path
+            && stream_base64_image(request.url.c_str(), &delivery_sink, pending.get());
+
+        /* settled at once, the callback balances the count */
+        PendingDownload* decoded = pending.release();
+        ++active_downloads;
+
+        onTransferDone(request.url.c_str(), decoded->path.c_str(),
+            delivered ? nullptr : downloadError().c_str(), decoded);
+        return future;
+    }
+
+    /* held until the transfer is registered, so a second request always finds it */
+    pending->key = request.output_dir + '\n' + request.url;
+    std::unique_lock<std::mutex> lock(flights_mutex);
+    auto flight = flights.find(pending->key);
 
-    /* wake up one worker thread */
-    queue_cv.notify_one();
+    if (flight != flights.end()) {
+        PendingDownload::Follower follower{ request.sequence_number, {} };
+        auto joined = follower.promise.get_future();
 
+        flight->second->followers.push_back(std::move(follower));
+        ++active_downloads;
+        ++dedup_hits;
+        return joined;
+    }
+
+    /* images kept off the disk need no directory */
+    char* local_path = nullptr;
+
+    if (delivery == Delivery::File) {
+        tryCreateDirectory(request.output_dir);
+        local_path = prepare_image_path(request.url.c_str(),
+            request.output_dir.c_str(), request.sequence_number);
+    }
+    else
+        local_path = build_image_path(request.url.c_str(),
+            request.output_dir.c_str(), request.sequence_number);
+
+    if (!local_path) {
+        pending->result.error = downloadError();
+        pending->promise.set_value(std::move(pending->result));
+        return future;
+    }
+
+    pending->path = local_path;
+    flights.emplace(pending->key, pending.get());
+    ++active_downloads;
+    lock.unlock();
+
+    /* the callback owns the pending download from here, a blocking fetcher runs it before returning */
+    PendingDownload* submitted = pending.release();
+    const int started = fetcher
+        ? image_fetcher_submit(fetcher, request.url.c_str(), local_path,
+            &ImageManager::onTransferDone, submitted)
+        : html_download_engine_submit_sink(engine, request.url.c_str(), local_path,
+            delivery == Delivery::File ? nullptr : &delivery_sink,
+            &ImageManager::onTransferDone, submitted);
+
+    /* requests that joined meanwhile fail along with it */
+    if (!started)
+        onTransferDone(request.url.c_str(), local_path,
+            downloadError().c_str(), submitted);
+
+    html2tex_free(local_path);
     return future;
 }
 
@@ -278,28 +401,42 @@ ImageManager::downloadBatch(const std::vector<DownloadRequest>& requests) {
 }
 
 void ImageManager::cancelAll() {
-    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (fetcher)
+        image_fetcher_cancel(fetcher);
+    else
+        html_download_engine_cancel(engine);
+}
 
-    while (!task_queue.empty()) {
-        auto& promise = task_queue
-            .front().second;
+bool ImageManager::isActive() const { 
+    return active_downloads > 0;
+}
 
-        try {
-            promise.set_exception(std::make_exception_ptr(
-                std::runtime_error("Download cancelled by user")));
-        }
-        catch (...) { }
-        task_queue.pop();
-    }
+size_t ImageManager::getDedupHits() const noexcept {
+    return dedup_hits;
 }
 
-bool ImageManager::isActive() const { 
-    return active_workers > 0 
-        || !task_queue.empty(); 
+void ImageManager::setDelivery(Delivery mode, StreamWriter writer) {
+    if (mode == Delivery::Stream && !writer)
+        throw std::invalid_argument(
+            "Stream delivery requires a writer.");
+
+    /* fetchers write files, only the engine hands out the body */
+    if (fetcher && mode != Delivery::File)
+        throw std::invalid_argument(
+            "Image fetchers only deliver files.");
+
+    if (isActive())
+        throw std::runtime_error(
+            "Image delivery cannot change while"
+            " images are downloading.");
+
+    delivery = mode;
+    this->writer = mode == Delivery::Stream
+        ? std::move(writer) : nullptr;
 }
 
 void ImageManager::waitForCompletion() {
     while (isActive())
         std::this_thread::sleep_for(
             std::chrono::milliseconds(10));
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#include "ext/task_executor.hpp"
+#include <memory>
+#include <string>
+
+namespace {
+    /**
+     * @brief Throws the error left by a failed executor call.
+     * @param what Operation that failed
+     */
+    [[noreturn]] void throwExecutorError(const char* what) {
+        const char* error_msg = html2tex_get_error_message();
+        const int error_code = html2tex_get_error();
+
+        throw RuntimeException(std::string(what) + ": "
+            + (error_msg && error_msg[0] ? error_msg : "unknown reason"),
+            error_code ? error_code : HTML2TEX_ERR_INTERNAL);
+    }
+}
+
+void TaskExecutor::configure(size_t threads) {
+    if (!html_executor_configure(threads))
+        throwExecutorError("Executor configuration failed");
+}
+
+size_t TaskExecutor::threads() noexcept {
+    return html_executor_threads();
+}
+
+TaskExecutor::TaskExecutor(Priority priority) {
+    pool = html_executor_pool_create(static_cast<HTMLTaskPriority>(priority));
+
+    if (!pool)
+        throwExecutorError("Executor pool creation failed");
+}
+
+TaskExecutor::~TaskExecutor() {
+    html_executor_pool_destroy(pool);
+}
+
+void TaskExecutor::runTask(void* arg) {
+    std::unique_ptr<std::packaged_task<void()>> task(
+        static_cast<std::packaged_task<void()>*>(arg));
+
+    /* exceptions are stored in the future, never reach the worker */
+    (*task)();
+}
+
+std::future<void> TaskExecutor::submit(std::function<void()> task) {
+    std::unique_ptr<std::packaged_task<void()>> packaged(
+        new std::packaged_task<void()>(std::move(task)));
+    std::future<void> result = packaged->get_future();
+
+    if (!html_executor_submit(pool, &TaskExecutor::runTask, packaged.get()))
+        throwExecutorError("Task submission failed");
+
+    /* owned by runTask from here */
+    packaged.release();
+    return result;
+}
+
+size_t TaskExecutor::pending() const noexcept {
+    return html_executor_pool_pending(pool);
+}